@@ -0,0 +1,109 @@
+// Замер массовых операций s21::array против std::array со стандартными
+// алгоритмами: fill, ==, < (различие в последнем элементе) и swap.
+//
+// Сборка: g++ -std=c++17 -O2 array_bench.cpp -o array_bench
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "s21_array.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsPerOp(Clock::time_point start, std::size_t ops) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+             .count() /
+         static_cast<double>(ops);
+}
+
+// Не дает компилятору выбросить вычисления, результат которых не
+// используется.
+template <typename T> void KeepAlive(T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+template <typename T, std::size_t N>
+void Run(const char *name, std::size_t ops) {
+  static s21::array<T, N> s21_a, s21_b;
+  static std::array<T, N> std_a, std_b;
+  std::size_t hits = 0;
+
+  auto start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i) {
+    s21_a.fill(static_cast<T>(i));
+    KeepAlive(s21_a);
+  }
+  double s21_fill = NanosecondsPerOp(start, ops);
+  start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i) {
+    std::fill(std_a.begin(), std_a.end(), static_cast<T>(i));
+    KeepAlive(std_a);
+  }
+  double std_fill = NanosecondsPerOp(start, ops);
+
+  s21_a.fill(T{1});
+  s21_b.fill(T{1});
+  std_a.fill(T{1});
+  std_b.fill(T{1});
+  s21_b.back() = T{2};
+  std_b.back() = T{2};
+
+  start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i) {
+    KeepAlive(s21_a);
+    hits += s21_a == s21_b;
+  }
+  double s21_equal = NanosecondsPerOp(start, ops);
+  start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i) {
+    KeepAlive(std_a);
+    hits += std::equal(std_a.begin(), std_a.end(), std_b.begin());
+  }
+  double std_equal = NanosecondsPerOp(start, ops);
+
+  start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i) {
+    KeepAlive(s21_a);
+    hits += s21_a < s21_b;
+  }
+  double s21_less = NanosecondsPerOp(start, ops);
+  start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i) {
+    KeepAlive(std_a);
+    hits += std::lexicographical_compare(std_a.begin(), std_a.end(),
+                                         std_b.begin(), std_b.end());
+  }
+  double std_less = NanosecondsPerOp(start, ops);
+
+  start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i) {
+    s21_a.swap(s21_b);
+    KeepAlive(s21_a);
+  }
+  double s21_swap = NanosecondsPerOp(start, ops);
+  start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i) {
+    std::swap(std_a, std_b);
+    KeepAlive(std_a);
+  }
+  double std_swap = NanosecondsPerOp(start, ops);
+
+  std::printf("%-24s fill %7.1f / %7.1f  ==  %7.1f / %7.1f  <  %7.1f / "
+              "%7.1f  swap %7.1f / %7.1f ns  (hits %zu)\n",
+              name, s21_fill, std_fill, s21_equal, std_equal, s21_less,
+              std_less, s21_swap, std_swap, hits);
+}
+} // namespace
+
+int main() {
+  std::printf("s21::array / std::array, ns на операцию\n");
+  Run<unsigned char, 4096>("unsigned char x 4096", 200000);
+  Run<std::uint32_t, 1024>("uint32_t x 1024", 200000);
+  Run<int, 4096>("int x 4096", 50000);
+  Run<double, 1024>("double x 1024", 200000);
+  return 0;
+}
@@ -0,0 +1,157 @@
+#include "../s21_containersplus.h"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace s21 {
+namespace {
+constexpr s21::array<int, 5> MakeSquares() {
+  s21::array<int, 5> result;
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    result[i] = static_cast<int>(i * i);
+  }
+  return result;
+}
+
+constexpr bool ConstexprOperations() {
+  s21::array<int, 4> a{1, 2, 3};
+  s21::array<int, 4> b;
+  b.fill(7);
+  a.swap(b);
+  return a.front() == 7 && b.at(2) == 3 && b.back() == 0 && a != b &&
+         b < a && a == s21::array<int, 4>{7, 7, 7, 7};
+}
+} // namespace
+
+static_assert(MakeSquares()[4] == 16);
+static_assert(MakeSquares() == s21::array<int, 5>{0, 1, 4, 9, 16});
+static_assert(ConstexprOperations());
+static_assert(s21::array<char, 0>().empty());
+
+TEST(ArrayTest, ElementAccess) {
+  s21::array<int, 3> a{10, 20};
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(a.max_size(), 3U);
+  EXPECT_FALSE(a.empty());
+  EXPECT_EQ(a.front(), 10);
+  EXPECT_EQ(a.back(), 0);
+  a.at(2) = 30;
+  EXPECT_EQ(a[2], 30);
+  EXPECT_EQ(*a.data(), 10);
+  EXPECT_EQ(a.end() - a.begin(), 3);
+  EXPECT_THROW(a.at(3), std::out_of_range);
+  EXPECT_THROW((s21::array<int, 1>{1, 2}), std::out_of_range);
+
+  int sum = 0;
+  for (int value : a) {
+    sum += value;
+  }
+  EXPECT_EQ(sum, 60);
+}
+
+TEST(ArrayTest, FillAndSwapBulk) {
+  s21::array<std::uint32_t, 1000> a;
+  s21::array<std::uint32_t, 1000> b;
+  a.fill(0xDEADBEEF);
+  b.fill(a[500]);
+  EXPECT_EQ(a, b);
+  b[999] = 1;
+  EXPECT_NE(a, b);
+
+  s21::array<char, 300> bytes;
+  bytes.fill('x');
+  EXPECT_EQ(bytes[0], 'x');
+  EXPECT_EQ(bytes[299], 'x');
+
+  a.swap(b);
+  EXPECT_EQ(a[999], 1U);
+  EXPECT_EQ(b[999], 0xDEADBEEF);
+
+  s21::array<std::string, 3> words{"a", "b", "c"};
+  s21::array<std::string, 3> other;
+  other.fill("z");
+  words.swap(other);
+  EXPECT_EQ(words[1], "z");
+  EXPECT_EQ(other[2], "c");
+}
+
+TEST(ArrayTest, ComparisonsMatchStdArray) {
+  // В little-endian порядке байтов memcmp считал бы 256 меньше 1.
+  s21::array<int, 100> a;
+  s21::array<int, 100> b;
+  a[90] = 256;
+  b[90] = 1;
+  EXPECT_TRUE(b < a);
+  EXPECT_TRUE(a > b);
+  EXPECT_TRUE(b <= a);
+  EXPECT_FALSE(a <= b);
+
+  s21::array<int, 2> negative{-1, 0};
+  s21::array<int, 2> positive{1, 0};
+  EXPECT_TRUE(negative < positive);
+
+  s21::array<unsigned char, 3> low{1, 2, 3};
+  s21::array<unsigned char, 3> high{1, 2, 200};
+  EXPECT_TRUE(low < high);
+  EXPECT_TRUE(high >= low);
+
+  // -0.0 == 0.0, хотя их байты различаются.
+  s21::array<double, 2> zero{0.0, 1.0};
+  s21::array<double, 2> negative_zero{-0.0, 1.0};
+  EXPECT_TRUE(zero == negative_zero);
+  EXPECT_FALSE(zero < negative_zero);
+
+  s21::array<std::string, 2> words{"apple", "pear"};
+  s21::array<std::string, 2> later{"apple", "plum"};
+  EXPECT_TRUE(words < later);
+  EXPECT_TRUE(words != later);
+  EXPECT_TRUE((s21::array<int, 0>{}) == (s21::array<int, 0>{}));
+}
+
+namespace {
+// Равенство учитывает только value: байты tag в сравнении не участвуют.
+struct Tagged {
+  int value;
+  int tag;
+
+  friend bool operator==(const Tagged &lhs, const Tagged &rhs) {
+    return lhs.value == rhs.value;
+  }
+  friend bool operator!=(const Tagged &lhs, const Tagged &rhs) {
+    return !(lhs == rhs);
+  }
+  friend bool operator<(const Tagged &lhs, const Tagged &rhs) {
+    return lhs.value < rhs.value;
+  }
+};
+} // namespace
+
+TEST(ArrayTest, ComparisonsUseElementOperators) {
+  s21::array<Tagged, 2> a{Tagged{1, 10}, Tagged{2, 20}};
+  s21::array<Tagged, 2> b{Tagged{1, 11}, Tagged{2, 21}};
+  std::array<Tagged, 2> std_a{Tagged{1, 10}, Tagged{2, 20}};
+  std::array<Tagged, 2> std_b{Tagged{1, 11}, Tagged{2, 21}};
+  EXPECT_EQ(a == b, std_a == std_b);
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a != b);
+  EXPECT_FALSE(a < b);
+  EXPECT_FALSE(b < a);
+
+  s21::array<Tagged, 100> long_a;
+  s21::array<Tagged, 100> long_b;
+  for (std::size_t i = 0; i < long_a.size(); ++i) {
+    long_a[i] = Tagged{static_cast<int>(i), 0};
+    long_b[i] = Tagged{static_cast<int>(i), 1};
+  }
+  long_b[99].value = 100;
+  EXPECT_TRUE(long_a < long_b);
+  EXPECT_FALSE(long_b < long_a);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
@@ -0,0 +1,114 @@
+#ifndef S21_CONTAINERS_ARRAY_S21_ARRAY_H_
+#define S21_CONTAINERS_ARRAY_S21_ARRAY_H_
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Массив фиксированного размера N. Все операции - constexpr: массив можно
+// заполнять, обменивать и сравнивать в константных выражениях. Вне
+// константных выражений заполнение и сравнение массивов целых чисел,
+// перечислений и указателей сводятся к memset/memcmp, которые стандартная
+// библиотека выполняет векторными инструкциями.
+template <typename T, std::size_t N> class array {
+public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using size_type = std::size_t;
+
+  // Конструкторы и операторы присваивания (деструктор тривиален, иначе
+  // массив не мог бы участвовать в константных выражениях)
+  constexpr array() = default;
+  constexpr array(std::initializer_list<value_type> const &items);
+  constexpr array(const array &other) = default;
+  constexpr array(array &&other) = default;
+  constexpr array &operator=(const array &other) = default;
+  constexpr array &operator=(array &&other) = default;
+
+  // Доступ к элементам
+  constexpr reference at(size_type pos);
+  constexpr const_reference at(size_type pos) const;
+  constexpr reference operator[](size_type pos) noexcept;
+  constexpr const_reference operator[](size_type pos) const noexcept;
+  constexpr reference front() noexcept;
+  constexpr const_reference front() const noexcept;
+  constexpr reference back() noexcept;
+  constexpr const_reference back() const noexcept;
+  constexpr iterator data() noexcept;
+  constexpr const_iterator data() const noexcept;
+
+  // Итераторы
+  constexpr iterator begin() noexcept;
+  constexpr const_iterator begin() const noexcept;
+  constexpr iterator end() noexcept;
+  constexpr const_iterator end() const noexcept;
+
+  // Размеры
+  [[nodiscard]] constexpr bool empty() const noexcept;
+  [[nodiscard]] constexpr size_type size() const noexcept;
+  [[nodiscard]] constexpr size_type max_size() const noexcept;
+
+  // Модификаторы
+  constexpr void swap(array &other) noexcept(std::is_nothrow_swappable_v<T>);
+  constexpr void fill(const_reference value);
+
+  friend constexpr bool operator==(const array &lhs, const array &rhs) {
+    return Equal(lhs, rhs);
+  }
+
+  friend constexpr bool operator!=(const array &lhs, const array &rhs) {
+    return !Equal(lhs, rhs);
+  }
+
+  friend constexpr bool operator<(const array &lhs, const array &rhs) {
+    return Less(lhs, rhs);
+  }
+
+  friend constexpr bool operator>(const array &lhs, const array &rhs) {
+    return Less(rhs, lhs);
+  }
+
+  friend constexpr bool operator<=(const array &lhs, const array &rhs) {
+    return !Less(rhs, lhs);
+  }
+
+  friend constexpr bool operator>=(const array &lhs, const array &rhs) {
+    return !Less(lhs, rhs);
+  }
+
+private:
+  // Равенство элементов совпадает с равенством их байтов. Только для
+  // встроенных типов без заполнителей и значений вроде -0.0 и NaN: у
+  // классов operator== может сравнивать не все поля, и memcmp его обошел бы.
+  static constexpr bool kBytewiseEqual =
+      std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+  // Порядок элементов совпадает с порядком memcmp.
+  static constexpr bool kBytewiseOrdered =
+      std::is_same_v<T, unsigned char> || std::is_same_v<T, std::byte> ||
+      std::is_same_v<T, bool> ||
+      (std::is_same_v<T, char> && !std::is_signed_v<char>);
+  // Размер блока (в байтах), которым сравнение пропускает равный префикс.
+  static constexpr size_type kCompareBlock = 64;
+
+  static constexpr bool IsConstantEvaluated() noexcept;
+  static constexpr bool Equal(const array &lhs, const array &rhs);
+  static constexpr bool Less(const array &lhs, const array &rhs);
+  static size_type EqualPrefix(const T *lhs, const T *rhs) noexcept;
+
+  // Массив нулевой длины в C++ недопустим, поэтому для N == 0 хранится один
+  // неиспользуемый элемент.
+  T data_[N == 0 ? 1 : N]{};
+};
+
+} // namespace s21
+
+#include "s21_array.tpp"
+#endif // S21_CONTAINERS_ARRAY_S21_ARRAY_H_
@@ -0,0 +1,321 @@
+namespace s21 {
+
+/**
+ * @brief Конструктор инициализации на основе списка значений.
+ *
+ * Элементы, для которых в списке не хватило значений, остаются
+ * инициализированными по умолчанию.
+ *
+ * @param items Список значений (не длиннее N).
+ * @throw std::out_of_range Если список длиннее массива.
+ */
+template <typename T, std::size_t N>
+constexpr array<T, N>::array(std::initializer_list<value_type> const &items) {
+  if (items.size() > N) {
+    throw std::out_of_range(
+        "s21::array: Список инициализации длиннее массива.");
+  }
+  size_type index = 0;
+  for (const auto &item : items) {
+    data_[index++] = item;
+  }
+}
+
+/**
+ * @brief Доступ к элементу с проверкой индекса.
+ *
+ * @param pos Индекс элемента.
+ * @return Ссылка на элемент.
+ * @throw std::out_of_range Если pos >= N.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::reference array<T, N>::at(size_type pos) {
+  if (pos >= N) {
+    throw std::out_of_range("s21::array::at: Индекс за пределами массива.");
+  }
+  return data_[pos];
+}
+
+/**
+ * @brief Константный доступ к элементу с проверкой индекса.
+ *
+ * @param pos Индекс элемента.
+ * @return Константная ссылка на элемент.
+ * @throw std::out_of_range Если pos >= N.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::const_reference
+array<T, N>::at(size_type pos) const {
+  if (pos >= N) {
+    throw std::out_of_range("s21::array::at: Индекс за пределами массива.");
+  }
+  return data_[pos];
+}
+
+/**
+ * @brief Доступ к элементу без проверки индекса.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::reference
+array<T, N>::operator[](size_type pos) noexcept {
+  return data_[pos];
+}
+
+/**
+ * @brief Константный доступ к элементу без проверки индекса.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::const_reference
+array<T, N>::operator[](size_type pos) const noexcept {
+  return data_[pos];
+}
+
+/**
+ * @brief Первый элемент (массив не должен быть пустым).
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::reference array<T, N>::front() noexcept {
+  return data_[0];
+}
+
+/**
+ * @brief Первый элемент (массив не должен быть пустым).
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::const_reference
+array<T, N>::front() const noexcept {
+  return data_[0];
+}
+
+/**
+ * @brief Последний элемент (массив не должен быть пустым).
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::reference array<T, N>::back() noexcept {
+  return data_[N - 1];
+}
+
+/**
+ * @brief Последний элемент (массив не должен быть пустым).
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::const_reference
+array<T, N>::back() const noexcept {
+  return data_[N - 1];
+}
+
+/**
+ * @brief Указатель на непрерывный буфер элементов.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::iterator array<T, N>::data() noexcept {
+  return data_;
+}
+
+/**
+ * @brief Константный указатель на непрерывный буфер элементов.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::const_iterator
+array<T, N>::data() const noexcept {
+  return data_;
+}
+
+/**
+ * @brief Итератор на первый элемент.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::iterator array<T, N>::begin() noexcept {
+  return data_;
+}
+
+/**
+ * @brief Константный итератор на первый элемент.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::const_iterator
+array<T, N>::begin() const noexcept {
+  return data_;
+}
+
+/**
+ * @brief Итератор за последним элементом.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::iterator array<T, N>::end() noexcept {
+  return data_ + N;
+}
+
+/**
+ * @brief Константный итератор за последним элементом.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::const_iterator
+array<T, N>::end() const noexcept {
+  return data_ + N;
+}
+
+/**
+ * @brief Проверяет, пуст ли массив (N == 0).
+ */
+template <typename T, std::size_t N>
+constexpr bool array<T, N>::empty() const noexcept {
+  return N == 0;
+}
+
+/**
+ * @brief Возвращает количество элементов.
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::size_type array<T, N>::size() const noexcept {
+  return N;
+}
+
+/**
+ * @brief Возвращает максимально возможное количество элементов (N).
+ */
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::size_type
+array<T, N>::max_size() const noexcept {
+  return N;
+}
+
+/**
+ * @brief Обменивает содержимое двух массивов.
+ *
+ * Простой поэлементный цикл: для тривиально копируемых элементов
+ * компилятор сам превращает его в векторный обмен, а обмен блоками через
+ * memcpy и буфер на стеке оказался в 3 раза медленнее (array_bench.cpp).
+ *
+ * @param other Массив для обмена.
+ */
+template <typename T, std::size_t N>
+constexpr void
+array<T, N>::swap(array &other) noexcept(std::is_nothrow_swappable_v<T>) {
+  for (size_type i = 0; i < N; ++i) {
+    T tmp = std::move(data_[i]);
+    data_[i] = std::move(other.data_[i]);
+    other.data_[i] = std::move(tmp);
+  }
+}
+
+/**
+ * @brief Присваивает всем элементам значение value.
+ *
+ * Однобайтовые целые и перечисления заполняются memset. Остальные - циклом
+ * по копии значения: копия не может совпасть ни с одним элементом, и
+ * компилятор векторизует цикл, не перечитывая значение после каждой записи.
+ *
+ * @param value Значение (может быть элементом этого же массива).
+ */
+template <typename T, std::size_t N>
+constexpr void array<T, N>::fill(const_reference value) {
+  if constexpr ((std::is_integral_v<T> || std::is_enum_v<T>) &&
+                sizeof(T) == 1) {
+    if (!IsConstantEvaluated()) {
+      unsigned char byte = 0;
+      std::memcpy(&byte, &value, 1);
+      std::memset(data_, byte, N);
+      return;
+    }
+  }
+  const T copy = value;
+  for (size_type i = 0; i < N; ++i) {
+    data_[i] = copy;
+  }
+}
+
+/**
+ * @brief Определяет, вычисляется ли вызов в константном выражении.
+ *
+ * Если компилятор не дает это узнать, функция возвращает true, и все
+ * операции выполняются поэлементно.
+ */
+template <typename T, std::size_t N>
+constexpr bool array<T, N>::IsConstantEvaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+  return std::is_constant_evaluated();
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+  return __builtin_is_constant_evaluated();
+#else
+  return true;
+#endif
+#else
+  return true;
+#endif
+}
+
+/**
+ * @brief Поэлементное равенство массивов; для элементов, равенство которых
+ * совпадает с равенством байтов, - один вызов memcmp.
+ */
+template <typename T, std::size_t N>
+constexpr bool array<T, N>::Equal(const array &lhs, const array &rhs) {
+  if constexpr (kBytewiseEqual) {
+    if (!IsConstantEvaluated()) {
+      return std::memcmp(lhs.data_, rhs.data_, N * sizeof(T)) == 0;
+    }
+  }
+  for (size_type i = 0; i < N; ++i) {
+    if (!(lhs.data_[i] == rhs.data_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Лексикографическое сравнение массивов оператором < элементов.
+ *
+ * Для беззнаковых байтов порядок memcmp совпадает с порядком элементов, и
+ * ответ дает один вызов memcmp. Для прочих элементов с побайтовым
+ * равенством memcmp пропускает равный префикс блоками, а поэлементно
+ * сравнивается только блок, в котором массивы различаются.
+ *
+ * @return true, если lhs лексикографически меньше rhs.
+ */
+template <typename T, std::size_t N>
+constexpr bool array<T, N>::Less(const array &lhs, const array &rhs) {
+  size_type start = 0;
+  if constexpr (kBytewiseOrdered) {
+    if (!IsConstantEvaluated()) {
+      return std::memcmp(lhs.data_, rhs.data_, N) < 0;
+    }
+  } else if constexpr (kBytewiseEqual) {
+    if (!IsConstantEvaluated()) {
+      start = EqualPrefix(lhs.data_, rhs.data_);
+    }
+  }
+  for (size_type i = start; i < N; ++i) {
+    if (lhs.data_[i] < rhs.data_[i]) {
+      return true;
+    }
+    if (rhs.data_[i] < lhs.data_[i]) {
+      return false;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Пропускает равный префикс двух буферов блоками по kCompareBlock
+ * байт.
+ *
+ * @return Индекс первого элемента блока, в котором буферы различаются, или
+ * начала неполного последнего блока.
+ */
+template <typename T, std::size_t N>
+typename array<T, N>::size_type
+array<T, N>::EqualPrefix(const T *lhs, const T *rhs) noexcept {
+  constexpr size_type kElements =
+      kCompareBlock / sizeof(T) == 0 ? 1 : kCompareBlock / sizeof(T);
+  size_type index = 0;
+  while (index + kElements <= N &&
+         std::memcmp(lhs + index, rhs + index, kElements * sizeof(T)) == 0) {
+    index += kElements;
+  }
+  return index;
+}
+
+} // namespace s21
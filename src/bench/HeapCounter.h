@@ -0,0 +1,51 @@
+#ifndef S21_CONTAINERS_BENCH_HEAPCOUNTER_H_
+#define S21_CONTAINERS_BENCH_HEAPCOUNTER_H_
+
+// Общий для замеров счетчик кучи: замена глобальных operator new/delete
+// считает обращения к operator new и объем живой памяти. Заголовок
+// подключается в единственную единицу трансляции замера, потому что
+// заменяющие функции не могут быть inline.
+//
+// Байты вычитаются в sized operator delete: контейнеры и std::allocator
+// освобождают память через него, поэтому размер блока не приходится хранить
+// в заголовке перед ним. Память, освобожденная без размера, из live_bytes не
+// вычитается. Выделения с выравниванием (std::align_val_t) не считаются.
+//
+// Замена не встраивается, иначе GCC видит malloc и free вместо пары
+// new/delete и предупреждает о несоответствии (-Wmismatched-new-delete), как
+// в set_test.cpp. Счетчики не атомарные: замеры однопоточные.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace s21::bench {
+// Число вызовов operator new.
+inline std::size_t new_calls = 0;
+// Байты, выделенные operator new и еще не освобожденные.
+inline std::size_t live_bytes = 0;
+} // namespace s21::bench
+
+[[gnu::noinline]] void *operator new(std::size_t size) {
+  void *memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  ++s21::bench::new_calls;
+  s21::bench::live_bytes += size;
+  return memory;
+}
+
+[[gnu::noinline]] void operator delete(void *memory) noexcept {
+  std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void *memory,
+                                       std::size_t size) noexcept {
+  if (memory != nullptr) {
+    s21::bench::live_bytes -= size;
+  }
+  std::free(memory);
+}
+
+#endif // S21_CONTAINERS_BENCH_HEAPCOUNTER_H_
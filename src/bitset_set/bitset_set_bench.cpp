@@ -0,0 +1,144 @@
+// Сравнение s21::bitset_set и s21::set<uint32_t> на плотных и редких
+// наборах идентификаторов: время вставки (по одному ключу и insert_many),
+// задержка поиска, байты на ключ и время объединения и пересечения двух
+// множеств (для s21::set - обходом одного множества с поиском и вставкой в
+// другое).
+//
+// Сборка: g++ -std=c++17 -O2 -mavx2 bitset_set_bench.cpp -o bitset_set_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../bench/HeapCounter.h"
+#include "../set/s21_set.h"
+#include "s21_bitset_set.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// Идентификаторы в нескольких диапазонах по 2М значений, заполненных
+// примерно наполовину.
+std::vector<std::uint32_t> MakeDense(std::size_t count, std::mt19937 &gen) {
+  std::vector<std::uint32_t> keys(count);
+  for (auto &key : keys) {
+    key = static_cast<std::uint32_t>((gen() % 4) * 50000000 + gen() % 2000000);
+  }
+  return keys;
+}
+
+std::vector<std::uint32_t> MakeSparse(std::size_t count, std::mt19937 &gen) {
+  std::vector<std::uint32_t> keys(count);
+  for (auto &key : keys) {
+    key = static_cast<std::uint32_t>(gen());
+  }
+  return keys;
+}
+
+std::size_t Bytes(const s21::bitset_set<std::uint32_t> &set) {
+  return set.memory_usage();
+}
+
+std::size_t Bytes(const s21::set<std::uint32_t> &) { return 0; }
+
+s21::bitset_set<std::uint32_t>
+Union(const s21::bitset_set<std::uint32_t> &lhs,
+      const s21::bitset_set<std::uint32_t> &rhs) {
+  return lhs | rhs;
+}
+
+s21::bitset_set<std::uint32_t>
+Intersection(const s21::bitset_set<std::uint32_t> &lhs,
+             const s21::bitset_set<std::uint32_t> &rhs) {
+  return lhs & rhs;
+}
+
+s21::set<std::uint32_t> Union(const s21::set<std::uint32_t> &lhs,
+                              const s21::set<std::uint32_t> &rhs) {
+  s21::set<std::uint32_t> result = lhs;
+  for (std::uint32_t key : rhs) {
+    result.insert(key);
+  }
+  return result;
+}
+
+s21::set<std::uint32_t> Intersection(const s21::set<std::uint32_t> &lhs,
+                                     const s21::set<std::uint32_t> &rhs) {
+  s21::set<std::uint32_t> result;
+  for (std::uint32_t key : lhs) {
+    if (rhs.contains(key)) {
+      result.insert(key);
+    }
+  }
+  return result;
+}
+
+template <typename Set>
+void Run(const char *name, const std::vector<std::uint32_t> &left,
+         const std::vector<std::uint32_t> &right,
+         const std::vector<std::uint32_t> &probes) {
+  std::size_t before = s21::bench::live_bytes;
+  auto *a = new Set;
+  auto start = Clock::now();
+  for (std::uint32_t key : left) {
+    a->insert(key);
+  }
+  double insert_ms = Milliseconds(start);
+  std::size_t bytes = s21::bench::live_bytes - before;
+  auto *b = new Set;
+  start = Clock::now();
+  b->insert_many(right.begin(), right.end());
+  double insert_many_ms = Milliseconds(start);
+
+  std::size_t found = 0;
+  start = Clock::now();
+  for (std::uint32_t key : probes) {
+    found += a->contains(key);
+  }
+  double lookup_ns = Milliseconds(start) * 1e6 / probes.size();
+
+  start = Clock::now();
+  std::size_t union_size = Union(*a, *b).size();
+  double union_ms = Milliseconds(start);
+  start = Clock::now();
+  std::size_t common = Intersection(*a, *b).size();
+  double intersection_ms = Milliseconds(start);
+
+  std::printf("  %-10s insert %7.2f ms  insert_many %7.2f ms  contains "
+              "%6.1f ns/op  %5.2f bytes/key  | %6.2f ms  & %6.2f ms  (%zu "
+              "%zu %zu)\n",
+              name, insert_ms, insert_many_ms, lookup_ns,
+              static_cast<double>(bytes) / a->size(), union_ms,
+              intersection_ms, found, union_size, common);
+  if (Bytes(*a) != 0 && Bytes(*a) != bytes) {
+    std::printf("  memory_usage() = %zu, в куче %zu\n", Bytes(*a), bytes);
+  }
+  delete a;
+  delete b;
+}
+
+void Compare(const char *title, const std::vector<std::uint32_t> &left,
+             const std::vector<std::uint32_t> &right, std::mt19937 &gen) {
+  std::vector<std::uint32_t> probes = left;
+  probes.insert(probes.end(), right.begin(), right.end());
+  std::shuffle(probes.begin(), probes.end(), gen);
+  std::printf("%s: %zu + %zu keys\n", title, left.size(), right.size());
+  Run<s21::bitset_set<std::uint32_t>>("bitset_set", left, right, probes);
+  Run<s21::set<std::uint32_t>>("set", left, right, probes);
+}
+} // namespace
+
+int main() {
+  std::mt19937 gen(35);
+  Compare("dense IDs", MakeDense(4000000, gen), MakeDense(4000000, gen), gen);
+  Compare("sparse IDs", MakeSparse(500000, gen), MakeSparse(500000, gen), gen);
+  return 0;
+}
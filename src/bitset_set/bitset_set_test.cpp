@@ -0,0 +1,211 @@
+#include "s21_bitset_set.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace s21 {
+namespace {
+using BitsetSet = s21::bitset_set<std::uint32_t>;
+
+void ExpectSameAs(const BitsetSet &actual, const std::set<std::uint32_t> &ref) {
+  ASSERT_EQ(actual.size(), ref.size());
+  EXPECT_TRUE(std::equal(actual.begin(), actual.end(), ref.begin(), ref.end()));
+  if (!ref.empty()) {
+    auto it = actual.end();
+    --it;
+    EXPECT_EQ(*it, *ref.rbegin());
+  }
+}
+
+// Ключи в трех плотных диапазонах (блоки становятся битовыми картами) и
+// редкие ключи по всему диапазону (блоки-массивы).
+std::set<std::uint32_t> RandomKeys(std::mt19937 &gen, std::size_t dense,
+                                   std::size_t sparse) {
+  std::set<std::uint32_t> keys;
+  for (std::size_t i = 0; i < dense; ++i) {
+    keys.insert((gen() % 3) * 65536 * 7 + gen() % 100000);
+  }
+  for (std::size_t i = 0; i < sparse; ++i) {
+    keys.insert(static_cast<std::uint32_t>(gen()));
+  }
+  return keys;
+}
+} // namespace
+
+TEST(BitsetSetTest, EmptySet) {
+  BitsetSet s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.size(), 0U);
+  EXPECT_TRUE(s.begin() == s.end());
+  EXPECT_FALSE(s.contains(0));
+  EXPECT_TRUE(s.find(42) == s.end());
+  EXPECT_EQ(s.rank(100), 0U);
+  EXPECT_EQ(s.max_size(), std::size_t{1} << 32);
+}
+
+TEST(BitsetSetTest, InsertFindErase) {
+  BitsetSet s{5, 1, 0xFFFFFFFF, 70000, 1};
+  EXPECT_EQ(s.size(), 4U);
+  EXPECT_FALSE(s.insert(5).second);
+  auto [it, inserted] = s.insert(65536);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, 65536U);
+  EXPECT_EQ(*++it, 70000U);
+  EXPECT_EQ(*s.find(0xFFFFFFFF), 0xFFFFFFFFU);
+  EXPECT_EQ(s.count(70000), 1U);
+  EXPECT_EQ(s.erase(70001), 0U);
+  EXPECT_EQ(s.erase(70000), 1U);
+  s.erase(s.find(1));
+  std::vector<std::uint32_t> keys(s.begin(), s.end());
+  EXPECT_EQ(keys, (std::vector<std::uint32_t>{5, 65536, 0xFFFFFFFF}));
+
+  s21::bitset_set<std::uint8_t> bytes{255, 0, 7};
+  EXPECT_EQ(*bytes.begin(), 0);
+  EXPECT_EQ(*--bytes.end(), 255);
+  EXPECT_EQ(bytes.max_size(), 256U);
+}
+
+TEST(BitsetSetTest, RandomOperationsMatchStdSet) {
+  std::mt19937 gen(35);
+  BitsetSet s;
+  std::set<std::uint32_t> ref;
+  // Блок 0 переходит от массива к карте и обратно несколько раз.
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 20000; ++i) {
+      std::uint32_t key = gen() % 10000 + (gen() % 8 == 0 ? gen() : 0);
+      EXPECT_EQ(s.insert(key).second, ref.insert(key).second);
+    }
+    ExpectSameAs(s, ref);
+    for (int i = 0; i < 25000; ++i) {
+      std::uint32_t key = gen() % 10000;
+      EXPECT_EQ(s.erase(key), ref.erase(key));
+    }
+    ExpectSameAs(s, ref);
+  }
+  for (std::uint32_t key = 0; key < 10000; key += 7) {
+    EXPECT_EQ(s.contains(key), ref.count(key) == 1);
+    EXPECT_EQ(s.rank(key), static_cast<std::size_t>(std::distance(
+                               ref.begin(), ref.lower_bound(key))));
+  }
+}
+
+TEST(BitsetSetTest, IteratorsWalkBothWays) {
+  BitsetSet s;
+  for (std::uint32_t key = 0; key < 20000; key += 3) {
+    s.insert(key);
+  }
+  s.insert(1000000);
+  std::vector<std::uint32_t> backward;
+  for (auto it = s.end(); it != s.begin();) {
+    backward.push_back(*--it);
+  }
+  std::vector<std::uint32_t> forward(s.begin(), s.end());
+  std::reverse(backward.begin(), backward.end());
+  EXPECT_EQ(forward, backward);
+  EXPECT_EQ(forward.size(), s.size());
+  EXPECT_EQ(forward.back(), 1000000U);
+}
+
+TEST(BitsetSetTest, SetAlgebraMatchesStdAlgorithms) {
+  std::mt19937 gen(135);
+  auto left = RandomKeys(gen, 150000, 2000);
+  auto right = RandomKeys(gen, 150000, 2000);
+  // Мелкие блоки-массивы и совпадающие блоки разного вида.
+  for (std::uint32_t key = 0; key < 3000; ++key) {
+    left.insert(65536 * 20 + key * 2);
+    right.insert(65536 * 20 + key * 3);
+  }
+  BitsetSet a;
+  BitsetSet b;
+  EXPECT_EQ(a.insert_many(left.begin(), left.end()), left.size());
+  for (auto key : right) {
+    b.insert(key);
+  }
+
+  auto check = [](const BitsetSet &actual, auto algorithm,
+                  const std::set<std::uint32_t> &x,
+                  const std::set<std::uint32_t> &y) {
+    std::set<std::uint32_t> expected;
+    algorithm(x.begin(), x.end(), y.begin(), y.end(),
+              std::inserter(expected, expected.end()));
+    ExpectSameAs(actual, expected);
+  };
+  using It = std::set<std::uint32_t>::const_iterator;
+  using Out = std::insert_iterator<std::set<std::uint32_t>>;
+  check(a | b, std::set_union<It, It, Out>, left, right);
+  check(a & b, std::set_intersection<It, It, Out>, left, right);
+  check(a - b, std::set_difference<It, It, Out>, left, right);
+  check(b - a, std::set_difference<It, It, Out>, right, left);
+  check(a ^ b, std::set_symmetric_difference<It, It, Out>, left, right);
+
+  BitsetSet c = a;
+  c |= b;
+  EXPECT_EQ(c, a | b);
+  BitsetSet d = a;
+  EXPECT_EQ(d.insert_many(right.begin(), right.end()), (b - a).size());
+  EXPECT_EQ(d, c);
+  c &= a;
+  EXPECT_EQ(c, a);
+  c -= b;
+  EXPECT_EQ(c, a - b);
+  c ^= c;
+  EXPECT_TRUE(c.empty());
+}
+
+TEST(BitsetSetTest, CopyMoveMergeAndEquality) {
+  BitsetSet a;
+  for (std::uint32_t key = 0; key < 5000; ++key) {
+    a.insert(key);
+  }
+  BitsetSet b = a;
+  EXPECT_EQ(a, b);
+  // В b после удаления блок остается битовой картой (3000 ключей не
+  // меньше kArrayMin), а в c те же ключи хранятся массивом.
+  for (std::uint32_t key = 3000; key < 5000; ++key) {
+    b.erase(key);
+  }
+  BitsetSet c;
+  for (std::uint32_t key = 0; key < 3000; ++key) {
+    c.insert(key);
+  }
+  EXPECT_EQ(b, c);
+  EXPECT_NE(a, c);
+
+  BitsetSet moved = std::move(b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(moved, c);
+
+  BitsetSet extra{2999, 3000, 100000};
+  c.merge(extra);
+  EXPECT_EQ(c.size(), 3002U);
+  // Как s21::set::merge: источник пуст, общий ключ 2999 в нем не остается.
+  EXPECT_TRUE(extra.empty());
+  BitsetSet same = c;
+  c.merge(same);
+  EXPECT_EQ(c.size(), 3002U);
+  EXPECT_TRUE(same.empty());
+  c.merge(c);
+  EXPECT_EQ(c.size(), 3002U);
+}
+
+TEST(BitsetSetTest, DenseKeysUseAboutOneBitEach) {
+  BitsetSet s;
+  for (std::uint32_t key = 1000000; key < 2000000; ++key) {
+    s.insert(key);
+  }
+  EXPECT_EQ(s.size(), 1000000U);
+  // 1М ключей - 16 блоков-карт по 8 КБ.
+  EXPECT_LT(s.memory_usage(), 1000000U / 8 + 20 * 8192);
+  EXPECT_EQ(s.rank(1500000), 500000U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
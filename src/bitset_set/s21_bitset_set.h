@@ -0,0 +1,244 @@
+#ifndef S21_CONTAINERS_BITSET_SET_S21_BITSET_SET_H_
+#define S21_CONTAINERS_BITSET_SET_S21_BITSET_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+// Множество беззнаковых целых ключей (не шире 32 бит) в виде сжатой битовой
+// карты (схема Roaring). Ключи делятся на блоки по 65536 значений со
+// значением старших 16 бит; блок хранит младшие 16 бит своих ключей
+// либо отсортированным массивом (до kArrayMax ключей, 2 байта на ключ),
+// либо битовой картой на 8 КБ. Плотные диапазоны идентификаторов стоят
+// около бита на ключ вместо узла дерева на ключ, а объединение, пересечение
+// и разность битовых карт выполняются словами по 256 (AVX2) или 128 (SSE2)
+// бит.
+//
+// Итераторы становятся недействительными после любого изменения
+// контейнера.
+template <typename Key = std::uint32_t> class bitset_set {
+  static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value &&
+                    sizeof(Key) <= sizeof(std::uint32_t),
+                "s21::bitset_set поддерживает только беззнаковые ключи "
+                "не шире 32 бит");
+
+private:
+  struct Chunk;
+  struct BitsetSetIterator;
+
+public:
+  using key_type = Key;
+  using value_type = key_type;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using iterator = BitsetSetIterator;
+  using const_iterator = BitsetSetIterator;
+  using size_type = std::size_t;
+
+  // Конструкторы и операторы присваивания
+  bitset_set() noexcept = default;
+  bitset_set(std::initializer_list<value_type> const &items);
+  bitset_set(const bitset_set &other) = default;
+  bitset_set(bitset_set &&other) noexcept;
+  bitset_set &operator=(const bitset_set &other) = default;
+  bitset_set &operator=(bitset_set &&other) noexcept;
+  ~bitset_set() = default;
+
+  // Операции сравнения
+  friend bool operator==(const bitset_set &lhs, const bitset_set &rhs) {
+    return Equal(lhs, rhs);
+  }
+
+  friend bool operator!=(const bitset_set &lhs, const bitset_set &rhs) {
+    return !Equal(lhs, rhs);
+  }
+
+  // Теоретико-множественные операции
+  friend bitset_set operator|(const bitset_set &lhs, const bitset_set &rhs) {
+    return Combine<kUnion>(lhs, rhs);
+  }
+
+  friend bitset_set operator&(const bitset_set &lhs, const bitset_set &rhs) {
+    return Combine<kIntersection>(lhs, rhs);
+  }
+
+  friend bitset_set operator-(const bitset_set &lhs, const bitset_set &rhs) {
+    return Combine<kDifference>(lhs, rhs);
+  }
+
+  friend bitset_set operator^(const bitset_set &lhs, const bitset_set &rhs) {
+    return Combine<kSymmetricDifference>(lhs, rhs);
+  }
+
+  bitset_set &operator|=(const bitset_set &other);
+  bitset_set &operator&=(const bitset_set &other);
+  bitset_set &operator-=(const bitset_set &other);
+  bitset_set &operator^=(const bitset_set &other);
+
+  // Итераторы
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+  [[nodiscard]] size_type max_size() const noexcept;
+  [[nodiscard]] size_type memory_usage() const noexcept;
+
+  // Модификаторы
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(value_type value);
+  void erase(iterator pos);
+  size_type erase(key_type key);
+  void swap(bitset_set &other) noexcept;
+  void merge(bitset_set &other);
+
+  // Вставка нескольких ключей за один проход по блокам
+  template <typename InputIt>
+  size_type insert_many(InputIt first, InputIt last);
+
+  // Поиск
+  iterator find(key_type key) const noexcept;
+  bool contains(key_type key) const noexcept;
+  size_type count(key_type key) const noexcept;
+  size_type rank(key_type key) const noexcept;
+
+private:
+  enum SetOperation {
+    kUnion,
+    kIntersection,
+    kDifference,
+    kSymmetricDifference
+  };
+
+  // Слов по 64 бита в битовой карте блока.
+  static constexpr std::uint32_t kBitmapWords = 65536 / 64;
+  // Наибольший размер массива: дальше битовая карта (8 КБ) компактнее.
+  static constexpr std::uint32_t kArrayMax = 4096;
+  // Битовая карта превращается обратно в массив, только когда ключей стало
+  // вдвое меньше kArrayMax: чередование вставки и удаления на границе не
+  // перестраивает блок каждый раз.
+  static constexpr std::uint32_t kArrayMin = kArrayMax / 2;
+
+  struct Chunk {
+    bool IsBitmap() const noexcept { return !bitmap_.empty(); }
+
+    std::uint16_t high_ = 0;
+    std::uint32_t size_ = 0;
+    // Отсортированные младшие 16 бит ключей (если bitmap_ пуст).
+    std::vector<std::uint16_t> array_;
+    // kBitmapWords слов или пусто.
+    std::vector<std::uint64_t> bitmap_;
+  };
+
+  // Номер бита, которого нет в битовой карте блока.
+  static constexpr std::uint32_t kNoBit = 65536;
+
+  static std::uint16_t High(key_type key) noexcept;
+  static std::uint16_t Low(key_type key) noexcept;
+  static bool Contains(const Chunk &chunk, std::uint16_t low) noexcept;
+  static bool InsertLow(Chunk &chunk, std::uint16_t low);
+  static bool EraseLow(Chunk &chunk, std::uint16_t low);
+  static void ToBitmap(Chunk &chunk);
+  static void ToArray(Chunk &chunk);
+  static void Normalize(Chunk &chunk);
+  static std::uint32_t FirstPos(const Chunk &chunk) noexcept;
+  static std::uint32_t LastPos(const Chunk &chunk) noexcept;
+  static std::uint32_t RankLow(const Chunk &chunk, std::uint16_t low) noexcept;
+  static bool EqualChunks(const Chunk &lhs, const Chunk &rhs) noexcept;
+  static bool Equal(const bitset_set &lhs, const bitset_set &rhs) noexcept;
+  template <SetOperation Op, typename Source>
+  static bitset_set Combine(Source &&lhs, const bitset_set &rhs);
+  template <SetOperation Op>
+  static Chunk CombineChunks(Chunk lhs, const Chunk &rhs);
+  template <SetOperation Op>
+  static void CombineArrays(const Chunk &lhs, const Chunk &rhs, Chunk &out);
+  template <SetOperation Op>
+  static std::uint32_t CombineBitmaps(const std::uint64_t *lhs,
+                                      const std::uint64_t *rhs,
+                                      std::uint64_t *out) noexcept;
+  static std::uint32_t PopCount(const std::uint64_t *words) noexcept;
+  static std::uint32_t FirstBit(const std::uint64_t *words,
+                                std::uint32_t from) noexcept;
+  static std::uint32_t LastBit(const std::uint64_t *words,
+                               std::uint32_t before) noexcept;
+
+  size_type FindChunk(std::uint16_t high) const noexcept;
+
+  // Позиция итератора: номер блока и номер ключа в массиве блока либо
+  // номер бита в его битовой карте. Ключ хранится в итераторе, чтобы
+  // operator* мог вернуть ссылку.
+  struct BitsetSetIterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = bitset_set::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    BitsetSetIterator() = delete;
+
+    BitsetSetIterator(const bitset_set *owner, size_type chunk,
+                      std::uint32_t pos) noexcept
+        : owner_(owner), chunk_(chunk), pos_(pos) {
+      Load();
+    }
+
+    reference operator*() const noexcept { return value_; }
+
+    pointer operator->() const noexcept { return &value_; }
+
+    iterator &operator++() noexcept;
+
+    iterator operator++(int) noexcept {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    iterator &operator--() noexcept;
+
+    iterator operator--(int) noexcept {
+      iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const iterator &other) const noexcept {
+      return chunk_ == other.chunk_ && pos_ == other.pos_;
+    }
+
+    bool operator!=(const iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+    void Load() noexcept;
+
+    const bitset_set *owner_;
+    size_type chunk_;
+    std::uint32_t pos_;
+    value_type value_ = 0;
+  };
+
+  // Непустые блоки в порядке возрастания старших 16 бит.
+  std::vector<Chunk> chunks_;
+  size_type size_ = 0;
+};
+
+} // namespace s21
+
+#include "s21_bitset_set.tpp"
+#endif // S21_CONTAINERS_BITSET_SET_S21_BITSET_SET_H_
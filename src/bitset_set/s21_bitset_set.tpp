@@ -0,0 +1,910 @@
+namespace s21 {
+
+/**
+ * @brief Конструктор инициализации на основе списка значений.
+ *
+ * Повторяющиеся ключи пропускаются, как и в s21::set.
+ *
+ * @param items Список ключей для инициализации контейнера.
+ */
+template <typename Key>
+bitset_set<Key>::bitset_set(std::initializer_list<value_type> const &items) {
+  for (value_type item : items) {
+    insert(item);
+  }
+}
+
+/**
+ * @brief Конструктор перемещения. Забирает блоки у other.
+ *
+ * @param other Контейнер, который после перемещения становится пустым.
+ */
+template <typename Key>
+bitset_set<Key>::bitset_set(bitset_set &&other) noexcept {
+  swap(other);
+}
+
+/**
+ * @brief Перемещающее присваивание.
+ *
+ * @param other Контейнер, содержимое которого перемещается.
+ * @return Ссылка на текущий контейнер.
+ */
+template <typename Key>
+bitset_set<Key> &bitset_set<Key>::operator=(bitset_set &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Объединение с other на месте: блоки текущего множества не
+ * копируются, а переносятся в результат.
+ */
+template <typename Key>
+bitset_set<Key> &bitset_set<Key>::operator|=(const bitset_set &other) {
+  if (this != &other) {
+    *this = Combine<kUnion>(*this, other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Пересечение с other на месте.
+ */
+template <typename Key>
+bitset_set<Key> &bitset_set<Key>::operator&=(const bitset_set &other) {
+  if (this != &other) {
+    *this = Combine<kIntersection>(*this, other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Удаляет ключи, которые есть в other.
+ */
+template <typename Key>
+bitset_set<Key> &bitset_set<Key>::operator-=(const bitset_set &other) {
+  if (this == &other) {
+    clear();
+  } else {
+    *this = Combine<kDifference>(*this, other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Симметрическая разность с other на месте.
+ */
+template <typename Key>
+bitset_set<Key> &bitset_set<Key>::operator^=(const bitset_set &other) {
+  if (this == &other) {
+    clear();
+  } else {
+    *this = Combine<kSymmetricDifference>(*this, other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Итератор на наименьший ключ.
+ */
+template <typename Key>
+typename bitset_set<Key>::iterator bitset_set<Key>::begin() const noexcept {
+  if (chunks_.empty()) {
+    return end();
+  }
+  return iterator(this, 0, FirstPos(chunks_.front()));
+}
+
+/**
+ * @brief Итератор за наибольшим ключом.
+ */
+template <typename Key>
+typename bitset_set<Key>::iterator bitset_set<Key>::end() const noexcept {
+  return iterator(this, chunks_.size(), 0);
+}
+
+/**
+ * @brief Проверяет, пуст ли контейнер.
+ */
+template <typename Key> bool bitset_set<Key>::empty() const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Возвращает количество ключей (сумма размеров блоков, которые
+ * поддерживаются при каждом изменении).
+ */
+template <typename Key>
+typename bitset_set<Key>::size_type bitset_set<Key>::size() const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Возвращает максимально возможное количество ключей: все значения
+ * типа Key.
+ */
+template <typename Key>
+typename bitset_set<Key>::size_type
+bitset_set<Key>::max_size() const noexcept {
+  return static_cast<size_type>(std::numeric_limits<key_type>::max()) + 1;
+}
+
+/**
+ * @brief Возвращает объем памяти контейнера в байтах: сам объект, массив
+ * блоков и буферы их массивов и битовых карт.
+ */
+template <typename Key>
+typename bitset_set<Key>::size_type
+bitset_set<Key>::memory_usage() const noexcept {
+  size_type bytes = sizeof(*this) + chunks_.capacity() * sizeof(Chunk);
+  for (const Chunk &chunk : chunks_) {
+    bytes += chunk.array_.capacity() * sizeof(std::uint16_t) +
+             chunk.bitmap_.capacity() * sizeof(std::uint64_t);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Удаляет все ключи и освобождает блоки.
+ */
+template <typename Key> void bitset_set<Key>::clear() noexcept {
+  chunks_.clear();
+  size_ = 0;
+}
+
+/**
+ * @brief Вставляет ключ.
+ *
+ * Блок ищется двоичным поиском по старшим 16 битам и создается, если его
+ * нет. Массив, выросший больше kArrayMax, превращается в битовую карту.
+ *
+ * @param value Вставляемый ключ.
+ * @return Пара из итератора на ключ и признака того, что ключа не было.
+ */
+template <typename Key>
+std::pair<typename bitset_set<Key>::iterator, bool>
+bitset_set<Key>::insert(value_type value) {
+  std::uint16_t high = High(value);
+  std::uint16_t low = Low(value);
+  size_type index = FindChunk(high);
+  if (index == chunks_.size() || chunks_[index].high_ != high) {
+    Chunk chunk;
+    chunk.high_ = high;
+    chunks_.insert(chunks_.begin() + index, std::move(chunk));
+  }
+  Chunk &chunk = chunks_[index];
+  bool inserted = InsertLow(chunk, low);
+  size_ += inserted;
+  std::uint32_t pos = low;
+  if (!chunk.IsBitmap()) {
+    pos = static_cast<std::uint32_t>(
+        std::lower_bound(chunk.array_.begin(), chunk.array_.end(), low) -
+        chunk.array_.begin());
+  }
+  return {iterator(this, index, pos), inserted};
+}
+
+/**
+ * @brief Удаляет ключ, на который указывает итератор.
+ *
+ * @param pos Итератор на существующий ключ.
+ */
+template <typename Key> void bitset_set<Key>::erase(iterator pos) {
+  erase(*pos);
+}
+
+/**
+ * @brief Удаляет ключ. Опустевший блок удаляется, битовая карта, в которой
+ * осталось меньше kArrayMin ключей, превращается в массив.
+ *
+ * @param key Удаляемый ключ.
+ * @return Количество удаленных ключей (0 или 1).
+ */
+template <typename Key>
+typename bitset_set<Key>::size_type bitset_set<Key>::erase(key_type key) {
+  size_type index = FindChunk(High(key));
+  if (index == chunks_.size() || chunks_[index].high_ != High(key) ||
+      !EraseLow(chunks_[index], Low(key))) {
+    return 0;
+  }
+  --size_;
+  if (chunks_[index].size_ == 0) {
+    chunks_.erase(chunks_.begin() + index);
+  }
+  return 1;
+}
+
+/**
+ * @brief Обменивает содержимое двух контейнеров.
+ */
+template <typename Key> void bitset_set<Key>::swap(bitset_set &other) noexcept {
+  chunks_.swap(other.chunks_);
+  std::swap(size_, other.size_);
+}
+
+/**
+ * @brief Переносит в текущий контейнер ключи other, которых в нем нет.
+ *
+ * Как и s21::set::merge, опустошает other: ключи, которые уже были в
+ * текущем контейнере, отбрасываются.
+ *
+ * @param other Контейнер-источник.
+ */
+template <typename Key> void bitset_set<Key>::merge(bitset_set &other) {
+  if (this == &other) {
+    return;
+  }
+  *this |= other;
+  other.clear();
+}
+
+/**
+ * @brief Вставляет ключи диапазона [first, last).
+ *
+ * Вставка по одному ключу создает блоки в середине отсортированного
+ * массива блоков, и каждый новый блок сдвигает все следующие. Здесь ключи
+ * сортируются и группируются по блокам, каждый затронутый блок
+ * объединяется со своей группой, и массив блоков собирается заново за один
+ * проход. Пока блоки не перенесены в новый массив, текущее содержимое не
+ * меняется, поэтому при исключении контейнер остается прежним.
+ *
+ * @return Количество ключей, которых не было в контейнере.
+ */
+template <typename Key>
+template <typename InputIt>
+typename bitset_set<Key>::size_type
+bitset_set<Key>::insert_many(InputIt first, InputIt last) {
+  std::vector<value_type> keys(first, last);
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  // Новые версии затронутых блоков (существующие блоки копируются).
+  std::vector<Chunk> updated;
+  for (size_type k = 0; k < keys.size();) {
+    Chunk group;
+    group.high_ = High(keys[k]);
+    for (; k < keys.size() && High(keys[k]) == group.high_; ++k) {
+      group.array_.push_back(Low(keys[k]));
+    }
+    group.size_ = static_cast<std::uint32_t>(group.array_.size());
+    size_type index = FindChunk(group.high_);
+    if (index != chunks_.size() && chunks_[index].high_ == group.high_) {
+      updated.push_back(CombineChunks<kUnion>(chunks_[index], group));
+    } else {
+      Normalize(group);
+      updated.push_back(std::move(group));
+    }
+  }
+
+  std::vector<Chunk> chunks;
+  chunks.reserve(chunks_.size() + updated.size());
+  size_type i = 0;
+  size_type old_size = size_;
+  size_ = 0;
+  for (Chunk &chunk : updated) {
+    for (; i < chunks_.size() && chunks_[i].high_ < chunk.high_; ++i) {
+      size_ += chunks_[i].size_;
+      chunks.push_back(std::move(chunks_[i]));
+    }
+    if (i < chunks_.size() && chunks_[i].high_ == chunk.high_) {
+      ++i;
+    }
+    size_ += chunk.size_;
+    chunks.push_back(std::move(chunk));
+  }
+  for (; i < chunks_.size(); ++i) {
+    size_ += chunks_[i].size_;
+    chunks.push_back(std::move(chunks_[i]));
+  }
+  chunks_.swap(chunks);
+  return size_ - old_size;
+}
+
+/**
+ * @brief Ищет ключ.
+ *
+ * @return Итератор на ключ или end(), если ключа нет.
+ */
+template <typename Key>
+typename bitset_set<Key>::iterator
+bitset_set<Key>::find(key_type key) const noexcept {
+  std::uint16_t low = Low(key);
+  size_type index = FindChunk(High(key));
+  if (index == chunks_.size() || chunks_[index].high_ != High(key)) {
+    return end();
+  }
+  const Chunk &chunk = chunks_[index];
+  if (chunk.IsBitmap()) {
+    return Contains(chunk, low) ? iterator(this, index, low) : end();
+  }
+  auto it = std::lower_bound(chunk.array_.begin(), chunk.array_.end(), low);
+  if (it == chunk.array_.end() || *it != low) {
+    return end();
+  }
+  return iterator(this, index,
+                  static_cast<std::uint32_t>(it - chunk.array_.begin()));
+}
+
+/**
+ * @brief Проверяет наличие ключа: двоичный поиск блока, затем один бит
+ * карты или двоичный поиск в массиве блока.
+ */
+template <typename Key>
+bool bitset_set<Key>::contains(key_type key) const noexcept {
+  size_type index = FindChunk(High(key));
+  return index != chunks_.size() && chunks_[index].high_ == High(key) &&
+         Contains(chunks_[index], Low(key));
+}
+
+/**
+ * @brief Возвращает количество ключей, равных key (0 или 1).
+ */
+template <typename Key>
+typename bitset_set<Key>::size_type
+bitset_set<Key>::count(key_type key) const noexcept {
+  return contains(key);
+}
+
+/**
+ * @brief Возвращает количество ключей, меньших key (номер, под которым key
+ * стоит или встал бы в упорядоченной последовательности).
+ *
+ * Размеры предыдущих блоков суммируются, а внутри блока битовой карты
+ * ключи считаются инструкцией popcount по словам, без обхода.
+ */
+template <typename Key>
+typename bitset_set<Key>::size_type
+bitset_set<Key>::rank(key_type key) const noexcept {
+  size_type index = FindChunk(High(key));
+  size_type result = 0;
+  for (size_type i = 0; i < index; ++i) {
+    result += chunks_[i].size_;
+  }
+  if (index != chunks_.size() && chunks_[index].high_ == High(key)) {
+    result += RankLow(chunks_[index], Low(key));
+  }
+  return result;
+}
+
+/**
+ * @brief Старшие 16 бит ключа: номер блока.
+ */
+template <typename Key>
+std::uint16_t bitset_set<Key>::High(key_type key) noexcept {
+  return static_cast<std::uint16_t>(static_cast<std::uint32_t>(key) >> 16);
+}
+
+/**
+ * @brief Младшие 16 бит ключа: положение внутри блока.
+ */
+template <typename Key>
+std::uint16_t bitset_set<Key>::Low(key_type key) noexcept {
+  return static_cast<std::uint16_t>(key);
+}
+
+/**
+ * @brief Проверяет, есть ли в блоке ключ с младшими битами low.
+ */
+template <typename Key>
+bool bitset_set<Key>::Contains(const Chunk &chunk, std::uint16_t low) noexcept {
+  if (chunk.IsBitmap()) {
+    return (chunk.bitmap_[low >> 6] >> (low & 63)) & 1;
+  }
+  return std::binary_search(chunk.array_.begin(), chunk.array_.end(), low);
+}
+
+/**
+ * @brief Добавляет в блок младшие биты low.
+ *
+ * @return true, если их в блоке не было.
+ */
+template <typename Key>
+bool bitset_set<Key>::InsertLow(Chunk &chunk, std::uint16_t low) {
+  if (chunk.IsBitmap()) {
+    std::uint64_t &word = chunk.bitmap_[low >> 6];
+    std::uint64_t mask = std::uint64_t{1} << (low & 63);
+    if (word & mask) {
+      return false;
+    }
+    word |= mask;
+    ++chunk.size_;
+    return true;
+  }
+  auto it = std::lower_bound(chunk.array_.begin(), chunk.array_.end(), low);
+  if (it != chunk.array_.end() && *it == low) {
+    return false;
+  }
+  chunk.array_.insert(it, low);
+  if (++chunk.size_ > kArrayMax) {
+    ToBitmap(chunk);
+  }
+  return true;
+}
+
+/**
+ * @brief Удаляет из блока младшие биты low.
+ *
+ * @return true, если они были в блоке.
+ */
+template <typename Key>
+bool bitset_set<Key>::EraseLow(Chunk &chunk, std::uint16_t low) {
+  if (chunk.IsBitmap()) {
+    std::uint64_t &word = chunk.bitmap_[low >> 6];
+    std::uint64_t mask = std::uint64_t{1} << (low & 63);
+    if (!(word & mask)) {
+      return false;
+    }
+    word &= ~mask;
+    if (--chunk.size_ < kArrayMin) {
+      ToArray(chunk);
+    }
+    return true;
+  }
+  auto it = std::lower_bound(chunk.array_.begin(), chunk.array_.end(), low);
+  if (it == chunk.array_.end() || *it != low) {
+    return false;
+  }
+  chunk.array_.erase(it);
+  --chunk.size_;
+  return true;
+}
+
+/**
+ * @brief Переводит блок из массива в битовую карту и освобождает массив.
+ */
+template <typename Key> void bitset_set<Key>::ToBitmap(Chunk &chunk) {
+  chunk.bitmap_.assign(kBitmapWords, 0);
+  for (std::uint16_t low : chunk.array_) {
+    chunk.bitmap_[low >> 6] |= std::uint64_t{1} << (low & 63);
+  }
+  std::vector<std::uint16_t>().swap(chunk.array_);
+}
+
+/**
+ * @brief Переводит блок из битовой карты в массив и освобождает карту.
+ *
+ * Установленные биты извлекаются по одному: номер младшего бита слова,
+ * затем сброс этого бита.
+ */
+template <typename Key> void bitset_set<Key>::ToArray(Chunk &chunk) {
+  std::vector<std::uint16_t> array;
+  array.reserve(chunk.size_);
+  for (std::uint32_t i = 0; i < kBitmapWords; ++i) {
+    for (std::uint64_t word = chunk.bitmap_[i]; word != 0; word &= word - 1) {
+      array.push_back(
+          static_cast<std::uint16_t>(i * 64 + __builtin_ctzll(word)));
+    }
+  }
+  chunk.array_.swap(array);
+  std::vector<std::uint64_t>().swap(chunk.bitmap_);
+}
+
+/**
+ * @brief Выбирает для блока после теоретико-множественной операции более
+ * компактное представление.
+ */
+template <typename Key> void bitset_set<Key>::Normalize(Chunk &chunk) {
+  if (chunk.IsBitmap() && chunk.size_ <= kArrayMax) {
+    ToArray(chunk);
+  } else if (!chunk.IsBitmap() && chunk.size_ > kArrayMax) {
+    ToBitmap(chunk);
+  }
+}
+
+/**
+ * @brief Позиция наименьшего ключа непустого блока.
+ */
+template <typename Key>
+std::uint32_t bitset_set<Key>::FirstPos(const Chunk &chunk) noexcept {
+  return chunk.IsBitmap() ? FirstBit(chunk.bitmap_.data(), 0) : 0;
+}
+
+/**
+ * @brief Позиция наибольшего ключа непустого блока.
+ */
+template <typename Key>
+std::uint32_t bitset_set<Key>::LastPos(const Chunk &chunk) noexcept {
+  return chunk.IsBitmap() ? LastBit(chunk.bitmap_.data(), kNoBit)
+                          : chunk.size_ - 1;
+}
+
+/**
+ * @brief Количество ключей блока с младшими битами меньше low.
+ */
+template <typename Key>
+std::uint32_t bitset_set<Key>::RankLow(const Chunk &chunk,
+                                       std::uint16_t low) noexcept {
+  if (!chunk.IsBitmap()) {
+    return static_cast<std::uint32_t>(
+        std::lower_bound(chunk.array_.begin(), chunk.array_.end(), low) -
+        chunk.array_.begin());
+  }
+  std::uint32_t result = 0;
+  for (std::uint32_t i = 0; i < (low >> 6); ++i) {
+    result += __builtin_popcountll(chunk.bitmap_[i]);
+  }
+  std::uint64_t below = (std::uint64_t{1} << (low & 63)) - 1;
+  return result + __builtin_popcountll(chunk.bitmap_[low >> 6] & below);
+}
+
+/**
+ * @brief Сравнивает содержимое двух блоков.
+ *
+ * Из-за запаса между kArrayMin и kArrayMax одинаковые блоки могут быть
+ * представлены по-разному; тогда каждый ключ массива ищется в карте.
+ */
+template <typename Key>
+bool bitset_set<Key>::EqualChunks(const Chunk &lhs, const Chunk &rhs) noexcept {
+  if (lhs.high_ != rhs.high_ || lhs.size_ != rhs.size_) {
+    return false;
+  }
+  if (lhs.IsBitmap() == rhs.IsBitmap()) {
+    return lhs.array_ == rhs.array_ && lhs.bitmap_ == rhs.bitmap_;
+  }
+  const Chunk &array = lhs.IsBitmap() ? rhs : lhs;
+  const Chunk &bitmap = lhs.IsBitmap() ? lhs : rhs;
+  return std::all_of(
+      array.array_.begin(), array.array_.end(),
+      [&bitmap](std::uint16_t low) { return Contains(bitmap, low); });
+}
+
+/**
+ * @brief Поблочное сравнение двух множеств.
+ */
+template <typename Key>
+bool bitset_set<Key>::Equal(const bitset_set &lhs,
+                            const bitset_set &rhs) noexcept {
+  return lhs.size_ == rhs.size_ &&
+         std::equal(lhs.chunks_.begin(), lhs.chunks_.end(),
+                    rhs.chunks_.begin(), rhs.chunks_.end(), EqualChunks);
+}
+
+/**
+ * @brief Теоретико-множественная операция Op над lhs и rhs.
+ *
+ * Списки блоков сливаются по старшим 16 битам за один проход; блок,
+ * который есть только в одном операнде, копируется в результат целиком
+ * (или отбрасывается), и только общие блоки обрабатываются поключево или
+ * по словам карты. Если lhs - неконстантная ссылка (составные операторы
+ * присваивания), его блоки переносятся в результат без копирования.
+ *
+ * @return Множество-результат.
+ */
+template <typename Key>
+template <typename bitset_set<Key>::SetOperation Op, typename Source>
+bitset_set<Key> bitset_set<Key>::Combine(Source &&lhs, const bitset_set &rhs) {
+  constexpr bool kReuseLhs = !std::is_const<std::remove_reference_t<Source>>{};
+  auto take = [&lhs](size_type i) -> Chunk {
+    if constexpr (kReuseLhs) {
+      return std::move(lhs.chunks_[i]);
+    } else {
+      return lhs.chunks_[i];
+    }
+  };
+
+  bitset_set result;
+  const size_type left_count = lhs.chunks_.size();
+  const size_type right_count = rhs.chunks_.size();
+  result.chunks_.reserve(Op == kIntersection
+                             ? std::min(left_count, right_count)
+                             : left_count + right_count);
+  size_type i = 0;
+  size_type j = 0;
+  while (i < left_count || j < right_count) {
+    if (j == right_count ||
+        (i < left_count && lhs.chunks_[i].high_ < rhs.chunks_[j].high_)) {
+      if (Op != kIntersection) {
+        result.chunks_.push_back(take(i));
+      }
+      ++i;
+    } else if (i == left_count ||
+               rhs.chunks_[j].high_ < lhs.chunks_[i].high_) {
+      if (Op == kUnion || Op == kSymmetricDifference) {
+        result.chunks_.push_back(rhs.chunks_[j]);
+      }
+      ++j;
+    } else {
+      Chunk chunk = CombineChunks<Op>(take(i), rhs.chunks_[j]);
+      if (chunk.size_ != 0) {
+        result.chunks_.push_back(std::move(chunk));
+      }
+      ++i;
+      ++j;
+    }
+  }
+  for (const Chunk &chunk : result.chunks_) {
+    result.size_ += chunk.size_;
+  }
+  return result;
+}
+
+/**
+ * @brief Операция Op над двумя блоками с одинаковыми старшими битами.
+ *
+ * Два массива сливаются, две карты обрабатываются по словам на месте lhs.
+ * Если блоки разного вида, пересечение и разность проверяют по одному биту
+ * на ключ массива, а для объединения и симметрической разности массив
+ * переводится в карту: результат все равно не меньше карты-операнда.
+ *
+ * @param lhs Левый блок (забирается по значению и переиспользуется).
+ * @param rhs Правый блок.
+ * @return Блок-результат, возможно пустой.
+ */
+template <typename Key>
+template <typename bitset_set<Key>::SetOperation Op>
+typename bitset_set<Key>::Chunk
+bitset_set<Key>::CombineChunks(Chunk lhs, const Chunk &rhs) {
+  if (!lhs.IsBitmap() && !rhs.IsBitmap()) {
+    Chunk result;
+    result.high_ = lhs.high_;
+    CombineArrays<Op>(lhs, rhs, result);
+    return result;
+  }
+  if (lhs.IsBitmap() && rhs.IsBitmap()) {
+    lhs.size_ = CombineBitmaps<Op>(lhs.bitmap_.data(), rhs.bitmap_.data(),
+                                   lhs.bitmap_.data());
+    Normalize(lhs);
+    return lhs;
+  }
+  if (Op == kIntersection || (Op == kDifference && !lhs.IsBitmap())) {
+    // Отбираются ключи массива: при пересечении - из меньшего операнда.
+    const Chunk &array = lhs.IsBitmap() ? rhs : lhs;
+    const Chunk &bitmap = lhs.IsBitmap() ? lhs : rhs;
+    Chunk result;
+    result.high_ = lhs.high_;
+    for (std::uint16_t low : array.array_) {
+      if (Contains(bitmap, low) == (Op == kIntersection)) {
+        result.array_.push_back(low);
+      }
+    }
+    result.size_ = static_cast<std::uint32_t>(result.array_.size());
+    return result;
+  }
+  if (Op == kDifference) {
+    // Карта минус массив: сброс битов.
+    for (std::uint16_t low : rhs.array_) {
+      std::uint64_t &word = lhs.bitmap_[low >> 6];
+      std::uint64_t mask = std::uint64_t{1} << (low & 63);
+      lhs.size_ -= (word & mask) != 0;
+      word &= ~mask;
+    }
+    Normalize(lhs);
+    return lhs;
+  }
+  if (!lhs.IsBitmap()) {
+    ToBitmap(lhs);
+    return CombineChunks<Op>(std::move(lhs), rhs);
+  }
+  Chunk bitmap = rhs;
+  ToBitmap(bitmap);
+  return CombineChunks<Op>(std::move(lhs), bitmap);
+}
+
+/**
+ * @brief Операция Op над двумя блоками-массивами слиянием отсортированных
+ * последовательностей.
+ */
+template <typename Key>
+template <typename bitset_set<Key>::SetOperation Op>
+void bitset_set<Key>::CombineArrays(const Chunk &lhs, const Chunk &rhs,
+                                    Chunk &out) {
+  auto output = std::back_inserter(out.array_);
+  auto lhs_begin = lhs.array_.begin(), lhs_end = lhs.array_.end();
+  auto rhs_begin = rhs.array_.begin(), rhs_end = rhs.array_.end();
+  if constexpr (Op == kUnion) {
+    out.array_.reserve(lhs.array_.size() + rhs.array_.size());
+    std::set_union(lhs_begin, lhs_end, rhs_begin, rhs_end, output);
+  } else if constexpr (Op == kIntersection) {
+    out.array_.reserve(std::min(lhs.array_.size(), rhs.array_.size()));
+    std::set_intersection(lhs_begin, lhs_end, rhs_begin, rhs_end, output);
+  } else if constexpr (Op == kDifference) {
+    out.array_.reserve(lhs.array_.size());
+    std::set_difference(lhs_begin, lhs_end, rhs_begin, rhs_end, output);
+  } else {
+    out.array_.reserve(lhs.array_.size() + rhs.array_.size());
+    std::set_symmetric_difference(lhs_begin, lhs_end, rhs_begin, rhs_end,
+                                  output);
+  }
+  out.size_ = static_cast<std::uint32_t>(out.array_.size());
+  Normalize(out);
+}
+
+/**
+ * @brief Операция Op над двумя битовыми картами по словам.
+ *
+ * С AVX2 за инструкцию обрабатываются 256 бит, с SSE2 - 128, без них - 64.
+ * out может совпадать с lhs или rhs.
+ *
+ * @return Количество установленных битов результата.
+ */
+template <typename Key>
+template <typename bitset_set<Key>::SetOperation Op>
+std::uint32_t bitset_set<Key>::CombineBitmaps(const std::uint64_t *lhs,
+                                              const std::uint64_t *rhs,
+                                              std::uint64_t *out) noexcept {
+#if defined(__AVX2__)
+  for (std::uint32_t i = 0; i < kBitmapWords; i += 4) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i));
+    __m256i r;
+    if constexpr (Op == kUnion) {
+      r = _mm256_or_si256(a, b);
+    } else if constexpr (Op == kIntersection) {
+      r = _mm256_and_si256(a, b);
+    } else if constexpr (Op == kDifference) {
+      r = _mm256_andnot_si256(b, a);
+    } else {
+      r = _mm256_xor_si256(a, b);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), r);
+  }
+#elif defined(__SSE2__)
+  for (std::uint32_t i = 0; i < kBitmapWords; i += 2) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i));
+    __m128i r;
+    if constexpr (Op == kUnion) {
+      r = _mm_or_si128(a, b);
+    } else if constexpr (Op == kIntersection) {
+      r = _mm_and_si128(a, b);
+    } else if constexpr (Op == kDifference) {
+      r = _mm_andnot_si128(b, a);
+    } else {
+      r = _mm_xor_si128(a, b);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), r);
+  }
+#else
+  for (std::uint32_t i = 0; i < kBitmapWords; ++i) {
+    if constexpr (Op == kUnion) {
+      out[i] = lhs[i] | rhs[i];
+    } else if constexpr (Op == kIntersection) {
+      out[i] = lhs[i] & rhs[i];
+    } else if constexpr (Op == kDifference) {
+      out[i] = lhs[i] & ~rhs[i];
+    } else {
+      out[i] = lhs[i] ^ rhs[i];
+    }
+  }
+#endif
+  return PopCount(out);
+}
+
+/**
+ * @brief Количество установленных битов в битовой карте блока.
+ */
+template <typename Key>
+std::uint32_t bitset_set<Key>::PopCount(const std::uint64_t *words) noexcept {
+  std::uint32_t result = 0;
+  for (std::uint32_t i = 0; i < kBitmapWords; ++i) {
+    result += __builtin_popcountll(words[i]);
+  }
+  return result;
+}
+
+/**
+ * @brief Номер первого установленного бита карты, не меньший from.
+ *
+ * @return Номер бита или kNoBit.
+ */
+template <typename Key>
+std::uint32_t bitset_set<Key>::FirstBit(const std::uint64_t *words,
+                                        std::uint32_t from) noexcept {
+  if (from >= kNoBit) {
+    return kNoBit;
+  }
+  std::uint32_t i = from >> 6;
+  std::uint64_t word = words[i] & (~std::uint64_t{0} << (from & 63));
+  while (word == 0) {
+    if (++i == kBitmapWords) {
+      return kNoBit;
+    }
+    word = words[i];
+  }
+  return i * 64 + __builtin_ctzll(word);
+}
+
+/**
+ * @brief Номер последнего установленного бита карты, меньший before.
+ *
+ * @return Номер бита или kNoBit.
+ */
+template <typename Key>
+std::uint32_t bitset_set<Key>::LastBit(const std::uint64_t *words,
+                                       std::uint32_t before) noexcept {
+  if (before == 0) {
+    return kNoBit;
+  }
+  std::uint32_t last = before - 1;
+  std::uint32_t i = last >> 6;
+  std::uint64_t word = words[i] & (~std::uint64_t{0} >> (63 - (last & 63)));
+  while (word == 0) {
+    if (i == 0) {
+      return kNoBit;
+    }
+    word = words[--i];
+  }
+  return i * 64 + 63 - __builtin_clzll(word);
+}
+
+/**
+ * @brief Номер первого блока со старшими битами не меньше high.
+ */
+template <typename Key>
+typename bitset_set<Key>::size_type
+bitset_set<Key>::FindChunk(std::uint16_t high) const noexcept {
+  auto it = std::lower_bound(
+      chunks_.begin(), chunks_.end(), high,
+      [](const Chunk &chunk, std::uint16_t value) {
+        return chunk.high_ < value;
+      });
+  return static_cast<size_type>(it - chunks_.begin());
+}
+
+/**
+ * @brief Переход к следующему ключу: в массиве - следующая ячейка, в карте
+ * - следующий установленный бит; в конце блока - первый ключ следующего.
+ */
+template <typename Key>
+typename bitset_set<Key>::iterator &
+bitset_set<Key>::BitsetSetIterator::operator++() noexcept {
+  const Chunk &chunk = owner_->chunks_[chunk_];
+  std::uint32_t next = chunk.IsBitmap()
+                           ? FirstBit(chunk.bitmap_.data(), pos_ + 1)
+                           : (pos_ + 1 < chunk.size_ ? pos_ + 1 : kNoBit);
+  if (next != kNoBit) {
+    pos_ = next;
+  } else if (++chunk_ < owner_->chunks_.size()) {
+    pos_ = FirstPos(owner_->chunks_[chunk_]);
+  } else {
+    pos_ = 0;
+  }
+  Load();
+  return *this;
+}
+
+/**
+ * @brief Переход к предыдущему ключу; от end() - к наибольшему ключу.
+ */
+template <typename Key>
+typename bitset_set<Key>::iterator &
+bitset_set<Key>::BitsetSetIterator::operator--() noexcept {
+  std::uint32_t prev = kNoBit;
+  if (chunk_ < owner_->chunks_.size()) {
+    const Chunk &chunk = owner_->chunks_[chunk_];
+    if (chunk.IsBitmap()) {
+      prev = LastBit(chunk.bitmap_.data(), pos_);
+    } else if (pos_ > 0) {
+      prev = pos_ - 1;
+    }
+  }
+  if (prev != kNoBit) {
+    pos_ = prev;
+  } else {
+    --chunk_;
+    pos_ = LastPos(owner_->chunks_[chunk_]);
+  }
+  Load();
+  return *this;
+}
+
+/**
+ * @brief Восстанавливает ключ по позиции итератора.
+ */
+template <typename Key>
+void bitset_set<Key>::BitsetSetIterator::Load() noexcept {
+  if (chunk_ == owner_->chunks_.size()) {
+    value_ = 0;
+    return;
+  }
+  const Chunk &chunk = owner_->chunks_[chunk_];
+  std::uint32_t low = chunk.IsBitmap() ? pos_ : chunk.array_[pos_];
+  value_ = static_cast<value_type>(
+      (static_cast<std::uint32_t>(chunk.high_) << 16) | low);
+}
+
+} // namespace s21
@@ -0,0 +1,130 @@
+// Сравнение s21::concurrent_skiplist_map с s21::map под std::shared_mutex
+// (поиск под разделяемой блокировкой, вставка и удаление - под
+// исключительной) при смеси 90/10 и 50/50 чтений и записей. Запись - это
+// поровну вставок и удалений случайных ключей, так что размер словаря
+// держится около половины диапазона ключей. Печатается суммарная пропускная
+// способность всех потоков.
+//
+// Сборка: g++ -std=c++17 -O2 -pthread concurrent_skiplist_map_bench.cpp
+//   -o concurrent_skiplist_map_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "../map/s21_map.h"
+#include "s21_concurrent_skiplist_map.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int kKeys = 1 << 20;
+constexpr int kOpsPerThread = 400000;
+
+class LockedMap {
+public:
+  bool contains(int key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+
+  void insert(int key, int value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    map_.insert(key, value);
+  }
+
+  void erase(int key) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+      map_.erase(it);
+    }
+  }
+
+private:
+  mutable std::shared_mutex mutex_;
+  s21::map<int, int> map_;
+};
+
+// Поток xorshift для ключей и выбора операции.
+std::uint32_t Next(std::uint32_t &state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+template <typename Map>
+double MillionOpsPerSecond(Map &map, int threads, unsigned write_percent) {
+  std::vector<std::thread> workers;
+  auto start = Clock::now();
+  for (int id = 0; id < threads; ++id) {
+    workers.emplace_back([&map, id, write_percent] {
+      std::uint32_t state = 2463534242U + static_cast<std::uint32_t>(id);
+      std::size_t found = 0;
+      for (int op = 0; op < kOpsPerThread; ++op) {
+        int key = static_cast<int>(Next(state) % kKeys);
+        unsigned dice = Next(state) % 100;
+        if (dice >= write_percent) {
+          found += map.contains(key) ? 1 : 0;
+        } else if (dice % 2 == 0) {
+          map.insert(key, key);
+        } else {
+          map.erase(key);
+        }
+      }
+      if (found == static_cast<std::size_t>(-1)) {
+        std::printf("unreachable\n");
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  return static_cast<double>(threads) * kOpsPerThread / seconds / 1e6;
+}
+
+template <typename Map> void Prefill(Map &map) {
+  for (int key = 0; key < kKeys; key += 2) {
+    map.insert(key, key);
+  }
+}
+
+void Run(int threads, unsigned write_percent) {
+  double skiplist = 0;
+  double locked = 0;
+  {
+    s21::concurrent_skiplist_map<int, int> map;
+    Prefill(map);
+    skiplist = MillionOpsPerSecond(map, threads, write_percent);
+  }
+  {
+    LockedMap map;
+    Prefill(map);
+    locked = MillionOpsPerSecond(map, threads, write_percent);
+  }
+  std::printf("  %2u/%-2u  %2d threads  skiplist %6.2f Mops/s  "
+              "locked s21::map %6.2f Mops/s\n",
+              100 - write_percent, write_percent, threads, skiplist, locked);
+}
+} // namespace
+
+int main() {
+  unsigned cores = std::thread::hardware_concurrency();
+  std::printf("%d keys, %d ops per thread, %u hardware threads\n", kKeys,
+              kOpsPerThread, cores);
+  int max_threads = static_cast<int>(std::max(4U, cores));
+  for (unsigned write_percent : {10U, 50U}) {
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+      Run(threads, write_percent);
+    }
+  }
+  return 0;
+}
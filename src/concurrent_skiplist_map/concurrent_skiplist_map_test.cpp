@@ -0,0 +1,256 @@
+#include "s21_concurrent_skiplist_map.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// Пока флаг поднят, operator new в этом потоке сообщает о нехватке памяти.
+thread_local bool fail_allocations = false;
+} // namespace
+
+// Замена не встраивается, иначе GCC видит malloc и free вместо пары
+// new/delete и предупреждает о несоответствии (-Wmismatched-new-delete).
+[[gnu::noinline]] void *operator new(std::size_t size) {
+  if (!fail_allocations) {
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+      return memory;
+    }
+  }
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *memory) noexcept {
+  std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+namespace s21 {
+namespace {
+// Значение, которое считает свои живые экземпляры.
+struct Tracked {
+  static inline std::atomic<int> live{0};
+
+  explicit Tracked(int value = 0) : value_(value) { ++live; }
+  Tracked(const Tracked &other) : value_(other.value_) { ++live; }
+  ~Tracked() { --live; }
+
+  int value_;
+};
+
+constexpr int kThreads = 4;
+} // namespace
+
+TEST(ConcurrentSkiplistMapTest, RandomOperationsMatchStdMap) {
+  concurrent_skiplist_map<int, std::string> map = {
+      {5, "five"}, {1, "one"}, {5, "again"}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.find(5)->second, "five");
+  EXPECT_TRUE(map.find(2) == map.end());
+
+  std::map<int, std::string> ref = {{5, "five"}, {1, "one"}};
+  std::mt19937 gen(39);
+  for (int step = 0; step < 20000; ++step) {
+    int key = static_cast<int>(gen() % 500);
+    switch (gen() % 3) {
+    case 0: {
+      std::string value = std::to_string(step);
+      EXPECT_EQ(map.insert(key, value), ref.emplace(key, value).second);
+      break;
+    }
+    case 1:
+      EXPECT_EQ(map.erase(key), ref.erase(key));
+      break;
+    default:
+      EXPECT_EQ(map.contains(key), ref.count(key) == 1);
+      auto it = map.find(key);
+      if (it != map.end()) {
+        EXPECT_EQ(it->second, ref[key]);
+      }
+    }
+  }
+  EXPECT_EQ(map.size(), ref.size());
+  EXPECT_EQ(map.empty(), ref.empty());
+  std::vector<std::pair<const int, std::string>> items(map.begin(), map.end());
+  EXPECT_TRUE(std::equal(items.begin(), items.end(), ref.begin(), ref.end()));
+
+  concurrent_skiplist_map<int, int, std::greater<int>> reversed;
+  for (int key : {3, 1, 2}) {
+    EXPECT_TRUE(reversed.emplace(key, key * 10));
+  }
+  EXPECT_FALSE(reversed.insert({2, 0}));
+  std::vector<int> keys;
+  for (const auto &item : reversed) {
+    keys.push_back(item.first);
+  }
+  EXPECT_EQ(keys, (std::vector<int>{3, 2, 1}));
+}
+
+TEST(ConcurrentSkiplistMapTest, ConcurrentWritersAndReaders) {
+  const int kKeys = 4000;
+  concurrent_skiplist_map<int, int> map;
+  std::atomic<bool> done{false};
+  std::atomic<int> unsorted{0};
+  std::atomic<int> wrong_values{0};
+
+  // Каждый писатель владеет ключами со своим остатком от деления и знает,
+  // какие из них должны остаться в словаре.
+  std::vector<std::set<int>> expected(kThreads);
+  std::vector<std::thread> writers;
+  for (int id = 0; id < kThreads; ++id) {
+    writers.emplace_back([&, id] {
+      std::mt19937 gen(id);
+      for (int step = 0; step < 20000; ++step) {
+        int key = static_cast<int>(gen() % (kKeys / kThreads)) * kThreads + id;
+        if (gen() % 2 == 0) {
+          EXPECT_EQ(map.insert(key, -key), expected[id].insert(key).second);
+        } else {
+          EXPECT_EQ(map.erase(key), expected[id].erase(key));
+        }
+      }
+    });
+  }
+  std::vector<std::thread> readers;
+  for (int id = 0; id < 2; ++id) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        int previous = -1;
+        for (const auto &item : map) {
+          if (item.first <= previous) {
+            ++unsorted;
+          }
+          if (item.second != -item.first) {
+            ++wrong_values;
+          }
+          previous = item.first;
+        }
+        auto it = map.find(previous);
+        if (previous >= 0 && it != map.end() && it->second != -previous) {
+          ++wrong_values;
+        }
+      }
+    });
+  }
+  for (std::thread &writer : writers) {
+    writer.join();
+  }
+  done.store(true);
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(unsorted.load(), 0);
+  EXPECT_EQ(wrong_values.load(), 0);
+
+  std::set<int> all;
+  for (const std::set<int> &keys : expected) {
+    all.insert(keys.begin(), keys.end());
+  }
+  std::vector<int> keys;
+  for (const auto &item : map) {
+    keys.push_back(item.first);
+  }
+  EXPECT_EQ(map.size(), all.size());
+  EXPECT_TRUE(std::equal(keys.begin(), keys.end(), all.begin(), all.end()));
+}
+
+TEST(ConcurrentSkiplistMapTest, ContendedKeysAreInsertedAndErasedOnce) {
+  const int kKeys = 2000;
+  concurrent_skiplist_map<int, Tracked> map;
+  std::atomic<int> inserted{0};
+  std::atomic<int> erased{0};
+  std::vector<std::thread> threads;
+  for (int id = 0; id < kThreads; ++id) {
+    threads.emplace_back([&, id] {
+      for (int key = 0; key < kKeys; ++key) {
+        inserted += map.emplace(key, Tracked(id)) ? 1 : 0;
+      }
+      for (int key = 0; key < kKeys; ++key) {
+        erased += static_cast<int>(map.erase(key));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  // Каждый ключ вставлен и удален ровно одним потоком, сколько бы раз его
+  // ни вставляли заново после удаления.
+  EXPECT_EQ(inserted.load(), erased.load());
+  EXPECT_GE(inserted.load(), kKeys);
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+
+  // Удаленные в этом потоке узлы освобождаются, как только ни один поток
+  // не держит старую эпоху.
+  int live = Tracked::live.load();
+  for (int key = 0; key < kKeys; ++key) {
+    map.emplace(key, Tracked(key));
+  }
+  EXPECT_EQ(Tracked::live.load(), live + kKeys);
+  for (int key = 0; key < kKeys; ++key) {
+    EXPECT_EQ(map.erase(key), 1U);
+  }
+  EpochReclaimer::Collect();
+  EXPECT_LE(Tracked::live.load(), live);
+}
+
+TEST(ConcurrentSkiplistMapTest, FirstReaderOnThreadReportsBadAlloc) {
+  concurrent_skiplist_map<int, int> map = {{1, 10}, {2, 20}};
+  // Записи завершившихся потоков прошлых тестов (их было не больше kThreads
+  // одновременно) достаются новым потокам без выделения памяти. Пока их
+  // держат заблокированные внутри Guard потоки, читатель получит новую.
+  std::atomic<int> entered{0};
+  std::atomic<bool> release{false};
+  std::vector<std::thread> holders;
+  for (int id = 0; id < 4 * kThreads; ++id) {
+    holders.emplace_back([&] {
+      EpochReclaimer::Guard guard;
+      ++entered;
+      while (!release.load()) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  while (entered.load() < 4 * kThreads) {
+    std::this_thread::yield();
+  }
+
+  bool threw = false;
+  bool found = false;
+  // Первый поиск нового потока выделяет ему запись эпох: нехватка памяти
+  // должна дойти до вызывающего как std::bad_alloc, а не std::terminate.
+  std::thread reader([&] {
+    fail_allocations = true;
+    try {
+      found = map.contains(1);
+    } catch (const std::bad_alloc &) {
+      threw = true;
+    }
+    fail_allocations = false;
+    found = map.contains(1) && map.find(2)->second == 20;
+  });
+  reader.join();
+  release = true;
+  for (std::thread &holder : holders) {
+    holder.join();
+  }
+  EXPECT_TRUE(threw);
+  EXPECT_TRUE(found);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
@@ -0,0 +1,180 @@
+#ifndef S21_CONTAINERS_CONCURRENT_SKIPLIST_MAP_S21_CONCURRENT_SKIPLIST_MAP_H_
+#define S21_CONTAINERS_CONCURRENT_SKIPLIST_MAP_S21_CONCURRENT_SKIPLIST_MAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "s21_epoch.h"
+
+namespace s21 {
+
+// Упорядоченный ассоциативный массив на неблокирующем списке с пропусками.
+// find, contains, insert и erase можно вызывать из любого числа потоков без
+// внешней блокировки: ссылки башен узлов меняются только через CAS.
+//
+// Удаление логическое: младший бит ссылки узла помечает, что узел удален на
+// этом уровне, после чего помеченная ссылка уже не меняется. Физически узел
+// вырезают из уровней любые проходящие мимо поиски, а память возвращается
+// через EpochReclaimer, когда ни один поток не может его читать.
+//
+// Значения после вставки не меняются, поэтому читать их можно без
+// синхронизации. Обход и size() согласованы слабо: итератор видит элементы
+// в порядке ключей, не пропускает тех, что были в словаре все время обхода,
+// и может увидеть или не увидеть одновременно вставленные и удаленные.
+// Итератор удерживает эпоху, поэтому его нельзя передавать другому потоку,
+// а долгий обход задерживает освобождение памяти.
+//
+// Конструкторы, деструктор и операторы присваивания потокобезопасными не
+// являются.
+template <typename Key, typename Type, typename Compare = std::less<Key>>
+class concurrent_skiplist_map {
+private:
+  struct Node;
+  class ConcurrentSkiplistIterator;
+
+  // Ссылка на следующий узел с флагом удаления в младшем бите.
+  using Link = std::atomic<std::uintptr_t>;
+
+  // Наибольшая высота башни. Уровни растут с вероятностью 1/4, так что
+  // 16 уровней хватает на миллиарды элементов.
+  static constexpr int kMaxHeight = 16;
+
+public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using iterator = ConcurrentSkiplistIterator;
+  using const_iterator = ConcurrentSkiplistIterator;
+  using size_type = std::size_t;
+
+  // Конструкторы, деструктор и операторы присваивания
+  concurrent_skiplist_map() noexcept;
+  explicit concurrent_skiplist_map(const Compare &comparator) noexcept;
+  concurrent_skiplist_map(std::initializer_list<value_type> const &items);
+  concurrent_skiplist_map(const concurrent_skiplist_map &) = delete;
+  ~concurrent_skiplist_map();
+
+  concurrent_skiplist_map &operator=(const concurrent_skiplist_map &) = delete;
+
+  // Итераторы
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+
+  // Модификаторы
+  bool insert(const value_type &value);
+  bool insert(const key_type &key, const mapped_type &obj);
+  template <typename... Args> bool emplace(Args &&...args);
+  size_type erase(const key_type &key);
+
+  // Поиск
+  const_iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+
+private:
+  static constexpr std::uintptr_t kMarked = 1;
+
+  template <typename... Args>
+  static Node *CreateNode(int height, Args &&...args);
+  static void DestroyNode(void *node) noexcept;
+  static Link *LinksOf(Node *node) noexcept;
+  static Node *ToNode(std::uintptr_t link) noexcept;
+  static int RandomHeight() noexcept;
+
+  template <typename... Args>
+  bool InsertUnique(const key_type &key, Args &&...args);
+  void RaiseLevels(int height) noexcept;
+  Link *Tower(Node *node) const noexcept;
+  bool TryFind(const key_type &key, Node **preds, Node **succs) const;
+  bool Find(const key_type &key, Node **preds, Node **succs) const;
+  Node *FindNode(const key_type &key) const;
+  static Node *NextLive(std::uintptr_t link) noexcept;
+  bool LinkNode(Node *node, Node **preds, Node **succs);
+  void Release(Node *node);
+
+  // Узел хранит значение, а за ним в том же блоке - башню из height_ ссылок.
+  // owners_ считает, кто еще работает с узлом: вставляющий поток, пока
+  // достраивает башню, и удаливший его поток. Последний из них вырезает
+  // узел со всех уровней и откладывает освобождение.
+  struct alignas(Link) alignas(value_type) Node {
+    template <typename... Args>
+    explicit Node(int height, Args &&...args)
+        : value_(std::forward<Args>(args)...), height_(height) {}
+
+    value_type value_;
+    int height_;
+    std::atomic<int> owners_{2};
+  };
+
+  class ConcurrentSkiplistIterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = concurrent_skiplist_map::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    ConcurrentSkiplistIterator() = default;
+
+    reference operator*() const noexcept { return node_->value_; }
+
+    pointer operator->() const noexcept { return &node_->value_; }
+
+    ConcurrentSkiplistIterator &operator++() noexcept {
+      std::uintptr_t next = LinksOf(node_)[0].load(std::memory_order_acquire);
+      node_ = NextLive(next);
+      return *this;
+    }
+
+    // Копия итератора входит в критическую секцию, а на новом потоке это
+    // выделение записи потока (см. EpochReclaimer::Guard).
+    ConcurrentSkiplistIterator operator++(int) {
+      ConcurrentSkiplistIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const ConcurrentSkiplistIterator &lhs,
+                           const ConcurrentSkiplistIterator &rhs) noexcept {
+      return lhs.node_ == rhs.node_;
+    }
+
+    friend bool operator!=(const ConcurrentSkiplistIterator &lhs,
+                           const ConcurrentSkiplistIterator &rhs) noexcept {
+      return lhs.node_ != rhs.node_;
+    }
+
+  private:
+    friend class concurrent_skiplist_map;
+
+    // Guard создается раньше, чем итератор получает узел.
+    EpochReclaimer::Guard guard_;
+    Node *node_ = nullptr;
+  };
+
+  // Встроенная голова: ссылки всех уровней на первые узлы. Поиск вырезает
+  // удаленные узлы и из головы, поэтому она mutable.
+  mutable Link head_[kMaxHeight];
+  // Высота самой высокой башни: поиск начинается с этого уровня, а не с
+  // kMaxHeight. Только растет.
+  std::atomic<int> levels_;
+  std::atomic<size_type> size_;
+  Compare comparator_;
+};
+
+} // namespace s21
+
+#include "s21_concurrent_skiplist_map.tpp"
+#endif // S21_CONTAINERS_CONCURRENT_SKIPLIST_MAP_S21_CONCURRENT_SKIPLIST_MAP_H_
@@ -0,0 +1,515 @@
+#include "s21_concurrent_skiplist_map.h"
+
+namespace s21 {
+
+/**
+ * @brief Конструктор по умолчанию. Создает пустой словарь.
+ */
+template <typename Key, typename Type, typename Compare>
+concurrent_skiplist_map<Key, Type, Compare>::concurrent_skiplist_map() noexcept
+    : concurrent_skiplist_map(Compare()) {}
+
+/**
+ * @brief Создает пустой словарь с заданным компаратором ключей.
+ *
+ * @param comparator Компаратор ключей.
+ */
+template <typename Key, typename Type, typename Compare>
+concurrent_skiplist_map<Key, Type, Compare>::concurrent_skiplist_map(
+    const Compare &comparator) noexcept
+    : levels_(1), size_(0), comparator_(comparator) {
+  for (Link &link : head_) {
+    link.store(0, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Конструктор со списком инициализации. Повторные ключи
+ * пропускаются.
+ *
+ * @param items Список пар ключ-значение.
+ */
+template <typename Key, typename Type, typename Compare>
+concurrent_skiplist_map<Key, Type, Compare>::concurrent_skiplist_map(
+    std::initializer_list<value_type> const &items)
+    : concurrent_skiplist_map() {
+  for (const value_type &item : items) {
+    insert(item);
+  }
+}
+
+/**
+ * @brief Деструктор. Удаляет узлы, которые еще в словаре; удаленные раньше
+ * узлы освобождает EpochReclaimer.
+ *
+ * Вызывается, когда другие потоки уже не обращаются к словарю.
+ */
+template <typename Key, typename Type, typename Compare>
+concurrent_skiplist_map<Key, Type, Compare>::~concurrent_skiplist_map() {
+  Node *node = ToNode(head_[0].load(std::memory_order_acquire));
+  while (node != nullptr) {
+    Node *next = ToNode(LinksOf(node)[0].load(std::memory_order_relaxed));
+    DestroyNode(node);
+    node = next;
+  }
+}
+
+/**
+ * @brief Итератор на элемент с наименьшим ключом.
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::const_iterator
+concurrent_skiplist_map<Key, Type, Compare>::begin() const {
+  const_iterator result;
+  result.node_ = NextLive(head_[0].load(std::memory_order_acquire));
+  return result;
+}
+
+/**
+ * @brief Итератор за последним элементом.
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::const_iterator
+concurrent_skiplist_map<Key, Type, Compare>::end() const {
+  return const_iterator();
+}
+
+/**
+ * @brief Проверяет, пуст ли словарь.
+ */
+template <typename Key, typename Type, typename Compare>
+bool concurrent_skiplist_map<Key, Type, Compare>::empty() const noexcept {
+  return size() == 0;
+}
+
+/**
+ * @brief Возвращает количество элементов. При одновременных изменениях
+ * значение приблизительное.
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::size_type
+concurrent_skiplist_map<Key, Type, Compare>::size() const noexcept {
+  return size_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Вставляет пару, если ключа еще нет.
+ *
+ * @param value Пара ключ-значение.
+ * @return true, если пара вставлена.
+ */
+template <typename Key, typename Type, typename Compare>
+bool concurrent_skiplist_map<Key, Type, Compare>::insert(
+    const value_type &value) {
+  return InsertUnique(value.first, value);
+}
+
+/**
+ * @brief Вставляет значение по ключу, если ключа еще нет.
+ *
+ * @param key Ключ.
+ * @param obj Значение.
+ * @return true, если пара вставлена.
+ */
+template <typename Key, typename Type, typename Compare>
+bool concurrent_skiplist_map<Key, Type, Compare>::insert(
+    const key_type &key, const mapped_type &obj) {
+  return InsertUnique(key, key, obj);
+}
+
+/**
+ * @brief Создает пару из аргументов и вставляет ее, если ключа еще нет.
+ *
+ * Ключ известен только после создания пары, поэтому узел выделяется и
+ * тогда, когда ключ уже есть.
+ *
+ * @param args Аргументы конструктора value_type.
+ * @return true, если пара вставлена.
+ */
+template <typename Key, typename Type, typename Compare>
+template <typename... Args>
+bool concurrent_skiplist_map<Key, Type, Compare>::emplace(Args &&...args) {
+  int height = RandomHeight();
+  RaiseLevels(height);
+  Node *node = CreateNode(height, std::forward<Args>(args)...);
+  EpochReclaimer::Guard guard;
+  Node *preds[kMaxHeight];
+  Node *succs[kMaxHeight];
+  if (Find(node->value_.first, preds, succs) ||
+      !LinkNode(node, preds, succs)) {
+    DestroyNode(node);
+    return false;
+  }
+  size_.fetch_add(1, std::memory_order_relaxed);
+  Release(node);
+  return true;
+}
+
+/**
+ * @brief Удаляет элемент по ключу.
+ *
+ * Сначала помечаются верхние уровни башни, затем нижний; поток, чей CAS
+ * пометил нижний уровень, и удалил элемент.
+ *
+ * @param key Ключ.
+ * @return Количество удаленных элементов (0 или 1).
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::size_type
+concurrent_skiplist_map<Key, Type, Compare>::erase(const key_type &key) {
+  EpochReclaimer::Guard guard;
+  Node *node = FindNode(key);
+  if (node == nullptr) {
+    return 0;
+  }
+  Link *links = LinksOf(node);
+  for (int level = node->height_ - 1; level > 0; --level) {
+    links[level].fetch_or(kMarked, std::memory_order_acq_rel);
+  }
+  if ((links[0].fetch_or(kMarked, std::memory_order_acq_rel) & kMarked) != 0) {
+    return 0;
+  }
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  Release(node);
+  return 1;
+}
+
+/**
+ * @brief Ищет элемент по ключу без блокировок и без записи в память.
+ *
+ * Найденный узел не освобождается, пока жив возвращенный итератор.
+ *
+ * @param key Ключ.
+ * @return Итератор на элемент или end().
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::const_iterator
+concurrent_skiplist_map<Key, Type, Compare>::find(const key_type &key) const {
+  const_iterator result;
+  result.node_ = FindNode(key);
+  return result;
+}
+
+/**
+ * @brief Проверяет, есть ли элемент с ключом key.
+ */
+template <typename Key, typename Type, typename Compare>
+bool concurrent_skiplist_map<Key, Type, Compare>::contains(
+    const key_type &key) const {
+  EpochReclaimer::Guard guard;
+  return FindNode(key) != nullptr;
+}
+
+/**
+ * @brief Вставляет пару, собранную из args, если ключа key еще нет.
+ *
+ * Узел выделяется только после того, как поиск не нашел ключ. Публикуется
+ * он одним CAS на нижнем уровне - в этот момент элемент появляется в
+ * словаре.
+ *
+ * @param key Ключ будущей пары.
+ * @param args Аргументы конструктора value_type.
+ * @return true, если пара вставлена.
+ */
+template <typename Key, typename Type, typename Compare>
+template <typename... Args>
+bool concurrent_skiplist_map<Key, Type, Compare>::InsertUnique(
+    const key_type &key, Args &&...args) {
+  int height = RandomHeight();
+  RaiseLevels(height);
+  EpochReclaimer::Guard guard;
+  Node *preds[kMaxHeight];
+  Node *succs[kMaxHeight];
+  if (Find(key, preds, succs)) {
+    return false;
+  }
+  Node *node = CreateNode(height, std::forward<Args>(args)...);
+  if (!LinkNode(node, preds, succs)) {
+    DestroyNode(node);
+    return false;
+  }
+  size_.fetch_add(1, std::memory_order_relaxed);
+  Release(node);
+  return true;
+}
+
+/**
+ * @brief Выделяет узел вместе с башней. Ссылки башни обнулены.
+ *
+ * @param height Высота башни.
+ * @param args Аргументы конструктора value_type.
+ */
+template <typename Key, typename Type, typename Compare>
+template <typename... Args>
+typename concurrent_skiplist_map<Key, Type, Compare>::Node *
+concurrent_skiplist_map<Key, Type, Compare>::CreateNode(int height,
+                                                        Args &&...args) {
+  void *memory = ::operator new(sizeof(Node) + sizeof(Link) * height);
+  Node *node = nullptr;
+  try {
+    node = new (memory) Node(height, std::forward<Args>(args)...);
+  } catch (...) {
+    ::operator delete(memory);
+    throw;
+  }
+  Link *links = LinksOf(node);
+  for (int level = 0; level < height; ++level) {
+    new (links + level) Link(0);
+  }
+  return node;
+}
+
+/**
+ * @brief Разрушает узел и освобождает его блок. Подходит как Deleter для
+ * EpochReclaimer.
+ */
+template <typename Key, typename Type, typename Compare>
+void concurrent_skiplist_map<Key, Type, Compare>::DestroyNode(
+    void *node) noexcept {
+  static_cast<Node *>(node)->~Node();
+  ::operator delete(node);
+}
+
+/**
+ * @brief Башня узла: массив ссылок сразу за узлом в том же блоке.
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::Link *
+concurrent_skiplist_map<Key, Type, Compare>::LinksOf(Node *node) noexcept {
+  static_assert(sizeof(Node) % alignof(Link) == 0,
+                "башня должна идти сразу за узлом");
+  return reinterpret_cast<Link *>(node + 1);
+}
+
+/**
+ * @brief Снимает флаг удаления со ссылки и возвращает узел.
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::Node *
+concurrent_skiplist_map<Key, Type, Compare>::ToNode(
+    std::uintptr_t link) noexcept {
+  return reinterpret_cast<Node *>(link & ~kMarked);
+}
+
+/**
+ * @brief Высота новой башни: каждый следующий уровень с вероятностью 1/4.
+ *
+ * Генератор xorshift свой у каждого потока, так что вставки не делят
+ * общее состояние.
+ */
+template <typename Key, typename Type, typename Compare>
+int concurrent_skiplist_map<Key, Type, Compare>::RandomHeight() noexcept {
+  static thread_local std::uint64_t state =
+      0x9E3779B97F4A7C15ULL ^ reinterpret_cast<std::uintptr_t>(&state);
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  std::uint64_t bits = state;
+  int height = 1;
+  while (height < kMaxHeight && (bits & 3) == 0) {
+    ++height;
+    bits >>= 2;
+  }
+  return height;
+}
+
+/**
+ * @brief Поднимает высоту списка до height.
+ *
+ * Вызывается до поиска позиции для башни такой высоты: тогда поиск
+ * заполнит preds и succs на всех ее уровнях, а уровни, на которых появится
+ * узел, увидит любой следующий поиск.
+ */
+template <typename Key, typename Type, typename Compare>
+void concurrent_skiplist_map<Key, Type, Compare>::RaiseLevels(
+    int height) noexcept {
+  int levels = levels_.load(std::memory_order_acquire);
+  while (levels < height &&
+         !levels_.compare_exchange_weak(levels, height,
+                                        std::memory_order_acq_rel)) {
+  }
+}
+
+/**
+ * @brief Ссылки узла или головы, если node == nullptr.
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::Link *
+concurrent_skiplist_map<Key, Type, Compare>::Tower(Node *node) const noexcept {
+  return node == nullptr ? head_ : LinksOf(node);
+}
+
+/**
+ * @brief Один проход поиска с вырезанием помеченных узлов.
+ *
+ * На каждом уровне заполняет preds последним узлом с ключом меньше key
+ * (nullptr - голова) и succs - следующим за ним. Помеченные узлы по пути
+ * вырезаются CAS по ссылке предшественника.
+ *
+ * @return false, если CAS не удался и проход надо начать заново.
+ */
+template <typename Key, typename Type, typename Compare>
+bool concurrent_skiplist_map<Key, Type, Compare>::TryFind(const key_type &key,
+                                                          Node **preds,
+                                                          Node **succs) const {
+  Node *pred = nullptr;
+  for (int level = levels_.load(std::memory_order_acquire) - 1; level >= 0;
+       --level) {
+    Node *curr = ToNode(Tower(pred)[level].load(std::memory_order_acquire));
+    while (curr != nullptr) {
+      std::uintptr_t next =
+          LinksOf(curr)[level].load(std::memory_order_acquire);
+      if ((next & kMarked) != 0) {
+        std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(curr);
+        if (!Tower(pred)[level].compare_exchange_strong(
+                expected, next & ~kMarked, std::memory_order_acq_rel)) {
+          return false;
+        }
+        curr = ToNode(next);
+      } else if (comparator_(curr->value_.first, key)) {
+        pred = curr;
+        curr = ToNode(next);
+      } else {
+        break;
+      }
+    }
+    preds[level] = pred;
+    succs[level] = curr;
+  }
+  return true;
+}
+
+/**
+ * @brief Поиск позиции key на всех уровнях (см. TryFind). Повторяется, пока
+ * проход не завершится без конфликтов.
+ *
+ * @return true, если succs[0] - неудаленный узел с ключом key.
+ */
+template <typename Key, typename Type, typename Compare>
+bool concurrent_skiplist_map<Key, Type, Compare>::Find(const key_type &key,
+                                                       Node **preds,
+                                                       Node **succs) const {
+  while (!TryFind(key, preds, succs)) {
+  }
+  return succs[0] != nullptr && !comparator_(key, succs[0]->value_.first);
+}
+
+/**
+ * @brief Поиск только на чтение: помеченные узлы перешагиваются, но не
+ * вырезаются.
+ *
+ * @return Неудаленный узел с ключом key или nullptr.
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::Node *
+concurrent_skiplist_map<Key, Type, Compare>::FindNode(
+    const key_type &key) const {
+  Node *pred = nullptr;
+  Node *curr = nullptr;
+  for (int level = levels_.load(std::memory_order_acquire) - 1; level >= 0;
+       --level) {
+    curr = ToNode(Tower(pred)[level].load(std::memory_order_acquire));
+    while (curr != nullptr) {
+      std::uintptr_t next =
+          LinksOf(curr)[level].load(std::memory_order_acquire);
+      if ((next & kMarked) == 0 && !comparator_(curr->value_.first, key)) {
+        break;
+      }
+      if ((next & kMarked) == 0) {
+        pred = curr;
+      }
+      curr = ToNode(next);
+    }
+  }
+  return curr != nullptr && !comparator_(key, curr->value_.first) ? curr
+                                                                  : nullptr;
+}
+
+/**
+ * @brief Первый неудаленный узел нижнего уровня, начиная со ссылки link.
+ */
+template <typename Key, typename Type, typename Compare>
+typename concurrent_skiplist_map<Key, Type, Compare>::Node *
+concurrent_skiplist_map<Key, Type, Compare>::NextLive(
+    std::uintptr_t link) noexcept {
+  Node *node = ToNode(link);
+  while (node != nullptr) {
+    std::uintptr_t next = LinksOf(node)[0].load(std::memory_order_acquire);
+    if ((next & kMarked) == 0) {
+      break;
+    }
+    node = ToNode(next);
+  }
+  return node;
+}
+
+/**
+ * @brief Вставляет узел в нижний уровень, затем достраивает верхние.
+ *
+ * Достройка прекращается, если узел тем временем удалили: помеченную
+ * ссылку башни CAS не перезапишет, а новый поиск не найдет узел.
+ *
+ * @param preds, succs Результат Find, который не нашел ключ узла.
+ * @return false, если ключ успели вставить; узел тогда не опубликован.
+ */
+template <typename Key, typename Type, typename Compare>
+bool concurrent_skiplist_map<Key, Type, Compare>::LinkNode(Node *node,
+                                                           Node **preds,
+                                                           Node **succs) {
+  const key_type &key = node->value_.first;
+  Link *links = LinksOf(node);
+  while (true) {
+    std::uintptr_t succ = reinterpret_cast<std::uintptr_t>(succs[0]);
+    links[0].store(succ, std::memory_order_relaxed);
+    if (Tower(preds[0])[0].compare_exchange_strong(
+            succ, reinterpret_cast<std::uintptr_t>(node),
+            std::memory_order_acq_rel)) {
+      break;
+    }
+    if (Find(key, preds, succs)) {
+      return false;
+    }
+  }
+  for (int level = 1; level < node->height_; ++level) {
+    while (true) {
+      std::uintptr_t next = links[level].load(std::memory_order_acquire);
+      std::uintptr_t succ = reinterpret_cast<std::uintptr_t>(succs[level]);
+      if ((next & kMarked) != 0 ||
+          (next != succ && !links[level].compare_exchange_strong(
+                               next, succ, std::memory_order_acq_rel))) {
+        return true;
+      }
+      if (Tower(preds[level])[level].compare_exchange_strong(
+              succ, reinterpret_cast<std::uintptr_t>(node),
+              std::memory_order_acq_rel)) {
+        break;
+      }
+      Find(key, preds, succs);
+      if (succs[0] != node) {
+        return true;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Снимает с узла одного владельца. Последний владелец вырезает узел
+ * со всех уровней и откладывает его освобождение.
+ *
+ * Вставляющий поток отпускает узел, когда достроил башню, удаливший - после
+ * пометки. Ни одна ссылка на узел не появится после прохода последнего
+ * владельца, поэтому его поиск вырезает узел окончательно.
+ */
+template <typename Key, typename Type, typename Compare>
+void concurrent_skiplist_map<Key, Type, Compare>::Release(Node *node) {
+  if (node->owners_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  Node *preds[kMaxHeight];
+  Node *succs[kMaxHeight];
+  Find(node->value_.first, preds, succs);
+  EpochReclaimer::Retire(node, &DestroyNode);
+}
+
+} // namespace s21
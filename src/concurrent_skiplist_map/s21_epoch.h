@@ -0,0 +1,181 @@
+#ifndef S21_CONTAINERS_CONCURRENT_SKIPLIST_MAP_S21_EPOCH_H_
+#define S21_CONTAINERS_CONCURRENT_SKIPLIST_MAP_S21_EPOCH_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+
+// Освобождение памяти по эпохам для неблокирующих контейнеров.
+//
+// Поток, который читает разделяемые узлы, держит Guard. Узел, исключенный из
+// структуры, не удаляется сразу, а откладывается через Retire() вместе с
+// номером глобальной эпохи. Эпоха сдвигается, только когда все активные
+// потоки уже увидели текущую, поэтому после двух сдвигов ни один поток не
+// может держать ссылку на отложенный узел, и его можно удалить.
+//
+// Записи потоков хранятся в общем списке и не освобождаются до конца
+// программы: запись завершившегося потока достается следующему новому
+// потоку вместе с его еще не удаленными узлами.
+class EpochReclaimer {
+private:
+  struct ThreadRecord;
+
+public:
+  // Удаляет отложенный объект; узлы разных контейнеров лежат в одном списке.
+  using Deleter = void (*)(void *);
+
+  // Критическая секция: пока Guard жив, отложенные узлы не удаляются.
+  // Вложенные Guard одного потока допустимы и почти ничего не стоят.
+  // Первый Guard потока выделяет запись потока и может бросить
+  // std::bad_alloc; дальше вход в секцию память не выделяет.
+  class Guard {
+  public:
+    Guard() : record_(Enter()) {}
+    Guard(const Guard &) : record_(Enter()) {}
+    Guard &operator=(const Guard &) noexcept { return *this; }
+    ~Guard() { Exit(record_); }
+
+  private:
+    ThreadRecord *record_;
+  };
+
+  // Откладывает удаление объекта. Вызывается внутри Guard после того, как
+  // объект стал недостижим для новых читателей.
+  static void Retire(void *object, Deleter deleter) {
+    ThreadRecord *record = LocalRecord();
+    record->retired_.push_back(
+        {object, deleter, global_epoch_.load(std::memory_order_seq_cst)});
+    if (record->retired_.size() >= kReclaimThreshold) {
+      TryAdvance();
+      Reclaim(record);
+    }
+  }
+
+  // Пытается сдвинуть эпоху и удалить все, что уже можно. Нужен тестам и
+  // потокам, которые хотят вернуть память до своего завершения.
+  static void Collect() {
+    ThreadRecord *record = LocalRecord();
+    if (record->depth_ == 0) {
+      TryAdvance();
+      TryAdvance();
+    }
+    Reclaim(record);
+  }
+
+private:
+  struct RetiredObject {
+    void *object_;
+    Deleter deleter_;
+    std::uint64_t epoch_;
+  };
+
+  // Эпоха хранится со сдвигом на бит: младший бит local_epoch_ означает,
+  // что поток сейчас в критической секции.
+  struct ThreadRecord {
+    std::atomic<std::uint64_t> local_epoch_{0};
+    std::atomic<bool> in_use_{true};
+    ThreadRecord *next_ = nullptr;
+    std::size_t depth_ = 0;
+    std::vector<RetiredObject> retired_;
+  };
+
+  // Возвращает запись потоку при его завершении.
+  struct LocalHolder {
+    ThreadRecord *record_ = nullptr;
+
+    ~LocalHolder() {
+      if (record_ != nullptr) {
+        TryAdvance();
+        Reclaim(record_);
+        record_->in_use_.store(false, std::memory_order_release);
+      }
+    }
+  };
+
+  static constexpr std::size_t kReclaimThreshold = 64;
+
+  static ThreadRecord *LocalRecord() {
+    static thread_local LocalHolder holder;
+    if (holder.record_ == nullptr) {
+      holder.record_ = AcquireRecord();
+    }
+    return holder.record_;
+  }
+
+  // Берет свободную запись завершившегося потока или добавляет новую.
+  static ThreadRecord *AcquireRecord() {
+    for (ThreadRecord *record = records_.load(std::memory_order_acquire);
+         record != nullptr; record = record->next_) {
+      bool expected = false;
+      if (!record->in_use_.load(std::memory_order_relaxed) &&
+          record->in_use_.compare_exchange_strong(expected, true,
+                                                  std::memory_order_acquire)) {
+        return record;
+      }
+    }
+    ThreadRecord *record = new ThreadRecord;
+    record->next_ = records_.load(std::memory_order_relaxed);
+    while (!records_.compare_exchange_weak(record->next_, record,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+    return record;
+  }
+
+  static ThreadRecord *Enter() {
+    ThreadRecord *record = LocalRecord();
+    if (record->depth_++ == 0) {
+      // seq_cst: запись эпохи должна стать видна раньше, чем поток прочтет
+      // первую ссылку на узел.
+      record->local_epoch_.store(
+          (global_epoch_.load(std::memory_order_seq_cst) << 1) | 1,
+          std::memory_order_seq_cst);
+    }
+    return record;
+  }
+
+  static void Exit(ThreadRecord *record) noexcept {
+    if (--record->depth_ == 0) {
+      record->local_epoch_.store(0, std::memory_order_release);
+    }
+  }
+
+  // Сдвигает глобальную эпоху, если все активные потоки ее уже видели.
+  static void TryAdvance() noexcept {
+    std::uint64_t epoch = global_epoch_.load(std::memory_order_seq_cst);
+    for (ThreadRecord *record = records_.load(std::memory_order_acquire);
+         record != nullptr; record = record->next_) {
+      std::uint64_t local =
+          record->local_epoch_.load(std::memory_order_seq_cst);
+      if ((local & 1) != 0 && (local >> 1) != epoch) {
+        return;
+      }
+    }
+    global_epoch_.compare_exchange_strong(epoch, epoch + 1,
+                                          std::memory_order_seq_cst);
+  }
+
+  // Удаляет объекты, отложенные не меньше двух эпох назад.
+  static void Reclaim(ThreadRecord *record) {
+    std::uint64_t epoch = global_epoch_.load(std::memory_order_seq_cst);
+    std::size_t kept = 0;
+    for (RetiredObject &retired : record->retired_) {
+      if (retired.epoch_ + 2 <= epoch) {
+        retired.deleter_(retired.object_);
+      } else {
+        record->retired_[kept++] = retired;
+      }
+    }
+    record->retired_.resize(kept);
+  }
+
+  static inline std::atomic<std::uint64_t> global_epoch_{0};
+  static inline std::atomic<ThreadRecord *> records_{nullptr};
+};
+
+} // namespace s21
+
+#endif // S21_CONTAINERS_CONCURRENT_SKIPLIST_MAP_S21_EPOCH_H_
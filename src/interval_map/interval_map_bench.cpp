@@ -0,0 +1,129 @@
+// Сравнение s21::interval_map с линейным просмотром интервалов, хранящихся
+// в s21::map по левому концу (просмотр обрывается на первом интервале
+// правее запроса): поиск всех пересечений отрезка, проверка точки и
+// построение из упорядоченной последовательности против вставок по одному.
+//
+// Сборка: g++ -std=c++17 -O2 interval_map_bench.cpp -o interval_map_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../map/s21_map.h"
+#include "s21_interval_map.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using IntervalMap = s21::interval_map<long, int>;
+using Interval = IntervalMap::interval_type;
+using ScanMap = s21::map<Interval, int>;
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// Интервалы длиной до max_length на оси [0, span), упорядоченные по левому
+// концу.
+std::vector<IntervalMap::value_type> MakeIntervals(std::size_t count,
+                                                   long span, long max_length,
+                                                   std::mt19937 &gen) {
+  std::vector<std::pair<Interval, int>> items;
+  for (std::size_t i = 0; i < count; ++i) {
+    const long lo = static_cast<long>(gen() % span);
+    items.emplace_back(Interval(lo, lo + static_cast<long>(gen() % max_length)),
+                       static_cast<int>(i));
+  }
+  std::sort(items.begin(), items.end());
+  return std::vector<IntervalMap::value_type>(items.begin(), items.end());
+}
+
+std::size_t ScanOverlaps(const ScanMap &intervals, long lo, long hi) {
+  std::size_t found = 0;
+  for (const auto &item : intervals) {
+    if (hi < item.first.first) {
+      break;
+    }
+    if (lo <= item.first.second) {
+      ++found;
+    }
+  }
+  return found;
+}
+
+void Compare(std::size_t count, long span, long max_length,
+             std::mt19937 &gen) {
+  const auto items = MakeIntervals(count, span, max_length, gen);
+  std::printf("%zu intervals, span %ld, length < %ld\n", count, span,
+              max_length);
+
+  auto start = Clock::now();
+  IntervalMap tree;
+  for (const auto &item : items) {
+    tree.insert(item);
+  }
+  const double insert_ms = Milliseconds(start);
+  start = Clock::now();
+  IntervalMap bulk;
+  bulk.assign(items.begin(), items.end());
+  const double assign_ms = Milliseconds(start);
+  std::printf("  build     insert loop %8.2f ms  assign (sorted) %8.2f ms\n",
+              insert_ms, assign_ms);
+
+  ScanMap scan;
+  for (const auto &item : items) {
+    scan.insert(Interval(item.first), item.second);
+  }
+
+  const int kQueries = 2000;
+  std::vector<std::pair<long, long>> queries;
+  for (int i = 0; i < kQueries; ++i) {
+    const long lo = static_cast<long>(gen() % span);
+    queries.emplace_back(lo, lo + static_cast<long>(gen() % 100));
+  }
+
+  std::size_t tree_found = 0;
+  start = Clock::now();
+  for (const auto &query : queries) {
+    tree_found += bulk.overlapping(query.first, query.second).size();
+  }
+  const double tree_us = Milliseconds(start) * 1e3 / kQueries;
+  std::size_t scan_found = 0;
+  start = Clock::now();
+  for (const auto &query : queries) {
+    scan_found += ScanOverlaps(scan, query.first, query.second);
+  }
+  const double scan_us = Milliseconds(start) * 1e3 / kQueries;
+  std::printf("  overlap   interval_map %8.2f us/op  scan %10.2f us/op"
+              "  (avg hits %.1f / %.1f)\n",
+              tree_us, scan_us, static_cast<double>(tree_found) / kQueries,
+              static_cast<double>(scan_found) / kQueries);
+
+  std::size_t tree_stabs = 0;
+  start = Clock::now();
+  for (const auto &query : queries) {
+    tree_stabs += bulk.overlaps(query.first) ? 1 : 0;
+  }
+  const double stab_tree_us = Milliseconds(start) * 1e3 / kQueries;
+  std::size_t scan_stabs = 0;
+  start = Clock::now();
+  for (const auto &query : queries) {
+    scan_stabs += ScanOverlaps(scan, query.first, query.first) != 0 ? 1 : 0;
+  }
+  const double stab_scan_us = Milliseconds(start) * 1e3 / kQueries;
+  std::printf("  stab      interval_map %8.2f us/op  scan %10.2f us/op"
+              "  (hits %zu / %zu)\n",
+              stab_tree_us, stab_scan_us, tree_stabs, scan_stabs);
+}
+} // namespace
+
+int main() {
+  std::mt19937 gen(2024);
+  Compare(100000, 10000000, 1000, gen);
+  Compare(1000000, 100000000, 1000, gen);
+  Compare(100000, 1000000, 100000, gen);
+  return 0;
+}
@@ -0,0 +1,158 @@
+#include "s21_interval_map.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace s21 {
+namespace {
+using IntervalMap = s21::interval_map<int, int>;
+using Entry = std::tuple<int, int, int>;
+
+// Пересечения, найденные полным перебором, в порядке интервалов.
+std::vector<Entry> BruteOverlaps(const std::vector<Entry> &items, int lo,
+                                 int hi) {
+  std::vector<Entry> result;
+  for (const Entry &item : items) {
+    if (std::get<0>(item) <= hi && lo <= std::get<1>(item)) {
+      result.push_back(item);
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<Entry> Overlaps(const IntervalMap &m, int lo, int hi) {
+  std::vector<Entry> result;
+  for (auto it : m.overlapping(lo, hi)) {
+    result.emplace_back((*it).first.first, (*it).first.second, (*it).second);
+  }
+  // Равные интервалы идут в порядке вставки, а не по значению
+  std::sort(result.begin(), result.end());
+  return result;
+}
+} // namespace
+
+TEST(IntervalMapTest, EmptyMap) {
+  IntervalMap m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.size(), 0U);
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_FALSE(m.overlaps(0));
+  EXPECT_TRUE(m.find_overlap(-10, 10) == m.end());
+  EXPECT_TRUE(m.overlapping(-10, 10).empty());
+}
+
+TEST(IntervalMapTest, PointAndRangeQueries) {
+  IntervalMap m{{{10, 20}, 1}, {{15, 16}, 2}, {{30, 40}, 3}, {{5, 7}, 4}};
+  EXPECT_EQ(m.size(), 4U);
+  EXPECT_EQ((*m.begin()).first.first, 5);
+
+  EXPECT_TRUE(m.overlaps(5));
+  EXPECT_TRUE(m.overlaps(20));
+  EXPECT_TRUE(m.overlaps(35));
+  EXPECT_FALSE(m.overlaps(8));
+  EXPECT_FALSE(m.overlaps(25));
+  EXPECT_FALSE(m.overlaps(41));
+
+  auto found = m.find_overlap(16, 31);
+  ASSERT_TRUE(found != m.end());
+  EXPECT_EQ((*found).second, 1);
+  EXPECT_TRUE(m.find_overlap(21, 29) == m.end());
+  EXPECT_TRUE(m.find_overlap(30, 20) == m.end());
+
+  auto hits = m.overlapping(7, 15);
+  ASSERT_EQ(hits.size(), 3U);
+  EXPECT_EQ((*hits[0]).second, 4);
+  EXPECT_EQ((*hits[1]).second, 1);
+  EXPECT_EQ((*hits[2]).second, 2);
+
+  int visited = 0;
+  m.for_each_overlap(0, 100, [&visited](IntervalMap::const_iterator) {
+    ++visited;
+    return visited < 2;
+  });
+  EXPECT_EQ(visited, 2);
+
+  EXPECT_THROW(m.insert(3, 2, 0), std::invalid_argument);
+  const std::vector<IntervalMap::value_type> invalid{{{0, 1}, 0},
+                                                     {{1, 0}, 0}};
+  EXPECT_THROW(m.assign(invalid.begin(), invalid.end()),
+               std::invalid_argument);
+  EXPECT_EQ(m.size(), 4U);
+}
+
+TEST(IntervalMapTest, RandomAgainstBruteForce) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> start(0, 1000);
+  std::uniform_int_distribution<int> length(0, 60);
+  IntervalMap m;
+  std::vector<Entry> ref;
+  for (int step = 0; step < 3000; ++step) {
+    if (!ref.empty() && gen() % 3 == 0) {
+      // Удаляем случайный интервал вместе с его значением
+      const Entry victim = ref[gen() % ref.size()];
+      auto it = m.begin();
+      while ((*it).first.first != std::get<0>(victim) ||
+             (*it).first.second != std::get<1>(victim) ||
+             (*it).second != std::get<2>(victim)) {
+        ++it;
+      }
+      m.erase(it);
+      ref.erase(std::find(ref.begin(), ref.end(), victim));
+    } else {
+      const int lo = start(gen);
+      const Entry item(lo, lo + length(gen), step);
+      m.insert(std::get<0>(item), std::get<1>(item), std::get<2>(item));
+      ref.push_back(item);
+    }
+    const int lo = start(gen);
+    const int hi = lo + length(gen);
+    ASSERT_EQ(Overlaps(m, lo, hi), BruteOverlaps(ref, lo, hi));
+    ASSERT_EQ(m.overlaps(lo), !BruteOverlaps(ref, lo, lo).empty());
+  }
+  EXPECT_EQ(m.size(), ref.size());
+}
+
+TEST(IntervalMapTest, BulkAssignCopyAndSwap) {
+  std::mt19937 gen(7);
+  std::vector<IntervalMap::value_type> items;
+  for (int i = 0; i < 500; ++i) {
+    const int lo = static_cast<int>(gen() % 10000);
+    items.emplace_back(IntervalMap::interval_type(lo, lo + gen() % 100), i);
+  }
+  IntervalMap unsorted(items.begin(), items.end());
+  std::vector<Entry> ref;
+  for (const auto &item : items) {
+    ref.emplace_back(item.first.first, item.first.second, item.second);
+  }
+  ASSERT_EQ(unsorted.size(), items.size());
+  EXPECT_TRUE(std::is_sorted(
+      unsorted.begin(), unsorted.end(),
+      [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; }));
+
+  // Выгрузка в порядке дерева идет по уже упорядоченному пути
+  IntervalMap sorted;
+  sorted.insert(0, 0, -1);
+  sorted.assign(unsorted.begin(), unsorted.end());
+  IntervalMap copy(sorted);
+  IntervalMap other{{{1, 2}, 3}};
+  copy.swap(other);
+  EXPECT_EQ(copy.size(), 1U);
+  for (int lo = 0; lo < 10100; lo += 97) {
+    ASSERT_EQ(Overlaps(sorted, lo, lo + 50), BruteOverlaps(ref, lo, lo + 50));
+    ASSERT_EQ(Overlaps(other, lo, lo + 50), BruteOverlaps(ref, lo, lo + 50));
+  }
+  sorted.clear();
+  EXPECT_TRUE(sorted.empty());
+  EXPECT_FALSE(sorted.overlaps(100));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
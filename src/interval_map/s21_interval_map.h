@@ -0,0 +1,112 @@
+#ifndef S21_CONTAINERS_INTERVAL_MAP_S21_INTERVAL_MAP_H_
+#define S21_CONTAINERS_INTERVAL_MAP_S21_INTERVAL_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../tree/RedBlackTree.h"
+
+namespace s21 {
+
+// Ассоциативный контейнер замкнутых интервалов [first, second] со
+// значениями (временные окна, диапазоны адресов). Интервалы упорядочены по
+// левому концу, а каждый узел дерева хранит наибольший правый конец своего
+// поддерева. Поэтому вопрос "пересекает ли что-нибудь точку или отрезок"
+// решается одним спуском за O(log n), а перечисление всех пересечений
+// заходит только в поддеревья, где они есть, и останавливается на первом
+// интервале правее запроса. Одинаковые интервалы допускаются.
+template <typename Key, typename Type> class interval_map {
+public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using interval_type = std::pair<key_type, key_type>;
+  using value_type = std::pair<const interval_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+
+private:
+  // Порядок интервалов: по левому концу, затем по правому.
+  struct IntervalComparator {
+    bool operator()(const value_type &lhs, const value_type &rhs) const {
+      return lhs.first < rhs.first;
+    }
+  };
+
+  // Агрегат поддерева - наибольший правый конец.
+  struct MaxEndpoint {
+    using value_type = key_type;
+
+    static value_type Identity() {
+      return std::numeric_limits<key_type>::lowest();
+    }
+
+    static value_type Lift(const interval_map::value_type &element) {
+      return element.first.second;
+    }
+
+    static value_type Combine(const value_type &lhs, const value_type &rhs) {
+      return lhs < rhs ? rhs : lhs;
+    }
+  };
+
+  struct TreeOptions : DefaultTreeOptions {
+    using aggregate = MaxEndpoint;
+  };
+
+  using tree_type = RedBlackTree<value_type, IntervalComparator, TreeOptions>;
+
+public:
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+
+  // Конструкторы
+  interval_map() = default;
+  interval_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt> interval_map(InputIt first, InputIt last);
+
+  // Итераторы
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+
+  // Модификаторы
+  void clear() noexcept;
+  iterator insert(const value_type &value);
+  iterator insert(const key_type &lo, const key_type &hi,
+                  const mapped_type &obj);
+  void erase(iterator pos) noexcept;
+  template <typename InputIt> void assign(InputIt first, InputIt last);
+  void swap(interval_map &other) noexcept;
+
+  // Поиск пересечений
+  bool overlaps(const key_type &point) const;
+  const_iterator find_overlap(const key_type &lo, const key_type &hi) const;
+  std::vector<const_iterator> overlapping(const key_type &lo,
+                                          const key_type &hi) const;
+  template <typename Function>
+  void for_each_overlap(const key_type &lo, const key_type &hi,
+                        Function fn) const;
+
+private:
+  static void CheckInterval(const interval_type &interval);
+
+  tree_type tree_;
+};
+
+} // namespace s21
+
+#include "s21_interval_map.tpp"
+#endif // S21_CONTAINERS_INTERVAL_MAP_S21_INTERVAL_MAP_H_
@@ -0,0 +1,298 @@
+#include "s21_interval_map.h"
+
+namespace s21 {
+
+/**
+ * @brief Конструктор инициализации на основе списка интервалов.
+ *
+ * @param items Список интервалов со значениями.
+ * @throw std::invalid_argument Если у интервала левый конец больше правого.
+ */
+template <typename Key, typename Type>
+interval_map<Key, Type>::interval_map(
+    std::initializer_list<value_type> const &items) {
+  assign(items.begin(), items.end());
+}
+
+/**
+ * @brief Создает контейнер из последовательности интервалов.
+ *
+ * Упорядоченная по левому концу последовательность строится за O(n)
+ * (см. assign).
+ *
+ * @param first Начало последовательности.
+ * @param last Конец последовательности.
+ * @throw std::invalid_argument Если у интервала левый конец больше правого.
+ */
+template <typename Key, typename Type>
+template <typename InputIt>
+interval_map<Key, Type>::interval_map(InputIt first, InputIt last) {
+  assign(first, last);
+}
+
+/**
+ * @brief Возвращает итератор на интервал с наименьшим левым концом.
+ *
+ * @return Итератор на первый интервал.
+ */
+template <typename Key, typename Type>
+typename interval_map<Key, Type>::iterator
+interval_map<Key, Type>::begin() noexcept {
+  return tree_.Begin();
+}
+
+/**
+ * @brief Возвращает константный итератор на первый интервал.
+ *
+ * @return Константный итератор на первый интервал.
+ */
+template <typename Key, typename Type>
+typename interval_map<Key, Type>::const_iterator
+interval_map<Key, Type>::begin() const noexcept {
+  return tree_.Begin();
+}
+
+/**
+ * @brief Возвращает итератор за последним интервалом.
+ *
+ * @return Итератор конца.
+ */
+template <typename Key, typename Type>
+typename interval_map<Key, Type>::iterator
+interval_map<Key, Type>::end() noexcept {
+  return tree_.End();
+}
+
+/**
+ * @brief Возвращает константный итератор за последним интервалом.
+ *
+ * @return Константный итератор конца.
+ */
+template <typename Key, typename Type>
+typename interval_map<Key, Type>::const_iterator
+interval_map<Key, Type>::end() const noexcept {
+  return tree_.End();
+}
+
+/**
+ * @brief Проверяет, пуст ли контейнер.
+ *
+ * @return true, если интервалов нет.
+ */
+template <typename Key, typename Type>
+bool interval_map<Key, Type>::empty() const noexcept {
+  return tree_.Empty();
+}
+
+/**
+ * @brief Возвращает количество интервалов.
+ *
+ * @return Количество интервалов.
+ */
+template <typename Key, typename Type>
+typename interval_map<Key, Type>::size_type
+interval_map<Key, Type>::size() const noexcept {
+  return tree_.Size();
+}
+
+/**
+ * @brief Удаляет все интервалы.
+ */
+template <typename Key, typename Type>
+void interval_map<Key, Type>::clear() noexcept {
+  tree_.Clear();
+}
+
+/**
+ * @brief Добавляет интервал со значением.
+ *
+ * @param value Интервал [first, second] и значение.
+ * @return Итератор на добавленный интервал.
+ * @throw std::invalid_argument Если левый конец больше правого.
+ */
+template <typename Key, typename Type>
+typename interval_map<Key, Type>::iterator
+interval_map<Key, Type>::insert(const value_type &value) {
+  CheckInterval(value.first);
+  return tree_.Insert(value);
+}
+
+/**
+ * @brief Добавляет интервал [lo, hi] со значением.
+ *
+ * @param lo Левый конец.
+ * @param hi Правый конец.
+ * @param obj Значение.
+ * @return Итератор на добавленный интервал.
+ * @throw std::invalid_argument Если lo больше hi.
+ */
+template <typename Key, typename Type>
+typename interval_map<Key, Type>::iterator
+interval_map<Key, Type>::insert(const key_type &lo, const key_type &hi,
+                                const mapped_type &obj) {
+  return insert(value_type(interval_type(lo, hi), obj));
+}
+
+/**
+ * @brief Удаляет интервал по итератору.
+ *
+ * @param pos Итератор на удаляемый интервал.
+ */
+template <typename Key, typename Type>
+void interval_map<Key, Type>::erase(iterator pos) noexcept {
+  tree_.Erase(pos);
+}
+
+/**
+ * @brief Заменяет содержимое интервалами из последовательности.
+ *
+ * Если интервалы уже упорядочены по левому концу (как при выгрузке из
+ * другого interval_map или из отсортированного журнала), дерево строится
+ * снизу вверх за O(n) вместе с агрегатами, без вставок по одному.
+ * Иначе копия последовательности сначала сортируется.
+ *
+ * @param first Начало последовательности значений value_type.
+ * @param last Конец последовательности.
+ * @throw std::invalid_argument Если у интервала левый конец больше правого;
+ * содержимое контейнера при этом не меняется.
+ */
+template <typename Key, typename Type>
+template <typename InputIt>
+void interval_map<Key, Type>::assign(InputIt first, InputIt last) {
+  // Изменяемые копии: у value_type интервал константный, такие пары нельзя
+  // сортировать.
+  std::vector<std::pair<interval_type, mapped_type>> items(first, last);
+  for (const auto &item : items) {
+    CheckInterval(item.first);
+  }
+  auto by_interval = [](const auto &lhs, const auto &rhs) {
+    return lhs.first < rhs.first;
+  };
+  if (!std::is_sorted(items.begin(), items.end(), by_interval)) {
+    std::stable_sort(items.begin(), items.end(), by_interval);
+  }
+  tree_.AssignSorted(items.begin(), items.end());
+}
+
+/**
+ * @brief Обменивает содержимое с другим контейнером.
+ *
+ * @param other Другой контейнер.
+ */
+template <typename Key, typename Type>
+void interval_map<Key, Type>::swap(interval_map &other) noexcept {
+  tree_.Swap(other.tree_);
+}
+
+/**
+ * @brief Проверяет, содержит ли точку хотя бы один интервал, за O(log n).
+ *
+ * @param point Точка.
+ * @return true, если есть интервал с first <= point <= second.
+ */
+template <typename Key, typename Type>
+bool interval_map<Key, Type>::overlaps(const key_type &point) const {
+  return find_overlap(point, point) != end();
+}
+
+/**
+ * @brief Находит интервал с наименьшим левым концом среди пересекающих
+ * отрезок [lo, hi], за O(log n).
+ *
+ * Поддеревья, где все правые концы меньше lo, пропускаются. Если в
+ * непропущенном левом поддереве нет пересечения, то в нем есть интервал,
+ * начинающийся правее hi, и обход на нем останавливается, поэтому спуск
+ * идет по одному пути.
+ *
+ * @param lo Левый конец запроса.
+ * @param hi Правый конец запроса.
+ * @return Итератор на найденный интервал или end().
+ */
+template <typename Key, typename Type>
+typename interval_map<Key, Type>::const_iterator
+interval_map<Key, Type>::find_overlap(const key_type &lo,
+                                      const key_type &hi) const {
+  const_iterator found = end();
+  for_each_overlap(lo, hi, [&found](const_iterator it) {
+    found = it;
+    return false;
+  });
+  return found;
+}
+
+/**
+ * @brief Возвращает все интервалы, пересекающие отрезок [lo, hi], в
+ * порядке левых концов.
+ *
+ * @param lo Левый конец запроса.
+ * @param hi Правый конец запроса.
+ * @return Итераторы на найденные интервалы.
+ */
+template <typename Key, typename Type>
+std::vector<typename interval_map<Key, Type>::const_iterator>
+interval_map<Key, Type>::overlapping(const key_type &lo,
+                                     const key_type &hi) const {
+  std::vector<const_iterator> result;
+  for_each_overlap(lo, hi, [&result](const_iterator it) {
+    result.push_back(it);
+    return true;
+  });
+  return result;
+}
+
+/**
+ * @brief Вызывает fn для каждого интервала, пересекающего отрезок [lo, hi],
+ * в порядке левых концов.
+ *
+ * Посещаются только поддеревья, наибольший правый конец которых не меньше
+ * lo, и только интервалы с левым концом не больше hi: O(log n) на первое
+ * пересечение и далее пропорционально числу найденных (с множителем
+ * O(log n) в худшем случае).
+ *
+ * @param lo Левый конец запроса.
+ * @param hi Правый конец запроса; при hi < lo пересечений нет.
+ * @param fn Обработчик const_iterator; если он возвращает bool, false
+ * останавливает перечисление.
+ */
+template <typename Key, typename Type>
+template <typename Function>
+void interval_map<Key, Type>::for_each_overlap(const key_type &lo,
+                                               const key_type &hi,
+                                               Function fn) const {
+  if (hi < lo) {
+    return;
+  }
+  tree_.VisitInOrder(
+      [&lo](const key_type &max_endpoint) { return max_endpoint < lo; },
+      [&lo, &hi, &fn](const_iterator it) {
+        const interval_type &interval = (*it).first;
+        if (hi < interval.first) {
+          return false; // дальше только интервалы правее запроса
+        }
+        if (interval.second < lo) {
+          return true;
+        }
+        if constexpr (std::is_same<decltype(fn(it)), bool>::value) {
+          return fn(it);
+        } else {
+          fn(it);
+          return true;
+        }
+      });
+}
+
+/**
+ * @brief Проверяет, что левый конец интервала не больше правого.
+ *
+ * @param interval Интервал.
+ * @throw std::invalid_argument Если левый конец больше правого.
+ */
+template <typename Key, typename Type>
+void interval_map<Key, Type>::CheckInterval(const interval_type &interval) {
+  if (interval.second < interval.first) {
+    throw std::invalid_argument(
+        "s21::interval_map: Левый конец интервала больше правого.");
+  }
+}
+
+} // namespace s21
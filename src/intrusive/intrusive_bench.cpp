@@ -0,0 +1,123 @@
+// Сравнение s21::intrusive_set с s21::set<int> и s21::intrusive_list с
+// s21::List<int> на объектах, которые уже лежат в своем массиве: вставка и
+// удаление всех объектов и число обращений к operator new за это время.
+//
+// Сборка: g++ -std=c++17 -O2 intrusive_bench.cpp -o intrusive_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../bench/HeapCounter.h"
+#include "../list/s21_list.h"
+#include "../set/s21_set.h"
+#include "s21_intrusive_list.h"
+#include "s21_intrusive_set.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsPerOp(Clock::time_point start, std::size_t ops) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+             .count() /
+         static_cast<double>(ops);
+}
+
+struct Object {
+  int key_;
+  s21::list_hook queue_;
+  s21::set_hook index_;
+
+  bool operator<(const Object &other) const { return key_ < other.key_; }
+};
+
+void Report(const char *name, double insert_ns, double erase_ns,
+            std::size_t calls) {
+  std::printf("  %-22s insert %6.1f ns/op  erase %6.1f ns/op  %zu new\n", name,
+              insert_ns, erase_ns, calls);
+}
+
+void RunSets(std::vector<Object> &objects) {
+  std::size_t count = objects.size();
+  {
+    s21::intrusive_set<Object, &Object::index_> set;
+    std::size_t calls = s21::bench::new_calls;
+    auto start = Clock::now();
+    for (auto &object : objects) {
+      set.insert(object);
+    }
+    double insert_ns = NanosecondsPerOp(start, count);
+    start = Clock::now();
+    for (auto &object : objects) {
+      set.remove(object);
+    }
+    Report("s21::intrusive_set", insert_ns, NanosecondsPerOp(start, count),
+           s21::bench::new_calls - calls);
+  }
+  {
+    s21::set<int> set;
+    std::size_t calls = s21::bench::new_calls;
+    auto start = Clock::now();
+    for (auto &object : objects) {
+      set.insert(object.key_);
+    }
+    double insert_ns = NanosecondsPerOp(start, count);
+    start = Clock::now();
+    for (auto &object : objects) {
+      set.erase(object.key_);
+    }
+    Report("s21::set<int>", insert_ns, NanosecondsPerOp(start, count),
+           s21::bench::new_calls - calls);
+  }
+}
+
+void RunLists(std::vector<Object> &objects) {
+  std::size_t count = objects.size();
+  {
+    s21::intrusive_list<Object, &Object::queue_> list;
+    std::size_t calls = s21::bench::new_calls;
+    auto start = Clock::now();
+    for (auto &object : objects) {
+      list.push_back(object);
+    }
+    double insert_ns = NanosecondsPerOp(start, count);
+    start = Clock::now();
+    while (!list.empty()) {
+      list.pop_front();
+    }
+    Report("s21::intrusive_list", insert_ns, NanosecondsPerOp(start, count),
+           s21::bench::new_calls - calls);
+  }
+  {
+    s21::List<int> list;
+    std::size_t calls = s21::bench::new_calls;
+    auto start = Clock::now();
+    for (auto &object : objects) {
+      list.push_back(object.key_);
+    }
+    double insert_ns = NanosecondsPerOp(start, count);
+    start = Clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+      list.pop_front();
+    }
+    Report("s21::List<int>", insert_ns, NanosecondsPerOp(start, count),
+           s21::bench::new_calls - calls);
+  }
+}
+} // namespace
+
+int main() {
+  const std::size_t kCount = 1000000;
+  std::mt19937 gen(38);
+  std::vector<Object> objects(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    objects[i].key_ = static_cast<int>(i);
+  }
+  std::shuffle(objects.begin(), objects.end(), gen);
+  std::printf("%zu objects in random key order\n", kCount);
+  RunSets(objects);
+  RunLists(objects);
+  return 0;
+}
@@ -0,0 +1,263 @@
+#include "s21_intrusive_list.h"
+#include "s21_intrusive_set.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace s21 {
+namespace {
+// Объект, который одновременно состоит в списке и в двух множествах.
+struct Item {
+  explicit Item(int id = 0) : id_(id), name_("item-" + std::to_string(id)) {}
+
+  int id_;
+  std::string name_;
+  s21::list_hook order_;
+  s21::set_hook by_id_;
+  s21::set_hook by_name_;
+};
+
+struct ById {
+  bool operator()(const Item &lhs, const Item &rhs) const {
+    return lhs.id_ < rhs.id_;
+  }
+  bool operator()(const Item &lhs, int rhs) const { return lhs.id_ < rhs; }
+  bool operator()(int lhs, const Item &rhs) const { return lhs < rhs.id_; }
+};
+
+struct ByName {
+  bool operator()(const Item &lhs, const Item &rhs) const {
+    return lhs.name_ < rhs.name_;
+  }
+};
+
+using ItemList = s21::intrusive_list<Item, &Item::order_>;
+using IdSet = s21::intrusive_set<Item, &Item::by_id_, ById>;
+using NameSet = s21::intrusive_set<Item, &Item::by_name_, ByName>;
+
+std::vector<int> Ids(const ItemList &list) {
+  std::vector<int> ids;
+  for (const Item &item : list) {
+    ids.push_back(item.id_);
+  }
+  return ids;
+}
+
+// Черная высота поддерева или -1, если нарушены свойства красно-черного
+// дерева или связи с родителем.
+int BlackHeight(const s21::set_hook *node) {
+  if (node == nullptr) {
+    return 1;
+  }
+  for (const s21::set_hook *child : {node->left_, node->right_}) {
+    if (child != nullptr &&
+        (child->parent() != node ||
+         (node->color() == s21::RED && child->color() == s21::RED))) {
+      return -1;
+    }
+  }
+  int left = BlackHeight(node->left_);
+  int right = BlackHeight(node->right_);
+  if (left < 0 || left != right) {
+    return -1;
+  }
+  return left + (node->color() == s21::BLACK ? 1 : 0);
+}
+
+bool IsValidTree(const IdSet &set) {
+  if (set.empty()) {
+    return true;
+  }
+  // Поднимаемся к корню: родитель корня - фиктивный узел, чей parent() -
+  // снова корень.
+  const s21::set_hook *root = &(*set.begin()).by_id_;
+  while (root->parent()->parent() != root) {
+    root = root->parent();
+  }
+  return root->color() == s21::BLACK && BlackHeight(root) > 0;
+}
+} // namespace
+
+TEST(IntrusiveListTest, LinksObjectsInPlace) {
+  std::vector<Item> items;
+  for (int i = 0; i < 6; ++i) {
+    items.emplace_back(i);
+  }
+  ItemList list;
+  EXPECT_TRUE(list.empty());
+  list.push_back(items[1]);
+  list.push_back(items[2]);
+  list.push_front(items[0]);
+  auto it = list.insert(list.iterator_to(items[2]), items[3]);
+  EXPECT_EQ(it->id_, 3);
+  EXPECT_EQ(Ids(list), (std::vector<int>{0, 1, 3, 2}));
+  EXPECT_EQ(&list.front(), &items[0]);
+  EXPECT_EQ(&list.back(), &items[2]);
+  EXPECT_TRUE(items[3].order_.is_linked());
+  EXPECT_FALSE(items[4].order_.is_linked());
+
+  list.remove(items[1]);
+  EXPECT_FALSE(items[1].order_.is_linked());
+  EXPECT_EQ(list.erase(list.begin())->id_, 3);
+  list.pop_back();
+  EXPECT_EQ(Ids(list), (std::vector<int>{3}));
+
+  ItemList other;
+  other.push_back(items[4]);
+  other.push_back(items[5]);
+  list.splice(list.begin(), other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(Ids(list), (std::vector<int>{4, 5, 3}));
+
+  ItemList moved = std::move(list);
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(moved.size(), 3U);
+  std::vector<int> backward;
+  for (auto rit = moved.end(); rit != moved.begin();) {
+    backward.push_back((--rit)->id_);
+  }
+  EXPECT_EQ(backward, (std::vector<int>{3, 5, 4}));
+
+  moved.swap(other);
+  EXPECT_EQ(Ids(other), (std::vector<int>{4, 5, 3}));
+  other.clear();
+  for (const Item &item : items) {
+    EXPECT_FALSE(item.order_.is_linked());
+  }
+}
+
+TEST(IntrusiveSetTest, RandomOperationsMatchStdSet) {
+  std::mt19937 gen(38);
+  std::vector<Item> items;
+  for (int i = 0; i < 2000; ++i) {
+    items.emplace_back(static_cast<int>(gen() % 1000));
+  }
+  IdSet set;
+  std::set<int> ref;
+  for (int step = 0; step < 20000; ++step) {
+    Item &item = items[gen() % items.size()];
+    if (item.by_id_.is_linked()) {
+      EXPECT_EQ(&*set.find(item.id_), &item);
+      set.remove(item);
+      ref.erase(item.id_);
+      EXPECT_FALSE(item.by_id_.is_linked());
+    } else {
+      auto [it, inserted] = set.insert(item);
+      EXPECT_EQ(inserted, ref.insert(item.id_).second);
+      EXPECT_EQ(it->id_, item.id_);
+      EXPECT_EQ(item.by_id_.is_linked(), inserted);
+    }
+    if (step % 1000 == 0) {
+      ASSERT_TRUE(IsValidTree(set));
+    }
+  }
+  ASSERT_EQ(set.size(), ref.size());
+  EXPECT_TRUE(IsValidTree(set));
+  std::vector<int> ids;
+  for (const Item &item : set) {
+    ids.push_back(item.id_);
+  }
+  EXPECT_TRUE(std::equal(ids.begin(), ids.end(), ref.begin(), ref.end()));
+
+  for (int key = -1; key <= 1001; key += 7) {
+    auto lower = set.lower_bound(key);
+    auto ref_lower = ref.lower_bound(key);
+    EXPECT_EQ(lower == set.end(), ref_lower == ref.end());
+    if (ref_lower != ref.end()) {
+      EXPECT_EQ(lower->id_, *ref_lower);
+    }
+    auto upper = set.upper_bound(key);
+    auto ref_upper = ref.upper_bound(key);
+    EXPECT_EQ(upper == set.end(), ref_upper == ref.end());
+    if (ref_upper != ref.end()) {
+      EXPECT_EQ(upper->id_, *ref_upper);
+    }
+    EXPECT_EQ(set.count(key), ref.count(key));
+  }
+
+  // Обход назад и удаление по итератору.
+  auto it = set.end();
+  --it;
+  EXPECT_EQ(it->id_, *ref.rbegin());
+  for (auto pos = set.begin(); pos != set.end();) {
+    pos = pos->id_ % 2 == 0 ? set.erase(pos) : std::next(pos);
+  }
+  EXPECT_TRUE(IsValidTree(set));
+  for (const Item &item : set) {
+    EXPECT_EQ(item.id_ % 2, 1);
+  }
+  set.clear();
+  EXPECT_TRUE(set.begin() == set.end());
+  for (const Item &item : items) {
+    EXPECT_FALSE(item.by_id_.is_linked());
+  }
+}
+
+TEST(IntrusiveSetTest, ObjectInSeveralContainers) {
+  std::list<Item> storage;
+  for (int id : {5, 12, 3, 40, 7}) {
+    storage.emplace_back(id);
+  }
+  ItemList order;
+  IdSet by_id;
+  NameSet by_name;
+  for (Item &item : storage) {
+    order.push_back(item);
+    EXPECT_TRUE(by_id.insert(item).second);
+    EXPECT_TRUE(by_name.insert(item).second);
+  }
+  Item duplicate(12);
+  EXPECT_FALSE(by_id.insert(duplicate).second);
+  EXPECT_FALSE(duplicate.by_id_.is_linked());
+
+  std::vector<int> ids;
+  for (const Item &item : by_id) {
+    ids.push_back(item.id_);
+  }
+  EXPECT_EQ(ids, (std::vector<int>{3, 5, 7, 12, 40}));
+  std::vector<std::string> names;
+  for (const Item &item : by_name) {
+    names.push_back(item.name_);
+  }
+  EXPECT_TRUE(std::is_sorted(names.begin(), names.end()));
+  EXPECT_EQ(Ids(order), (std::vector<int>{5, 12, 3, 40, 7}));
+
+  // Удаление из одного контейнера не трогает остальные.
+  Item &twelve = *by_id.find(12);
+  by_name.remove(twelve);
+  EXPECT_TRUE(twelve.by_id_.is_linked());
+  EXPECT_TRUE(twelve.order_.is_linked());
+  EXPECT_EQ(by_name.size(), 4U);
+  EXPECT_FALSE(by_name.contains(twelve));
+
+  IdSet moved(std::move(by_id));
+  EXPECT_TRUE(by_id.empty());
+  EXPECT_EQ(moved.size(), 5U);
+  EXPECT_EQ(&*moved.iterator_to(twelve), &twelve);
+  EXPECT_TRUE(IsValidTree(moved));
+  IdSet other;
+  other.swap(moved);
+  EXPECT_EQ(other.begin()->id_, 3);
+  EXPECT_TRUE(moved.empty());
+
+  order.clear();
+  other.clear();
+  by_name.clear();
+  for (const Item &item : storage) {
+    EXPECT_FALSE(item.order_.is_linked());
+    EXPECT_FALSE(item.by_id_.is_linked());
+    EXPECT_FALSE(item.by_name_.is_linked());
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
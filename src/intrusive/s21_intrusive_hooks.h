@@ -0,0 +1,64 @@
+#ifndef S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_HOOKS_H_
+#define S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_HOOKS_H_
+
+#include <cstddef>
+
+#include "../tree/RedBlackTreeAlgorithms.h"
+
+namespace s21 {
+
+// Звено s21::intrusive_list, встраиваемое в объект полем. Объект с
+// несколькими звеньями может одновременно состоять в нескольких списках.
+// Копирование объекта не копирует связи: копия ни в одном списке не состоит.
+struct list_hook {
+  list_hook() noexcept = default;
+  list_hook(const list_hook &) noexcept {}
+  list_hook &operator=(const list_hook &) noexcept { return *this; }
+
+  [[nodiscard]] bool is_linked() const noexcept { return next_ != nullptr; }
+
+  list_hook *prev_ = nullptr;
+  list_hook *next_ = nullptr;
+};
+
+// Звено s21::intrusive_set: узел красно-черного дерева без ключа, ключом
+// служит сам объект. Правила копирования те же, что у list_hook.
+struct set_hook : TreeNodeLinks<set_hook> {
+  set_hook() noexcept = default;
+  set_hook(const set_hook &) noexcept : TreeNodeLinks<set_hook>() {}
+  set_hook &operator=(const set_hook &) noexcept { return *this; }
+
+  [[nodiscard]] bool is_linked() const noexcept { return parent() != nullptr; }
+};
+
+// Переход от звена Member к объекту, в который оно встроено, и обратно.
+template <typename T, typename Hook, Hook T::*Member> struct HookTraits {
+  static Hook *HookOf(T &object) noexcept { return &(object.*Member); }
+
+  static T *Owner(const Hook *hook) noexcept {
+    return reinterpret_cast<T *>(
+        reinterpret_cast<char *>(const_cast<Hook *>(hook)) - Offset());
+  }
+
+private:
+  // Смещение звена внутри объекта. Объект-образец не конструируется: берется
+  // только адрес его поля, а константная инициализация не требует проверок
+  // при каждом вызове.
+  union Probe {
+    constexpr Probe() noexcept : byte_() {}
+    ~Probe() {}
+
+    char byte_;
+    T object_;
+  };
+
+  static std::ptrdiff_t Offset() noexcept {
+    static const Probe probe;
+    return reinterpret_cast<const char *>(&(probe.object_.*Member)) -
+           reinterpret_cast<const char *>(&probe.object_);
+  }
+};
+
+} // namespace s21
+
+#endif // S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_HOOKS_H_
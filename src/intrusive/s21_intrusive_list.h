@@ -0,0 +1,142 @@
+#ifndef S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_LIST_H_
+#define S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_LIST_H_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "s21_intrusive_hooks.h"
+
+namespace s21 {
+
+// Интрузивный двусвязный список: связи хранятся в звене Hook, встроенном в
+// сами объекты, поэтому вставка и удаление не выделяют память и не копируют
+// элементы. Список не владеет объектами: clear() и деструктор только
+// отсоединяют их. Пока объект в списке, он не должен перемещаться в памяти
+// или разрушаться; вставлять можно только объекты с несвязанным звеном.
+template <typename T, list_hook T::*Hook> class intrusive_list {
+private:
+  using Traits = HookTraits<T, list_hook, Hook>;
+  template <bool IsConst> class IntrusiveListIterator;
+
+public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = IntrusiveListIterator<false>;
+  using const_iterator = IntrusiveListIterator<true>;
+  using size_type = std::size_t;
+
+  // Конструкторы, деструктор и операторы присваивания
+  intrusive_list() noexcept;
+  intrusive_list(const intrusive_list &) = delete;
+  intrusive_list(intrusive_list &&other) noexcept;
+  ~intrusive_list();
+
+  intrusive_list &operator=(const intrusive_list &) = delete;
+  intrusive_list &operator=(intrusive_list &&other) noexcept;
+
+  // Доступ к элементам
+  reference front() noexcept;
+  const_reference front() const noexcept;
+  reference back() noexcept;
+  const_reference back() const noexcept;
+
+  // Итераторы
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  iterator iterator_to(reference value) noexcept;
+  const_iterator iterator_to(const_reference value) const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+
+  // Модификаторы
+  void clear() noexcept;
+  iterator insert(const_iterator pos, reference value) noexcept;
+  iterator erase(const_iterator pos) noexcept;
+  void remove(reference value) noexcept;
+  void push_back(reference value) noexcept;
+  void push_front(reference value) noexcept;
+  void pop_back() noexcept;
+  void pop_front() noexcept;
+  void splice(const_iterator pos, intrusive_list &other) noexcept;
+  void swap(intrusive_list &other) noexcept;
+
+private:
+  static void Unlink(list_hook *hook) noexcept;
+  void RelinkHead() noexcept;
+
+  template <bool IsConst> class IntrusiveListIterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+    using hook_pointer =
+        std::conditional_t<IsConst, const list_hook *, list_hook *>;
+
+    IntrusiveListIterator() noexcept = default;
+
+    explicit IntrusiveListIterator(hook_pointer node) noexcept : node_(node) {}
+
+    template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+    IntrusiveListIterator(const IntrusiveListIterator<WasConst> &other) noexcept
+        : node_(other.node_) {}
+
+    reference operator*() const noexcept { return *Traits::Owner(node_); }
+
+    pointer operator->() const noexcept { return Traits::Owner(node_); }
+
+    IntrusiveListIterator &operator++() noexcept {
+      node_ = node_->next_;
+      return *this;
+    }
+
+    IntrusiveListIterator operator++(int) noexcept {
+      IntrusiveListIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    IntrusiveListIterator &operator--() noexcept {
+      node_ = node_->prev_;
+      return *this;
+    }
+
+    IntrusiveListIterator operator--(int) noexcept {
+      IntrusiveListIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const IntrusiveListIterator &lhs,
+                           const IntrusiveListIterator &rhs) noexcept {
+      return lhs.node_ == rhs.node_;
+    }
+
+    friend bool operator!=(const IntrusiveListIterator &lhs,
+                           const IntrusiveListIterator &rhs) noexcept {
+      return lhs.node_ != rhs.node_;
+    }
+
+  private:
+    friend class intrusive_list;
+    template <bool> friend class IntrusiveListIterator;
+
+    hook_pointer node_ = nullptr;
+  };
+
+  list_hook head_;
+  size_type size_;
+};
+
+} // namespace s21
+
+#include "s21_intrusive_list.tpp"
+#endif // S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_LIST_H_
@@ -0,0 +1,331 @@
+#include "s21_intrusive_list.h"
+
+namespace s21 {
+
+/**
+ * @brief Конструктор по умолчанию. Создает пустой список.
+ *
+ * Фиктивное звено head_ замыкается само на себя.
+ */
+template <typename T, list_hook T::*Hook>
+intrusive_list<T, Hook>::intrusive_list() noexcept : size_(0) {
+  head_.prev_ = head_.next_ = &head_;
+}
+
+/**
+ * @brief Конструктор перемещения. Забирает объекты у other.
+ *
+ * @param other Список, который после перемещения становится пустым.
+ */
+template <typename T, list_hook T::*Hook>
+intrusive_list<T, Hook>::intrusive_list(intrusive_list &&other) noexcept
+    : intrusive_list() {
+  swap(other);
+}
+
+/**
+ * @brief Деструктор. Отсоединяет все объекты, не разрушая их.
+ */
+template <typename T, list_hook T::*Hook>
+intrusive_list<T, Hook>::~intrusive_list() {
+  clear();
+}
+
+/**
+ * @brief Перемещающее присваивание. Прежние объекты текущего списка
+ * отсоединяются.
+ *
+ * @param other Список, который после перемещения становится пустым.
+ * @return Ссылка на текущий список.
+ */
+template <typename T, list_hook T::*Hook>
+intrusive_list<T, Hook> &
+intrusive_list<T, Hook>::operator=(intrusive_list &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Возвращает ссылку на первый элемент. Список не должен быть пуст.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::reference
+intrusive_list<T, Hook>::front() noexcept {
+  return *Traits::Owner(head_.next_);
+}
+
+/**
+ * @brief Возвращает константную ссылку на первый элемент.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::const_reference
+intrusive_list<T, Hook>::front() const noexcept {
+  return *Traits::Owner(head_.next_);
+}
+
+/**
+ * @brief Возвращает ссылку на последний элемент. Список не должен быть пуст.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::reference
+intrusive_list<T, Hook>::back() noexcept {
+  return *Traits::Owner(head_.prev_);
+}
+
+/**
+ * @brief Возвращает константную ссылку на последний элемент.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::const_reference
+intrusive_list<T, Hook>::back() const noexcept {
+  return *Traits::Owner(head_.prev_);
+}
+
+/**
+ * @brief Итератор на первый элемент.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::begin() noexcept {
+  return iterator(head_.next_);
+}
+
+/**
+ * @brief Константный итератор на первый элемент.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::const_iterator
+intrusive_list<T, Hook>::begin() const noexcept {
+  return const_iterator(head_.next_);
+}
+
+/**
+ * @brief Итератор за последним элементом (фиктивное звено).
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::end() noexcept {
+  return iterator(&head_);
+}
+
+/**
+ * @brief Константный итератор за последним элементом.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::const_iterator
+intrusive_list<T, Hook>::end() const noexcept {
+  return const_iterator(&head_);
+}
+
+/**
+ * @brief Итератор на объект, который уже состоит в этом списке.
+ *
+ * Работает за O(1): позиция объекта известна по его звену.
+ *
+ * @param value Объект из списка.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::iterator_to(reference value) noexcept {
+  return iterator(Traits::HookOf(value));
+}
+
+/**
+ * @brief Константный итератор на объект, который уже состоит в этом списке.
+ *
+ * @param value Объект из списка.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::const_iterator
+intrusive_list<T, Hook>::iterator_to(const_reference value) const noexcept {
+  return const_iterator(&(value.*Hook));
+}
+
+/**
+ * @brief Проверяет, пуст ли список.
+ */
+template <typename T, list_hook T::*Hook>
+bool intrusive_list<T, Hook>::empty() const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Возвращает количество элементов.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::size_type
+intrusive_list<T, Hook>::size() const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Отсоединяет все объекты. Сами объекты не разрушаются, их звенья
+ * снова свободны.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::clear() noexcept {
+  list_hook *node = head_.next_;
+  while (node != &head_) {
+    list_hook *next = node->next_;
+    node->prev_ = node->next_ = nullptr;
+    node = next;
+  }
+  head_.prev_ = head_.next_ = &head_;
+  size_ = 0;
+}
+
+/**
+ * @brief Вставляет объект перед позицией pos без выделения памяти.
+ *
+ * @param pos Позиция, перед которой встает объект.
+ * @param value Объект с несвязанным звеном.
+ * @return Итератор на вставленный объект.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::insert(const_iterator pos, reference value) noexcept {
+  list_hook *next = const_cast<list_hook *>(pos.node_);
+  list_hook *hook = Traits::HookOf(value);
+  hook->prev_ = next->prev_;
+  hook->next_ = next;
+  next->prev_->next_ = hook;
+  next->prev_ = hook;
+  ++size_;
+  return iterator(hook);
+}
+
+/**
+ * @brief Отсоединяет объект в позиции pos.
+ *
+ * @param pos Итератор на элемент (не end()).
+ * @return Итератор на следующий элемент.
+ */
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::erase(const_iterator pos) noexcept {
+  list_hook *hook = const_cast<list_hook *>(pos.node_);
+  list_hook *next = hook->next_;
+  Unlink(hook);
+  --size_;
+  return iterator(next);
+}
+
+/**
+ * @brief Отсоединяет объект, который состоит в этом списке, за O(1).
+ *
+ * @param value Объект из списка.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::remove(reference value) noexcept {
+  Unlink(Traits::HookOf(value));
+  --size_;
+}
+
+/**
+ * @brief Добавляет объект в конец списка.
+ *
+ * @param value Объект с несвязанным звеном.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::push_back(reference value) noexcept {
+  insert(end(), value);
+}
+
+/**
+ * @brief Добавляет объект в начало списка.
+ *
+ * @param value Объект с несвязанным звеном.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::push_front(reference value) noexcept {
+  insert(begin(), value);
+}
+
+/**
+ * @brief Отсоединяет последний объект. Для пустого списка ничего не делает.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::pop_back() noexcept {
+  if (size_ != 0) {
+    Unlink(head_.prev_);
+    --size_;
+  }
+}
+
+/**
+ * @brief Отсоединяет первый объект. Для пустого списка ничего не делает.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::pop_front() noexcept {
+  if (size_ != 0) {
+    Unlink(head_.next_);
+    --size_;
+  }
+}
+
+/**
+ * @brief Переносит все объекты other перед позицией pos за O(1).
+ *
+ * @param pos Позиция в текущем списке.
+ * @param other Другой список; после переноса он пуст.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos,
+                                     intrusive_list &other) noexcept {
+  if (this == &other || other.size_ == 0) {
+    return;
+  }
+  list_hook *next = const_cast<list_hook *>(pos.node_);
+  list_hook *first = other.head_.next_;
+  list_hook *last = other.head_.prev_;
+  first->prev_ = next->prev_;
+  next->prev_->next_ = first;
+  last->next_ = next;
+  next->prev_ = last;
+  size_ += other.size_;
+  other.head_.prev_ = other.head_.next_ = &other.head_;
+  other.size_ = 0;
+}
+
+/**
+ * @brief Обменивает содержимое списков за O(1).
+ *
+ * @param other Список для обмена.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::swap(intrusive_list &other) noexcept {
+  std::swap(head_.prev_, other.head_.prev_);
+  std::swap(head_.next_, other.head_.next_);
+  std::swap(size_, other.size_);
+  RelinkHead();
+  other.RelinkHead();
+}
+
+/**
+ * @brief Исключает звено из кольца и помечает его несвязанным.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::Unlink(list_hook *hook) noexcept {
+  hook->prev_->next_ = hook->next_;
+  hook->next_->prev_ = hook->prev_;
+  hook->prev_ = hook->next_ = nullptr;
+}
+
+/**
+ * @brief Восстанавливает ссылки крайних элементов на head_ после обмена
+ * фиктивными звеньями.
+ */
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::RelinkHead() noexcept {
+  if (size_ == 0) {
+    head_.prev_ = head_.next_ = &head_;
+  } else {
+    head_.next_->prev_ = &head_;
+    head_.prev_->next_ = &head_;
+  }
+}
+
+} // namespace s21
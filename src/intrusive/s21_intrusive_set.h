@@ -0,0 +1,159 @@
+#ifndef S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_SET_H_
+#define S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_SET_H_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "../stats/ContainerStats.h"
+#include "s21_intrusive_hooks.h"
+
+namespace s21 {
+
+// Интрузивное множество уникальных объектов на красно-черном дереве. Узлом
+// дерева служит звено Hook, встроенное в объект, а ключом - сам объект,
+// поэтому вставка и удаление не выделяют память и не копируют элементы.
+// Обход и балансировка - те же RedBlackTreeAlgorithms, что у RedBlackTree.
+//
+// Множество не владеет объектами: clear() и деструктор только отсоединяют
+// их. Пока объект в множестве, он не должен перемещаться в памяти или
+// разрушаться, а поля, от которых зависит сравнение, - меняться.
+template <typename T, set_hook T::*Hook, typename Compare = std::less<T>>
+class intrusive_set {
+private:
+  using Traits = HookTraits<T, set_hook, Hook>;
+  using TreeAlgorithms = RedBlackTreeAlgorithms<set_hook>;
+  template <bool IsConst> class IntrusiveSetIterator;
+
+  // Интрузивные контейнеры счетчиков не ведут.
+  using NoStats = StatsCounters<false>;
+
+public:
+  using value_type = T;
+  using key_compare = Compare;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = IntrusiveSetIterator<false>;
+  using const_iterator = IntrusiveSetIterator<true>;
+  using size_type = std::size_t;
+
+  // Конструкторы, деструктор и операторы присваивания
+  intrusive_set() noexcept;
+  explicit intrusive_set(const Compare &comparator) noexcept;
+  intrusive_set(const intrusive_set &) = delete;
+  intrusive_set(intrusive_set &&other) noexcept;
+  ~intrusive_set();
+
+  intrusive_set &operator=(const intrusive_set &) = delete;
+  intrusive_set &operator=(intrusive_set &&other) noexcept;
+
+  // Итераторы
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  iterator iterator_to(reference value) noexcept;
+  const_iterator iterator_to(const_reference value) const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+
+  // Модификаторы
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(reference value);
+  iterator erase(const_iterator pos) noexcept;
+  void remove(reference value) noexcept;
+  void swap(intrusive_set &other) noexcept;
+
+  // Поиск. Ключ сравнивается с объектами компаратором в обе стороны, поэтому
+  // искать можно не только объектом, но и любым ключом, который компаратор
+  // умеет сравнивать с T.
+  template <typename Key> iterator find(const Key &key);
+  template <typename Key> const_iterator find(const Key &key) const;
+  template <typename Key> bool contains(const Key &key) const;
+  template <typename Key> size_type count(const Key &key) const;
+  template <typename Key> iterator lower_bound(const Key &key);
+  template <typename Key> iterator upper_bound(const Key &key);
+
+private:
+  template <typename Key> set_hook *LowerBound(const Key &key) const;
+  template <typename Key> set_hook *UpperBound(const Key &key) const;
+  static void ResetLinks(set_hook *node) noexcept;
+  void InitializeHead() noexcept;
+  void RelinkHead() noexcept;
+
+  template <bool IsConst> class IntrusiveSetIterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+    using hook_pointer =
+        std::conditional_t<IsConst, const set_hook *, set_hook *>;
+
+    IntrusiveSetIterator() noexcept = default;
+
+    explicit IntrusiveSetIterator(hook_pointer node) noexcept : node_(node) {}
+
+    template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+    IntrusiveSetIterator(const IntrusiveSetIterator<WasConst> &other) noexcept
+        : node_(other.node_) {}
+
+    reference operator*() const noexcept { return *Traits::Owner(node_); }
+
+    pointer operator->() const noexcept { return Traits::Owner(node_); }
+
+    IntrusiveSetIterator &operator++() noexcept {
+      node_ = TreeAlgorithms::NextNode(node_);
+      return *this;
+    }
+
+    IntrusiveSetIterator operator++(int) noexcept {
+      IntrusiveSetIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    IntrusiveSetIterator &operator--() noexcept {
+      node_ = TreeAlgorithms::PrevNode(node_);
+      return *this;
+    }
+
+    IntrusiveSetIterator operator--(int) noexcept {
+      IntrusiveSetIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const IntrusiveSetIterator &lhs,
+                           const IntrusiveSetIterator &rhs) noexcept {
+      return lhs.node_ == rhs.node_;
+    }
+
+    friend bool operator!=(const IntrusiveSetIterator &lhs,
+                           const IntrusiveSetIterator &rhs) noexcept {
+      return lhs.node_ != rhs.node_;
+    }
+
+  private:
+    friend class intrusive_set;
+    template <bool> friend class IntrusiveSetIterator;
+
+    hook_pointer node_ = nullptr;
+  };
+
+  // Фиктивный узел дерева: parent() - корень, left_ - минимум, right_ -
+  // максимум. Красный, как того требуют RedBlackTreeAlgorithms.
+  set_hook head_;
+  size_type size_;
+  Compare comparator_;
+};
+
+} // namespace s21
+
+#include "s21_intrusive_set.tpp"
+#endif // S21_CONTAINERS_INTRUSIVE_S21_INTRUSIVE_SET_H_
@@ -0,0 +1,419 @@
+#include "s21_intrusive_set.h"
+
+namespace s21 {
+
+/**
+ * @brief Конструктор по умолчанию. Создает пустое множество.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+intrusive_set<T, Hook, Compare>::intrusive_set() noexcept : size_(0) {
+  InitializeHead();
+}
+
+/**
+ * @brief Создает пустое множество с заданным компаратором.
+ *
+ * @param comparator Компаратор объектов.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+intrusive_set<T, Hook, Compare>::intrusive_set(
+    const Compare &comparator) noexcept
+    : size_(0), comparator_(comparator) {
+  InitializeHead();
+}
+
+/**
+ * @brief Конструктор перемещения. Забирает объекты у other.
+ *
+ * @param other Множество, которое после перемещения становится пустым.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+intrusive_set<T, Hook, Compare>::intrusive_set(intrusive_set &&other) noexcept
+    : intrusive_set(other.comparator_) {
+  swap(other);
+}
+
+/**
+ * @brief Деструктор. Отсоединяет все объекты, не разрушая их.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+intrusive_set<T, Hook, Compare>::~intrusive_set() {
+  clear();
+}
+
+/**
+ * @brief Перемещающее присваивание. Прежние объекты текущего множества
+ * отсоединяются.
+ *
+ * @param other Множество, которое после перемещения становится пустым.
+ * @return Ссылка на текущее множество.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+intrusive_set<T, Hook, Compare> &
+intrusive_set<T, Hook, Compare>::operator=(intrusive_set &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Итератор на наименьший элемент.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+typename intrusive_set<T, Hook, Compare>::iterator
+intrusive_set<T, Hook, Compare>::begin() noexcept {
+  return iterator(head_.left_);
+}
+
+/**
+ * @brief Константный итератор на наименьший элемент.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+typename intrusive_set<T, Hook, Compare>::const_iterator
+intrusive_set<T, Hook, Compare>::begin() const noexcept {
+  return const_iterator(head_.left_);
+}
+
+/**
+ * @brief Итератор за наибольшим элементом (фиктивный узел).
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+typename intrusive_set<T, Hook, Compare>::iterator
+intrusive_set<T, Hook, Compare>::end() noexcept {
+  return iterator(&head_);
+}
+
+/**
+ * @brief Константный итератор за наибольшим элементом.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+typename intrusive_set<T, Hook, Compare>::const_iterator
+intrusive_set<T, Hook, Compare>::end() const noexcept {
+  return const_iterator(&head_);
+}
+
+/**
+ * @brief Итератор на объект, который уже состоит в этом множестве, за O(1).
+ *
+ * @param value Объект из множества.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+typename intrusive_set<T, Hook, Compare>::iterator
+intrusive_set<T, Hook, Compare>::iterator_to(reference value) noexcept {
+  return iterator(Traits::HookOf(value));
+}
+
+/**
+ * @brief Константный итератор на объект, который уже состоит в этом
+ * множестве.
+ *
+ * @param value Объект из множества.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+typename intrusive_set<T, Hook, Compare>::const_iterator
+intrusive_set<T, Hook, Compare>::iterator_to(
+    const_reference value) const noexcept {
+  return const_iterator(&(value.*Hook));
+}
+
+/**
+ * @brief Проверяет, пусто ли множество.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+bool intrusive_set<T, Hook, Compare>::empty() const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Возвращает количество элементов.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+typename intrusive_set<T, Hook, Compare>::size_type
+intrusive_set<T, Hook, Compare>::size() const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Отсоединяет все объекты за O(n) без рекурсии и стека.
+ *
+ * Левые поддеревья поворотами переносятся направо, после чего узлы
+ * отсоединяются по одному по правой цепочке.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+void intrusive_set<T, Hook, Compare>::clear() noexcept {
+  set_hook *node = head_.parent();
+  while (node != nullptr) {
+    if (node->left_ != nullptr) {
+      set_hook *left = node->left_;
+      node->left_ = left->right_;
+      left->right_ = node;
+      node = left;
+    } else {
+      set_hook *right = node->right_;
+      ResetLinks(node);
+      node = right;
+    }
+  }
+  InitializeHead();
+  size_ = 0;
+}
+
+/**
+ * @brief Вставляет объект, если эквивалентного ему еще нет, без выделения
+ * памяти.
+ *
+ * Спуск сравнивает ключи один раз на уровень: равенство проверяется после
+ * спуска с последним узлом, от которого спуск свернул вправо.
+ *
+ * @param value Объект с несвязанным звеном.
+ * @return Пара из итератора на вставленный (или уже имеющийся
+ * эквивалентный) объект и флага успешной вставки.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+std::pair<typename intrusive_set<T, Hook, Compare>::iterator, bool>
+intrusive_set<T, Hook, Compare>::insert(reference value) {
+  set_hook *parent = &head_;
+  set_hook *node = head_.parent();
+  // Последний узел, от которого спуск свернул вправо (он не больше value).
+  set_hook *not_greater = nullptr;
+  bool go_left = true;
+  while (node != nullptr) {
+    parent = node;
+    go_left = comparator_(value, *Traits::Owner(node));
+    if (go_left) {
+      node = node->left_;
+    } else {
+      not_greater = node;
+      node = node->right_;
+    }
+  }
+  if (not_greater != nullptr &&
+      !comparator_(*Traits::Owner(not_greater), value)) {
+    return {iterator(not_greater), false};
+  }
+
+  set_hook *hook = Traits::HookOf(value);
+  hook->set_parent(parent);
+  hook->left_ = hook->right_ = nullptr;
+  hook->set_color(RED);
+  if (parent == &head_) {
+    head_.left_ = head_.right_ = hook;
+    head_.set_parent(hook);
+  } else if (go_left) {
+    parent->left_ = hook;
+    if (parent == head_.left_) {
+      head_.left_ = hook;
+    }
+  } else {
+    parent->right_ = hook;
+    if (parent == head_.right_) {
+      head_.right_ = hook;
+    }
+  }
+  ++size_;
+  TreeAlgorithms::BalanceAfterInsert(&head_, hook, NoStats());
+  return {iterator(hook), true};
+}
+
+/**
+ * @brief Отсоединяет объект в позиции pos.
+ *
+ * @param pos Итератор на элемент (не end()).
+ * @return Итератор на следующий элемент.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+typename intrusive_set<T, Hook, Compare>::iterator
+intrusive_set<T, Hook, Compare>::erase(const_iterator pos) noexcept {
+  set_hook *node = const_cast<set_hook *>(pos.node_);
+  set_hook *next = TreeAlgorithms::NextNode(node);
+  TreeAlgorithms::Erase(&head_, node, NoStats());
+  ResetLinks(node);
+  --size_;
+  return iterator(next);
+}
+
+/**
+ * @brief Отсоединяет объект, который состоит в этом множестве, без поиска.
+ *
+ * @param value Объект из множества.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+void intrusive_set<T, Hook, Compare>::remove(reference value) noexcept {
+  erase(iterator_to(value));
+}
+
+/**
+ * @brief Обменивает содержимое множеств за O(1).
+ *
+ * @param other Множество для обмена.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+void intrusive_set<T, Hook, Compare>::swap(intrusive_set &other) noexcept {
+  set_hook *root = head_.parent();
+  head_.set_parent(other.head_.parent());
+  other.head_.set_parent(root);
+  std::swap(head_.left_, other.head_.left_);
+  std::swap(head_.right_, other.head_.right_);
+  std::swap(size_, other.size_);
+  std::swap(comparator_, other.comparator_);
+  RelinkHead();
+  other.RelinkHead();
+}
+
+/**
+ * @brief Ищет объект, эквивалентный ключу.
+ *
+ * @param key Ключ поиска.
+ * @return Итератор на найденный объект или end().
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+template <typename Key>
+typename intrusive_set<T, Hook, Compare>::iterator
+intrusive_set<T, Hook, Compare>::find(const Key &key) {
+  set_hook *node = LowerBound(key);
+  if (node != &head_ && comparator_(key, *Traits::Owner(node))) {
+    node = &head_;
+  }
+  return iterator(node);
+}
+
+/**
+ * @brief Ищет объект, эквивалентный ключу (константная версия).
+ *
+ * @param key Ключ поиска.
+ * @return Итератор на найденный объект или end().
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+template <typename Key>
+typename intrusive_set<T, Hook, Compare>::const_iterator
+intrusive_set<T, Hook, Compare>::find(const Key &key) const {
+  return const_cast<intrusive_set *>(this)->find(key);
+}
+
+/**
+ * @brief Проверяет, есть ли объект, эквивалентный ключу.
+ *
+ * @param key Ключ поиска.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+template <typename Key>
+bool intrusive_set<T, Hook, Compare>::contains(const Key &key) const {
+  return find(key) != end();
+}
+
+/**
+ * @brief Количество объектов, эквивалентных ключу (0 или 1).
+ *
+ * @param key Ключ поиска.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+template <typename Key>
+typename intrusive_set<T, Hook, Compare>::size_type
+intrusive_set<T, Hook, Compare>::count(const Key &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Итератор на первый объект, не меньший ключа.
+ *
+ * @param key Ключ поиска.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+template <typename Key>
+typename intrusive_set<T, Hook, Compare>::iterator
+intrusive_set<T, Hook, Compare>::lower_bound(const Key &key) {
+  return iterator(LowerBound(key));
+}
+
+/**
+ * @brief Итератор на первый объект, больший ключа.
+ *
+ * @param key Ключ поиска.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+template <typename Key>
+typename intrusive_set<T, Hook, Compare>::iterator
+intrusive_set<T, Hook, Compare>::upper_bound(const Key &key) {
+  return iterator(UpperBound(key));
+}
+
+/**
+ * @brief Спуск к первому узлу, не меньшему ключа.
+ *
+ * @param key Ключ поиска.
+ * @return Найденный узел или фиктивный узел head_.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+template <typename Key>
+set_hook *intrusive_set<T, Hook, Compare>::LowerBound(const Key &key) const {
+  auto *result = const_cast<set_hook *>(&head_);
+  set_hook *node = head_.parent();
+  while (node != nullptr) {
+    if (comparator_(*Traits::Owner(node), key)) {
+      node = node->right_;
+    } else {
+      result = node;
+      node = node->left_;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Спуск к первому узлу, большему ключа.
+ *
+ * @param key Ключ поиска.
+ * @return Найденный узел или фиктивный узел head_.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+template <typename Key>
+set_hook *intrusive_set<T, Hook, Compare>::UpperBound(const Key &key) const {
+  auto *result = const_cast<set_hook *>(&head_);
+  set_hook *node = head_.parent();
+  while (node != nullptr) {
+    if (comparator_(key, *Traits::Owner(node))) {
+      result = node;
+      node = node->left_;
+    } else {
+      node = node->right_;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Помечает звено несвязанным.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+void intrusive_set<T, Hook, Compare>::ResetLinks(set_hook *node) noexcept {
+  node->left_ = node->right_ = nullptr;
+  node->set_parent(nullptr);
+  node->set_color(RED);
+}
+
+/**
+ * @brief Приводит фиктивный узел к состоянию пустого дерева.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+void intrusive_set<T, Hook, Compare>::InitializeHead() noexcept {
+  head_.set_parent(nullptr);
+  head_.left_ = head_.right_ = &head_;
+  head_.set_color(RED);
+}
+
+/**
+ * @brief Восстанавливает ссылку корня на head_ после обмена фиктивными
+ * узлами.
+ */
+template <typename T, set_hook T::*Hook, typename Compare>
+void intrusive_set<T, Hook, Compare>::RelinkHead() noexcept {
+  if (head_.parent() == nullptr) {
+    InitializeHead();
+  } else {
+    head_.parent()->set_parent(&head_);
+  }
+}
+
+} // namespace s21
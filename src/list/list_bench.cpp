@@ -0,0 +1,68 @@
+// Сравнение пула узлов s21::List<int> с std::list<int>, который выделяет
+// каждый узел отдельно: очередь (push_back + pop_front при постоянной длине),
+// построение List(n), копирование и число обращений к operator new.
+//
+// Сборка: g++ -std=c++17 -O2 list_bench.cpp -o list_bench
+
+#include <chrono>
+#include <cstdio>
+#include <list>
+
+#include "../bench/HeapCounter.h"
+#include "s21_list.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+template <typename List>
+void Run(const char *name, std::size_t length, std::size_t churn,
+         std::size_t count) {
+  List queue;
+  for (std::size_t i = 0; i < length; ++i) {
+    queue.push_back(static_cast<int>(i));
+  }
+  std::size_t calls = s21::bench::new_calls;
+  auto start = Clock::now();
+  for (std::size_t i = 0; i < churn; ++i) {
+    queue.push_back(static_cast<int>(i));
+    queue.pop_front();
+  }
+  double churn_ns = Milliseconds(start) * 1e6 / churn;
+  std::size_t churn_calls = s21::bench::new_calls - calls;
+
+  calls = s21::bench::new_calls;
+  start = Clock::now();
+  auto *filled = new List(count);
+  double build_ns = Milliseconds(start) * 1e6 / count;
+  std::size_t build_calls = s21::bench::new_calls - calls - 1;
+
+  calls = s21::bench::new_calls;
+  start = Clock::now();
+  auto *copy = new List(*filled);
+  double copy_ns = Milliseconds(start) * 1e6 / count;
+  std::size_t copy_calls = s21::bench::new_calls - calls - 1;
+
+  std::printf("  %-10s queue %6.2f ns/op (%zu new)  List(n) %5.2f ns/elem "
+              "(%zu new)  copy %5.2f ns/elem (%zu new)  (front %d)\n",
+              name, churn_ns, churn_calls, build_ns, build_calls, copy_ns,
+              copy_calls, queue.front() + copy->front());
+  delete copy;
+  delete filled;
+}
+} // namespace
+
+int main() {
+  const std::size_t kLength = 1000;
+  const std::size_t kChurn = 10000000;
+  const std::size_t kCount = 1000000;
+  std::printf("queue length %zu, %zu push/pop pairs, n = %zu\n", kLength,
+              kChurn, kCount);
+  Run<s21::List<int>>("s21::List", kLength, kChurn, kCount);
+  Run<std::list<int>>("std::list", kLength, kChurn, kCount);
+  return 0;
+}
@@ -1,6 +1,70 @@
 #include "s21_list.h"
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+// Распределитель, считающий обращения к нему.
+struct AllocatorCalls {
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t live_bytes = 0;
+};
+
+template <typename T> struct CountingAllocator {
+  using value_type = T;
+
+  explicit CountingAllocator(AllocatorCalls *calls) noexcept : calls_(calls) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &other) noexcept
+      : calls_(other.calls_) {}
+
+  T *allocate(std::size_t n) {
+    ++calls_->allocations;
+    calls_->live_bytes += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    ++calls_->deallocations;
+    calls_->live_bytes -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U> &other) const noexcept {
+    return calls_ == other.calls_;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U> &other) const noexcept {
+    return calls_ != other.calls_;
+  }
+
+  AllocatorCalls *calls_;
+};
+
+using CountingList =
+    s21::List<int, s21::DefaultListOptions, CountingAllocator<int>>;
+
+// Элемент, копирование которого бросает исключение, пока включен fail_.
+// Строится из числа, потому что служебный узел конца хранит размер списка.
+struct FragileValue {
+  FragileValue(std::size_t value) : value_(value) {}
+  FragileValue(const FragileValue &other) : value_(other.value_) {
+    if (fail_) {
+      throw std::runtime_error("copy");
+    }
+  }
+
+  FragileValue &operator=(const FragileValue &) = default;
+
+  std::size_t value_;
+  static inline bool fail_ = false;
+};
+} // namespace
+
 TEST(ListTest, PushBack) {
   s21::List<int> list;
   list.push_back(1);
@@ -298,6 +362,127 @@ TEST(ListTest, InsertManyFront) {
   EXPECT_EQ(*iter, 5);
 }
 
+TEST(ListTest, Stats) {
+  s21::List<int, s21::StatsListOptions> list{3, 1, 2};
+  list.sort();
+  s21::ContainerStats stats = list.stats();
+  EXPECT_GE(stats.allocations, 3U);
+  EXPECT_GT(stats.comparisons, 0U);
+
+  list.reset_stats();
+  for (auto it = list.cBegin(); it != list.cEnd(); ++it) {
+  }
+  list.pop_front();
+  stats = list.stats();
+  EXPECT_EQ(stats.deallocations, 1U);
+  EXPECT_EQ(stats.rotations, 0U);
+}
+
+TEST(ListTest, StatsIteratorOutlivesMovedFromList) {
+  auto source = std::make_unique<s21::List<int, s21::StatsListOptions>>(
+      std::initializer_list<int>{1, 2, 3});
+  s21::List<int, s21::StatsListOptions> target(std::move(*source));
+  auto it = target.cBegin();
+  source.reset();
+  ++it;
+  EXPECT_EQ(*it, 2);
+}
+
+TEST(ListTest, NodePoolAllocatesSlabs) {
+  AllocatorCalls calls;
+  CountingAllocator<int> allocator(&calls);
+
+  CountingList empty(allocator);
+  EXPECT_EQ(calls.allocations, 0U);
+
+  // List(n) и копия выделяют все узлы одним блоком.
+  {
+    CountingList list(1000, allocator);
+    EXPECT_EQ(list.size(), 1000U);
+    EXPECT_EQ(calls.allocations, 1U);
+  }
+  EXPECT_EQ(calls.deallocations, 1U);
+  CountingList filled(allocator);
+  filled.push_back(1);
+  EXPECT_EQ(calls.allocations, 2U);
+  for (int i = 2; i <= 100; ++i) {
+    filled.push_back(i);
+  }
+  std::size_t before = calls.allocations;
+  CountingList copy(filled);
+  EXPECT_EQ(calls.allocations, before + 1);
+  int expected = 1;
+  for (auto it = copy.cBegin(); it != copy.cEnd(); ++it) {
+    EXPECT_EQ(*it, expected++);
+  }
+  EXPECT_TRUE(copy.get_allocator() == allocator);
+
+  // Очередь: освобожденные узлы переиспользуются без обращений к
+  // распределителю.
+  before = calls.allocations;
+  for (int i = 0; i < 100000; ++i) {
+    copy.pop_front();
+    copy.push_back(i);
+  }
+  EXPECT_EQ(calls.allocations, before);
+  EXPECT_EQ(copy.size(), 100U);
+  EXPECT_EQ(copy.front(), 99900);
+  EXPECT_EQ(copy.back(), 99999);
+
+  CountingList moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 100U);
+  moved.clear();
+  filled.clear();
+  EXPECT_EQ(calls.live_bytes, 0U);
+  EXPECT_EQ(calls.allocations, calls.deallocations);
+}
+
+TEST(ListTest, MemoryUsageCountsSlabs) {
+  AllocatorCalls calls;
+  CountingAllocator<int> allocator(&calls);
+  CountingList list(allocator);
+  EXPECT_EQ(list.memory_usage(), sizeof(list));
+  for (int i = 0; i < 1000; ++i) {
+    list.push_back(i);
+    ASSERT_EQ(list.memory_usage(), sizeof(list) + calls.live_bytes);
+  }
+  // Свободные ячейки остаются в пуле и продолжают занимать память.
+  const std::size_t filled = list.memory_usage();
+  for (int i = 0; i < 500; ++i) {
+    list.pop_back();
+  }
+  EXPECT_EQ(list.memory_usage(), filled);
+  list.clear();
+  EXPECT_EQ(list.memory_usage(), sizeof(list) + calls.live_bytes);
+}
+
+TEST(ListTest, FailedConstructionKeepsPoolSlot) {
+  AllocatorCalls calls;
+  CountingAllocator<FragileValue> allocator(&calls);
+  s21::List<FragileValue, s21::DefaultListOptions,
+            CountingAllocator<FragileValue>>
+      list(allocator);
+  const FragileValue value(7);
+  list.push_back(value);
+  list.push_back(value);
+  list.pop_back();
+  // Неудачные вставки не занимают ни свободную ячейку, ни ячейку пласта,
+  // поэтому новые пласты не нужны.
+  const std::size_t before = calls.allocations;
+  FragileValue::fail_ = true;
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_THROW(list.push_back(value), std::runtime_error);
+  }
+  FragileValue::fail_ = false;
+  EXPECT_EQ(calls.allocations, before);
+  EXPECT_EQ(list.size(), 1U);
+  for (int i = 0; i < 2; ++i) {
+    list.push_back(value);
+  }
+  EXPECT_EQ(calls.allocations, before);
+  EXPECT_EQ(list.size(), 3U);
+  EXPECT_EQ(list.back().value_, 7U);
+}
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -1,16 +1,44 @@
 #ifndef S21_LIST_H
 #define S21_LIST_H
+#include <algorithm>
+#include <cstddef>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../stats/ContainerStats.h"
 
 namespace s21 {
-template <typename T> class List {
+// Параметры списка по умолчанию. Чтобы изменить отдельный параметр, достаточно
+// унаследоваться от этой структуры и переопределить его.
+struct DefaultListOptions {
+  // Список ведет счетчики выделений/освобождений узлов и сравнений,
+  // доступные через stats().
+  static constexpr bool stats = false;
+};
+
+struct StatsListOptions : DefaultListOptions {
+  static constexpr bool stats = true;
+};
+
+// Узлы списка берутся из собственного пула списка: пласты (slabs) на
+// несколько узлов запрашиваются у Allocator, освобожденные узлы попадают в
+// список свободных ячеек и переиспользуются следующими вставками. Память
+// пластов возвращается распределителю при clear() и в деструкторе.
+template <typename T, typename Options = DefaultListOptions,
+          typename Allocator = std::allocator<T>>
+class List {
 public:
   using const_reference = const T &;
   using size_type = size_t;
   using reference = T &;
   using value_type = T;
+  using allocator_type = Allocator;
+  using stats_type = StatsCounters<Options::stats>;
 
 private:
   struct Node;
@@ -42,7 +70,7 @@ public:
     value_type error_ = 0;
     reference error_value = error_;
   };
-  using const_iterator = List<T>::ConstListIterator;
+  using const_iterator = List<T, Options, Allocator>::ConstListIterator;
 
   class ListIterator : public ConstListIterator {
   public:
@@ -62,19 +90,20 @@ public:
     void operator=(Node *node) noexcept { this->_node = node; }
     void operator=(Node &node) noexcept { this->_node = &node; }
   };
-  using iterator = List<T>::ListIterator;
+  using iterator = List<T, Options, Allocator>::ListIterator;
 
   List() noexcept;
-  List(size_type n);
+  explicit List(const Allocator &allocator) noexcept;
+  List(size_type n, const Allocator &allocator = Allocator());
   List(const std::initializer_list<value_type> &items);
-  List(const List<T> &other);
-  List(List<T> &&other) noexcept;
+  List(const List &other);
+  List(List &&other) noexcept;
   ~List() noexcept;
   iterator cBegin() const noexcept;
   iterator cEnd() const noexcept;
   iterator insert(iterator position, const_reference value);
-  void operator=(const List<T> &other) noexcept;
-  void operator=(List<T> &&other) noexcept;
+  void operator=(const List &other) noexcept;
+  void operator=(List &&other) noexcept;
   void copyList(const List &other) noexcept;
   void moveList(List &other) noexcept;
   void push_back(const_reference value);
@@ -99,23 +128,71 @@ public:
   iterator insert_range(const_iterator pos, InputIt first, InputIt last);
   template <typename... Args> void insert_many_back(Args &&...args);
   template <typename... Args> void insert_many_front(Args &&...args);
+  ContainerStats stats() const noexcept;
+  void reset_stats() noexcept;
+  size_type memory_usage() const noexcept;
+  allocator_type get_allocator() const noexcept;
 
 private:
   template <typename First, typename... Rest>
   void insert_front_helper(First &&first, Rest &&...rest);
   struct Node {
-    Node() noexcept : next_(nullptr), prev_(nullptr), value_(0) {}
-    Node(const_reference t) noexcept
+    Node() noexcept(std::is_nothrow_constructible_v<value_type, int>)
+        : next_(nullptr), prev_(nullptr), value_(0) {}
+    Node(const_reference t) noexcept(
+        std::is_nothrow_copy_constructible_v<value_type>)
         : value_(t), next_(nullptr), prev_(nullptr) {}
     value_type value_;
     Node *next_;
     Node *prev_;
   };
 
+  // Ячейка пласта: место под один узел.
+  struct alignas(Node) NodeSlot {
+    unsigned char bytes_[sizeof(Node)];
+  };
+
+  // Свободная ячейка хранит ссылку на следующую свободную.
+  struct FreeSlot {
+    FreeSlot *next_;
+  };
+
+  // Заголовок пласта занимает его первую ячейку.
+  struct Slab {
+    Slab *next_;
+    size_type slots_;
+  };
+
+  static_assert(sizeof(FreeSlot) <= sizeof(NodeSlot) &&
+                    sizeof(Slab) <= sizeof(NodeSlot),
+                "s21::List: служебные записи пула не помещаются в ячейку");
+
+  using slot_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<NodeSlot>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+
+  // Размеры пластов, которые пул выделяет сам: от kMinSlab узлов, далее
+  // пропорционально размеру списка, но не больше kMaxSlab.
+  static constexpr size_type kMinSlab = 16;
+  static constexpr size_type kMaxSlab = 4096;
+
+  template <typename... Args> Node *CreateNode(Args &&...args);
+  void DestroyNode(Node *node) noexcept;
+  void ReserveNodes(size_type count);
+  void AllocateSlab(size_type count);
+  void ReleaseSlabs() noexcept;
+
   Node *_head;
   Node *_tail;
   Node *_end;
   size_type _size;
+  stats_type _stats;
+
+  slot_allocator _allocator;
+  FreeSlot *_free = nullptr;
+  NodeSlot *_bump = nullptr;
+  NodeSlot *_bump_end = nullptr;
+  Slab *_slabs = nullptr;
 
   value_type error_ = 0;
   reference error_value = error_;
@@ -10,37 +10,54 @@ namespace s21 {
  *
  * @tparam T Тип элементов, хранимых в списке.
  */
-template <typename T>
-List<T>::List() noexcept
+template <typename T, typename Options, typename Allocator>
+List<T, Options, Allocator>::List() noexcept
     : _head(nullptr), _tail(nullptr), _end(nullptr), _size(0) {}
 
+/**
+ * @brief Создает пустой список, узлы которого выделяет заданный распределитель.
+ *
+ * @param allocator Распределитель, из которого пул списка берет пласты узлов.
+ */
+template <typename T, typename Options, typename Allocator>
+List<T, Options, Allocator>::List(const Allocator &allocator) noexcept
+    : _head(nullptr), _tail(nullptr), _end(nullptr), _size(0),
+      _allocator(allocator) {}
+
 /**
  * @brief Создает контейнер типа List с заданным количеством элементов.
  *
  * Этот конструктор создает экземпляр контейнера типа List, заполняя его
  * заданным количеством элементов. Внутренние указатели на начальный и конечный
  * элементы списка инициализируются. Значение размера контейнера также
- * обновляется.
+ * обновляется. Все n узлов и конечный узел выделяются одним пластом.
  *
  * @tparam T Тип элементов, хранимых в контейнере.
  * @param n Количество элементов для создания в списке.
+ * @param allocator Распределитель, из которого пул списка берет пласты узлов.
  */
-template <typename T>
-List<T>::List(size_type n) : _head(nullptr), _tail(nullptr), _size(0) {
+template <typename T, typename Options, typename Allocator>
+List<T, Options, Allocator>::List(size_type n, const Allocator &allocator)
+    : _head(nullptr), _tail(nullptr), _end(nullptr), _size(0),
+      _allocator(allocator) {
   // Если количество элементов равно нулю, завершаем конструктор
   if (n == 0)
     return;
 
+  // Один пласт на все узлы и конечный узел
+  ReserveNodes(n + 1);
+
   // Создаем начальный узел и связываем остальные узлы
-  _head = new Node(value_type());
+  _head = CreateNode(value_type());
   Node *current = _head;
   for (size_type i = 1; i < n; ++i) {
-    current->next_ = new Node(value_type());
+    current->next_ = CreateNode(value_type());
     current->next_->prev_ = current;
     current = current->next_;
   }
   _tail = current;
   _size = n;
+  endAddress();
 };
 
 /**
@@ -54,9 +71,9 @@ List<T>::List(size_type n) : _head(nullptr), _tail(nullptr), _size(0) {
  * @tparam T Тип элементов, хранимых в списке.
  * @param items Список инициализации, содержащий элементы для заполнения списка.
  */
-template <typename T>
-List<T>::List(const std::initializer_list<T> &items)
-    : _head(nullptr), _tail(nullptr), _size(0) {
+template <typename T, typename Options, typename Allocator>
+List<T, Options, Allocator>::List(const std::initializer_list<T> &items)
+    : _head(nullptr), _tail(nullptr), _end(nullptr), _size(0) {
   // Проходим по всем элементам списка инициализации
   for (const T &item : items) {
     // Добавляем элемент в конец списка
@@ -76,9 +93,11 @@ List<T>::List(const std::initializer_list<T> &items)
  * @param other Ссылка на другой экземпляр List, из которого будет создана
  * копия.
  */
-template <typename T>
-List<T>::List(const List &other)
-    : _head(nullptr), _tail(nullptr), _size(0), _end(nullptr) {
+template <typename T, typename Options, typename Allocator>
+List<T, Options, Allocator>::List(const List &other)
+    : _head(nullptr), _tail(nullptr), _end(nullptr), _size(0),
+      _allocator(slot_traits::select_on_container_copy_construction(
+          other._allocator)) {
   // Вызов вспомогательной функции для копирования элементов
   copyList(other);
 };
@@ -95,9 +114,10 @@ List<T>::List(const List &other)
  * @tparam T Тип элементов в контейнере.
  * @param other Другой контейнер типа List, из которого происходит перемещение.
  */
-template <typename T>
-List<T>::List(List &&other) noexcept
-    : _head(nullptr), _tail(nullptr), _end(nullptr), _size(0) {
+template <typename T, typename Options, typename Allocator>
+List<T, Options, Allocator>::List(List &&other) noexcept
+    : _head(nullptr), _tail(nullptr), _end(nullptr), _size(0),
+      _allocator(other._allocator) {
   // Вызов функции перемещения элементов из другого контейнера
   moveList(other);
 };
@@ -110,7 +130,8 @@ List<T>::List(List &&other) noexcept
  *
  * @tparam T Тип данных, хранящихся в списке.
  */
-template <typename T> List<T>::~List() noexcept { clear(); };
+template <typename T, typename Options, typename Allocator>
+List<T, Options, Allocator>::~List() noexcept { clear(); };
 
 /**
  * @brief Оператор перемещения для класса List.
@@ -121,7 +142,8 @@ template <typename T> List<T>::~List() noexcept { clear(); };
  * @tparam T Тип данных, хранящихся в списке.
  * @param other Список, содержимое которого нужно переместить.
  */
-template <typename T> void List<T>::operator=(List &&other) noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::operator=(List &&other) noexcept {
   moveList(other);
 };
 
@@ -136,7 +158,8 @@ template <typename T> void List<T>::operator=(List &&other) noexcept {
  * @tparam T Тип элементов, хранящихся в списке.
  * @param other Список, содержимое которого будет присвоено текущему списку.
  */
-template <typename T> void List<T>::operator=(const List &other) noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::operator=(const List &other) noexcept {
   // Копируем содержимое списка other в текущий список
   copyList(std::move(other));
 }
@@ -153,14 +176,15 @@ template <typename T> void List<T>::operator=(const List &other) noexcept {
  * @param value Значение элемента, которое нужно добавить.
  * @throws std::out_of_range Если размер списка превышает максимальное значение.
  */
-template <typename T> void List<T>::push_back(const_reference value) {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::push_back(const_reference value) {
   // Проверка на достижение максимального размера списка
   if (size() >= max_size())
     throw std::out_of_range(
         "s21_List::push_back: Limit of the container is exceeded");
 
   // Создание нового узла
-  Node *node = new Node(value);
+  Node *node = CreateNode(value);
 
   // Обновление связей узлов
   node->next_ = _end;
@@ -198,14 +222,15 @@ template <typename T> void List<T>::push_back(const_reference value) {
  * @throws std::out_of_range В случае, если предельный размер контейнера
  * превышен.
  */
-template <typename T> void List<T>::push_front(const_reference value) {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::push_front(const_reference value) {
   // Проверка на превышение предельного размера контейнера
   if (size() >= max_size())
     throw std::out_of_range(
         "s21_List::push_front:: Limit of the container is exceeded");
 
   // Создание нового узла с переданным значением
-  Node *node = new Node(value);
+  Node *node = CreateNode(value);
   node->next_ = _head;
 
   // Обновление ссылки предыдущего элемента, если голова списка существует
@@ -237,14 +262,15 @@ template <typename T> void List<T>::push_front(const_reference value) {
  *
  * @tparam T Тип элементов, хранящихся в списке.
  */
-template <class T> void List<T>::pop_back() noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::pop_back() noexcept {
   if (_head == _tail) {
     // Если в списке только один элемент
     _head = nullptr;
   }
   if (_tail) {
     Node *newHead = _tail->prev_;
-    delete _tail;
+    DestroyNode(_tail);
     _tail = newHead;
     _end->prev_ = _tail;
     _tail->next_ = _end;
@@ -264,7 +290,8 @@ template <class T> void List<T>::pop_back() noexcept {
  *
  * @tparam T Тип элементов, хранящихся в списке.
  */
-template <typename T> void List<T>::pop_front() noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::pop_front() noexcept {
   if (!_head) {
     // Если список пустой, ничего не делаем.
     return;
@@ -272,7 +299,7 @@ template <typename T> void List<T>::pop_front() noexcept {
 
   if (_head == _tail) {
     // Если в списке только один элемент
-    delete _head;
+    DestroyNode(_head);
     _head = nullptr;
     _tail = nullptr;
     _size = 0;
@@ -281,7 +308,7 @@ template <typename T> void List<T>::pop_front() noexcept {
 
   // Если в списке больше одного элемента
   Node *newHead = _head->next_;
-  delete _head;
+  DestroyNode(_head);
   _head = newHead;
   _head->prev_ = _end; // Устанавливаем новый head
   _end->next_ = _head; // Обновляем указатель у end
@@ -293,16 +320,20 @@ template <typename T> void List<T>::pop_front() noexcept {
  *
  * Этот метод выполняет копирование элементов из переданного списка `other`
  * в текущий список. Перед копированием существующие элементы в текущем списке
- * удаляются с помощью вызова метода clear(). Затем каждый элемент из списка
- * `other` добавляется в конец текущего списка с использованием метода
- * push_back().
+ * удаляются с помощью вызова метода clear(). Затем под все узлы копии
+ * выделяется один пласт, и каждый элемент из списка `other` добавляется в
+ * конец текущего списка с использованием метода push_back().
  *
  * @tparam T Тип элементов, хранящихся в списке.
  * @param other Ссылка на другой список, из которого будут скопированы элементы.
  */
-template <typename T> void List<T>::copyList(const List &other) noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::copyList(const List &other) noexcept {
   // Удаляем существующие элементы в текущем списке
   clear();
+  if (other._size != 0) {
+    ReserveNodes(other._size + 1);
+  }
 
   // Проходим по всем элементам списка other и копируем их
   for (auto i = other.cBegin(); i != other.cEnd(); i++) {
@@ -318,12 +349,14 @@ template <typename T> void List<T>::copyList(const List &other) noexcept {
  * в текущий список. Перед переносом существующие элементы в текущем списке
  * удаляются с помощью вызова метода clear(). Затем происходит перенос
  * внутренних указателей и размера из списка `other` в текущий список.
- * Указатели в списке `other` обнуляются, и его размер обнуляется.
+ * Вместе с узлами переходят пласты пула и распределитель, которым они
+ * выделены. Указатели в списке `other` обнуляются, и его размер обнуляется.
  *
  * @tparam T Тип элементов, хранящихся в списке.
  * @param other Ссылка на другой список, из которого будут перенесены элементы.
  */
-template <typename T> void List<T>::moveList(List &other) noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::moveList(List &other) noexcept {
   // Удаляем существующие элементы в текущем списке
   clear();
 
@@ -332,12 +365,20 @@ template <typename T> void List<T>::moveList(List &other) noexcept {
   _tail = other._tail;
   _size = other._size;
   _end = other._end;
+  std::swap(_allocator, other._allocator);
+  _free = other._free;
+  _bump = other._bump;
+  _bump_end = other._bump_end;
+  _slabs = other._slabs;
 
   // Обнуляем внутренние данные в списке other
   other._end = nullptr;
   other._head = nullptr;
   other._tail = nullptr;
   other._size = 0;
+  other._free = nullptr;
+  other._bump = other._bump_end = nullptr;
+  other._slabs = nullptr;
 }
 
 /**
@@ -351,11 +392,12 @@ template <typename T> void List<T>::moveList(List &other) noexcept {
  *
  * @tparam T Тип элементов, хранящихся в списке.
  */
-template <typename T> void s21::List<T>::endAddress() noexcept {
+template <typename T, typename Options, typename Allocator>
+void s21::List<T, Options, Allocator>::endAddress() noexcept {
   // Проверяем, не задан ли уже адрес конца списка
   if (_end == nullptr) {
     // Создаем новый узел для конечного адреса
-    _end = new Node(0);
+    _end = CreateNode(0);
     _end->next_ = nullptr;
   }
 
@@ -377,7 +419,8 @@ template <typename T> void s21::List<T>::endAddress() noexcept {
  * @tparam T Тип элементов в списке.
  * @return Размер списка.
  */
-template <typename T> size_t List<T>::size() const noexcept { return _size; }
+template <typename T, typename Options, typename Allocator>
+size_t List<T, Options, Allocator>::size() const noexcept { return _size; }
 
 /**
  * @brief Проверяет, является ли список пустым.
@@ -389,7 +432,8 @@ template <typename T> size_t List<T>::size() const noexcept { return _size; }
  * @tparam T Тип элементов в списке.
  * @return true, если список пуст, иначе false.
  */
-template <typename T> bool List<T>::empty() const noexcept {
+template <typename T, typename Options, typename Allocator>
+bool List<T, Options, Allocator>::empty() const noexcept {
   if (_head) {
     return false;
   } else {
@@ -406,8 +450,9 @@ template <typename T> bool List<T>::empty() const noexcept {
  * @tparam T Тип элементов в списке.
  * @return Максимальный размер списка.
  */
-template <typename T>
-typename List<T>::size_type List<T>::max_size() const noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::size_type
+List<T, Options, Allocator>::max_size() const noexcept {
   return std::numeric_limits<size_type>::max() / sizeof(T);
 }
 
@@ -415,17 +460,22 @@ typename List<T>::size_type List<T>::max_size() const noexcept {
  * @brief Очищает список, удаляя все элементы.
  *
  * Этот метод освобождает память, выделенную для элементов списка, и сбрасывает
- * головные и хвостовые указатели, а также счетчик размера списка.
+ * головные и хвостовые указатели, а также счетчик размера списка. Пласты пула
+ * возвращаются распределителю.
  *
  * @tparam T Тип элементов в списке.
  */
-template <typename T> void List<T>::clear() {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::clear() {
   while (_head != _end && _head) {
     pop_front();
   }
-  delete _end;
+  if (_end) {
+    DestroyNode(_end);
+  }
   _head = _tail = _end = nullptr;
   _size = 0;
+  ReleaseSlabs();
 }
 
 /**
@@ -440,9 +490,9 @@ template <typename T> void List<T>::clear() {
  * @return Ссылка на значение, на которое указывает итератор, или значение по
  * умолчанию для ошибок.
  */
-template <class T>
-typename List<T>::const_reference
-List<T>::ConstListIterator::operator*() noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::const_reference
+List<T, Options, Allocator>::ConstListIterator::operator*() noexcept {
   if (_node) {
     return _node->value_;
   }
@@ -462,9 +512,9 @@ List<T>::ConstListIterator::operator*() noexcept {
  * @return Обновленный итератор, указывающий на следующий элемент в списке
  * или оставшийся на месте при попытке перемещения за конец списка.
  */
-template <typename T>
-typename List<T>::ConstListIterator
-List<T>::ConstListIterator::operator++() noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::ConstListIterator
+List<T, Options, Allocator>::ConstListIterator::operator++() noexcept {
   if (_node) {
     _node = _node->next_;
   }
@@ -481,10 +531,11 @@ List<T>::ConstListIterator::operator++() noexcept {
  * @param int Параметр-заглушка, обозначающий постфиксный инкремент.
  * @return Копия текущего итератора до инкремента.
  */
-template <typename T>
-typename List<T>::ConstListIterator
-List<T>::ConstListIterator::operator++(int) noexcept {
-  List<T>::ConstListIterator tmp(*this); // Создание копии текущего итератора
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::ConstListIterator
+List<T, Options, Allocator>::ConstListIterator::operator++(int) noexcept {
+  // Создание копии текущего итератора
+  List<T, Options, Allocator>::ConstListIterator tmp(*this);
   if (_node) {
     _node = _node->next_; // Перемещение итератора на следующий элемент
   }
@@ -500,9 +551,9 @@ List<T>::ConstListIterator::operator++(int) noexcept {
  *
  * @return Итератор на предыдущий элемент списка (если возможно).
  */
-template <typename T>
-typename List<T>::ConstListIterator
-List<T>::ConstListIterator::operator--() noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::ConstListIterator
+List<T, Options, Allocator>::ConstListIterator::operator--() noexcept {
   if (_node) {
     _node = _node->prev_; // Перемещение итератора на предыдущий элемент
   }
@@ -519,10 +570,10 @@ List<T>::ConstListIterator::operator--() noexcept {
  * @tparam T Тип элементов списка.
  * @return Копия текущего итератора перед декрементом.
  */
-template <typename T>
-typename List<T>::ConstListIterator
-List<T>::ConstListIterator::operator--(int) noexcept {
-  List<T>::ConstListIterator tmp(*this);
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::ConstListIterator
+List<T, Options, Allocator>::ConstListIterator::operator--(int) noexcept {
+  List<T, Options, Allocator>::ConstListIterator tmp(*this);
   if (_node) {
     _node = _node->prev_;
   }
@@ -539,8 +590,9 @@ List<T>::ConstListIterator::operator--(int) noexcept {
  * @tparam T Тип элементов списка.
  * @return Ссылка на значение элемента списка или на "error_value".
  */
-template <typename T>
-typename List<T>::value_type &List<T>::ListIterator::operator*() noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::value_type &
+List<T, Options, Allocator>::ListIterator::operator*() noexcept {
   if (this->_node)
     return this->_node->value_;
   return this->error_value;
@@ -558,8 +610,8 @@ typename List<T>::value_type &List<T>::ListIterator::operator*() noexcept {
  * @param other Другой константный итератор, с которым сравнивается текущий.
  * @return True, если итераторы равны, иначе false.
  */
-template <typename T>
-bool List<T>::ConstListIterator::operator==(
+template <typename T, typename Options, typename Allocator>
+bool List<T, Options, Allocator>::ConstListIterator::operator==(
     const ConstListIterator other) const noexcept {
   if (this == &other) {
     return true;
@@ -577,8 +629,9 @@ bool List<T>::ConstListIterator::operator==(
  *
  * @return Константный итератор, указывающий на начало списка.
  */
-template <typename T>
-typename List<T>::iterator List<T>::cBegin() const noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::iterator
+List<T, Options, Allocator>::cBegin() const noexcept {
   return iterator(_head);
 };
 
@@ -592,8 +645,9 @@ typename List<T>::iterator List<T>::cBegin() const noexcept {
  *
  * @return Константный итератор, указывающий на конец списка.
  */
-template <typename T>
-typename List<T>::iterator List<T>::cEnd() const noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::iterator
+List<T, Options, Allocator>::cEnd() const noexcept {
   return iterator(_end);
 };
 /**
@@ -617,9 +671,9 @@ typename List<T>::iterator List<T>::cEnd() const noexcept {
  * @return Итератор на вставленный элемент.
  * @throws std::out_of_range Если позиция не найдена в списке.
  */
-template <typename T>
-typename List<T>::iterator List<T>::insert(iterator position,
-                                           const_reference value) {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::iterator
+List<T, Options, Allocator>::insert(iterator position, const_reference value) {
   Node *currentNode = _head;
   for (auto i = cBegin(); i != position;
        currentNode = currentNode->next_, ++i) {
@@ -632,7 +686,7 @@ typename List<T>::iterator List<T>::insert(iterator position,
     endAddress();
     position = _end;
   } else if (currentNode && currentNode->prev_ != _end) {
-    Node *newNode = new Node(value);
+    Node *newNode = CreateNode(value);
     Node *leftNode = currentNode->prev_;
     newNode->prev_ = leftNode;
     newNode->next_ = currentNode;
@@ -658,9 +712,10 @@ typename List<T>::iterator List<T>::insert(iterator position,
  * @tparam T Тип элементов, хранящихся в списке.
  * @param other Ссылка на другой список, с которым производится обмен.
  */
-template <typename T> void List<T>::swap(List &other) noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::swap(List &other) noexcept {
   // Создаем временный список и копируем содержимое данного списка в него
-  List<T> tempList(*this);
+  List<T, Options, Allocator> tempList(*this);
 
   // Копируем содержимое другого списка в данную
   this->copyList(other);
@@ -682,7 +737,8 @@ template <typename T> void List<T>::swap(List &other) noexcept {
  * @param other Ссылка на другой список, который будет объединен с данным
  * списком.
  */
-template <typename T> void List<T>::merge(List &other) {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::merge(List &other) {
   // Итераторы для прохода по текущему и другому списку
   iterator current = cBegin();
   iterator otherIter = other.cBegin();
@@ -699,6 +755,7 @@ template <typename T> void List<T>::merge(List &other) {
 
   // Проходим по обоим спискам, объединяя их элементы
   while (current != cEnd() && otherIter != other.cEnd()) {
+    _stats.Compare();
     if (*otherIter <= *current) {
       insert(current, *otherIter);
       ++otherIter;
@@ -726,7 +783,8 @@ template <typename T> void List<T>::merge(List &other) {
  *
  * @tparam T Тип элементов, хранящихся в списке.
  */
-template <typename T> void List<T>::reverse() noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::reverse() noexcept {
   Node *current = _head;
   Node *last = _tail;
   T tmp;
@@ -749,7 +807,8 @@ template <typename T> void List<T>::reverse() noexcept {
  *
  * @tparam T Тип элементов, хранящихся в списке.
  */
-template <typename T> void List<T>::sort() noexcept {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::sort() noexcept {
   if (_head == nullptr || _head->next_ == nullptr) {
     return; // Возврат, если список пуст или содержит только один элемент
   }
@@ -760,6 +819,7 @@ template <typename T> void List<T>::sort() noexcept {
     Node *currentNode = _head;
     while (currentNode->next_ != _end) {
       Node *nextNode = currentNode->next_;
+      _stats.Compare();
       if (currentNode->value_ > nextNode->value_) {
         // Меняем местами значения текущего и следующего элементов
         T temp = currentNode->value_;
@@ -782,7 +842,8 @@ template <typename T> void List<T>::sort() noexcept {
  *                       Если nullptr, то метод завершает выполнение.
  * @tparam T Тип данных, хранящихся в списке.
  */
-template <typename T> void List<T>::remove_node(Node *node_to_remove) {
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::remove_node(Node *node_to_remove) {
   // Если передан nullptr, завершаем выполнение метода
   if (node_to_remove == nullptr) {
     return;
@@ -804,7 +865,7 @@ template <typename T> void List<T>::remove_node(Node *node_to_remove) {
   }
 
   // Удаляем узел и уменьшаем размер списка
-  delete node_to_remove;
+  DestroyNode(node_to_remove);
   _size--;
 }
 /**
@@ -817,8 +878,9 @@ template <typename T> void List<T>::remove_node(Node *node_to_remove) {
  * @return Константная ссылка на первый элемент списка или значение error_value,
  * если список пуст.
  */
-template <typename T>
-typename List<T>::const_reference List<T>::front() noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::const_reference
+List<T, Options, Allocator>::front() noexcept {
   if (_head)
     return _head->value_;
   return error_value;
@@ -834,8 +896,9 @@ typename List<T>::const_reference List<T>::front() noexcept {
  * @return Константная ссылка на последний элемент списка или значение
  * error_value, если список пуст.
  */
-template <typename T>
-typename List<T>::const_reference List<T>::back() noexcept {
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::const_reference
+List<T, Options, Allocator>::back() noexcept {
   if (_tail)
     return _tail->value_;
   return error_value;
@@ -854,10 +917,10 @@ typename List<T>::const_reference List<T>::back() noexcept {
  * @param args Аргументы для вставки.
  * @return Итератор на первый вставленный элемент.
  */
-template <typename T>
+template <typename T, typename Options, typename Allocator>
 template <typename... Args>
-typename List<T>::iterator List<T>::insert_many(const_iterator pos,
-                                                Args &&...args) {
+typename List<T, Options, Allocator>::iterator
+List<T, Options, Allocator>::insert_many(const_iterator pos, Args &&...args) {
   auto values = {std::forward<Args>(args)...};
   return insert_range(pos, values.begin(), values.end());
 }
@@ -876,16 +939,17 @@ typename List<T>::iterator List<T>::insert_many(const_iterator pos,
  * @param last Итератор на конец диапазона элементов.
  * @return Итератор на первый вставленный элемент.
  */
-template <typename T>
+template <typename T, typename Options, typename Allocator>
 template <typename InputIt>
-typename List<T>::iterator List<T>::insert_range(const_iterator pos,
-                                                 InputIt first, InputIt last) {
+typename List<T, Options, Allocator>::iterator
+List<T, Options, Allocator>::insert_range(const_iterator pos, InputIt first,
+                                          InputIt last) {
   Node *nodeBeforeInsertPosition = pos._node->prev_;
   size_t inserted_elements_count = std::distance(first, last);
   _size += inserted_elements_count;
 
   for (; first != last; ++first) {
-    Node *newNode = new Node(std::forward<decltype(*first)>(*first));
+    Node *newNode = CreateNode(*first);
 
     if (nodeBeforeInsertPosition) {
       newNode->next_ = nodeBeforeInsertPosition->next_;
@@ -922,9 +986,10 @@ typename List<T>::iterator List<T>::insert_range(const_iterator pos,
  * @param first Первый элемент для вставки.
  * @param rest Остальные элементы для вставки.
  */
-template <typename T>
+template <typename T, typename Options, typename Allocator>
 template <typename First, typename... Rest>
-void List<T>::insert_front_helper(First &&first, Rest &&...rest) {
+void List<T, Options, Allocator>::insert_front_helper(First &&first,
+                                                      Rest &&...rest) {
   if constexpr (sizeof...(rest) > 0) {
     insert_front_helper(std::forward<Rest>(rest)...);
   }
@@ -942,10 +1007,163 @@ void List<T>::insert_front_helper(First &&first, Rest &&...rest) {
  * @tparam Args Типы элементов для вставки.
  * @param args Элементы для вставки.
  */
-template <typename T>
+template <typename T, typename Options, typename Allocator>
 template <typename... Args>
-void List<T>::insert_many_front(Args &&...args) {
+void List<T, Options, Allocator>::insert_many_front(Args &&...args) {
   insert_front_helper(std::forward<Args>(args)...);
 }
 
+/**
+ * @brief Создает узел в ячейке пула.
+ *
+ * Ячейка берется из списка свободных, а если он пуст - из текущего пласта.
+ * Когда пласт исчерпан, выделяется новый: от kMinSlab узлов и до kMaxSlab,
+ * пропорционально текущему размеру списка. Если конструктор узла бросает
+ * исключение, ячейка остается свободной.
+ *
+ * @param args Аргументы конструктора узла.
+ * @return Указатель на созданный узел.
+ */
+template <typename T, typename Options, typename Allocator>
+template <typename... Args>
+typename List<T, Options, Allocator>::Node *
+List<T, Options, Allocator>::CreateNode(Args &&...args) {
+  Node *node;
+  if (_free) {
+    // Узел затирает ссылку на следующую свободную ячейку, даже если его
+    // конструктор не завершился, поэтому при сбое ссылка пишется заново.
+    FreeSlot *slot = _free;
+    FreeSlot *next = slot->next_;
+    slot->~FreeSlot();
+    try {
+      node =
+          ::new (static_cast<void *>(slot)) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      _free = ::new (static_cast<void *>(slot)) FreeSlot{next};
+      throw;
+    }
+    _free = next;
+  } else {
+    if (_bump == _bump_end) {
+      AllocateSlab(std::min(std::max(_size, kMinSlab), kMaxSlab));
+    }
+    node = ::new (static_cast<void *>(_bump)) Node(std::forward<Args>(args)...);
+    ++_bump;
+  }
+  _stats.Allocate();
+  return node;
+}
+
+/**
+ * @brief Разрушает узел и возвращает его ячейку в список свободных.
+ *
+ * @param node Узел, уже исключенный из списка.
+ */
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::DestroyNode(Node *node) noexcept {
+  node->~Node();
+  _free = ::new (static_cast<void *>(node)) FreeSlot{_free};
+  _stats.Deallocate();
+}
+
+/**
+ * @brief Готовит в текущем пласте не меньше count подряд идущих ячеек.
+ *
+ * Используется перед созданием заранее известного числа узлов (List(n),
+ * копирование), чтобы все они попали в один блок памяти.
+ *
+ * @param count Требуемое число ячеек.
+ */
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::ReserveNodes(size_type count) {
+  if (static_cast<size_type>(_bump_end - _bump) < count) {
+    AllocateSlab(count);
+  }
+}
+
+/**
+ * @brief Выделяет у распределителя пласт на count узлов.
+ *
+ * Неиспользованный остаток прежнего пласта переходит в список свободных
+ * ячеек. Первая ячейка нового пласта занята его заголовком.
+ *
+ * @param count Число ячеек под узлы.
+ */
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::AllocateSlab(size_type count) {
+  NodeSlot *slots = slot_traits::allocate(_allocator, count + 1);
+  while (_bump != _bump_end) {
+    _free = ::new (static_cast<void *>(_bump++)) FreeSlot{_free};
+  }
+  _slabs = ::new (static_cast<void *>(slots)) Slab{_slabs, count + 1};
+  _bump = slots + 1;
+  _bump_end = slots + count + 1;
+}
+
+/**
+ * @brief Возвращает распределителю все пласты пула.
+ *
+ * Вызывается, когда в пласте не осталось живых узлов (из clear()).
+ */
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::ReleaseSlabs() noexcept {
+  while (_slabs) {
+    Slab *next = _slabs->next_;
+    slot_traits::deallocate(_allocator, reinterpret_cast<NodeSlot *>(_slabs),
+                            _slabs->slots_);
+    _slabs = next;
+  }
+  _free = nullptr;
+  _bump = _bump_end = nullptr;
+}
+
+/**
+ * @brief Возвращает копию распределителя, которым список выделяет узлы.
+ */
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::allocator_type
+List<T, Options, Allocator>::get_allocator() const noexcept {
+  return allocator_type(_allocator);
+}
+
+/**
+ * @brief Возвращает снимок счетчиков горячего пути списка.
+ *
+ * Счетчики ведутся только при Options::stats (например,
+ * s21::List<T, StatsListOptions>); иначе все значения нулевые. Для списка
+ * заполняются выделения и освобождения узлов (включая служебный узел конца)
+ * и сравнения в sort() и merge(); счетчики дерева остаются нулевыми.
+ *
+ * @return Значения счетчиков на момент вызова.
+ */
+template <typename T, typename Options, typename Allocator>
+ContainerStats List<T, Options, Allocator>::stats() const noexcept {
+  return _stats.Snapshot();
+}
+
+/**
+ * @brief Обнуляет счетчики горячего пути списка.
+ */
+template <typename T, typename Options, typename Allocator>
+void List<T, Options, Allocator>::reset_stats() noexcept {
+  _stats.Reset();
+}
+
+/**
+ * @brief Подсчитывает память, занятую списком: сам объект и все пласты
+ * пула, включая свободные ячейки, которые список держит для следующих
+ * вставок. Служебные данные распределителя не учитываются.
+ *
+ * @return Число байт.
+ */
+template <typename T, typename Options, typename Allocator>
+typename List<T, Options, Allocator>::size_type
+List<T, Options, Allocator>::memory_usage() const noexcept {
+  size_type bytes = sizeof(List);
+  for (const Slab *slab = _slabs; slab; slab = slab->next_) {
+    bytes += slab->slots_ * sizeof(NodeSlot);
+  }
+  return bytes;
+}
+
 } // namespace s21
\ No newline at end of file
@@ -0,0 +1,151 @@
+// Кэш перед s21::map под зипфовой нагрузкой: s21::lru_cache с политиками
+// LRU, LFU и ARC против обычного LRU на std::list + std::unordered_map.
+// Первый проход по последовательности ключей заполняет кэш (промахи читают
+// карту), второй замеряется: get и при промахе put. Для каждой емкости
+// печатаются время обращения к кэшу, доля попаданий и число выделений
+// памяти в куче за время замера.
+//
+// Сборка: g++ -std=c++17 -O2 lru_cache_bench.cpp -o lru_cache_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../bench/HeapCounter.h"
+#include "../map/s21_map.h"
+#include "s21_lru_cache.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// LRU, какой обычно пишут вручную: узел списка выделяется на каждый промах.
+class StdLru {
+public:
+  explicit StdLru(std::size_t capacity) : capacity_(capacity) {}
+
+  long *get(long key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    order_.splice(order_.begin(), order_, it->second);
+    return &it->second->second;
+  }
+
+  void put(long key, long value) {
+    if (order_.size() == capacity_) {
+      index_.erase(order_.back().first);
+      order_.pop_back();
+    }
+    order_.emplace_front(key, value);
+    index_[key] = order_.begin();
+  }
+
+  std::size_t hits() const { return hits_; }
+
+private:
+  std::size_t capacity_;
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+  std::list<std::pair<long, long>> order_;
+  std::unordered_map<long, std::list<std::pair<long, long>>::iterator> index_;
+};
+
+// Выборка из universe различных ключей: вероятность ключа обратно
+// пропорциональна его рангу в степени skew.
+std::vector<long> MakeZipf(std::size_t universe, double skew,
+                           std::size_t count, std::mt19937 &gen) {
+  std::vector<double> cdf(universe);
+  double sum = 0.0;
+  for (std::size_t rank = 0; rank < universe; ++rank) {
+    sum += 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+    cdf[rank] = sum;
+  }
+  // Ранги перемешаны, чтобы частые ключи не шли подряд
+  std::vector<long> keys(universe);
+  for (std::size_t i = 0; i < universe; ++i) {
+    keys[i] = static_cast<long>(i) * 2654435761L % 1000000007L;
+  }
+  std::uniform_real_distribution<double> uniform(0.0, sum);
+  std::vector<long> samples;
+  samples.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t rank =
+        std::lower_bound(cdf.begin(), cdf.end(), uniform(gen)) - cdf.begin();
+    samples.push_back(keys[rank < universe ? rank : universe - 1]);
+  }
+  return samples;
+}
+
+template <typename Cache>
+void Run(const char *name, std::size_t capacity,
+         const s21::map<long, long> &store, const std::vector<long> &keys) {
+  Cache cache(capacity);
+  // Прогрев: кэш заполняется и достигает устойчивого состояния
+  for (long key : keys) {
+    if (cache.get(key) == nullptr) {
+      cache.put(key, store.at(key));
+    }
+  }
+  // В замере значение при промахе вычисляется без карты, чтобы время
+  // поиска в ней не смешивалось со временем кэша
+  const std::size_t hits_before = cache.hits();
+  const std::size_t allocations_before = s21::bench::new_calls;
+  long checksum = 0;
+  const auto start = Clock::now();
+  for (long key : keys) {
+    const long *value = cache.get(key);
+    if (value == nullptr) {
+      cache.put(key, key * 3);
+      checksum += key * 3;
+    } else {
+      checksum += *value;
+    }
+  }
+  const double ns = std::chrono::duration<double, std::nano>(Clock::now() -
+                                                             start)
+                        .count();
+  const std::size_t ops = keys.size();
+  std::printf("  %-10s %7.1f ns/op  hit %5.1f%%  allocations %8zu"
+              "  (checksum %ld)\n",
+              name, ns / ops,
+              100.0 * static_cast<double>(cache.hits() - hits_before) / ops,
+              s21::bench::new_calls - allocations_before, checksum);
+}
+
+// Адаптер счетчика попаданий к общему виду с StdLru.
+template <typename Options>
+class S21Cache : public s21::lru_cache<long, long, Options> {
+public:
+  using s21::lru_cache<long, long, Options>::lru_cache;
+
+  std::size_t hits() const { return this->stats().hits; }
+};
+} // namespace
+
+int main() {
+  std::mt19937 gen(2024);
+  for (std::size_t capacity : {1000UL, 64000UL, 1000000UL}) {
+    const std::size_t universe = capacity * 10;
+    const std::vector<long> keys = MakeZipf(universe, 0.99, 4000000, gen);
+    s21::map<long, long> store;
+    for (long key : keys) {
+      store.insert(key, key * 3);
+    }
+    std::printf("capacity %zu, universe %zu, zipf 0.99\n", capacity,
+                universe);
+    Run<StdLru>("std LRU", capacity, store, keys);
+    Run<S21Cache<s21::DefaultCacheOptions>>("s21 LRU", capacity, store, keys);
+    Run<S21Cache<s21::LfuCacheOptions>>("s21 LFU", capacity, store, keys);
+    Run<S21Cache<s21::ArcCacheOptions>>("s21 ARC", capacity, store, keys);
+  }
+  return 0;
+}
@@ -0,0 +1,214 @@
+#include "s21_lru_cache.h"
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace s21 {
+namespace {
+// Образцовый LRU: голова списка - самая свежая запись.
+class ReferenceLru {
+public:
+  explicit ReferenceLru(std::size_t capacity) : capacity_(capacity) {}
+
+  const int *Get(int key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    order_.splice(order_.begin(), order_, it->second);
+    return &it->second->second;
+  }
+
+  void Put(int key, int value) {
+    if (Get(key) != nullptr) {
+      order_.front().second = value;
+      return;
+    }
+    if (order_.size() == capacity_) {
+      index_.erase(order_.back().first);
+      order_.pop_back();
+    }
+    order_.emplace_front(key, value);
+    index_[key] = order_.begin();
+  }
+
+  bool Erase(int key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return false;
+    }
+    order_.erase(it->second);
+    index_.erase(it);
+    return true;
+  }
+
+  std::size_t Size() const { return order_.size(); }
+
+private:
+  std::size_t capacity_;
+  std::list<std::pair<int, int>> order_;
+  std::unordered_map<int, std::list<std::pair<int, int>>::iterator> index_;
+};
+
+// Хеш, сводящий все ключи в несколько цепочек индекса.
+struct CollidingHash {
+  std::size_t operator()(int key) const noexcept { return key % 3; }
+};
+
+struct StringBytes {
+  std::size_t operator()(int, const std::string &value) const noexcept {
+    return value.size();
+  }
+};
+
+struct ByteCacheOptions : DefaultCacheOptions {
+  using weigher = StringBytes;
+};
+
+template <typename Cache> void CheckAgainstLru(Cache &cache, unsigned seed) {
+  ReferenceLru ref(cache.capacity());
+  std::mt19937 gen(seed);
+  for (int step = 0; step < 20000; ++step) {
+    const int key = static_cast<int>(gen() % 200);
+    switch (gen() % 4) {
+    case 0:
+      cache.put(key, step);
+      ref.Put(key, step);
+      break;
+    case 1:
+      ASSERT_EQ(cache.erase(key), ref.Erase(key));
+      break;
+    default: {
+      const int *expected = ref.Get(key);
+      const int *actual = cache.get(key);
+      ASSERT_EQ(actual == nullptr, expected == nullptr);
+      if (expected != nullptr) {
+        ASSERT_EQ(*actual, *expected);
+      }
+    }
+    }
+    ASSERT_EQ(cache.size(), ref.Size());
+  }
+}
+} // namespace
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed) {
+  s21::lru_cache<int, std::string> cache(2);
+  EXPECT_TRUE(cache.empty());
+  cache.put(1, "one");
+  cache.put(2, "two");
+  ASSERT_NE(cache.get(1), nullptr);
+  cache.put(3, "three");
+  EXPECT_TRUE(cache.contains(1));
+  EXPECT_FALSE(cache.contains(2));
+  EXPECT_EQ(*cache.peek(3), "three");
+  cache.put(1, "uno");
+  EXPECT_EQ(*cache.get(1), "uno");
+  EXPECT_EQ(cache.size(), 2U);
+  EXPECT_EQ(cache.get(2), nullptr);
+
+  const CacheStats stats = cache.stats();
+  EXPECT_EQ(stats.hits, 2U);
+  EXPECT_EQ(stats.misses, 1U);
+  EXPECT_EQ(stats.insertions, 3U);
+  EXPECT_EQ(stats.evictions, 1U);
+  cache.reset_stats();
+  EXPECT_EQ(cache.stats().hits, 0U);
+
+  cache.clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_FALSE(cache.contains(1));
+  cache.put(4, "four");
+  EXPECT_EQ(*cache.get(4), "four");
+}
+
+TEST(LruCacheTest, MatchesReferenceLru) {
+  s21::lru_cache<int, int> cache(50);
+  CheckAgainstLru(cache, 1);
+  // Длинные цепочки индекса проверяют удаление со сдвигом
+  s21::lru_cache<int, int, DefaultCacheOptions, CollidingHash> colliding(50);
+  CheckAgainstLru(colliding, 2);
+}
+
+TEST(LruCacheTest, LfuEvictsLeastFrequent) {
+  s21::lru_cache<int, int, LfuCacheOptions> cache(3);
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(3, 30);
+  for (int i = 0; i < 3; ++i) {
+    cache.get(1);
+    cache.get(3);
+  }
+  cache.get(2);
+  cache.put(4, 40); // вытесняет 2: одно обращение
+  EXPECT_FALSE(cache.contains(2));
+  cache.put(5, 50); // вытесняет 4: обращений нет
+  EXPECT_FALSE(cache.contains(4));
+  EXPECT_TRUE(cache.contains(1));
+  EXPECT_TRUE(cache.contains(3));
+  // Среди равных по частоте вытесняется давний
+  cache.get(5);
+  cache.get(5);
+  cache.get(5);
+  cache.put(6, 60);
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_EQ(cache.stats().evictions, 3U);
+}
+
+TEST(LruCacheTest, ArcKeepsFrequentKeysThroughScan) {
+  const std::size_t capacity = 100;
+  s21::lru_cache<int, int, ArcCacheOptions> arc(capacity);
+  s21::lru_cache<int, int> lru(capacity);
+  std::mt19937 gen(3);
+  int scan = 1000;
+  for (int step = 0; step < 50000; ++step) {
+    // Горячие 60 ключей вперемешку с однократным сканированием
+    const int key = step % 2 == 0 ? static_cast<int>(gen() % 60) : scan++;
+    if (int *value = arc.get(key)) {
+      ASSERT_EQ(*value, key);
+    } else {
+      arc.put(key, key);
+    }
+    if (lru.get(key) == nullptr) {
+      lru.put(key, key);
+    }
+    ASSERT_LE(arc.size(), capacity);
+  }
+  EXPECT_EQ(arc.size(), capacity);
+  EXPECT_GT(arc.stats().hits, lru.stats().hits + lru.stats().hits / 2);
+  EXPECT_TRUE(arc.erase(arc.contains(1) ? 1 : scan - 1));
+  EXPECT_EQ(arc.size(), capacity - 1);
+}
+
+TEST(LruCacheTest, CapacityInBytes) {
+  s21::lru_cache<int, std::string, ByteCacheOptions> cache(10);
+  cache.put(1, "aaaa");
+  cache.put(2, "bbbb");
+  EXPECT_EQ(cache.weight(), 8U);
+  cache.put(3, "cc");
+  EXPECT_EQ(cache.size(), 3U);
+  cache.put(4, "ddd"); // вытесняет 1
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_EQ(cache.weight(), 9U);
+  cache.put(3, "cccccc"); // рост записи вытесняет 2, но не ее саму
+  EXPECT_EQ(*cache.peek(3), "cccccc");
+  EXPECT_FALSE(cache.contains(2));
+  EXPECT_EQ(cache.size(), 2U);
+  cache.put(5, std::string(11, 'e')); // тяжелее емкости: не кэшируется
+  EXPECT_FALSE(cache.contains(5));
+  cache.put(3, std::string(11, 'c'));
+  EXPECT_FALSE(cache.contains(3));
+  EXPECT_EQ(cache.size(), 1U);
+  EXPECT_EQ(cache.weight(), 3U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
@@ -0,0 +1,190 @@
+#ifndef S21_CONTAINERS_LRU_CACHE_S21_LRU_CACHE_H_
+#define S21_CONTAINERS_LRU_CACHE_S21_LRU_CACHE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "../intrusive/s21_intrusive_list.h"
+
+namespace s21 {
+
+// Политика вытеснения записей кэша.
+enum class CachePolicy {
+  kLru, // вытесняется запись, к которой дольше всего не обращались
+  kLfu, // вытесняется запись с наименьшим числом обращений
+  kArc  // адаптивная замена: баланс между недавними и частыми записями
+};
+
+// Вес записи по умолчанию: емкость кэша задается числом записей.
+struct EntryWeigher {
+  template <typename Key, typename Value>
+  std::size_t operator()(const Key &, const Value &) const noexcept {
+    return 1;
+  }
+};
+
+// Параметры кэша по умолчанию. Чтобы изменить отдельный параметр, достаточно
+// унаследоваться от этой структуры и переопределить его. weigher задает вес
+// записи (например, ее размер в байтах), емкость считается в тех же
+// единицах.
+struct DefaultCacheOptions {
+  static constexpr CachePolicy policy = CachePolicy::kLru;
+  using weigher = EntryWeigher;
+};
+
+struct LfuCacheOptions : DefaultCacheOptions {
+  static constexpr CachePolicy policy = CachePolicy::kLfu;
+};
+
+// ARC сравнивает длины списков в записях, поэтому работает только с
+// емкостью в записях (EntryWeigher).
+struct ArcCacheOptions : DefaultCacheOptions {
+  static constexpr CachePolicy policy = CachePolicy::kArc;
+};
+
+// Счетчики обращений к кэшу.
+struct CacheStats {
+  std::size_t hits = 0;       // get, нашедшие запись
+  std::size_t misses = 0;     // get, не нашедшие запись
+  std::size_t insertions = 0; // put новых ключей
+  std::size_t evictions = 0;  // записи, вытесненные по емкости
+};
+
+// Кэш фиксированной емкости с вытеснением по политике Options::policy.
+// Записи выделяются один раз и связаны звеньями s21::intrusive_list:
+// обращение к записи только перевешивает ее звено (next_/prev_) в голову
+// нужного списка, а вытесненная запись уходит в список свободных и
+// переиспользуется следующим put. Ключ ищется в индексе с открытой
+// адресацией (линейное пробирование, удаление сдвигом назад), поэтому get и
+// put выполняются за O(1) в среднем и не выделяют память, пока число записей
+// не превышает достигнутого ранее.
+//
+// Как и остальные контейнеры, кэш не синхронизирован. Указатель из get
+// действителен до следующего изменения кэша.
+template <typename Key, typename Value, typename Options = DefaultCacheOptions,
+          typename Hash = std::hash<Key>>
+class lru_cache {
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using size_type = std::size_t;
+  using hasher = Hash;
+
+  static_assert(Options::policy != CachePolicy::kArc ||
+                    std::is_same<typename Options::weigher,
+                                 EntryWeigher>::value,
+                "s21::lru_cache: ARC поддерживает только емкость в записях");
+
+  // Конструкторы и деструктор
+  explicit lru_cache(size_type capacity, const Hash &hash = Hash());
+  lru_cache(const lru_cache &) = delete;
+  lru_cache &operator=(const lru_cache &) = delete;
+  ~lru_cache() = default;
+
+  // Доступ к записям
+  mapped_type *get(const key_type &key);
+  const mapped_type *peek(const key_type &key) const;
+  bool contains(const key_type &key) const;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+  [[nodiscard]] size_type capacity() const noexcept;
+  [[nodiscard]] size_type weight() const noexcept;
+
+  // Модификаторы
+  void put(const key_type &key, const mapped_type &value);
+  bool erase(const key_type &key);
+  void clear() noexcept;
+
+  // Счетчики обращений
+  CacheStats stats() const noexcept;
+  void reset_stats() noexcept;
+
+private:
+  struct Entry {
+    Entry(std::size_t hash, const key_type &key, const mapped_type &value)
+        : key_(key), value_(value), hash_(hash) {}
+
+    list_hook hook_;
+    key_type key_;
+    mapped_type value_;
+    std::size_t hash_;
+    std::size_t weight_ = 0;
+    // Номер списка, в котором состоит запись (см. kT1...kB2 и уровни LFU)
+    unsigned list_ = 0;
+  };
+
+  using entry_list = intrusive_list<Entry, &Entry::hook_>;
+
+  // Ячейка индекса; пустая ячейка - entry_ == nullptr.
+  struct IndexSlot {
+    std::size_t hash_;
+    Entry *entry_;
+  };
+
+  // Списки ARC: T1 и T2 - записи в кэше, увиденные один и несколько раз;
+  // B1 и B2 - "призраки", ключи недавно вытесненных из T1 и T2 записей без
+  // учета в размере кэша. LRU пользуется только списком kT1.
+  static constexpr unsigned kT1 = 0;
+  static constexpr unsigned kT2 = 1;
+  static constexpr unsigned kB1 = 2;
+  static constexpr unsigned kB2 = 3;
+
+  // LFU держит по списку на каждое число обращений; начиная с
+  // kLfuLevels - 1 обращения записи не различаются и вытесняются по LRU.
+  static constexpr unsigned kLfuLevels = 64;
+  static constexpr unsigned kListCount =
+      Options::policy == CachePolicy::kLfu ? kLfuLevels : 4;
+
+  Entry *Find(const key_type &key, std::size_t hash) const;
+  void IndexInsert(Entry *entry);
+  void IndexErase(const Entry *entry) noexcept;
+  void Rehash(size_type slots);
+  size_type Home(std::size_t hash) const noexcept;
+
+  Entry *Acquire(std::size_t hash, const key_type &key,
+                 const mapped_type &value);
+  void Release(Entry *entry) noexcept;
+  void Link(Entry *entry, unsigned list) noexcept;
+  void Unlink(Entry *entry) noexcept;
+  void Touch(Entry *entry) noexcept;
+  bool IsResident(const Entry *entry) const noexcept;
+
+  void EvictFor(size_type incoming);
+  Entry *Victim() noexcept;
+  void ArcPut(Entry *entry, std::size_t hash, const key_type &key,
+              const mapped_type &value);
+  void ArcReplace(bool ghost_in_b2) noexcept;
+
+  size_type capacity_;
+  size_type weight_ = 0;
+  size_type resident_ = 0;
+  // Целевой размер T1 в ARC
+  size_type target_t1_ = 0;
+  // Непустые уровни LFU, бит i - список lists_[i]
+  std::uint64_t lfu_levels_ = 0;
+  Hash hash_;
+  typename Options::weigher weigher_;
+  CacheStats stats_;
+
+  std::vector<IndexSlot> index_;
+  unsigned index_shift_ = 0;
+  // Записи в индексе, включая призраков
+  size_type used_ = 0;
+  // Записи хранятся в deque: добавление новых не перемещает прежние. Списки
+  // объявлены после хранилища и разрушаются раньше него.
+  std::deque<Entry> entries_;
+  entry_list free_;
+  entry_list lists_[kListCount];
+};
+
+} // namespace s21
+
+#include "s21_lru_cache.tpp"
+#endif // S21_CONTAINERS_LRU_CACHE_S21_LRU_CACHE_H_
@@ -0,0 +1,577 @@
+#include "s21_lru_cache.h"
+
+namespace s21 {
+
+/**
+ * @brief Создает пустой кэш.
+ *
+ * При емкости в записях индекс сразу рассчитан на все записи, которые кэш
+ * может хранить, и не перестраивается во время работы.
+ *
+ * @param capacity Емкость: число записей или суммарный вес по
+ * Options::weigher.
+ * @param hash Хеш-функция ключей.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+lru_cache<Key, Value, Options, Hash>::lru_cache(size_type capacity,
+                                                const Hash &hash)
+    : capacity_(capacity), hash_(hash) {
+  size_type slots = 16;
+  if (std::is_same<typename Options::weigher, EntryWeigher>::value) {
+    // ARC дополнительно помнит до capacity ключей-призраков
+    const size_type entries =
+        Options::policy == CachePolicy::kArc ? 2 * capacity : capacity;
+    while (slots < 2 * entries && slots < (size_type{1} << 20)) {
+      slots *= 2;
+    }
+  }
+  Rehash(slots);
+}
+
+/**
+ * @brief Ищет запись и отмечает обращение к ней.
+ *
+ * Найденная запись становится самой свежей по политике кэша; промах и
+ * попадание учитываются в stats().
+ *
+ * @param key Ключ.
+ * @return Указатель на значение или nullptr, если записи в кэше нет.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+typename lru_cache<Key, Value, Options, Hash>::mapped_type *
+lru_cache<Key, Value, Options, Hash>::get(const key_type &key) {
+  Entry *entry = Find(key, hash_(key));
+  if (entry == nullptr || !IsResident(entry)) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  ++stats_.hits;
+  Touch(entry);
+  return &entry->value_;
+}
+
+/**
+ * @brief Ищет запись, не отмечая обращения и не меняя счетчиков.
+ *
+ * @param key Ключ.
+ * @return Указатель на значение или nullptr, если записи в кэше нет.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+const typename lru_cache<Key, Value, Options, Hash>::mapped_type *
+lru_cache<Key, Value, Options, Hash>::peek(const key_type &key) const {
+  const Entry *entry = Find(key, hash_(key));
+  return entry != nullptr && IsResident(entry) ? &entry->value_ : nullptr;
+}
+
+/**
+ * @brief Проверяет, есть ли запись в кэше, не отмечая обращения.
+ *
+ * @param key Ключ.
+ * @return true, если запись есть.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+bool lru_cache<Key, Value, Options, Hash>::contains(const key_type &key) const {
+  return peek(key) != nullptr;
+}
+
+/**
+ * @brief Проверяет, пуст ли кэш.
+ *
+ * @return true, если записей нет.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+bool lru_cache<Key, Value, Options, Hash>::empty() const noexcept {
+  return resident_ == 0;
+}
+
+/**
+ * @brief Возвращает число записей в кэше (без призраков ARC).
+ *
+ * @return Число записей.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+typename lru_cache<Key, Value, Options, Hash>::size_type
+lru_cache<Key, Value, Options, Hash>::size() const noexcept {
+  return resident_;
+}
+
+/**
+ * @brief Возвращает емкость кэша.
+ *
+ * @return Емкость в единицах Options::weigher.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+typename lru_cache<Key, Value, Options, Hash>::size_type
+lru_cache<Key, Value, Options, Hash>::capacity() const noexcept {
+  return capacity_;
+}
+
+/**
+ * @brief Возвращает суммарный вес записей в кэше.
+ *
+ * @return Вес, не превышающий capacity().
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+typename lru_cache<Key, Value, Options, Hash>::size_type
+lru_cache<Key, Value, Options, Hash>::weight() const noexcept {
+  return weight_;
+}
+
+/**
+ * @brief Добавляет запись или заменяет значение существующей.
+ *
+ * Если записи не хватает места, вытесняются записи по политике кэша.
+ * Запись тяжелее всей емкости не кэшируется (прежнее значение ключа
+ * удаляется). Замена значения считается обращением к записи.
+ *
+ * @param key Ключ.
+ * @param value Значение.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::put(const key_type &key,
+                                               const mapped_type &value) {
+  const std::size_t hash = hash_(key);
+  Entry *entry = Find(key, hash);
+  if constexpr (Options::policy == CachePolicy::kArc) {
+    ArcPut(entry, hash, key, value);
+  } else {
+    const size_type weight = weigher_(key, value);
+    if (entry != nullptr) {
+      if (weight > capacity_) {
+        erase(key);
+        return;
+      }
+      entry->value_ = value;
+      // Запись снимается со списка на время вытеснения, чтобы не вытеснить
+      // ее саму
+      const unsigned list =
+          Options::policy == CachePolicy::kLfu && entry->list_ + 1 < kListCount
+              ? entry->list_ + 1
+              : entry->list_;
+      Unlink(entry);
+      weight_ -= entry->weight_;
+      --resident_;
+      EvictFor(weight);
+      entry->weight_ = weight;
+      weight_ += weight;
+      ++resident_;
+      Link(entry, list);
+      return;
+    }
+    if (weight > capacity_) {
+      return;
+    }
+    EvictFor(weight);
+    entry = Acquire(hash, key, value);
+    entry->weight_ = weight;
+    Link(entry, kT1);
+    weight_ += weight;
+    ++resident_;
+    ++stats_.insertions;
+  }
+}
+
+/**
+ * @brief Удаляет запись по ключу.
+ *
+ * @param key Ключ.
+ * @return true, если запись была в кэше.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+bool lru_cache<Key, Value, Options, Hash>::erase(const key_type &key) {
+  Entry *entry = Find(key, hash_(key));
+  if (entry == nullptr) {
+    return false;
+  }
+  const bool resident = IsResident(entry);
+  if (resident) {
+    weight_ -= entry->weight_;
+    --resident_;
+  }
+  Release(entry);
+  return resident;
+}
+
+/**
+ * @brief Удаляет все записи и освобождает их память. Счетчики не
+ * сбрасываются.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::clear() noexcept {
+  for (entry_list &list : lists_) {
+    list.clear();
+  }
+  free_.clear();
+  entries_.clear();
+  for (IndexSlot &slot : index_) {
+    slot.entry_ = nullptr;
+  }
+  used_ = 0;
+  weight_ = resident_ = target_t1_ = 0;
+  lfu_levels_ = 0;
+}
+
+/**
+ * @brief Возвращает снимок счетчиков обращений.
+ *
+ * @return Попадания, промахи, вставки и вытеснения с момента создания или
+ * последнего reset_stats().
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+CacheStats lru_cache<Key, Value, Options, Hash>::stats() const noexcept {
+  return stats_;
+}
+
+/**
+ * @brief Обнуляет счетчики обращений.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::reset_stats() noexcept {
+  stats_ = CacheStats();
+}
+
+/**
+ * @brief Ищет запись по ключу в индексе, включая призраков ARC.
+ *
+ * @param key Ключ.
+ * @param hash Хеш ключа.
+ * @return Запись или nullptr.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+typename lru_cache<Key, Value, Options, Hash>::Entry *
+lru_cache<Key, Value, Options, Hash>::Find(const key_type &key,
+                                           std::size_t hash) const {
+  const size_type mask = index_.size() - 1;
+  for (size_type i = Home(hash);; i = (i + 1) & mask) {
+    const IndexSlot &slot = index_[i];
+    if (slot.entry_ == nullptr) {
+      return nullptr;
+    }
+    if (slot.hash_ == hash && slot.entry_->key_ == key) {
+      return slot.entry_;
+    }
+  }
+}
+
+/**
+ * @brief Добавляет запись в индекс, при заполнении больше чем наполовину
+ * удваивая его.
+ *
+ * @param entry Запись, которой еще нет в индексе.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::IndexInsert(Entry *entry) {
+  if (2 * (used_ + 1) > index_.size()) {
+    Rehash(2 * index_.size());
+  }
+  const size_type mask = index_.size() - 1;
+  size_type i = Home(entry->hash_);
+  while (index_[i].entry_ != nullptr) {
+    i = (i + 1) & mask;
+  }
+  index_[i] = IndexSlot{entry->hash_, entry};
+  ++used_;
+}
+
+/**
+ * @brief Удаляет запись из индекса без надгробий: следующие за ней записи
+ * той же цепочки сдвигаются назад.
+ *
+ * @param entry Запись из индекса.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::IndexErase(
+    const Entry *entry) noexcept {
+  const size_type mask = index_.size() - 1;
+  size_type hole = Home(entry->hash_);
+  while (index_[hole].entry_ != entry) {
+    hole = (hole + 1) & mask;
+  }
+  for (size_type i = (hole + 1) & mask; index_[i].entry_ != nullptr;
+       i = (i + 1) & mask) {
+    // Запись можно перенести в дыру, если ее исходная ячейка не лежит
+    // между дырой и текущей позицией
+    const size_type home = Home(index_[i].hash_);
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      index_[hole] = index_[i];
+      hole = i;
+    }
+  }
+  index_[hole].entry_ = nullptr;
+  --used_;
+}
+
+/**
+ * @brief Перестраивает индекс на заданное число ячеек.
+ *
+ * @param slots Число ячеек, степень двойки не меньше 2.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::Rehash(size_type slots) {
+  std::vector<IndexSlot> old(slots, IndexSlot{0, nullptr});
+  old.swap(index_);
+  index_shift_ = 64;
+  for (size_type size = slots; size > 1; size /= 2) {
+    --index_shift_;
+  }
+  const size_type mask = slots - 1;
+  for (const IndexSlot &slot : old) {
+    if (slot.entry_ != nullptr) {
+      size_type i = Home(slot.hash_);
+      while (index_[i].entry_ != nullptr) {
+        i = (i + 1) & mask;
+      }
+      index_[i] = slot;
+    }
+  }
+}
+
+/**
+ * @brief Вычисляет исходную ячейку ключа. Хеш перемешивается умножением
+ * Фибоначчи, так что и тождественный std::hash целых чисел дает
+ * равномерные старшие биты.
+ *
+ * @param hash Хеш ключа.
+ * @return Номер ячейки.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+typename lru_cache<Key, Value, Options, Hash>::size_type
+lru_cache<Key, Value, Options, Hash>::Home(std::size_t hash) const noexcept {
+  return static_cast<size_type>(
+      (static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >>
+      index_shift_);
+}
+
+/**
+ * @brief Берет свободную запись (или создает новую) и вносит ее в индекс.
+ *
+ * @param hash Хеш ключа.
+ * @param key Ключ.
+ * @param value Значение.
+ * @return Запись, еще не связанная ни с одним списком.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+typename lru_cache<Key, Value, Options, Hash>::Entry *
+lru_cache<Key, Value, Options, Hash>::Acquire(std::size_t hash,
+                                              const key_type &key,
+                                              const mapped_type &value) {
+  Entry *entry;
+  if (!free_.empty()) {
+    entry = &free_.front();
+    entry->key_ = key;
+    entry->value_ = value;
+    entry->hash_ = hash;
+    free_.pop_front();
+  } else {
+    entry = &entries_.emplace_back(hash, key, value);
+  }
+  try {
+    IndexInsert(entry);
+  } catch (...) {
+    free_.push_front(*entry);
+    throw;
+  }
+  return entry;
+}
+
+/**
+ * @brief Удаляет запись из индекса и списков и отдает ее в свободные. Ключ
+ * и значение остаются в записи до ее переиспользования.
+ *
+ * @param entry Запись из индекса.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::Release(Entry *entry) noexcept {
+  Unlink(entry);
+  IndexErase(entry);
+  free_.push_front(*entry);
+}
+
+/**
+ * @brief Ставит запись в голову списка.
+ *
+ * @param entry Несвязанная запись.
+ * @param list Номер списка.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::Link(Entry *entry,
+                                                unsigned list) noexcept {
+  entry->list_ = list;
+  lists_[list].push_front(*entry);
+  if constexpr (Options::policy == CachePolicy::kLfu) {
+    lfu_levels_ |= std::uint64_t{1} << list;
+  }
+}
+
+/**
+ * @brief Отсоединяет запись от ее списка.
+ *
+ * @param entry Запись из списка.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::Unlink(Entry *entry) noexcept {
+  entry_list &list = lists_[entry->list_];
+  list.remove(*entry);
+  if constexpr (Options::policy == CachePolicy::kLfu) {
+    if (list.empty()) {
+      lfu_levels_ &= ~(std::uint64_t{1} << entry->list_);
+    }
+  }
+}
+
+/**
+ * @brief Отмечает обращение к записи в кэше: LRU переносит ее в голову
+ * списка, LFU - на следующий уровень, ARC - в голову T2.
+ *
+ * @param entry Запись в кэше.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::Touch(Entry *entry) noexcept {
+  unsigned list = kT1;
+  if constexpr (Options::policy == CachePolicy::kLfu) {
+    list = entry->list_ + 1 < kListCount ? entry->list_ + 1 : entry->list_;
+  } else if constexpr (Options::policy == CachePolicy::kArc) {
+    list = kT2;
+  }
+  Unlink(entry);
+  Link(entry, list);
+}
+
+/**
+ * @brief Проверяет, что запись в кэше, а не призрак ARC.
+ *
+ * @param entry Запись из индекса.
+ * @return true для записи из кэша.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+bool lru_cache<Key, Value, Options, Hash>::IsResident(
+    const Entry *entry) const noexcept {
+  return Options::policy != CachePolicy::kArc || entry->list_ == kT1 ||
+         entry->list_ == kT2;
+}
+
+/**
+ * @brief Вытесняет записи (LRU и LFU), пока не освободится место под вес
+ * incoming.
+ *
+ * @param incoming Вес добавляемой записи, не больше емкости.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::EvictFor(size_type incoming) {
+  while (resident_ > 0 && weight_ + incoming > capacity_) {
+    Entry *victim = Victim();
+    weight_ -= victim->weight_;
+    --resident_;
+    Release(victim);
+    ++stats_.evictions;
+  }
+}
+
+/**
+ * @brief Выбирает запись для вытеснения: хвост списка LRU или хвост
+ * младшего непустого уровня LFU.
+ *
+ * @return Запись в кэше; кэш не пуст.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+typename lru_cache<Key, Value, Options, Hash>::Entry *
+lru_cache<Key, Value, Options, Hash>::Victim() noexcept {
+  if constexpr (Options::policy == CachePolicy::kLfu) {
+    return &lists_[__builtin_ctzll(lfu_levels_)].back();
+  } else {
+    return &lists_[kT1].back();
+  }
+}
+
+/**
+ * @brief Добавление записи по алгоритму ARC (Megiddo, Modha).
+ *
+ * Попадание в призрака B1 означает, что T1 был мал, и увеличивает его
+ * целевой размер; попадание в B2 - уменьшает. Размер кэша не превышает
+ * capacity, а вместе с призраками - 2 * capacity записей.
+ *
+ * @param entry Запись ключа из индекса или nullptr.
+ * @param hash Хеш ключа.
+ * @param key Ключ.
+ * @param value Значение.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::ArcPut(Entry *entry,
+                                                  std::size_t hash,
+                                                  const key_type &key,
+                                                  const mapped_type &value) {
+  if (capacity_ == 0) {
+    return;
+  }
+  if (entry != nullptr) {
+    entry->value_ = value;
+    if (IsResident(entry)) {
+      Touch(entry);
+      return;
+    }
+    const size_type b1 = lists_[kB1].size();
+    const size_type b2 = lists_[kB2].size();
+    const bool in_b2 = entry->list_ == kB2;
+    if (in_b2) {
+      target_t1_ -= std::min(target_t1_, std::max<size_type>(b1 / b2, 1));
+    } else {
+      target_t1_ =
+          std::min(capacity_, target_t1_ + std::max<size_type>(b2 / b1, 1));
+    }
+    Unlink(entry);
+    if (resident_ >= capacity_) {
+      ArcReplace(in_b2);
+    }
+    Link(entry, kT2);
+  } else {
+    const size_type t1 = lists_[kT1].size();
+    const size_type l1 = t1 + lists_[kB1].size();
+    const size_type total = l1 + lists_[kT2].size() + lists_[kB2].size();
+    if (l1 >= capacity_ && t1 < capacity_) {
+      Release(&lists_[kB1].back());
+      if (resident_ >= capacity_) {
+        ArcReplace(false);
+      }
+    } else if (l1 >= capacity_) {
+      // T1 занимает весь кэш: его хвост вытесняется без призрака
+      --resident_;
+      Release(&lists_[kT1].back());
+      ++stats_.evictions;
+    } else if (total >= capacity_) {
+      if (total >= 2 * capacity_) {
+        Release(&lists_[kB2].back());
+      }
+      if (resident_ >= capacity_) {
+        ArcReplace(false);
+      }
+    }
+    entry = Acquire(hash, key, value);
+    entry->weight_ = 1;
+    Link(entry, kT1);
+  }
+  ++resident_;
+  weight_ = resident_;
+  ++stats_.insertions;
+}
+
+/**
+ * @brief Вытесняет запись ARC в призраки: хвост T1 в B1, если T1 больше
+ * целевого размера, иначе хвост T2 в B2.
+ *
+ * @param ghost_in_b2 Добавляемый ключ найден в B2.
+ */
+template <typename Key, typename Value, typename Options, typename Hash>
+void lru_cache<Key, Value, Options, Hash>::ArcReplace(
+    bool ghost_in_b2) noexcept {
+  const size_type t1 = lists_[kT1].size();
+  const bool from_t1 = t1 > 0 && (t1 > target_t1_ ||
+                                  (ghost_in_b2 && t1 == target_t1_) ||
+                                  lists_[kT2].empty());
+  Entry *victim = &lists_[from_t1 ? kT1 : kT2].back();
+  Unlink(victim);
+  Link(victim, from_t1 ? kB1 : kB2);
+  --resident_;
+  ++stats_.evictions;
+}
+
+} // namespace s21
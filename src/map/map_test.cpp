@@ -3,6 +3,14 @@
 #include "s21_map.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace s21 {
 TEST(MapTest, EmptyMap) {
   s21::map<int, std::string> m;
@@ -210,6 +218,387 @@ TEST(MapTest, MergeWithoutModifyingOriginal) {
   EXPECT_EQ(m1_copy.size(), 2);
 }
 
+TEST(MapTest, EraseKeyRangeAndIf) {
+  s21::map<int, int> m;
+  for (int i = 0; i < 100; ++i) {
+    m.insert(i, i * i);
+  }
+  EXPECT_EQ(m.erase(10, 90), 80U);
+  EXPECT_EQ(m.erase(5, 5), 0U);
+  EXPECT_FALSE(m.contains(10));
+  EXPECT_TRUE(m.contains(90));
+
+  auto it = m.erase(m.begin(), m.find(5));
+  EXPECT_EQ((*it).first, 5);
+  EXPECT_EQ(m.size(), 15U);
+
+  EXPECT_EQ(m.erase_if([](const std::pair<const int, int> &item) {
+              return item.second % 2 == 0;
+            }),
+            7U);
+  EXPECT_EQ(m.size(), 8U);
+  EXPECT_EQ(m.at(91), 91 * 91);
+}
+
+TEST(MapTest, ExtractAndInsertNode) {
+  s21::map<int, std::string> hot{{1, "one"}, {2, "two"}, {3, "three"}};
+  s21::map<int, std::string> cold{{20, "old"}};
+
+  auto node = hot.extract(2);
+  ASSERT_FALSE(node.empty());
+  node.key() = 10;
+  node.mapped() += "!";
+  auto result = cold.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ((*result.position).first, 10);
+  EXPECT_EQ(cold.at(10), "two!");
+  EXPECT_FALSE(hot.contains(2));
+
+  node = hot.extract(hot.begin());
+  node.key() = 20;
+  result = cold.insert(std::move(node));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(result.node.mapped(), "one");
+  EXPECT_EQ(cold.at(20), "old");
+  EXPECT_TRUE(hot.extract(42).empty());
+}
+
+TEST(MapTest, Stats) {
+  s21::map<int, std::string, s21::StatsTreeOptions> m{{1, "one"},
+                                                      {2, "two"}};
+  m[3] = "three";
+  s21::ContainerStats stats = m.stats();
+  EXPECT_EQ(stats.allocations, 3U);
+  EXPECT_GT(stats.descents, 0U);
+
+  m.reset_stats();
+  for (auto it = m.begin(); it != m.end(); ++it) {
+  }
+  EXPECT_EQ(m.stats().comparisons, 0U);
+  EXPECT_EQ(m.stats().descents, 0U);
+}
+
+namespace {
+// Тип, считающий копирования и перемещения своих объектов.
+struct Counted {
+  static inline int copies = 0;
+  static inline int moves = 0;
+
+  static void Reset() { copies = moves = 0; }
+
+  Counted(int value = 0) : value(value) {}
+  Counted(const Counted &other) : value(other.value) { ++copies; }
+  Counted(Counted &&other) noexcept : value(other.value) { ++moves; }
+  Counted &operator=(const Counted &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  Counted &operator=(Counted &&other) noexcept {
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+  bool operator<(const Counted &other) const { return value < other.value; }
+
+  int value;
+};
+} // namespace
+
+TEST(MapTest, InsertionMovesInsteadOfCopying) {
+  s21::map<Counted, Counted> m;
+  Counted::Reset();
+  EXPECT_TRUE(m.insert(Counted(1), Counted(10)).second);
+  EXPECT_EQ(Counted::copies, 0);
+  EXPECT_EQ(Counted::moves, 2);
+
+  // Дубликат: аргументы не трогаются
+  Counted::Reset();
+  Counted key(1);
+  Counted value(11);
+  EXPECT_FALSE(m.insert(std::move(key), std::move(value)).second);
+  EXPECT_EQ(Counted::copies + Counted::moves, 0);
+
+  // Присваивается только значение, одним перемещением
+  Counted::Reset();
+  EXPECT_FALSE(m.insert_or_assign(Counted(1), Counted(12)).second);
+  EXPECT_EQ(Counted::copies, 0);
+  EXPECT_EQ(Counted::moves, 1);
+  EXPECT_EQ(m.at(Counted(1)).value, 12);
+  Counted::Reset();
+  const Counted existing(1);
+  m.insert_or_assign(existing, Counted(13));
+  EXPECT_EQ(Counted::copies, 0);
+  EXPECT_EQ(Counted::moves, 1);
+
+  // Пара строится прямо в узле
+  Counted::Reset();
+  EXPECT_TRUE(m.emplace(std::piecewise_construct, std::forward_as_tuple(2),
+                        std::forward_as_tuple(20))
+                  .second);
+  EXPECT_TRUE(m.try_emplace(Counted(3), 30).second);
+  EXPECT_FALSE(m.try_emplace(Counted(3), 31).second);
+  EXPECT_EQ(Counted::copies, 0);
+  EXPECT_EQ(Counted::moves, 1);
+
+  // operator[]: поиск без временной пары, ключ перемещается в новый узел
+  Counted::Reset();
+  m[Counted(4)] = Counted(40);
+  EXPECT_EQ(m[Counted(4)].value, 40);
+  EXPECT_EQ(Counted::copies, 0);
+  EXPECT_EQ(Counted::moves, 2);
+  const Counted lookup(2);
+  Counted::Reset();
+  EXPECT_EQ(m[lookup].value, 20);
+  EXPECT_EQ(Counted::copies + Counted::moves, 0);
+
+  // Вставка пары: значение перемещается, константный ключ копируется
+  Counted::Reset();
+  EXPECT_TRUE(m.insert(std::pair<const Counted, Counted>(5, 50)).second);
+  EXPECT_EQ(Counted::copies, 1);
+  EXPECT_EQ(Counted::moves, 1);
+
+  std::vector<int> keys;
+  for (const auto &item : m) {
+    keys.push_back(item.first.value);
+  }
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST(MapTest, MemoryUsage) {
+  s21::map<int, int> plain;
+  s21::map<int, int, s21::CompactTreeOptions> compact;
+  const std::size_t plain_empty = plain.memory_usage();
+  const std::size_t compact_empty = compact.memory_usage();
+  for (int key = 0; key < 64; ++key) {
+    plain[key] = key;
+    compact[key] = key;
+  }
+  // Пара int занимает 8 байт: вместе с тремя указателями компактный узел
+  // укладывается в 32 байта, обычному нужны еще байты цвета и признака.
+  EXPECT_EQ(plain.memory_usage() - plain_empty, 64 * 40U);
+  EXPECT_EQ(compact.memory_usage() - compact_empty, 64 * 32U);
+  // Узлам копии из общего блока нужен еще номер ячейки, а хвостового
+  // выравнивания у такого узла нет; к ячейкам добавляется 16-байтовый
+  // заголовок блока.
+  const s21::map<int, int, s21::CompactTreeOptions> copy = compact;
+  EXPECT_EQ(copy.memory_usage() - compact_empty, 64 * 40U + 16);
+  EXPECT_EQ(copy.at(17), 17);
+}
+
+TEST(MapTest, StringKeyFindComparisons) {
+  s21::map<std::string, int, s21::StatsTreeOptions> m;
+  for (int i = 0; i < 512; ++i) {
+    m.insert("user/" + std::to_string(i), i);
+  }
+  m.reset_stats();
+  EXPECT_EQ(m.at("user/300"), 300);
+  EXPECT_FALSE(m.contains("user/300x"));
+  s21::ContainerStats stats = m.stats();
+#if S21_CONTAINERS_THREE_WAY
+  // Одно трехстороннее сравнение на уровень.
+  EXPECT_LE(stats.comparisons, 2 * stats.max_depth);
+#else
+  EXPECT_LE(stats.comparisons, 4 * stats.max_depth);
+#endif
+  EXPECT_FALSE(m.insert("user/300", 0).second);
+}
+
+TEST(MapTest, SetAlgebraKeepsLeftValues) {
+  s21::map<int, std::string> lhs{{1, "a"}, {2, "b"}, {3, "c"}};
+  s21::map<int, std::string> rhs{{2, "x"}, {3, "y"}, {4, "z"}};
+
+  s21::map<int, std::string> all = set_union(lhs, rhs);
+  EXPECT_EQ(all, (s21::map<int, std::string>{
+                     {1, "a"}, {2, "b"}, {3, "c"}, {4, "z"}}));
+  EXPECT_EQ(set_intersection(rhs, lhs),
+            (s21::map<int, std::string>{{2, "x"}, {3, "y"}}));
+  EXPECT_EQ(set_difference(lhs, rhs), (s21::map<int, std::string>{{1, "a"}}));
+  EXPECT_EQ(symmetric_difference(lhs, rhs),
+            (s21::map<int, std::string>{{1, "a"}, {4, "z"}}));
+
+  rhs |= lhs;
+  EXPECT_EQ(rhs, (s21::map<int, std::string>{
+                     {1, "a"}, {2, "x"}, {3, "y"}, {4, "z"}}));
+  rhs -= s21::map<int, std::string>{{1, ""}, {4, ""}};
+  EXPECT_EQ(rhs, (s21::map<int, std::string>{{2, "x"}, {3, "y"}}));
+  rhs &= lhs;
+  rhs ^= s21::map<int, std::string>{{3, ""}, {5, "e"}};
+  EXPECT_EQ(rhs, (s21::map<int, std::string>{{2, "x"}, {5, "e"}}));
+}
+
+TEST(MapTest, RangeAggregates) {
+  s21::map<std::uint64_t, std::int64_t,
+           s21::AggregateTreeOptions<s21::SumAggregate<std::int64_t>>>
+      counters;
+  std::map<std::uint64_t, std::int64_t> expected;
+  for (std::uint64_t ts = 0; ts < 3000; ts += 3) {
+    counters.insert(ts, static_cast<std::int64_t>(ts % 17) - 8);
+    expected.emplace(ts, static_cast<std::int64_t>(ts % 17) - 8);
+  }
+  counters.insert_or_assign(300, 1000);
+  expected[300] = 1000;
+  counters.update(counters.find(600), [](std::int64_t &value) { value *= 3; });
+  expected[600] *= 3;
+  counters.erase(counters.find(900));
+  expected.erase(900);
+
+  for (auto [lo, hi] :
+       {std::pair<std::uint64_t, std::uint64_t>{0, 3000}, {299, 901},
+        {300, 301}, {300, 300}, {301, 302}, {2000, 1000}}) {
+    std::int64_t sum = 0;
+    for (auto it = expected.lower_bound(lo);
+         it != expected.end() && it->first < hi; ++it) {
+      sum += it->second;
+    }
+    EXPECT_EQ(counters.aggregate(lo, hi), sum);
+  }
+  // Те же границы, что у erase(lo, hi): агрегат удаляемых элементов.
+  const std::int64_t removed = counters.aggregate(300, 603);
+  const std::int64_t total = counters.aggregate(0, 3000);
+  counters.erase(300, 603);
+  EXPECT_EQ(counters.aggregate(0, 3000), total - removed);
+  EXPECT_EQ(counters.aggregate(300, 603), 0);
+
+  s21::map<int, double, s21::AggregateTreeOptions<s21::MinAggregate<double>>>
+      low{{1, 2.5}, {2, -1.0}, {3, 4.0}};
+  EXPECT_EQ(low.aggregate(1, 3), -1.0);
+  EXPECT_EQ(low.aggregate(3, 9), 4.0);
+  EXPECT_EQ(low.aggregate(3, 3), std::numeric_limits<double>::infinity());
+  EXPECT_EQ(low.aggregate(4, 9), std::numeric_limits<double>::infinity());
+  s21::map<int, int, s21::AggregateTreeOptions<s21::MaxAggregate<int>>> high{
+      {1, 5}, {2, 9}, {3, 7}};
+  EXPECT_EQ(high.aggregate(2, 4), 9);
+  EXPECT_EQ(high.aggregate(3, 4), 7);
+  s21::map<int, int, s21::AggregateTreeOptions<s21::CountAggregate>> count{
+      {1, 0}, {4, 0}, {9, 0}};
+  EXPECT_EQ(count.aggregate(2, 9), 1U);
+  EXPECT_EQ(count.aggregate(2, 10), 2U);
+}
+
+template <typename Options> void CheckMapBackend() {
+  map<int, std::string, Options> m;
+  std::map<int, std::string> ref;
+  for (int key = 0; key < 200; ++key) {
+    const int shuffled = key * 37 % 200;
+    m[shuffled] = std::to_string(shuffled);
+    ref[shuffled] = std::to_string(shuffled);
+  }
+  EXPECT_FALSE(m.insert(5, "five").second);
+  m.insert_or_assign(5, "five");
+  ref[5] = "five";
+  EXPECT_EQ(m.at(5), "five");
+  EXPECT_THROW(m.at(500), std::out_of_range);
+  EXPECT_EQ(m.erase(50, 100), 50U);
+  ref.erase(ref.lower_bound(50), ref.lower_bound(100));
+  m.erase(m.find(7));
+  ref.erase(7);
+
+  const map<int, std::string, Options> copy = m;
+  EXPECT_TRUE(copy.contains(5));
+  EXPECT_FALSE(copy.contains(7));
+  map<int, std::string, Options> other;
+  other.insert(1000, "thousand");
+  m.merge(other);
+  ref[1000] = "thousand";
+  EXPECT_EQ(m.size(), ref.size());
+  EXPECT_TRUE(std::equal(m.begin(), m.end(), ref.begin(), ref.end()));
+  EXPECT_EQ(copy.size(), ref.size() - 1);
+}
+
+TEST(MapTest, SelfAdjustingBackends) {
+  CheckMapBackend<SplayTreeOptions>();
+  CheckMapBackend<TreapTreeOptions>();
+  CheckMapBackend<FrequencyTreapTreeOptions>();
+}
+
+// Значение без конструктора по умолчанию и ключ, считающий свои копии:
+// поиск по ключу не должен строить временную пару.
+struct NoDefault {
+  explicit NoDefault(int v) : value(v) {}
+  int value;
+};
+
+struct CountedKey {
+  static inline int copies = 0;
+  explicit CountedKey(int v) : value(v) {}
+  CountedKey(const CountedKey &other) : value(other.value) { ++copies; }
+  CountedKey &operator=(const CountedKey &) = default;
+  bool operator<(const CountedKey &other) const { return value < other.value; }
+  int value;
+};
+
+template <typename Options> void CheckProbeLookups() {
+  map<CountedKey, NoDefault, Options> m;
+  for (int key = 0; key < 100; ++key) {
+    m.insert(CountedKey(key), NoDefault(key * 2));
+  }
+  const auto &view = m;
+  CountedKey::copies = 0;
+  EXPECT_TRUE(m.contains(CountedKey(40)));
+  EXPECT_FALSE(m.contains(CountedKey(100)));
+  EXPECT_EQ(m.at(CountedKey(41)).value, 82);
+  EXPECT_EQ(view.at(CountedKey(42)).value, 84);
+  EXPECT_EQ((*m.find(CountedKey(43))).second.value, 86);
+  EXPECT_EQ((*view.find(CountedKey(44))).second.value, 88);
+  EXPECT_EQ(view.count(CountedKey(-1)), 0U);
+  EXPECT_THROW(m.at(CountedKey(-1)), std::out_of_range);
+  EXPECT_EQ(m.erase(CountedKey(10), CountedKey(20)), 10U);
+  EXPECT_EQ(CountedKey::copies, 0);
+  EXPECT_EQ(m.size(), 90U);
+  EXPECT_FALSE(m.contains(CountedKey(15)));
+}
+
+TEST(MapTest, LookupsNeedNoDefaultValueOrKeyCopy) {
+  CheckProbeLookups<DefaultTreeOptions>();
+  CheckProbeLookups<SplayTreeOptions>();
+}
+
+TEST(MapTest, MapsSharingNodeBlockClearOnDifferentThreads) {
+  // Копия лежит в одном блоке; часть ее узлов переезжает в другую карту, и
+  // обе карты освобождают узлы общего блока одновременно.
+  for (int round = 0; round < 20; ++round) {
+    map<int, std::string> source;
+    for (int key = 0; key < 200; ++key) {
+      source.insert(key, std::to_string(key));
+    }
+    map<int, std::string> copy = source;
+    map<int, std::string> other;
+    for (int key = 0; key < 200; key += 4) {
+      other.insert(copy.extract(key));
+    }
+    ASSERT_EQ(other.size(), 50U);
+    std::thread worker([&other] { other.clear(); });
+    copy.clear();
+    worker.join();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(other.empty());
+  }
+}
+
+TEST(MapTest, CompactKeepsContents) {
+  map<int, std::string> m;
+  std::map<int, std::string> ref;
+  for (int key = 0; key < 500; ++key) {
+    m[key * 13 % 500] = std::to_string(key);
+    ref[key * 13 % 500] = std::to_string(key);
+  }
+  for (int key = 0; key < 500; key += 3) {
+    m.erase(m.find(key));
+    ref.erase(key);
+  }
+  m.compact();
+  EXPECT_TRUE(std::equal(m.begin(), m.end(), ref.begin(), ref.end()));
+  int calls = 0;
+  while (!m.compact_step(50, CompactOrder::kVanEmdeBoas)) {
+    ++calls;
+  }
+  EXPECT_EQ(calls, 6);
+  m[1000] = "thousand";
+  ref[1000] = "thousand";
+  EXPECT_TRUE(std::equal(m.begin(), m.end(), ref.begin(), ref.end()));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
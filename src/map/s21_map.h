@@ -1,12 +1,16 @@
 #ifndef CPP2_S21_CONTAINERS_1_S21_MAP_H
 #define CPP2_S21_CONTAINERS_1_S21_MAP_H
 
-#include "../tree/RedBlackTree.h"
+#include "../tree/OrderedTree.h"
 #include <stdexcept>
+#include <tuple>
+#include <utility>
 
 
 namespace s21 {
-template <typename Key, typename Type> class map {
+template <typename Key, typename Type,
+          typename Options = DefaultTreeOptions>
+class map {
 public:
   // Типы данных
   using key_type = Key;
@@ -15,17 +19,33 @@ public:
   using reference = value_type &;
   using const_reference = const value_type &;
 
+  // Сравнивает пары по ключу; сравнивать можно любые объекты с полем first,
+  // в том числе пробы поиска без пары. Если ключ поддерживает оператор <=>
+  // со слабым или строгим порядком (C++20), компаратор возвращает результат
+  // трехстороннего сравнения, и дерево тратит на уровень одно сравнение
+  // вместо двух.
   struct MapKeyComparator {
-    template <typename PairType>
-    bool operator()(const PairType &lhs, const PairType &rhs) const noexcept {
+    template <typename Lhs, typename Rhs>
+    auto operator()(const Lhs &lhs, const Rhs &rhs) const noexcept {
+#if S21_CONTAINERS_THREE_WAY
+      if constexpr (std::three_way_comparable<key_type, std::weak_ordering>) {
+        return lhs.first <=> rhs.first;
+      } else {
+        return lhs.first < rhs.first;
+      }
+#else
       return lhs.first < rhs.first;
+#endif
     }
   };
 
-  using tree_type = RedBlackTree<value_type, MapKeyComparator>;
+  using tree_type = OrderedTree<value_type, MapKeyComparator, Options>;
   using iterator = typename tree_type::iterator;
   using const_iterator = typename tree_type::const_iterator;
   using size_type = std::size_t;
+  using node_type = typename tree_type::node_type;
+  using insert_return_type = typename tree_type::insert_return_type;
+  using aggregate_type = typename tree_type::aggregate_type;
 
   // Конструкторы, деструкторы и операторы присваивания
   map();
@@ -41,10 +61,34 @@ public:
   bool operator==(const map &otherMap) const;
   bool operator!=(const map &otherMap) const;
 
+  // Теоретико-множественные операции по ключам за O(n + m): упорядоченные
+  // обходы сливаются, а результат строится снизу вверх за один проход.
+  // При совпадении ключей значение берется из левой карты.
+  friend map set_union(const map &lhs, const map &rhs) {
+    return map(tree_type::Combine(lhs.tree_, rhs.tree_,
+                                  SetOperation::kUnion));
+  }
+
+  friend map set_intersection(const map &lhs, const map &rhs) {
+    return map(tree_type::Combine(lhs.tree_, rhs.tree_,
+                                  SetOperation::kIntersection));
+  }
+
+  friend map set_difference(const map &lhs, const map &rhs) {
+    return map(tree_type::Combine(lhs.tree_, rhs.tree_,
+                                  SetOperation::kDifference));
+  }
+
+  friend map symmetric_difference(const map &lhs, const map &rhs) {
+    return map(tree_type::Combine(lhs.tree_, rhs.tree_,
+                                  SetOperation::kSymmetricDifference));
+  }
+
   // Доступ к элементам
   mapped_type &at(const key_type &key);
   const mapped_type &at(const key_type &key) const;
   mapped_type &operator[](const key_type &key);
+  mapped_type &operator[](key_type &&key);
 
   // Итераторы
   iterator begin() noexcept;
@@ -60,24 +104,79 @@ public:
   // Модификаторы
   void clear() noexcept;
   std::pair<iterator, bool> insert(const value_type &element_to_insert);
+  std::pair<iterator, bool> insert(value_type &&element_to_insert);
   std::pair<iterator, bool> insert(const key_type &key,
                                    const mapped_type &value);
+  std::pair<iterator, bool> insert(key_type &&key, mapped_type &&value);
   std::pair<iterator, bool> insert_or_assign(const key_type &key,
                                              const mapped_type &value);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             mapped_type &&value);
+  std::pair<iterator, bool> insert_or_assign(key_type &&key,
+                                             mapped_type &&value);
   void erase(iterator pos) noexcept;
+  iterator erase(iterator first, iterator last) noexcept;
+  size_type erase(const key_type &lo, const key_type &hi);
+  template <typename Predicate> size_type erase_if(Predicate pred);
+  node_type extract(iterator pos) noexcept;
+  node_type extract(const key_type &key);
+  insert_return_type insert(node_type &&node);
   void swap(map &otherMap) noexcept;
   void merge(map &otherMap) noexcept;
   template <typename... Args> std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
   template <typename InputIt> void insert_many(InputIt first, InputIt last);
 
+  // Те же операции на месте: узлы текущей карты используются повторно
+  map &operator|=(const map &otherMap);
+  map &operator&=(const map &otherMap);
+  map &operator-=(const map &otherMap);
+  map &operator^=(const map &otherMap);
+
   // Операции над элементами
   iterator find(const key_type &key) noexcept;
   const_iterator find(const key_type &key) const noexcept;
   size_type count(const key_type &key) const noexcept;
   bool contains(const key_type &key) const noexcept;
 
+  // Агрегаты по полуинтервалам ключей [lo, hi), как у erase(lo, hi) (только
+  // при Options::aggregate, например
+  // map<Key, Type, AggregateTreeOptions<SumAggregate<Type>>>). Значения
+  // нужно менять через insert_or_assign или update: запись по ссылке из
+  // at, operator[] или итератора агрегаты не обновляет.
+  aggregate_type aggregate(const key_type &lo, const key_type &hi) const;
+  template <typename Function> void update(iterator pos, Function modify);
+
+  // Счетчики горячего пути (заполнены только при Options::stats)
+  ContainerStats stats() const noexcept;
+  void reset_stats() noexcept;
+
+  // Память, занятая контейнером вместе с узлами, в байтах (за O(n log n))
+  [[nodiscard]] size_type memory_usage() const;
+
+  // Уплотнение: узлы переносятся в один непрерывный блок по порядку ключей
+  // или в порядке ван Эмде Боаса, целиком или порциями по max_nodes узлов
+  // (compact_step вернет true, когда проход закончен). Итераторы и ссылки
+  // на перенесенные элементы становятся недействительными.
+  void compact(CompactOrder order = CompactOrder::kInOrder);
+  bool compact_step(size_type max_nodes,
+                    CompactOrder order = CompactOrder::kInOrder);
+
 private:
-  tree_type *tree_;
+  // Проба поиска по ключу: компаратор читает только first, поэтому искать
+  // можно без временной пары с копией ключа и значением по умолчанию.
+  struct KeyProbe {
+    const key_type &first;
+  };
+
+  explicit map(tree_type &&tree);
+  template <typename K, typename M>
+  std::pair<iterator, bool> InsertOrAssign(K &&key, M &&value);
+
+  tree_type tree_;
 };
 
 } // namespace s21
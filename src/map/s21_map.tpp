@@ -8,11 +8,11 @@ namespace s21 {
 /**
  * @brief Конструктор по умолчанию. Инициализирует пустое дерево.
  *
- * Создает фиктивный узел head_ и связанные с ним указатели,
- * чтобы обеспечить пустое дерево.
+ * Дерево хранится в самой карте вместе со своим фиктивным узлом, поэтому
+ * пустая карта не выделяет память.
  */
-template <typename Key, typename Type>
-map<Key, Type>::map() : tree_(new tree_type{}) {}
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options>::map() : tree_() {}
 /**
  * @brief Конструктор инициализации на основе списка значений.
  *
@@ -22,23 +22,36 @@ map<Key, Type>::map() : tree_(new tree_type{}) {}
  *
  * @param items Список значений для инициализации дерева.
  */
-template <typename Key, typename Type>
-map<Key, Type>::map(std::initializer_list<value_type> const &items) : map() {
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options>::map(
+    std::initializer_list<value_type> const &items) : map() {
   for (const auto &item : items) {
     insert(item);
   }
 }
 
+/**
+ * @brief Создает карту, забирая готовое дерево.
+ *
+ * @param tree Дерево с уникальными ключами.
+ */
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options>::map(tree_type &&tree)
+    : tree_(std::move(tree)) {}
+
 /**
  * @brief Конструктор копирования. Создает копию дерева из другого объекта map.
  *
  * Создает глубокую копию дерева, на которое указывает другой объект map.
+ * Узлы копии лежат одним общим блоком, который держит любой оставшийся в
+ * нем узел; после удаления большей части элементов память блока
+ * возвращает compact().
  *
  * @param otherMap Другой объект map, из которого будет скопировано дерево.
  */
-template <typename Key, typename Type>
-map<Key, Type>::map(const map &otherMap)
-    : tree_(new tree_type(*otherMap.tree_)) {}
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options>::map(const map &otherMap)
+    : tree_(otherMap.tree_) {}
 
 /**
  * @brief Конструктор перемещения. Перемещает дерево из другого объекта map.
@@ -48,9 +61,9 @@ map<Key, Type>::map(const map &otherMap)
  *
  * @param otherMap Другой объект map, из которого будет перемещено дерево.
  */
-template <typename Key, typename Type>
-map<Key, Type>::map(map &&otherMap) noexcept
-    : tree_(new tree_type(std::move(*otherMap.tree_))) {}
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options>::map(map &&otherMap) noexcept
+    : tree_(std::move(otherMap.tree_)) {}
 
 /**
  * @brief Присваивание содержимого другой карты текущей карте.
@@ -61,12 +74,12 @@ map<Key, Type>::map(map &&otherMap) noexcept
  * @param otherMap Карта, содержимое которой будет скопировано.
  * @return Ссылка на текущую карту после присваивания.
  */
-template <typename Key, typename Type>
-map<Key, Type> &map<Key, Type>::operator=(const map &otherMap) {
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options> &map<Key, Type, Options>::operator=(
+    const map &otherMap) {
   if (this != &otherMap) {
-    auto *copiedTree = new tree_type(*otherMap.tree_);
-    std::swap(tree_, copiedTree);
-    delete copiedTree;
+    tree_type copiedTree(otherMap.tree_);
+    tree_.Swap(copiedTree);
   }
   return *this;
 }
@@ -81,10 +94,11 @@ map<Key, Type> &map<Key, Type>::operator=(const map &otherMap) {
  * @param otherMap Карта, содержимое которой будет перемещено.
  * @return Ссылка на текущую карту после перемещающего присваивания.
  */
-template <typename Key, typename Type>
-map<Key, Type> &map<Key, Type>::operator=(map &&otherMap) noexcept {
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options> &map<Key, Type, Options>::operator=(
+    map &&otherMap) noexcept {
   if (this != &otherMap) {
-    std::swap(tree_, otherMap.tree_);
+    tree_ = std::move(otherMap.tree_);
   }
   return *this;
 }
@@ -98,8 +112,8 @@ map<Key, Type> &map<Key, Type>::operator=(map &&otherMap) noexcept {
  * @param otherMap Другая карта, с которой производится сравнение.
  * @return true, если карты равны, иначе false.
  */
-template <typename Key, typename Type>
-inline bool map<Key, Type>::operator==(const map &otherMap) const {
+template <typename Key, typename Type, typename Options>
+inline bool map<Key, Type, Options>::operator==(const map &otherMap) const {
   if (this == &otherMap)
     return true;
   if (size() != otherMap.size())
@@ -122,18 +136,19 @@ inline bool map<Key, Type>::operator==(const map &otherMap) const {
  * @param other Другая карта, с которой выполняется сравнение.
  * @return `true`, если карты не равны, иначе `false`.
  */
-template <typename Key, typename Type>
-bool map<Key, Type>::operator!=(const map &otherMap) const {
+template <typename Key, typename Type, typename Options>
+bool map<Key, Type, Options>::operator!=(const map &otherMap) const {
   return !(*this == otherMap);
 }
 
 /**
  * @brief Деструктор класса карты.
  *
- * Освобождает память, занимаемую деревом карты.
+ * Освобождает память, занимаемую узлами дерева карты.
  * Этот метод вызывается при уничтожении объекта карты.
  */
-template <typename Key, typename Type> map<Key, Type>::~map() { delete tree_; }
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options>::~map() = default;
 
 /**
  * @brief Получение значения элемента по ключу с проверкой на наличие.
@@ -145,9 +160,11 @@ template <typename Key, typename Type> map<Key, Type>::~map() { delete tree_; }
  * @return Ссылка на значение элемента.
  * @throws std::out_of_range Если ключ отсутствует в карте.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::mapped_type &map<Key, Type>::at(const key_type &key) {
-  iterator searchIterator = tree_->Find(value_type(key, mapped_type{}));
+template <typename Key, typename Type, typename Options>
+typename
+map<Key, Type, Options>::mapped_type &map<Key, Type, Options>::at(
+    const key_type &key) {
+  iterator searchIterator = tree_.Find(KeyProbe{key});
 
   if (searchIterator == end()) {
     throw std::out_of_range(
@@ -169,10 +186,10 @@ typename map<Key, Type>::mapped_type &map<Key, Type>::at(const key_type &key) {
  * @return Ссылка на константное значение элемента.
  * @throws std::out_of_range Если ключ отсутствует в карте.
  */
-template <typename Key, typename Type>
-const typename map<Key, Type>::mapped_type &
-map<Key, Type>::at(const key_type &key) const {
-  const_iterator searchIterator = tree_->Find(value_type(key, mapped_type{}));
+template <typename Key, typename Type, typename Options>
+const typename map<Key, Type, Options>::mapped_type &
+map<Key, Type, Options>::at(const key_type &key) const {
+  const_iterator searchIterator = tree_.Find(KeyProbe{key});
 
   if (searchIterator == end()) {
     throw std::out_of_range(
@@ -193,26 +210,31 @@ map<Key, Type>::at(const key_type &key) const {
  * @param key Ключ элемента, значение которого необходимо получить или добавить.
  * @return Ссылка на значение элемента.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::mapped_type &
-map<Key, Type>::operator[](const key_type &key) {
-  // Создание временного значения для поиска элемента по ключу
-  value_type temp_value_to_search(key, mapped_type{});
-
-  // Поиск элемента в карте по временному значению
-  iterator search_iterator = tree_->Find(temp_value_to_search);
-
-  // Если элемент существует, возвращаем ссылку на его значение
-  if (search_iterator != end()) {
-    return (*search_iterator).second;
-  }
-
-  // Вставляем новый элемент в карту и получаем результат операции
-  std::pair<iterator, bool> insertion_result =
-      tree_->InsertUnique(temp_value_to_search);
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::mapped_type &
+map<Key, Type, Options>::operator[](const key_type &key) {
+  // Один спуск по ключу; пара создается прямо в узле, только если ключа нет
+  auto result = tree_.TryConstruct(KeyProbe{key}, std::piecewise_construct,
+                                    std::forward_as_tuple(key),
+                                    std::forward_as_tuple());
+  return (*result.first).second;
+}
 
-  // Возвращаем ссылку на значение нового элемента
-  return (*insertion_result.first).second;
+/**
+ * @brief Оператор индексации, перемещающий ключ в новый элемент.
+ *
+ * Если ключ уже есть, key остается нетронутым.
+ *
+ * @param key Ключ элемента.
+ * @return Ссылка на значение элемента.
+ */
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::mapped_type &
+map<Key, Type, Options>::operator[](key_type &&key) {
+  auto result = tree_.TryConstruct(KeyProbe{key}, std::piecewise_construct,
+                                    std::forward_as_tuple(std::move(key)),
+                                    std::forward_as_tuple());
+  return (*result.first).second;
 }
 /**
  * @brief Возвращает итератор, указывающий на начало контейнера.
@@ -221,9 +243,10 @@ map<Key, Type>::operator[](const key_type &key) {
  *
  * @return Итератор, указывающий на начало контейнера.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::iterator map<Key, Type>::begin() noexcept {
-  return tree_->Begin();
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::iterator
+map<Key, Type, Options>::begin() noexcept {
+  return tree_.Begin();
 }
 
 /**
@@ -233,9 +256,10 @@ typename map<Key, Type>::iterator map<Key, Type>::begin() noexcept {
  *
  * @return Константный итератор, указывающий на начало контейнера.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::const_iterator map<Key, Type>::begin() const noexcept {
-  return tree_->Begin();
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::const_iterator
+map<Key, Type, Options>::begin() const noexcept {
+  return tree_.Begin();
 }
 
 /**
@@ -246,9 +270,10 @@ typename map<Key, Type>::const_iterator map<Key, Type>::begin() const noexcept {
  *
  * @return Итератор, указывающий на конец контейнера.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::iterator map<Key, Type>::end() noexcept {
-  return tree_->End();
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::iterator
+map<Key, Type, Options>::end() noexcept {
+  return tree_.End();
 }
 
 /**
@@ -259,9 +284,10 @@ typename map<Key, Type>::iterator map<Key, Type>::end() noexcept {
  *
  * @return Константный итератор, указывающий на конец контейнера.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::const_iterator map<Key, Type>::end() const noexcept {
-  return tree_->End();
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::const_iterator
+map<Key, Type, Options>::end() const noexcept {
+  return tree_.End();
 }
 
 /**
@@ -271,8 +297,9 @@ typename map<Key, Type>::const_iterator map<Key, Type>::end() const noexcept {
  *
  * @return true, если контейнер пуст, иначе false.
  */
-template <typename Key, typename Type> bool map<Key, Type>::empty() const noexcept {
-  return tree_->Empty();
+template <typename Key, typename Type, typename Options>
+bool map<Key, Type, Options>::empty() const noexcept {
+  return tree_.Empty();
 }
 
 /**
@@ -282,9 +309,10 @@ template <typename Key, typename Type> bool map<Key, Type>::empty() const noexce
  *
  * @return Количество элементов в контейнере.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::size_type map<Key, Type>::size() const noexcept {
-  return tree_->Size();
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::size_type
+map<Key, Type, Options>::size() const noexcept {
+  return tree_.Size();
 }
 
 /**
@@ -295,9 +323,10 @@ typename map<Key, Type>::size_type map<Key, Type>::size() const noexcept {
  *
  * @return Максимальное количество элементов в контейнере.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::size_type map<Key, Type>::max_size() const noexcept {
-  return tree_->MaxSize();
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::size_type
+map<Key, Type, Options>::max_size() const noexcept {
+  return tree_.MaxSize();
 }
 
 /**
@@ -305,8 +334,9 @@ typename map<Key, Type>::size_type map<Key, Type>::max_size() const noexcept {
  *
  * Удаляет все элементы, содержащиеся в контейнере, оставляя его пустым.
  */
-template <typename Key, typename Type> void map<Key, Type>::clear() noexcept {
-  tree_->Clear();
+template <typename Key, typename Type, typename Options>
+void map<Key, Type, Options>::clear() noexcept {
+  tree_.Clear();
 }
 /**
  * @brief Вставляет элемент в карту, если его ключ отсутствует.
@@ -320,10 +350,27 @@ template <typename Key, typename Type> void map<Key, Type>::clear() noexcept {
  * @param element_to_insert Значение элемента, которое необходимо вставить.
  * @return Пара, содержащая итератор на элемент и флаг успешности вставки.
  */
-template <typename Key, typename Type>
-std::pair<typename map<Key, Type>::iterator, bool>
-map<Key, Type>::insert(const value_type &element_to_insert) {
-  return tree_->InsertUnique(element_to_insert);
+template <typename Key, typename Type, typename Options>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::insert(const value_type &element_to_insert) {
+  return tree_.TryConstruct(KeyProbe{element_to_insert.first},
+                             element_to_insert);
+}
+
+/**
+ * @brief Вставляет элемент перемещением, если его ключ отсутствует.
+ *
+ * Значение перемещается в узел; ключ пары константный и копируется. Если
+ * ключ уже есть, элемент остается нетронутым.
+ *
+ * @param element_to_insert Элемент для вставки.
+ * @return Пара, содержащая итератор на элемент и флаг успешности вставки.
+ */
+template <typename Key, typename Type, typename Options>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::insert(value_type &&element_to_insert) {
+  return tree_.TryConstruct(KeyProbe{element_to_insert.first},
+                             std::move(element_to_insert));
 }
 
 /**
@@ -339,10 +386,25 @@ map<Key, Type>::insert(const value_type &element_to_insert) {
  * @param value Значение элемента, которое необходимо вставить.
  * @return Пара, содержащая итератор на элемент и флаг успешности вставки.
  */
-template <typename Key, typename Type>
-std::pair<typename map<Key, Type>::iterator, bool>
-map<Key, Type>::insert(const key_type &key, const mapped_type &value) {
-  return tree_->InsertUnique(value_type{key, value});
+template <typename Key, typename Type, typename Options>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::insert(const key_type &key, const mapped_type &value) {
+  return tree_.TryConstruct(KeyProbe{key}, key, value);
+}
+
+/**
+ * @brief Вставляет элемент, перемещая ключ и значение прямо в новый узел.
+ *
+ * Если ключ уже есть, аргументы остаются нетронутыми.
+ *
+ * @param key Ключ элемента.
+ * @param value Значение элемента.
+ * @return Пара, содержащая итератор на элемент и флаг успешности вставки.
+ */
+template <typename Key, typename Type, typename Options>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::insert(key_type &&key, mapped_type &&value) {
+  return tree_.TryConstruct(KeyProbe{key}, std::move(key), std::move(value));
 }
 /**
  * @brief Вставляет элемент или обновляет значение элемента в карте.
@@ -356,14 +418,63 @@ map<Key, Type>::insert(const key_type &key, const mapped_type &value) {
  * @param value Значение элемента, которое необходимо вставить или установить.
  * @return Пара, содержащая итератор на элемент и флаг успешности операции.
  */
-template <typename Key, typename Type>
-std::pair<typename map<Key, Type>::iterator, bool>
-map<Key, Type>::insert_or_assign(const key_type &key,
-                                 const mapped_type &value) {
-  auto [it, inserted] = tree_->InsertUnique(value_type{key, value});
+template <typename Key, typename Type, typename Options>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::insert_or_assign(const key_type &key,
+                                          const mapped_type &value) {
+  return InsertOrAssign(key, value);
+}
+
+/**
+ * @brief Вставляет элемент или перемещением присваивает новое значение.
+ *
+ * У существующего элемента меняется только значение (перемещающим
+ * присваиванием), ключ не копируется.
+ *
+ * @param key Ключ элемента.
+ * @param value Значение, перемещаемое в элемент.
+ * @return Пара, содержащая итератор на элемент и флаг вставки.
+ */
+template <typename Key, typename Type, typename Options>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::insert_or_assign(const key_type &key,
+                                          mapped_type &&value) {
+  return InsertOrAssign(key, std::move(value));
+}
+
+/**
+ * @brief Вставляет элемент, перемещая ключ и значение, или перемещением
+ * присваивает значение существующему элементу (ключ тогда не трогается).
+ *
+ * @param key Ключ элемента.
+ * @param value Значение, перемещаемое в элемент.
+ * @return Пара, содержащая итератор на элемент и флаг вставки.
+ */
+template <typename Key, typename Type, typename Options>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::insert_or_assign(key_type &&key, mapped_type &&value) {
+  return InsertOrAssign(std::move(key), std::move(value));
+}
+
+/**
+ * @brief Общая часть insert_or_assign: один спуск по ключу, затем либо
+ * создание пары в новом узле, либо присваивание значения найденному
+ * элементу с пересчетом агрегатов.
+ *
+ * @param key Ключ элемента (ссылка с сохраненной категорией значения).
+ * @param value Значение элемента (ссылка с сохраненной категорией значения).
+ * @return Пара, содержащая итератор на элемент и флаг вставки.
+ */
+template <typename Key, typename Type, typename Options>
+template <typename K, typename M>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::InsertOrAssign(K &&key, M &&value) {
+  auto [it, inserted] = tree_.TryConstruct(
+      KeyProbe{key}, std::forward<K>(key), std::forward<M>(value));
 
   if (!inserted) {
-    (*it).second = value;
+    (*it).second = std::forward<M>(value);
+    tree_.UpdateAggregates(it);
   }
 
   return {it, inserted};
@@ -376,9 +487,104 @@ map<Key, Type>::insert_or_assign(const key_type &key,
  *
  * @param pos Итератор, указывающий на элемент, который необходимо удалить.
  */
-template <typename Key, typename Type>
-void map<Key, Type>::erase(iterator pos) noexcept {
-  tree_->Erase(pos);
+template <typename Key, typename Type, typename Options>
+void map<Key, Type, Options>::erase(iterator pos) noexcept {
+  tree_.Erase(pos);
+}
+
+/**
+ * @brief Удаляет из карты элементы диапазона [first, last).
+ *
+ * Диапазон вырезается из дерева целиком за O(k + log n), без поочередного
+ * удаления и балансировки для каждого из k элементов.
+ *
+ * @param first Итератор на первый удаляемый элемент.
+ * @param last Итератор на элемент, следующий за последним удаляемым.
+ * @return Итератор на элемент, на который указывал last.
+ */
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::iterator
+map<Key, Type, Options>::erase(iterator first, iterator last) noexcept {
+  return tree_.Erase(first, last);
+}
+
+/**
+ * @brief Удаляет из карты все элементы с ключами из полуинтервала [lo, hi).
+ *
+ * Удобно для вытеснения устаревших ключей, упорядоченных по времени: весь
+ * диапазон удаляется за O(k + log n).
+ *
+ * @param lo Нижняя граница ключей (включительно).
+ * @param hi Верхняя граница ключей (не включительно).
+ * @return Количество удаленных элементов.
+ */
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::size_type
+map<Key, Type, Options>::erase(const key_type &lo, const key_type &hi) {
+  if (!(lo < hi)) {
+    return 0;
+  }
+  size_type old_size = size();
+  tree_.Erase(tree_.LowerBound(KeyProbe{lo}), tree_.LowerBound(KeyProbe{hi}));
+  return old_size - size();
+}
+
+/**
+ * @brief Удаляет из карты все элементы, для которых предикат вернул true.
+ *
+ * Предикат получает пару ключ-значение. Оставшиеся элементы перестраиваются
+ * в сбалансированное дерево один раз за O(n).
+ *
+ * @tparam Predicate Унарный предикат от const value_type &.
+ * @param pred Предикат, отбирающий удаляемые элементы.
+ * @return Количество удаленных элементов.
+ */
+template <typename Key, typename Type, typename Options>
+template <typename Predicate>
+typename map<Key, Type, Options>::size_type
+map<Key, Type, Options>::erase_if(Predicate pred) {
+  return tree_.EraseIf(pred);
+}
+
+/**
+ * @brief Извлекает элемент из карты вместе с его узлом.
+ *
+ * Узел не освобождается: через дескриптор можно изменить ключ и значение, а
+ * затем вставить узел в эту или другую карту того же типа без выделения
+ * памяти и копирования элемента.
+ *
+ * @param pos Итератор на извлекаемый элемент.
+ * @return Дескриптор узла; пустой, если pos == end().
+ */
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::node_type
+map<Key, Type, Options>::extract(iterator pos) noexcept {
+  return tree_.Extract(pos);
+}
+
+/**
+ * @brief Извлекает из карты элемент с заданным ключом вместе с его узлом.
+ *
+ * @param key Ключ извлекаемого элемента.
+ * @return Дескриптор узла; пустой, если ключ не найден.
+ */
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::node_type
+map<Key, Type, Options>::extract(const key_type &key) {
+  return tree_.Extract(find(key));
+}
+
+/**
+ * @brief Вставляет в карту узел из дескриптора, если ключа в карте еще нет.
+ *
+ * @param node Дескриптор узла, полученный из extract().
+ * @return Позиция элемента с ключом узла, флаг вставки и дескриптор: пустой
+ * при успехе, исходный узел - если ключ уже был в карте.
+ */
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::insert_return_type
+map<Key, Type, Options>::insert(node_type &&node) {
+  return tree_.InsertUnique(std::move(node));
 }
 
 /**
@@ -388,9 +594,9 @@ void map<Key, Type>::erase(iterator pos) noexcept {
  *
  * @param other Карта, с которой необходимо обменять содержимое.
  */
-template <typename Key, typename Type>
-void map<Key, Type>::swap(map &other) noexcept {
-  tree_->Swap(*other.tree_);
+template <typename Key, typename Type, typename Options>
+void map<Key, Type, Options>::swap(map &other) noexcept {
+  tree_.Swap(other.tree_);
 }
 
 /**
@@ -401,29 +607,77 @@ void map<Key, Type>::swap(map &other) noexcept {
  *
  * @param other Карта, с которой необходимо объединить текущую карту.
  */
-template <typename Key, typename Type>
-void map<Key, Type>::merge(map &other) noexcept {
-  tree_->MergeUnique(*other.tree_);
+template <typename Key, typename Type, typename Options>
+void map<Key, Type, Options>::merge(map &other) noexcept {
+  tree_.MergeUnique(other.tree_);
+}
+/**
+ * @brief Добавляет элементы otherMap с ключами, которых нет в карте, за
+ * O(n + m).
+ *
+ * @param otherMap Вторая карта.
+ * @return Ссылка на текущую карту.
+ */
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options> &
+map<Key, Type, Options>::operator|=(const map &otherMap) {
+  tree_.CombineWith(otherMap.tree_, SetOperation::kUnion);
+  return *this;
+}
+
+/**
+ * @brief Оставляет только элементы с ключами, которые есть в otherMap.
+ *
+ * @param otherMap Вторая карта.
+ * @return Ссылка на текущую карту.
+ */
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options> &
+map<Key, Type, Options>::operator&=(const map &otherMap) {
+  tree_.CombineWith(otherMap.tree_, SetOperation::kIntersection);
+  return *this;
+}
+
+/**
+ * @brief Удаляет элементы с ключами, которые есть в otherMap.
+ *
+ * @param otherMap Вторая карта.
+ * @return Ссылка на текущую карту.
+ */
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options> &
+map<Key, Type, Options>::operator-=(const map &otherMap) {
+  tree_.CombineWith(otherMap.tree_, SetOperation::kDifference);
+  return *this;
 }
+
+/**
+ * @brief Оставляет элементы с ключами ровно из одной из карт.
+ *
+ * @param otherMap Вторая карта.
+ * @return Ссылка на текущую карту.
+ */
+template <typename Key, typename Type, typename Options>
+map<Key, Type, Options> &
+map<Key, Type, Options>::operator^=(const map &otherMap) {
+  tree_.CombineWith(otherMap.tree_, SetOperation::kSymmetricDifference);
+  return *this;
+}
+
 /**
  * @brief Проверяет наличие элемента по ключу в карте.
  *
  * Этот метод позволяет проверить, существует ли элемент в карте с заданным
- * ключом. Он создает временную пару ключ-значение и использует внутренний метод
- * поиска дерева, чтобы определить, существует ли такой элемент в карте.
+ * ключом. Поиск идет по самому ключу (KeyProbe), без временной пары, поэтому
+ * не требует конструктора значения по умолчанию и не копирует ключ.
  *
  * @param key Ключ, который нужно проверить на наличие в карте.
  * @return true, если элемент с данным ключом существует, иначе false.
  */
-template <typename Key, typename Type>
-bool map<Key, Type>::contains(const key_type &key) const noexcept {
-  // Создаем временную пару ключ-значение с заданным ключом и пустым значением
-  value_type keyValuePair(key, mapped_type{});
-  // Используем метод поиска дерева, чтобы найти пару в карте
-  // Если пара найдена, значит, элемент с данным ключом существует
-  // Возвращаем результат сравнения с итератором, указывающим за конец
-  // контейнера
-  return tree_->Find(keyValuePair) != end();
+template <typename Key, typename Type, typename Options>
+bool map<Key, Type, Options>::contains(const key_type &key) const noexcept {
+  // Если пара с таким ключом найдена, элемент существует
+  return tree_.Find(KeyProbe{key}) != end();
 }
 /**
  * @brief Вставляет элемент в карту, используя перемещение аргументов.
@@ -440,25 +694,49 @@ bool map<Key, Type>::contains(const key_type &key) const noexcept {
  * @return Пара, содержащая итератор на вставленный элемент и флаг успешности
  * вставки.
  */
-template <typename Key, typename Type>
+template <typename Key, typename Type, typename Options>
 template <typename... Args>
-std::pair<typename map<Key, Type>::iterator, bool>
-map<Key, Type>::emplace(Args &&...args) {
-  // Создаем новый элемент (ключ-значение) из переданных аргументов
-  value_type newEntry{std::forward<Args>(args)...};
-
-  // Ищем существующий элемент с таким же ключом
-  iterator existingEntry = find(newEntry.first);
-
-  if (existingEntry == end()) {
-    // Если элемент с данным ключом не найден, выполняем вставку
-    auto insertResult = tree_->InsertUnique(newEntry);
-    return std::make_pair(insertResult.first, insertResult.second);
-  } else {
-    // Если элемент с данным ключом уже существует, возвращаем итератор на него
-    // и флаг false
-    return std::make_pair(existingEntry, false);
-  }
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::emplace(Args &&...args) {
+  // Пара строится прямо в узле; при дубликате узел удаляется
+  return tree_.ConstructUnique(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Создает элемент из ключа и аргументов конструктора значения, если
+ * ключа еще нет.
+ *
+ * В отличие от emplace, ключ известен заранее: если он уже есть, узел не
+ * создается и аргументы остаются нетронутыми.
+ *
+ * @param key Ключ элемента.
+ * @param args Аргументы конструктора значения.
+ * @return Пара, содержащая итератор на элемент и флаг вставки.
+ */
+template <typename Key, typename Type, typename Options>
+template <typename... Args>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::try_emplace(const key_type &key, Args &&...args) {
+  return tree_.TryConstruct(
+      KeyProbe{key}, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Создает элемент, перемещая ключ, если такого ключа еще нет.
+ *
+ * @param key Ключ элемента.
+ * @param args Аргументы конструктора значения.
+ * @return Пара, содержащая итератор на элемент и флаг вставки.
+ */
+template <typename Key, typename Type, typename Options>
+template <typename... Args>
+std::pair<typename map<Key, Type, Options>::iterator, bool>
+map<Key, Type, Options>::try_emplace(key_type &&key, Args &&...args) {
+  return tree_.TryConstruct(
+      KeyProbe{key}, std::piecewise_construct,
+      std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
 }
 
 /**
@@ -472,9 +750,9 @@ map<Key, Type>::emplace(Args &&...args) {
  * @param first Итератор, указывающий на начало диапазона элементов для вставки.
  * @param last Итератор, указывающий на конец диапазона элементов для вставки.
  */
-template <typename Key, typename Type>
+template <typename Key, typename Type, typename Options>
 template <typename InputIt>
-void map<Key, Type>::insert_many(InputIt first, InputIt last) {
+void map<Key, Type, Options>::insert_many(InputIt first, InputIt last) {
   // Проходим по диапазону элементов, вызывая метод вставки для каждого элемента
   for (; first != last; ++first) {
     insert(*first);
@@ -484,42 +762,36 @@ void map<Key, Type>::insert_many(InputIt first, InputIt last) {
  * @brief Находит элемент по ключу в карте.
  *
  * Этот метод позволяет найти элемент в карте по заданному ключу.
- * Создается временная пара ключ-значение с заданным ключом и пустым значением,
- * которая используется для выполнения поиска через внутренний метод дерева.
+ * Дерево сравнивает с ключами узлов саму ссылку на ключ (KeyProbe), так что
+ * временная пара со значением по умолчанию не создается.
  *
  * @param key Ключ, по которому нужно найти элемент.
  * @return Итератор на найденный элемент, либо итератор, указывающий за конец,
  * если элемент не найден.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::iterator
-map<Key, Type>::find(const key_type &key) noexcept {
-  // Создаем временную пару ключ-значение с заданным ключом и пустым значением
-  value_type temporary_entry(key, mapped_type{});
-
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::iterator
+map<Key, Type, Options>::find(const key_type &key) noexcept {
   // Используем метод поиска дерева для выполнения поиска элемента
-  return tree_->Find(temporary_entry);
+  return tree_.Find(KeyProbe{key});
 }
 
 /**
  * @brief Находит константный элемент по ключу в карте.
  *
  * Этот метод позволяет найти константный элемент в карте по заданному ключу.
- * Создается временная пара ключ-значение с заданным ключом и пустым значением,
- * которая используется для выполнения поиска через внутренний метод дерева.
+ * Дерево сравнивает с ключами узлов саму ссылку на ключ (KeyProbe), так что
+ * временная пара со значением по умолчанию не создается.
  *
  * @param key Ключ, по которому нужно найти константный элемент.
  * @return Константный итератор на найденный элемент, либо константный итератор,
  *         указывающий за конец, если элемент не найден.
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::const_iterator
-map<Key, Type>::find(const key_type &key) const noexcept {
-  // Создаем временную пару ключ-значение с заданным ключом и пустым значением
-  value_type temporary_entry(key, mapped_type{});
-
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::const_iterator
+map<Key, Type, Options>::find(const key_type &key) const noexcept {
   // Используем метод поиска дерева для выполнения поиска константного элемента
-  return tree_->Find(temporary_entry);
+  return tree_.Find(KeyProbe{key});
 }
 
 /**
@@ -532,12 +804,98 @@ map<Key, Type>::find(const key_type &key) const noexcept {
  * @param key Ключ, для которого нужно подсчитать количество элементов.
  * @return Количество элементов с заданным ключом (0 или 1).
  */
-template <typename Key, typename Type>
-typename map<Key, Type>::size_type
-map<Key, Type>::count(const key_type &key) const noexcept {
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::size_type
+map<Key, Type, Options>::count(const key_type &key) const noexcept {
   // Используем метод поиска для определения наличия элемента с заданным ключом
   // Возвращаем 1, если элемент найден, и 0 в противном случае
   return find(key) != end() ? 1 : 0;
 }
 
+/**
+ * @brief Сворачивает значения с ключами из полуинтервала [lo, hi) агрегатом
+ * Options::aggregate за O(log n). Границы те же, что у erase(lo, hi).
+ *
+ * @param lo Нижняя граница ключей (включительно).
+ * @param hi Верхняя граница ключей (не включается).
+ * @return Агрегат значений полуинтервала; нейтральный элемент, если он пуст.
+ */
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::aggregate_type
+map<Key, Type, Options>::aggregate(const key_type &lo,
+                                   const key_type &hi) const {
+  return tree_.Aggregate(KeyProbe{lo}, KeyProbe{hi});
+}
+
+/**
+ * @brief Изменяет значение элемента на месте и обновляет агрегаты.
+ *
+ * @param pos Итератор на изменяемый элемент.
+ * @param modify Функция, получающая ссылку на значение (mapped_type &).
+ */
+template <typename Key, typename Type, typename Options>
+template <typename Function>
+void map<Key, Type, Options>::update(iterator pos, Function modify) {
+  modify((*pos).second);
+  tree_.UpdateAggregates(pos);
+}
+
+/**
+ * @brief Возвращает снимок счетчиков горячего пути карты.
+ *
+ * Счетчики ведутся внутренним деревом только при Options::stats (например,
+ * s21::map<Key, Type, StatsTreeOptions>); иначе все значения нулевые.
+ *
+ * @return Значения счетчиков на момент вызова.
+ */
+template <typename Key, typename Type, typename Options>
+ContainerStats map<Key, Type, Options>::stats() const noexcept {
+  return tree_.Stats();
+}
+
+/**
+ * @brief Обнуляет счетчики горячего пути карты.
+ */
+template <typename Key, typename Type, typename Options>
+void map<Key, Type, Options>::reset_stats() noexcept {
+  tree_.ResetStats();
+}
+
+/**
+ * @brief Подсчитывает память, занятую картой: сам объект со встроенным
+ * деревом и узлы дерева (см. RedBlackTree::MemoryUsage).
+ *
+ * @return Число байт.
+ */
+template <typename Key, typename Type, typename Options>
+typename map<Key, Type, Options>::size_type
+map<Key, Type, Options>::memory_usage() const {
+  return sizeof(*this) - sizeof(tree_type) + tree_.MemoryUsage();
+}
+
+/**
+ * @brief Переносит все узлы карты в один непрерывный блок (см.
+ * RedBlackTree::Compact).
+ *
+ * @param order Порядок узлов в памяти.
+ */
+template <typename Key, typename Type, typename Options>
+void map<Key, Type, Options>::compact(CompactOrder order) {
+  tree_.Compact(order);
+}
+
+/**
+ * @brief Переносит в общий блок очередную порцию узлов карты (см.
+ * RedBlackTree::CompactStep).
+ *
+ * @param max_nodes Наибольшее число узлов, переносимых за вызов.
+ * @param order Порядок узлов в памяти для нового прохода.
+ * @return true, если проход уплотнения закончен.
+ */
+template <typename Key, typename Type, typename Options>
+bool map<Key, Type, Options>::compact_step(size_type max_nodes,
+                                           CompactOrder order) {
+  return tree_.CompactStep(max_nodes, order);
+}
+
 } // namespace s21
@@ -0,0 +1,170 @@
+// Сравнение s21::priority_queue (d-арная куча) и
+// s21::addressable_priority_queue с s21::set, используемым как очередь с
+// приоритетом (вставка и удаление begin()). События планировщика - пары
+// (время, номер), ближайшее время в вершине.
+//
+//   hold       - модель "удержания": очередь из n событий, шаг извлекает
+//                ближайшее и планирует новое чуть позже;
+//   build      - построение из n событий: вставки по одному и assign за O(n);
+//   reschedule - перенос случайных событий на более раннее время
+//                (decrease_key против erase + insert в множестве).
+//
+// Сборка: g++ -std=c++17 -O2 priority_queue_bench.cpp -o priority_queue_bench
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../set/s21_set.h"
+#include "s21_addressable_priority_queue.h"
+#include "s21_priority_queue.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Event = std::pair<long, unsigned>;
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+std::vector<Event> MakeEvents(std::size_t count, std::mt19937 &gen) {
+  std::vector<Event> events;
+  for (std::size_t i = 0; i < count; ++i) {
+    events.emplace_back(static_cast<long>(gen() % 1000000000),
+                        static_cast<unsigned>(i));
+  }
+  return events;
+}
+
+template <std::size_t Arity>
+double HoldHeap(const std::vector<Event> &events,
+                const std::vector<long> &delays, long &checksum) {
+  s21::priority_queue<Event, std::greater<Event>, Arity> queue(events.begin(),
+                                                               events.end());
+  unsigned next_id = static_cast<unsigned>(events.size());
+  const auto start = Clock::now();
+  for (long delay : delays) {
+    const Event event = queue.top();
+    queue.pop();
+    checksum += event.first;
+    queue.push(Event(event.first + delay, next_id++));
+  }
+  return Milliseconds(start);
+}
+
+double HoldSet(const std::vector<Event> &events,
+               const std::vector<long> &delays, long &checksum) {
+  s21::set<Event> queue;
+  for (const Event &event : events) {
+    queue.insert(event);
+  }
+  unsigned next_id = static_cast<unsigned>(events.size());
+  const auto start = Clock::now();
+  for (long delay : delays) {
+    const Event event = *queue.begin();
+    queue.erase(queue.begin());
+    checksum += event.first;
+    queue.insert(Event(event.first + delay, next_id++));
+  }
+  return Milliseconds(start);
+}
+
+void Hold(std::size_t count, std::mt19937 &gen) {
+  const std::vector<Event> events = MakeEvents(count, gen);
+  std::vector<long> delays(2000000);
+  for (long &delay : delays) {
+    delay = static_cast<long>(gen() % 1000000);
+  }
+  long sums[4] = {0, 0, 0, 0};
+  const double set_ms = HoldSet(events, delays, sums[0]);
+  const double heap2_ms = HoldHeap<2>(events, delays, sums[1]);
+  const double heap4_ms = HoldHeap<4>(events, delays, sums[2]);
+  const double heap8_ms = HoldHeap<8>(events, delays, sums[3]);
+  const double ops = static_cast<double>(delays.size());
+  std::printf("  hold n=%-8zu set %6.1f  d=2 %6.1f  d=4 %6.1f  d=8 %6.1f"
+              " ns/op%s\n",
+              count, set_ms * 1e6 / ops, heap2_ms * 1e6 / ops,
+              heap4_ms * 1e6 / ops, heap8_ms * 1e6 / ops,
+              sums[0] == sums[1] && sums[1] == sums[2] && sums[2] == sums[3]
+                  ? ""
+                  : "  (checksum mismatch)");
+}
+
+void Build(std::size_t count, std::mt19937 &gen) {
+  const std::vector<Event> events = MakeEvents(count, gen);
+  auto start = Clock::now();
+  s21::set<Event> set;
+  for (const Event &event : events) {
+    set.insert(event);
+  }
+  const double set_ms = Milliseconds(start);
+  start = Clock::now();
+  s21::priority_queue<Event, std::greater<Event>> pushed;
+  for (const Event &event : events) {
+    pushed.push(event);
+  }
+  const double push_ms = Milliseconds(start);
+  start = Clock::now();
+  s21::priority_queue<Event, std::greater<Event>> built(events.begin(),
+                                                        events.end());
+  const double assign_ms = Milliseconds(start);
+  std::printf("  build n=%-7zu set %7.2f ms  push loop %7.2f ms"
+              "  assign %7.2f ms  (tops %d)\n",
+              count, set_ms, push_ms, assign_ms,
+              built.top() == pushed.top() && pushed.top() == *set.begin());
+}
+
+void Reschedule(std::size_t count, std::mt19937 &gen) {
+  const std::vector<Event> events = MakeEvents(count, gen);
+  std::vector<std::size_t> picks(1000000);
+  for (std::size_t &pick : picks) {
+    pick = gen() % count;
+  }
+
+  s21::addressable_priority_queue<Event, std::greater<Event>> queue;
+  std::vector<decltype(queue)::handle> handles =
+      queue.assign(events.begin(), events.end());
+  auto start = Clock::now();
+  for (std::size_t pick : picks) {
+    Event event = queue.value(handles[pick]);
+    event.first -= event.first / 8;
+    queue.decrease_key(handles[pick], event);
+  }
+  const double heap_ms = Milliseconds(start);
+
+  s21::set<Event> set;
+  std::vector<Event> current = events;
+  for (const Event &event : events) {
+    set.insert(event);
+  }
+  start = Clock::now();
+  for (std::size_t pick : picks) {
+    set.erase(set.find(current[pick]));
+    current[pick].first -= current[pick].first / 8;
+    set.insert(current[pick]);
+  }
+  const double set_ms = Milliseconds(start);
+  std::printf("  reschedule n=%-7zu set %6.1f ns/op  decrease_key %6.1f"
+              " ns/op  (tops %d)\n",
+              count, set_ms * 1e6 / picks.size(), heap_ms * 1e6 / picks.size(),
+              queue.top() == *set.begin());
+}
+} // namespace
+
+int main() {
+  std::mt19937 gen(2024);
+  for (std::size_t count : {1000UL, 100000UL, 1000000UL}) {
+    Hold(count, gen);
+  }
+  for (std::size_t count : {100000UL, 1000000UL}) {
+    Build(count, gen);
+  }
+  for (std::size_t count : {100000UL, 1000000UL}) {
+    Reschedule(count, gen);
+  }
+  return 0;
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "s21_addressable_priority_queue.h"
+#include "s21_priority_queue.h"
+
+namespace s21 {
+namespace {
+template <typename Queue> std::vector<int> Drain(Queue &queue) {
+  std::vector<int> result;
+  while (!queue.empty()) {
+    result.push_back(queue.top());
+    queue.pop();
+  }
+  return result;
+}
+
+template <std::size_t Arity> void CheckAgainstStd(unsigned seed) {
+  s21::priority_queue<int, std::less<int>, Arity> queue;
+  std::priority_queue<int> ref;
+  std::mt19937 gen(seed);
+  for (int step = 0; step < 5000; ++step) {
+    if (gen() % 3 == 0) {
+      queue.pop();
+      if (!ref.empty()) {
+        ref.pop();
+      }
+    } else {
+      const int value = static_cast<int>(gen() % 1000);
+      queue.push(value);
+      ref.push(value);
+    }
+    ASSERT_EQ(queue.size(), ref.size());
+    if (!ref.empty()) {
+      ASSERT_EQ(queue.top(), ref.top());
+    }
+  }
+}
+
+// Число, копирование которого бросает исключение по счетчику.
+struct FragileInt {
+  FragileInt(int value) : value_(value) {}
+  FragileInt(const FragileInt &other) : value_(other.value_) {
+    if (copies_left_ >= 0 && copies_left_-- == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  FragileInt &operator=(const FragileInt &) = default;
+
+  bool operator<(const FragileInt &other) const {
+    return value_ < other.value_;
+  }
+
+  int value_;
+  static inline int copies_left_ = -1;
+};
+} // namespace
+
+TEST(PriorityQueueTest, MatchesStdForEveryArity) {
+  CheckAgainstStd<2>(1);
+  CheckAgainstStd<3>(2);
+  CheckAgainstStd<4>(3);
+  CheckAgainstStd<8>(4);
+}
+
+TEST(PriorityQueueTest, BulkBuildAndMinHeap) {
+  std::vector<int> values(1000);
+  std::mt19937 gen(5);
+  for (int &value : values) {
+    value = static_cast<int>(gen() % 500);
+  }
+  s21::priority_queue<int, std::greater<int>> queue(values.begin(),
+                                                    values.end());
+  EXPECT_EQ(queue.size(), values.size());
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(Drain(queue), values);
+  EXPECT_THROW(queue.top(), std::out_of_range);
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+
+  s21::priority_queue<std::string> strings{"b", "d", "a"};
+  strings.emplace(3, 'c');
+  EXPECT_EQ(strings.top(), "d");
+  strings.pop();
+  EXPECT_EQ(strings.top(), "ccc");
+  s21::priority_queue<std::string> other;
+  other.swap(strings);
+  EXPECT_TRUE(strings.empty());
+  EXPECT_EQ(other.size(), 3U);
+}
+
+TEST(PriorityQueueTest, AddressableMatchesMultiset) {
+  // Очередь минимумов, как в алгоритме Дейкстры
+  using Queue = s21::addressable_priority_queue<int, std::greater<int>>;
+  Queue queue;
+  std::multiset<int> ref;
+  std::vector<Queue::handle> handles;
+  std::mt19937 gen(6);
+  for (int step = 0; step < 20000; ++step) {
+    const unsigned op = gen() % 6;
+    if (op < 2 || handles.empty()) {
+      const int value = static_cast<int>(gen() % 10000);
+      handles.push_back(queue.push(value));
+      ref.insert(value);
+    } else {
+      const std::size_t pick = gen() % handles.size();
+      const Queue::handle handle = handles[pick];
+      const int old = queue.value(handle);
+      if (op != 5) {
+        ref.erase(ref.find(old));
+      }
+      if (op == 2) {
+        queue.erase(handle);
+        handles[pick] = handles.back();
+        handles.pop_back();
+      } else if (op == 3) {
+        const int value = old - static_cast<int>(gen() % 100);
+        queue.decrease_key(handle, value);
+        ref.insert(value);
+      } else if (op == 4) {
+        const int value = static_cast<int>(gen() % 10000);
+        queue.update(handle, value);
+        ref.insert(value);
+      } else {
+        const Queue::handle top = queue.top_handle();
+        EXPECT_EQ(queue.value(top), *ref.begin());
+        ref.erase(ref.begin());
+        queue.pop();
+        handles.erase(std::find(handles.begin(), handles.end(), top));
+      }
+    }
+    ASSERT_EQ(queue.size(), ref.size());
+    if (!ref.empty()) {
+      ASSERT_EQ(queue.top(), *ref.begin());
+    }
+  }
+  // Описатели выживших элементов по-прежнему указывают на свои значения
+  std::multiset<int> values;
+  for (Queue::handle handle : handles) {
+    values.insert(queue.value(handle));
+  }
+  EXPECT_EQ(values, ref);
+}
+
+TEST(PriorityQueueTest, AddressableBulkAssign) {
+  std::vector<int> values{5, 1, 9, 3, 7, 2, 8};
+  s21::addressable_priority_queue<int> queue;
+  queue.push(100);
+  auto handles = queue.assign(values.begin(), values.end());
+  ASSERT_EQ(handles.size(), values.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(queue.value(handles[i]), values[i]);
+  }
+  queue.update(handles[1], 10);
+  EXPECT_EQ(queue.top_handle(), handles[1]);
+  queue.erase(handles[2]);
+  EXPECT_EQ(Drain(queue), (std::vector<int>{10, 8, 7, 5, 3, 2}));
+  EXPECT_THROW(queue.top_handle(), std::out_of_range);
+}
+
+TEST(PriorityQueueTest, AddressableFailedAssignKeepsQueue) {
+  s21::addressable_priority_queue<FragileInt> queue;
+  const auto first = queue.push(FragileInt(4));
+  const auto second = queue.push(FragileInt(6));
+  queue.pop();
+  const std::vector<FragileInt> values{FragileInt(1), FragileInt(3),
+                                       FragileInt(2)};
+  FragileInt::copies_left_ = 1;
+  EXPECT_THROW(queue.assign(values.begin(), values.end()),
+               std::runtime_error);
+  FragileInt::copies_left_ = -1;
+  ASSERT_EQ(queue.size(), 1U);
+  EXPECT_EQ(queue.value(first).value_, 4);
+  // Освобожденный описатель переиспользуется, а не совпадает с живым.
+  const auto third = queue.push(FragileInt(5));
+  EXPECT_EQ(third, second);
+  queue.update(first, FragileInt(7));
+  EXPECT_EQ(queue.top_handle(), first);
+  queue.erase(first);
+  EXPECT_EQ(queue.top().value_, 5);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
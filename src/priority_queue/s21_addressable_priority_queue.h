@@ -0,0 +1,123 @@
+#ifndef S21_CONTAINERS_PRIORITY_QUEUE_S21_ADDRESSABLE_PRIORITY_QUEUE_H_
+#define S21_CONTAINERS_PRIORITY_QUEUE_S21_ADDRESSABLE_PRIORITY_QUEUE_H_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_heap_algorithms.h"
+
+namespace s21 {
+
+// Очередь с приоритетом, элементы которой доступны по описателям (handle):
+// push возвращает описатель, который остается действительным, пока элемент
+// в очереди, как бы ни перестраивалась куча. По описателю можно прочитать
+// элемент, изменить его приоритет или удалить элемент за O(log n) - как
+// нужно, например, алгоритму Дейкстры и планировщикам с отменой задач.
+//
+// Куча - тот же непрерывный d-арный массив, что у priority_queue; рядом с
+// элементом лежит номер его описателя, а таблица описателей хранит позицию
+// элемента в куче. Номера удаленных элементов переиспользуются, поэтому
+// описатель после pop или erase своего элемента недействителен.
+template <typename T, typename Compare = std::less<T>, std::size_t Arity = 4>
+class addressable_priority_queue {
+public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using value_compare = Compare;
+
+  class handle {
+  public:
+    handle() noexcept = default;
+
+    bool operator==(const handle &other) const noexcept {
+      return id_ == other.id_;
+    }
+    bool operator!=(const handle &other) const noexcept {
+      return id_ != other.id_;
+    }
+
+  private:
+    friend class addressable_priority_queue;
+
+    explicit handle(size_type id) noexcept : id_(id) {}
+
+    size_type id_ = static_cast<size_type>(-1);
+  };
+
+  // Конструкторы
+  addressable_priority_queue() = default;
+  explicit addressable_priority_queue(const Compare &compare);
+
+  // Доступ к элементам
+  const_reference top() const;
+  handle top_handle() const;
+  const_reference value(handle position) const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+  void reserve(size_type count);
+
+  // Модификаторы
+  handle push(const value_type &value);
+  handle push(value_type &&value);
+  void pop();
+  template <typename InputIt>
+  std::vector<handle> assign(InputIt first, InputIt last);
+  void update(handle position, const value_type &value);
+  void decrease_key(handle position, const value_type &value);
+  void erase(handle position);
+  void clear() noexcept;
+  void swap(addressable_priority_queue &other) noexcept;
+
+private:
+  using Algorithms = DAryHeapAlgorithms<Arity>;
+
+  struct Entry {
+    value_type value_;
+    size_type id_;
+  };
+
+  // Порядок записей кучи по их значениям.
+  struct EntryLess {
+    bool operator()(const Entry &lhs, const Entry &rhs) {
+      return (*compare_)(lhs.value_, rhs.value_);
+    }
+
+    Compare *compare_;
+  };
+
+  // Записывает в таблицу описателей новую позицию элемента.
+  struct TrackPlacement {
+    void operator()(size_type index) const noexcept {
+      (*positions_)[(*heap_)[index].id_] = index;
+    }
+
+    const std::vector<Entry> *heap_;
+    std::vector<size_type> *positions_;
+  };
+
+  size_type AcquireId();
+  handle PushEntry(Entry &&entry);
+  void SiftUp(size_type index);
+  void SiftDown(size_type index);
+  void RemoveAt(size_type index);
+
+  std::vector<Entry> heap_;
+  // Позиция в heap_ по номеру описателя
+  std::vector<size_type> positions_;
+  // Номера описателей удаленных элементов
+  std::vector<size_type> free_ids_;
+  Compare compare_;
+};
+
+} // namespace s21
+
+#include "s21_addressable_priority_queue.tpp"
+#endif // S21_CONTAINERS_PRIORITY_QUEUE_S21_ADDRESSABLE_PRIORITY_QUEUE_H_
@@ -0,0 +1,326 @@
+#include "s21_addressable_priority_queue.h"
+
+namespace s21 {
+
+/**
+ * @brief Создает пустую очередь с заданным порядком.
+ *
+ * @param compare Порядок элементов.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+addressable_priority_queue<T, Compare, Arity>::addressable_priority_queue(
+    const Compare &compare)
+    : compare_(compare) {}
+
+/**
+ * @brief Возвращает элемент с наибольшим приоритетом.
+ *
+ * @return Константная ссылка на вершину кучи.
+ * @throw std::out_of_range Если очередь пуста.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename addressable_priority_queue<T, Compare, Arity>::const_reference
+addressable_priority_queue<T, Compare, Arity>::top() const {
+  if (heap_.empty()) {
+    throw std::out_of_range(
+        "s21::addressable_priority_queue::top: Очередь пуста.");
+  }
+  return heap_.front().value_;
+}
+
+/**
+ * @brief Возвращает описатель элемента с наибольшим приоритетом.
+ *
+ * @return Описатель вершины кучи.
+ * @throw std::out_of_range Если очередь пуста.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename addressable_priority_queue<T, Compare, Arity>::handle
+addressable_priority_queue<T, Compare, Arity>::top_handle() const {
+  if (heap_.empty()) {
+    throw std::out_of_range(
+        "s21::addressable_priority_queue::top_handle: Очередь пуста.");
+  }
+  return handle(heap_.front().id_);
+}
+
+/**
+ * @brief Возвращает элемент по описателю за O(1).
+ *
+ * @param position Описатель элемента из очереди.
+ * @return Константная ссылка на элемент.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename addressable_priority_queue<T, Compare, Arity>::const_reference
+addressable_priority_queue<T, Compare, Arity>::value(
+    handle position) const noexcept {
+  return heap_[positions_[position.id_]].value_;
+}
+
+/**
+ * @brief Проверяет, пуста ли очередь.
+ *
+ * @return true, если элементов нет.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+bool addressable_priority_queue<T, Compare, Arity>::empty() const noexcept {
+  return heap_.empty();
+}
+
+/**
+ * @brief Возвращает количество элементов.
+ *
+ * @return Количество элементов.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename addressable_priority_queue<T, Compare, Arity>::size_type
+addressable_priority_queue<T, Compare, Arity>::size() const noexcept {
+  return heap_.size();
+}
+
+/**
+ * @brief Резервирует место под count элементов и их описатели.
+ *
+ * @param count Ожидаемое число элементов.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::reserve(size_type count) {
+  heap_.reserve(count);
+  positions_.reserve(count);
+}
+
+/**
+ * @brief Добавляет элемент за O(log n).
+ *
+ * @param value Элемент.
+ * @return Описатель добавленного элемента.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename addressable_priority_queue<T, Compare, Arity>::handle
+addressable_priority_queue<T, Compare, Arity>::push(const value_type &value) {
+  return PushEntry(Entry{value, 0});
+}
+
+/**
+ * @brief Добавляет элемент перемещением за O(log n).
+ *
+ * @param value Элемент.
+ * @return Описатель добавленного элемента.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename addressable_priority_queue<T, Compare, Arity>::handle
+addressable_priority_queue<T, Compare, Arity>::push(value_type &&value) {
+  return PushEntry(Entry{std::move(value), 0});
+}
+
+/**
+ * @brief Удаляет элемент с наибольшим приоритетом за O(log n). Для пустой
+ * очереди ничего не делает.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::pop() {
+  if (heap_.empty()) {
+    return;
+  }
+  free_ids_.push_back(heap_.front().id_);
+  EntryLess less{&compare_};
+  TrackPlacement placed{&heap_, &positions_};
+  Algorithms::PopHeap(heap_.begin(), heap_.size(), less, placed);
+  heap_.pop_back();
+}
+
+/**
+ * @brief Заменяет содержимое элементами последовательности и строит кучу
+ * снизу вверх за O(n).
+ *
+ * Куча строится в отдельных векторах и подменяет прежнюю только целиком,
+ * поэтому при исключении очередь и ее описатели не меняются.
+ *
+ * @param first Начало последовательности.
+ * @param last Конец последовательности.
+ * @return Описатели элементов в порядке последовательности.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+template <typename InputIt>
+std::vector<typename addressable_priority_queue<T, Compare, Arity>::handle>
+addressable_priority_queue<T, Compare, Arity>::assign(InputIt first,
+                                                      InputIt last) {
+  std::vector<Entry> heap;
+  std::vector<handle> handles;
+  for (; first != last; ++first) {
+    heap.push_back(Entry{*first, heap.size()});
+    handles.push_back(handle(heap.size() - 1));
+  }
+  std::vector<size_type> positions(heap.size());
+  EntryLess less{&compare_};
+  TrackPlacement placed{&heap, &positions};
+  Algorithms::MakeHeap(heap.begin(), heap.size(), less, placed);
+  heap_.swap(heap);
+  positions_.swap(positions);
+  free_ids_.clear();
+  return handles;
+}
+
+/**
+ * @brief Заменяет элемент по описателю и восстанавливает кучу за O(log n):
+ * элемент поднимается или опускается в зависимости от нового значения.
+ *
+ * @param position Описатель элемента из очереди.
+ * @param value Новое значение.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::update(
+    handle position, const value_type &value) {
+  const size_type index = positions_[position.id_];
+  const bool raise = compare_(heap_[index].value_, value);
+  heap_[index].value_ = value;
+  if (raise) {
+    SiftUp(index);
+  } else {
+    SiftDown(index);
+  }
+}
+
+/**
+ * @brief Повышает приоритет элемента (decrease-key для очереди минимумов с
+ * std::greater) за O(log n): элемент только поднимается к вершине.
+ *
+ * Новое значение не должно уступать прежнему по Compare; для изменения в
+ * любую сторону служит update.
+ *
+ * @param position Описатель элемента из очереди.
+ * @param value Новое значение.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::decrease_key(
+    handle position, const value_type &value) {
+  const size_type index = positions_[position.id_];
+  heap_[index].value_ = value;
+  SiftUp(index);
+}
+
+/**
+ * @brief Удаляет элемент по описателю за O(log n).
+ *
+ * @param position Описатель элемента из очереди; после удаления он
+ * недействителен.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::erase(handle position) {
+  RemoveAt(positions_[position.id_]);
+}
+
+/**
+ * @brief Удаляет все элементы; все описатели становятся недействительными.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::clear() noexcept {
+  heap_.clear();
+  positions_.clear();
+  free_ids_.clear();
+}
+
+/**
+ * @brief Обменивает содержимое с другой очередью. Описатели остаются
+ * действительными и относятся к той очереди, куда переехали элементы.
+ *
+ * @param other Другая очередь.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::swap(
+    addressable_priority_queue &other) noexcept {
+  using std::swap;
+  heap_.swap(other.heap_);
+  positions_.swap(other.positions_);
+  free_ids_.swap(other.free_ids_);
+  swap(compare_, other.compare_);
+}
+
+/**
+ * @brief Выдает номер описателя: освобожденный или новый.
+ *
+ * @return Номер с выделенным местом в positions_.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename addressable_priority_queue<T, Compare, Arity>::size_type
+addressable_priority_queue<T, Compare, Arity>::AcquireId() {
+  if (!free_ids_.empty()) {
+    const size_type id = free_ids_.back();
+    free_ids_.pop_back();
+    return id;
+  }
+  positions_.push_back(0);
+  return positions_.size() - 1;
+}
+
+/**
+ * @brief Добавляет запись в конец кучи и поднимает ее.
+ *
+ * @param entry Запись с элементом.
+ * @return Описатель элемента.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename addressable_priority_queue<T, Compare, Arity>::handle
+addressable_priority_queue<T, Compare, Arity>::PushEntry(Entry &&entry) {
+  heap_.push_back(std::move(entry));
+  try {
+    heap_.back().id_ = AcquireId();
+  } catch (...) {
+    heap_.pop_back();
+    throw;
+  }
+  const size_type id = heap_.back().id_;
+  SiftUp(heap_.size() - 1);
+  return handle(id);
+}
+
+/**
+ * @brief Поднимает запись кучи, обновляя позиции сдвинутых записей.
+ *
+ * @param index Позиция записи.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::SiftUp(size_type index) {
+  EntryLess less{&compare_};
+  TrackPlacement placed{&heap_, &positions_};
+  Algorithms::SiftUp(heap_.begin(), index, less, placed);
+}
+
+/**
+ * @brief Опускает запись кучи, обновляя позиции сдвинутых записей.
+ *
+ * @param index Позиция записи.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::SiftDown(size_type index) {
+  EntryLess less{&compare_};
+  TrackPlacement placed{&heap_, &positions_};
+  Algorithms::SiftDown(heap_.begin(), heap_.size(), index, less, placed);
+}
+
+/**
+ * @brief Удаляет запись кучи: на ее место встает последняя, которая затем
+ * поднимается или опускается.
+ *
+ * @param index Позиция удаляемой записи.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void addressable_priority_queue<T, Compare, Arity>::RemoveAt(size_type index) {
+  free_ids_.push_back(heap_[index].id_);
+  const size_type last = heap_.size() - 1;
+  if (index != last) {
+    heap_[index] = std::move(heap_[last]);
+  }
+  heap_.pop_back();
+  if (index == last) {
+    return;
+  }
+  if (index > 0 &&
+      compare_(heap_[(index - 1) / Arity].value_, heap_[index].value_)) {
+    SiftUp(index);
+  } else {
+    SiftDown(index);
+  }
+}
+
+} // namespace s21
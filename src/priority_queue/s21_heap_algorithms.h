@@ -0,0 +1,183 @@
+#ifndef S21_CONTAINERS_PRIORITY_QUEUE_S21_HEAP_ALGORITHMS_H_
+#define S21_CONTAINERS_PRIORITY_QUEUE_S21_HEAP_ALGORITHMS_H_
+
+#include <cstddef>
+#include <utility>
+
+namespace s21 {
+
+// Алгоритмы d-арной кучи над непрерывным массивом, общие для
+// priority_queue и addressable_priority_queue. Дети узла i лежат подряд в
+// ячейках [Arity * i + 1, Arity * i + Arity], поэтому при Arity = 4 выбор
+// наибольшего ребенка читает одну-две строки кэша, а высота кучи вдвое
+// меньше двоичной.
+//
+// less(a, b) - "a уступает b": в вершине кучи наибольший по less элемент,
+// как у std::priority_queue. placed(i) вызывается каждый раз, когда в
+// ячейку i записан элемент; адресуемая очередь обновляет в нем позиции
+// элементов, а обычная передает пустую функцию.
+template <std::size_t Arity> struct DAryHeapAlgorithms {
+  static_assert(Arity >= 2, "s21: арность кучи должна быть не меньше 2");
+
+  using size_type = std::size_t;
+
+  template <typename RandomIt, typename Less, typename Placed>
+  static void SiftUp(RandomIt heap, size_type index, Less &less,
+                     Placed &placed);
+
+  template <typename RandomIt, typename Less, typename Placed>
+  static void SiftDown(RandomIt heap, size_type size, size_type index,
+                       Less &less, Placed &placed);
+
+  template <typename RandomIt, typename Less, typename Placed>
+  static void PopHeap(RandomIt heap, size_type size, Less &less,
+                      Placed &placed);
+
+  template <typename RandomIt, typename Less, typename Placed>
+  static void MakeHeap(RandomIt heap, size_type size, Less &less,
+                       Placed &placed);
+};
+
+/**
+ * @brief Поднимает элемент к вершине, пока родитель ему уступает.
+ *
+ * Элемент вынимается один раз, а родители сдвигаются на его место, так что
+ * на уровень приходится одно перемещение вместо обмена.
+ *
+ * @param heap Начало массива кучи.
+ * @param index Позиция поднимаемого элемента.
+ * @param less Порядок элементов.
+ * @param placed Обработчик записи элемента в ячейку.
+ */
+template <std::size_t Arity>
+template <typename RandomIt, typename Less, typename Placed>
+void DAryHeapAlgorithms<Arity>::SiftUp(RandomIt heap, size_type index,
+                                       Less &less, Placed &placed) {
+  auto value = std::move(heap[index]);
+  while (index > 0) {
+    const size_type parent = (index - 1) / Arity;
+    if (!less(heap[parent], value)) {
+      break;
+    }
+    heap[index] = std::move(heap[parent]);
+    placed(index);
+    index = parent;
+  }
+  heap[index] = std::move(value);
+  placed(index);
+}
+
+/**
+ * @brief Опускает элемент, пока наибольший из его детей его превосходит.
+ *
+ * @param heap Начало массива кучи.
+ * @param size Число элементов кучи.
+ * @param index Позиция опускаемого элемента.
+ * @param less Порядок элементов.
+ * @param placed Обработчик записи элемента в ячейку.
+ */
+template <std::size_t Arity>
+template <typename RandomIt, typename Less, typename Placed>
+void DAryHeapAlgorithms<Arity>::SiftDown(RandomIt heap, size_type size,
+                                         size_type index, Less &less,
+                                         Placed &placed) {
+  auto value = std::move(heap[index]);
+  for (;;) {
+    const size_type first = Arity * index + 1;
+    if (first >= size) {
+      break;
+    }
+    const size_type last = size - first < Arity ? size : first + Arity;
+    size_type best = first;
+    for (size_type child = first + 1; child < last; ++child) {
+      if (less(heap[best], heap[child])) {
+        best = child;
+      }
+    }
+    if (!less(value, heap[best])) {
+      break;
+    }
+    heap[index] = std::move(heap[best]);
+    placed(index);
+    index = best;
+  }
+  heap[index] = std::move(value);
+  placed(index);
+}
+
+/**
+ * @brief Удаляет вершину: куча из size элементов становится кучей из
+ * size - 1 элементов в начале массива, последняя ячейка освобождается.
+ *
+ * Дыра в вершине спускается к листу по наибольшим детям без сравнения с
+ * последним элементом, и уже с листа тот поднимается на место. Последний
+ * элемент почти всегда возвращается к нижним уровням, так что подъем
+ * короткий, а на каждом уровне спуска сравнений на одно меньше.
+ *
+ * @param heap Начало массива кучи.
+ * @param size Число элементов кучи, не меньше 1.
+ * @param less Порядок элементов.
+ * @param placed Обработчик записи элемента в ячейку.
+ */
+template <std::size_t Arity>
+template <typename RandomIt, typename Less, typename Placed>
+void DAryHeapAlgorithms<Arity>::PopHeap(RandomIt heap, size_type size,
+                                        Less &less, Placed &placed) {
+  const size_type last = size - 1;
+  if (last == 0) {
+    return;
+  }
+  size_type index = 0;
+  for (;;) {
+    const size_type first = Arity * index + 1;
+    if (first >= last) {
+      break;
+    }
+    const size_type end = last - first < Arity ? last : first + Arity;
+    size_type best = first;
+    for (size_type child = first + 1; child < end; ++child) {
+      if (less(heap[best], heap[child])) {
+        best = child;
+      }
+    }
+    heap[index] = std::move(heap[best]);
+    placed(index);
+    index = best;
+  }
+  heap[index] = std::move(heap[last]);
+  SiftUp(heap, index, less, placed);
+}
+
+/**
+ * @brief Упорядочивает произвольный массив в кучу за O(n).
+ *
+ * Внутренние узлы опускаются снизу вверх: большая часть узлов лежит у
+ * листьев и опускается на один-два уровня.
+ *
+ * @param heap Начало массива.
+ * @param size Число элементов.
+ * @param less Порядок элементов.
+ * @param placed Обработчик записи элемента в ячейку.
+ */
+template <std::size_t Arity>
+template <typename RandomIt, typename Less, typename Placed>
+void DAryHeapAlgorithms<Arity>::MakeHeap(RandomIt heap, size_type size,
+                                         Less &less, Placed &placed) {
+  if (size < 2) {
+    for (size_type i = 0; i < size; ++i) {
+      placed(i);
+    }
+    return;
+  }
+  // Листья не двигаются, но адресуемой очереди нужны их позиции
+  for (size_type i = (size - 2) / Arity + 1; i < size; ++i) {
+    placed(i);
+  }
+  for (size_type i = (size - 2) / Arity + 1; i-- > 0;) {
+    SiftDown(heap, size, i, less, placed);
+  }
+}
+
+} // namespace s21
+
+#endif // S21_CONTAINERS_PRIORITY_QUEUE_S21_HEAP_ALGORITHMS_H_
@@ -0,0 +1,71 @@
+#ifndef S21_CONTAINERS_PRIORITY_QUEUE_S21_PRIORITY_QUEUE_H_
+#define S21_CONTAINERS_PRIORITY_QUEUE_S21_PRIORITY_QUEUE_H_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_heap_algorithms.h"
+
+namespace s21 {
+
+// Очередь с приоритетом на d-арной куче в непрерывном массиве. В вершине -
+// наибольший по Compare элемент (с std::greater - наименьший), как у
+// std::priority_queue. push и pop стоят O(log n) перемещений без выделения
+// узлов, построение из последовательности - O(n).
+template <typename T, typename Compare = std::less<T>, std::size_t Arity = 4>
+class priority_queue {
+public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using value_compare = Compare;
+
+  // Конструкторы
+  priority_queue() = default;
+  explicit priority_queue(const Compare &compare);
+  priority_queue(std::initializer_list<value_type> const &items,
+                 const Compare &compare = Compare());
+  template <typename InputIt>
+  priority_queue(InputIt first, InputIt last,
+                 const Compare &compare = Compare());
+
+  // Доступ к элементам
+  const_reference top() const;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+  void reserve(size_type count);
+
+  // Модификаторы
+  void push(const value_type &value);
+  void push(value_type &&value);
+  template <typename... Args> void emplace(Args &&...args);
+  void pop();
+  template <typename InputIt> void assign(InputIt first, InputIt last);
+  void clear() noexcept;
+  void swap(priority_queue &other) noexcept;
+
+private:
+  using Algorithms = DAryHeapAlgorithms<Arity>;
+
+  // Обычной очереди позиции элементов не нужны.
+  struct IgnorePlacement {
+    void operator()(size_type) const noexcept {}
+  };
+
+  void SiftUpLast();
+
+  std::vector<value_type> heap_;
+  Compare compare_;
+};
+
+} // namespace s21
+
+#include "s21_priority_queue.tpp"
+#endif // S21_CONTAINERS_PRIORITY_QUEUE_S21_PRIORITY_QUEUE_H_
@@ -0,0 +1,181 @@
+#include "s21_priority_queue.h"
+
+namespace s21 {
+
+/**
+ * @brief Создает пустую очередь с заданным порядком.
+ *
+ * @param compare Порядок элементов.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+priority_queue<T, Compare, Arity>::priority_queue(const Compare &compare)
+    : compare_(compare) {}
+
+/**
+ * @brief Конструктор инициализации на основе списка элементов за O(n).
+ *
+ * @param items Список элементов.
+ * @param compare Порядок элементов.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+priority_queue<T, Compare, Arity>::priority_queue(
+    std::initializer_list<value_type> const &items, const Compare &compare)
+    : compare_(compare) {
+  assign(items.begin(), items.end());
+}
+
+/**
+ * @brief Создает очередь из последовательности элементов за O(n).
+ *
+ * @param first Начало последовательности.
+ * @param last Конец последовательности.
+ * @param compare Порядок элементов.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+template <typename InputIt>
+priority_queue<T, Compare, Arity>::priority_queue(InputIt first, InputIt last,
+                                                  const Compare &compare)
+    : compare_(compare) {
+  assign(first, last);
+}
+
+/**
+ * @brief Возвращает элемент с наибольшим приоритетом.
+ *
+ * @return Константная ссылка на вершину кучи.
+ * @throw std::out_of_range Если очередь пуста.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename priority_queue<T, Compare, Arity>::const_reference
+priority_queue<T, Compare, Arity>::top() const {
+  if (heap_.empty()) {
+    throw std::out_of_range("s21::priority_queue::top: Очередь пуста.");
+  }
+  return heap_.front();
+}
+
+/**
+ * @brief Проверяет, пуста ли очередь.
+ *
+ * @return true, если элементов нет.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+bool priority_queue<T, Compare, Arity>::empty() const noexcept {
+  return heap_.empty();
+}
+
+/**
+ * @brief Возвращает количество элементов.
+ *
+ * @return Количество элементов.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+typename priority_queue<T, Compare, Arity>::size_type
+priority_queue<T, Compare, Arity>::size() const noexcept {
+  return heap_.size();
+}
+
+/**
+ * @brief Резервирует место под count элементов, чтобы push не
+ * перевыделял массив.
+ *
+ * @param count Ожидаемое число элементов.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::reserve(size_type count) {
+  heap_.reserve(count);
+}
+
+/**
+ * @brief Добавляет элемент за O(log n).
+ *
+ * @param value Элемент.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::push(const value_type &value) {
+  heap_.push_back(value);
+  SiftUpLast();
+}
+
+/**
+ * @brief Добавляет элемент перемещением за O(log n).
+ *
+ * @param value Элемент.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::push(value_type &&value) {
+  heap_.push_back(std::move(value));
+  SiftUpLast();
+}
+
+/**
+ * @brief Создает элемент на месте из аргументов и добавляет его.
+ *
+ * @param args Аргументы конструктора элемента.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+template <typename... Args>
+void priority_queue<T, Compare, Arity>::emplace(Args &&...args) {
+  heap_.emplace_back(std::forward<Args>(args)...);
+  SiftUpLast();
+}
+
+/**
+ * @brief Удаляет элемент с наибольшим приоритетом за O(log n). Для пустой
+ * очереди ничего не делает.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::pop() {
+  if (heap_.empty()) {
+    return;
+  }
+  IgnorePlacement placed;
+  Algorithms::PopHeap(heap_.begin(), heap_.size(), compare_, placed);
+  heap_.pop_back();
+}
+
+/**
+ * @brief Заменяет содержимое элементами последовательности и строит кучу
+ * снизу вверх за O(n) вместо n вставок по O(log n).
+ *
+ * @param first Начало последовательности.
+ * @param last Конец последовательности.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+template <typename InputIt>
+void priority_queue<T, Compare, Arity>::assign(InputIt first, InputIt last) {
+  heap_.assign(first, last);
+  IgnorePlacement placed;
+  Algorithms::MakeHeap(heap_.begin(), heap_.size(), compare_, placed);
+}
+
+/**
+ * @brief Удаляет все элементы. Память массива сохраняется.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::clear() noexcept {
+  heap_.clear();
+}
+
+/**
+ * @brief Обменивает содержимое с другой очередью.
+ *
+ * @param other Другая очередь.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::swap(priority_queue &other) noexcept {
+  using std::swap;
+  heap_.swap(other.heap_);
+  swap(compare_, other.compare_);
+}
+
+/**
+ * @brief Поднимает только что добавленный последний элемент.
+ */
+template <typename T, typename Compare, std::size_t Arity>
+void priority_queue<T, Compare, Arity>::SiftUpLast() {
+  IgnorePlacement placed;
+  Algorithms::SiftUp(heap_.begin(), heap_.size() - 1, compare_, placed);
+}
+
+} // namespace s21
@@ -0,0 +1,97 @@
+// Сравнение s21::radix_map и s21::map<std::string, int> на наборах строковых
+// ключей с длинными общими префиксами: время вставки, задержка поиска
+// (в случайном порядке) и байты на ключ.
+//
+// Сборка: g++ -std=c++17 -O2 radix_map_bench.cpp -o radix_map_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../bench/HeapCounter.h"
+#include "../map/s21_map.h"
+#include "s21_radix_map.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+std::vector<std::string> MakeUrls(std::size_t count, std::mt19937 &gen) {
+  const char *resources[] = {"orders", "payments", "sessions", "reviews"};
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < count; ++i) {
+    keys.push_back("https://example.com/api/v1/users/" +
+                   std::to_string(gen() % 1000000) + "/" +
+                   resources[gen() % 4] + "/" + std::to_string(i));
+  }
+  return keys;
+}
+
+std::vector<std::string> MakeMetrics(std::size_t count, std::mt19937 &gen) {
+  const char *services[] = {"api", "auth", "billing", "search", "storage"};
+  const char *regions[] = {"eu-west", "us-east", "ap-south"};
+  const char *metrics[] = {"cpu.user", "cpu.system", "mem.rss", "disk.read",
+                           "disk.write", "net.rx", "net.tx"};
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < count; ++i) {
+    char host[16];
+    std::snprintf(host, sizeof(host), "host-%04u",
+                  static_cast<unsigned>(i / 7));
+    keys.push_back(std::string(services[gen() % 5]) + "." +
+                   regions[gen() % 3] + "." + host + "." + metrics[i % 7]);
+  }
+  return keys;
+}
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+template <typename Container>
+void Run(const char *name, const std::vector<std::string> &keys,
+         const std::vector<std::string> &probes) {
+  std::size_t before = s21::bench::live_bytes;
+  auto *container = new Container;
+  auto start = Clock::now();
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    container->insert(keys[i], static_cast<int>(i));
+  }
+  double insert_ms = Milliseconds(start);
+  std::size_t bytes = s21::bench::live_bytes - before;
+
+  long long checksum = 0;
+  start = Clock::now();
+  for (const auto &key : probes) {
+    checksum += (*container->find(key)).second;
+  }
+  double lookup_ns = Milliseconds(start) * 1e6 / probes.size();
+  std::printf("  %-10s insert %8.2f ms  lookup %7.1f ns/op  %6.1f bytes/key"
+              "  (checksum %lld)\n",
+              name, insert_ms, lookup_ns,
+              static_cast<double>(bytes) / keys.size(), checksum);
+  delete container;
+}
+
+void Compare(const char *title, std::vector<std::string> keys,
+             std::mt19937 &gen) {
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  std::shuffle(keys.begin(), keys.end(), gen);
+  std::vector<std::string> probes = keys;
+  std::shuffle(probes.begin(), probes.end(), gen);
+
+  std::printf("%s: %zu keys\n", title, keys.size());
+  Run<s21::radix_map<std::string, int>>("radix_map", keys, probes);
+  Run<s21::map<std::string, int>>("map", keys, probes);
+}
+} // namespace
+
+int main() {
+  std::mt19937 gen(2024);
+  Compare("URL", MakeUrls(500000, gen), gen);
+  Compare("metric names", MakeMetrics(500000, gen), gen);
+  return 0;
+}
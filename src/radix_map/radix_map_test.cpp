@@ -0,0 +1,199 @@
+#include "s21_radix_map.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace s21 {
+namespace {
+using RadixMap = s21::radix_map<std::string, int>;
+
+void ExpectSameAs(const RadixMap &actual,
+                  const std::map<std::string, int> &ref) {
+  ASSERT_EQ(actual.size(), ref.size());
+  auto expected = ref.begin();
+  for (const auto &item : actual) {
+    EXPECT_EQ(item.first, expected->first);
+    EXPECT_EQ(item.second, expected->second);
+    ++expected;
+  }
+}
+} // namespace
+
+TEST(RadixMapTest, EmptyMap) {
+  RadixMap m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.size(), 0U);
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_FALSE(m.contains(""));
+  EXPECT_TRUE(m.lower_bound("a") == m.end());
+}
+
+TEST(RadixMapTest, InsertFindAndAt) {
+  RadixMap m{{"banana", 2}, {"apple", 1}, {"cherry", 3}};
+  EXPECT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.at("apple"), 1);
+  EXPECT_EQ(m.find("cherry")->second, 3);
+  EXPECT_TRUE(m.find("cher") == m.end());
+  EXPECT_FALSE(m.insert("apple", 10).second);
+  EXPECT_EQ(m.at("apple"), 1);
+  EXPECT_FALSE(m.insert_or_assign("apple", 10).second);
+  EXPECT_EQ(m.at("apple"), 10);
+  EXPECT_THROW(m.at("durian"), std::out_of_range);
+
+  m["durian"] += 4;
+  EXPECT_EQ(m["durian"], 4);
+  EXPECT_EQ(m.count("durian"), 1U);
+}
+
+TEST(RadixMapTest, KeysThatArePrefixesOfEachOther) {
+  RadixMap m;
+  m.insert("abc", 3);
+  m.insert("a", 1);
+  m.insert("", 0);
+  m.insert("ab", 2);
+  m.insert(std::string("a\0b", 3), 4);
+
+  std::vector<std::string> keys;
+  for (const auto &item : m) {
+    keys.push_back(item.first);
+  }
+  std::vector<std::string> expected{"", "a", std::string("a\0b", 3), "ab",
+                                    "abc"};
+  EXPECT_EQ(keys, expected);
+  EXPECT_EQ(m.at(""), 0);
+  EXPECT_EQ(m.at("ab"), 2);
+
+  EXPECT_EQ(m.erase("ab"), 1U);
+  EXPECT_EQ(m.erase("ab"), 0U);
+  EXPECT_EQ(m.at("abc"), 3);
+  EXPECT_EQ(m.at("a"), 1);
+  EXPECT_EQ(m.erase("a"), 1U);
+  EXPECT_EQ(m.erase(""), 1U);
+  EXPECT_EQ(m.at(std::string("a\0b", 3)), 4);
+  EXPECT_EQ(m.size(), 2U);
+}
+
+TEST(RadixMapTest, MatchesStdMapOnLongSharedPrefixes) {
+  std::mt19937 gen(31);
+  std::map<std::string, int> ref;
+  RadixMap m;
+  const std::vector<std::string> stems{
+      "https://example.com/api/v1/users/", "https://example.com/api/v2/",
+      "service.eu-west.host-", "x"};
+  for (int i = 0; i < 4000; ++i) {
+    std::string key = stems[gen() % stems.size()] +
+                      std::to_string(gen() % 700) +
+                      (gen() % 3 == 0 ? "/orders" : "");
+    if (gen() % 4 == 0) {
+      EXPECT_EQ(m.erase(key), ref.erase(key));
+    } else {
+      EXPECT_EQ(m.insert(key, i).second, ref.emplace(key, i).second);
+    }
+  }
+  ExpectSameAs(m, ref);
+
+  for (int i = 0; i < 500; ++i) {
+    std::string probe = stems[gen() % stems.size()] +
+                        std::to_string(gen() % 800);
+    auto expected = ref.lower_bound(probe);
+    auto actual = m.lower_bound(probe);
+    if (expected == ref.end()) {
+      EXPECT_TRUE(actual == m.end());
+    } else {
+      EXPECT_EQ(actual->first, expected->first);
+    }
+    EXPECT_EQ(m.contains(probe), ref.count(probe) == 1);
+  }
+
+  std::vector<std::string> keys;
+  for (const auto &item : ref) {
+    keys.push_back(item.first);
+  }
+  std::shuffle(keys.begin(), keys.end(), gen);
+  for (const auto &key : keys) {
+    EXPECT_EQ(m.erase(key), 1U);
+  }
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.begin() == m.end());
+}
+
+TEST(RadixMapTest, GrowsAndShrinksThroughAllNodeSizes) {
+  RadixMap m;
+  for (int byte = 255; byte >= 0; --byte) {
+    m.insert(std::string("k") + static_cast<char>(byte), byte);
+  }
+  m.insert("k", -1);
+  EXPECT_EQ(m.size(), 257U);
+  int expected = -1;
+  for (const auto &item : m) {
+    EXPECT_EQ(item.second, expected++);
+  }
+
+  for (int byte = 0; byte < 256; byte += 2) {
+    EXPECT_EQ(m.erase(std::string("k") + static_cast<char>(byte)), 1U);
+  }
+  for (int byte = 1; byte < 250; byte += 2) {
+    EXPECT_EQ(m.at(std::string("k") + static_cast<char>(byte)), byte);
+    m.erase(std::string("k") + static_cast<char>(byte));
+  }
+  EXPECT_EQ(m.size(), 4U);
+  EXPECT_EQ(m.begin()->second, -1);
+  EXPECT_EQ((--m.end())->second, 255);
+}
+
+TEST(RadixMapTest, PrefixRange) {
+  RadixMap m{{"app", 1},    {"apple", 2}, {"applet", 3},
+             {"apply", 4},  {"apt", 5},   {"b", 6},
+             {"ap\xff", 7}, {"ap\xff\xff", 8}};
+  auto range = m.prefix_range("appl");
+  std::vector<int> values;
+  for (auto it = range.first; it != range.second; ++it) {
+    values.push_back(it->second);
+  }
+  EXPECT_EQ(values, (std::vector<int>{2, 3, 4}));
+
+  range = m.prefix_range("ap\xff");
+  EXPECT_EQ(range.first->second, 7);
+  EXPECT_EQ(std::distance(range.first, range.second), 2);
+
+  range = m.prefix_range("");
+  EXPECT_EQ(std::distance(range.first, range.second), 8);
+  range = m.prefix_range("zz");
+  EXPECT_TRUE(range.first == range.second);
+}
+
+TEST(RadixMapTest, CopyMoveAndSwap) {
+  RadixMap m{{"alpha", 1}, {"beta", 2}};
+  RadixMap copy(m);
+  copy["gamma"] = 3;
+  EXPECT_EQ(m.size(), 2U);
+  EXPECT_EQ(copy.size(), 3U);
+
+  RadixMap moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.at("gamma"), 3);
+  EXPECT_EQ((--moved.end())->first, "gamma");
+
+  RadixMap empty;
+  empty.swap(moved);
+  EXPECT_TRUE(moved.empty());
+  EXPECT_TRUE(moved.begin() == moved.end());
+  EXPECT_EQ(empty.size(), 3U);
+  EXPECT_EQ(empty.begin()->first, "alpha");
+
+  m = empty;
+  EXPECT_EQ(m.size(), 3U);
+  m = RadixMap{{"z", 26}};
+  EXPECT_EQ(m.begin()->second, 26);
+  EXPECT_GT(empty.memory_usage(), m.memory_usage());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
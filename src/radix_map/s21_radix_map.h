@@ -0,0 +1,316 @@
+#ifndef S21_CONTAINERS_RADIX_MAP_S21_RADIX_MAP_H_
+#define S21_CONTAINERS_RADIX_MAP_S21_RADIX_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+// Упорядоченный ассоциативный контейнер со строковыми ключами на основе
+// адаптивного префиксного дерева (Adaptive Radix Tree). Поиск идет по байтам
+// ключа, а не сравнениями целых ключей, поэтому длинные общие префиксы
+// (URL, имена метрик) не сравниваются заново на каждом уровне. Порядок
+// обхода совпадает с порядком s21::map<std::string, Type>.
+template <typename Key, typename Type> class radix_map {
+  static_assert(std::is_same<Key, std::string>::value,
+                "s21::radix_map поддерживает только ключи std::string");
+
+private:
+  struct Node;
+  struct Links;
+  struct Leaf;
+  struct InnerNode;
+  struct Node4;
+  struct Node16;
+  struct Node48;
+  struct Node256;
+  struct RadixMapIterator;
+  struct RadixMapIteratorConst;
+
+public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = RadixMapIterator;
+  using const_iterator = RadixMapIteratorConst;
+  using size_type = std::size_t;
+
+  // Конструкторы, деструктор и операторы присваивания
+  radix_map() noexcept;
+  radix_map(std::initializer_list<value_type> const &items);
+  radix_map(const radix_map &other);
+  radix_map(radix_map &&other) noexcept;
+  ~radix_map();
+
+  radix_map &operator=(const radix_map &other);
+  radix_map &operator=(radix_map &&other) noexcept;
+
+  // Доступ к элементам
+  mapped_type &at(const key_type &key);
+  const mapped_type &at(const key_type &key) const;
+  mapped_type &operator[](const key_type &key);
+
+  // Итераторы
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+  [[nodiscard]] size_type max_size() const noexcept;
+  [[nodiscard]] size_type memory_usage() const noexcept;
+
+  // Модификаторы
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(const key_type &key, const mapped_type &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &obj);
+  void erase(iterator pos) noexcept;
+  size_type erase(const key_type &key) noexcept;
+  void swap(radix_map &other) noexcept;
+
+  // Поиск
+  iterator find(const key_type &key) noexcept;
+  const_iterator find(const key_type &key) const noexcept;
+  bool contains(const key_type &key) const noexcept;
+  size_type count(const key_type &key) const noexcept;
+  iterator lower_bound(const key_type &key) noexcept;
+  const_iterator lower_bound(const key_type &key) const noexcept;
+  std::pair<iterator, iterator> prefix_range(const key_type &prefix);
+  std::pair<const_iterator, const_iterator>
+  prefix_range(const key_type &prefix) const;
+
+private:
+  enum NodeKind : unsigned char { kLeaf, kNode4, kNode16, kNode48, kNode256 };
+
+  // Сколько байт сжатого пути хранится прямо в узле. Более длинные пути
+  // проверяются оптимистично: при поиске пропускаются и сверяются с ключом
+  // найденного листа, а при изменении дерева берутся из любого листа
+  // поддерева.
+  static constexpr std::size_t kMaxPrefix = 10;
+
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const key_type &key, Args &&...args);
+  Leaf *FindLeaf(const key_type &key) const noexcept;
+  Leaf *LowerBoundLeaf(Node *node, const key_type &key,
+                       size_type depth) const noexcept;
+  void InsertLeaf(Leaf *leaf);
+  void RemoveLeaf(Leaf *leaf) noexcept;
+  void CopyFrom(const radix_map &other);
+  void RelinkHead() noexcept;
+
+  static Node **FindChild(InnerNode *node, unsigned char byte) noexcept;
+  static Node *FirstChildFrom(InnerNode *node, unsigned from) noexcept;
+  static void AddChild(Node **ref, InnerNode *node, unsigned char byte,
+                       Node *child);
+  static void InsertSorted(unsigned char *keys, Node **children,
+                           std::uint16_t count, unsigned char byte,
+                           Node *child) noexcept;
+  static void RemoveChild(InnerNode *node, unsigned char byte) noexcept;
+  static void Shrink(Node **ref, size_type depth) noexcept;
+  static void AttachLeaf(Node4 *node, Leaf *leaf, size_type depth) noexcept;
+  static Leaf *MinLeaf(Node *node) noexcept;
+  static size_type PrefixMismatch(InnerNode *node, const key_type &key,
+                                  size_type depth) noexcept;
+  static unsigned char PrefixByte(InnerNode *node, size_type depth,
+                                  size_type index) noexcept;
+  static void SetPrefix(InnerNode *node, const key_type &source,
+                        size_type depth, size_type length) noexcept;
+  static void CopyHeader(InnerNode *to, const InnerNode *from) noexcept;
+  static void DeleteInner(InnerNode *node) noexcept;
+  template <typename Function>
+  static void ForEachChild(InnerNode *node, Function func);
+  static void Destroy(Node *node) noexcept;
+  static size_type SubtreeMemory(const Node *node) noexcept;
+
+  struct Node {
+    explicit Node(NodeKind kind) noexcept : kind_(kind) {}
+    NodeKind kind_;
+  };
+
+  // Ссылки листа на соседей по порядку ключей. Листья образуют кольцевой
+  // список через head_, поэтому итераторы переходят между элементами за O(1)
+  // и не хранят путь от корня.
+  struct Links {
+    Links *prev_ = nullptr;
+    Links *next_ = nullptr;
+  };
+
+  struct Leaf : Node, Links {
+    template <typename... Args>
+    explicit Leaf(Args &&...args)
+        : Node(kLeaf), value_(std::forward<Args>(args)...) {}
+
+    value_type value_;
+  };
+
+  // Общий заголовок внутренних узлов: сжатый путь и лист ключа, который
+  // заканчивается ровно в этом узле (он меньше всех ключей в потомках).
+  struct InnerNode : Node {
+    explicit InnerNode(NodeKind kind) noexcept : Node(kind) {}
+    std::uint16_t count_ = 0;
+    std::uint32_t prefix_len_ = 0;
+    unsigned char prefix_[kMaxPrefix] = {};
+    Leaf *terminal_ = nullptr;
+  };
+
+  // До 4 потомков, байты отсортированы.
+  struct Node4 : InnerNode {
+    Node4() noexcept : InnerNode(kNode4) {}
+    unsigned char keys_[4] = {};
+    Node *children_[4] = {};
+  };
+
+  // До 16 потомков, байты отсортированы, поиск - одним SIMD-сравнением.
+  struct Node16 : InnerNode {
+    Node16() noexcept : InnerNode(kNode16) {}
+    unsigned char keys_[16] = {};
+    Node *children_[16] = {};
+  };
+
+  // До 48 потомков: индекс по байту (номер ячейки + 1, 0 - нет потомка).
+  struct Node48 : InnerNode {
+    Node48() noexcept : InnerNode(kNode48) {}
+    unsigned char index_[256] = {};
+    Node *children_[48] = {};
+  };
+
+  // До 256 потомков, прямая адресация по байту.
+  struct Node256 : InnerNode {
+    Node256() noexcept : InnerNode(kNode256) {}
+    Node *children_[256] = {};
+  };
+
+  struct RadixMapIterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = radix_map::value_type;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    RadixMapIterator() = delete;
+
+    explicit RadixMapIterator(Links *link) noexcept : link_(link) {}
+
+    reference operator*() const noexcept {
+      return static_cast<Leaf *>(link_)->value_;
+    }
+
+    pointer operator->() const noexcept { return &**this; }
+
+    iterator &operator++() noexcept {
+      link_ = link_->next_;
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    iterator &operator--() noexcept {
+      link_ = link_->prev_;
+      return *this;
+    }
+
+    iterator operator--(int) noexcept {
+      iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const iterator &other) const noexcept {
+      return link_ == other.link_;
+    }
+
+    bool operator!=(const iterator &other) const noexcept {
+      return link_ != other.link_;
+    }
+
+    Links *link_;
+  };
+
+  struct RadixMapIteratorConst {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = radix_map::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    RadixMapIteratorConst() = delete;
+
+    explicit RadixMapIteratorConst(const Links *link) noexcept : link_(link) {}
+
+    RadixMapIteratorConst(const iterator &it) noexcept : link_(it.link_) {}
+
+    reference operator*() const noexcept {
+      return static_cast<const Leaf *>(link_)->value_;
+    }
+
+    pointer operator->() const noexcept { return &**this; }
+
+    const_iterator &operator++() noexcept {
+      link_ = link_->next_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    const_iterator &operator--() noexcept {
+      link_ = link_->prev_;
+      return *this;
+    }
+
+    const_iterator operator--(int) noexcept {
+      const_iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const const_iterator &it1,
+                           const const_iterator &it2) noexcept {
+      return it1.link_ == it2.link_;
+    }
+
+    friend bool operator!=(const const_iterator &it1,
+                           const const_iterator &it2) noexcept {
+      return it1.link_ != it2.link_;
+    }
+
+    const Links *link_;
+  };
+
+  Node *root_;
+  Links head_;
+  size_type size_;
+};
+
+} // namespace s21
+
+#include "s21_radix_map.tpp"
+#endif // S21_CONTAINERS_RADIX_MAP_S21_RADIX_MAP_H_
@@ -0,0 +1,1259 @@
+namespace s21 {
+
+/**
+ * @brief Конструктор по умолчанию. Создает пустой контейнер.
+ *
+ * Фиктивный узел списка листьев head_ замыкается сам на себя.
+ */
+template <typename Key, typename Type>
+radix_map<Key, Type>::radix_map() noexcept : root_(nullptr), size_(0) {
+  head_.prev_ = head_.next_ = &head_;
+}
+
+/**
+ * @brief Конструктор инициализации на основе списка значений.
+ *
+ * Повторяющиеся ключи пропускаются, как и в s21::map.
+ *
+ * @param items Список значений для инициализации контейнера.
+ */
+template <typename Key, typename Type>
+radix_map<Key, Type>::radix_map(std::initializer_list<value_type> const &items)
+    : radix_map() {
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+/**
+ * @brief Конструктор копирования.
+ *
+ * @param other Контейнер, содержимое которого копируется.
+ */
+template <typename Key, typename Type>
+radix_map<Key, Type>::radix_map(const radix_map &other) : radix_map() {
+  CopyFrom(other);
+}
+
+/**
+ * @brief Конструктор перемещения. Забирает дерево и список листьев у other.
+ *
+ * @param other Контейнер, который после перемещения становится пустым.
+ */
+template <typename Key, typename Type>
+radix_map<Key, Type>::radix_map(radix_map &&other) noexcept : radix_map() {
+  swap(other);
+}
+
+/**
+ * @brief Деструктор. Освобождает все узлы и листья.
+ */
+template <typename Key, typename Type> radix_map<Key, Type>::~radix_map() {
+  clear();
+}
+
+/**
+ * @brief Копирующее присваивание.
+ *
+ * Копия строится отдельно, поэтому при исключении текущее содержимое не
+ * меняется.
+ *
+ * @param other Контейнер, содержимое которого копируется.
+ * @return Ссылка на текущий контейнер.
+ */
+template <typename Key, typename Type>
+radix_map<Key, Type> &radix_map<Key, Type>::operator=(const radix_map &other) {
+  if (this != &other) {
+    radix_map copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+/**
+ * @brief Перемещающее присваивание.
+ *
+ * @param other Контейнер, содержимое которого перемещается.
+ * @return Ссылка на текущий контейнер.
+ */
+template <typename Key, typename Type>
+radix_map<Key, Type> &
+radix_map<Key, Type>::operator=(radix_map &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Доступ к значению по ключу с проверкой наличия.
+ *
+ * @param key Ключ элемента.
+ * @return Ссылка на значение.
+ * @throw std::out_of_range Если ключ отсутствует.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::mapped_type &
+radix_map<Key, Type>::at(const key_type &key) {
+  Leaf *leaf = FindLeaf(key);
+  if (leaf == nullptr) {
+    throw std::out_of_range(
+        "s21::radix_map::at: Элемент с указанным ключом отсутствует.");
+  }
+  return leaf->value_.second;
+}
+
+/**
+ * @brief Константный доступ к значению по ключу с проверкой наличия.
+ *
+ * @param key Ключ элемента.
+ * @return Константная ссылка на значение.
+ * @throw std::out_of_range Если ключ отсутствует.
+ */
+template <typename Key, typename Type>
+const typename radix_map<Key, Type>::mapped_type &
+radix_map<Key, Type>::at(const key_type &key) const {
+  Leaf *leaf = FindLeaf(key);
+  if (leaf == nullptr) {
+    throw std::out_of_range(
+        "s21::radix_map::at: Элемент с указанным ключом отсутствует.");
+  }
+  return leaf->value_.second;
+}
+
+/**
+ * @brief Доступ к значению по ключу; отсутствующий ключ добавляется со
+ * значением по умолчанию.
+ *
+ * @param key Ключ элемента.
+ * @return Ссылка на значение.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::mapped_type &
+radix_map<Key, Type>::operator[](const key_type &key) {
+  return TryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                    std::tuple<>())
+      .first->second;
+}
+
+/**
+ * @brief Итератор на элемент с наименьшим ключом.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::iterator
+radix_map<Key, Type>::begin() noexcept {
+  return iterator(head_.next_);
+}
+
+/**
+ * @brief Константный итератор на элемент с наименьшим ключом.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::const_iterator
+radix_map<Key, Type>::begin() const noexcept {
+  return const_iterator(head_.next_);
+}
+
+/**
+ * @brief Итератор за последним элементом.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::iterator radix_map<Key, Type>::end() noexcept {
+  return iterator(&head_);
+}
+
+/**
+ * @brief Константный итератор за последним элементом.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::const_iterator
+radix_map<Key, Type>::end() const noexcept {
+  return const_iterator(&head_);
+}
+
+/**
+ * @brief Проверяет, пуст ли контейнер.
+ */
+template <typename Key, typename Type>
+bool radix_map<Key, Type>::empty() const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Возвращает количество элементов.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::size_type
+radix_map<Key, Type>::size() const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Возвращает максимально возможное количество элементов.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::size_type
+radix_map<Key, Type>::max_size() const noexcept {
+  return std::numeric_limits<size_type>::max() / sizeof(Leaf);
+}
+
+/**
+ * @brief Оценивает память, занятую контейнером: сам объект, внутренние узлы,
+ * листья и размещенные в куче буферы ключей.
+ *
+ * @return Количество байт.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::size_type
+radix_map<Key, Type>::memory_usage() const noexcept {
+  return sizeof(*this) + SubtreeMemory(root_);
+}
+
+/**
+ * @brief Удаляет все элементы.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::clear() noexcept {
+  Destroy(root_);
+  root_ = nullptr;
+  head_.prev_ = head_.next_ = &head_;
+  size_ = 0;
+}
+
+/**
+ * @brief Вставляет пару ключ-значение, если ключа еще нет.
+ *
+ * @param value Вставляемая пара.
+ * @return Итератор на элемент с этим ключом и признак вставки.
+ */
+template <typename Key, typename Type>
+std::pair<typename radix_map<Key, Type>::iterator, bool>
+radix_map<Key, Type>::insert(const value_type &value) {
+  return TryEmplace(value.first, value);
+}
+
+/**
+ * @brief Вставляет ключ и значение, если ключа еще нет.
+ *
+ * @param key Ключ.
+ * @param obj Значение.
+ * @return Итератор на элемент с этим ключом и признак вставки.
+ */
+template <typename Key, typename Type>
+std::pair<typename radix_map<Key, Type>::iterator, bool>
+radix_map<Key, Type>::insert(const key_type &key, const mapped_type &obj) {
+  return TryEmplace(key, key, obj);
+}
+
+/**
+ * @brief Вставляет элемент или заменяет значение существующего.
+ *
+ * @param key Ключ.
+ * @param obj Значение.
+ * @return Итератор на элемент и true, если элемент был вставлен.
+ */
+template <typename Key, typename Type>
+std::pair<typename radix_map<Key, Type>::iterator, bool>
+radix_map<Key, Type>::insert_or_assign(const key_type &key,
+                                       const mapped_type &obj) {
+  auto result = TryEmplace(key, key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
+
+/**
+ * @brief Удаляет элемент, на который указывает итератор.
+ *
+ * @param pos Итератор на существующий элемент.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::erase(iterator pos) noexcept {
+  auto *leaf = static_cast<Leaf *>(pos.link_);
+  RemoveLeaf(leaf);
+  leaf->prev_->next_ = leaf->next_;
+  leaf->next_->prev_ = leaf->prev_;
+  delete leaf;
+  --size_;
+}
+
+/**
+ * @brief Удаляет элемент по ключу.
+ *
+ * @param key Ключ удаляемого элемента.
+ * @return Количество удаленных элементов (0 или 1).
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::size_type
+radix_map<Key, Type>::erase(const key_type &key) noexcept {
+  Leaf *leaf = FindLeaf(key);
+  if (leaf == nullptr) {
+    return 0;
+  }
+  erase(iterator(leaf));
+  return 1;
+}
+
+/**
+ * @brief Обменивает содержимое двух контейнеров за O(1).
+ *
+ * @param other Контейнер для обмена.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::swap(radix_map &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(head_, other.head_);
+  std::swap(size_, other.size_);
+  RelinkHead();
+  other.RelinkHead();
+}
+
+/**
+ * @brief Ищет элемент по ключу.
+ *
+ * @param key Искомый ключ.
+ * @return Итератор на элемент или end().
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::iterator
+radix_map<Key, Type>::find(const key_type &key) noexcept {
+  Leaf *leaf = FindLeaf(key);
+  return leaf == nullptr ? end() : iterator(leaf);
+}
+
+/**
+ * @brief Ищет элемент по ключу.
+ *
+ * @param key Искомый ключ.
+ * @return Константный итератор на элемент или end().
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::const_iterator
+radix_map<Key, Type>::find(const key_type &key) const noexcept {
+  Leaf *leaf = FindLeaf(key);
+  return leaf == nullptr ? end() : const_iterator(leaf);
+}
+
+/**
+ * @brief Проверяет наличие ключа.
+ */
+template <typename Key, typename Type>
+bool radix_map<Key, Type>::contains(const key_type &key) const noexcept {
+  return FindLeaf(key) != nullptr;
+}
+
+/**
+ * @brief Возвращает количество элементов с ключом (0 или 1).
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::size_type
+radix_map<Key, Type>::count(const key_type &key) const noexcept {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Ищет первый элемент с ключом не меньше заданного.
+ *
+ * @param key Граница поиска.
+ * @return Итератор на найденный элемент или end().
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::iterator
+radix_map<Key, Type>::lower_bound(const key_type &key) noexcept {
+  Leaf *leaf = LowerBoundLeaf(root_, key, 0);
+  return leaf == nullptr ? end() : iterator(leaf);
+}
+
+/**
+ * @brief Ищет первый элемент с ключом не меньше заданного.
+ *
+ * @param key Граница поиска.
+ * @return Константный итератор на найденный элемент или end().
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::const_iterator
+radix_map<Key, Type>::lower_bound(const key_type &key) const noexcept {
+  Leaf *leaf = LowerBoundLeaf(root_, key, 0);
+  return leaf == nullptr ? end() : const_iterator(leaf);
+}
+
+/**
+ * @brief Возвращает диапазон элементов, ключи которых начинаются с prefix.
+ *
+ * Верхняя граница - lower_bound от наименьшей строки, большей всех строк с
+ * этим префиксом: завершающие байты 0xFF отбрасываются, а последний
+ * оставшийся байт увеличивается на единицу.
+ *
+ * @param prefix Общий префикс ключей.
+ * @return Полуинтервал [first, last) в порядке ключей.
+ */
+template <typename Key, typename Type>
+std::pair<typename radix_map<Key, Type>::iterator,
+          typename radix_map<Key, Type>::iterator>
+radix_map<Key, Type>::prefix_range(const key_type &prefix) {
+  key_type upper = prefix;
+  while (!upper.empty() && static_cast<unsigned char>(upper.back()) == 0xFF) {
+    upper.pop_back();
+  }
+  if (upper.empty()) {
+    return {lower_bound(prefix), end()};
+  }
+  auto last = static_cast<unsigned char>(upper.back());
+  upper.back() = static_cast<char>(last + 1);
+  return {lower_bound(prefix), lower_bound(upper)};
+}
+
+/**
+ * @brief Константный вариант prefix_range().
+ *
+ * @param prefix Общий префикс ключей.
+ * @return Полуинтервал [first, last) в порядке ключей.
+ */
+template <typename Key, typename Type>
+std::pair<typename radix_map<Key, Type>::const_iterator,
+          typename radix_map<Key, Type>::const_iterator>
+radix_map<Key, Type>::prefix_range(const key_type &prefix) const {
+  auto range = const_cast<radix_map *>(this)->prefix_range(prefix);
+  return {range.first, range.second};
+}
+
+/**
+ * @brief Вставляет элемент, если ключа еще нет.
+ *
+ * Сначала ищется lower_bound ключа: он же служит соседом, перед которым
+ * новый лист встает в упорядоченный список. Лист создается только после
+ * этого, а при исключении во время перестройки узлов удаляется.
+ *
+ * @param key Ключ вставляемого элемента.
+ * @param args Аргументы конструктора value_type.
+ * @return Итератор на элемент с этим ключом и признак вставки.
+ */
+template <typename Key, typename Type>
+template <typename... Args>
+std::pair<typename radix_map<Key, Type>::iterator, bool>
+radix_map<Key, Type>::TryEmplace(const key_type &key, Args &&...args) {
+  Leaf *next = LowerBoundLeaf(root_, key, 0);
+  if (next != nullptr && next->value_.first == key) {
+    return {iterator(next), false};
+  }
+
+  auto *leaf = new Leaf(std::forward<Args>(args)...);
+  try {
+    InsertLeaf(leaf);
+  } catch (...) {
+    delete leaf;
+    throw;
+  }
+
+  Links *position = next == nullptr ? &head_ : static_cast<Links *>(next);
+  leaf->prev_ = position->prev_;
+  leaf->next_ = position;
+  position->prev_->next_ = leaf;
+  position->prev_ = leaf;
+  ++size_;
+  return {iterator(leaf), true};
+}
+
+/**
+ * @brief Точный поиск листа по ключу.
+ *
+ * Сжатые пути длиннее kMaxPrefix проверяются только по сохраненным байтам,
+ * остальные пропускаются; ключ найденного листа затем сравнивается целиком.
+ *
+ * @param key Искомый ключ.
+ * @return Лист с этим ключом или nullptr.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::Leaf *
+radix_map<Key, Type>::FindLeaf(const key_type &key) const noexcept {
+  const auto *bytes = reinterpret_cast<const unsigned char *>(key.data());
+  Node *node = root_;
+  size_type depth = 0;
+  while (node != nullptr) {
+    if (node->kind_ == kLeaf) {
+      auto *leaf = static_cast<Leaf *>(node);
+      return leaf->value_.first == key ? leaf : nullptr;
+    }
+
+    auto *inner = static_cast<InnerNode *>(node);
+    if (key.size() - depth < inner->prefix_len_) {
+      return nullptr;
+    }
+    size_type stored =
+        inner->prefix_len_ < kMaxPrefix ? inner->prefix_len_ : kMaxPrefix;
+    if (std::memcmp(inner->prefix_, bytes + depth, stored) != 0) {
+      return nullptr;
+    }
+    depth += inner->prefix_len_;
+
+    if (depth == key.size()) {
+      Leaf *terminal = inner->terminal_;
+      return terminal != nullptr && terminal->value_.first == key ? terminal
+                                                                  : nullptr;
+    }
+    Node **child = FindChild(inner, bytes[depth]);
+    node = child == nullptr ? nullptr : *child;
+    ++depth;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Ищет в поддереве наименьший лист с ключом не меньше заданного.
+ *
+ * @param node Корень поддерева.
+ * @param key Граница поиска.
+ * @param depth Количество байт ключа, уже пройденных до node.
+ * @return Найденный лист или nullptr, если все ключи поддерева меньше key.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::Leaf *
+radix_map<Key, Type>::LowerBoundLeaf(Node *node, const key_type &key,
+                                     size_type depth) const noexcept {
+  if (node == nullptr) {
+    return nullptr;
+  }
+  if (node->kind_ == kLeaf) {
+    auto *leaf = static_cast<Leaf *>(node);
+    return key <= leaf->value_.first ? leaf : nullptr;
+  }
+
+  auto *inner = static_cast<InnerNode *>(node);
+  size_type mismatch = PrefixMismatch(inner, key, depth);
+  if (mismatch < inner->prefix_len_) {
+    // Ключ закончился внутри пути или его байт меньше - все ключи поддерева
+    // больше; байт больше - все ключи поддерева меньше.
+    if (depth + mismatch == key.size() ||
+        static_cast<unsigned char>(key[depth + mismatch]) <
+            PrefixByte(inner, depth, mismatch)) {
+      return MinLeaf(inner);
+    }
+    return nullptr;
+  }
+  depth += inner->prefix_len_;
+  if (depth == key.size()) {
+    return MinLeaf(inner);
+  }
+
+  auto byte = static_cast<unsigned char>(key[depth]);
+  Node **child = FindChild(inner, byte);
+  if (child != nullptr) {
+    Leaf *leaf = LowerBoundLeaf(*child, key, depth + 1);
+    if (leaf != nullptr) {
+      return leaf;
+    }
+  }
+  Node *next = FirstChildFrom(inner, byte + 1u);
+  return next == nullptr ? nullptr : MinLeaf(next);
+}
+
+/**
+ * @brief Встраивает новый лист в дерево. Ключа листа в дереве быть не должно.
+ *
+ * Возможны четыре случая: пустое место под байтом (лист добавляется в узел,
+ * при необходимости узел растет), встреченный лист (оба листа уходят в новый
+ * Node4 с их общим путем), расхождение внутри сжатого пути (путь делится
+ * новым Node4) и ключ, заканчивающийся ровно в узле (лист становится
+ * terminal_). Все выделения памяти выполняются до изменения дерева, поэтому
+ * при исключении дерево остается прежним.
+ *
+ * @param leaf Вставляемый лист.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::InsertLeaf(Leaf *leaf) {
+  const key_type &key = leaf->value_.first;
+  Node **ref = &root_;
+  size_type depth = 0;
+  while (true) {
+    Node *node = *ref;
+    if (node == nullptr) {
+      *ref = leaf;
+      return;
+    }
+
+    if (node->kind_ == kLeaf) {
+      auto *existing = static_cast<Leaf *>(node);
+      const key_type &other = existing->value_.first;
+      size_type common = depth;
+      size_type limit = std::min(key.size(), other.size());
+      while (common < limit && key[common] == other[common]) {
+        ++common;
+      }
+      auto *split = new Node4;
+      SetPrefix(split, key, depth, common - depth);
+      AttachLeaf(split, existing, common);
+      AttachLeaf(split, leaf, common);
+      *ref = split;
+      return;
+    }
+
+    auto *inner = static_cast<InnerNode *>(node);
+    size_type mismatch = PrefixMismatch(inner, key, depth);
+    if (mismatch < inner->prefix_len_) {
+      auto *split = new Node4;
+      SetPrefix(split, key, depth, mismatch);
+      unsigned char byte = PrefixByte(inner, depth, mismatch);
+      SetPrefix(inner, MinLeaf(inner)->value_.first, depth + mismatch + 1,
+                inner->prefix_len_ - mismatch - 1);
+      InsertSorted(split->keys_, split->children_, split->count_++, byte,
+                   inner);
+      AttachLeaf(split, leaf, depth + mismatch);
+      *ref = split;
+      return;
+    }
+    depth += inner->prefix_len_;
+
+    if (depth == key.size()) {
+      inner->terminal_ = leaf;
+      return;
+    }
+    auto byte = static_cast<unsigned char>(key[depth]);
+    Node **child = FindChild(inner, byte);
+    if (child == nullptr) {
+      AddChild(ref, inner, byte, leaf);
+      return;
+    }
+    ref = child;
+    ++depth;
+  }
+}
+
+/**
+ * @brief Отсоединяет лист от дерева и сжимает узлы на его пути.
+ *
+ * Список листьев и сам лист не затрагиваются.
+ *
+ * @param leaf Лист, находящийся в дереве.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::RemoveLeaf(Leaf *leaf) noexcept {
+  const key_type &key = leaf->value_.first;
+  Node **ref = &root_;
+  Node **parent_ref = nullptr;
+  size_type parent_depth = 0;
+  unsigned char parent_byte = 0;
+  size_type depth = 0;
+  while ((*ref)->kind_ != kLeaf) {
+    auto *inner = static_cast<InnerNode *>(*ref);
+    size_type node_depth = depth;
+    depth += inner->prefix_len_;
+    if (depth == key.size()) {
+      inner->terminal_ = nullptr;
+      Shrink(ref, node_depth);
+      return;
+    }
+    parent_ref = ref;
+    parent_depth = node_depth;
+    parent_byte = static_cast<unsigned char>(key[depth]);
+    ref = FindChild(inner, parent_byte);
+    ++depth;
+  }
+
+  if (parent_ref == nullptr) {
+    root_ = nullptr;
+    return;
+  }
+  RemoveChild(static_cast<InnerNode *>(*parent_ref), parent_byte);
+  Shrink(parent_ref, parent_depth);
+}
+
+/**
+ * @brief Копирует элементы другого контейнера в текущий (пустой).
+ *
+ * @param other Источник элементов.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::CopyFrom(const radix_map &other) {
+  for (const auto &item : other) {
+    TryEmplace(item.first, item);
+  }
+}
+
+/**
+ * @brief Перенаправляет крайние листья на собственный head_ после того, как
+ * head_ был скопирован из другого объекта.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::RelinkHead() noexcept {
+  if (size_ == 0) {
+    head_.prev_ = head_.next_ = &head_;
+  } else {
+    head_.next_->prev_ = &head_;
+    head_.prev_->next_ = &head_;
+  }
+}
+
+/**
+ * @brief Ищет потомка узла по очередному байту ключа.
+ *
+ * В Node16 все 16 байт сравниваются одной инструкцией SSE2; без SSE2
+ * используется линейный поиск.
+ *
+ * @param node Внутренний узел.
+ * @param byte Байт ключа.
+ * @return Адрес ячейки с потомком или nullptr.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::Node **
+radix_map<Key, Type>::FindChild(InnerNode *node, unsigned char byte) noexcept {
+  switch (node->kind_) {
+  case kNode4: {
+    auto *small = static_cast<Node4 *>(node);
+    for (unsigned i = 0; i < small->count_; ++i) {
+      if (small->keys_[i] == byte) {
+        return &small->children_[i];
+      }
+    }
+    return nullptr;
+  }
+  case kNode16: {
+    auto *medium = static_cast<Node16 *>(node);
+#if defined(__SSE2__)
+    __m128i match = _mm_cmpeq_epi8(
+        _mm_set1_epi8(static_cast<char>(byte)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(medium->keys_)));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(match)) &
+                    ((1u << medium->count_) - 1u);
+    return mask == 0 ? nullptr : &medium->children_[__builtin_ctz(mask)];
+#else
+    for (unsigned i = 0; i < medium->count_; ++i) {
+      if (medium->keys_[i] == byte) {
+        return &medium->children_[i];
+      }
+    }
+    return nullptr;
+#endif
+  }
+  case kNode48: {
+    auto *large = static_cast<Node48 *>(node);
+    unsigned slot = large->index_[byte];
+    return slot == 0 ? nullptr : &large->children_[slot - 1];
+  }
+  default: {
+    auto *full = static_cast<Node256 *>(node);
+    return full->children_[byte] == nullptr ? nullptr : &full->children_[byte];
+  }
+  }
+}
+
+/**
+ * @brief Возвращает потомка с наименьшим байтом не меньше from.
+ *
+ * @param node Внутренний узел.
+ * @param from Нижняя граница байта (256 - потомков нет).
+ * @return Потомок или nullptr.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::Node *
+radix_map<Key, Type>::FirstChildFrom(InnerNode *node, unsigned from) noexcept {
+  switch (node->kind_) {
+  case kNode4: {
+    auto *small = static_cast<Node4 *>(node);
+    for (unsigned i = 0; i < small->count_; ++i) {
+      if (small->keys_[i] >= from) {
+        return small->children_[i];
+      }
+    }
+    return nullptr;
+  }
+  case kNode16: {
+    auto *medium = static_cast<Node16 *>(node);
+    for (unsigned i = 0; i < medium->count_; ++i) {
+      if (medium->keys_[i] >= from) {
+        return medium->children_[i];
+      }
+    }
+    return nullptr;
+  }
+  case kNode48: {
+    auto *large = static_cast<Node48 *>(node);
+    for (unsigned byte = from; byte < 256; ++byte) {
+      if (large->index_[byte] != 0) {
+        return large->children_[large->index_[byte] - 1];
+      }
+    }
+    return nullptr;
+  }
+  default: {
+    auto *full = static_cast<Node256 *>(node);
+    for (unsigned byte = from; byte < 256; ++byte) {
+      if (full->children_[byte] != nullptr) {
+        return full->children_[byte];
+      }
+    }
+    return nullptr;
+  }
+  }
+}
+
+/**
+ * @brief Добавляет потомка под новым байтом.
+ *
+ * Заполненный узел сначала заменяется узлом следующего размера (новый узел
+ * выделяется до изменения старого), затем добавление повторяется.
+ *
+ * @param ref Ячейка родителя, хранящая node; обновляется при росте узла.
+ * @param node Внутренний узел без потомка под byte.
+ * @param byte Байт ключа.
+ * @param child Добавляемый потомок.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::AddChild(Node **ref, InnerNode *node,
+                                    unsigned char byte, Node *child) {
+  switch (node->kind_) {
+  case kNode4: {
+    auto *small = static_cast<Node4 *>(node);
+    if (small->count_ < 4) {
+      InsertSorted(small->keys_, small->children_, small->count_++, byte,
+                   child);
+      return;
+    }
+    auto *grown = new Node16;
+    CopyHeader(grown, small);
+    std::memcpy(grown->keys_, small->keys_, sizeof(small->keys_));
+    std::memcpy(grown->children_, small->children_, sizeof(small->children_));
+    *ref = grown;
+    delete small;
+    AddChild(ref, grown, byte, child);
+    return;
+  }
+  case kNode16: {
+    auto *medium = static_cast<Node16 *>(node);
+    if (medium->count_ < 16) {
+      InsertSorted(medium->keys_, medium->children_, medium->count_++, byte,
+                   child);
+      return;
+    }
+    auto *grown = new Node48;
+    CopyHeader(grown, medium);
+    for (unsigned i = 0; i < 16; ++i) {
+      grown->index_[medium->keys_[i]] = static_cast<unsigned char>(i + 1);
+      grown->children_[i] = medium->children_[i];
+    }
+    *ref = grown;
+    delete medium;
+    AddChild(ref, grown, byte, child);
+    return;
+  }
+  case kNode48: {
+    auto *large = static_cast<Node48 *>(node);
+    if (large->count_ < 48) {
+      // После удалений свободные ячейки могут быть в любом месте массива.
+      unsigned slot = 0;
+      while (large->children_[slot] != nullptr) {
+        ++slot;
+      }
+      large->children_[slot] = child;
+      large->index_[byte] = static_cast<unsigned char>(slot + 1);
+      ++large->count_;
+      return;
+    }
+    auto *grown = new Node256;
+    CopyHeader(grown, large);
+    for (unsigned b = 0; b < 256; ++b) {
+      if (large->index_[b] != 0) {
+        grown->children_[b] = large->children_[large->index_[b] - 1];
+      }
+    }
+    *ref = grown;
+    delete large;
+    AddChild(ref, grown, byte, child);
+    return;
+  }
+  default: {
+    auto *full = static_cast<Node256 *>(node);
+    full->children_[byte] = child;
+    ++full->count_;
+    return;
+  }
+  }
+}
+
+/**
+ * @brief Вставляет пару байт-потомок в отсортированные массивы Node4/Node16.
+ *
+ * @param keys Массив байт.
+ * @param children Массив потомков.
+ * @param count Текущее количество потомков (меньше емкости).
+ * @param byte Байт нового потомка.
+ * @param child Новый потомок.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::InsertSorted(unsigned char *keys, Node **children,
+                                        std::uint16_t count,
+                                        unsigned char byte,
+                                        Node *child) noexcept {
+  unsigned position = count;
+  while (position > 0 && keys[position - 1] > byte) {
+    keys[position] = keys[position - 1];
+    children[position] = children[position - 1];
+    --position;
+  }
+  keys[position] = byte;
+  children[position] = child;
+}
+
+/**
+ * @brief Убирает потомка под байтом. Размер узла не меняется.
+ *
+ * @param node Внутренний узел.
+ * @param byte Байт удаляемого потомка.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::RemoveChild(InnerNode *node,
+                                       unsigned char byte) noexcept {
+  unsigned char *keys = nullptr;
+  Node **children = nullptr;
+  switch (node->kind_) {
+  case kNode4:
+    keys = static_cast<Node4 *>(node)->keys_;
+    children = static_cast<Node4 *>(node)->children_;
+    break;
+  case kNode16:
+    keys = static_cast<Node16 *>(node)->keys_;
+    children = static_cast<Node16 *>(node)->children_;
+    break;
+  case kNode48: {
+    auto *large = static_cast<Node48 *>(node);
+    large->children_[large->index_[byte] - 1] = nullptr;
+    large->index_[byte] = 0;
+    --large->count_;
+    return;
+  }
+  default:
+    static_cast<Node256 *>(node)->children_[byte] = nullptr;
+    --node->count_;
+    return;
+  }
+
+  unsigned position = 0;
+  while (keys[position] != byte) {
+    ++position;
+  }
+  for (--node->count_; position < node->count_; ++position) {
+    keys[position] = keys[position + 1];
+    children[position] = children[position + 1];
+  }
+}
+
+/**
+ * @brief Восстанавливает инварианты узла после удаления потомка или
+ * terminal_.
+ *
+ * Узел без потомков заменяется своим terminal_, узел с единственным
+ * потомком и без terminal_ - этим потомком (сжатые пути склеиваются), а
+ * малозаполненный узел - узлом меньшего размера. Уменьшение необязательно,
+ * поэтому при нехватке памяти узел остается прежним.
+ *
+ * @param ref Ячейка родителя, хранящая узел.
+ * @param depth Количество байт ключа до начала сжатого пути узла.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::Shrink(Node **ref, size_type depth) noexcept {
+  auto *node = static_cast<InnerNode *>(*ref);
+  if (node->count_ == 0) {
+    *ref = node->terminal_;
+    DeleteInner(node);
+    return;
+  }
+
+  if (node->count_ == 1 && node->terminal_ == nullptr) {
+    Node *child = FirstChildFrom(node, 0);
+    if (child->kind_ != kLeaf) {
+      auto *inner = static_cast<InnerNode *>(child);
+      SetPrefix(inner, MinLeaf(inner)->value_.first, depth,
+                node->prefix_len_ + 1 + inner->prefix_len_);
+    }
+    *ref = child;
+    DeleteInner(node);
+    return;
+  }
+
+  if (node->kind_ == kNode16 && node->count_ <= 3) {
+    auto *medium = static_cast<Node16 *>(node);
+    auto *shrunk = new (std::nothrow) Node4;
+    if (shrunk != nullptr) {
+      CopyHeader(shrunk, medium);
+      std::memcpy(shrunk->keys_, medium->keys_, medium->count_);
+      std::memcpy(shrunk->children_, medium->children_,
+                  medium->count_ * sizeof(Node *));
+      *ref = shrunk;
+      delete medium;
+    }
+  } else if (node->kind_ == kNode48 && node->count_ <= 12) {
+    auto *large = static_cast<Node48 *>(node);
+    auto *shrunk = new (std::nothrow) Node16;
+    if (shrunk != nullptr) {
+      CopyHeader(shrunk, large);
+      unsigned position = 0;
+      for (unsigned b = 0; b < 256; ++b) {
+        if (large->index_[b] != 0) {
+          shrunk->keys_[position] = static_cast<unsigned char>(b);
+          shrunk->children_[position++] =
+              large->children_[large->index_[b] - 1];
+        }
+      }
+      *ref = shrunk;
+      delete large;
+    }
+  } else if (node->kind_ == kNode256 && node->count_ <= 37) {
+    auto *full = static_cast<Node256 *>(node);
+    auto *shrunk = new (std::nothrow) Node48;
+    if (shrunk != nullptr) {
+      CopyHeader(shrunk, full);
+      unsigned slot = 0;
+      for (unsigned b = 0; b < 256; ++b) {
+        if (full->children_[b] != nullptr) {
+          shrunk->children_[slot] = full->children_[b];
+          shrunk->index_[b] = static_cast<unsigned char>(++slot);
+        }
+      }
+      *ref = shrunk;
+      delete full;
+    }
+  }
+}
+
+/**
+ * @brief Помещает лист в новый Node4: под байтом ключа на глубине depth или
+ * в terminal_, если ключ на этой глубине заканчивается.
+ *
+ * @param node Узел, в котором есть место.
+ * @param leaf Лист.
+ * @param depth Глубина, на которой узел выбирает потомка.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::AttachLeaf(Node4 *node, Leaf *leaf,
+                                      size_type depth) noexcept {
+  const key_type &key = leaf->value_.first;
+  if (key.size() == depth) {
+    node->terminal_ = leaf;
+  } else {
+    InsertSorted(node->keys_, node->children_, node->count_++,
+                 static_cast<unsigned char>(key[depth]), leaf);
+  }
+}
+
+/**
+ * @brief Возвращает лист с наименьшим ключом в поддереве.
+ *
+ * terminal_ узла меньше всех ключей его потомков, поэтому проверяется
+ * первым.
+ *
+ * @param node Непустое поддерево.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::Leaf *
+radix_map<Key, Type>::MinLeaf(Node *node) noexcept {
+  while (node->kind_ != kLeaf) {
+    auto *inner = static_cast<InnerNode *>(node);
+    if (inner->terminal_ != nullptr) {
+      return inner->terminal_;
+    }
+    node = FirstChildFrom(inner, 0);
+  }
+  return static_cast<Leaf *>(node);
+}
+
+/**
+ * @brief Находит первое расхождение сжатого пути узла с ключом.
+ *
+ * Байты за пределами kMaxPrefix берутся из ключа любого листа поддерева.
+ *
+ * @param node Внутренний узел.
+ * @param key Ключ.
+ * @param depth Позиция ключа, с которой начинается путь узла.
+ * @return Длина совпадения; prefix_len_, если путь совпал целиком.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::size_type
+radix_map<Key, Type>::PrefixMismatch(InnerNode *node, const key_type &key,
+                                     size_type depth) noexcept {
+  size_type limit = std::min<size_type>(node->prefix_len_, key.size() - depth);
+  size_type stored = std::min(limit, kMaxPrefix);
+  const auto *bytes = reinterpret_cast<const unsigned char *>(key.data());
+  size_type index = 0;
+  while (index < stored && node->prefix_[index] == bytes[depth + index]) {
+    ++index;
+  }
+  if (index == kMaxPrefix && limit > kMaxPrefix) {
+    const key_type &full = MinLeaf(node)->value_.first;
+    while (index < limit && full[depth + index] == key[depth + index]) {
+      ++index;
+    }
+  }
+  return index;
+}
+
+/**
+ * @brief Возвращает байт сжатого пути узла по индексу.
+ *
+ * @param node Внутренний узел.
+ * @param depth Позиция ключа, с которой начинается путь узла.
+ * @param index Индекс байта внутри пути.
+ */
+template <typename Key, typename Type>
+unsigned char radix_map<Key, Type>::PrefixByte(InnerNode *node,
+                                               size_type depth,
+                                               size_type index) noexcept {
+  if (index < kMaxPrefix) {
+    return node->prefix_[index];
+  }
+  return static_cast<unsigned char>(MinLeaf(node)->value_.first[depth + index]);
+}
+
+/**
+ * @brief Задает сжатый путь узла: длину и первые kMaxPrefix его байт.
+ *
+ * @param node Внутренний узел.
+ * @param source Ключ, содержащий путь.
+ * @param depth Позиция начала пути в source.
+ * @param length Длина пути.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::SetPrefix(InnerNode *node, const key_type &source,
+                                     size_type depth,
+                                     size_type length) noexcept {
+  node->prefix_len_ = static_cast<std::uint32_t>(length);
+  std::memcpy(node->prefix_, source.data() + depth,
+              std::min(length, kMaxPrefix));
+}
+
+/**
+ * @brief Копирует общий заголовок при смене размера узла.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::CopyHeader(InnerNode *to,
+                                      const InnerNode *from) noexcept {
+  to->count_ = from->count_;
+  to->prefix_len_ = from->prefix_len_;
+  std::memcpy(to->prefix_, from->prefix_, kMaxPrefix);
+  to->terminal_ = from->terminal_;
+}
+
+/**
+ * @brief Освобождает внутренний узел (без потомков) по его фактическому типу.
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::DeleteInner(InnerNode *node) noexcept {
+  switch (node->kind_) {
+  case kNode4:
+    delete static_cast<Node4 *>(node);
+    break;
+  case kNode16:
+    delete static_cast<Node16 *>(node);
+    break;
+  case kNode48:
+    delete static_cast<Node48 *>(node);
+    break;
+  default:
+    delete static_cast<Node256 *>(node);
+    break;
+  }
+}
+
+/**
+ * @brief Вызывает func для каждого потомка узла (порядок байт не
+ * гарантируется).
+ *
+ * @param node Внутренний узел.
+ * @param func Функция от Node *.
+ */
+template <typename Key, typename Type>
+template <typename Function>
+void radix_map<Key, Type>::ForEachChild(InnerNode *node, Function func) {
+  Node **children = nullptr;
+  unsigned capacity = 0;
+  switch (node->kind_) {
+  case kNode4:
+    children = static_cast<Node4 *>(node)->children_;
+    capacity = node->count_;
+    break;
+  case kNode16:
+    children = static_cast<Node16 *>(node)->children_;
+    capacity = node->count_;
+    break;
+  case kNode48:
+    children = static_cast<Node48 *>(node)->children_;
+    capacity = 48;
+    break;
+  default:
+    children = static_cast<Node256 *>(node)->children_;
+    capacity = 256;
+    break;
+  }
+  for (unsigned i = 0; i < capacity; ++i) {
+    if (children[i] != nullptr) {
+      func(children[i]);
+    }
+  }
+}
+
+/**
+ * @brief Рекурсивно освобождает поддерево вместе с листьями.
+ *
+ * Глубина рекурсии ограничена длиной ключа.
+ *
+ * @param node Корень поддерева (может быть nullptr).
+ */
+template <typename Key, typename Type>
+void radix_map<Key, Type>::Destroy(Node *node) noexcept {
+  if (node == nullptr) {
+    return;
+  }
+  if (node->kind_ == kLeaf) {
+    delete static_cast<Leaf *>(node);
+    return;
+  }
+  auto *inner = static_cast<InnerNode *>(node);
+  ForEachChild(inner, [](Node *child) { Destroy(child); });
+  Destroy(inner->terminal_);
+  DeleteInner(inner);
+}
+
+/**
+ * @brief Считает байты, занятые поддеревом.
+ *
+ * Буфер ключа учитывается, только если строка хранит его в куче, а не
+ * внутри самого объекта (short string optimization).
+ *
+ * @param node Корень поддерева (может быть nullptr).
+ * @return Количество байт.
+ */
+template <typename Key, typename Type>
+typename radix_map<Key, Type>::size_type
+radix_map<Key, Type>::SubtreeMemory(const Node *node) noexcept {
+  if (node == nullptr) {
+    return 0;
+  }
+  if (node->kind_ == kLeaf) {
+    const key_type &key = static_cast<const Leaf *>(node)->value_.first;
+    const auto *object = reinterpret_cast<const char *>(&key);
+    bool on_heap =
+        key.data() < object || key.data() >= object + sizeof(key_type);
+    return sizeof(Leaf) + (on_heap ? key.capacity() + 1 : 0);
+  }
+
+  auto *inner = static_cast<InnerNode *>(const_cast<Node *>(node));
+  size_type bytes = 0;
+  switch (inner->kind_) {
+  case kNode4:
+    bytes = sizeof(Node4);
+    break;
+  case kNode16:
+    bytes = sizeof(Node16);
+    break;
+  case kNode48:
+    bytes = sizeof(Node48);
+    break;
+  default:
+    bytes = sizeof(Node256);
+    break;
+  }
+  ForEachChild(inner, [&bytes](Node *child) { bytes += SubtreeMemory(child); });
+  return bytes + SubtreeMemory(inner->terminal_);
+}
+
+} // namespace s21
@@ -0,0 +1,6 @@
+#ifndef S21_CONTAINERS_S21_CONTAINERSPLUS_H_
+#define S21_CONTAINERS_S21_CONTAINERSPLUS_H_
+
+#include "array/s21_array.h"
+
+#endif // S21_CONTAINERS_S21_CONTAINERSPLUS_H_
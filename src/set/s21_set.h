@@ -1,21 +1,23 @@
 #ifndef CPP2_S21_CONTAINERS_1_SET_H
 #define CPP2_S21_CONTAINERS_1_SET_H
-#include "../tree/RedBlackTree.h"
+#include "../tree/OrderedTree.h"
 #include <cassert>
 #include <list>
 #include <vector>
 
 namespace s21 {
-template <typename Key> class set {
+template <typename Key, typename Options = DefaultTreeOptions> class set {
 public:
   using key_type = Key;
   using value_type = key_type;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using tree_type = RedBlackTree<value_type>;
+  using tree_type = OrderedTree<value_type, std::less<value_type>, Options>;
   using iterator = typename tree_type::iterator;
   using const_iterator = typename tree_type::const_iterator;
   using size_type = std::size_t;
+  using node_type = typename tree_type::node_type;
+  using insert_return_type = typename tree_type::insert_return_type;
   // Конструкторы и Деструктор
   set();
   set(std::initializer_list<value_type> const &items);
@@ -34,6 +36,30 @@ public:
     return !(lhs == rhs);
   }
 
+  // Теоретико-множественные операции за O(n + m): упорядоченные обходы
+  // сливаются, а результат строится снизу вверх за один проход. С
+  // ParallelTreeOptions (TreeParallel.h) большие множества сливаются
+  // параллельно.
+  friend set set_union(const set &lhs, const set &rhs) {
+    return set(tree_type::Combine(lhs.tree_, rhs.tree_,
+                                  SetOperation::kUnion));
+  }
+
+  friend set set_intersection(const set &lhs, const set &rhs) {
+    return set(tree_type::Combine(lhs.tree_, rhs.tree_,
+                                  SetOperation::kIntersection));
+  }
+
+  friend set set_difference(const set &lhs, const set &rhs) {
+    return set(tree_type::Combine(lhs.tree_, rhs.tree_,
+                                  SetOperation::kDifference));
+  }
+
+  friend set symmetric_difference(const set &lhs, const set &rhs) {
+    return set(tree_type::Combine(lhs.tree_, rhs.tree_,
+                                  SetOperation::kSymmetricDifference));
+  }
+
   // Методы доступа к элементам и информации
   iterator begin() noexcept;
   const_iterator begin() const noexcept;
@@ -46,11 +72,24 @@ public:
   // Модификация контейнера
   void clear() noexcept;
   std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
   void erase(iterator pos) noexcept;
   size_type erase(const key_type &key) noexcept;
+  iterator erase(iterator first, iterator last) noexcept;
+  size_type erase(const key_type &lo, const key_type &hi) noexcept;
+  template <typename Predicate> size_type erase_if(Predicate pred);
+  node_type extract(iterator pos) noexcept;
+  node_type extract(const key_type &key) noexcept;
+  insert_return_type insert(node_type &&node);
   void swap(set &other) noexcept;
   void merge(set &other) noexcept;
 
+  // Те же операции на месте: узлы текущего множества используются повторно
+  set &operator|=(const set &other);
+  set &operator&=(const set &other);
+  set &operator-=(const set &other);
+  set &operator^=(const set &other);
+
   // Поиск и проверка наличия элементов
   iterator find(const key_type &key) noexcept;
   const_iterator find(const key_type &key) const noexcept;
@@ -64,8 +103,25 @@ public:
   template <typename InputIt>
   size_type insert_many(InputIt first, InputIt last) noexcept;
 
+  // Счетчики горячего пути (заполнены только при Options::stats)
+  ContainerStats stats() const noexcept;
+  void reset_stats() noexcept;
+
+  // Память, занятая контейнером вместе с узлами, в байтах (за O(n log n))
+  [[nodiscard]] size_type memory_usage() const;
+
+  // Уплотнение: узлы переносятся в один непрерывный блок по порядку ключей
+  // или в порядке ван Эмде Боаса, целиком или порциями по max_nodes узлов
+  // (compact_step вернет true, когда проход закончен). Итераторы и ссылки
+  // на перенесенные элементы становятся недействительными.
+  void compact(CompactOrder order = CompactOrder::kInOrder);
+  bool compact_step(size_type max_nodes,
+                    CompactOrder order = CompactOrder::kInOrder);
+
 private:
-  tree_type *tree_;
+  explicit set(tree_type &&tree);
+
+  tree_type tree_;
 };
 
 } // namespace s21
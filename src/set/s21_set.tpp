@@ -4,12 +4,14 @@ namespace s21 {
  * @brief Создает пустой контейнер типа set.
  *
  * Конструктор инициализирует пустой экземпляр контейнера типа set. Внутренняя
- * структура данных, представляющая дерево красно-черного типа, инициализируется
- * через создание нового экземпляра tree_type с помощью оператора new.
+ * структура данных, представляющая дерево красно-черного типа, хранится в
+ * самом контейнере вместе со своим фиктивным узлом, поэтому пустое множество
+ * не выделяет память.
  *
  * @tparam Key Тип ключа, хранимого в контейнере.
  */
-template <typename Key> set<Key>::set() : tree_(new tree_type{}) {}
+template <typename Key, typename Options>
+set<Key, Options>::set() : tree_() {}
 
 /**
  * @brief Конструктор множества на основе списка инициализации.
@@ -20,8 +22,8 @@ template <typename Key> set<Key>::set() : tree_(new tree_type{}) {}
  *
  * @param items Список инициализации элементами для создания множества.
  */
-template <typename Key>
-set<Key>::set(std::initializer_list<value_type> const &items) : set() {
+template <typename Key, typename Options>
+set<Key, Options>::set(std::initializer_list<value_type> const &items) : set() {
   for (auto item : items) {
     // Проверяем, содержится ли элемент уже в множестве
     if (!contains(item)) {
@@ -31,6 +33,15 @@ set<Key>::set(std::initializer_list<value_type> const &items) : set() {
   }
 }
 
+/**
+ * @brief Создает множество, забирая готовое дерево.
+ *
+ * @param tree Дерево с уникальными ключами.
+ */
+template <typename Key, typename Options>
+set<Key, Options>::set(tree_type &&tree)
+    : tree_(std::move(tree)) {}
+
 /**
  * @brief Создает копию контейнера типа set из другого контейнера.
  *
@@ -38,15 +49,20 @@ set<Key>::set(std::initializer_list<value_type> const &items) : set() {
  * элементами из другого существующего контейнера типа set. Внутренняя структура
  * данных, представляющая дерево красно-черного типа, также инициализируется.
  *
+ * Узлы копии лежат одним общим блоком, который держит любой оставшийся в
+ * нем узел; после удаления большей части элементов память блока
+ * возвращает compact().
+ *
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @param other Ссылка на другой контейнер типа set, из которого выполняется
  * копирование.
  */
-template <typename Key> set<Key>::set(const set &other) : set() {
+template <typename Key, typename Options>
+set<Key, Options>::set(const set &other) : set() {
   // Проверка на самоприсваивание
   if (this != &other) {
     // Копирование содержимого дерева из другого контейнера
-    *tree_ = *other.tree_;
+    tree_ = other.tree_;
   }
 }
 /**
@@ -60,9 +76,9 @@ template <typename Key> set<Key>::set(const set &other) : set() {
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @param other Контейнер, из которого будет перемещено содержимое.
  */
-template <typename Key>
-set<Key>::set(set &&other) noexcept
-    : tree_(new tree_type(std::move(*other.tree_))) {}
+template <typename Key, typename Options>
+set<Key, Options>::set(set &&other) noexcept
+    : tree_(std::move(other.tree_)) {}
 
 /**
  * @brief Присваивание контейнера с использованием оператора присваивания.
@@ -77,13 +93,14 @@ set<Key>::set(set &&other) noexcept
  * @param other Контейнер типа set, из которого копируются элементы.
  * @return Ссылка на текущий экземпляр контейнера после присваивания.
  */
-template <typename Key> set<Key> &set<Key>::operator=(const set &other) {
+template <typename Key, typename Options>
+set<Key, Options> &set<Key, Options>::operator=(const set &other) {
   // Проверка на self-assignment
   if (this != &other) {
     // Очищаем текущий контейнер
-    tree_->Clear();
+    tree_.Clear();
     // Копируем элементы из другого контейнера
-    *tree_ = *other.tree_;
+    tree_ = other.tree_;
   }
   return *this;
 }
@@ -93,7 +110,7 @@ template <typename Key> set<Key> &set<Key>::operator=(const set &other) {
  *
  * Этот оператор присваивания переносит содержимое rvalue-контейнера типа set
  * в текущий контейнер. Если контейнеры не совпадают (this != &other),
- * происходит обмен внутренних структур данных между контейнерами.
+ * текущие элементы удаляются, а узлы другого контейнера переходят к этому.
  * Это позволяет эффективно перенести ресурсы между контейнерами без
  * копирования.
  *
@@ -101,11 +118,12 @@ template <typename Key> set<Key> &set<Key>::operator=(const set &other) {
  * @param other Rvalue-контейнер, из которого будет произведено перемещение.
  * @return Ссылка на текущий контейнер после перемещения.
  */
-template <typename Key> set<Key> &set<Key>::operator=(set &&other) noexcept {
+template <typename Key, typename Options>
+set<Key, Options> &set<Key, Options>::operator=(set &&other) noexcept {
   // Проверяем, что контейнеры не совпадают
   if (this != &other) {
-    // Обмениваем внутренние структуры данных между контейнерами
-    std::swap(tree_, other.tree_);
+    // Забираем узлы дерева другого контейнера
+    tree_ = std::move(other.tree_);
   }
   return *this;
 }
@@ -113,20 +131,12 @@ template <typename Key> set<Key> &set<Key>::operator=(set &&other) noexcept {
 /**
  * @brief Деструктор контейнера типа set.
  *
- * Деструктор освобождает выделенную память для внутренней структуры данных
- * (красно-черное дерево), если она была создана. Это происходит путем
- * удаления указателя на объект дерева и установки его в nullptr.
+ * Деструктор освобождает память узлов внутренней структуры данных
+ * (красно-черного дерева); само дерево хранится в контейнере.
  *
  * @tparam Key Тип ключа, хранимого в контейнере.
  */
-template <typename Key> set<Key>::~set() {
-  // Проверяем, было ли создано дерево
-  if (tree_) {
-    // Освобождаем память и устанавливаем указатель в nullptr
-    delete tree_;
-    tree_ = nullptr;
-  }
-}
+template <typename Key, typename Options> set<Key, Options>::~set() = default;
 
 /**
  * @brief Возвращает итератор, указывающий на начало контейнера.
@@ -138,8 +148,9 @@ template <typename Key> set<Key>::~set() {
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @return Итератор, указывающий на начало контейнера.
  */
-template <typename Key> typename set<Key>::iterator set<Key>::begin() noexcept {
-  return tree_->Begin();
+template <typename Key, typename Options>
+typename set<Key, Options>::iterator set<Key, Options>::begin() noexcept {
+  return tree_.Begin();
 }
 
 /**
@@ -152,9 +163,10 @@ template <typename Key> typename set<Key>::iterator set<Key>::begin() noexcept {
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @return Константный итератор, указывающий на начало контейнера.
  */
-template <typename Key>
-typename set<Key>::const_iterator set<Key>::begin() const noexcept {
-  return tree_->Begin();
+template <typename Key, typename Options>
+typename set<Key, Options>::const_iterator
+set<Key, Options>::begin() const noexcept {
+  return tree_.Begin();
 }
 
 /**
@@ -167,8 +179,9 @@ typename set<Key>::const_iterator set<Key>::begin() const noexcept {
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @return Итератор, указывающий на конец контейнера.
  */
-template <typename Key> typename set<Key>::iterator set<Key>::end() noexcept {
-  return tree_->End();
+template <typename Key, typename Options>
+typename set<Key, Options>::iterator set<Key, Options>::end() noexcept {
+  return tree_.End();
 }
 
 /**
@@ -182,9 +195,10 @@ template <typename Key> typename set<Key>::iterator set<Key>::end() noexcept {
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @return Константный итератор, указывающий на конец контейнера.
  */
-template <typename Key>
-typename set<Key>::const_iterator set<Key>::end() const noexcept {
-  return tree_->End();
+template <typename Key, typename Options>
+typename set<Key, Options>::const_iterator
+set<Key, Options>::end() const noexcept {
+  return tree_.End();
 }
 
 /**
@@ -196,11 +210,10 @@ typename set<Key>::const_iterator set<Key>::end() const noexcept {
  *
  * @return `true`, если контейнер пуст, `false` в противном случае.
  */
-template <typename Key> inline bool set<Key>::empty() const noexcept {
-  // Проверка, существует ли внутренняя структура данных
-  // Если она существует, используем метод Empty() для определения пустоты
-  // Если она не существует, считаем, что контейнер пуст
-  return tree_ ? tree_->Empty() : true;
+template <typename Key, typename Options>
+inline bool set<Key, Options>::empty() const noexcept {
+  // Используем метод Empty() внутренней структуры данных
+  return tree_.Empty();
 }
 
 /**
@@ -209,16 +222,14 @@ template <typename Key> inline bool set<Key>::empty() const noexcept {
  * Этот метод возвращает текущий размер (количество элементов) контейнера
  * типа set. Он использует метод Size() внутренней структуры данных,
  * представляющей дерево красно-черного типа, чтобы получить размер.
- * Если внутренняя структура данных не инициализирована (равна nullptr),
- * метод вернет 0.
  *
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @return Текущий размер контейнера.
  */
-template <typename Key>
-inline typename set<Key>::size_type set<Key>::size() const noexcept {
-  // Проверяем, инициализирована ли внутренняя структура данных
-  return tree_ ? tree_->Size() : 0;
+template <typename Key, typename Options>
+inline typename set<Key, Options>::size_type
+set<Key, Options>::size() const noexcept {
+  return tree_.Size();
 }
 
 /**
@@ -227,38 +238,32 @@ inline typename set<Key>::size_type set<Key>::size() const noexcept {
  *
  * Этот метод возвращает максимальное количество элементов, которое контейнер
  * типа set может содержать. Он делегирует запрос к внутренней структуре данных
- * - дереву красно-черного типа. Если дерево не инициализировано, метод
- * возвращает значение, указывающее на отсутствие дерева (например, 0).
+ * - дереву красно-черного типа.
  *
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @return Максимальное количество элементов, которое контейнер может содержать.
  */
-template <typename Key>
-typename set<Key>::size_type set<Key>::max_size() const noexcept {
-  if (tree_) {
-    // Возвращаем максимальное количество элементов из дерева
-    return tree_->MaxSize();
-  }
-  // Если дерево не инициализировано, возвращаем значение, указывающее на
-  // отсутствие дерева
-  return 0; // или другое значение, которое бы обозначало отсутствие дерева
+template <typename Key, typename Options>
+typename set<Key, Options>::size_type
+set<Key, Options>::max_size() const noexcept {
+  // Возвращаем максимальное количество элементов из дерева
+  return tree_.MaxSize();
 }
 
 /**
  * @brief Очищает контейнер, удаляя все элементы из него.
  *
- * Этот метод освобождает память, занятую текущим внутренним деревом, и
- * создает новое пустое дерево для хранения элементов. Операция выполняется
- * без генерации исключений и помечена как noexcept, что указывает на отсутствие
- * исключений во время выполнения.
+ * Этот метод освобождает память, занятую узлами внутреннего дерева, и
+ * оставляет дерево пустым. Операция выполняется без генерации исключений и
+ * помечена как noexcept, что указывает на отсутствие исключений во время
+ * выполнения.
  *
  * @tparam Key Тип ключа, хранимого в контейнере.
  */
-template <typename Key> void set<Key>::clear() noexcept {
-  // Освобождение памяти, занимаемой текущим деревом
-  delete tree_;
-  // Создание нового пустого дерева
-  tree_ = new tree_type{};
+template <typename Key, typename Options>
+void set<Key, Options>::clear() noexcept {
+  // Освобождение памяти, занимаемой узлами дерева
+  tree_.Clear();
 }
 
 /**
@@ -275,11 +280,25 @@ template <typename Key> void set<Key>::clear() noexcept {
  * @return Пара, содержащая итератор на вставленный элемент и флаг успешности
  * вставки.
  */
-template <typename Key>
-std::pair<typename set<Key>::iterator, bool>
-set<Key>::insert(const value_type &value) {
+template <typename Key, typename Options>
+std::pair<typename set<Key, Options>::iterator, bool>
+set<Key, Options>::insert(const value_type &value) {
   // Вызов метода вставки с условием уникальности из внутреннего дерева
-  return tree_->InsertUnique(value);
+  return tree_.InsertUnique(value);
+}
+
+/**
+ * @brief Вставляет элемент перемещением, если его еще нет в контейнере.
+ *
+ * Если такой элемент уже есть, value остается нетронутым.
+ *
+ * @param value Значение для вставки.
+ * @return Пара, содержащая итератор на элемент и флаг успешности вставки.
+ */
+template <typename Key, typename Options>
+std::pair<typename set<Key, Options>::iterator, bool>
+set<Key, Options>::insert(value_type &&value) {
+  return tree_.InsertUnique(std::move(value));
 }
 
 /**
@@ -292,13 +311,14 @@ set<Key>::insert(const value_type &value) {
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @param position Итератор, указывающий на позицию удаляемого элемента.
  */
-template <typename Key> void set<Key>::erase(iterator position) noexcept {
+template <typename Key, typename Options>
+void set<Key, Options>::erase(iterator position) noexcept {
   // Проверка, является ли позиция итератором, указывающим за конец
   if (position == end()) {
     return; // Просто завершаем метод, не выполняя никаких действий
   }
   // Вызываем метод Erase из внутренней структуры данных
-  tree_->Erase(position);
+  tree_.Erase(position);
 }
 
 /**
@@ -313,8 +333,9 @@ template <typename Key> void set<Key>::erase(iterator position) noexcept {
  * @param key Ключ элемента, который нужно удалить.
  * @return Количество удаленных элементов (0 или 1).
  */
-template <typename Key>
-typename set<Key>::size_type set<Key>::erase(const key_type &key) noexcept {
+template <typename Key, typename Options>
+typename set<Key, Options>::size_type
+set<Key, Options>::erase(const key_type &key) noexcept {
   // Поиск элемента по ключу
   auto it = find(key);
   if (it != end()) {
@@ -324,6 +345,98 @@ typename set<Key>::size_type set<Key>::erase(const key_type &key) noexcept {
   }
   return 0;
 }
+
+/**
+ * @brief Удаляет из множества элементы диапазона [first, last).
+ *
+ * Диапазон вырезается из дерева целиком за O(k + log n), без поочередного
+ * удаления и балансировки для каждого из k элементов.
+ *
+ * @param first Итератор на первый удаляемый элемент.
+ * @param last Итератор на элемент, следующий за последним удаляемым.
+ * @return Итератор на элемент, на который указывал last.
+ */
+template <typename Key, typename Options>
+typename set<Key, Options>::iterator
+set<Key, Options>::erase(iterator first, iterator last) noexcept {
+  return tree_.Erase(first, last);
+}
+
+/**
+ * @brief Удаляет из множества все элементы из полуинтервала [lo, hi).
+ *
+ * @param lo Нижняя граница (включительно).
+ * @param hi Верхняя граница (не включительно).
+ * @return Количество удаленных элементов.
+ */
+template <typename Key, typename Options>
+typename set<Key, Options>::size_type
+set<Key, Options>::erase(const key_type &lo, const key_type &hi) noexcept {
+  if (!(lo < hi)) {
+    return 0;
+  }
+  size_type old_size = size();
+  tree_.Erase(tree_.LowerBound(lo), tree_.LowerBound(hi));
+  return old_size - size();
+}
+
+/**
+ * @brief Удаляет из множества все элементы, для которых предикат вернул
+ * true. Оставшиеся элементы перестраиваются в сбалансированное дерево один
+ * раз за O(n).
+ *
+ * @tparam Predicate Унарный предикат от const value_type &.
+ * @param pred Предикат, отбирающий удаляемые элементы.
+ * @return Количество удаленных элементов.
+ */
+template <typename Key, typename Options>
+template <typename Predicate>
+typename set<Key, Options>::size_type
+set<Key, Options>::erase_if(Predicate pred) {
+  return tree_.EraseIf(pred);
+}
+
+/**
+ * @brief Извлекает элемент из множества вместе с его узлом.
+ *
+ * Узел не освобождается: через дескриптор можно изменить значение, а затем
+ * вставить узел в это или другое множество того же типа без выделения
+ * памяти и копирования элемента.
+ *
+ * @param pos Итератор на извлекаемый элемент.
+ * @return Дескриптор узла; пустой, если pos == end().
+ */
+template <typename Key, typename Options>
+typename set<Key, Options>::node_type
+set<Key, Options>::extract(iterator pos) noexcept {
+  return tree_.Extract(pos);
+}
+
+/**
+ * @brief Извлекает из множества заданный элемент вместе с его узлом.
+ *
+ * @param key Извлекаемый элемент.
+ * @return Дескриптор узла; пустой, если элемент не найден.
+ */
+template <typename Key, typename Options>
+typename set<Key, Options>::node_type
+set<Key, Options>::extract(const key_type &key) noexcept {
+  return tree_.Extract(find(key));
+}
+
+/**
+ * @brief Вставляет в множество узел из дескриптора, если такого элемента в
+ * множестве еще нет.
+ *
+ * @param node Дескриптор узла, полученный из extract().
+ * @return Позиция элемента, флаг вставки и дескриптор: пустой при успехе,
+ * исходный узел - если элемент уже был в множестве.
+ */
+template <typename Key, typename Options>
+typename set<Key, Options>::insert_return_type
+set<Key, Options>::insert(node_type &&node) {
+  return tree_.InsertUnique(std::move(node));
+}
 /**
  * @brief Обменивает содержимое двух контейнеров типа set.
  *
@@ -334,8 +447,9 @@ typename set<Key>::size_type set<Key>::erase(const key_type &key) noexcept {
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @param other Контейнер, с которым происходит обмен содержимым.
  */
-template <typename Key> void set<Key>::swap(set &other) noexcept {
-  tree_->Swap(*other.tree_);
+template <typename Key, typename Options>
+void set<Key, Options>::swap(set &other) noexcept {
+  tree_.Swap(other.tree_);
 }
 
 /**
@@ -349,68 +463,101 @@ template <typename Key> void set<Key>::swap(set &other) noexcept {
  * @tparam Key Тип ключа, хранимого в контейнере.
  * @param other Другой контейнер, с которым выполняется объединение.
  */
-template <typename Key> void set<Key>::merge(set &other) noexcept {
+template <typename Key, typename Options>
+void set<Key, Options>::merge(set &other) noexcept {
   // Проверка на самоприсваивание, чтобы избежать некорректной операции
   if (this == &other) {
     return; // Ничего не делаем при самоприсваивании
   }
 
   // Объединяем элементы из другого контейнера, исключая дубликаты
-  tree_->MergeUnique(*other.tree_);
+  tree_.MergeUnique(other.tree_);
 
   // Очищаем элементы из другого контейнера
   other.clear();
 }
 
+/**
+ * @brief Добавляет в множество все элементы other за O(n + m).
+ *
+ * @param other Второе множество.
+ * @return Ссылка на текущее множество.
+ */
+template <typename Key, typename Options>
+set<Key, Options> &set<Key, Options>::operator|=(const set &other) {
+  tree_.CombineWith(other.tree_, SetOperation::kUnion);
+  return *this;
+}
+
+/**
+ * @brief Оставляет в множестве только элементы, которые есть в other.
+ *
+ * @param other Второе множество.
+ * @return Ссылка на текущее множество.
+ */
+template <typename Key, typename Options>
+set<Key, Options> &set<Key, Options>::operator&=(const set &other) {
+  tree_.CombineWith(other.tree_, SetOperation::kIntersection);
+  return *this;
+}
+
+/**
+ * @brief Удаляет из множества все элементы, которые есть в other.
+ *
+ * @param other Второе множество.
+ * @return Ссылка на текущее множество.
+ */
+template <typename Key, typename Options>
+set<Key, Options> &set<Key, Options>::operator-=(const set &other) {
+  tree_.CombineWith(other.tree_, SetOperation::kDifference);
+  return *this;
+}
+
+/**
+ * @brief Оставляет элементы, которые есть ровно в одном из множеств.
+ *
+ * @param other Второе множество.
+ * @return Ссылка на текущее множество.
+ */
+template <typename Key, typename Options>
+set<Key, Options> &set<Key, Options>::operator^=(const set &other) {
+  tree_.CombineWith(other.tree_, SetOperation::kSymmetricDifference);
+  return *this;
+}
+
 /**
  * @brief Находит элемент по ключу в контейнере.
  *
- * Этот метод позволяет найти элемент в контейнере по заданному ключу.
- * В начале метода происходит проверка, существует ли вообще внутренний
- * объект-структура данных (дерево). Если объект не существует (равен nullptr),
- * то функция возвращает итератор, указывающий за конец контейнера. В противном
- * случае, происходит вызов соответствующего метода дерева (Find), который
- * выполняет поиск элемента в дереве.
+ * Этот метод позволяет найти элемент в контейнере по заданному ключу
+ * вызовом соответствующего метода дерева (Find), который выполняет поиск
+ * элемента в дереве.
  *
  * @param key Ключ, по которому нужно найти элемент.
  * @return Итератор на найденный элемент, либо итератор, указывающий за конец,
  * если элемент не найден или контейнер пуст.
  */
-template <typename Key>
-typename set<Key>::iterator set<Key>::find(const key_type &key) noexcept {
-  // Проверяем, существует ли внутренний объект-структура данных
-  if (!tree_) {
-    return this->end();
-  }
-
+template <typename Key, typename Options>
+typename set<Key, Options>::iterator
+set<Key, Options>::find(const key_type &key) noexcept {
   // Вызываем метод поиска элемента в дереве
-  return tree_->Find(key);
+  return tree_.Find(key);
 }
 
 /**
  * @brief Находит элемент по ключу в контейнере (константная версия).
  *
- * Этот метод позволяет найти элемент в контейнере по заданному ключу.
- * Подобно не-константной версии метода, здесь также происходит проверка
- * наличия внутренней структуры данных (дерева). Если она не существует,
- * возвращается итератор, указывающий за конец контейнера. В противном случае,
- * вызывается соответствующий метод дерева (Find), который выполняет поиск
- * элемента в дереве.
+ * Подобно не-константной версии метода, вызывает соответствующий метод
+ * дерева (Find), который выполняет поиск элемента в дереве.
  *
  * @param key Ключ, по которому нужно найти элемент.
  * @return Константный итератор на найденный элемент, либо константный
  * итератор, указывающий за конец, если элемент не найден или контейнер пуст.
  */
-template <typename Key>
-typename set<Key>::const_iterator
-set<Key>::find(const key_type &key) const noexcept {
-  // Проверяем, существует ли внутренний объект-структура данных
-  if (!tree_) {
-    return this->end();
-  }
-
+template <typename Key, typename Options>
+typename set<Key, Options>::const_iterator
+set<Key, Options>::find(const key_type &key) const noexcept {
   // Вызываем метод поиска элемента в дереве
-  return tree_->Find(key);
+  return tree_.Find(key);
 }
 
 /**
@@ -425,9 +572,9 @@ set<Key>::find(const key_type &key) const noexcept {
  * @param key Ключ, для которого требуется подсчитать количество вхождений.
  * @return Количество вхождений элемента с заданным ключом.
  */
-template <typename Key>
-typename set<Key>::size_type
-set<Key>::count(const key_type &key) const noexcept {
+template <typename Key, typename Options>
+typename set<Key, Options>::size_type
+set<Key, Options>::count(const key_type &key) const noexcept {
   // Проверяем, содержит ли контейнер элемент с заданным ключом
   return find(key) != end() ? 1 : 0;
 }
@@ -444,13 +591,13 @@ set<Key>::count(const key_type &key) const noexcept {
  * @return True, если элемент с указанным ключом найден в контейнере, иначе
  * false.
  */
-template <typename Key>
-bool set<Key>::contains(const key_type &key) const noexcept {
+template <typename Key, typename Options>
+bool set<Key, Options>::contains(const key_type &key) const noexcept {
   // Получаем итератор, указывающий на конец контейнера
-  auto end = tree_->End();
+  auto end = tree_.End();
 
   // Проверяем, найден ли элемент с заданным ключом в контейнере
-  return tree_->Find(key) != end;
+  return tree_.Find(key) != end;
 }
 
 /**
@@ -467,13 +614,13 @@ bool set<Key>::contains(const key_type &key) const noexcept {
  * @return Вектор пар итератор-булево, содержащий результаты вставки каждого
  * элемента.
  */
-template <typename Key>
+template <typename Key, typename Options>
 template <typename... Args>
-std::vector<std::pair<typename set<Key>::iterator, bool>>
-set<Key>::emplace(Args &&...args) {
+std::vector<std::pair<typename set<Key, Options>::iterator, bool>>
+set<Key, Options>::emplace(Args &&...args) {
   // Вызываем метод EmplaceUnique внутренней структуры данных с переданными
   // аргументами
-  return tree_->EmplaceUnique(std::forward<Args>(args)...);
+  return tree_.EmplaceUnique(std::forward<Args>(args)...);
 }
 
 /**
@@ -492,10 +639,10 @@ set<Key>::emplace(Args &&...args) {
  * диапазона.
  * @return Количество успешно вставленных элементов.
  */
-template <typename Key>
+template <typename Key, typename Options>
 template <typename InputIt>
-typename set<Key>::size_type set<Key>::insert_many(InputIt first,
-                                                   InputIt last) noexcept {
+typename set<Key, Options>::size_type
+set<Key, Options>::insert_many(InputIt first, InputIt last) noexcept {
   size_type count = 0; // Инициализация счетчика успешных вставок
   for (auto it = first; it != last; ++it) {
     auto result = insert(*it); // Вставка текущего элемента
@@ -506,4 +653,61 @@ typename set<Key>::size_type set<Key>::insert_many(InputIt first,
   return count; // Возврат общего количества успешно вставленных элементов
 }
 
+/**
+ * @brief Возвращает снимок счетчиков горячего пути множества.
+ *
+ * Счетчики ведутся внутренним деревом только при Options::stats (например,
+ * s21::set<Key, StatsTreeOptions>); иначе все значения нулевые.
+ *
+ * @return Значения счетчиков на момент вызова.
+ */
+template <typename Key, typename Options>
+ContainerStats set<Key, Options>::stats() const noexcept {
+  return tree_.Stats();
+}
+
+/**
+ * @brief Обнуляет счетчики горячего пути множества.
+ */
+template <typename Key, typename Options>
+void set<Key, Options>::reset_stats() noexcept {
+  tree_.ResetStats();
+}
+
+/**
+ * @brief Подсчитывает память, занятую множеством: сам объект со встроенным
+ * деревом и узлы дерева (см. RedBlackTree::MemoryUsage).
+ *
+ * @return Число байт.
+ */
+template <typename Key, typename Options>
+typename set<Key, Options>::size_type
+set<Key, Options>::memory_usage() const {
+  return sizeof(*this) - sizeof(tree_type) + tree_.MemoryUsage();
+}
+
+/**
+ * @brief Переносит все узлы множества в один непрерывный блок (см.
+ * RedBlackTree::Compact).
+ *
+ * @param order Порядок узлов в памяти.
+ */
+template <typename Key, typename Options>
+void set<Key, Options>::compact(CompactOrder order) {
+  tree_.Compact(order);
+}
+
+/**
+ * @brief Переносит в общий блок очередную порцию узлов множества (см.
+ * RedBlackTree::CompactStep).
+ *
+ * @param max_nodes Наибольшее число узлов, переносимых за вызов.
+ * @param order Порядок узлов в памяти для нового прохода.
+ * @return true, если проход уплотнения закончен.
+ */
+template <typename Key, typename Options>
+bool set<Key, Options>::compact_step(size_type max_nodes, CompactOrder order) {
+  return tree_.CompactStep(max_nodes, order);
+}
+
 } // namespace s21
@@ -0,0 +1,203 @@
+// Замер s21::set<int>: время вставки и поиска существующих и отсутствующих
+// ключей, а также число сравнений ключей на операцию
+// (по счетчикам set со статистикой). Отдельно сравниваются объединение и
+// пересечение через set_union/set_intersection с циклом insert/contains.
+// Для set<long> сравниваются обычная и компактная (CompactTreeOptions)
+// раскладки узла: байты на элемент по memory_usage(), вставка, поиск и
+// полный обход. Для set<std::string> с длинными ключами сравнивается
+// вставка копированием и перемещением. Отдельно замеряются создание,
+// перемещение и уничтожение пустого множества.
+//
+// Сборка: g++ -std=c++17 -O2 set_bench.cpp -o set_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "s21_set.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsPerOp(Clock::time_point start, std::size_t ops) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+             .count() /
+         static_cast<double>(ops);
+}
+
+template <typename Set>
+void Run(const char *name, std::size_t count, bool with_stats) {
+  std::mt19937 gen(32);
+  std::vector<int> keys(count);
+  for (auto &key : keys) {
+    key = static_cast<int>(gen() % (4 * count)) * 2; // только четные
+  }
+  std::vector<int> misses(count);
+  for (auto &key : misses) {
+    key = static_cast<int>(gen() % (4 * count)) * 2 + 1;
+  }
+
+  Set set;
+  auto start = Clock::now();
+  for (int key : keys) {
+    set.insert(key);
+  }
+  double insert_ns = NanosecondsPerOp(start, count);
+  double insert_cmp =
+      static_cast<double>(set.stats().comparisons) / count;
+
+  std::shuffle(keys.begin(), keys.end(), gen);
+  set.reset_stats();
+  std::size_t found = 0;
+  start = Clock::now();
+  for (int key : keys) {
+    found += set.contains(key);
+  }
+  double hit_ns = NanosecondsPerOp(start, count);
+  double hit_cmp = static_cast<double>(set.stats().comparisons) / count;
+
+  set.reset_stats();
+  start = Clock::now();
+  for (int key : misses) {
+    found += set.contains(key);
+  }
+  double miss_ns = NanosecondsPerOp(start, count);
+  double miss_cmp = static_cast<double>(set.stats().comparisons) / count;
+
+  if (with_stats) {
+    std::printf("  %-8s comparisons/op: insert %.1f  find hit %.1f  "
+                "find miss %.1f\n",
+                name, insert_cmp, hit_cmp, miss_cmp);
+  } else {
+    std::printf("  %-8s insert %6.1f ns  find hit %6.1f ns  find miss %6.1f "
+                "ns  (found %zu)\n",
+                name, insert_ns, hit_ns, miss_ns, found);
+  }
+}
+void RunAlgebra(std::size_t count) {
+  std::mt19937 gen(40);
+  s21::set<int> lhs;
+  s21::set<int> rhs;
+  for (std::size_t i = 0; i < count; ++i) {
+    lhs.insert(static_cast<int>(gen() % (4 * count)));
+    rhs.insert(static_cast<int>(gen() % (4 * count)));
+  }
+  const std::size_t ops = lhs.size() + rhs.size();
+
+  auto start = Clock::now();
+  s21::set<int> merged = set_union(lhs, rhs);
+  double union_ns = NanosecondsPerOp(start, ops);
+  start = Clock::now();
+  s21::set<int> common = set_intersection(lhs, rhs);
+  double intersection_ns = NanosecondsPerOp(start, ops);
+
+  start = Clock::now();
+  s21::set<int> merged_loop = lhs;
+  for (int key : rhs) {
+    merged_loop.insert(key);
+  }
+  double union_loop_ns = NanosecondsPerOp(start, ops);
+  start = Clock::now();
+  s21::set<int> common_loop;
+  for (int key : lhs) {
+    if (rhs.contains(key)) {
+      common_loop.insert(key);
+    }
+  }
+  double intersection_loop_ns = NanosecondsPerOp(start, ops);
+
+  std::printf("  algebra  union %6.1f ns (loop %6.1f)  intersection %6.1f ns "
+              "(loop %6.1f) per element, sizes %zu/%zu\n",
+              union_ns, union_loop_ns, intersection_ns, intersection_loop_ns,
+              merged.size(), common.size());
+}
+
+template <typename Set> void RunLayout(const char *name, std::size_t count) {
+  std::mt19937 gen(45);
+  std::vector<long> keys(count);
+  for (auto &key : keys) {
+    key = static_cast<long>(gen() % (4 * count));
+  }
+
+  Set set;
+  auto start = Clock::now();
+  for (long key : keys) {
+    set.insert(key);
+  }
+  const double insert_ns = NanosecondsPerOp(start, count);
+  std::shuffle(keys.begin(), keys.end(), gen);
+  std::size_t found = 0;
+  start = Clock::now();
+  for (long key : keys) {
+    found += set.contains(key);
+  }
+  const double find_ns = NanosecondsPerOp(start, count);
+  long sum = 0;
+  start = Clock::now();
+  for (long key : set) {
+    sum += key;
+  }
+  const double scan_ns = NanosecondsPerOp(start, set.size());
+  std::printf("  %-8s %5.1f bytes/elem  insert %6.1f ns  find %6.1f ns  "
+              "scan %5.2f ns  (found %zu, sum %ld)\n",
+              name,
+              static_cast<double>(set.memory_usage()) /
+                  static_cast<double>(set.size()),
+              insert_ns, find_ns, scan_ns, found, sum);
+}
+
+void RunMoves(std::size_t count) {
+  std::mt19937 gen(46);
+  std::vector<std::string> keys(count);
+  for (auto &key : keys) {
+    key = std::to_string(gen()) + std::string(64, 'x');
+  }
+
+  s21::set<std::string> copied;
+  auto start = Clock::now();
+  for (const std::string &key : keys) {
+    copied.insert(key);
+  }
+  const double copy_ns = NanosecondsPerOp(start, count);
+  s21::set<std::string> moved;
+  start = Clock::now();
+  for (std::string &key : keys) {
+    moved.insert(std::move(key));
+  }
+  const double move_ns = NanosecondsPerOp(start, count);
+  std::printf("  strings  insert copy %6.1f ns  move %6.1f ns  (size %zu)\n",
+              copy_ns, move_ns, moved.size());
+}
+
+void RunEmpty(std::size_t count) {
+  std::size_t sink = 0;
+  auto start = Clock::now();
+  for (std::size_t i = 0; i < count; ++i) {
+    s21::set<int> empty;
+    s21::set<int> moved(std::move(empty));
+    sink += moved.size() + empty.size() + moved.contains(static_cast<int>(i));
+  }
+  std::printf("  empty    create+move+destroy %6.1f ns  (%zu bytes/set, "
+              "sink %zu)\n",
+              NanosecondsPerOp(start, count), sizeof(s21::set<int>), sink);
+}
+} // namespace
+
+int main() {
+  for (std::size_t count : {std::size_t{50000}, std::size_t{1000000}}) {
+    std::printf("s21::set<int>, %zu random keys\n", count);
+    Run<s21::set<int>>("time", count, false);
+    Run<s21::set<int, s21::StatsTreeOptions>>("stats", count, true);
+    RunAlgebra(count);
+    std::printf("s21::set<long>, %zu random keys\n", count);
+    RunLayout<s21::set<long>>("plain", count);
+    RunLayout<s21::set<long, s21::CompactTreeOptions>>("compact", count);
+    std::printf("s21::set<std::string>, %zu random keys\n", count);
+    RunMoves(count);
+    RunEmpty(count);
+  }
+  return 0;
+}
@@ -1,7 +1,42 @@
 #include "s21_set.h"
+#include "../map/s21_map.h"
 #include "../tree/RedBlackTree.h"
+#include "../tree/TreeParallel.h"
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+// Число вызовов глобального operator new в тестах; атомарное, потому что
+// параллельные операции над множествами выделяют память в нескольких
+// потоках.
+std::atomic<std::size_t> allocations{0};
+} // namespace
+
+// Замена глобальных operator new/delete считает выделения памяти. Замена не
+// встраивается, иначе GCC видит malloc и free вместо пары new/delete и
+// предупреждает о несоответствии (-Wmismatched-new-delete).
+[[gnu::noinline]] void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *memory) noexcept {
+  std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
 TEST(SetTest, DefaultConstructor) {
   s21::set<int> s;
   EXPECT_TRUE(s.empty());
@@ -29,6 +64,34 @@ TEST(SetTest, MoveConstructor) {
   EXPECT_TRUE(original.empty());
 }
 
+TEST(SetTest, EmptyContainersDoNotAllocate) {
+  // Проверки gtest сами могут выделять память, поэтому идут после замера.
+  const std::size_t before = allocations;
+  bool empty_after_moves = false;
+  bool found = true;
+  {
+    s21::set<std::string> empty;
+    s21::set<std::string> moved(std::move(empty));
+    empty = std::move(moved);
+    empty.swap(moved);
+    empty_after_moves = empty.empty() && moved.empty();
+    found = moved.find("key") != moved.end();
+    s21::map<std::string, std::string> map;
+    s21::map<std::string, std::string> moved_map(std::move(map));
+    found = found || moved_map.contains("key");
+  }
+  const std::size_t empty_allocations = allocations - before;
+  s21::set<std::string> filled{"one"};
+  s21::set<std::string> moved(std::move(filled));
+  const std::size_t filled_allocations = allocations - before;
+
+  EXPECT_EQ(empty_allocations, 0U);
+  EXPECT_EQ(filled_allocations, 1U);
+  EXPECT_TRUE(empty_after_moves);
+  EXPECT_FALSE(found);
+  EXPECT_TRUE(moved.contains("one"));
+}
+
 TEST(SetTest, Insert) {
   s21::set<int> s;
   auto [it, success] = s.insert(42);
@@ -41,6 +104,18 @@ TEST(SetTest, Insert) {
   EXPECT_EQ(s.size(), 1);
 }
 
+TEST(SetTest, InsertMovesValue) {
+  s21::set<std::string> s;
+  std::string key(64, 'k');
+  EXPECT_TRUE(s.insert(std::move(key)).second);
+  EXPECT_TRUE(key.empty());
+  EXPECT_EQ((*s.begin()).size(), 64U);
+
+  std::string duplicate(64, 'k');
+  EXPECT_FALSE(s.insert(std::move(duplicate)).second);
+  EXPECT_EQ(duplicate.size(), 64U);
+}
+
 TEST(SetTest, Erase) {
   s21::set<int> s{1, 2, 3};
   auto it = s.find(2);
@@ -206,6 +281,170 @@ TEST(SetTest, InsertMany) {
   EXPECT_EQ(*s.find(40), 40);
 }
 
+TEST(SetTest, ThreadedSet) {
+  s21::set<int, s21::ThreadedTreeOptions> s{5, 1, 4, 2, 3};
+  s.erase(4);
+
+  std::vector<int> values(s.begin(), s.end());
+  EXPECT_EQ(values, (std::vector<int>{1, 2, 3, 5}));
+  EXPECT_EQ(*(--s.end()), 5);
+}
+
+TEST(SetTest, EraseRangeAndIf) {
+  s21::set<int> s{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(s.erase(3, 6), 3U);
+  EXPECT_EQ(*s.erase(s.begin(), s.find(2)), 2);
+  EXPECT_EQ(s.erase_if([](int key) { return key > 7; }), 2U);
+
+  std::vector<int> values(s.begin(), s.end());
+  EXPECT_EQ(values, (std::vector<int>{2, 6, 7}));
+}
+
+TEST(SetTest, ExtractAndInsertNode) {
+  s21::set<std::string> s{"apple", "banana"};
+  s21::set<std::string> other;
+
+  auto node = s.extract("banana");
+  node.value() = "cherry";
+  EXPECT_TRUE(other.insert(std::move(node)).inserted);
+  EXPECT_TRUE(other.contains("cherry"));
+  EXPECT_EQ(s.size(), 1U);
+  EXPECT_FALSE(s.extract(s.end()));
+}
+
+TEST(SetTest, Stats) {
+  s21::set<int, s21::StatsTreeOptions> s{5, 1, 4, 2, 3};
+  EXPECT_EQ(s.stats().allocations, 5U);
+
+  s.reset_stats();
+  EXPECT_TRUE(s.contains(4));
+  EXPECT_EQ(s.erase(4), 1U);
+  s21::ContainerStats stats = s.stats();
+  EXPECT_GT(stats.comparisons, 0U);
+  EXPECT_EQ(stats.deallocations, 1U);
+  EXPECT_EQ((s21::set<int>{1, 2}.stats().comparisons), 0U);
+}
+
+TEST(SetTest, StatsIteratorOutlivesMovedFromSet) {
+  auto source = std::make_unique<s21::set<int, s21::StatsTreeOptions>>(
+      std::initializer_list<int>{1, 2, 3});
+  s21::set<int, s21::StatsTreeOptions> target(std::move(*source));
+  auto it = target.begin();
+  source.reset();
+  ++it;
+  EXPECT_EQ(*it, 2);
+}
+
+TEST(SetTest, StatsConcurrentReaders) {
+  s21::set<int, s21::StatsTreeOptions> s;
+  for (int key = 0; key < 1000; ++key) {
+    s.insert(key);
+  }
+  s.reset_stats();
+  const auto &shared = s;
+  std::vector<std::thread> readers;
+  for (int reader = 0; reader < 4; ++reader) {
+    readers.emplace_back([&shared] {
+      for (int key = 0; key < 1000; ++key) {
+        EXPECT_TRUE(shared.contains(key));
+      }
+    });
+  }
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(s.stats().descents, 4000U);
+}
+
+TEST(SetTest, MemoryUsage) {
+  s21::set<long> plain;
+  s21::set<long, s21::CompactTreeOptions> compact;
+  const std::size_t plain_empty = plain.memory_usage();
+  const std::size_t compact_empty = compact.memory_usage();
+  for (long key = 0; key < 64; ++key) {
+    plain.insert(key);
+    compact.insert(key);
+  }
+  EXPECT_EQ(plain.memory_usage() - plain_empty, 64 * 40U);
+  EXPECT_EQ(compact.memory_usage() - compact_empty, 64 * 32U);
+  EXPECT_TRUE(compact.contains(63));
+  compact.clear();
+  EXPECT_EQ(compact.memory_usage(), compact_empty);
+}
+
+TEST(SetTest, MemoryUsageCountsWholeCopyBlock) {
+  s21::set<long> source;
+  for (long key = 0; key < 1000; ++key) {
+    source.insert(key);
+  }
+  s21::set<long> copy = source;
+  const std::size_t copied = copy.memory_usage();
+  EXPECT_GE(copied, source.memory_usage());
+  // Последний узел держит весь блок копии.
+  copy.erase(copy.begin(), copy.find(999));
+  ASSERT_EQ(copy.size(), 1U);
+  EXPECT_EQ(copy.memory_usage(), copied);
+  copy.compact();
+  EXPECT_LT(copy.memory_usage(), copied / 100);
+}
+
+TEST(SetTest, SetAlgebra) {
+  s21::set<int> lhs{1, 2, 3, 4, 5};
+  s21::set<int> rhs{4, 5, 6, 7};
+  EXPECT_EQ(set_union(lhs, rhs), (s21::set<int>{1, 2, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(set_intersection(lhs, rhs), (s21::set<int>{4, 5}));
+  EXPECT_EQ(set_difference(lhs, rhs), (s21::set<int>{1, 2, 3}));
+  EXPECT_EQ(symmetric_difference(lhs, rhs), (s21::set<int>{1, 2, 3, 6, 7}));
+  EXPECT_TRUE(set_intersection(lhs, s21::set<int>{}).empty());
+
+  s21::set<int, s21::ThreadedTreeOptions> threaded{1, 3, 5, 7};
+  threaded |= s21::set<int, s21::ThreadedTreeOptions>{2, 3, 4};
+  threaded -= s21::set<int, s21::ThreadedTreeOptions>{1, 7};
+  threaded ^= s21::set<int, s21::ThreadedTreeOptions>{4, 6};
+  threaded &= s21::set<int, s21::ThreadedTreeOptions>{2, 3, 5, 6, 8};
+  EXPECT_EQ(threaded,
+            (s21::set<int, s21::ThreadedTreeOptions>{2, 3, 5, 6}));
+  std::vector<int> reversed;
+  for (auto it = threaded.end(); it != threaded.begin();) {
+    reversed.push_back(*--it);
+  }
+  EXPECT_EQ(reversed, (std::vector<int>{6, 5, 3, 2}));
+
+  threaded &= threaded;
+  EXPECT_EQ(threaded.size(), 4U);
+  threaded ^= threaded;
+  EXPECT_TRUE(threaded.empty());
+}
+
+namespace {
+struct ForcedParallelOptions : s21::DefaultTreeOptions {
+  using executor = s21::ThreadTreeExecutor<3>;
+  static constexpr std::size_t parallel_threshold = 1;
+};
+} // namespace
+
+TEST(SetTest, ParallelSetAlgebraAndCopy) {
+  using Set = s21::set<int, ForcedParallelOptions>;
+  Set lhs;
+  Set rhs;
+  for (int key = 0; key < 1000; ++key) {
+    lhs.insert(key * 2);
+    rhs.insert(key * 3);
+  }
+  const Set copy = lhs;
+  EXPECT_EQ(copy, lhs);
+  EXPECT_EQ(set_union(lhs, rhs).size(), 1666U);
+  EXPECT_EQ(set_intersection(lhs, rhs).size(), 334U);
+  EXPECT_EQ(set_difference(lhs, rhs).size(), 666U);
+  EXPECT_EQ(symmetric_difference(lhs, rhs).size(), 1332U);
+  lhs &= rhs;
+  int expected = 0;
+  for (int key : lhs) {
+    EXPECT_EQ(key, expected);
+    expected += 6;
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,167 @@
+#ifndef S21_CONTAINERS_SMALL_S21_SMALL_MAP_H_
+#define S21_CONTAINERS_SMALL_S21_SMALL_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../map/s21_map.h"
+#include "s21_small_storage.h"
+
+namespace s21 {
+
+// Ассоциативный массив с оптимизацией малого размера: пока элементов не
+// больше Capacity, пары лежат упорядоченным по ключу массивом в самом
+// объекте и не выделяют память, а поиск - линейный просмотр массива. Новый
+// ключ для полного массива переносит все пары в дерево s21::map
+// (map<Key, Type, Options>::tree_type); обратно в массив их возвращает
+// shrink_to_fit(), если пар снова не больше Capacity.
+//
+// Правила недействительности итераторов те же, что у small_set: в массиве
+// вставка и удаление сдвигают хвост, а переход между представлениями
+// (вставка в полный массив, shrink_to_fit, удаление последней пары из
+// дерева) делает недействительными все итераторы и ссылки, включая end().
+template <typename Key, typename Type, std::size_t Capacity = 8,
+          typename Options = DefaultTreeOptions>
+class small_map {
+public:
+  using key_type = Key;
+  using mapped_type = Type;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using tree_type = typename map<Key, Type, Options>::tree_type;
+  using iterator = SmallIterator<value_type, typename tree_type::iterator>;
+  using const_iterator =
+      SmallIterator<const value_type, typename tree_type::const_iterator>;
+
+  // Конструкторы, деструктор и операторы присваивания
+  small_map() noexcept = default;
+  small_map(std::initializer_list<value_type> const &items);
+  small_map(const small_map &other) = default;
+  small_map(small_map &&other) noexcept(
+      std::is_nothrow_move_constructible_v<std::pair<Key, Type>>) = default;
+  ~small_map() = default;
+
+  small_map &operator=(const small_map &other);
+  small_map &operator=(small_map &&other) noexcept(
+      std::is_nothrow_move_constructible_v<std::pair<Key, Type>>);
+
+  friend bool operator==(const small_map &lhs, const small_map &rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  friend bool operator!=(const small_map &lhs, const small_map &rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Доступ к элементам
+  mapped_type &at(const key_type &key);
+  const mapped_type &at(const key_type &key) const;
+  mapped_type &operator[](const key_type &key);
+  mapped_type &operator[](key_type &&key);
+
+  // Итераторы
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+  [[nodiscard]] size_type max_size() const noexcept;
+  // Пары лежат во встроенном массиве, а не в дереве.
+  [[nodiscard]] bool is_small() const noexcept;
+  static constexpr size_type inline_capacity() noexcept { return Capacity; }
+
+  // Модификаторы
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &value);
+  std::pair<iterator, bool> insert(key_type &&key, mapped_type &&value);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &value);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             mapped_type &&value);
+  std::pair<iterator, bool> insert_or_assign(key_type &&key,
+                                             mapped_type &&value);
+  template <typename... Args> std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+  iterator erase(iterator pos);
+  size_type erase(const key_type &key);
+  void swap(small_map &other);
+  void shrink_to_fit();
+
+  // Поиск
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator lower_bound(const key_type &key);
+  const_iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key);
+  const_iterator upper_bound(const key_type &key) const;
+
+  // Память контейнера вместе с узлами дерева, в байтах (за O(n log n))
+  [[nodiscard]] size_type memory_usage() const;
+
+private:
+  // Массив хранит пары с изменяемым ключом: сдвиг при вставке и удалении
+  // тогда переносит ключ, а не копирует его, и не бросает исключений для
+  // ключей вроде std::string. Наружу пары отдаются как value_type
+  // (SmallData), как это делают узлы std::map в libc++.
+  using stored_type = std::pair<key_type, mapped_type>;
+  using storage_type = SmallStorage<stored_type, Capacity>;
+
+  // Ключ элемента встроенного массива.
+  struct KeyOf {
+    const key_type &operator()(const stored_type &value) const noexcept {
+      return value.first;
+    }
+  };
+
+  // Проба поиска в дереве по ключу без временной пары (как в s21::map).
+  struct KeyProbe {
+    const key_type &first;
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const key_type &key, Args &&...args);
+  template <typename K, typename M>
+  std::pair<iterator, bool> InsertOrAssign(K &&key, M &&value);
+  size_type SmallLowerBound(const key_type &key) const;
+  size_type SmallUpperBound(const key_type &key) const;
+  size_type SmallFind(const key_type &key) const;
+  value_type *SmallData() noexcept;
+  const value_type *SmallData() const noexcept;
+  iterator SmallIteratorAt(size_type position) noexcept;
+  const_iterator SmallIteratorAt(size_type position) const noexcept;
+  iterator TreeIterator(typename tree_type::iterator node) noexcept;
+  const_iterator
+  TreeIterator(typename tree_type::const_iterator node) const noexcept;
+  void Promote();
+
+  // Пока дерево пусто, пары лежат в small_; в дереве они оказываются все
+  // сразу, поэтому непусто не больше одного представления.
+  storage_type small_;
+  tree_type tree_;
+};
+
+} // namespace s21
+
+#include "s21_small_map.tpp"
+#endif // S21_CONTAINERS_SMALL_S21_SMALL_MAP_H_
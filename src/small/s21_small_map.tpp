@@ -0,0 +1,621 @@
+#include "s21_small_map.h"
+
+namespace s21 {
+
+/**
+ * @brief Создает карту из пар списка; пары с повторным ключом пропускаются.
+ *
+ * @param items Пары в любом порядке.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+small_map<Key, Type, Capacity, Options>::small_map(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) {
+    insert(item);
+  }
+}
+
+/**
+ * @brief Копирующее присваивание. Если копирование бросает исключение,
+ * карта не меняется.
+ *
+ * @param other Карта-источник.
+ * @return Ссылка на текущую карту.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+small_map<Key, Type, Capacity, Options> &
+small_map<Key, Type, Capacity, Options>::operator=(const small_map &other) {
+  if (this != &other) {
+    small_map copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+/**
+ * @brief Перемещающее присваивание. Пары из массива other переносятся
+ * поштучно, дерево - целиком.
+ *
+ * @param other Карта, которая после перемещения становится пустой.
+ * @return Ссылка на текущую карту.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+small_map<Key, Type, Capacity, Options> &
+small_map<Key, Type, Capacity, Options>::operator=(small_map &&other) noexcept(
+    std::is_nothrow_move_constructible_v<stored_type>) {
+  if (this != &other) {
+    small_ = std::move(other.small_);
+    tree_ = std::move(other.tree_);
+  }
+  return *this;
+}
+
+/**
+ * @brief Значение по ключу с проверкой наличия.
+ *
+ * @param key Ключ.
+ * @return Ссылка на значение.
+ * @throw std::out_of_range Если ключа нет.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::mapped_type &
+small_map<Key, Type, Capacity, Options>::at(const key_type &key) {
+  return const_cast<mapped_type &>(std::as_const(*this).at(key));
+}
+
+/**
+ * @brief Значение по ключу с проверкой наличия (константная версия).
+ *
+ * @param key Ключ.
+ * @return Константная ссылка на значение.
+ * @throw std::out_of_range Если ключа нет.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+const typename small_map<Key, Type, Capacity, Options>::mapped_type &
+small_map<Key, Type, Capacity, Options>::at(const key_type &key) const {
+  const_iterator pos = find(key);
+  if (pos == end()) {
+    throw std::out_of_range(
+        "s21::small_map::at: Элемент с указанным ключом отсутствует.");
+  }
+  return pos->second;
+}
+
+/**
+ * @brief Значение по ключу; если ключа нет, вставляется пара со значением
+ * по умолчанию.
+ *
+ * @param key Ключ.
+ * @return Ссылка на значение.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::mapped_type &
+small_map<Key, Type, Capacity, Options>::operator[](const key_type &key) {
+  return TryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                    std::forward_as_tuple())
+      .first->second;
+}
+
+/**
+ * @brief Значение по ключу, перемещающее ключ в новую пару. Если ключ уже
+ * есть, key остается нетронутым.
+ *
+ * @param key Ключ.
+ * @return Ссылка на значение.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::mapped_type &
+small_map<Key, Type, Capacity, Options>::operator[](key_type &&key) {
+  return TryEmplace(key, std::piecewise_construct,
+                    std::forward_as_tuple(std::move(key)),
+                    std::forward_as_tuple())
+      .first->second;
+}
+
+/**
+ * @brief Итератор на пару с наименьшим ключом.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::iterator
+small_map<Key, Type, Capacity, Options>::begin() noexcept {
+  return is_small() ? SmallIteratorAt(0) : TreeIterator(tree_.Begin());
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::const_iterator
+small_map<Key, Type, Capacity, Options>::begin() const noexcept {
+  return is_small() ? SmallIteratorAt(0) : TreeIterator(tree_.Begin());
+}
+
+/**
+ * @brief Итератор за парой с наибольшим ключом.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::iterator
+small_map<Key, Type, Capacity, Options>::end() noexcept {
+  return is_small() ? SmallIteratorAt(small_.Size())
+                    : TreeIterator(tree_.End());
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::const_iterator
+small_map<Key, Type, Capacity, Options>::end() const noexcept {
+  return is_small() ? SmallIteratorAt(small_.Size())
+                    : TreeIterator(tree_.End());
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+bool small_map<Key, Type, Capacity, Options>::empty() const noexcept {
+  return small_.Empty() && tree_.Empty();
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::size_type
+small_map<Key, Type, Capacity, Options>::size() const noexcept {
+  return is_small() ? small_.Size() : tree_.Size();
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::size_type
+small_map<Key, Type, Capacity, Options>::max_size() const noexcept {
+  return tree_.MaxSize();
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+bool small_map<Key, Type, Capacity, Options>::is_small() const noexcept {
+  return tree_.Empty();
+}
+
+/**
+ * @brief Удаляет все пары. Дерево освобождается, и карта снова хранит пары
+ * во встроенном массиве.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+void small_map<Key, Type, Capacity, Options>::clear() noexcept {
+  small_.Clear();
+  tree_.Clear();
+}
+
+/**
+ * @brief Вставляет копию пары, если ее ключа еще нет.
+ *
+ * @param value Пара.
+ * @return Пара из итератора на элемент и флага вставки.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::insert(const value_type &value) {
+  return TryEmplace(value.first, value);
+}
+
+/**
+ * @brief Вставляет пару перемещением, если ее ключа еще нет. Ключ пары
+ * константный и копируется; если ключ уже есть, value не трогается.
+ *
+ * @param value Пара.
+ * @return Пара из итератора на элемент и флага вставки.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::insert(value_type &&value) {
+  return TryEmplace(value.first, std::move(value));
+}
+
+/**
+ * @brief Вставляет пару из ключа и значения, если ключа еще нет.
+ *
+ * @param key Ключ.
+ * @param value Значение.
+ * @return Пара из итератора на элемент и флага вставки.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::insert(const key_type &key,
+                                                const mapped_type &value) {
+  return TryEmplace(key, key, value);
+}
+
+/**
+ * @brief Вставляет пару, перемещая ключ и значение. Если ключ уже есть,
+ * аргументы остаются нетронутыми.
+ *
+ * @param key Ключ.
+ * @param value Значение.
+ * @return Пара из итератора на элемент и флага вставки.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::insert(key_type &&key,
+                                                mapped_type &&value) {
+  return TryEmplace(key, std::move(key), std::move(value));
+}
+
+/**
+ * @brief Вставляет пару или заменяет значение существующего ключа.
+ *
+ * @param key Ключ.
+ * @param value Значение.
+ * @return Пара из итератора на элемент и флага вставки нового ключа.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::insert_or_assign(
+    const key_type &key, const mapped_type &value) {
+  return InsertOrAssign(key, value);
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::insert_or_assign(
+    const key_type &key, mapped_type &&value) {
+  return InsertOrAssign(key, std::move(value));
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::insert_or_assign(
+    key_type &&key, mapped_type &&value) {
+  return InsertOrAssign(std::move(key), std::move(value));
+}
+
+/**
+ * @brief Создает пару из args и вставляет ее, если ключа еще нет.
+ *
+ * Ключ известен только после создания пары, поэтому она строится заранее;
+ * при вставке ключ копируется, а значение перемещается.
+ *
+ * @param args Аргументы конструктора пары.
+ * @return Пара из итератора на элемент и флага вставки.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+template <typename... Args>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::emplace(Args &&...args) {
+  value_type value(std::forward<Args>(args)...);
+  return TryEmplace(value.first, std::move(value));
+}
+
+/**
+ * @brief Создает пару из ключа и аргументов конструктора значения, если
+ * ключа еще нет; иначе аргументы остаются нетронутыми.
+ *
+ * @param key Ключ.
+ * @param args Аргументы конструктора значения.
+ * @return Пара из итератора на элемент и флага вставки.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+template <typename... Args>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::try_emplace(const key_type &key,
+                                                     Args &&...args) {
+  return TryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                    std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+template <typename... Args>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::try_emplace(key_type &&key,
+                                                     Args &&...args) {
+  return TryEmplace(key, std::piecewise_construct,
+                    std::forward_as_tuple(std::move(key)),
+                    std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Удаляет пару, на которую указывает pos.
+ *
+ * @param pos Итератор на существующую пару.
+ * @return Итератор на следующую пару.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::iterator
+small_map<Key, Type, Capacity, Options>::erase(iterator pos) {
+  if (is_small()) {
+    const size_type position =
+        static_cast<size_type>(pos.element_ - SmallData());
+    small_.Erase(position);
+    return SmallIteratorAt(position);
+  }
+  typename tree_type::iterator next = pos.node_;
+  ++next;
+  tree_.Erase(pos.node_);
+  // Удалена последняя пара дерева: карта снова хранит пары в массиве.
+  return tree_.Empty() ? end() : TreeIterator(next);
+}
+
+/**
+ * @brief Удаляет пару с ключом key, если она есть.
+ *
+ * @param key Ключ.
+ * @return Число удаленных пар: 0 или 1.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::size_type
+small_map<Key, Type, Capacity, Options>::erase(const key_type &key) {
+  iterator pos = find(key);
+  if (pos == end()) {
+    return 0;
+  }
+  erase(pos);
+  return 1;
+}
+
+/**
+ * @brief Обменивает содержимое с other. Пары встроенных массивов
+ * переносятся поштучно, поэтому итераторы на них становятся
+ * недействительными.
+ *
+ * @param other Другая карта.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+void small_map<Key, Type, Capacity, Options>::swap(small_map &other) {
+  small_map tmp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(tmp);
+}
+
+/**
+ * @brief Возвращает пары из дерева во встроенный массив, если их не больше
+ * Capacity, и освобождает узлы дерева.
+ *
+ * Пары переносятся, если их конструктор перемещения не бросает исключений,
+ * и копируются иначе; при исключении карта не меняется. Все итераторы и
+ * ссылки на элементы становятся недействительными.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+void small_map<Key, Type, Capacity, Options>::shrink_to_fit() {
+  if (is_small() || tree_.Size() > Capacity) {
+    return;
+  }
+  try {
+    for (auto it = tree_.Begin(); it != tree_.End(); ++it) {
+      small_.Emplace(small_.Size(), std::move_if_noexcept(*it));
+    }
+  } catch (...) {
+    small_.Clear();
+    throw;
+  }
+  tree_.Clear();
+}
+
+/**
+ * @brief Ищет пару по ключу.
+ *
+ * @param key Искомый ключ.
+ * @return Итератор на пару или end().
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::iterator
+small_map<Key, Type, Capacity, Options>::find(const key_type &key) {
+  if (is_small()) {
+    return SmallIteratorAt(SmallFind(key));
+  }
+  return TreeIterator(tree_.Find(KeyProbe{key}));
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::const_iterator
+small_map<Key, Type, Capacity, Options>::find(const key_type &key) const {
+  if (is_small()) {
+    return SmallIteratorAt(SmallFind(key));
+  }
+  return TreeIterator(tree_.Find(KeyProbe{key}));
+}
+
+/**
+ * @brief Проверяет наличие ключа без построения итераторов.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+bool small_map<Key, Type, Capacity, Options>::contains(
+    const key_type &key) const {
+  if (is_small()) {
+    return SmallFind(key) != small_.Size();
+  }
+  return tree_.Find(KeyProbe{key}) != tree_.End();
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::size_type
+small_map<Key, Type, Capacity, Options>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Итератор на первую пару с ключом, не меньшим key.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::iterator
+small_map<Key, Type, Capacity, Options>::lower_bound(const key_type &key) {
+  if (is_small()) {
+    return SmallIteratorAt(SmallLowerBound(key));
+  }
+  return TreeIterator(tree_.LowerBound(KeyProbe{key}));
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::const_iterator
+small_map<Key, Type, Capacity, Options>::lower_bound(
+    const key_type &key) const {
+  if (is_small()) {
+    return SmallIteratorAt(SmallLowerBound(key));
+  }
+  return TreeIterator(tree_.LowerBound(KeyProbe{key}));
+}
+
+/**
+ * @brief Итератор на первую пару с ключом, большим key.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::iterator
+small_map<Key, Type, Capacity, Options>::upper_bound(const key_type &key) {
+  if (is_small()) {
+    return SmallIteratorAt(SmallUpperBound(key));
+  }
+  return TreeIterator(tree_.UpperBound(KeyProbe{key}));
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::const_iterator
+small_map<Key, Type, Capacity, Options>::upper_bound(
+    const key_type &key) const {
+  if (is_small()) {
+    return SmallIteratorAt(SmallUpperBound(key));
+  }
+  return TreeIterator(tree_.UpperBound(KeyProbe{key}));
+}
+
+/**
+ * @brief Размер самой карты вместе со встроенным массивом и узлами дерева.
+ * Пока пары в массиве, это sizeof(small_map).
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::size_type
+small_map<Key, Type, Capacity, Options>::memory_usage() const {
+  return sizeof(*this) - sizeof(tree_type) + tree_.MemoryUsage();
+}
+
+/**
+ * @brief Общая часть вставок: создает пару из args, только если ключа key
+ * еще нет.
+ *
+ * В массиве место находится тем же просмотром, что и при поиске, а пара
+ * строится сразу на своем месте. Новый ключ для полного массива сначала
+ * переносит весь массив в дерево, и дальше пара вставляется одним спуском
+ * по пробе ключа.
+ *
+ * @param key Ключ создаваемой пары.
+ * @param args Аргументы конструктора пары с ключом, равным key.
+ * @return Пара из итератора на элемент и флага вставки.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+template <typename... Args>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::TryEmplace(const key_type &key,
+                                                    Args &&...args) {
+  if (is_small()) {
+    const size_type position = SmallLowerBound(key);
+    if (position < small_.Size() &&
+        !std::less<key_type>()(key, small_.Data()[position].first)) {
+      return {SmallIteratorAt(position), false};
+    }
+    if (!small_.Full()) {
+      small_.Emplace(position, std::forward<Args>(args)...);
+      return {SmallIteratorAt(position), true};
+    }
+    Promote();
+  }
+  auto [node, inserted] =
+      tree_.TryConstruct(KeyProbe{key}, std::forward<Args>(args)...);
+  return {TreeIterator(node), inserted};
+}
+
+/**
+ * @brief Общая часть insert_or_assign.
+ *
+ * @param key Ключ.
+ * @param value Значение.
+ * @return Пара из итератора на элемент и флага вставки нового ключа.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+template <typename K, typename M>
+std::pair<typename small_map<Key, Type, Capacity, Options>::iterator, bool>
+small_map<Key, Type, Capacity, Options>::InsertOrAssign(K &&key, M &&value) {
+  iterator pos = find(key);
+  if (pos != end()) {
+    pos->second = std::forward<M>(value);
+    return {pos, false};
+  }
+  return TryEmplace(key, std::forward<K>(key), std::forward<M>(value));
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::size_type
+small_map<Key, Type, Capacity, Options>::SmallLowerBound(
+    const key_type &key) const {
+  return small_.template LowerBound<KeyOf>(key, std::less<key_type>());
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::size_type
+small_map<Key, Type, Capacity, Options>::SmallUpperBound(
+    const key_type &key) const {
+  return small_.template UpperBound<KeyOf>(key, std::less<key_type>());
+}
+
+/**
+ * @brief Номер пары с ключом key во встроенном массиве или его размер, если
+ * такой пары нет.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::size_type
+small_map<Key, Type, Capacity, Options>::SmallFind(const key_type &key) const {
+  return small_.template Find<KeyOf>(key, std::less<key_type>());
+}
+
+/**
+ * @brief Пары встроенного массива в том виде, в каком их видят итераторы.
+ *
+ * stored_type и value_type отличаются только константностью ключа и имеют
+ * одинаковую раскладку.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::value_type *
+small_map<Key, Type, Capacity, Options>::SmallData() noexcept {
+  return reinterpret_cast<value_type *>(small_.Data());
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+const typename small_map<Key, Type, Capacity, Options>::value_type *
+small_map<Key, Type, Capacity, Options>::SmallData() const noexcept {
+  return reinterpret_cast<const value_type *>(small_.Data());
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::iterator
+small_map<Key, Type, Capacity, Options>::SmallIteratorAt(
+    size_type position) noexcept {
+  return iterator(SmallData() + position, tree_.End());
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::const_iterator
+small_map<Key, Type, Capacity, Options>::SmallIteratorAt(
+    size_type position) const noexcept {
+  return const_iterator(SmallData() + position, tree_.End());
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::iterator
+small_map<Key, Type, Capacity, Options>::TreeIterator(
+    typename tree_type::iterator node) noexcept {
+  return iterator(nullptr, node);
+}
+
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+typename small_map<Key, Type, Capacity, Options>::const_iterator
+small_map<Key, Type, Capacity, Options>::TreeIterator(
+    typename tree_type::const_iterator node) const noexcept {
+  return const_iterator(nullptr, node);
+}
+
+/**
+ * @brief Переносит полный встроенный массив в дерево.
+ *
+ * Массив уже упорядочен, поэтому дерево собирается за O(Capacity) без
+ * поворотов (AssignSorted). Пары, чей конструктор перемещения может бросить
+ * исключение, копируются, чтобы при сбое массив остался целым.
+ */
+template <typename Key, typename Type, std::size_t Capacity, typename Options>
+void small_map<Key, Type, Capacity, Options>::Promote() {
+  stored_type *data = small_.Data();
+  if constexpr (std::is_nothrow_move_constructible_v<stored_type>) {
+    tree_.AssignSorted(std::make_move_iterator(data),
+                       std::make_move_iterator(data + small_.Size()));
+  } else {
+    tree_.AssignSorted(data, data + small_.Size());
+  }
+  small_.Clear();
+}
+
+} // namespace s21
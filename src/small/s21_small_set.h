@@ -0,0 +1,126 @@
+#ifndef S21_CONTAINERS_SMALL_S21_SMALL_SET_H_
+#define S21_CONTAINERS_SMALL_S21_SMALL_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "../tree/RedBlackTree.h"
+#include "s21_small_storage.h"
+
+namespace s21 {
+
+// Множество уникальных ключей с оптимизацией малого размера. Пока ключей не
+// больше Capacity, они лежат упорядоченным массивом в самом объекте: вставка,
+// поиск и удаление не выделяют память и не балансируют дерево, а поиск -
+// линейный просмотр массива. Вставка ключа в полный массив переносит все
+// ключи в красно-черное дерево (RedBlackTree с параметрами Options), и
+// дальше множество ведет себя как s21::set. Обратно в массив ключи
+// возвращает shrink_to_fit(), если их снова не больше Capacity.
+//
+// Итераторы обоих представлений двунаправленные. Пока ключи в массиве,
+// вставка и удаление делают недействительными итераторы и ссылки на ключи
+// после места вставки или удаления; в дереве - только на удаленный ключ.
+// Переход между представлениями (вставка в полный массив, shrink_to_fit,
+// удаление последнего ключа из дерева) делает недействительными все
+// итераторы и ссылки, включая end().
+template <typename Key, std::size_t Capacity = 8,
+          typename Options = DefaultTreeOptions>
+class small_set {
+public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using tree_type = RedBlackTree<value_type, std::less<value_type>, Options>;
+  // Ключи через итератор не меняются, поэтому итератор один.
+  using iterator =
+      SmallIterator<const value_type, typename tree_type::iterator>;
+  using const_iterator = iterator;
+
+  // Конструкторы, деструктор и операторы присваивания
+  small_set() noexcept = default;
+  small_set(std::initializer_list<value_type> const &items);
+  small_set(const small_set &other) = default;
+  small_set(small_set &&other) noexcept(
+      std::is_nothrow_move_constructible_v<value_type>) = default;
+  ~small_set() = default;
+
+  small_set &operator=(const small_set &other);
+  small_set &operator=(small_set &&other) noexcept(
+      std::is_nothrow_move_constructible_v<value_type>);
+
+  friend bool operator==(const small_set &lhs, const small_set &rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  friend bool operator!=(const small_set &lhs, const small_set &rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Итераторы
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+  [[nodiscard]] size_type max_size() const noexcept;
+  // Ключи лежат во встроенном массиве, а не в дереве.
+  [[nodiscard]] bool is_small() const noexcept;
+  static constexpr size_type inline_capacity() noexcept { return Capacity; }
+
+  // Модификаторы
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <typename... Args> std::pair<iterator, bool> emplace(Args &&...args);
+  iterator erase(iterator pos);
+  size_type erase(const key_type &key);
+  void swap(small_set &other);
+  void shrink_to_fit();
+
+  // Поиск
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+
+  // Память контейнера вместе с узлами дерева, в байтах (за O(n log n))
+  [[nodiscard]] size_type memory_usage() const;
+
+private:
+  using storage_type = SmallStorage<value_type, Capacity>;
+
+  // Ключ элемента встроенного массива - сам элемент.
+  struct KeyOf {
+    const key_type &operator()(const value_type &value) const noexcept {
+      return value;
+    }
+  };
+
+  template <typename Value> std::pair<iterator, bool> Insert(Value &&value);
+  size_type SmallLowerBound(const key_type &key) const;
+  size_type SmallUpperBound(const key_type &key) const;
+  size_type SmallFind(const key_type &key) const;
+  iterator SmallIteratorAt(size_type position) const noexcept;
+  iterator TreeIterator(typename tree_type::iterator node) const noexcept;
+  void Promote();
+
+  // Пока дерево пусто, ключи лежат в small_; в дереве они оказываются все
+  // сразу, поэтому непусто не больше одного представления.
+  storage_type small_;
+  tree_type tree_;
+};
+
+} // namespace s21
+
+#include "s21_small_set.tpp"
+#endif // S21_CONTAINERS_SMALL_S21_SMALL_SET_H_
@@ -0,0 +1,378 @@
+#include "s21_small_set.h"
+
+namespace s21 {
+
+/**
+ * @brief Создает множество из ключей списка; повторы пропускаются.
+ *
+ * @param items Ключи в любом порядке.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+small_set<Key, Capacity, Options>::small_set(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) {
+    insert(item);
+  }
+}
+
+/**
+ * @brief Копирующее присваивание. Если копирование бросает исключение,
+ * множество не меняется.
+ *
+ * @param other Множество-источник.
+ * @return Ссылка на текущее множество.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+small_set<Key, Capacity, Options> &
+small_set<Key, Capacity, Options>::operator=(const small_set &other) {
+  if (this != &other) {
+    small_set copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+/**
+ * @brief Перемещающее присваивание. Ключи из массива other переносятся
+ * поштучно, дерево - целиком.
+ *
+ * @param other Множество, которое после перемещения становится пустым.
+ * @return Ссылка на текущее множество.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+small_set<Key, Capacity, Options> &
+small_set<Key, Capacity, Options>::operator=(small_set &&other) noexcept(
+    std::is_nothrow_move_constructible_v<value_type>) {
+  if (this != &other) {
+    small_ = std::move(other.small_);
+    tree_ = std::move(other.tree_);
+  }
+  return *this;
+}
+
+/**
+ * @brief Итератор на наименьший ключ.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::iterator
+small_set<Key, Capacity, Options>::begin() const noexcept {
+  return is_small() ? SmallIteratorAt(0)
+                    : TreeIterator(const_cast<tree_type &>(tree_).Begin());
+}
+
+/**
+ * @brief Итератор за наибольшим ключом.
+ *
+ * После удаления последнего ключа из дерева множество снова хранит ключи в
+ * массиве, и end(), полученный раньше, становится недействительным.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::iterator
+small_set<Key, Capacity, Options>::end() const noexcept {
+  return is_small() ? SmallIteratorAt(small_.Size())
+                    : TreeIterator(const_cast<tree_type &>(tree_).End());
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+bool small_set<Key, Capacity, Options>::empty() const noexcept {
+  return small_.Empty() && tree_.Empty();
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::size_type
+small_set<Key, Capacity, Options>::size() const noexcept {
+  return is_small() ? small_.Size() : tree_.Size();
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::size_type
+small_set<Key, Capacity, Options>::max_size() const noexcept {
+  return tree_.MaxSize();
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+bool small_set<Key, Capacity, Options>::is_small() const noexcept {
+  return tree_.Empty();
+}
+
+/**
+ * @brief Удаляет все ключи. Дерево освобождается, и множество снова хранит
+ * ключи во встроенном массиве.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+void small_set<Key, Capacity, Options>::clear() noexcept {
+  small_.Clear();
+  tree_.Clear();
+}
+
+/**
+ * @brief Вставляет копию ключа, если его еще нет.
+ *
+ * @param value Ключ.
+ * @return Пара из итератора на ключ и флага вставки.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+std::pair<typename small_set<Key, Capacity, Options>::iterator, bool>
+small_set<Key, Capacity, Options>::insert(const value_type &value) {
+  return Insert(value);
+}
+
+/**
+ * @brief Вставляет ключ перемещением, если его еще нет. Если ключ уже есть,
+ * value не трогается.
+ *
+ * @param value Ключ.
+ * @return Пара из итератора на ключ и флага вставки.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+std::pair<typename small_set<Key, Capacity, Options>::iterator, bool>
+small_set<Key, Capacity, Options>::insert(value_type &&value) {
+  return Insert(std::move(value));
+}
+
+/**
+ * @brief Создает ключ из args и вставляет его, если такого еще нет.
+ *
+ * Место ключа известно только после его создания, поэтому ключ строится
+ * заранее и затем переносится на место.
+ *
+ * @param args Аргументы конструктора ключа.
+ * @return Пара из итератора на ключ и флага вставки.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+template <typename... Args>
+std::pair<typename small_set<Key, Capacity, Options>::iterator, bool>
+small_set<Key, Capacity, Options>::emplace(Args &&...args) {
+  return Insert(value_type(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Удаляет ключ, на который указывает pos.
+ *
+ * @param pos Итератор на существующий ключ.
+ * @return Итератор на следующий ключ.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::iterator
+small_set<Key, Capacity, Options>::erase(iterator pos) {
+  if (is_small()) {
+    const size_type position =
+        static_cast<size_type>(pos.element_ - small_.Data());
+    small_.Erase(position);
+    return SmallIteratorAt(position);
+  }
+  typename tree_type::iterator next = pos.node_;
+  ++next;
+  tree_.Erase(pos.node_);
+  // Удален последний ключ дерева: множество снова хранит ключи в массиве.
+  return tree_.Empty() ? end() : TreeIterator(next);
+}
+
+/**
+ * @brief Удаляет ключ, если он есть.
+ *
+ * @param key Ключ.
+ * @return Число удаленных ключей: 0 или 1.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::size_type
+small_set<Key, Capacity, Options>::erase(const key_type &key) {
+  iterator pos = find(key);
+  if (pos == end()) {
+    return 0;
+  }
+  erase(pos);
+  return 1;
+}
+
+/**
+ * @brief Обменивает содержимое с other. Ключи встроенных массивов
+ * переносятся поштучно, поэтому итераторы на них становятся
+ * недействительными.
+ *
+ * @param other Другое множество.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+void small_set<Key, Capacity, Options>::swap(small_set &other) {
+  small_set tmp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(tmp);
+}
+
+/**
+ * @brief Возвращает ключи из дерева во встроенный массив, если их не больше
+ * Capacity, и освобождает узлы дерева.
+ *
+ * Ключи переносятся, если их конструктор перемещения не бросает
+ * исключений, и копируются иначе; при исключении множество не меняется.
+ * Все итераторы и ссылки на ключи становятся недействительными.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+void small_set<Key, Capacity, Options>::shrink_to_fit() {
+  if (is_small() || tree_.Size() > Capacity) {
+    return;
+  }
+  try {
+    for (auto it = tree_.Begin(); it != tree_.End(); ++it) {
+      small_.Emplace(small_.Size(), std::move_if_noexcept(*it));
+    }
+  } catch (...) {
+    small_.Clear();
+    throw;
+  }
+  tree_.Clear();
+}
+
+/**
+ * @brief Ищет ключ.
+ *
+ * @param key Искомый ключ.
+ * @return Итератор на ключ или end().
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::iterator
+small_set<Key, Capacity, Options>::find(const key_type &key) const {
+  if (is_small()) {
+    return SmallIteratorAt(SmallFind(key));
+  }
+  return TreeIterator(const_cast<tree_type &>(tree_).Find(key));
+}
+
+/**
+ * @brief Проверяет наличие ключа без построения итераторов.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+bool small_set<Key, Capacity, Options>::contains(const key_type &key) const {
+  if (is_small()) {
+    return SmallFind(key) != small_.Size();
+  }
+  return tree_.Find(key) != tree_.End();
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::size_type
+small_set<Key, Capacity, Options>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Итератор на первый ключ, не меньший key.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::iterator
+small_set<Key, Capacity, Options>::lower_bound(const key_type &key) const {
+  if (is_small()) {
+    return SmallIteratorAt(SmallLowerBound(key));
+  }
+  return TreeIterator(const_cast<tree_type &>(tree_).LowerBound(key));
+}
+
+/**
+ * @brief Итератор на первый ключ, больший key.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::iterator
+small_set<Key, Capacity, Options>::upper_bound(const key_type &key) const {
+  if (is_small()) {
+    return SmallIteratorAt(SmallUpperBound(key));
+  }
+  return TreeIterator(const_cast<tree_type &>(tree_).UpperBound(key));
+}
+
+/**
+ * @brief Размер самого множества вместе со встроенным массивом и узлами
+ * дерева. Пока ключи в массиве, это sizeof(small_set).
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::size_type
+small_set<Key, Capacity, Options>::memory_usage() const {
+  return sizeof(*this) - sizeof(tree_type) + tree_.MemoryUsage();
+}
+
+/**
+ * @brief Общая часть insert и emplace.
+ *
+ * Пока в массиве есть место, ключ вставляется в него со сдвигом хвоста.
+ * Новый ключ для полного массива сначала переносит весь массив в дерево.
+ * Если при переносе бросается исключение, множество не меняется.
+ *
+ * @param value Ключ, копируемый или перемещаемый в контейнер.
+ * @return Пара из итератора на ключ и флага вставки.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+template <typename Value>
+std::pair<typename small_set<Key, Capacity, Options>::iterator, bool>
+small_set<Key, Capacity, Options>::Insert(Value &&value) {
+  if (is_small()) {
+    const size_type position = SmallLowerBound(value);
+    if (position < small_.Size() &&
+        !std::less<key_type>()(value, small_.Data()[position])) {
+      return {SmallIteratorAt(position), false};
+    }
+    if (!small_.Full()) {
+      small_.Emplace(position, std::forward<Value>(value));
+      return {SmallIteratorAt(position), true};
+    }
+    Promote();
+  }
+  auto [node, inserted] = tree_.TryConstruct(value, std::forward<Value>(value));
+  return {TreeIterator(node), inserted};
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::size_type
+small_set<Key, Capacity, Options>::SmallLowerBound(const key_type &key) const {
+  return small_.template LowerBound<KeyOf>(key, std::less<key_type>());
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::size_type
+small_set<Key, Capacity, Options>::SmallUpperBound(const key_type &key) const {
+  return small_.template UpperBound<KeyOf>(key, std::less<key_type>());
+}
+
+/**
+ * @brief Номер ключа key во встроенном массиве или его размер, если такого
+ * ключа нет.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::size_type
+small_set<Key, Capacity, Options>::SmallFind(const key_type &key) const {
+  return small_.template Find<KeyOf>(key, std::less<key_type>());
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::iterator
+small_set<Key, Capacity, Options>::SmallIteratorAt(
+    size_type position) const noexcept {
+  return iterator(small_.Data() + position,
+                  const_cast<tree_type &>(tree_).End());
+}
+
+template <typename Key, std::size_t Capacity, typename Options>
+typename small_set<Key, Capacity, Options>::iterator
+small_set<Key, Capacity, Options>::TreeIterator(
+    typename tree_type::iterator node) const noexcept {
+  return iterator(nullptr, node);
+}
+
+/**
+ * @brief Переносит полный встроенный массив в дерево.
+ *
+ * Массив уже упорядочен, поэтому дерево собирается за O(Capacity) без
+ * поворотов (AssignSorted). Ключи, чей конструктор перемещения может
+ * бросить исключение, копируются, чтобы при сбое массив остался целым.
+ */
+template <typename Key, std::size_t Capacity, typename Options>
+void small_set<Key, Capacity, Options>::Promote() {
+  value_type *data = small_.Data();
+  if constexpr (std::is_nothrow_move_constructible_v<value_type>) {
+    tree_.AssignSorted(std::make_move_iterator(data),
+                       std::make_move_iterator(data + small_.Size()));
+  } else {
+    tree_.AssignSorted(data, data + small_.Size());
+  }
+  small_.Clear();
+}
+
+} // namespace s21
@@ -0,0 +1,345 @@
+#ifndef S21_CONTAINERS_SMALL_S21_SMALL_STORAGE_H_
+#define S21_CONTAINERS_SMALL_S21_SMALL_STORAGE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Упорядоченный массив не более Capacity элементов, который хранится в самом
+// объекте и не выделяет память. Порядок поддерживает владелец: вставка
+// сдвигает хвост массива вправо, удаление - влево, поэтому итераторы и
+// ссылки на элементы после места вставки или удаления становятся
+// недействительными.
+//
+// Элементы переносятся конструктором перемещения. Если он бросает
+// исключение, массив сохраняет целостность, но теряет элементы после места
+// сбоя. Поэтому владелец хранит элементы, которые переносятся без
+// исключений: small_map - пары с неконстантным ключом, а не value_type.
+template <typename Value, std::size_t Capacity> class SmallStorage {
+public:
+  using size_type = std::size_t;
+
+  static_assert(Capacity > 0, "Встроенный массив не может быть пустым");
+
+  SmallStorage() noexcept { ZeroSlots(); }
+
+  SmallStorage(const SmallStorage &other) {
+    ZeroSlots();
+    try {
+      for (; size_ < other.size_; ++size_) {
+        ::new (Slot(size_)) Value(other.Data()[size_]);
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+  }
+
+  // Забирает элементы other; other остается пустым.
+  SmallStorage(SmallStorage &&other) noexcept(
+      std::is_nothrow_move_constructible_v<Value>) {
+    ZeroSlots();
+    MoveFrom(other);
+  }
+
+  // Присваивания заменяют элементы целиком. Если копирование бросает
+  // исключение, массив не меняется; если перенос - остается пустым.
+  SmallStorage &operator=(const SmallStorage &other) {
+    if (this != &other) {
+      SmallStorage copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  SmallStorage &operator=(SmallStorage &&other) noexcept(
+      std::is_nothrow_move_constructible_v<Value>) {
+    if (this != &other) {
+      Clear();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  ~SmallStorage() { Clear(); }
+
+  Value *Data() noexcept { return reinterpret_cast<Value *>(slots_); }
+  const Value *Data() const noexcept {
+    return reinterpret_cast<const Value *>(slots_);
+  }
+
+  [[nodiscard]] size_type Size() const noexcept { return size_; }
+  [[nodiscard]] bool Empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] bool Full() const noexcept { return size_ == Capacity; }
+
+  // Поиск места ключа key; KeyOf достает ключ из элемента. Арифметические
+  // ключи со стандартным компаратором сравниваются со всеми элементами без
+  // ветвлений (Count): ответ складывается из числа меньших и равных ключей,
+  // и поиск не платит за неверно предсказанный выход из цикла. Остальные
+  // ключи просматриваются по порядку до первого подходящего.
+
+  // Номер первого элемента, ключ которого не меньше key.
+  template <typename KeyOf, typename Compare, typename Key>
+  size_type LowerBound(const Key &key, const Compare &compare) const {
+    if constexpr (kBranchless<KeyOf, Compare, Key>) {
+      return Count<KeyOf>(key).first;
+    } else {
+      const Value *data = Data();
+      size_type position = 0;
+      while (position < size_ && compare(KeyOf()(data[position]), key)) {
+        ++position;
+      }
+      return position;
+    }
+  }
+
+  // Номер первого элемента, ключ которого больше key.
+  template <typename KeyOf, typename Compare, typename Key>
+  size_type UpperBound(const Key &key, const Compare &compare) const {
+    if constexpr (kBranchless<KeyOf, Compare, Key>) {
+      const auto [less, equal] = Count<KeyOf>(key);
+      return less + equal;
+    } else {
+      const Value *data = Data();
+      size_type position = 0;
+      while (position < size_ && !compare(key, KeyOf()(data[position]))) {
+        ++position;
+      }
+      return position;
+    }
+  }
+
+  // Номер элемента с ключом key или Size(), если такого нет.
+  template <typename KeyOf, typename Compare, typename Key>
+  size_type Find(const Key &key, const Compare &compare) const {
+    if constexpr (kBranchless<KeyOf, Compare, Key>) {
+      const auto [less, equal] = Count<KeyOf>(key);
+      return equal != 0 ? less : size_;
+    } else {
+      const size_type position = LowerBound<KeyOf>(key, compare);
+      return position < size_ && !compare(key, KeyOf()(Data()[position]))
+                 ? position
+                 : size_;
+    }
+  }
+
+  // Создает элемент на месте position, сдвигая хвост вправо. Массив не
+  // должен быть полон. Если конструктор элемента бросает исключение, хвост
+  // возвращается на место.
+  template <typename... Args>
+  Value *Emplace(size_type position, Args &&...args) {
+    ShiftRight(position);
+    try {
+      ::new (Slot(position)) Value(std::forward<Args>(args)...);
+    } catch (...) {
+      ShiftLeft(position);
+      throw;
+    }
+    ++size_;
+    return Data() + position;
+  }
+
+  // Удаляет элемент на месте position, сдвигая хвост влево.
+  void Erase(size_type position) {
+    Data()[position].~Value();
+    --size_;
+    ShiftLeft(position);
+  }
+
+  void Clear() noexcept {
+    Value *data = Data();
+    for (size_type i = size_; i > 0; --i) {
+      data[i - 1].~Value();
+    }
+    size_ = 0;
+  }
+
+private:
+  // Элементы - сами арифметические ключи. Свободные места такого массива
+  // заполнены нулями, поэтому поиск может читать весь массив.
+  static constexpr bool kArithmetic = std::is_arithmetic_v<Value>;
+
+  template <typename KeyOf, typename Compare, typename Key>
+  static constexpr bool kBranchless =
+      std::is_arithmetic_v<Key> &&
+      std::is_same_v<std::decay_t<decltype(KeyOf()(std::declval<Value &>()))>,
+                     Key> &&
+      (std::is_same_v<Compare, std::less<Key>> ||
+       std::is_same_v<Compare, std::less<>>);
+
+  // Число ключей, меньших key, и число ключей, равных key. Массив самих
+  // арифметических ключей просматривается целиком: у цикла постоянное
+  // число шагов Capacity, и компилятор векторизует его уже на -O2 (но
+  // только со счетчиками unsigned, а не size_type). Ключи внутри элементов
+  // (например, пар карты) так не читаются: свободные места не заполнены.
+  template <typename KeyOf, typename Key>
+  std::pair<unsigned, unsigned> Count(Key key) const noexcept {
+    const Value *data = Data();
+    const unsigned size = static_cast<unsigned>(size_);
+    unsigned less = 0;
+    unsigned equal = 0;
+    if constexpr (kArithmetic && std::is_same_v<Key, Value>) {
+      for (unsigned i = 0; i < Capacity; ++i) {
+        const bool live = i < size;
+        less += live & (data[i] < key);
+        equal += live & !(data[i] < key) & !(key < data[i]);
+      }
+    } else {
+      for (unsigned i = 0; i < size; ++i) {
+        const Key current = KeyOf()(data[i]);
+        less += current < key;
+        equal += !(current < key) & !(key < current);
+      }
+    }
+    return {less, equal};
+  }
+
+  void ZeroSlots() noexcept {
+    if constexpr (kArithmetic) {
+      std::fill(std::begin(slots_), std::end(slots_), 0);
+    }
+  }
+
+  // Общая часть перемещающих конструктора и присваивания: переносит
+  // элементы other в пустой массив, после чего other становится пустым.
+  void MoveFrom(SmallStorage &other) {
+    try {
+      for (; size_ < other.size_; ++size_) {
+        ::new (Slot(size_)) Value(std::move(other.Data()[size_]));
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+    other.Clear();
+  }
+
+  void *Slot(size_type position) noexcept {
+    return slots_ + position * sizeof(Value);
+  }
+
+  // Сдвигает элементы [position, size_) на одно место вправо; место position
+  // остается пустым. При исключении элементы после места сбоя уничтожаются.
+  void ShiftRight(size_type position) {
+    Value *data = Data();
+    for (size_type i = size_; i > position; --i) {
+      try {
+        ::new (Slot(i)) Value(std::move(data[i - 1]));
+      } catch (...) {
+        DropTail(i, i + 1, size_ + 1);
+        throw;
+      }
+      data[i - 1].~Value();
+    }
+  }
+
+  // Сдвигает элементы [position + 1, size_ + 1) на одно место влево, закрывая
+  // пустое место position.
+  void ShiftLeft(size_type position) {
+    Value *data = Data();
+    for (size_type i = position; i < size_; ++i) {
+      try {
+        ::new (Slot(i)) Value(std::move(data[i + 1]));
+      } catch (...) {
+        DropTail(i, i + 1, size_ + 1);
+        throw;
+      }
+      data[i + 1].~Value();
+    }
+  }
+
+  // Восстановление после исключения при сдвиге: живые элементы - [0, keep)
+  // и [first, last); вторые уничтожаются, и массив сокращается до keep.
+  void DropTail(size_type keep, size_type first, size_type last) noexcept {
+    Value *data = Data();
+    for (size_type i = first; i < last; ++i) {
+      data[i].~Value();
+    }
+    size_ = keep;
+  }
+
+  alignas(Value) unsigned char slots_[Capacity * sizeof(Value)];
+  size_type size_ = 0;
+};
+
+// Итератор контейнера с двумя представлениями: пока элементы лежат во
+// встроенном массиве, итератор - указатель element_ на элемент, а node_ -
+// End() пустого дерева; после перехода на дерево element_ равен nullptr, а
+// node_ - итератор дерева.
+template <typename Value, typename TreeIterator> struct SmallIterator {
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::remove_const_t<Value>;
+  using pointer = Value *;
+  using reference = Value &;
+
+  SmallIterator(Value *element, TreeIterator node) noexcept
+      : element_(element), node_(node) {}
+
+  // Неконстантный итератор приводится к константному.
+  template <typename OtherValue, typename OtherIterator,
+            typename = std::enable_if_t<
+                std::is_convertible_v<OtherValue *, Value *> &&
+                std::is_convertible_v<OtherIterator, TreeIterator>>>
+  SmallIterator(const SmallIterator<OtherValue, OtherIterator> &other) noexcept
+      : element_(other.element_), node_(other.node_) {}
+
+  reference operator*() const noexcept {
+    return element_ != nullptr ? *element_ : *node_;
+  }
+
+  pointer operator->() const noexcept { return &**this; }
+
+  SmallIterator &operator++() noexcept {
+    if (element_ != nullptr) {
+      ++element_;
+    } else {
+      ++node_;
+    }
+    return *this;
+  }
+
+  SmallIterator operator++(int) noexcept {
+    SmallIterator tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+
+  SmallIterator &operator--() noexcept {
+    if (element_ != nullptr) {
+      --element_;
+    } else {
+      --node_;
+    }
+    return *this;
+  }
+
+  SmallIterator operator--(int) noexcept {
+    SmallIterator tmp = *this;
+    --(*this);
+    return tmp;
+  }
+
+  friend bool operator==(const SmallIterator &lhs,
+                         const SmallIterator &rhs) noexcept {
+    return lhs.element_ == rhs.element_ && lhs.node_ == rhs.node_;
+  }
+
+  friend bool operator!=(const SmallIterator &lhs,
+                         const SmallIterator &rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  Value *element_;
+  TreeIterator node_;
+};
+
+} // namespace s21
+
+#endif // S21_CONTAINERS_SMALL_S21_SMALL_STORAGE_H_
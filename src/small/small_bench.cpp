@@ -0,0 +1,110 @@
+// Замер малых контейнеров: s21::map<int, int> против small_map<int, int> и
+// s21::set<int> против small_set<int> (встроенный массив на 8 элементов) на
+// размерах от 0 до 32. Для каждого размера замеряются создание с вставкой
+// всех ключей и уничтожение (build) и полный обход (scan) в наносекундах на
+// контейнер, а также поиск (find) в наносекундах на случайный запрос.
+//
+// Сборка: g++ -std=c++17 -O2 small_bench.cpp -o small_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../map/s21_map.h"
+#include "../set/s21_set.h"
+#include "s21_small_map.h"
+#include "s21_small_set.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kRounds = 200000;
+
+double NanosecondsPerOp(Clock::time_point start, std::size_t ops) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+             .count() /
+         static_cast<double>(ops);
+}
+
+template <typename Container> void Add(Container &container, int key) {
+  if constexpr (std::is_same_v<typename Container::key_type,
+                               typename Container::value_type>) {
+    container.insert(key);
+  } else {
+    container.insert(key, key);
+  }
+}
+
+int KeyOf(int key) { return key; }
+int KeyOf(const std::pair<const int, int> &item) { return item.first; }
+
+template <typename Container>
+void Run(const char *name, const std::vector<int> &keys) {
+  const std::size_t size = keys.size();
+  std::size_t sink = 0;
+
+  auto start = Clock::now();
+  for (std::size_t round = 0; round < kRounds; ++round) {
+    Container container;
+    for (int key : keys) {
+      Add(container, key);
+    }
+    sink += container.size();
+  }
+  const double build_ns = NanosecondsPerOp(start, kRounds);
+
+  Container container;
+  for (int key : keys) {
+    Add(container, key);
+  }
+  // Случайный поток запросов: четные ключи есть в контейнере, нечетные -
+  // нет. Повторяющийся порядок запросов предсказатель переходов выучил бы.
+  std::mt19937 gen(static_cast<unsigned>(size));
+  std::vector<int> queries(4096);
+  for (int &query : queries) {
+    query = static_cast<int>(gen() % (2 * size + 1));
+  }
+  start = Clock::now();
+  for (std::size_t round = 0; round < kRounds / 64; ++round) {
+    for (int query : queries) {
+      sink += container.contains(query);
+    }
+  }
+  const double find_ns =
+      NanosecondsPerOp(start, kRounds / 64 * queries.size());
+
+  start = Clock::now();
+  for (std::size_t round = 0; round < kRounds; ++round) {
+    for (auto it = container.begin(); it != container.end(); ++it) {
+      sink += static_cast<std::size_t>(KeyOf(*it));
+    }
+  }
+  const double scan_ns = NanosecondsPerOp(start, kRounds);
+
+  std::printf("  %-10s size %2zu  build %7.1f ns  find %7.1f ns  "
+              "scan %6.1f ns  %4zu bytes  (sink %zu)\n",
+              name, size, build_ns, find_ns, scan_ns,
+              container.memory_usage(), sink);
+}
+} // namespace
+
+int main() {
+  std::mt19937 gen(48);
+  for (std::size_t size : {0, 1, 2, 4, 8, 16, 32}) {
+    std::vector<int> keys(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      keys[i] = static_cast<int>(i) * 2;
+    }
+    std::shuffle(keys.begin(), keys.end(), gen);
+    std::printf("%zu random keys\n", size);
+    Run<s21::map<int, int>>("map", keys);
+    Run<s21::small_map<int, int>>("small_map", keys);
+    Run<s21::set<int>>("set", keys);
+    Run<s21::small_set<int>>("small_set", keys);
+  }
+  return 0;
+}
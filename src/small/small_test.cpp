@@ -0,0 +1,357 @@
+#include "s21_small_map.h"
+#include "s21_small_set.h"
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+// Число вызовов глобального operator new в тестах.
+std::size_t allocations = 0;
+} // namespace
+
+// Замена глобальных operator new/delete считает выделения памяти, как в
+// set_test.cpp; noinline нужен по той же причине (-Wmismatched-new-delete).
+[[gnu::noinline]] void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *memory) noexcept {
+  std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+namespace s21 {
+namespace {
+template <typename Set>
+std::vector<typename Set::value_type> Forward(const Set &set) {
+  return std::vector<typename Set::value_type>(set.begin(), set.end());
+}
+
+template <typename Set>
+std::vector<typename Set::value_type> Backward(const Set &set) {
+  std::vector<typename Set::value_type> items;
+  for (auto it = set.end(); it != set.begin();) {
+    --it;
+    items.push_back(*it);
+  }
+  return std::vector<typename Set::value_type>(items.rbegin(), items.rend());
+}
+
+// Ключ, копирование которого бросает исключение по счетчику.
+struct FragileKey {
+  explicit FragileKey(int value) : value_(value) {}
+  FragileKey(const FragileKey &other) : value_(other.value_) {
+    if (copies_left_ >= 0 && copies_left_-- == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  FragileKey &operator=(const FragileKey &) = default;
+
+  bool operator<(const FragileKey &other) const {
+    return value_ < other.value_;
+  }
+
+  int value_;
+  static inline int copies_left_ = -1;
+};
+
+// Ключ вроде std::string: копирование может бросить исключение, а
+// перемещение - нет.
+struct CopyThrowingKey : FragileKey {
+  using FragileKey::FragileKey;
+  CopyThrowingKey(const CopyThrowingKey &) = default;
+  CopyThrowingKey(CopyThrowingKey &&other) noexcept
+      : FragileKey(other.value_) {}
+  CopyThrowingKey &operator=(const CopyThrowingKey &) = default;
+};
+} // namespace
+
+TEST(SmallSetTest, MatchesStdSetAcrossPromotion) {
+  std::mt19937 gen(48);
+  small_set<int, 4> set;
+  std::set<int> expected;
+  for (int step = 0; step < 4000; ++step) {
+    const int key = static_cast<int>(gen() % 12);
+    switch (gen() % 6) {
+    case 0:
+    case 1: {
+      auto [it, inserted] = set.insert(key);
+      EXPECT_EQ(inserted, expected.insert(key).second);
+      EXPECT_EQ(*it, key);
+      break;
+    }
+    case 2:
+      EXPECT_EQ(set.erase(key), expected.erase(key));
+      break;
+    case 3: {
+      auto it = set.lower_bound(key);
+      auto std_it = expected.lower_bound(key);
+      ASSERT_EQ(it == set.end(), std_it == expected.end());
+      if (std_it != expected.end()) {
+        EXPECT_EQ(*it, *std_it);
+      }
+      it = set.upper_bound(key);
+      std_it = expected.upper_bound(key);
+      ASSERT_EQ(it == set.end(), std_it == expected.end());
+      if (std_it != expected.end()) {
+        EXPECT_EQ(*it, *std_it);
+      }
+      break;
+    }
+    case 4:
+      EXPECT_EQ(set.contains(key), expected.count(key) == 1);
+      break;
+    default:
+      set.shrink_to_fit();
+      EXPECT_EQ(set.is_small(), expected.size() <= 4);
+      break;
+    }
+    ASSERT_EQ(set.size(), expected.size());
+    if (expected.size() > 4) {
+      EXPECT_FALSE(set.is_small());
+    }
+    ASSERT_EQ(Forward(set), std::vector<int>(expected.begin(), expected.end()));
+    ASSERT_EQ(Backward(set), Forward(set));
+  }
+}
+
+TEST(SmallSetTest, StaysInlineUntilFull) {
+  small_set<int> set;
+  const std::size_t before = allocations;
+  for (int key = 7; key >= 0; --key) {
+    set.insert(key);
+  }
+  const bool found = set.contains(3) && !set.contains(8);
+  set.erase(5);
+  set.insert(5);
+  const std::size_t inline_allocations = allocations - before;
+  EXPECT_EQ(inline_allocations, 0u);
+  EXPECT_TRUE(found);
+  EXPECT_TRUE(set.is_small());
+  EXPECT_EQ(set.memory_usage(), sizeof(set));
+
+  auto [it, inserted] = set.insert(8);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, 8);
+  EXPECT_FALSE(set.is_small());
+  EXPECT_GT(set.memory_usage(), sizeof(set));
+  EXPECT_EQ(Forward(set), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+  // Удаление до Capacity ключей оставляет дерево; вернуть массив можно
+  // только явно.
+  set.erase(0);
+  set.erase(8);
+  EXPECT_FALSE(set.is_small());
+  set.shrink_to_fit();
+  EXPECT_TRUE(set.is_small());
+  EXPECT_EQ(set.memory_usage(), sizeof(set));
+  EXPECT_EQ(Forward(set), (std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST(SmallSetTest, EraseReturnsNextIterator) {
+  for (int count : {3, 6}) {
+    small_set<int, 4> set;
+    for (int key = 0; key < count; ++key) {
+      set.insert(key * 10);
+    }
+    auto it = set.erase(set.find(10));
+    ASSERT_NE(it, set.end());
+    EXPECT_EQ(*it, 20);
+    std::vector<int> rest;
+    for (it = set.begin(); it != set.end();) {
+      rest.push_back(*it);
+      it = set.erase(it);
+    }
+    EXPECT_EQ(rest.size(), static_cast<std::size_t>(count - 1));
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.is_small());
+    EXPECT_EQ(set.begin(), set.end());
+  }
+}
+
+TEST(SmallSetTest, StringKeysCopyMoveAndSwap) {
+  small_set<std::string, 2> small{"beta", "alpha"};
+  small_set<std::string, 2> large{"delta", "alpha", "charlie", "bravo"};
+  EXPECT_TRUE(small.is_small());
+  EXPECT_FALSE(large.is_small());
+
+  small_set<std::string, 2> copy = large;
+  EXPECT_EQ(copy, large);
+  copy = small;
+  EXPECT_EQ(copy, small);
+  EXPECT_NE(copy, large);
+
+  std::string key(40, 'z');
+  auto [it, inserted] = copy.insert(std::move(key));
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(it->size(), 40u);
+  EXPECT_FALSE(copy.is_small());
+
+  small.swap(large);
+  EXPECT_EQ(Forward(small), (std::vector<std::string>{"alpha", "bravo",
+                                                      "charlie", "delta"}));
+  EXPECT_EQ(Forward(large), (std::vector<std::string>{"alpha", "beta"}));
+
+  small_set<std::string, 2> moved(std::move(small));
+  EXPECT_TRUE(small.empty());
+  EXPECT_EQ(moved.size(), 4u);
+  moved = std::move(large);
+  EXPECT_TRUE(large.empty());
+  EXPECT_EQ(Forward(moved), (std::vector<std::string>{"alpha", "beta"}));
+  EXPECT_EQ(moved.emplace(3, 'a').first->size(), 3u);
+}
+
+TEST(SmallMapTest, MatchesStdMapAcrossPromotion) {
+  std::mt19937 gen(480);
+  small_map<int, std::string, 4> map;
+  std::map<int, std::string> expected;
+  for (int step = 0; step < 4000; ++step) {
+    const int key = static_cast<int>(gen() % 12);
+    const std::string value = std::to_string(step);
+    switch (gen() % 7) {
+    case 0:
+      map[key] += value;
+      expected[key] += value;
+      break;
+    case 1:
+      EXPECT_EQ(map.insert_or_assign(key, value).second,
+                expected.insert_or_assign(key, value).second);
+      break;
+    case 2:
+      EXPECT_EQ(map.try_emplace(key, 2, 'x').second,
+                expected.try_emplace(key, 2, 'x').second);
+      break;
+    case 3:
+      EXPECT_EQ(map.insert({key, value}).second,
+                expected.insert({key, value}).second);
+      break;
+    case 4:
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+      break;
+    case 5:
+      if (expected.count(key) == 1) {
+        EXPECT_EQ(map.at(key), expected.at(key));
+      } else {
+        EXPECT_THROW(map.at(key), std::out_of_range);
+      }
+      break;
+    default:
+      map.shrink_to_fit();
+      EXPECT_EQ(map.is_small(), expected.size() <= 4);
+      break;
+    }
+    ASSERT_EQ(map.size(), expected.size());
+    ASSERT_TRUE(std::equal(map.begin(), map.end(), expected.begin(),
+                           expected.end()));
+  }
+}
+
+TEST(SmallMapTest, ConstAccessAndBounds) {
+  small_map<int, int, 4> map{{5, 50}, {1, 10}, {3, 30}};
+  for (int extra : {0, 1}) {
+    if (extra == 1) {
+      map.insert(7, 70);
+      map.insert(9, 90);
+      EXPECT_FALSE(map.is_small());
+    }
+    const auto &view = map;
+    EXPECT_EQ(view.at(3), 30);
+    EXPECT_EQ(view.lower_bound(2)->first, 3);
+    EXPECT_EQ(view.upper_bound(3)->first, 5);
+    EXPECT_EQ(view.find(4), view.end());
+    EXPECT_EQ(view.count(5), 1u);
+    small_map<int, int, 4>::const_iterator last = map.end();
+    --last;
+    EXPECT_EQ(last->first, extra == 1 ? 9 : 5);
+    map.find(1)->second = 11;
+    EXPECT_EQ(view.begin()->second, 11);
+  }
+}
+
+TEST(SmallMapTest, MoveOnlyValues) {
+  small_map<int, std::unique_ptr<int>, 2> map;
+  for (int key = 0; key < 5; ++key) {
+    map.try_emplace(key, std::make_unique<int>(key * key));
+  }
+  EXPECT_FALSE(map.is_small());
+  map.erase(0);
+  map.erase(1);
+  map.erase(4);
+  map.shrink_to_fit();
+  EXPECT_TRUE(map.is_small());
+  EXPECT_EQ(*map.at(2), 4);
+  EXPECT_EQ(*map.at(3), 9);
+
+  small_map<int, std::unique_ptr<int>, 2> other(std::move(map));
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(*other[3], 9);
+  EXPECT_EQ(other[8], nullptr);
+  EXPECT_FALSE(other.is_small());
+}
+
+TEST(SmallMapTest, FailedPromotionLeavesMapIntact) {
+  small_map<FragileKey, int, 3> map;
+  for (int key = 0; key < 3; ++key) {
+    map.insert(FragileKey(key), key);
+  }
+  // Ключ без перемещающего конструктора переносится копированием; сбой на
+  // второй копии прерывает перенос массива в дерево.
+  FragileKey::copies_left_ = 1;
+  EXPECT_THROW(map.insert(FragileKey(3), 3), std::runtime_error);
+  FragileKey::copies_left_ = -1;
+  EXPECT_TRUE(map.is_small());
+  ASSERT_EQ(map.size(), 3u);
+  int expected = 0;
+  for (const auto &[key, value] : map) {
+    EXPECT_EQ(key.value_, expected);
+    EXPECT_EQ(value, expected++);
+  }
+  EXPECT_TRUE(map.insert(FragileKey(3), 3).second);
+  EXPECT_FALSE(map.is_small());
+  EXPECT_EQ(map.at(FragileKey(3)), 3);
+}
+
+TEST(SmallMapTest, ShiftsDoNotCopyKeys) {
+  small_map<CopyThrowingKey, int, 4> map;
+  for (int key : {0, 2, 4}) {
+    map.insert(CopyThrowingKey(key), key * 10);
+  }
+  // Любая копия ключа бросает исключение. Сдвиги массива переносят ключи,
+  // поэтому сбой возможен только при создании самой новой пары, и тогда
+  // остальные пары остаются на месте.
+  const std::pair<const CopyThrowingKey, int> copied(CopyThrowingKey(1), 10);
+  FragileKey::copies_left_ = 0;
+  EXPECT_THROW(map.insert(copied), std::runtime_error);
+  FragileKey::copies_left_ = 0;
+  ASSERT_EQ(map.size(), 3u);
+  EXPECT_TRUE(map.insert(CopyThrowingKey(1), 10).second);
+  EXPECT_EQ(map.erase(CopyThrowingKey(0)), 1u);
+  FragileKey::copies_left_ = -1;
+  EXPECT_TRUE(map.is_small());
+  std::vector<std::pair<int, int>> items;
+  for (const auto &[key, value] : map) {
+    items.emplace_back(key.value_, value);
+  }
+  EXPECT_EQ(items,
+            (std::vector<std::pair<int, int>>{{1, 10}, {2, 20}, {4, 40}}));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21
@@ -0,0 +1,145 @@
+#ifndef S21_CONTAINERS_STATS_CONTAINERSTATS_H_
+#define S21_CONTAINERS_STATS_CONTAINERSTATS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace s21 {
+
+// Снимок счетчиков горячего пути контейнера. Счетчики, не имеющие смысла для
+// данного контейнера (например, повороты у списка), остаются нулевыми.
+struct ContainerStats {
+  std::size_t comparisons = 0;   // вызовы компаратора
+  std::size_t rotations = 0;     // повороты дерева
+  std::size_t recolorings = 0;   // смены цвета узлов при балансировке
+  std::size_t allocations = 0;   // выделенные узлы
+  std::size_t deallocations = 0; // освобожденные узлы
+  std::size_t descents = 0;      // спуски от корня (поиск, вставка)
+  std::size_t max_depth = 0;     // наибольшая глубина спуска
+  double average_depth = 0.0;    // средняя глубина спуска
+
+  std::string ToJson() const;
+};
+
+/**
+ * @brief Сериализует снимок счетчиков в JSON-объект в одну строку.
+ *
+ * @return Строка вида {"comparisons":..., ..., "average_depth":...}.
+ */
+inline std::string ContainerStats::ToJson() const {
+  std::string json = "{";
+  auto append = [&json](const char *name, const std::string &value) {
+    if (json.size() > 1) {
+      json += ",";
+    }
+    json += "\"";
+    json += name;
+    json += "\":";
+    json += value;
+  };
+
+  append("comparisons", std::to_string(comparisons));
+  append("rotations", std::to_string(rotations));
+  append("recolorings", std::to_string(recolorings));
+  append("allocations", std::to_string(allocations));
+  append("deallocations", std::to_string(deallocations));
+  append("descents", std::to_string(descents));
+  append("max_depth", std::to_string(max_depth));
+  append("average_depth", std::to_string(average_depth));
+  json += "}";
+  return json;
+}
+
+// Счетчики, которые контейнер ведет во время работы. Выключенный вариант не
+// содержит данных, а все его методы пустые, поэтому после встраивания от
+// вызовов не остается ни одной инструкции.
+template <bool Enabled> class StatsCounters {
+public:
+  void Compare() const noexcept {}
+  void Rotate() const noexcept {}
+  void Recolor(std::size_t = 1) const noexcept {}
+  void Allocate(std::size_t = 1) const noexcept {}
+  void Deallocate(std::size_t = 1) const noexcept {}
+  void Descent(std::size_t) const noexcept {}
+  ContainerStats Snapshot() const noexcept { return {}; }
+  void Reset() const noexcept {}
+};
+
+// Включенный вариант. Счетчики изменяемы и в константных методах
+// контейнера (поиск тоже считается), поэтому они атомарные: несколько
+// читателей, разделяющих контейнер под общей блокировкой, могут искать
+// одновременно. Порядок доступа ослабленный (relaxed) - счетчики ничего не
+// синхронизируют, а снимок, снятый во время работы читателей, может
+// сочетать значения из разных моментов.
+template <> class StatsCounters<true> {
+public:
+  void Compare() const noexcept { Add(comparisons_, 1); }
+  void Rotate() const noexcept { Add(rotations_, 1); }
+  void Recolor(std::size_t count = 1) const noexcept {
+    Add(recolorings_, count);
+  }
+  void Allocate(std::size_t count = 1) const noexcept {
+    Add(allocations_, count);
+  }
+  void Deallocate(std::size_t count = 1) const noexcept {
+    Add(deallocations_, count);
+  }
+
+  void Descent(std::size_t depth) const noexcept {
+    Add(descents_, 1);
+    Add(total_depth_, depth);
+    std::size_t seen = max_depth_.load(std::memory_order_relaxed);
+    while (depth > seen && !max_depth_.compare_exchange_weak(
+                               seen, depth, std::memory_order_relaxed)) {
+    }
+  }
+
+  ContainerStats Snapshot() const noexcept {
+    ContainerStats stats;
+    stats.comparisons = Load(comparisons_);
+    stats.rotations = Load(rotations_);
+    stats.recolorings = Load(recolorings_);
+    stats.allocations = Load(allocations_);
+    stats.deallocations = Load(deallocations_);
+    stats.descents = Load(descents_);
+    stats.max_depth = Load(max_depth_);
+    if (stats.descents > 0) {
+      stats.average_depth = static_cast<double>(Load(total_depth_)) /
+                            static_cast<double>(stats.descents);
+    }
+    return stats;
+  }
+
+  void Reset() const noexcept {
+    for (Counter *counter : {&comparisons_, &rotations_, &recolorings_,
+                             &allocations_, &deallocations_, &descents_,
+                             &total_depth_, &max_depth_}) {
+      counter->store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  using Counter = std::atomic<std::size_t>;
+
+  static void Add(Counter &counter, std::size_t count) noexcept {
+    counter.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  static std::size_t Load(const Counter &counter) noexcept {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+  mutable Counter comparisons_{0};
+  mutable Counter rotations_{0};
+  mutable Counter recolorings_{0};
+  mutable Counter allocations_{0};
+  mutable Counter deallocations_{0};
+  mutable Counter descents_{0};
+  mutable Counter total_depth_{0};
+  mutable Counter max_depth_{0};
+};
+
+} // namespace s21
+
+#endif // S21_CONTAINERS_STATS_CONTAINERSTATS_H_
@@ -0,0 +1,22 @@
+#ifndef S21_CONTAINERS_TREE_ORDEREDTREE_H_
+#define S21_CONTAINERS_TREE_ORDEREDTREE_H_
+
+#include <type_traits>
+
+#include "RedBlackTree.h"
+#include "SelfAdjustingTree.h"
+
+namespace s21 {
+
+// Дерево, на котором строятся map и set, по Options::backend: красно-черное
+// по умолчанию, косое или декартово для потоков обращений с небольшим
+// числом горячих ключей, например map<Key, Type, SplayTreeOptions>.
+template <typename Key, typename Comparator, typename Options>
+using OrderedTree =
+    std::conditional_t<Options::backend == TreeBackend::kRedBlack,
+                       RedBlackTree<Key, Comparator, Options>,
+                       SelfAdjustingTree<Key, Comparator, Options>>;
+
+} // namespace s21
+
+#endif // S21_CONTAINERS_TREE_ORDEREDTREE_H_
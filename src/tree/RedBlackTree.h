@@ -1,28 +1,221 @@
 #ifndef S21_CONTAINERS_S21_CONTAINERS_REDBLACKTREE_H_
 #define S21_CONTAINERS_S21_CONTAINERS_REDBLACKTREE_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <functional>
+#include <iterator>
 #include <limits>
-#include <stack>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "../stats/ContainerStats.h"
+#include "RedBlackTreeAlgorithms.h"
+#include "TreeAggregate.h"
+
+// Трехстороннее сравнение доступно только начиная с C++20; в C++17 дерево
+// сравнивает ключи через <.
+#if __cplusplus > 201703L && __has_include(<compare>)
+#include <compare>
+#endif
+#if defined(__cpp_impl_three_way_comparison) &&                               \
+    defined(__cpp_lib_three_way_comparison)
+#define S21_CONTAINERS_THREE_WAY 1
+#else
+#define S21_CONTAINERS_THREE_WAY 0
+#endif
+
 namespace s21 {
 
-enum Color { BLACK, RED };
-template <typename Key, typename Comparator = std::less<Key>>
+// Теоретико-множественная операция над двумя деревьями: в результат
+// попадают ключи обоих деревьев, общие ключи, ключи только левого дерева или
+// ключи ровно одного из деревьев. При совпадении ключей берется элемент
+// левого дерева.
+enum class SetOperation {
+  kUnion,
+  kIntersection,
+  kDifference,
+  kSymmetricDifference
+};
+
+// Порядок узлов в памяти после уплотнения дерева (Compact): по порядку
+// ключей - для последовательных обходов - или ван Эмде Боаса: сначала
+// верхняя половина уровней дерева, затем каждое нижнее поддерево, и так
+// рекурсивно, чтобы путь поиска задевал O(log_B n) строк кеша любого
+// размера B.
+enum class CompactOrder { kInOrder, kVanEmdeBoas };
+
+// Упорядоченное дерево, на котором строятся map и set (см. OrderedTree.h):
+// красно-черное, косое (splay) или декартово (treap) со случайными либо
+// растущими от обращений приоритетами.
+enum class TreeBackend { kRedBlack, kSplay, kTreap, kFrequencyTreap };
+
+// Проба поиска: значение, которое компаратор дерева сравнивает с ключами в
+// обе стороны, но которое нельзя привести к ключу, например ссылка на ключ
+// пары карты без значения. Для проб Find, LowerBound и UpperBound ищут без
+// временного ключа; остальные аргументы идут в перегрузки с самим ключом.
+template <typename Probe, typename Key>
+using EnableIfTreeProbe =
+    std::enable_if_t<!std::is_convertible<const Probe &, Key>::value, int>;
+
+// Исполнитель задач дерева по умолчанию: все задачи по очереди в текущем
+// потоке. Потоки подключает заголовок TreeParallel.h (ThreadTreeExecutor,
+// ParallelTreeOptions), чтобы <thread> и <future> не попадали к каждому
+// пользователю map и set.
+struct SerialTreeExecutor {
+  static unsigned Concurrency() noexcept { return 1; }
+
+  // Выполняет job для каждой задачи и возвращает первое исключение.
+  template <typename Task, typename Job>
+  static std::exception_ptr Run(const std::vector<Task *> &tasks, Job job) {
+    std::exception_ptr error;
+    for (Task *task : tasks) {
+      try {
+        job(task);
+      } catch (...) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+    return error;
+  }
+};
+
+// Параметры красно-черного дерева по умолчанию. Чтобы изменить отдельный
+// параметр, достаточно унаследоваться от этой структуры и переопределить его.
+struct DefaultTreeOptions {
+  // Реализация дерева для map и set. Остальные параметры, кроме stats,
+  // относятся только к красно-черному дереву.
+  static constexpr TreeBackend backend = TreeBackend::kRedBlack;
+  // Узлы хранят ссылки на соседей по порядку обхода (прошитое дерево):
+  // переход итератора к следующему/предыдущему элементу - одно чтение
+  // указателя, но каждый узел занимает на два указателя больше.
+  static constexpr bool threaded = false;
+  // Дерево ведет счетчики горячего пути (сравнения, повороты, выделения
+  // узлов, глубина спусков), доступные через Stats().
+  // В выключенном состоянии счетчики не занимают места и не стоят ни одной
+  // инструкции.
+  static constexpr bool stats = false;
+  // Агрегат поддерева, который хранится в каждом узле (см. TreeAggregate.h)
+  // и дает Aggregate(lo, hi) за O(log n). По умолчанию не хранится.
+  using aggregate = NoAggregate;
+  // Компактная раскладка узла: цвет и служебный флаг хранятся в младших
+  // битах указателя на родителя, а узел общего блока вместо указателя на
+  // блок хранит 32-битный номер ячейки. Связи занимают три указателя: узел
+  // с ключом до 8 байт укладывается в 32 байта, а узел общего блока - с
+  // ключом до 4 байт. Цена - маскирование при каждом чтении родителя и цвета
+  // и не более 2^32 - 1 узлов в одном блоке.
+  static constexpr bool compact = false;
+  // Исполнитель, на котором копирование дерева и слияние деревьев в
+  // теоретико-множественных операциях делятся на независимые поддеревья,
+  // если в дереве (в обоих деревьях) не меньше parallel_threshold узлов и
+  // исполнителю доступно больше одного потока.
+  using executor = SerialTreeExecutor;
+  static constexpr std::size_t parallel_threshold = std::size_t{1} << 16;
+};
+
+struct ThreadedTreeOptions : DefaultTreeOptions {
+  static constexpr bool threaded = true;
+};
+
+struct StatsTreeOptions : DefaultTreeOptions {
+  static constexpr bool stats = true;
+};
+
+struct CompactTreeOptions : DefaultTreeOptions {
+  static constexpr bool compact = true;
+};
+
+template <typename Aggregate>
+struct AggregateTreeOptions : DefaultTreeOptions {
+  using aggregate = Aggregate;
+};
+
+// Ссылки прошитого дерева. Для обычного дерева база пустая и не увеличивает
+// размер узла.
+template <typename Node, bool Threaded> struct TreeThreadLinks {};
+
+template <typename Node> struct TreeThreadLinks<Node, true> {
+  Node *next_ = nullptr;
+  Node *prev_ = nullptr;
+};
+
+// Способ сравнения ключей деревом. ordering - компаратор сам возвращает
+// std::strong_ordering или std::weak_ordering (результат сравнивается с
+// нулем); spaceship - стандартный компаратор заменяется оператором <=>
+// ключа. В обоих случаях одно сравнение сразу отличает "меньше", "равно" и
+// "больше".
+template <typename Key, typename Comparator> struct TreeComparison {
+#if S21_CONTAINERS_THREE_WAY
+  static constexpr bool ordering = std::is_convertible_v<
+      std::invoke_result_t<const Comparator &, const Key &, const Key &>,
+      std::weak_ordering>;
+  static constexpr bool spaceship =
+      (std::is_same_v<Comparator, std::less<Key>> ||
+       std::is_same_v<Comparator, std::less<>>) &&
+      std::three_way_comparable<Key, std::weak_ordering>;
+#else
+  static constexpr bool ordering = false;
+  static constexpr bool spaceship = false;
+#endif
+};
+
+template <typename Key, typename Comparator = std::less<Key>,
+          typename Options = DefaultTreeOptions>
 class RedBlackTree {
 private:
   struct RedBlackTreeNode;
+  struct NodeBlock;
+  struct PooledNode;
+  struct CopyTask;
+  struct MergeTask;
+  struct Subtree;
+  struct InsertPosition;
+  struct CompactionPass;
   struct RedBlackTreeIterator;
   struct RedBlackTreeIteratorConst;
+  class NodeHandle;
+  struct NodeInsertResult;
+
+  // Ключ арифметического типа со стандартным компаратором: такой ключ
+  // дешевле передать по значению, чем по ссылке, а порядок задан встроенным
+  // оператором <, поэтому поиск обходится одним сравнением на уровень и
+  // выбирает потомка без ветвлений.
+  static constexpr bool kArithmeticKey =
+      std::is_arithmetic<Key>::value &&
+      (std::is_same<Comparator, std::less<Key>>::value ||
+       std::is_same<Comparator, std::less<>>::value);
+
+  // Поиск и вставка с проверкой уникальности сравнивают ключи один раз на
+  // уровень трехсторонним сравнением. Арифметическим ключам оно не нужно:
+  // для них быстрее одно сравнение < без ветвлений.
+  static constexpr bool kThreeWay =
+      !kArithmeticKey && (TreeComparison<Key, Comparator>::ordering ||
+                          TreeComparison<Key, Comparator>::spaceship);
+
+  // Узлы хранят агрегаты поддеревьев.
+  static constexpr bool kAggregated =
+      !std::is_same<typename Options::aggregate, NoAggregate>::value;
 
 public:
   using key_type = Key;
   using reference = key_type &;
   using const_reference = const key_type &;
+  using key_arg_type =
+      std::conditional_t<kArithmeticKey, key_type, const key_type &>;
   using iterator = RedBlackTreeIterator;
   using const_iterator = RedBlackTreeIteratorConst;
   using size_type = std::size_t;
+  using stats_type = StatsCounters<Options::stats>;
+  using node_type = NodeHandle;
+  using insert_return_type = NodeInsertResult;
+  using aggregate_type = typename Options::aggregate::value_type;
 
   // Конструкторы и деструкторы
   RedBlackTree();
@@ -34,15 +227,46 @@ public:
 
   // Основные методы работы с деревом (вставка, поиск, удаление и т.д.)
   iterator Insert(const key_type &key);
+  iterator Insert(key_type &&key);
   std::pair<iterator, bool> InsertUnique(const key_type &key);
+  std::pair<iterator, bool> InsertUnique(key_type &&key);
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> Emplace(Args &&...args);
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> EmplaceUnique(Args &&...args);
-  iterator Find(const_reference key);
-  iterator LowerBound(const_reference key);
-  iterator UpperBound(const_reference key);
+  // Построение одного элемента прямо в узле из аргументов его конструктора
+  template <typename... Args> iterator Construct(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> ConstructUnique(Args &&...args);
+  template <typename Probe, typename... Args>
+  std::pair<iterator, bool> TryConstruct(const Probe &probe, Args &&...args);
+  iterator Find(key_arg_type key);
+  iterator LowerBound(key_arg_type key);
+  iterator UpperBound(key_arg_type key);
+  const_iterator Find(key_arg_type key) const;
+  const_iterator LowerBound(key_arg_type key) const;
+  const_iterator UpperBound(key_arg_type key) const;
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  iterator Find(const Probe &probe);
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  iterator LowerBound(const Probe &probe);
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  iterator UpperBound(const Probe &probe);
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  const_iterator Find(const Probe &probe) const;
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  const_iterator LowerBound(const Probe &probe) const;
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  const_iterator UpperBound(const Probe &probe) const;
   void Erase(iterator position) noexcept;
+  iterator Erase(iterator first, iterator last) noexcept;
+  template <typename Predicate> size_type EraseIf(Predicate pred);
+
+  // Работа с узлами без перевыделения памяти
+  node_type Extract(iterator position) noexcept;
+  node_type Extract(const_reference key);
+  iterator Insert(node_type &&node);
+  insert_return_type InsertUnique(node_type &&node);
 
   // Методы работы с итераторами
   iterator Begin() noexcept;
@@ -58,130 +282,309 @@ public:
   void Merge(RedBlackTree &other);
   void MergeUnique(RedBlackTree &other);
   void Swap(RedBlackTree &other) noexcept;
+  static RedBlackTree Combine(const RedBlackTree &lhs, const RedBlackTree &rhs,
+                              SetOperation operation);
+  void CombineWith(const RedBlackTree &other, SetOperation operation);
   [[nodiscard]] bool CheckTree() const noexcept;
 
+  // Агрегаты поддеревьев (только при Options::aggregate). Границы - ключи
+  // или пробы, которые компаратор сравнивает с ключами в обе стороны.
+  template <typename Bound>
+  aggregate_type Aggregate(const Bound &lo, const Bound &hi) const;
+  void UpdateAggregates(iterator position) noexcept;
+  template <typename SkipSubtree, typename Visit>
+  void VisitInOrder(SkipSubtree skip_subtree, Visit visit) const;
+
+  // Построение из упорядоченной последовательности за O(n)
+  template <typename ForwardIt>
+  void AssignSorted(ForwardIt first, ForwardIt last);
+
+  // Уплотнение: перенос узлов в один непрерывный блок целиком или
+  // порциями не более max_nodes узлов за вызов
+  void Compact(CompactOrder order = CompactOrder::kInOrder);
+  bool CompactStep(size_type max_nodes,
+                   CompactOrder order = CompactOrder::kInOrder);
+
+  // Счетчики горячего пути (заполнены только при Options::stats)
+  [[nodiscard]] ContainerStats Stats() const noexcept;
+  void ResetStats() noexcept;
+
+  // Память, занятая деревом вместе с узлами и их блоками, в байтах
+  [[nodiscard]] size_type MemoryUsage() const;
+
 private:
+  // Балансировка и обход по связям узлов (общие с интрузивными
+  // контейнерами)
+  using TreeAlgorithms = RedBlackTreeAlgorithms<RedBlackTreeNode>;
+  using executor = typename Options::executor;
+
   // Внутренние методы для работы с узлами и деревом
-  void HandleBlackCases(RedBlackTreeNode *deleted_node);
-  void HandleK2Case(RedBlackTreeNode *deleted_node);
-  void HandleDeletionCases(RedBlackTreeNode *deleted_node);
-  void UpdateParentAndHeadLinks(RedBlackTreeNode *deleted_node);
   void CopyTreeFromOther(const RedBlackTree &other);
-  RedBlackTreeNode *CopyTree(const RedBlackTreeNode *node,
-                             RedBlackTreeNode *parent);
+  static RedBlackTreeNode *CopyTree(const RedBlackTreeNode *source,
+                                    PooledNode *slots, size_type &constructed,
+                                    NodeBlock *block);
+  static RedBlackTreeNode *CopyTreeParallel(const RedBlackTreeNode *source,
+                                            PooledNode *slots,
+                                            NodeBlock *block);
+  static void CollectCopyTasks(const RedBlackTreeNode *source, int depth,
+                               std::vector<CopyTask> &tasks);
+  static RedBlackTreeNode *LinkCopyTasks(const RedBlackTreeNode *source,
+                                         int depth, CopyTask *&task) noexcept;
+  static size_type CountNodes(const RedBlackTreeNode *node) noexcept;
+  static bool Parallel(size_type nodes) noexcept;
+  static int ParallelDepth() noexcept;
+  std::vector<MergeTask> PlanMerge(const RedBlackTree &other,
+                                          bool parallel) const;
+  template <typename Emit>
+  void MergeRanges(const MergeTask &task, SetOperation operation,
+                   Emit &&emit) const;
+  static NodeBlock *AllocateBlock(size_type count);
+  static PooledNode *BlockSlots(NodeBlock *block) noexcept;
+  static NodeBlock *SlotsBlock(PooledNode *slots) noexcept;
+  static void ReleaseBlock(NodeBlock *block) noexcept;
+  static void UnrefBlock(NodeBlock *block) noexcept;
+  void FreeNode(RedBlackTreeNode *node) noexcept;
+  static void DeleteNode(RedBlackTreeNode *node) noexcept;
   void Destroy(RedBlackTreeNode *node) noexcept;
   void InitializeHead() noexcept;
-  void HandleLeftCase(RedBlackTreeNode *node);
-  void HandleRightCase(RedBlackTreeNode *node);
-  void HandleRedUncle(RedBlackTreeNode *parent, RedBlackTreeNode *uncle,
-                      RedBlackTreeNode *gparent);
-  void Rotate(RedBlackTreeNode *node, bool rotateRight) noexcept;
-  std::pair<iterator, bool> Insert(RedBlackTreeNode *root,
-                                   RedBlackTreeNode *newNnode,
+  void RelinkHead() noexcept;
+  void LinkThread(RedBlackTreeNode *node) noexcept;
+  static void UnlinkThread(RedBlackTreeNode *node) noexcept;
+  void LinkThreadsInBlock(PooledNode *slots, size_type count) noexcept;
+  void LinkThreadsInOrder(RedBlackTreeNode *const *nodes,
+                          size_type count) noexcept;
+  Subtree Detach(RedBlackTreeNode *node, int black_height) noexcept;
+  Subtree Join(Subtree left, RedBlackTreeNode *pivot, Subtree right) noexcept;
+  void Split(RedBlackTreeNode *const *path, int length, int black_height,
+             Subtree &left, Subtree &right) noexcept;
+  void SplitAt(RedBlackTreeNode *node, Subtree tree, Subtree &left,
+               Subtree &right) noexcept;
+  static int BlackHeight(const RedBlackTreeNode *node) noexcept;
+  static int Height(const RedBlackTreeNode *node) noexcept;
+  static void CollectVanEmdeBoas(RedBlackTreeNode *node, int levels,
+                                 std::vector<RedBlackTreeNode *> &order);
+  static void CollectLevel(RedBlackTreeNode *node, int depth,
+                           std::vector<RedBlackTreeNode *> &level);
+  void BeginCompaction(CompactOrder order);
+  void AbortCompaction() noexcept;
+  void ForgetNode(const RedBlackTreeNode *node) noexcept;
+  RedBlackTreeNode *Relocate(RedBlackTreeNode *node, PooledNode *slot,
+                             NodeBlock *block);
+  void AdoptInOrder(RedBlackTreeNode *const *nodes, size_type count) noexcept;
+  static RedBlackTreeNode *BuildBalanced(RedBlackTreeNode *const *nodes,
+                                         size_type count, size_type depth,
+                                         size_type red_depth) noexcept;
+  template <typename Lhs, typename Rhs>
+  bool Less(const Lhs &lhs, const Rhs &rhs) const;
+  template <typename Lhs, typename Rhs>
+  int ThreeWay(const Lhs &lhs, const Rhs &rhs) const;
+  template <typename Probe>
+  InsertPosition Locate(const Probe &probe, bool check_duplicates);
+  template <typename Probe> iterator LocateEqual(const Probe &probe);
+  template <typename Probe> iterator LocateLower(const Probe &probe);
+  template <typename Probe> iterator LocateUpper(const Probe &probe);
+  iterator Link(const InsertPosition &position,
+                RedBlackTreeNode *node) noexcept;
+  std::pair<iterator, bool> Insert(RedBlackTreeNode *newNnode,
                                    bool check_duplicates);
-  void BalancingInsert(RedBlackTreeNode *node);
-  void RotateRight(RedBlackTreeNode *node) noexcept;
-  void RotateLeft(RedBlackTreeNode *node) noexcept;
   RedBlackTreeNode *ExtractNode(iterator position) noexcept;
-  void SwapNodes(RedBlackTreeNode *node_a, RedBlackTreeNode *node_b) noexcept;
-  void UpdateParent(RedBlackTreeNode *node, RedBlackTreeNode *newNode) noexcept;
-  void SwapNodesAndUpdateAfterErase(RedBlackTreeNode *node,
-                                    RedBlackTreeNode *survivor) noexcept;
-  void EraseBalancing(RedBlackTreeNode *deleted_node) noexcept;
-  void HandleBlackSiblingWithRedChild(RedBlackTreeNode *parent,
-                                      RedBlackTreeNode *&check_node);
-  void HandleBlackSiblingWithBlackChildren(RedBlackTreeNode *parent,
-                                           RedBlackTreeNode *&check_node);
-  void HandleRedSibling(RedBlackTreeNode *parent,
-                        RedBlackTreeNode *&check_node);
-  RedBlackTreeNode *GoRight(RedBlackTreeNode *node) const noexcept;
-  RedBlackTreeNode *GoLeft(RedBlackTreeNode *node) const noexcept;
-  RedBlackTreeNode *SearchMinimum(RedBlackTreeNode *node) const noexcept;
-  RedBlackTreeNode *SearchMaximum(RedBlackTreeNode *node) const noexcept;
   int ComputeBlackHeight(const RedBlackTreeNode *node) const noexcept;
   bool checkRedNodes(const RedBlackTreeNode *Node) const noexcept;
+  static bool CheckAggregates(const RedBlackTreeNode *node) noexcept;
+  template <typename SkipSubtree, typename Visit>
+  bool VisitSubtree(const RedBlackTreeNode *node, SkipSubtree &skip_subtree,
+                    Visit &visit) const;
+
+  struct RedBlackTreeNode
+      : TreeThreadLinks<RedBlackTreeNode, Options::threaded>,
+        TreeAggregateData<RedBlackTreeNode, typename Options::aggregate>,
+        TreeNodeLinks<RedBlackTreeNode, Options::compact> {
+    // Фиктивный узел: ключ не создается, поэтому от key_type не требуется
+    // конструктор по умолчанию.
+    RedBlackTreeNode() noexcept {
+      this->left_ = this;
+      this->right_ = this;
+      if constexpr (Options::threaded) {
+        this->next_ = this;
+        this->prev_ = this;
+      }
+    }
+
+    explicit RedBlackTreeNode(const key_type &key) : key_(key) {}
 
-  struct RedBlackTreeNode {
-    RedBlackTreeNode()
-        : parent_(nullptr), left_(this), right_(this), key_(key_type{}),
-          color_(RED) {}
+    explicit RedBlackTreeNode(key_type &&key) : key_(std::move(key)) {}
 
-    explicit RedBlackTreeNode(const key_type &key)
-        : parent_(nullptr), left_(nullptr), right_(nullptr), key_(key),
-          color_(RED) {}
+    template <typename... Args>
+    explicit RedBlackTreeNode(std::in_place_t, Args &&...args)
+        : key_(std::forward<Args>(args)...) {}
 
-    explicit RedBlackTreeNode(key_type &&key)
-        : parent_(nullptr), left_(nullptr), right_(nullptr),
-          key_(std::move(key)), color_(RED) {}
+    template <typename K>
+    RedBlackTreeNode(K &&key, Color color) : key_(std::forward<K>(key)) {
+      this->set_color(color);
+    }
 
-    RedBlackTreeNode(key_type key, Color color)
-        : parent_(nullptr), left_(nullptr), right_(nullptr), key_(key),
-          color_(color) {}
+    // Узлы не копируются: ключ активен не у каждого узла.
+    RedBlackTreeNode(const RedBlackTreeNode &) = delete;
+    RedBlackTreeNode &operator=(const RedBlackTreeNode &) = delete;
+
+    // Уничтожает ключ. Для фиктивного узла не вызывается: тот хранится в
+    // дереве внутри объединения (см. head_).
+    ~RedBlackTreeNode() { key_.~key_type(); }
 
     void ToDefault() noexcept {
-      left_ = nullptr;
-      right_ = nullptr;
-      parent_ = nullptr;
-      color_ = RED;
+      this->left_ = nullptr;
+      this->right_ = nullptr;
+      this->set_parent(nullptr);
+      this->set_color(RED);
+      if constexpr (Options::threaded) {
+        this->next_ = nullptr;
+        this->prev_ = nullptr;
+      }
     }
 
     RedBlackTreeNode *NextNode() const noexcept {
-      auto *node = const_cast<RedBlackTreeNode *>(this);
-      if (node->color_ == RED &&
-          (node->parent_ == nullptr || node->parent_->parent_ == node)) {
-        node = node->left_;
-      } else if (node->right_ != nullptr) {
-        node = node->right_;
-
-        while (node->left_ != nullptr) {
-          node = node->left_;
-        }
-      } else {
-        RedBlackTreeNode *parent = node->parent_;
-
-        while (node == parent->right_) {
-          node = parent;
-          parent = parent->parent_;
-        }
-        if (node->right_ != parent) {
-          node = parent;
-        }
+      if constexpr (Options::threaded) {
+        return this->next_;
       }
-
-      return node;
+      return TreeAlgorithms::NextNode(this);
     }
 
     RedBlackTreeNode *PrevNode() const noexcept {
-      RedBlackTreeNode *node = const_cast<RedBlackTreeNode *>(this);
-
-      if (node->color_ == RED &&
-          (node->parent_ == nullptr || node->parent_->parent_ == node)) {
-        node = node->right_;
-      } else if (node->left_ != nullptr) {
-        node = node->left_;
-        while (node->right_ != nullptr) {
-          node = node->right_;
-        }
+      if constexpr (Options::threaded) {
+        return this->prev_;
+      }
+      return TreeAlgorithms::PrevNode(this);
+    }
+
+    // Узел размещен в общем блоке NodeBlock. Признак хранится служебным
+    // флагом связей и не занимает отдельного поля.
+    bool pooled() const noexcept { return this->flag(); }
+
+    // Ключ идет после связей: ключ, выровненный не строже 4 байт, занимает
+    // хвостовое выравнивание связей или следует вплотную за указателями.
+    // Объединение позволяет фиктивному узлу не создавать ключ.
+    union {
+      key_type key_;
+    };
+  };
+
+  // Заголовок непрерывного блока узлов. Блок освобождается, когда в нем не
+  // остается ни одного живого узла, поэтому узлы из блока можно свободно
+  // удалять по одному и переносить между деревьями. Узлы одного блока могут
+  // оказаться в разных контейнерах (merge, extract, уплотнение), которые
+  // разрушаются в разных потоках, поэтому счетчик атомарный. Незаконченный
+  // проход уплотнения держит на свой блок еще одну ссылку.
+  struct NodeBlock {
+    std::atomic<size_type> alive_;
+    size_type capacity_; // число ячеек в блоке
+  };
+
+  // Узел общего блока. Обычный узел хранит указатель на заголовок блока,
+  // компактный - 32-битный номер своей ячейки, который занимает хвостовое
+  // выравнивание узла; заголовок тогда находится вычитанием адресов.
+  struct PooledNode : RedBlackTreeNode {
+    template <typename K>
+    PooledNode(K &&key, Color color, NodeBlock *block)
+        : RedBlackTreeNode(std::forward<K>(key), color) {
+      this->set_flag(true);
+      if constexpr (Options::compact) {
+        block_ = static_cast<std::uint32_t>(this - BlockSlots(block));
       } else {
-        RedBlackTreeNode *parent = node->parent_;
-        while (node == parent->left_) {
-          node = parent;
-          parent = parent->parent_;
-        }
-        if (node->left_ != parent) {
-          node = parent;
-        }
+        block_ = block;
       }
+    }
 
-      return node;
+    NodeBlock *Block() noexcept {
+      if constexpr (Options::compact) {
+        return SlotsBlock(this - block_);
+      } else {
+        return block_;
+      }
+    }
+
+    const NodeBlock *Block() const noexcept {
+      return const_cast<PooledNode *>(this)->Block();
     }
+
+    std::conditional_t<Options::compact, std::uint32_t, NodeBlock *> block_;
+  };
+
+  // Часть дерева, копируемая отдельной задачей при параллельном копировании:
+  // либо целое поддерево, либо один узел над ним.
+  struct CopyTask {
+    const RedBlackTreeNode *source_;
+    bool subtree_;
+    size_type offset_;
+    size_type count_;
+    size_type constructed_;
+    RedBlackTreeNode *result_;
+  };
+
+  // Участок слияния двух деревьев: полуинтервалы [lhs_first_, lhs_last_)
+  // левого и [rhs_first_, rhs_last_) правого дерева в порядке обхода.
+  // Параллельное слияние делит деревья на участки, которые не пересекаются
+  // по ключам. picked_ - отобранные в результат узлы участка по порядку,
+  // их копии записываются в общий блок с позиции offset_.
+  struct MergeTask {
+    const RedBlackTreeNode *lhs_first_;
+    const RedBlackTreeNode *lhs_last_;
+    const RedBlackTreeNode *rhs_first_;
+    const RedBlackTreeNode *rhs_last_;
+    std::vector<const RedBlackTreeNode *> picked_;
+    size_type offset_;
+    size_type constructed_;
+  };
+
+  // Самостоятельное поддерево, получаемое при разрезании и склеивании дерева:
+  // корень (всегда черный, родитель nullptr) и черная высота - число черных
+  // узлов на любом пути от корня до листа, включая сам корень.
+  struct Subtree {
+    RedBlackTreeNode *root_;
+    int black_height_;
+  };
+
+  // Место для нового узла, найденное спуском от корня: родитель, ссылка в
+  // родителе, куда записывается узел (nullptr для пустого дерева), и признаки
+  // нового минимума и максимума. existing_ - узел с равным ключом, если
+  // спуск искал дубликаты и нашел его.
+  struct InsertPosition {
     RedBlackTreeNode *parent_;
-    RedBlackTreeNode *left_;
-    RedBlackTreeNode *right_;
-    key_type key_;
-    Color color_;
+    RedBlackTreeNode **link_;
+    bool leftmost_;
+    bool rightmost_;
+    RedBlackTreeNode *existing_;
   };
 
+  // Незаконченное пошаговое уплотнение (CompactStep): новый блок, число
+  // занятых в нем ячеек и следующий переносимый узел - после последнего
+  // перенесенного cursor_ в порядке ключей либо plan_[used_] в порядке
+  // ван Эмде Боаса. План порядка ван Эмде Боаса строится один раз на весь
+  // проход.
+  struct CompactionPass {
+    CompactOrder order_;
+    NodeBlock *block_;
+    size_type capacity_;
+    size_type used_;
+    RedBlackTreeNode *cursor_;
+    std::vector<RedBlackTreeNode *> plan_;
+  };
+
+  // Наибольшая возможная высота дерева: путь от корня до листа не длиннее
+  // удвоенной черной высоты, а та не больше log2(n + 1).
+  static constexpr int kMaxHeight = 2 * std::numeric_limits<size_type>::digits;
+
+  // Размер заголовка блока узлов с выравниванием до первой ячейки.
+  static constexpr size_type kBlockHeader =
+      (sizeof(NodeBlock) + alignof(PooledNode) - 1) / alignof(PooledNode) *
+      alignof(PooledNode);
+
+  // Наибольшее число узлов в блоке: компактный узел хранит номер ячейки в
+  // 32 битах.
+  static constexpr size_type kMaxBlockNodes =
+      Options::compact ? std::numeric_limits<std::uint32_t>::max()
+                       : std::numeric_limits<size_type>::max() /
+                             sizeof(PooledNode);
+
   struct RedBlackTreeIterator {
     using iterator_category = std::forward_iterator_tag;
     using difference_type = std::ptrdiff_t;
@@ -201,7 +604,7 @@ private:
     }
 
     iterator operator++(int) noexcept {
-      iterator tmp{node_};
+      iterator tmp = *this;
       ++(*this);
       return tmp;
     }
@@ -212,7 +615,7 @@ private:
     }
 
     iterator operator--(int) noexcept {
-      iterator tmp{node_};
+      iterator tmp = *this;
       --(*this);
       return tmp;
     }
@@ -250,7 +653,7 @@ private:
     }
 
     const_iterator operator++(int) noexcept {
-      const_iterator tmp{node_};
+      const_iterator tmp = *this;
       ++(*this);
       return tmp;
     }
@@ -261,7 +664,7 @@ private:
     }
 
     const_iterator operator--(int) noexcept {
-      const_iterator tmp{node_};
+      const_iterator tmp = *this;
       --(*this);
       return tmp;
     }
@@ -279,9 +682,93 @@ private:
     const RedBlackTreeNode *node_;
   };
 
-  RedBlackTreeNode *head_;
+  // Владеющий указатель на узел, извлеченный из дерева. Пока узел вне дерева,
+  // его значение (в том числе ключ) можно менять, а затем вставить узел в
+  // любое дерево того же типа без выделения памяти и копирования элемента.
+  class NodeHandle {
+  public:
+    NodeHandle() noexcept = default;
+
+    NodeHandle(NodeHandle &&other) noexcept : node_(other.node_) {
+      other.node_ = nullptr;
+    }
+
+    NodeHandle &operator=(NodeHandle &&other) noexcept {
+      if (this != &other) {
+        Reset();
+        node_ = other.node_;
+        other.node_ = nullptr;
+      }
+      return *this;
+    }
+
+    NodeHandle(const NodeHandle &) = delete;
+    NodeHandle &operator=(const NodeHandle &) = delete;
+
+    ~NodeHandle() { Reset(); }
+
+    [[nodiscard]] bool empty() const noexcept { return node_ == nullptr; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    // Элемент целиком (для множества - ключ, для карты - пара).
+    key_type &value() const noexcept { return node_->key_; }
+
+    // Ключ и значение элемента-пары (только для карты). Константность ключа
+    // в паре снимается: узел вне дерева, поэтому порядок не нарушается.
+    template <typename Value = key_type>
+    std::remove_const_t<typename Value::first_type> &key() const noexcept {
+      return const_cast<std::remove_const_t<typename Value::first_type> &>(
+          node_->key_.first);
+    }
+
+    template <typename Value = key_type>
+    typename Value::second_type &mapped() const noexcept {
+      return node_->key_.second;
+    }
+
+    void swap(NodeHandle &other) noexcept { std::swap(node_, other.node_); }
+
+  private:
+    friend class RedBlackTree;
+
+    explicit NodeHandle(RedBlackTreeNode *node) noexcept : node_(node) {}
+
+    RedBlackTreeNode *Release() noexcept {
+      RedBlackTreeNode *node = node_;
+      node_ = nullptr;
+      return node;
+    }
+
+    void Reset() noexcept {
+      if (node_ != nullptr) {
+        DeleteNode(node_);
+        node_ = nullptr;
+      }
+    }
+
+    RedBlackTreeNode *node_ = nullptr;
+  };
+
+  // Результат вставки узла с проверкой уникальности: при неудаче узел
+  // возвращается обратно вызывающему в поле node.
+  struct NodeInsertResult {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
+  // Фиктивный узел хранится в самом дереве: пустое дерево не выделяет
+  // память. head_.parent() - корень, left_ - минимум, right_ - максимум.
+  // Объединение не дает деструктору дерева уничтожать несозданный ключ
+  // фиктивного узла.
+  union {
+    RedBlackTreeNode head_;
+  };
   size_type size_;
   Comparator key_comparator_;
+  stats_type stats_;
+  // Состояние пошагового уплотнения; nullptr, если прохода нет
+  std::unique_ptr<CompactionPass> compaction_;
 };
 
 } // namespace s21
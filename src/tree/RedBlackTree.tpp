@@ -4,20 +4,26 @@ namespace s21 {
 
 /**
  * @brief Конструктор по умолчанию для красно-черного дерева.
- * Создает пустое красно-черное дерево.
+ * Создает пустое красно-черное дерево без выделения памяти: фиктивный узел
+ * хранится в самом дереве.
  */
-template <typename Key, typename Comparator>
-RedBlackTree<Key, Comparator>::RedBlackTree()
-    : head_(new RedBlackTreeNode), size_(0U) {}
+template <typename Key, typename Comparator, typename Options>
+RedBlackTree<Key, Comparator, Options>::RedBlackTree() : head_(), size_(0U) {}
 
 /**
  * @brief Конструктор копирования для красно-черного дерева.
  * Создает красно-черное дерево, являющееся копией другого дерева.
  *
+ * Узлы копии размещаются одним общим блоком (см. CopyTreeFromOther). Блок
+ * освобождается только вместе с последним своим узлом: если из копии
+ * удалить почти все элементы, оставшиеся узлы продолжают держать весь блок
+ * (это видно по MemoryUsage). Compact() переносит оставшиеся узлы в новый
+ * блок по размеру и освобождает старый.
+ *
  * @param other Дерево, которое нужно скопировать.
  */
-template <typename Key, typename Comparator>
-RedBlackTree<Key, Comparator>::RedBlackTree(const RedBlackTree &other)
+template <typename Key, typename Comparator, typename Options>
+RedBlackTree<Key, Comparator, Options>::RedBlackTree(const RedBlackTree &other)
     : RedBlackTree() {
   if (other.Size() > 0) {
     CopyTreeFromOther(other);
@@ -33,8 +39,9 @@ RedBlackTree<Key, Comparator>::RedBlackTree(const RedBlackTree &other)
  * @param other Дерево, содержимое которого будет перемещено в текущий объект.
  * @return Ничего не возвращает, так как это конструктор.
  */
-template <typename Key, typename Comparator>
-RedBlackTree<Key, Comparator>::RedBlackTree(RedBlackTree &&other) noexcept
+template <typename Key, typename Comparator, typename Options>
+RedBlackTree<Key, Comparator, Options>::RedBlackTree(
+    RedBlackTree &&other) noexcept
     : RedBlackTree() {
   // Проверка на самоприсваивание: если other и this указывают на один и тот же
   // объект
@@ -52,9 +59,9 @@ RedBlackTree<Key, Comparator>::RedBlackTree(RedBlackTree &&other) noexcept
  * скопировать
  * @return Ссылка на текущее дерево после копирования
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::RedBlackTree &
-RedBlackTree<Key, Comparator>::operator=(const RedBlackTree &other) {
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::RedBlackTree &
+RedBlackTree<Key, Comparator, Options>::operator=(const RedBlackTree &other) {
   if (this != &other) { // Проверка на самоприсваивание
     Clear();
     if (other.Size() > 0) {
@@ -74,9 +81,10 @@ RedBlackTree<Key, Comparator>::operator=(const RedBlackTree &other) {
  * @param other Другое дерево, с которым происходит обмен содержимым.
  * @return Ссылка на текущий экземпляр дерева после обмена.
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::RedBlackTree &
-RedBlackTree<Key, Comparator>::operator=(RedBlackTree &&other) noexcept {
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::RedBlackTree &
+RedBlackTree<Key, Comparator, Options>::operator=(
+    RedBlackTree &&other) noexcept {
   Clear();
   Swap(other); // Обмениваем содержимое текущего дерева с другим деревом.
   return *this; // Возвращаем ссылку на текущий экземпляр дерева.
@@ -85,14 +93,13 @@ RedBlackTree<Key, Comparator>::operator=(RedBlackTree &&other) noexcept {
 /**
  * @brief Деструктор класса красно-черного дерева
  *
- * Уничтожает все узлы дерева, освобождая занимаемую память,
- * и удаляет фиктивный узел (head_).
+ * Уничтожает все узлы дерева, освобождая занимаемую память. Фиктивный узел
+ * head_ не владеет ни ключом, ни памятью и не уничтожается.
  */
-template <typename Key, typename Comparator>
-RedBlackTree<Key, Comparator>::~RedBlackTree() {
-  Clear();
-  delete head_;
-  head_ = nullptr;
+template <typename Key, typename Comparator, typename Options>
+RedBlackTree<Key, Comparator, Options>::~RedBlackTree() {
+  AbortCompaction();
+  Destroy(head_.parent());
 }
 
 /**
@@ -102,10 +109,11 @@ RedBlackTree<Key, Comparator>::~RedBlackTree() {
  * Он использует вспомогательный метод Destroy для удаления всех узлов, затем
  * инициализирует "голову" дерева с помощью метода InitializeHead.
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::Clear() noexcept {
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::Clear() noexcept {
+  AbortCompaction();
   // Удаление всех узлов, начиная с корневого узла
-  Destroy(head_->parent_);
+  Destroy(head_.parent());
 
   // Инициализация "головы" дерева
   InitializeHead();
@@ -119,9 +127,9 @@ void RedBlackTree<Key, Comparator>::Clear() noexcept {
  *
  * @return Количество элементов в дереве.
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::size_type
-RedBlackTree<Key, Comparator>::Size() const noexcept {
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::size_type
+RedBlackTree<Key, Comparator, Options>::Size() const noexcept {
   return size_;
 }
 /**
@@ -129,8 +137,8 @@ RedBlackTree<Key, Comparator>::Size() const noexcept {
  *
  * @return Возвращает true, если дерево пусто, иначе false.
  */
-template <typename Key, typename Comparator>
-bool RedBlackTree<Key, Comparator>::Empty() const noexcept {
+template <typename Key, typename Comparator, typename Options>
+bool RedBlackTree<Key, Comparator, Options>::Empty() const noexcept {
   return size_ == 0;
 }
 
@@ -139,9 +147,9 @@ bool RedBlackTree<Key, Comparator>::Empty() const noexcept {
  *
  * @return Максимальное количество элементов, которое можно хранить в дереве.
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::size_type
-RedBlackTree<Key, Comparator>::MaxSize() const noexcept {
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::size_type
+RedBlackTree<Key, Comparator, Options>::MaxSize() const noexcept {
   return ((std::numeric_limits<size_type>::max() / 2) - sizeof(RedBlackTree) -
           sizeof(RedBlackTreeNode)) /
          sizeof(RedBlackTreeNode);
@@ -152,20 +160,20 @@ RedBlackTree<Key, Comparator>::MaxSize() const noexcept {
  *
  * @return Итератор к началу дерева
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::iterator
-RedBlackTree<Key, Comparator>::Begin() noexcept {
-  return iterator(head_->left_);
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::Begin() noexcept {
+  return iterator(head_.left_);
 }
 /**
  * @brief Возвращает константный итератор к началу дерева (самому левому узлу)
  *
  * @return Константный итератор к началу дерева
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::const_iterator
-RedBlackTree<Key, Comparator>::Begin() const noexcept {
-  return const_iterator(head_->left_);
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::const_iterator
+RedBlackTree<Key, Comparator, Options>::Begin() const noexcept {
+  return const_iterator(head_.left_);
 }
 
 /**
@@ -173,10 +181,10 @@ RedBlackTree<Key, Comparator>::Begin() const noexcept {
  *
  * @return Итератор к концу дерева
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::iterator
-RedBlackTree<Key, Comparator>::End() noexcept {
-  return iterator(head_);
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::End() noexcept {
+  return iterator(&head_);
 }
 
 /**
@@ -184,10 +192,10 @@ RedBlackTree<Key, Comparator>::End() noexcept {
  *
  * @return Константный итератор к концу дерева
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::const_iterator
-RedBlackTree<Key, Comparator>::End() const noexcept {
-  return const_iterator(head_);
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::const_iterator
+RedBlackTree<Key, Comparator, Options>::End() const noexcept {
+  return const_iterator(&head_);
 }
 
 /**
@@ -195,8 +203,8 @@ RedBlackTree<Key, Comparator>::End() const noexcept {
  *
  * @param other Дерево, которое будет объединено с текущим деревом.
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::Merge(RedBlackTree &other) {
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::Merge(RedBlackTree &other) {
   // Проверяем, что дерево other не является текущим деревом (this).
   if (this != &other) {
     // Если дерево other пустое, нет необходимости делать слияние.
@@ -225,8 +233,8 @@ void RedBlackTree<Key, Comparator>::Merge(RedBlackTree &other) {
  *
  * @param other Другое дерево, с которым происходит объединение.
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::MergeUnique(RedBlackTree &other) {
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::MergeUnique(RedBlackTree &other) {
   if (this != &other) {
     iterator other_iter = other.Begin();
     const iterator other_end = other.End();
@@ -245,7 +253,7 @@ void RedBlackTree<Key, Comparator>::MergeUnique(RedBlackTree &other) {
 
         // Извлекаем узел из дерева other и вставляем его в текущее дерево.
         RedBlackTreeNode *moving_node = other.ExtractNode(tmp);
-        Insert(head_->parent_, moving_node, false);
+        Insert(moving_node, false);
       } else {
         ++other_iter;
       }
@@ -264,11 +272,12 @@ void RedBlackTree<Key, Comparator>::MergeUnique(RedBlackTree &other) {
  * элемент с таким же ключом. Если ключ уже существует, то возвращается также
  * флаг "false".
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::iterator
-RedBlackTree<Key, Comparator>::Insert(const key_type &key) {
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::Insert(const key_type &key) {
   RedBlackTreeNode *newNode = new RedBlackTreeNode{key};
-  return Insert(head_->parent_, newNode, false).first;
+  stats_.Allocate();
+  return Insert(newNode, false).first;
 }
 
 /**
@@ -279,18 +288,111 @@ RedBlackTree<Key, Comparator>::Insert(const key_type &key) {
  * вставлен), и флаг, указывающий на успешность операции вставки. Если ключ уже
  * существует, возвращается итератор на существующий элемент и "false".
  */
-template <typename Key, typename Comparator>
-std::pair<typename RedBlackTree<Key, Comparator>::iterator, bool>
-RedBlackTree<Key, Comparator>::InsertUnique(const key_type &key) {
-  iterator it = Find(key);
-  if (it != End()) {
-    return {it, false};
+template <typename Key, typename Comparator, typename Options>
+std::pair<typename RedBlackTree<Key, Comparator, Options>::iterator, bool>
+RedBlackTree<Key, Comparator, Options>::InsertUnique(const key_type &key) {
+  return TryConstruct(key, key);
+}
+
+/**
+ * @brief Вставляет элемент, перемещая ключ в новый узел.
+ *
+ * @param key Ключ для вставки.
+ * @return Итератор на вставленный элемент.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::Insert(key_type &&key) {
+  RedBlackTreeNode *newNode = new RedBlackTreeNode{std::move(key)};
+  stats_.Allocate();
+  return Insert(newNode, false).first;
+}
+
+/**
+ * @brief Вставляет уникальный элемент, перемещая ключ в новый узел.
+ *
+ * Если такой ключ уже есть, key остается нетронутым.
+ *
+ * @param key Ключ для вставки.
+ * @return Пара из итератора на элемент с этим ключом и флага вставки.
+ */
+template <typename Key, typename Comparator, typename Options>
+std::pair<typename RedBlackTree<Key, Comparator, Options>::iterator, bool>
+RedBlackTree<Key, Comparator, Options>::InsertUnique(key_type &&key) {
+  return TryConstruct(key, std::move(key));
+}
+
+/**
+ * @brief Создает элемент прямо в новом узле из аргументов конструктора
+ * key_type и вставляет его (дубликаты допускаются).
+ *
+ * Элемент не копируется и не перемещается: например, пара карты строится
+ * через std::piecewise_construct сразу в узле.
+ *
+ * @param args Аргументы конструктора элемента.
+ * @return Итератор на вставленный элемент.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename... Args>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::Construct(Args &&...args) {
+  RedBlackTreeNode *newNode =
+      new RedBlackTreeNode(std::in_place, std::forward<Args>(args)...);
+  stats_.Allocate();
+  return Insert(newNode, false).first;
+}
+
+/**
+ * @brief Создает элемент прямо в новом узле и вставляет его, если такого
+ * ключа еще нет; иначе узел удаляется.
+ *
+ * Ключ известен только после создания элемента, поэтому узел создается
+ * всегда. Когда ключ доступен заранее, дешевле TryConstruct.
+ *
+ * @param args Аргументы конструктора элемента.
+ * @return Пара из итератора на элемент с этим ключом и флага вставки.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename... Args>
+std::pair<typename RedBlackTree<Key, Comparator, Options>::iterator, bool>
+RedBlackTree<Key, Comparator, Options>::ConstructUnique(Args &&...args) {
+  RedBlackTreeNode *newNode =
+      new RedBlackTreeNode(std::in_place, std::forward<Args>(args)...);
+  stats_.Allocate();
+  std::pair<iterator, bool> result = Insert(newNode, true);
+  if (!result.second) {
+    FreeNode(newNode);
   }
-  RedBlackTreeNode *newNode = new RedBlackTreeNode{key};
-  std::pair<iterator, bool> result = Insert(head_->parent_, newNode, true);
   return result;
 }
 
+/**
+ * @brief Создает элемент в новом узле, только если ключа probe в дереве нет.
+ *
+ * Место вставки находится одним спуском по probe - ключу или любому
+ * объекту, который компаратор сравнивает с ключами в обе стороны (карта
+ * передает ссылку на ключ без пары). Если ключ найден, элемент не создается
+ * и аргументы не трогаются; иначе элемент строится прямо в узле из args.
+ *
+ * @param probe Искомый ключ.
+ * @param args Аргументы конструктора элемента с ключом, равным probe.
+ * @return Пара из итератора на элемент с этим ключом и флага вставки.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, typename... Args>
+std::pair<typename RedBlackTree<Key, Comparator, Options>::iterator, bool>
+RedBlackTree<Key, Comparator, Options>::TryConstruct(const Probe &probe,
+                                                     Args &&...args) {
+  const InsertPosition position = Locate(probe, true);
+  if (position.existing_ != nullptr) {
+    return {iterator(position.existing_), false};
+  }
+  RedBlackTreeNode *newNode =
+      new RedBlackTreeNode(std::in_place, std::forward<Args>(args)...);
+  stats_.Allocate();
+  return {Link(position, newNode), true};
+}
+
 /**
  * @brief Вставляет элементы в дерево, используя переданные аргументы, и
  * возвращает вектор пар итераторов и флагов успешной вставки для каждого
@@ -302,10 +404,11 @@ RedBlackTree<Key, Comparator>::InsertUnique(const key_type &key) {
  * @param args Аргументы для создания элементов.
  * @return Вектор пар итераторов и флагов успешной вставки для каждого элемента.
  */
-template <typename Key, typename Comparator>
+template <typename Key, typename Comparator, typename Options>
 template <typename... Args>
-std::vector<std::pair<typename RedBlackTree<Key, Comparator>::iterator, bool>>
-RedBlackTree<Key, Comparator>::Emplace(Args &&...args) {
+std::vector<
+    std::pair<typename RedBlackTree<Key, Comparator, Options>::iterator, bool>>
+RedBlackTree<Key, Comparator, Options>::Emplace(Args &&...args) {
   std::vector<std::pair<iterator, bool>>
       insertion_results; // Результаты вставки будут храниться здесь.
   insertion_results.reserve(sizeof...(
@@ -315,8 +418,9 @@ RedBlackTree<Key, Comparator>::Emplace(Args &&...args) {
   auto emplaceItem = [&](auto &&item) {
     RedBlackTreeNode *newNode = new RedBlackTreeNode(
         std::forward<decltype(item)>(item)); // Создаем новый узел.
+    stats_.Allocate();
     std::pair<iterator, bool> insertion_result =
-        Insert(head_->parent_, newNode, false); // Вставляем узел в дерево.
+        Insert(newNode, false); // Вставляем узел в дерево.
     insertion_results.push_back(
         insertion_result); // Добавляем результат в вектор.
   };
@@ -339,10 +443,11 @@ RedBlackTree<Key, Comparator>::Emplace(Args &&...args) {
  * @param args Аргументы для создания элементов.
  * @return Вектор пар итераторов и флагов успешной вставки для каждого элемента.
  */
-template <typename Key, typename Comparator>
+template <typename Key, typename Comparator, typename Options>
 template <typename... Args>
-std::vector<std::pair<typename RedBlackTree<Key, Comparator>::iterator, bool>>
-RedBlackTree<Key, Comparator>::EmplaceUnique(Args &&...args) {
+std::vector<
+    std::pair<typename RedBlackTree<Key, Comparator, Options>::iterator, bool>>
+RedBlackTree<Key, Comparator, Options>::EmplaceUnique(Args &&...args) {
   std::vector<std::pair<iterator, bool>>
       insertion_results; // Результаты вставки будут храниться здесь.
   insertion_results.reserve(sizeof...(
@@ -352,11 +457,13 @@ RedBlackTree<Key, Comparator>::EmplaceUnique(Args &&...args) {
   auto emplaceUniqueItem = [&](auto &&item) {
     RedBlackTreeNode *newNode = new RedBlackTreeNode(
         std::forward<decltype(item)>(item)); // Создаем новый узел.
+    stats_.Allocate();
     std::pair<iterator, bool> insertion_result =
-        Insert(head_->parent_, newNode,
+        Insert(newNode,
                true); // Вставляем узел в дерево с уникальностью.
     if (!insertion_result.second) {
-      delete newNode; // Если вставка не удалась из-за дубликата, удаляем узел.
+      FreeNode(newNode); // Если вставка не удалась из-за дубликата, удаляем
+                         // узел.
     }
     insertion_results.push_back(
         insertion_result); // Добавляем результат в вектор.
@@ -372,26 +479,61 @@ RedBlackTree<Key, Comparator>::EmplaceUnique(Args &&...args) {
 /**
  * @brief Находит элемент в дереве по заданному ключу.
  *
- * @param key Ключ, по которому выполняется поиск элемента.
+ * Для арифметических ключей спуск идет как в LowerBound: одно сравнение на
+ * уровень без раннего выхода и одна проверка равенства в конце. Ветвление
+ * по результату сравнения заменено выбором значения, который компилятор
+ * превращает в условную пересылку, поэтому непредсказуемый переход
+ * влево/вправо не сбрасывает конвейер. При трехстороннем сравнении (C++20)
+ * одно сравнение на уровень сразу отличает совпадение от спуска влево или
+ * вправо.
+ *
+ * @param probe Ключ или проба, по которой выполняется поиск элемента.
  * @return Итератор на найденный элемент, если найден, или итератор к концу
  * дерева, если не найден.
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::iterator
-RedBlackTree<Key, Comparator>::Find(const_reference key) {
-  RedBlackTreeNode *current_node = head_->parent_;
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::LocateEqual(const Probe &probe) {
+  RedBlackTreeNode *current_node = head_.parent();
+  size_type depth = 0;
+  if constexpr (kArithmeticKey) {
+    RedBlackTreeNode *candidate = &head_; // Наименьший узел не меньше probe.
+    while (current_node) {
+      ++depth;
+      const bool go_right = Less(current_node->key_, probe);
+      candidate = go_right ? candidate : current_node;
+      current_node = go_right ? current_node->right_ : current_node->left_;
+    }
+    stats_.Descent(depth);
+    if (candidate != &head_ && !Less(probe, candidate->key_)) {
+      return iterator(candidate);
+    }
+    return End();
+  }
+
   while (current_node) {
-    if (key_comparator_(
-            key, current_node->key_)) { // Если key меньше ключа текущего узла.
+    ++depth;
+    int order = 0; // Знак сравнения probe с ключом узла.
+    if constexpr (kThreeWay) {
+      order = ThreeWay(probe, current_node->key_);
+    } else if (Less(probe, current_node->key_)) {
+      order = -1;
+    } else if (Less(current_node->key_, probe)) {
+      order = 1;
+    }
+
+    if (order < 0) { // Если probe меньше ключа текущего узла.
       current_node = current_node->left_; // Переходим к левому потомку.
-    } else if (key_comparator_(current_node->key_,
-                               key)) { // Если ключ текущего узла меньше key.
+    } else if (order > 0) { // Если ключ текущего узла меньше probe.
       current_node = current_node->right_; // Переходим к правому потомку.
     } else {
       // Найдено точное совпадение ключей, возвращаем итератор на этот узел.
+      stats_.Descent(depth);
       return iterator(current_node);
     }
   }
+  stats_.Descent(depth);
 
   // Ключ не найден, возвращаем итератор к концу дерева.
   return End();
@@ -404,25 +546,29 @@ RedBlackTree<Key, Comparator>::Find(const_reference key) {
  * Этот метод выполняет бинарный поиск по дереву для нахождения первого
  * элемента, который больше или равен заданному ключу.
  *
- * @param key Ключ, для которого ищется ближайший элемент не меньший него.
+ * @param probe Ключ или проба, для которой ищется ближайший элемент не
+ * меньший нее.
  * @return Итератор на ближайший элемент дерева, не меньший заданному ключу.
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::iterator
-RedBlackTree<Key, Comparator>::LowerBound(const_reference key) {
-  RedBlackTreeNode *current_node = head_->parent_;
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::LocateLower(const Probe &probe) {
+  RedBlackTreeNode *current_node = head_.parent();
   RedBlackTreeNode *result_node = End().node_;
+  size_type depth = 0;
 
   while (current_node) {
-    // Если ключ текущего узла не меньше заданного ключа
-    if (!key_comparator_(current_node->key_, key)) {
-      result_node = current_node; // Обновляем ближайший найденный узел
-      current_node = current_node->left_; // Двигаемся влево
-    } else {
-      current_node = current_node->right_; // Двигаемся вправо
-    }
+    ++depth;
+    // Если ключ текущего узла меньше заданного, двигаемся вправо, иначе
+    // запоминаем узел как ближайший найденный и двигаемся влево.
+    const bool go_right = Less(current_node->key_, probe);
+    result_node = go_right ? result_node : current_node;
+    current_node = go_right ? current_node->right_ : current_node->left_;
   }
 
+  stats_.Descent(depth);
+
   // Возвращаем итератор на ближайший найденный узел
   return iterator(result_node);
 }
@@ -433,844 +579,2223 @@ RedBlackTree<Key, Comparator>::LowerBound(const_reference key) {
  *
  * Находит наименьший элемент, ключ которого больше заданного ключа.
  *
- * @param key Ключ для поиска верхней границы.
+ * @param probe Ключ или проба для поиска верхней границы.
  * @return Итератор на элемент, ключ которого больше заданного, либо End(), если
  * такого элемента нет.
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::iterator
-RedBlackTree<Key, Comparator>::UpperBound(const_reference key) {
-  RedBlackTreeNode *current = head_->parent_; // Текущий узел, начиная с корня.
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::LocateUpper(const Probe &probe) {
+  RedBlackTreeNode *current = head_.parent(); // Текущий узел, начиная с корня.
   RedBlackTreeNode *result =
       End().node_; // Результат - итератор на следующий элемент.
+  size_type depth = 0;
 
   while (current != nullptr) {
-    if (key_comparator_(
-            key,
-            current->key_)) { // Если ключ меньше текущего узла, идем налево.
-      result = current; // Обновляем итератор на следующий элемент.
-      current = current->left_;
-    } else { // Если ключ больше или равен текущему узлу, идем направо.
-      current = current->right_;
-    }
+    ++depth;
+    // Если ключ меньше текущего узла, запоминаем узел и идем налево, иначе
+    // идем направо.
+    const bool go_left = Less(probe, current->key_);
+    result = go_left ? current : result;
+    current = go_left ? current->left_ : current->right_;
   }
 
-  return iterator(result); // Возвращаем итератор на следующий элемент.
-}
-
-/**
- * @brief Удаляет элемент из дерева по переданному итератору.
- * Извлекает узел, соответствующий переданному итератору, удаляет его и
- * освобождает память.
- *
- * @param position Итератор, указывающий на удаляемый элемент.
- */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::Erase(iterator position) noexcept {
-  // Извлекаем узел по переданному итератору.
-  RedBlackTreeNode *result = ExtractNode(position);
+  stats_.Descent(depth);
 
-  // Удаляем извлеченный узел и освобождаем память.
-  delete result;
+  // Возвращаем итератор на следующий элемент.
+  return iterator(result);
 }
 
 /**
- * @brief Меняет местами содержимое текущего дерева с содержимым другого дерева.
- * Меняет указатели на голову, размер и компаратор между текущим и другим
- * деревом.
+ * @brief Поиск элемента по ключу.
  *
- * @param other Другое дерево, с которым происходит обмен содержимым.
+ * @param key Искомый ключ.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::Swap(RedBlackTree &other) noexcept {
-  std::swap(head_, other.head_); // Меняем указатели на голову дерева.
-  std::swap(size_, other.size_); // Меняем размеры деревьев.
-  std::swap(key_comparator_,
-            other.key_comparator_); // Меняем компараторы деревьев.
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::Find(key_arg_type key) {
+  return LocateEqual(key);
 }
 
 /**
- * @brief Копирует структуру и содержимое дерева из другого дерева.
- * Очищает текущее дерево и создает его копию на основе другого дерева.
- * Затем обновляет указатели на наибольший и наименьший элементы,
- * размер, и компаратор для текущего дерева.
+ * @brief Находит первый элемент, не меньший ключа.
  *
- * @param other Другое дерево, из которого копируется структура и содержимое.
+ * @param key Ключ для поиска нижней границы.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::CopyTreeFromOther(
-    const RedBlackTree &other) {
-  // Очищаем текущее дерево.
-  Clear();
-
-  // Копируем структуру дерева из другого дерева.
-  head_->parent_ = CopyTree(other.head_->parent_, nullptr);
-  head_->parent_->parent_ = head_;
-
-  // Обновляем указатели на наибольший и наименьший элементы.
-  RedBlackTreeNode *node = head_->parent_;
-  while (node->left_)
-    node = node->left_;
-  head_->left_ = node;
-
-  node = head_->parent_;
-  while (node->right_)
-    node = node->right_;
-  head_->right_ = node;
-
-  // Обновляем размер и компаратор для текущего дерева.
-  size_ = other.size_;
-  key_comparator_ = other.key_comparator_;
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::LowerBound(key_arg_type key) {
+  return LocateLower(key);
 }
 
 /**
-
-@brief Создает копию поддерева, начиная с указанного узла.
-    * @param node Указатель на корень поддерева,
-    * которое нужно скопировать.
-    *
-    * @param parent Указатель на родительский узел в новой копии (по умолчанию
-    * nullptr).
-    *
-    * @return Указатель на корень новой копии поддерева.
-    * Этот метод выполняет глубокую копию поддерева, начиная с заданного узла.
-    *
-    * Для каждого узла из исходного поддерева создается новый узел в новой
-    * ыкопии,
-    * копируются ключ и цвет. При этом сохраняется структура дерева.
-    *
-    * Возвращается указатель на корень новой копии поддерева.
-*/
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::RedBlackTreeNode *
-RedBlackTree<Key, Comparator>::CopyTree(const RedBlackTreeNode *source_node,
-                                        RedBlackTreeNode *new_parent) {
-  if (!source_node)
-    return nullptr;
-
-  // Используем стек для обхода узлов поддерева в глубину
-  std::stack<std::pair<const RedBlackTreeNode *, RedBlackTreeNode **>>
-      node_stack;
-  RedBlackTreeNode *new_subtree_root = nullptr;
-  node_stack.push({source_node, &new_subtree_root});
-
-  while (!node_stack.empty()) {
-    auto [current_source_node, new_node_ptr] = node_stack.top();
-    node_stack.pop();
-
-    if (current_source_node) {
-      // Создаем новый узел в новой копии
-      *new_node_ptr = new RedBlackTreeNode{current_source_node->key_,
-                                           current_source_node->color_};
-      (*new_node_ptr)->parent_ = new_parent;
-
-      // Добавляем дочерние узлы и соответствующие указатели на них в стек
-      node_stack.push({current_source_node->right_, &(*new_node_ptr)->right_});
-      node_stack.push({current_source_node->left_, &(*new_node_ptr)->left_});
-    }
-  }
-
-  return new_subtree_root;
-}
-/**
- * @brief Рекурсивно удаляет узлы дерева, начиная с заданного узла.
- * Использует стек для обхода узлов и их последовательного удаления.
+ * @brief Находит первый элемент, больший ключа.
  *
- * @param node Узел, с которого начинается удаление.
+ * @param key Ключ для поиска верхней границы.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::Destroy(RedBlackTreeNode *node) noexcept {
-  std::stack<RedBlackTreeNode *> nodes;
-
-  while (node != nullptr || !nodes.empty()) {
-    if (node != nullptr) {
-      // Добавляем текущий узел в стек и переходим к левому потомку
-      nodes.push(node);
-      node = node->left_;
-    } else {
-      // Если левых потомков нет, извлекаем узел из стека,
-      // удаляем его и переходим к его правому потомку
-      node = nodes.top();
-      nodes.pop();
-
-      RedBlackTreeNode *right_child = node->right_;
-      delete node;
-
-      node = right_child;
-    }
-  }
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::UpperBound(key_arg_type key) {
+  return LocateUpper(key);
 }
 
 /**
- * @brief Инициализирует фиктивный узел head_ и связанные с ним указатели.
+ * @brief Поиск элемента по ключу в константном дереве.
  *
- * Устанавливает указатели в head_ таким образом, что дерево будет пустым.
+ * Спуск не меняет дерево (кроме счетчиков статистики), поэтому выполняется
+ * неконстантной версией.
  *
- * Функция не принимает никаких аргументов и ничего не возвращает.
- * Этот метод обеспечивает корректное начальное состояние дерева.
+ * @param key Ключ, по которому выполняется поиск элемента.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::InitializeHead() noexcept {
-  // Создание фиктивного узла head_, если он не был создан ранее.
-  if (!head_) {
-    head_ = new RedBlackTreeNode();
-  }
-  head_->parent_ = nullptr;
-  head_->left_ = head_;
-  head_->right_ = head_;
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::const_iterator
+RedBlackTree<Key, Comparator, Options>::Find(key_arg_type key) const {
+  return const_cast<RedBlackTree *>(this)->Find(key);
 }
+
 /**
- * @brief Проверяет корректность структуры и свойств красно-черного дерева.
+ * @brief Находит в константном дереве первый элемент, не меньший ключа.
  *
- * @return `true`, если дерево корректно; `false`, если есть нарушения.
+ * @param key Ключ для поиска нижней границы.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename Key, typename Comparator>
-bool RedBlackTree<Key, Comparator>::CheckTree() const noexcept {
-  // Проверка корректности корневого узла
-  if (head_->color_ == BLACK) {
-    return false;
-  }
-  // Получение корневого узла дерева
-  RedBlackTreeNode *root = head_->parent_;
-
-  // Пустое дерево считается корректным
-  if (root == nullptr) {
-    return true;
-  }
-
-  // Проверка свойств красно-черного дерева:
-  // 1. Корневой узел не может быть красным
-  // 2. Для каждого красного узла его дети должны быть черными
-  // 3. Чёрные высоты поддеревьев должны быть равны
-
-  // Если корневой узел красный или нарушено условие для красных узлов,
-  // возвращаем false
-  if (root->color_ == RED || !checkRedNodes(root) ||
-      ComputeBlackHeight(root) == -1) {
-    return false;
-  }
-
-  // Дерево прошло все проверки и считается корректным
-  return true;
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::const_iterator
+RedBlackTree<Key, Comparator, Options>::LowerBound(key_arg_type key) const {
+  return const_cast<RedBlackTree *>(this)->LowerBound(key);
 }
 
 /**
- * @brief Вставляет новый узел в красно-черное дерево, начиная от указанного
- * корневого узла.
+ * @brief Находит в константном дереве первый элемент, больший ключа.
  *
- * @param root Корневой узел, с которого начинается вставка.
- * @param newNnode Новый узел для вставки.
- * @param check_duplicates Если true, то вставляются только уникальные ключи.
- * @return Пара, содержащая итератор на вставленный узел и флаг, указывающий на
- * успешность вставки.
+ * @param key Ключ для поиска верхней границы.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename KeyType, typename Compare>
-std::pair<typename RedBlackTree<KeyType, Compare>::iterator, bool>
-RedBlackTree<KeyType, Compare>::Insert(RedBlackTreeNode *root,
-                                       RedBlackTreeNode *newNnode,
-                                       bool check_duplicates) {
-  RedBlackTreeNode *parent = head_;
-  RedBlackTreeNode **node = &root;
-
-  // Находим место для вставки нового узла.
-  while (*node != nullptr) {
-    parent = *node;
-    bool is_less = key_comparator_(newNnode->key_, (*node)->key_);
-    if (is_less) {
-      node = &(*node)->left_;
-    } else {
-      if (check_duplicates && !key_comparator_((*node)->key_, newNnode->key_)) {
-        return {iterator(*node), false}; // Уже существующий ключ.
-      }
-      node = &(*node)->right_;
-    }
-  }
-
-  // Производим вставку нового узла.
-  newNnode->parent_ = parent;
-  *node = newNnode;
-
-  // Обновляем связи в родительском узле.
-  if (parent == head_ || parent == nullptr) {
-    newNnode->color_ = BLACK;
-    head_->parent_ = newNnode;
-    head_->left_ = newNnode;
-    head_->right_ = newNnode;
-  } else {
-    if (key_comparator_(newNnode->key_, head_->left_->key_)) {
-      head_->left_ = newNnode;
-    }
-    if (!key_comparator_(newNnode->key_, head_->right_->key_)) {
-      head_->right_ = newNnode;
-    }
-  }
-
-  ++size_;
-  BalancingInsert(newNnode); // Выполняем балансировку после вставки.
-
-  return {
-      iterator(newNnode),
-      true}; // Возвращаем итератор на вставленный узел и флаг успешной вставки.
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::const_iterator
+RedBlackTree<Key, Comparator, Options>::UpperBound(key_arg_type key) const {
+  return const_cast<RedBlackTree *>(this)->UpperBound(key);
 }
+
 /**
- * @brief Выполняет балансировку красно-черного дерева после вставки нового
- * узла. Метод проверяет и корректирует баланс дерева, чтобы сохранить его
- * свойства.
+ * @brief Поиск элемента по пробе без построения временного ключа.
  *
- * @param node Узел, который был только что вставлен в дерево.
+ * @param probe Проба, сравнимая с ключами (см. EnableIfTreeProbe).
+ * @return Итератор на найденный элемент или End().
  */
-template <typename KeyType, typename Compare>
-void RedBlackTree<KeyType, Compare>::BalancingInsert(RedBlackTreeNode *node) {
-  while (node != head_->parent_ && node->parent_->color_ == RED) {
-    if (node->parent_->parent_->left_ == node->parent_) {
-      HandleLeftCase(node); // Вызываем метод для обработки левого случая.
-    } else {
-      HandleRightCase(
-          node); // Иначе вызываем метод для обработки правого случая.
-    }
-  }
-
-  head_->parent_->color_ = BLACK; // Корень всегда должен быть черным.
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::Find(const Probe &probe) {
+  return LocateEqual(probe);
 }
 
 /**
- * @brief Обрабатывает левый случай при балансировке красно-черного дерева после
- * вставки узла. В данном случае узел, его родитель и дедушка образуют
- * "зигзагообразную" структуру, которая требует коррекции для сохранения баланса
- * и свойств дерева.
+ * @brief Находит первый элемент, не меньший пробы.
  *
- * @param node Узел, который был только что вставлен в дерево.
+ * @param probe Проба, сравнимая с ключами.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename KeyType, typename Compare>
-void RedBlackTree<KeyType, Compare>::HandleLeftCase(RedBlackTreeNode *node) {
-  RedBlackTreeNode *parent = node->parent_;
-  RedBlackTreeNode *gparent = parent->parent_;
-  RedBlackTreeNode *uncle = gparent->right_;
-
-  if (uncle != nullptr && uncle->color_ == RED) {
-    HandleRedUncle(
-        parent, uncle,
-        gparent); // Вызываем метод для обработки случая с красным дядей.
-  } else {
-    if (parent->right_ == node) { // Если узел находится справа от родителя...
-      RotateLeft(parent); // ...поворачиваем родителя влево.
-      std::swap(parent, node); // Меняем местами узел и родителя.
-    }
-    RotateRight(gparent); // Поворачиваем дедушку вправо.
-    std::swap(parent->color_,
-              gparent->color_); // Меняем цвет родителя и дедушки.
-  }
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::LowerBound(const Probe &probe) {
+  return LocateLower(probe);
 }
 
 /**
- * @brief Обрабатывает правый случай при балансировке красно-черного дерева
- * после вставки узла. В данном случае узел, его родитель и дедушка образуют
- * "зигзагообразную" структуру, которая требует коррекции для сохранения баланса
- * и свойств дерева.
+ * @brief Находит первый элемент, больший пробы.
  *
- * @param node Узел, который был только что вставлен в дерево.
+ * @param probe Проба, сравнимая с ключами.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename KeyType, typename Compare>
-void RedBlackTree<KeyType, Compare>::HandleRightCase(RedBlackTreeNode *node) {
-  RedBlackTreeNode *parent = node->parent_;
-  RedBlackTreeNode *gparent = parent->parent_;
-  RedBlackTreeNode *uncle = gparent->left_;
-
-  if (uncle != nullptr && uncle->color_ == RED) {
-    HandleRedUncle(
-        parent, uncle,
-        gparent); // Вызываем метод для обработки случая с красным дядей.
-  } else {
-    if (parent->left_ == node) { // Если узел находится слева от родителя...
-      RotateRight(parent); // ...поворачиваем родителя вправо.
-      std::swap(parent, node); // Меняем местами узел и родителя.
-    }
-    RotateLeft(gparent); // Поворачиваем дедушку влево.
-    std::swap(parent->color_,
-              gparent->color_); // Меняем цвет родителя и дедушки.
-  }
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::UpperBound(const Probe &probe) {
+  return LocateUpper(probe);
 }
 
 /**
- * @brief Обрабатывает случай, когда родитель и дядя вставленного узла являются
- * красными узлами. В этом случае, цвета родителя, дяди и дедушки меняются,
- * чтобы поддержать баланс красно-черного дерева.
+ * @brief Поиск элемента по пробе в константном дереве.
  *
- * @param parent Родитель вставленного узла.
- * @param uncle Дядя вставленного узла (брат родителя).
- * @param gparent Дедушка вставленного узла (родитель родителя).
+ * @param probe Проба, сравнимая с ключами.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename KeyType, typename Compare>
-void RedBlackTree<KeyType, Compare>::HandleRedUncle(RedBlackTreeNode *parent,
-                                                    RedBlackTreeNode *uncle,
-                                                    RedBlackTreeNode *gparent) {
-  parent->color_ = BLACK; // Родитель и дядя становятся черными.
-  uncle->color_ = BLACK;
-  gparent->color_ =
-      RED; // Дедушка становится красным, чтобы сохранить свойства дерева.
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename RedBlackTree<Key, Comparator, Options>::const_iterator
+RedBlackTree<Key, Comparator, Options>::Find(const Probe &probe) const {
+  return const_cast<RedBlackTree *>(this)->LocateEqual(probe);
 }
+
 /**
- * @brief Выполняет операцию вращения узла влево или вправо.
+ * @brief Находит в константном дереве первый элемент, не меньший пробы.
  *
- * @param node Узел, который будет вращаться.
- * @param rotateRight Если true, выполняется вращение вправо, иначе - влево.
- *                    Определяет направление вращения.
+ * @param probe Проба, сравнимая с ключами.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::Rotate(RedBlackTreeNode *node,
-                                               bool rotateRight) noexcept {
-  RedBlackTreeNode *pivot = rotateRight ? node->left_ : node->right_;
-
-  RedBlackTreeNode *parentBeforeRotation = node->parent_;
-
-  if (node == head_->parent_) {
-    head_->parent_ = pivot; // Обновляем корень дерева.
-  } else if (parentBeforeRotation->left_ == node) {
-    parentBeforeRotation->left_ = pivot; // Обновляем левый указатель родителя.
-  } else {
-    parentBeforeRotation->right_ =
-        pivot; // Обновляем правый указатель родителя.
-  }
-
-  pivot->parent_ = parentBeforeRotation;
-
-  if (rotateRight) {
-    // Вращение вправо.
-    node->left_ = pivot->right_;
-    if (pivot->right_ != nullptr) {
-      pivot->right_->parent_ = node;
-    }
-    pivot->right_ = node;
-  } else {
-    // Вращение влево.
-    node->right_ = pivot->left_;
-    if (pivot->left_ != nullptr) {
-      pivot->left_->parent_ = node;
-    }
-    pivot->left_ = node;
-  }
-
-  node->parent_ = pivot;
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename RedBlackTree<Key, Comparator, Options>::const_iterator
+RedBlackTree<Key, Comparator, Options>::LowerBound(const Probe &probe) const {
+  return const_cast<RedBlackTree *>(this)->LocateLower(probe);
 }
 
 /**
- * @brief Выполняет операцию вращения узла вправо.
+ * @brief Находит в константном дереве первый элемент, больший пробы.
  *
- * @param node Узел, который будет вращаться вправо.
+ * @param probe Проба, сравнимая с ключами.
+ * @return Итератор на найденный элемент или End().
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::RotateRight(
-    RedBlackTreeNode *node) noexcept {
-  Rotate(node,
-         true); // Вызов общей функции Rotate с параметром rotateRight = true.
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename RedBlackTree<Key, Comparator, Options>::const_iterator
+RedBlackTree<Key, Comparator, Options>::UpperBound(const Probe &probe) const {
+  return const_cast<RedBlackTree *>(this)->LocateUpper(probe);
 }
 
 /**
- * @brief Выполняет операцию вращения узла влево.
+ * @brief Удаляет элемент из дерева по переданному итератору.
+ * Извлекает узел, соответствующий переданному итератору, удаляет его и
+ * освобождает память.
  *
- * @param node Узел, который будет вращаться влево.
+ * @param position Итератор, указывающий на удаляемый элемент.
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::RotateLeft(
-    RedBlackTreeNode *node) noexcept {
-  Rotate(node,
-         false); // Вызов общей функции Rotate с параметром rotateRight = false.
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::Erase(iterator position) noexcept {
+  // Извлекаем узел по переданному итератору.
+  RedBlackTreeNode *result = ExtractNode(position);
+
+  // Удаляем извлеченный узел и освобождаем память.
+  if (result)
+    FreeNode(result);
 }
 
 /**
- * @brief Извлекает узел из дерева по заданному итератору и выполняет
- * необходимые действия.
+ * @brief Удаляет из дерева элементы диапазона [first, last).
  *
- * @param position Итератор, указывающий на узел, который нужно извлечь.
- * @return Указатель на извлеченный узел или nullptr, если итератор указывает на
- * конец дерева.
+ * Вместо поочередного удаления каждого элемента дерево разрезается перед
+ * first и перед last, а две оставшиеся части склеиваются обратно через узел
+ * last. Разрезание и склеивание стоят O(log n), вырезанное поддерево
+ * освобождается целиком одним обходом, поэтому весь вызов стоит O(k + log n)
+ * для k удаляемых элементов вместо O(k log n).
+ *
+ * @param first Итератор на первый удаляемый элемент.
+ * @param last Итератор на элемент, следующий за последним удаляемым.
+ * @return Итератор на элемент, на который указывал last.
  */
-template <typename Key, typename Comparator>
-typename RedBlackTree<Key, Comparator>::RedBlackTreeNode *
-RedBlackTree<Key, Comparator>::ExtractNode(iterator position) noexcept {
-  if (position == End()) {
-    return nullptr;
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::Erase(iterator first,
+                                              iterator last) noexcept {
+  if (first == last) {
+    return last;
   }
-  RedBlackTreeNode *deleted_node = position.node_;
-  // Обрабатываем случаи удаления узла с учетом его цвета и наличия потомков.
-  HandleDeletionCases(deleted_node);
-  // Обновляем связи с родителями и фиктивным узлом head.
-  UpdateParentAndHeadLinks(deleted_node);
-  // Уменьшаем размер дерева и обнуляем данные узла.
-  --size_;
-  deleted_node->ToDefault();
-  return deleted_node;
+  if (first.node_ == head_.left_ && last.node_ == &head_) {
+    Clear();
+    return End();
+  }
+
+  size_type count = 0;
+  for (RedBlackTreeNode *node = first.node_; node != last.node_;
+       node = node->NextNode()) {
+    ++count;
+  }
+  RedBlackTreeNode *before =
+      first.node_ == head_.left_ ? &head_ : first.node_->PrevNode();
+  RedBlackTreeNode *stop = last.node_;
+
+  // Отрезаем все, что лежит перед first, затем все, начиная с last.
+  // Середина (без самого first) - удаляемое поддерево.
+  RedBlackTreeNode *root = head_.parent();
+  root->set_parent(nullptr);
+  Subtree left;
+  Subtree removed;
+  SplitAt(first.node_, {root, BlackHeight(root)}, left, removed);
+  Subtree result = left;
+  if (stop != &head_) {
+    Subtree right;
+    SplitAt(stop, removed, removed, right);
+    result = Join(left, stop, right);
+  }
+
+  FreeNode(first.node_);
+  Destroy(removed.root_);
+
+  head_.set_parent(result.root_);
+  result.root_->set_parent(&head_);
+  if (before == &head_) {
+    head_.left_ = stop;
+  }
+  if (stop == &head_) {
+    head_.right_ = before;
+  }
+  if constexpr (Options::threaded) {
+    before->next_ = stop;
+    stop->prev_ = before;
+  }
+  size_ -= count;
+
+  return iterator(stop);
 }
+
 /**
- * @brief Обрабатывает случаи удаления узла из красно-черного дерева.
+ * @brief Удаляет из дерева все элементы, для которых предикат вернул true.
  *
- * Если удаляемый узел имеет два потомка, вызывается метод HandleK2Case
- * для обработки данного случая. В противном случае, если цвет удаляемого узла
- * - черный, вызывается метод HandleBlackCases для обработки других вариантов
- * удаления.
+ * Предикат вызывается для каждого элемента по порядку до любых изменений,
+ * поэтому исключение из него оставляет дерево нетронутым. Затем удаляемые
+ * узлы освобождаются, а из оставшихся за O(n) строится идеально
+ * сбалансированное дерево - без поворотов и перекрашиваний по каждому
+ * удаленному элементу.
  *
- * @param deleted_node Удаляемый узел.
+ * @tparam Predicate Унарный предикат от const key_type &.
+ * @param pred Предикат, отбирающий удаляемые элементы.
+ * @return Количество удаленных элементов.
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::HandleDeletionCases(
-    RedBlackTreeNode *deleted_node) {
-  // Если есть оба потомка, обрабатываем случай K2.
-  if (deleted_node->left_ != nullptr && deleted_node->right_ != nullptr) {
-    HandleK2Case(deleted_node);
+template <typename Key, typename Comparator, typename Options>
+template <typename Predicate>
+typename RedBlackTree<Key, Comparator, Options>::size_type
+RedBlackTree<Key, Comparator, Options>::EraseIf(Predicate pred) {
+  // Оставляемые узлы собираются с начала массива, удаляемые - с конца.
+  std::vector<RedBlackTreeNode *> nodes(size_);
+  size_type kept = 0;
+  size_type removed_begin = size_;
+  for (RedBlackTreeNode *node = head_.left_; node != &head_;
+       node = node->NextNode()) {
+    const key_type &key = node->key_;
+    if (pred(key)) {
+      nodes[--removed_begin] = node;
+    } else {
+      nodes[kept++] = node;
+    }
+  }
+
+  size_type removed = size_ - removed_begin;
+  if (removed == 0) {
+    return 0;
+  }
+  if (kept == 0) {
+    Clear();
+    return removed;
   }
-  // Если удаляемый узел черный, обрабатываем случаи удаления с черными узлами.
-  else if (deleted_node->color_ == BLACK) {
-    HandleBlackCases(deleted_node);
+  for (size_type i = removed_begin; i < size_; ++i) {
+    FreeNode(nodes[i]);
   }
+  AdoptInOrder(nodes.data(), kept);
+
+  return removed;
 }
 
 /**
- * @brief Обновляет связи родителя и head_ после удаления узла из дерева.
+ * @brief Извлекает элемент из дерева вместе с его узлом.
+ *
+ * Узел отсоединяется от дерева без освобождения памяти и передается во
+ * владение возвращаемому дескриптору.
  *
- * @param deleted_node Узел, который был удален.
+ * @param position Итератор на извлекаемый элемент.
+ * @return Дескриптор узла; пустой, если position == End().
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::UpdateParentAndHeadLinks(
-    RedBlackTreeNode *deleted_node) {
-  if (deleted_node == head_->parent_) {
-    // Если удаляемый узел был корневым элементом, инициализируем head_.
-    InitializeHead();
-  } else {
-    RedBlackTreeNode *parent = deleted_node->parent_;
-    if (deleted_node == parent->left_)
-      parent->left_ = nullptr;
-    else
-      parent->right_ = nullptr;
-
-    // Обновляем ссылки head_ на самый левый и самый правый узлы, если они были
-    // удалены.
-    if (head_->left_ == deleted_node)
-      head_->left_ = SearchMinimum(head_->parent_);
-    if (head_->right_ == deleted_node)
-      head_->right_ = SearchMaximum(head_->parent_);
-  }
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::node_type
+RedBlackTree<Key, Comparator, Options>::Extract(iterator position) noexcept {
+  return node_type(ExtractNode(position));
 }
 
 /**
- * @brief Обработка случая "K2" для балансировки дерева при удалении узла.
+ * @brief Извлекает из дерева элемент с заданным ключом вместе с его узлом.
  *
- * При удалении узла, если у него есть правый потомок, этот метод находит
- * наименьший узел в правом поддереве удаляемого узла и меняет его местами с
- * удаляемым узлом. Это помогает сохранить свойства красно-черного дерева после
- * удаления.
- *
- * @param deleted_node Удаляемый узел, для которого выполняется обработка K2.
+ * @param key Ключ извлекаемого элемента.
+ * @return Дескриптор узла; пустой, если ключ не найден.
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::HandleK2Case(
-    RedBlackTreeNode *deleted_node) {
-  // Находим наименьший узел в правом поддереве удаляемого узла.
-  RedBlackTreeNode *replacement_node = SearchMinimum(deleted_node->right_);
-
-  // Меняем местами удаляемый узел и наименьший узел в правом поддереве.
-  SwapNodesAndUpdateAfterErase(deleted_node, replacement_node);
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::node_type
+RedBlackTree<Key, Comparator, Options>::Extract(const_reference key) {
+  return Extract(Find(key));
 }
 
 /**
- * @brief Обрабатывает случаи, когда удаляемый узел имеет черный цвет.
- * Если удаленный узел имеет черного родителя, метод решает, как корректно
- * поддерживать свойства красно-черного дерева.
+ * @brief Вставляет в дерево узел из дескриптора (допуская повторяющиеся
+ * ключи). Память не выделяется, элемент не копируется.
  *
- * @param deleted_node Узел, который был удален из дерева.
+ * @param node Дескриптор узла; после вставки становится пустым.
+ * @return Итератор на вставленный элемент или End() для пустого дескриптора.
  */
-template <typename Key, typename Comparator>
-void RedBlackTree<Key, Comparator>::HandleBlackCases(
-    RedBlackTreeNode *deleted_node) {
-  if ((deleted_node->left_ != nullptr && deleted_node->right_ == nullptr) ||
-      (deleted_node->left_ == nullptr && deleted_node->right_ != nullptr)) {
-    // Случай 1: У удаляемого узла есть один потомок. Заменяем его потомком.
-    RedBlackTreeNode *replacement =
-        deleted_node->left_ ? deleted_node->left_ : deleted_node->right_;
-    SwapNodesAndUpdateAfterErase(deleted_node, replacement);
-  } else if (deleted_node->left_ == nullptr &&
-             deleted_node->right_ == nullptr) {
-    // Случай 2: У удаляемого узла нет потомков. Балансируем дерево.
-    EraseBalancing(deleted_node);
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::iterator
+RedBlackTree<Key, Comparator, Options>::Insert(node_type &&node) {
+  if (node.empty()) {
+    return End();
   }
+  return Insert(node.Release(), false).first;
 }
+
 /**
- * @brief Обменивает местами два узла в красно-черном дереве.
- *
- * Обменивает местами позиции и свойства (родителей, потомков, цвета) двух узлов
- * в красно-черном дереве.
+ * @brief Вставляет в дерево узел из дескриптора, если элемента с таким
+ * ключом еще нет. Память не выделяется, элемент не копируется.
  *
- * @param node_a Указатель на первый узел для обмена.
- * @param node_b Указатель на второй узел для обмена.
+ * @param node Дескриптор узла.
+ * @return Позиция вставленного (или мешающего вставке) элемента, флаг
+ * вставки и дескриптор: пустой при успехе, исходный узел - при неудаче.
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::SwapNodes(
-    RedBlackTreeNode *node_a, RedBlackTreeNode *node_b) noexcept {
-  std::swap(node_a->parent_, node_b->parent_);
-  std::swap(node_a->left_, node_b->left_);
-  std::swap(node_a->right_, node_b->right_);
-  std::swap(node_a->color_, node_b->color_);
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::insert_return_type
+RedBlackTree<Key, Comparator, Options>::InsertUnique(node_type &&node) {
+  if (node.empty()) {
+    return {End(), false, node_type()};
+  }
+  std::pair<iterator, bool> result = Insert(node.node_, true);
+  if (result.second) {
+    node.Release();
+    return {result.first, true, node_type()};
+  }
+  return {result.first, false, std::move(node)};
 }
 
 /**
- * @brief Обновляет родителя узла на новый узел.
- *
- * Обновляет указатель на родительский узел, заменяя его на новый узел,
- * при этом учитывает, с какой стороны родитель был связан с текущим узлом.
+ * @brief Меняет местами содержимое текущего дерева с содержимым другого дерева.
+ * Меняет связи фиктивных узлов, размер и компаратор между текущим и другим
+ * деревом за O(1). Итераторы End() обоих деревьев после обмена указывают на
+ * фиктивный узел своего дерева.
  *
- * @param node     Указатель на узел, родителя которого нужно обновить.
- * @param newNode  Указатель на новый узел, который станет родителем.
+ * @param other Другое дерево, с которым происходит обмен содержимым.
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::UpdateParent(
-    RedBlackTreeNode *node, RedBlackTreeNode *newNode) noexcept {
-  if (node->parent_->left_ == node) {
-    node->parent_->left_ = newNode;
-  } else {
-    node->parent_->right_ = newNode;
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::Swap(
+    RedBlackTree &other) noexcept {
+  // Меняем связи фиктивных узлов и возвращаем корни и крайние узлы к своим
+  // фиктивным узлам.
+  RedBlackTreeNode *root = head_.parent();
+  head_.set_parent(other.head_.parent());
+  other.head_.set_parent(root);
+  std::swap(head_.left_, other.head_.left_);
+  std::swap(head_.right_, other.head_.right_);
+  if constexpr (Options::threaded) {
+    std::swap(head_.next_, other.head_.next_);
+    std::swap(head_.prev_, other.head_.prev_);
   }
+  RelinkHead();
+  other.RelinkHead();
+  std::swap(size_, other.size_); // Меняем размеры деревьев.
+  std::swap(key_comparator_,
+            other.key_comparator_); // Меняем компараторы деревьев.
+  // Незаконченное уплотнение переходит вместе с узлами.
+  std::swap(compaction_, other.compaction_);
 }
+
 /**
- * @brief Обменивает местами два узла и обновляет их свойства после удаления
- * одного из них.
+ * @brief Строит новое дерево - объединение, пересечение, разность или
+ * симметрическую разность lhs и rhs.
  *
- * Обменивает местами позиции и свойства (родителей, потомков, цвета) двух узлов
- * в красно-черном дереве. При этом учитываются нюансы после удаления одного из
- * узлов, включая обновление указателей на потомков и родителей.
+ * Упорядоченные обходы деревьев сливаются за O(n + m) сравнений в один
+ * проход, который запоминает отобранные узлы. Затем их ключи копируются в
+ * один блок узлов по порядку, и дерево собирается снизу вверх
+ * (BuildBalanced) без поворотов и поиска мест вставки. Для больших деревьев
+ * оба шага идут параллельно: lhs делится верхними уровнями на поддеревья,
+ * а rhs разрезается по их граничным ключам.
  *
- * @param node    Указатель на первый узел для обмена и удаления.
- * @param survivor Указатель на второй узел, который останется после обмена
- *                и который выжил после удаления.
+ * @param lhs Левое дерево; его элементы берутся при совпадении ключей.
+ * @param rhs Правое дерево.
+ * @param operation Операция.
+ * @return Дерево-результат с компаратором lhs.
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::SwapNodesAndUpdateAfterErase(
-    RedBlackTreeNode *node, RedBlackTreeNode *survivor) noexcept {
-  if (node == survivor)
-    return;
-
-  UpdateParent(node, survivor);
-  UpdateParent(survivor, node);
+template <typename Key, typename Comparator, typename Options>
+RedBlackTree<Key, Comparator, Options>
+RedBlackTree<Key, Comparator, Options>::Combine(const RedBlackTree &lhs,
+                                                const RedBlackTree &rhs,
+                                                SetOperation operation) {
+  RedBlackTree result;
+  result.key_comparator_ = lhs.key_comparator_;
+
+  // Со статистикой слияние последовательное: потоки не делят атомарные
+  // счетчики сравнений.
+  const bool parallel = !Options::stats && Parallel(lhs.size_ + rhs.size_);
+  std::vector<MergeTask> tasks = lhs.PlanMerge(rhs, parallel);
+  std::vector<MergeTask *> jobs;
+  for (MergeTask &task : tasks) {
+    jobs.push_back(&task);
+  }
 
-  if (node == head_->parent_) {
-    head_->parent_ = survivor;
+  std::exception_ptr error =
+      executor::Run(jobs, [&lhs, operation](MergeTask *task) {
+        lhs.MergeRanges(
+            *task, operation,
+            [task](const RedBlackTreeNode *node, bool, bool keep) {
+              if (keep) {
+                task->picked_.push_back(node);
+              }
+            });
+      });
+  if (error) {
+    std::rethrow_exception(error);
   }
 
-  SwapNodes(node, survivor);
+  size_type total = 0;
+  for (MergeTask &task : tasks) {
+    task.offset_ = total;
+    total += task.picked_.size();
+  }
+  if (total == 0) {
+    return result;
+  }
 
-  if (node->left_)
-    node->left_->parent_ = node;
-  if (node->right_)
-    node->right_->parent_ = node;
-  if (survivor->left_)
-    survivor->left_->parent_ = survivor;
-  if (survivor->right_)
-    survivor->right_->parent_ = survivor;
-}
-/**
- * @brief Обрабатывает ситуацию, когда брат узла красный.
- * Метод выполняет перебалансировку для поддержания свойств красно-черного
- * дерева.
- *
- * @param parent Родительский узел для проверяемого узла.
- * @param check_node Узел, для которого выполняется перебалансировка.
- */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::HandleRedSibling(
-    RedBlackTreeNode *parent, RedBlackTreeNode *&check_node) {
-  RedBlackTreeNode *sibling =
-      (check_node == parent->left_) ? parent->right_ : parent->left_;
-  std::swap(sibling->color_, parent->color_);
-
-  // Поворачиваем родительский узел влево или вправо в зависимости от позиции
-  // проверяемого узла.
-  if (check_node == parent->left_) {
-    RotateLeft(parent);
-  } else {
-    RotateRight(parent);
+  NodeBlock *block = AllocateBlock(total);
+  PooledNode *slots = BlockSlots(block);
+  error = executor::Run(jobs, [slots, block](MergeTask *task) {
+    PooledNode *out = slots + task->offset_;
+    for (const RedBlackTreeNode *node : task->picked_) {
+      new (out + task->constructed_) PooledNode(node->key_, BLACK, block);
+      ++task->constructed_;
+    }
+  });
+  if (error) {
+    for (MergeTask &task : tasks) {
+      for (size_type i = 0; i < task.constructed_; ++i) {
+        slots[task.offset_ + i].~PooledNode();
+      }
+    }
+    ReleaseBlock(block);
+    std::rethrow_exception(error);
   }
+  block->alive_.store(total, std::memory_order_relaxed);
+  result.stats_.Allocate(total);
 
-  parent = check_node->parent_;
+  std::vector<RedBlackTreeNode *> nodes(total);
+  for (size_type i = 0; i < total; ++i) {
+    nodes[i] = slots + i;
+  }
+  result.AdoptInOrder(nodes.data(), total);
+  return result;
 }
 
 /**
- * @brief Обрабатывает ситуацию, когда брат узла черный, и у него нет красных
- * детей. Метод выполняет перебалансировку для поддержания свойств
- * красно-черного дерева.
+ * @brief Заменяет содержимое дерева результатом операции с other.
  *
- * @param parent Родительский узел для проверяемого узла.
- * @param check_node Узел, для которого выполняется перебалансировка.
+ * Один проход слиянием за O(n + m): узлы текущего дерева, попадающие в
+ * результат, используются повторно, лишние освобождаются, а ключи other
+ * копируются в один общий блок узлов. Затем дерево собирается заново снизу
+ * вверх. При исключении во время копирования дерево не меняется.
+ *
+ * @param other Второе дерево; при совпадении ключей остается элемент
+ * текущего дерева.
+ * @param operation Операция.
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::HandleBlackSiblingWithBlackChildren(
-    RedBlackTreeNode *parent, RedBlackTreeNode *&check_node) {
-  RedBlackTreeNode *sibling =
-      (check_node == parent->left_) ? parent->right_ : parent->left_;
-  sibling->color_ = RED;
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::CombineWith(
+    const RedBlackTree &other, SetOperation operation) {
+  if (this == &other) {
+    if (operation == SetOperation::kDifference ||
+        operation == SetOperation::kSymmetricDifference) {
+      Clear();
+    }
+    return;
+  }
 
-  // Если цвет родителя также красный, то меняем цвет родителя на черный и
-  // завершаем обработку.
-  if (parent->color_ == RED) {
-    parent->color_ = BLACK;
+  // Узлы результата по порядку; на местах добавляемых элементов пока стоят
+  // узлы other, их позиции запоминаются в added.
+  std::vector<RedBlackTreeNode *> nodes;
+  std::vector<RedBlackTreeNode *> removed;
+  std::vector<size_type> added;
+  nodes.reserve(size_);
+  MergeRanges(PlanMerge(other, false).front(), operation,
+              [&](const RedBlackTreeNode *node, bool from_lhs, bool keep) {
+                if (!from_lhs) {
+                  added.push_back(nodes.size());
+                }
+                (keep ? nodes : removed)
+                    .push_back(const_cast<RedBlackTreeNode *>(node));
+              });
+  if (added.empty() && removed.empty()) {
     return;
   }
 
-  // Переопределяем проверяемый узел и его родителя для продолжения балансировки
-  // вверх по дереву.
-  check_node = parent;
-  parent = check_node->parent_;
+  if (!added.empty()) {
+    NodeBlock *block = AllocateBlock(added.size());
+    PooledNode *slots = BlockSlots(block);
+    size_type constructed = 0;
+    try {
+      for (; constructed < added.size(); ++constructed) {
+        RedBlackTreeNode *&node = nodes[added[constructed]];
+        node = new (slots + constructed) PooledNode(node->key_, BLACK, block);
+      }
+    } catch (...) {
+      for (size_type i = 0; i < constructed; ++i) {
+        slots[i].~PooledNode();
+      }
+      ReleaseBlock(block);
+      throw;
+    }
+    block->alive_.store(added.size(), std::memory_order_relaxed);
+    stats_.Allocate(added.size());
+  }
+
+  if (nodes.empty()) {
+    Clear();
+    return;
+  }
+  for (RedBlackTreeNode *node : removed) {
+    FreeNode(node);
+  }
+  AdoptInOrder(nodes.data(), nodes.size());
+}
+
+/**
+ * @brief Копирует структуру и содержимое дерева из другого дерева.
+ * Очищает текущее дерево и создает его копию на основе другого дерева.
+ *
+ * Все узлы копии размещаются одним непрерывным блоком в порядке обхода
+ * (in-order), поэтому последовательный проход по копии идет по соседним
+ * адресам. Каждый ключ копируется ровно один раз. Деревья от
+ * Options::parallel_threshold узлов копируются на Options::executor по
+ * независимым поддеревьям.
+ *
+ * @param other Другое дерево, из которого копируется структура и содержимое.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::CopyTreeFromOther(
+    const RedBlackTree &other) {
+  // Очищаем текущее дерево.
+  Clear();
+
+  NodeBlock *block = AllocateBlock(other.size_);
+  PooledNode *slots = BlockSlots(block);
+  stats_.Allocate(other.size_);
+
+  RedBlackTreeNode *root = nullptr;
+  if (Parallel(other.size_)) {
+    root = CopyTreeParallel(other.head_.parent(), slots, block);
+  } else {
+    size_type constructed = 0;
+    try {
+      root = CopyTree(other.head_.parent(), slots, constructed, block);
+    } catch (...) {
+      for (size_type i = 0; i < constructed; ++i) {
+        slots[i].~PooledNode();
+      }
+      ReleaseBlock(block);
+      throw;
+    }
+  }
+  block->alive_.store(other.size_, std::memory_order_relaxed);
+
+  head_.set_parent(root);
+  root->set_parent(&head_);
+
+  // Узлы лежат в блоке по порядку, поэтому крайние элементы известны сразу.
+  head_.left_ = slots;
+  head_.right_ = slots + (other.size_ - 1);
+  LinkThreadsInBlock(slots, other.size_);
+
+  // Обновляем размер и компаратор для текущего дерева.
+  size_ = other.size_;
+  key_comparator_ = other.key_comparator_;
+}
+
+/**
+ * @brief Создает копию поддерева в заранее выделенном блоке узлов.
+ *
+ * Узлы копии создаются строго в порядке обхода (in-order) в ячейках
+ * slots[constructed], slots[constructed + 1], ... Глубина рекурсии
+ * ограничена высотой красно-черного дерева (не более 2 * log2(n + 1)).
+ *
+ * @param source Корень копируемого поддерева.
+ * @param slots Начало участка блока, отведенного под поддерево.
+ * @param constructed Счетчик уже созданных в участке узлов. При исключении
+ * по нему определяется, какие ячейки нужно разрушить.
+ * @param block Блок, которому принадлежат создаваемые узлы.
+ * @return Указатель на корень новой копии поддерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::RedBlackTreeNode *
+RedBlackTree<Key, Comparator, Options>::CopyTree(
+    const RedBlackTreeNode *source, PooledNode *slots, size_type &constructed,
+    NodeBlock *block) {
+  if (!source)
+    return nullptr;
+
+  RedBlackTreeNode *left = CopyTree(source->left_, slots, constructed, block);
+
+  RedBlackTreeNode *node = new (slots + constructed)
+      PooledNode(source->key_, source->color(), block);
+  ++constructed;
+
+  node->left_ = left;
+  if (left)
+    left->set_parent(node);
+
+  node->right_ = CopyTree(source->right_, slots, constructed, block);
+  if (node->right_)
+    node->right_->set_parent(node);
+
+  if constexpr (kAggregated) {
+    node->UpdateAggregate();
+  }
+  return node;
+}
+
+/**
+ * @brief Параллельно копирует дерево в заранее выделенный блок узлов.
+ *
+ * Верхние уровни дерева делятся на независимые поддеревья. Сначала
+ * параллельно подсчитываются их размеры, по ним вычисляются смещения
+ * участков в блоке, затем поддеревья параллельно копируются каждое в свой
+ * участок. Узлы над поддеревьями создаются и связываются в конце.
+ *
+ * @param source Корень копируемого дерева.
+ * @param slots Начало блока узлов.
+ * @param block Блок, которому принадлежат создаваемые узлы.
+ * @return Указатель на корень копии.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::RedBlackTreeNode *
+RedBlackTree<Key, Comparator, Options>::CopyTreeParallel(
+    const RedBlackTreeNode *source, PooledNode *slots, NodeBlock *block) {
+  const int depth = ParallelDepth();
+  std::vector<CopyTask> tasks;
+  CollectCopyTasks(source, depth, tasks);
+  std::vector<CopyTask *> subtrees;
+  for (CopyTask &task : tasks) {
+    if (task.subtree_ && task.source_)
+      subtrees.push_back(&task);
+  }
+
+  std::exception_ptr error = executor::Run(subtrees, [](CopyTask *task) {
+    task->count_ = CountNodes(task->source_);
+  });
+
+  size_type offset = 0;
+  for (CopyTask &task : tasks) {
+    task.offset_ = offset;
+    offset += task.count_;
+  }
+
+  if (!error) {
+    error = executor::Run(subtrees, [slots, block](CopyTask *task) {
+      task->result_ =
+          CopyTree(task->source_, slots + task->offset_, task->constructed_,
+                   block);
+    });
+  }
+
+  if (!error) {
+    try {
+      for (CopyTask &task : tasks) {
+        if (!task.subtree_) {
+          task.result_ = new (slots + task.offset_)
+              PooledNode(task.source_->key_, task.source_->color(), block);
+          task.constructed_ = 1;
+        }
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+  }
+
+  if (error) {
+    for (CopyTask &task : tasks) {
+      for (size_type i = 0; i < task.constructed_; ++i) {
+        slots[task.offset_ + i].~PooledNode();
+      }
+    }
+    ReleaseBlock(block);
+    std::rethrow_exception(error);
+  }
+
+  CopyTask *cursor = tasks.data();
+  return LinkCopyTasks(source, depth, cursor);
+}
+
+/**
+ * @brief Разбивает верхние уровни дерева на задачи копирования.
+ *
+ * Задачи добавляются в порядке обхода (in-order): поддеревья на глубине
+ * depth становятся отдельными задачами, узлы над ними - задачами из одного
+ * узла.
+ *
+ * @param source Текущий узел исходного дерева.
+ * @param depth Оставшаяся глубина разбиения.
+ * @param tasks Список задач.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::CollectCopyTasks(
+    const RedBlackTreeNode *source, int depth, std::vector<CopyTask> &tasks) {
+  if (depth == 0 || source == nullptr) {
+    tasks.push_back({source, true, 0, 0, 0, nullptr});
+    return;
+  }
+  CollectCopyTasks(source->left_, depth - 1, tasks);
+  tasks.push_back({source, false, 0, 1, 0, nullptr});
+  CollectCopyTasks(source->right_, depth - 1, tasks);
+}
+
+/**
+ * @brief Связывает скопированные задачами части в одно дерево.
+ *
+ * Повторяет обход CollectCopyTasks и соединяет узлы верхних уровней с
+ * корнями скопированных поддеревьев.
+ *
+ * @param source Текущий узел исходного дерева.
+ * @param depth Оставшаяся глубина разбиения.
+ * @param task Текущая задача, сдвигается по мере обхода.
+ * @return Корень скопированной части.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::RedBlackTreeNode *
+RedBlackTree<Key, Comparator, Options>::LinkCopyTasks(
+    const RedBlackTreeNode *source, int depth, CopyTask *&task) noexcept {
+  if (depth == 0 || source == nullptr) {
+    return (task++)->result_;
+  }
+  RedBlackTreeNode *left = LinkCopyTasks(source->left_, depth - 1, task);
+  RedBlackTreeNode *node = (task++)->result_;
+  RedBlackTreeNode *right = LinkCopyTasks(source->right_, depth - 1, task);
+
+  node->left_ = left;
+  if (left)
+    left->set_parent(node);
+  node->right_ = right;
+  if (right)
+    right->set_parent(node);
+  if constexpr (kAggregated) {
+    node->UpdateAggregate();
+  }
+  return node;
+}
+
+/**
+ * @brief Подсчитывает количество узлов в поддереве.
+ *
+ * @param node Корень поддерева.
+ * @return Количество узлов.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::size_type
+RedBlackTree<Key, Comparator, Options>::CountNodes(
+    const RedBlackTreeNode *node) noexcept {
+  size_type count = 0;
+  while (node) {
+    count += 1 + CountNodes(node->left_);
+    node = node->right_;
+  }
+  return count;
+}
+
+/**
+ * @brief Определяет, делить ли работу над nodes узлами между потоками
+ * исполнителя Options::executor.
+ *
+ * @param nodes Число узлов копируемого дерева или обоих сливаемых деревьев.
+ * @return true, если узлов не меньше Options::parallel_threshold, а
+ * исполнителю доступно больше одного потока.
+ */
+template <typename Key, typename Comparator, typename Options>
+bool RedBlackTree<Key, Comparator, Options>::Parallel(
+    size_type nodes) noexcept {
+  return nodes >= Options::parallel_threshold &&
+         executor::Concurrency() > 1;
+}
+
+/**
+ * @brief Глубина, на которой верхние уровни дерева делятся на независимые
+ * поддеревья для параллельной работы: примерно по два поддерева на поток.
+ */
+template <typename Key, typename Comparator, typename Options>
+int RedBlackTree<Key, Comparator, Options>::ParallelDepth() noexcept {
+  int depth = 1;
+  while ((1U << depth) < 2 * executor::Concurrency() && depth < 6)
+    ++depth;
+  return depth;
+}
+
+/**
+ * @brief Делит слияние текущего дерева с other на участки.
+ *
+ * Без параллельности участок один - оба дерева целиком. Иначе текущее
+ * дерево делится на поддеревья верхних уровней и узлы над ними (как при
+ * параллельном копировании), а other разрезается нижними границами ключей
+ * этих узлов. Ключи разных участков не пересекаются, поэтому результаты
+ * участков, записанные подряд, уже упорядочены.
+ *
+ * @param other Правое дерево слияния.
+ * @param parallel Делить ли слияние на участки.
+ * @return Участки в порядке ключей.
+ */
+template <typename Key, typename Comparator, typename Options>
+std::vector<typename RedBlackTree<Key, Comparator, Options>::MergeTask>
+RedBlackTree<Key, Comparator, Options>::PlanMerge(const RedBlackTree &other,
+                                                  bool parallel) const {
+  std::vector<MergeTask> tasks;
+  if (!parallel) {
+    tasks.push_back(
+        {head_.left_, &head_, other.head_.left_, &other.head_, {}, 0, 0});
+    return tasks;
+  }
+
+  std::vector<CopyTask> parts;
+  CollectCopyTasks(head_.parent(), ParallelDepth(), parts);
+  const RedBlackTreeNode *rhs_first = other.head_.left_;
+  for (const CopyTask &part : parts) {
+    if (part.subtree_) {
+      // Конец участка other определится по следующему разделяющему узлу.
+      const RedBlackTreeNode *first = part.source_;
+      const RedBlackTreeNode *last = part.source_;
+      if (part.source_ != nullptr) {
+        while (first->left_ != nullptr)
+          first = first->left_;
+        while (last->right_ != nullptr)
+          last = last->right_;
+        last = last->NextNode();
+      }
+      tasks.push_back({first, last, rhs_first, &other.head_, {}, 0, 0});
+      continue;
+    }
+
+    const RedBlackTreeNode *bound = &other.head_;
+    const RedBlackTreeNode *node = other.head_.parent();
+    while (node != nullptr) {
+      const bool go_right = Less(node->key_, part.source_->key_);
+      bound = go_right ? bound : node;
+      node = go_right ? node->right_ : node->left_;
+    }
+    const RedBlackTreeNode *bound_last = bound;
+    if (bound != &other.head_ && !Less(part.source_->key_, bound->key_)) {
+      bound_last = bound->NextNode();
+    }
+    tasks.back().rhs_last_ = bound;
+    tasks.push_back({part.source_, part.source_->NextNode(), bound, bound_last,
+                     {}, 0, 0});
+    rhs_first = bound_last;
+  }
+  return tasks;
+}
+
+/**
+ * @brief Сливает участки деревьев по порядку ключей и сообщает emit о
+ * каждом узле, который мог бы попасть в результат.
+ *
+ * emit(node, from_lhs, keep) вызывается для каждого узла левого участка
+ * (keep - попадает ли он в результат) и для тех узлов правого участка,
+ * которые попадают в результат. При равных ключах правый узел пропускается.
+ *
+ * @param task Участок слияния.
+ * @param operation Операция.
+ * @param emit Обработчик узлов.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Emit>
+void RedBlackTree<Key, Comparator, Options>::MergeRanges(
+    const MergeTask &task, SetOperation operation, Emit &&emit) const {
+  const bool keep_lhs_only = operation == SetOperation::kUnion ||
+                             operation == SetOperation::kDifference ||
+                             operation == SetOperation::kSymmetricDifference;
+  const bool keep_rhs_only = operation == SetOperation::kUnion ||
+                             operation == SetOperation::kSymmetricDifference;
+  const bool keep_common = operation == SetOperation::kUnion ||
+                           operation == SetOperation::kIntersection;
+
+  const RedBlackTreeNode *lhs = task.lhs_first_;
+  const RedBlackTreeNode *rhs = task.rhs_first_;
+  while (lhs != task.lhs_last_ && rhs != task.rhs_last_) {
+    int order = 0; // Знак сравнения ключа lhs с ключом rhs.
+    if constexpr (kThreeWay) {
+      order = ThreeWay(lhs->key_, rhs->key_);
+    } else if (Less(lhs->key_, rhs->key_)) {
+      order = -1;
+    } else if (Less(rhs->key_, lhs->key_)) {
+      order = 1;
+    }
+
+    if (order < 0) {
+      emit(lhs, true, keep_lhs_only);
+      lhs = lhs->NextNode();
+    } else if (order > 0) {
+      if (keep_rhs_only) {
+        emit(rhs, false, true);
+      }
+      rhs = rhs->NextNode();
+    } else {
+      emit(lhs, true, keep_common);
+      lhs = lhs->NextNode();
+      rhs = rhs->NextNode();
+    }
+  }
+  for (; lhs != task.lhs_last_; lhs = lhs->NextNode()) {
+    emit(lhs, true, keep_lhs_only);
+  }
+  if (keep_rhs_only) {
+    for (; rhs != task.rhs_last_; rhs = rhs->NextNode()) {
+      emit(rhs, false, true);
+    }
+  }
+}
+
+/**
+ * @brief Выделяет непрерывный блок памяти под count узлов.
+ *
+ * Узлы в блоке не создаются, счетчик живых узлов равен нулю.
+ *
+ * @param count Количество узлов.
+ * @return Заголовок выделенного блока.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::NodeBlock *
+RedBlackTree<Key, Comparator, Options>::AllocateBlock(size_type count) {
+  if (count > kMaxBlockNodes) {
+    throw std::length_error(
+        "s21::RedBlackTree::AllocateBlock: Слишком много узлов в блоке.");
+  }
+  void *memory = ::operator new(kBlockHeader + count * sizeof(PooledNode),
+                                std::align_val_t{alignof(PooledNode)});
+  return new (memory) NodeBlock{0, count};
+}
+
+/**
+ * @brief Возвращает указатель на первую ячейку узла в блоке.
+ *
+ * @param block Заголовок блока.
+ * @return Указатель на первую ячейку.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::PooledNode *
+RedBlackTree<Key, Comparator, Options>::BlockSlots(NodeBlock *block) noexcept {
+  return reinterpret_cast<PooledNode *>(reinterpret_cast<char *>(block) +
+                                        kBlockHeader);
+}
+
+/**
+ * @brief Возвращает заголовок блока по его первой ячейке.
+ *
+ * @param slots Указатель на первую ячейку блока.
+ * @return Заголовок блока.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::NodeBlock *
+RedBlackTree<Key, Comparator, Options>::SlotsBlock(PooledNode *slots) noexcept {
+  return reinterpret_cast<NodeBlock *>(reinterpret_cast<char *>(slots) -
+                                       kBlockHeader);
+}
+
+/**
+ * @brief Освобождает память блока узлов.
+ *
+ * @param block Заголовок блока.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::ReleaseBlock(
+    NodeBlock *block) noexcept {
+  block->~NodeBlock();
+  ::operator delete(block, std::align_val_t{alignof(PooledNode)});
+}
+
+/**
+ * @brief Удаляет узел дерева и учитывает освобождение в счетчиках.
+ *
+ * @param node Удаляемый узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::FreeNode(
+    RedBlackTreeNode *node) noexcept {
+  ForgetNode(node);
+  stats_.Deallocate();
+  DeleteNode(node);
+}
+
+/**
+ * @brief Удаляет узел, не принадлежащий ни одному дереву.
+ *
+ * Отдельно выделенный узел удаляется через delete. Узел из общего блока
+ * разрушается на месте, а сам блок освобождается вместе с последним живым
+ * узлом.
+ *
+ * @param node Удаляемый узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::DeleteNode(
+    RedBlackTreeNode *node) noexcept {
+  if (!node->pooled()) {
+    delete node;
+    return;
+  }
+  PooledNode *pooled = static_cast<PooledNode *>(node);
+  NodeBlock *block = pooled->Block();
+  pooled->~PooledNode();
+  UnrefBlock(block);
+}
+
+/**
+ * @brief Снимает одну ссылку на блок (живой узел или проход уплотнения) и
+ * освобождает блок вместе с последней.
+ *
+ * acq_rel: все разрушения узлов блока в других потоках должны завершиться
+ * раньше, чем поток, снявший последнюю ссылку, освободит память.
+ *
+ * @param block Заголовок блока.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::UnrefBlock(
+    NodeBlock *block) noexcept {
+  if (block->alive_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    ReleaseBlock(block);
+  }
+}
+
+/**
+ * @brief Удаляет узлы поддерева, начиная с заданного узла.
+ *
+ * Левый потомок поворотом поднимается наверх, пока у текущего узла он есть;
+ * узел без левого потомка удаляется, и обход продолжается с правого. Обход
+ * выполняется за O(n) без стека и не выделяет память.
+ *
+ * @param node Узел, с которого начинается удаление.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::Destroy(
+    RedBlackTreeNode *node) noexcept {
+  while (node != nullptr) {
+    RedBlackTreeNode *left = node->left_;
+    if (left != nullptr) {
+      // Поворот вправо: связи удаляемых узлов можно не поддерживать
+      node->left_ = left->right_;
+      left->right_ = node;
+      node = left;
+    } else {
+      RedBlackTreeNode *right_child = node->right_;
+      FreeNode(node);
+      node = right_child;
+    }
+  }
+}
+
+/**
+ * @brief Инициализирует фиктивный узел head_ и связанные с ним указатели.
+ *
+ * Устанавливает указатели в head_ таким образом, что дерево будет пустым.
+ *
+ * Функция не принимает никаких аргументов и ничего не возвращает.
+ * Этот метод обеспечивает корректное начальное состояние дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::InitializeHead() noexcept {
+  head_.set_parent(nullptr);
+  head_.left_ = &head_;
+  head_.right_ = &head_;
+  if constexpr (Options::threaded) {
+    head_.next_ = &head_;
+    head_.prev_ = &head_;
+  }
+}
+
+/**
+ * @brief Восстанавливает ссылки на head_ после обмена связями фиктивных
+ * узлов: родителя корня, а в прошитом дереве - соседей минимума и максимума.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::RelinkHead() noexcept {
+  if (head_.parent() == nullptr) {
+    InitializeHead();
+    return;
+  }
+  head_.parent()->set_parent(&head_);
+  if constexpr (Options::threaded) {
+    head_.next_->prev_ = &head_;
+    head_.prev_->next_ = &head_;
+  }
+}
+
+/**
+ * @brief Вставляет узел в список соседей прошитого дерева.
+ *
+ * Узел уже должен стоять на своем месте в дереве. Соседи определяются по
+ * родителю: левый ребенок встает перед родителем, правый - после него.
+ * Для обычного дерева ничего не делает.
+ *
+ * @param node Только что вставленный узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::LinkThread(
+    RedBlackTreeNode *node) noexcept {
+  if constexpr (Options::threaded) {
+    RedBlackTreeNode *parent = node->parent();
+    RedBlackTreeNode *prev = &head_;
+    RedBlackTreeNode *next = &head_;
+    if (parent != &head_) {
+      if (parent->left_ == node) {
+        next = parent;
+        prev = parent->prev_;
+      } else {
+        prev = parent;
+        next = parent->next_;
+      }
+    }
+    node->prev_ = prev;
+    node->next_ = next;
+    prev->next_ = node;
+    next->prev_ = node;
+  }
+}
+
+/**
+ * @brief Исключает узел из списка соседей прошитого дерева.
+ *
+ * Повороты и обмен узлов местами при удалении не меняют порядок ключей,
+ * поэтому список правится только при вставке и извлечении узла.
+ *
+ * @param node Извлекаемый узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::UnlinkThread(
+    RedBlackTreeNode *node) noexcept {
+  if constexpr (Options::threaded) {
+    node->prev_->next_ = node->next_;
+    node->next_->prev_ = node->prev_;
+  }
+}
+
+/**
+ * @brief Связывает в список соседей узлы, скопированные в блок по порядку.
+ *
+ * @param slots Первый узел блока.
+ * @param count Количество узлов в блоке.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::LinkThreadsInBlock(
+    PooledNode *slots, size_type count) noexcept {
+  if constexpr (Options::threaded) {
+    RedBlackTreeNode *prev = &head_;
+    for (size_type i = 0; i < count; ++i) {
+      prev->next_ = slots + i;
+      slots[i].prev_ = prev;
+      prev = slots + i;
+    }
+    prev->next_ = &head_;
+    head_.prev_ = prev;
+  }
+}
+
+/**
+ * @brief Связывает узлы массива в список соседей прошитого дерева в порядке
+ * их следования. Для обычного дерева ничего не делает.
+ *
+ * @param nodes Узлы дерева в порядке обхода.
+ * @param count Количество узлов.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::LinkThreadsInOrder(
+    RedBlackTreeNode *const *nodes, size_type count) noexcept {
+  if constexpr (Options::threaded) {
+    RedBlackTreeNode *prev = &head_;
+    for (size_type i = 0; i < count; ++i) {
+      prev->next_ = nodes[i];
+      nodes[i]->prev_ = prev;
+      prev = nodes[i];
+    }
+    prev->next_ = &head_;
+    head_.prev_ = prev;
+  }
+}
+
+/**
+ * @brief Отделяет поддерево от родителя и делает его самостоятельным
+ * деревом: красный корень перекрашивается в черный.
+ *
+ * @param node Корень поддерева (может быть nullptr).
+ * @param black_height Черная высота поддерева до перекрашивания корня.
+ * @return Самостоятельное поддерево.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::Subtree
+RedBlackTree<Key, Comparator, Options>::Detach(RedBlackTreeNode *node,
+                                               int black_height) noexcept {
+  if (node == nullptr) {
+    return {nullptr, 0};
+  }
+  node->set_parent(nullptr);
+  if (node->color() == RED) {
+    node->set_color(BLACK);
+    stats_.Recolor();
+    ++black_height;
+  }
+  return {node, black_height};
+}
+
+/**
+ * @brief Склеивает два дерева через разделяющий узел.
+ *
+ * Все ключи left меньше pivot, все ключи right больше. Узел ставится на
+ * правую (левую) границу более высокого дерева на уровень с той же черной
+ * высотой, что у низкого, после чего нарушение "красный под красным"
+ * исправляется обычной балансировкой вставки. Стоимость - O(|разность
+ * черных высот| + 1).
+ *
+ * На время балансировки корень высокого дерева подвешивается к head_, поэтому
+ * основное дерево в этот момент должно быть отсоединено от head_.
+ *
+ * @param left Левое дерево.
+ * @param pivot Разделяющий узел, не входящий ни в одно из деревьев.
+ * @param right Правое дерево.
+ * @return Склеенное дерево.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::Subtree
+RedBlackTree<Key, Comparator, Options>::Join(Subtree left,
+                                             RedBlackTreeNode *pivot,
+                                             Subtree right) noexcept {
+  if (left.black_height_ == right.black_height_) {
+    pivot->set_parent(nullptr);
+    pivot->left_ = left.root_;
+    pivot->right_ = right.root_;
+    pivot->set_color(BLACK);
+    if (left.root_ != nullptr) {
+      left.root_->set_parent(pivot);
+    }
+    if (right.root_ != nullptr) {
+      right.root_->set_parent(pivot);
+    }
+    if constexpr (kAggregated) {
+      pivot->UpdateAggregate();
+    }
+    return {pivot, left.black_height_ + 1};
+  }
+
+  const bool into_left = left.black_height_ > right.black_height_;
+  Subtree tall = into_left ? left : right;
+  Subtree low = into_left ? right : left;
+
+  // Спускаемся по внутренней границе высокого дерева до черного узла (или
+  // листа) с черной высотой низкого дерева.
+  RedBlackTreeNode *parent = nullptr;
+  RedBlackTreeNode *node = tall.root_;
+  int black_height = tall.black_height_;
+  while (node != nullptr &&
+         (node->color() == RED || black_height != low.black_height_)) {
+    black_height -= node->color() == BLACK ? 1 : 0;
+    parent = node;
+    node = into_left ? node->right_ : node->left_;
+  }
+
+  pivot->set_parent(parent);
+  pivot->set_color(RED);
+  if (into_left) {
+    pivot->left_ = node;
+    pivot->right_ = low.root_;
+    parent->right_ = pivot;
+  } else {
+    pivot->left_ = low.root_;
+    pivot->right_ = node;
+    parent->left_ = pivot;
+  }
+  if (node != nullptr) {
+    node->set_parent(pivot);
+  }
+  if (low.root_ != nullptr) {
+    low.root_->set_parent(pivot);
+  }
+
+  head_.set_parent(tall.root_);
+  tall.root_->set_parent(&head_);
+  if (TreeAlgorithms::BalanceAfterInsert(&head_, pivot, stats_)) {
+    ++tall.black_height_;
+  }
+  tall.root_ = head_.parent();
+  tall.root_->set_parent(nullptr);
+  return tall;
+}
+
+/**
+ * @brief Рекурсивно разрезает дерево по узлу на конце пути.
+ *
+ * Поддеревья, отходящие от пути влево, вместе со своими узлами пути
+ * склеиваются в левую часть, отходящие вправо - в правую. Стоимости
+ * склеиваний складываются в O(log n). Сам узел path[length - 1] не попадает
+ * ни в одну из частей.
+ *
+ * @param path Путь от корня дерева до узла разреза.
+ * @param length Длина пути.
+ * @param black_height Черная высота поддерева с корнем path[0].
+ * @param left Узлы, меньшие узла разреза.
+ * @param right Узлы, большие узла разреза.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::Split(
+    RedBlackTreeNode *const *path, int length, int black_height,
+    Subtree &left, Subtree &right) noexcept {
+  RedBlackTreeNode *node = path[0];
+  const int child_height = black_height - (node->color() == BLACK ? 1 : 0);
+  if (length == 1) {
+    left = Detach(node->left_, child_height);
+    right = Detach(node->right_, child_height);
+    return;
+  }
+
+  if (path[1] == node->left_) {
+    Subtree node_right = Detach(node->right_, child_height);
+    Subtree inner_right;
+    Split(path + 1, length - 1, child_height, left, inner_right);
+    right = Join(inner_right, node, node_right);
+  } else {
+    Subtree node_left = Detach(node->left_, child_height);
+    Subtree inner_left;
+    Split(path + 1, length - 1, child_height, inner_left, right);
+    left = Join(node_left, node, inner_left);
+  }
+}
+
+/**
+ * @brief Разрезает самостоятельное дерево по узлу: left получает все узлы
+ * перед node, right - все узлы после него. Сам node не попадает ни в одну из
+ * частей.
+ *
+ * @param node Узел разреза, лежащий в tree.
+ * @param tree Разрезаемое дерево (родитель корня - nullptr).
+ * @param left Узлы перед node.
+ * @param right Узлы после node.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::SplitAt(RedBlackTreeNode *node,
+                                                     Subtree tree,
+                                                     Subtree &left,
+                                                     Subtree &right) noexcept {
+  RedBlackTreeNode *path[kMaxHeight + 1];
+  int length = 0;
+  for (RedBlackTreeNode *current = node; current != nullptr;
+       current = current->parent()) {
+    path[length++] = current;
+  }
+  std::reverse(path, path + length);
+  Split(path, length, tree.black_height_, left, right);
+}
+
+/**
+ * @brief Вычисляет черную высоту поддерева спуском по левой границе.
+ *
+ * @param node Корень поддерева.
+ * @return Число черных узлов на пути от node до листа, включая node.
+ */
+template <typename Key, typename Comparator, typename Options>
+int RedBlackTree<Key, Comparator, Options>::BlackHeight(
+    const RedBlackTreeNode *node) noexcept {
+  int black_height = 0;
+  for (; node != nullptr; node = node->left_) {
+    black_height += node->color() == BLACK ? 1 : 0;
+  }
+  return black_height;
+}
+
+/**
+ * @brief Делает узлы, заданные в порядке обхода, содержимым дерева.
+ *
+ * Из узлов за O(n) строится идеально сбалансированное дерево, к нему
+ * подвешивается head_ и, для прошитого дерева, связывается список соседей.
+ * Прежние связи узлов не используются.
+ *
+ * @param nodes Узлы в порядке обхода.
+ * @param count Количество узлов (не меньше одного).
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::AdoptInOrder(
+    RedBlackTreeNode *const *nodes, size_type count) noexcept {
+  // Уровни 0..red_depth-1 заполнены полностью и окрашены в черный, узлы
+  // неполного нижнего уровня - красные.
+  size_type red_depth = 0;
+  while ((size_type{2} << red_depth) <= count + 1) {
+    ++red_depth;
+  }
+  RedBlackTreeNode *root = BuildBalanced(nodes, count, 0, red_depth);
+  head_.set_parent(root);
+  root->set_parent(&head_);
+  head_.left_ = nodes[0];
+  head_.right_ = nodes[count - 1];
+  LinkThreadsInOrder(nodes, count);
+  size_ = count;
+}
+
+/**
+ * @brief Строит идеально сбалансированное поддерево из узлов, заданных в
+ * порядке обхода.
+ *
+ * Корнем становится средний узел, половины строятся рекурсивно. Все листья
+ * такого дерева лежат на двух соседних уровнях, поэтому окраска "нижний
+ * неполный уровень красный, остальные черные" дает корректное
+ * красно-черное дерево.
+ *
+ * @param nodes Узлы в порядке обхода.
+ * @param count Количество узлов.
+ * @param depth Глубина корня строящегося поддерева.
+ * @param red_depth Глубина, узлы на которой окрашиваются в красный.
+ * @return Корень поддерева (nullptr для пустого).
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::RedBlackTreeNode *
+RedBlackTree<Key, Comparator, Options>::BuildBalanced(
+    RedBlackTreeNode *const *nodes, size_type count, size_type depth,
+    size_type red_depth) noexcept {
+  if (count == 0) {
+    return nullptr;
+  }
+  const size_type middle = count / 2;
+  RedBlackTreeNode *node = nodes[middle];
+  node->left_ = BuildBalanced(nodes, middle, depth + 1, red_depth);
+  node->right_ = BuildBalanced(nodes + middle + 1, count - middle - 1,
+                               depth + 1, red_depth);
+  if (node->left_ != nullptr) {
+    node->left_->set_parent(node);
+  }
+  if (node->right_ != nullptr) {
+    node->right_->set_parent(node);
+  }
+  node->set_color(depth == red_depth ? RED : BLACK);
+  if constexpr (kAggregated) {
+    node->UpdateAggregate();
+  }
+  return node;
+}
+/**
+ * @brief Проверяет корректность структуры и свойств красно-черного дерева.
+ *
+ * @return `true`, если дерево корректно; `false`, если есть нарушения.
+ */
+template <typename Key, typename Comparator, typename Options>
+bool RedBlackTree<Key, Comparator, Options>::CheckTree() const noexcept {
+  // Проверка корректности корневого узла
+  if (head_.color() == BLACK) {
+    return false;
+  }
+  // Получение корневого узла дерева
+  RedBlackTreeNode *root = head_.parent();
+
+  // Пустое дерево считается корректным
+  if (root == nullptr) {
+    return true;
+  }
+
+  // Проверка свойств красно-черного дерева:
+  // 1. Корневой узел не может быть красным
+  // 2. Для каждого красного узла его дети должны быть черными
+  // 3. Чёрные высоты поддеревьев должны быть равны
+
+  // Если корневой узел красный или нарушено условие для красных узлов,
+  // возвращаем false
+  if (root->color() == RED || !checkRedNodes(root) ||
+      ComputeBlackHeight(root) == -1) {
+    return false;
+  }
+
+  // Агрегаты поддеревьев должны совпадать с пересчитанными заново.
+  if constexpr (kAggregated) {
+    if (!CheckAggregates(root)) {
+      return false;
+    }
+  }
+
+  // Дерево прошло все проверки и считается корректным
+  return true;
+}
+
+/**
+ * @brief Сворачивает агрегатом Options::aggregate элементы с ключами из
+ * полуинтервала [lo, hi) в порядке ключей - тех же, что удаляет
+ * Erase(LowerBound(lo), LowerBound(hi)).
+ *
+ * Спуск находит узел, где пути к lo и hi расходятся; дальше на пути к lo
+ * каждый узел не меньше lo добавляет себя и целое правое поддерево, а на
+ * пути к hi каждый узел меньше hi - себя и целое левое поддерево. Итого
+ * O(log n) сравнений и операций моноида вместо обхода k элементов.
+ *
+ * @param lo Нижняя граница (включительно).
+ * @param hi Верхняя граница (не включается).
+ * @return Агрегат элементов полуинтервала; Identity(), если он пуст.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Bound>
+typename RedBlackTree<Key, Comparator, Options>::aggregate_type
+RedBlackTree<Key, Comparator, Options>::Aggregate(const Bound &lo,
+                                                  const Bound &hi) const {
+  static_assert(kAggregated, "Aggregate() requires Options::aggregate");
+  using Policy = typename Options::aggregate;
+
+  const RedBlackTreeNode *split = head_.parent();
+  while (split != nullptr) {
+    if (Less(split->key_, lo)) {
+      split = split->right_;
+    } else if (!Less(split->key_, hi)) {
+      split = split->left_;
+    } else {
+      break;
+    }
+  }
+  if (split == nullptr) {
+    return Policy::Identity();
+  }
+
+  aggregate_type result = Policy::Lift(split->key_);
+  for (const RedBlackTreeNode *node = split->left_; node != nullptr;) {
+    if (Less(node->key_, lo)) {
+      node = node->right_;
+      continue;
+    }
+    aggregate_type part = Policy::Lift(node->key_);
+    if (node->right_ != nullptr) {
+      part = Policy::Combine(part, node->right_->aggregate_);
+    }
+    result = Policy::Combine(part, result);
+    node = node->left_;
+  }
+  for (const RedBlackTreeNode *node = split->right_; node != nullptr;) {
+    if (!Less(node->key_, hi)) {
+      node = node->left_;
+      continue;
+    }
+    aggregate_type part = Policy::Lift(node->key_);
+    if (node->left_ != nullptr) {
+      part = Policy::Combine(node->left_->aggregate_, part);
+    }
+    result = Policy::Combine(result, part);
+    node = node->right_;
+  }
+  return result;
+}
+
+/**
+ * @brief Пересчитывает агрегаты после изменения элемента на месте.
+ *
+ * Порядок ключей меняться не должен: обновляются только агрегаты узла
+ * position и его предков, за O(log n).
+ *
+ * @param position Итератор на измененный элемент.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::UpdateAggregates(
+    iterator position) noexcept {
+  if constexpr (kAggregated) {
+    if (position.node_ != &head_) {
+      TreeAlgorithms::UpdateAggregates(&head_, position.node_);
+    }
+  }
+}
+
+/**
+ * @brief Обходит элементы по порядку, пропуская поддеревья по их агрегатам.
+ *
+ * Поддерево, для агрегата которого skip_subtree вернул true, не
+ * посещается целиком. Обход останавливается, как только visit вернет false.
+ * Так, для интервалов, упорядоченных по левому концу, с агрегатом
+ * "наибольший правый конец" поиск пересечений посещает только поддеревья,
+ * где они могут быть, и останавливается на первом интервале правее запроса.
+ *
+ * @param skip_subtree Предикат от const aggregate_type &.
+ * @param visit Обработчик const_iterator на элемент; false - остановить
+ * обход.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename SkipSubtree, typename Visit>
+void RedBlackTree<Key, Comparator, Options>::VisitInOrder(
+    SkipSubtree skip_subtree, Visit visit) const {
+  static_assert(kAggregated, "VisitInOrder() requires Options::aggregate");
+  VisitSubtree(head_.parent(), skip_subtree, visit);
+}
+
+/**
+ * @brief Рекурсивный шаг VisitInOrder.
+ *
+ * @param node Корень поддерева.
+ * @param skip_subtree Предикат пропуска поддерева.
+ * @param visit Обработчик элементов.
+ * @return false, если обход остановлен.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename SkipSubtree, typename Visit>
+bool RedBlackTree<Key, Comparator, Options>::VisitSubtree(
+    const RedBlackTreeNode *node, SkipSubtree &skip_subtree,
+    Visit &visit) const {
+  if (node == nullptr || skip_subtree(node->aggregate_)) {
+    return true;
+  }
+  return VisitSubtree(node->left_, skip_subtree, visit) &&
+         visit(const_iterator(node)) &&
+         VisitSubtree(node->right_, skip_subtree, visit);
+}
+
+/**
+ * @brief Заменяет содержимое дерева элементами упорядоченной
+ * последовательности за O(n).
+ *
+ * Узлы создаются одним блоком по порядку, а дерево собирается снизу вверх
+ * (BuildBalanced) без поиска мест вставки и поворотов. Равные элементы
+ * допускаются. Элементы копируются, а из std::move_iterator - перемещаются.
+ * При исключении во время копирования дерево остается пустым.
+ *
+ * @param first Начало последовательности, упорядоченной компаратором.
+ * @param last Конец последовательности.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename ForwardIt>
+void RedBlackTree<Key, Comparator, Options>::AssignSorted(ForwardIt first,
+                                                          ForwardIt last) {
+  Clear();
+  const auto count = static_cast<size_type>(std::distance(first, last));
+  if (count == 0) {
+    return;
+  }
+
+  NodeBlock *block = AllocateBlock(count);
+  PooledNode *slots = BlockSlots(block);
+  size_type constructed = 0;
+  try {
+    for (; first != last; ++first, ++constructed) {
+      new (slots + constructed) PooledNode(*first, BLACK, block);
+    }
+  } catch (...) {
+    for (size_type i = 0; i < constructed; ++i) {
+      slots[i].~PooledNode();
+    }
+    ReleaseBlock(block);
+    throw;
+  }
+  block->alive_.store(count, std::memory_order_relaxed);
+  stats_.Allocate(count);
+
+  std::vector<RedBlackTreeNode *> nodes(count);
+  for (size_type i = 0; i < count; ++i) {
+    nodes[i] = slots + i;
+  }
+  AdoptInOrder(nodes.data(), count);
+}
+
+/**
+ * @brief Переносит все узлы дерева в один новый непрерывный блок.
+ *
+ * После долгой череды вставок и удалений узлы разбросаны по куче, и обход
+ * каждый раз промахивается мимо кеша. Уплотнение раскладывает узлы подряд
+ * в выбранном порядке: по порядку ключей полный обход читает память
+ * последовательно, а в порядке ван Эмде Боаса соседние уровни пути поиска
+ * лежат рядом. Форма дерева, цвета, агрегаты и прошивка не меняются,
+ * переносятся только сами узлы; незаконченное пошаговое уплотнение
+ * начинается заново. Стоит O(n) в порядке ключей и O(n log log n) в
+ * порядке ван Эмде Боаса.
+ *
+ * Итераторы, указатели и ссылки на элементы становятся недействительными.
+ * Элементы перемещаются, если их перемещение не бросает исключений, иначе
+ * копируются; при исключении дерево остается корректным, часть узлов может
+ * быть уже перенесена.
+ *
+ * @param order Порядок узлов в блоке.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::Compact(CompactOrder order) {
+  AbortCompaction();
+  CompactStep(std::numeric_limits<size_type>::max(), order);
+}
+
+/**
+ * @brief Выполняет очередную порцию пошагового уплотнения: переносит не
+ * более max_nodes узлов.
+ *
+ * Первый вызов начинает проход: выделяет блок на Size() узлов, а для
+ * порядка ван Эмде Боаса еще и строит план переноса за O(n log log n).
+ * Следующие вызовы продолжают с места остановки, order у них не
+ * учитывается. Между вызовами дерево можно менять как угодно: узлы,
+ * вставленные после начала прохода, переносятся, только если в порядке
+ * ключей окажутся дальше уже перенесенных и в блоке останется место.
+ * Удаление последнего перенесенного узла (в порядке ключей) или любого
+ * узла (в порядке ван Эмде Боаса) прерывает проход; следующий вызов
+ * начнет новый.
+ *
+ * Перенос делает недействительными итераторы, указатели и ссылки на
+ * перенесенные элементы.
+ *
+ * @param max_nodes Наибольшее число узлов, переносимых за вызов.
+ * @param order Порядок узлов в блоке для нового прохода.
+ * @return true, если проход закончен (или дерево пусто) и все узлы,
+ * бывшие в дереве на его начало, лежат в одном блоке.
+ */
+template <typename Key, typename Comparator, typename Options>
+bool RedBlackTree<Key, Comparator, Options>::CompactStep(size_type max_nodes,
+                                                         CompactOrder order) {
+  if (compaction_ == nullptr) {
+    if (size_ == 0) {
+      return true;
+    }
+    BeginCompaction(order);
+  }
+
+  CompactionPass &pass = *compaction_;
+  PooledNode *slots = BlockSlots(pass.block_);
+  bool finished = false;
+  for (size_type moved = 0; moved < max_nodes; ++moved) {
+    RedBlackTreeNode *node = nullptr;
+    if (pass.order_ == CompactOrder::kInOrder) {
+      node = pass.cursor_ == nullptr ? head_.left_ : pass.cursor_->NextNode();
+    } else if (pass.used_ < pass.plan_.size()) {
+      node = pass.plan_[pass.used_];
+    }
+    if (node == nullptr || node == &head_ || pass.used_ == pass.capacity_) {
+      finished = true;
+      break;
+    }
+    pass.cursor_ = Relocate(node, slots + pass.used_, pass.block_);
+    ++pass.used_;
+  }
+  // Последний узел плана мог быть перенесен ровно на границе порции.
+  if (pass.used_ == pass.capacity_ ||
+      (pass.order_ == CompactOrder::kInOrder && pass.cursor_ != nullptr &&
+       pass.cursor_->NextNode() == &head_)) {
+    finished = true;
+  }
+
+  if (finished) {
+    AbortCompaction();
+  }
+  return finished;
 }
 
 /**
- * @brief Обрабатывает ситуацию, когда брат узла черный, а у него есть красный
- * ребенок. Этот метод выполняет перебалансировку для поддержания свойств
- * красно-черного дерева.
+ * @brief Начинает проход уплотнения: блок на все текущие узлы и, для
+ * порядка ван Эмде Боаса, план переноса.
  *
- * @param parent Родительский узел для проверяемого узла.
- * @param check_node Узел, для которого выполняется перебалансировка.
+ * @param order Порядок узлов в блоке.
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::HandleBlackSiblingWithRedChild(
-    RedBlackTreeNode *parent, RedBlackTreeNode *&check_node) {
-  RedBlackTreeNode *sibling =
-      (check_node == parent->left_) ? parent->right_ : parent->left_;
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::BeginCompaction(
+    CompactOrder order) {
+  auto pass = std::make_unique<CompactionPass>();
+  pass->order_ = order;
+  pass->capacity_ = size_;
+  pass->used_ = 0;
+  pass->cursor_ = nullptr;
+  if (order == CompactOrder::kVanEmdeBoas) {
+    pass->plan_.reserve(size_);
+    CollectVanEmdeBoas(head_.parent(), Height(head_.parent()), pass->plan_);
+  }
+  pass->block_ = AllocateBlock(size_);
+  // Ссылка самого прохода: блок не освободится, даже если все перенесенные
+  // узлы уже удалены вне дерева.
+  pass->block_->alive_.store(1, std::memory_order_relaxed);
+  compaction_ = std::move(pass);
+}
 
-  // Если проверяемый узел - левый ребенок родителя и левый ребенок брата
-  // красный.
-  if (check_node == parent->left_ && sibling->left_ != nullptr &&
-      sibling->left_->color_ == RED &&
-      (sibling->right_ == nullptr || sibling->right_->color_ == BLACK)) {
-    std::swap(sibling->color_, sibling->left_->color_);
-    RotateRight(sibling);
-    sibling = parent->right_;
+/**
+ * @brief Завершает или прерывает проход уплотнения.
+ *
+ * Проход отпускает свою ссылку на блок: блок с уже перенесенными узлами
+ * живет, пока жив хоть один из них; блок, в который не перенесено ни одного
+ * узла, освобождается сразу.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::AbortCompaction() noexcept {
+  if (compaction_ == nullptr) {
+    return;
   }
-  // Если проверяемый узел - правый ребенок родителя и правый ребенок брата
-  // красный.
-  else if (sibling->right_ != nullptr && sibling->right_->color_ == RED &&
-           (sibling->left_ == nullptr || sibling->left_->color_ == BLACK)) {
-    std::swap(sibling->color_, sibling->right_->color_);
-    RotateLeft(sibling);
-    sibling = parent->left_;
+  UnrefBlock(compaction_->block_);
+  compaction_.reset();
+}
+
+/**
+ * @brief Прерывает проход уплотнения, если удаляемый из дерева узел нужен
+ * для его продолжения.
+ *
+ * @param node Узел, который покидает дерево.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::ForgetNode(
+    const RedBlackTreeNode *node) noexcept {
+  if (compaction_ != nullptr &&
+      (compaction_->order_ == CompactOrder::kVanEmdeBoas ||
+       compaction_->cursor_ == node)) {
+    AbortCompaction();
   }
+}
 
-  sibling->left_->color_ = BLACK;
-  sibling->color_ = parent->color_;
-  parent->color_ = BLACK;
+/**
+ * @brief Переносит узел в ячейку блока, сохраняя его место в дереве.
+ *
+ * Новый узел получает элемент, цвет, связи, агрегат и соседей по прошивке
+ * старого, после чего все ссылки на старый узел (родитель, дети, соседи и
+ * крайние узлы head_) перенаправляются на новый, а старый удаляется. Если
+ * создание элемента бросит исключение, дерево не меняется.
+ *
+ * @param node Переносимый узел.
+ * @param slot Свободная ячейка блока.
+ * @param block Блок ячейки.
+ * @return Узел на новом месте.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::RedBlackTreeNode *
+RedBlackTree<Key, Comparator, Options>::Relocate(RedBlackTreeNode *node,
+                                                 PooledNode *slot,
+                                                 NodeBlock *block) {
+  RedBlackTreeNode *moved = new (slot)
+      PooledNode(std::move_if_noexcept(node->key_), node->color(), block);
+  block->alive_.fetch_add(1, std::memory_order_relaxed);
+  stats_.Allocate();
+
+  RedBlackTreeNode *parent = node->parent();
+  moved->set_parent(parent);
+  moved->left_ = node->left_;
+  moved->right_ = node->right_;
+  if constexpr (kAggregated) {
+    moved->aggregate_ = node->aggregate_;
+  }
+  if constexpr (Options::threaded) {
+    moved->next_ = node->next_;
+    moved->prev_ = node->prev_;
+    moved->next_->prev_ = moved;
+    moved->prev_->next_ = moved;
+  }
 
-  // Поворачиваем родительский узел влево или вправо в зависимости от позиции
-  // проверяемого узла.
-  if (check_node == parent->left_) {
-    RotateLeft(parent);
+  if (node == head_.parent()) {
+    head_.set_parent(moved);
+  } else if (parent->left_ == node) {
+    parent->left_ = moved;
   } else {
-    RotateRight(parent);
+    parent->right_ = moved;
+  }
+  if (moved->left_ != nullptr) {
+    moved->left_->set_parent(moved);
+  }
+  if (moved->right_ != nullptr) {
+    moved->right_->set_parent(moved);
+  }
+  if (head_.left_ == node) {
+    head_.left_ = moved;
+  }
+  if (head_.right_ == node) {
+    head_.right_ = moved;
+  }
+
+  stats_.Deallocate();
+  DeleteNode(node);
+  return moved;
+}
+
+/**
+ * @brief Вычисляет высоту поддерева (число уровней).
+ *
+ * @param node Корень поддерева.
+ * @return Высота; 0 для пустого поддерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+int RedBlackTree<Key, Comparator, Options>::Height(
+    const RedBlackTreeNode *node) noexcept {
+  if (node == nullptr) {
+    return 0;
+  }
+  return 1 + std::max(Height(node->left_), Height(node->right_));
+}
+
+/**
+ * @brief Дописывает узлы поддерева в порядке ван Эмде Боаса.
+ *
+ * Верхние levels / 2 уровней раскладываются рекурсивно как отдельное
+ * дерево, за ними - каждое поддерево, растущее из следующего уровня,
+ * слева направо. Глубина рекурсии - O(log log n) вложенных разбиений по
+ * высоте дерева.
+ *
+ * @param node Корень поддерева.
+ * @param levels Число уровней поддерева, которые нужно разложить.
+ * @param order Последовательность узлов для переноса.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::CollectVanEmdeBoas(
+    RedBlackTreeNode *node, int levels,
+    std::vector<RedBlackTreeNode *> &order) {
+  if (node == nullptr || levels == 0) {
+    return;
+  }
+  if (levels == 1) {
+    order.push_back(node);
+    return;
+  }
+  const int top = levels / 2;
+  CollectVanEmdeBoas(node, top, order);
+  std::vector<RedBlackTreeNode *> roots;
+  CollectLevel(node, top, roots);
+  for (RedBlackTreeNode *root : roots) {
+    CollectVanEmdeBoas(root, levels - top, order);
   }
 }
 
 /**
- * @brief Балансирует дерево после удаления узла, чтобы сохранить свойства
- * красно-черного дерева.
+ * @brief Собирает узлы поддерева на заданной глубине слева направо.
  *
- * @param deleted_node Узел, который был удален и требует балансировки.
+ * @param node Корень поддерева.
+ * @param depth Глубина относительно node (0 - сам node).
+ * @param level Найденные узлы.
  */
-template <typename KeyType, typename Comparator>
-void RedBlackTree<KeyType, Comparator>::EraseBalancing(
-    RedBlackTreeNode *deleted_node) noexcept {
-  RedBlackTreeNode *node_to_check = deleted_node;
-  RedBlackTreeNode *parent_node = deleted_node->parent_;
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::CollectLevel(
+    RedBlackTreeNode *node, int depth,
+    std::vector<RedBlackTreeNode *> &level) {
+  if (node == nullptr) {
+    return;
+  }
+  if (depth == 0) {
+    level.push_back(node);
+    return;
+  }
+  CollectLevel(node->left_, depth - 1, level);
+  CollectLevel(node->right_, depth - 1, level);
+}
 
-  // Пока проверяемый узел не достигнет корня и его цвет черный.
-  while (node_to_check != head_->parent_ && node_to_check->color_ == BLACK) {
-    if (node_to_check == parent_node->left_ ||
-        node_to_check == parent_node->right_) {
-      // Получаем брата проверяемого узла.
-      RedBlackTreeNode *sibling_node = (node_to_check == parent_node->left_)
-                                           ? parent_node->right_
-                                           : parent_node->left_;
+/**
+ * @brief Возвращает снимок счетчиков горячего пути дерева.
+ *
+ * Счетчики ведутся только при Options::stats; иначе все значения нулевые.
+ * Они описывают работу, выполненную именно этим объектом, и не переносятся
+ * при копировании, перемещении и обмене деревьев.
+ *
+ * @return Значения счетчиков на момент вызова.
+ */
+template <typename Key, typename Comparator, typename Options>
+ContainerStats RedBlackTree<Key, Comparator, Options>::Stats() const noexcept {
+  return stats_.Snapshot();
+}
 
-      // Если брат красный, выполняем балансировку для этой ситуации.
-      if (sibling_node->color_ == RED) {
-        HandleRedSibling(parent_node, node_to_check);
-      }
+/**
+ * @brief Обнуляет счетчики горячего пути дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+void RedBlackTree<Key, Comparator, Options>::ResetStats() noexcept {
+  stats_.Reset();
+}
 
-      // Обновляем указатель на брата, так как он мог измениться.
-      sibling_node = (node_to_check == parent_node->left_) ? parent_node->right_
-                                                           : parent_node->left_;
-
-      // Если брат черный и у него также черные дети, выполняем балансировку.
-      if (sibling_node->color_ == BLACK &&
-          (sibling_node->left_ == nullptr ||
-           sibling_node->left_->color_ == BLACK) &&
-          (sibling_node->right_ == nullptr ||
-           sibling_node->right_->color_ == BLACK)) {
-        HandleBlackSiblingWithBlackChildren(parent_node, node_to_check);
-      } else {
-        // В противном случае, выполняем балансировку для черного брата с
-        // красным ребенком.
-        HandleBlackSiblingWithRedChild(parent_node, node_to_check);
-        break;
+/**
+ * @brief Подсчитывает память, занятую деревом, за O(n log n).
+ *
+ * Учитываются сам объект дерева вместе с фиктивным узлом, отдельно
+ * выделенные узлы и каждый общий блок, в котором есть узел дерева, целиком:
+ * заголовок и все ячейки, включая ячейки уже удаленных узлов - блок
+ * освобождается только вместе с последним узлом. Блок, узлы которого
+ * разошлись по нескольким деревьям, учитывается каждым из них. Служебные
+ * данные распределителя памяти не учитываются.
+ *
+ * @return Число байт.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::size_type
+RedBlackTree<Key, Comparator, Options>::MemoryUsage() const {
+  size_type bytes = sizeof(RedBlackTree);
+  std::vector<const NodeBlock *> blocks;
+  for (const RedBlackTreeNode *node = head_.left_; node != &head_;
+       node = node->NextNode()) {
+    if (!node->pooled()) {
+      bytes += sizeof(RedBlackTreeNode);
+      continue;
+    }
+    // Соседние по порядку узлы обычно лежат в одном блоке.
+    const NodeBlock *block = static_cast<const PooledNode *>(node)->Block();
+    if (blocks.empty() || blocks.back() != block) {
+      blocks.push_back(block);
+    }
+  }
+  std::sort(blocks.begin(), blocks.end());
+  blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+  for (const NodeBlock *block : blocks) {
+    bytes += kBlockHeader + block->capacity_ * sizeof(PooledNode);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Находит место для нового элемента спуском от корня.
+ *
+ * Новый узел становится минимумом (максимумом) дерева, только если спуск ни
+ * разу не свернул вправо (влево), поэтому крайние узлы определяются без
+ * дополнительных сравнений. Для арифметических ключей равенство проверяется
+ * один раз после спуска - с последним узлом, от которого спуск свернул
+ * вправо, а при трехстороннем сравнении - тем же сравнением, что выбирает
+ * сторону спуска.
+ *
+ * @param probe Ключ нового элемента или любой объект, который компаратор
+ * сравнивает с ключами дерева в обе стороны.
+ * @param check_duplicates Искать узел с равным ключом.
+ * @return Место вставки; при найденном дубликате заполнено existing_.
+ */
+template <typename KeyType, typename Compare, typename Options>
+template <typename Probe>
+typename RedBlackTree<KeyType, Compare, Options>::InsertPosition
+RedBlackTree<KeyType, Compare, Options>::Locate(const Probe &probe,
+                                                bool check_duplicates) {
+  InsertPosition position{&head_, nullptr, true, true, nullptr};
+  RedBlackTreeNode *current = head_.parent();
+  // Последний узел, от которого спуск свернул вправо (его ключ <= нового).
+  RedBlackTreeNode *not_greater = nullptr;
+  size_type depth = 0;
+
+  while (current != nullptr) {
+    ++depth;
+    position.parent_ = current;
+    // Знак сравнения нового ключа с ключом узла; 0 - дубликат.
+    int order = 0;
+    if constexpr (kThreeWay) {
+      order = check_duplicates ? ThreeWay(probe, current->key_)
+                               : (Less(probe, current->key_) ? -1 : 1);
+    } else {
+      order = Less(probe, current->key_) ? -1 : 1;
+      if constexpr (kArithmeticKey) {
+        not_greater = order > 0 ? current : not_greater;
+      } else if (order > 0 && check_duplicates &&
+                 !Less(current->key_, probe)) {
+        order = 0;
       }
     }
+    if (order == 0) {
+      stats_.Descent(depth);
+      position.existing_ = current;
+      return position;
+    }
+    const bool go_right = order > 0;
+    position.leftmost_ = position.leftmost_ && !go_right;
+    position.rightmost_ = position.rightmost_ && go_right;
+    position.link_ = go_right ? &current->right_ : &current->left_;
+    current = *position.link_;
+  }
+  stats_.Descent(depth);
+
+  if constexpr (kArithmeticKey) {
+    if (check_duplicates && not_greater != nullptr &&
+        !Less(not_greater->key_, probe)) {
+      position.existing_ = not_greater;
+    }
   }
+  return position;
 }
 
 /**
- * @brief Перемещается к левому дочернему узлу заданного узла.
+ * @brief Подвешивает новый узел в найденное Locate место и балансирует
+ * дерево.
  *
- * @param node Узел, для которого нужно найти левого потомка.
- * @return Указатель на левого потомка заданного узла.
+ * @param position Место вставки без дубликата.
+ * @param node Новый узел.
+ * @return Итератор на вставленный узел.
  */
-template <typename KeyType, typename Comparator>
-typename RedBlackTree<KeyType, Comparator>::RedBlackTreeNode *
-RedBlackTree<KeyType, Comparator>::GoLeft(
-    typename RedBlackTree<KeyType, Comparator>::RedBlackTreeNode *node)
-    const noexcept {
-  return node->left_;
+template <typename KeyType, typename Compare, typename Options>
+typename RedBlackTree<KeyType, Compare, Options>::iterator
+RedBlackTree<KeyType, Compare, Options>::Link(const InsertPosition &position,
+                                              RedBlackTreeNode *node) noexcept {
+  node->set_parent(position.parent_);
+  if (position.link_ == nullptr) {
+    // Дерево было пустым: узел становится черным корнем.
+    node->set_color(BLACK);
+    head_.set_parent(node);
+    head_.left_ = node;
+    head_.right_ = node;
+  } else {
+    *position.link_ = node;
+    if (position.leftmost_) {
+      head_.left_ = node;
+    }
+    if (position.rightmost_) {
+      head_.right_ = node;
+    }
+  }
+  LinkThread(node);
+
+  ++size_;
+  TreeAlgorithms::BalanceAfterInsert(&head_, node, stats_);
+  return iterator(node);
 }
 
 /**
- * @brief Перемещается к правому дочернему узлу заданного узла.
+ * @brief Вставляет новый узел в красно-черное дерево.
  *
- * @param node Узел, для которого нужно найти правого потомка.
- * @return Указатель на правого потомка заданного узла.
+ * @param newNnode Новый узел для вставки.
+ * @param check_duplicates Если true, то вставляются только уникальные ключи.
+ * @return Пара, содержащая итератор на вставленный узел и флаг, указывающий на
+ * успешность вставки.
  */
-template <typename KeyType, typename Comparator>
-typename RedBlackTree<KeyType, Comparator>::RedBlackTreeNode *
-RedBlackTree<KeyType, Comparator>::GoRight(
-    typename RedBlackTree<KeyType, Comparator>::RedBlackTreeNode *node)
-    const noexcept {
-  return node->right_;
+template <typename KeyType, typename Compare, typename Options>
+std::pair<typename RedBlackTree<KeyType, Compare, Options>::iterator, bool>
+RedBlackTree<KeyType, Compare, Options>::Insert(RedBlackTreeNode *newNnode,
+                                                bool check_duplicates) {
+  const InsertPosition position = Locate(newNnode->key_, check_duplicates);
+  if (position.existing_ != nullptr) {
+    // Уже существующий ключ.
+    return {iterator(position.existing_), false};
+  }
+  return {Link(position, newNnode), true};
 }
 
 /**
- * @brief Ищет узел с минимальным ключом, начиная с заданного узла.
+ * @brief Сравнивает два ключа компаратором дерева и учитывает сравнение в
+ * счетчиках.
+ *
+ * Один из аргументов может быть не ключом, а пробой TryConstruct.
  *
- * @param node Узел, с которого начинается поиск.
- * @return Указатель на узел с минимальным ключом.
+ * @param lhs Левый ключ.
+ * @param rhs Правый ключ.
+ * @return `true`, если lhs меньше rhs.
  */
-template <typename KeyType, typename Comparator>
-typename RedBlackTree<KeyType, Comparator>::RedBlackTreeNode *
-RedBlackTree<KeyType, Comparator>::SearchMinimum(
-    typename RedBlackTree<KeyType, Comparator>::RedBlackTreeNode *node)
-    const noexcept {
-  while (GoLeft(node) != nullptr) {
-    node = GoLeft(node);
-  };
-  return node;
+template <typename KeyType, typename Comparator, typename Options>
+template <typename Lhs, typename Rhs>
+bool RedBlackTree<KeyType, Comparator, Options>::Less(const Lhs &lhs,
+                                                      const Rhs &rhs) const {
+  stats_.Compare();
+  if constexpr (TreeComparison<KeyType, Comparator>::ordering) {
+    return key_comparator_(lhs, rhs) < 0;
+  } else {
+    return key_comparator_(lhs, rhs);
+  }
 }
 
 /**
- * @brief Ищет узел с максимальным ключом, начиная с заданного узла.
+ * @brief Трехстороннее сравнение ключей с учетом в счетчиках.
  *
- * @param node Узел, с которого начинается поиск.
- * @return Указатель на узел с максимальным ключом.
+ * Использует компаратор, возвращающий std::strong_ordering или
+ * std::weak_ordering, либо оператор <=> ключа при стандартном компараторе.
+ * Без поддержки C++20 сводится к двум вызовам Less().
+ *
+ * @param lhs Левый ключ.
+ * @param rhs Правый ключ.
+ * @return Отрицательное число, ноль или положительное число, если lhs
+ * соответственно меньше, эквивалентен или больше rhs.
  */
-template <typename KeyType, typename Comparator>
-typename RedBlackTree<KeyType, Comparator>::RedBlackTreeNode *
-RedBlackTree<KeyType, Comparator>::SearchMaximum(
-    typename RedBlackTree<KeyType, Comparator>::RedBlackTreeNode *node)
-    const noexcept {
-  while (GoRight(node) != nullptr) {
-    node = GoRight(node);
-  };
-  return node;
+template <typename KeyType, typename Comparator, typename Options>
+template <typename Lhs, typename Rhs>
+int RedBlackTree<KeyType, Comparator, Options>::ThreeWay(const Lhs &lhs,
+                                                         const Rhs &rhs) const {
+#if S21_CONTAINERS_THREE_WAY
+  if constexpr (TreeComparison<KeyType, Comparator>::ordering) {
+    stats_.Compare();
+    const auto order = key_comparator_(lhs, rhs);
+    return static_cast<int>(order > 0) - static_cast<int>(order < 0);
+  } else if constexpr (TreeComparison<KeyType, Comparator>::spaceship) {
+    stats_.Compare();
+    const auto order = lhs <=> rhs;
+    return static_cast<int>(order > 0) - static_cast<int>(order < 0);
+  }
+#endif
+  return static_cast<int>(Less(rhs, lhs)) - static_cast<int>(Less(lhs, rhs));
+}
+
+/**
+ * @brief Извлекает узел из дерева по заданному итератору и выполняет
+ * необходимые действия.
+ *
+ * @param position Итератор, указывающий на узел, который нужно извлечь.
+ * @return Указатель на извлеченный узел или nullptr, если итератор указывает на
+ * конец дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename RedBlackTree<Key, Comparator, Options>::RedBlackTreeNode *
+RedBlackTree<Key, Comparator, Options>::ExtractNode(
+    iterator position) noexcept {
+  if (position == End()) {
+    return nullptr;
+  }
+  RedBlackTreeNode *deleted_node = position.node_;
+  ForgetNode(deleted_node);
+  UnlinkThread(deleted_node);
+  // Исключаем узел с балансировкой и обновляем связи фиктивного узла head.
+  TreeAlgorithms::Erase(&head_, deleted_node, stats_);
+  // Уменьшаем размер дерева и обнуляем данные узла.
+  --size_;
+  deleted_node->ToDefault();
+  return deleted_node;
 }
 
 /**
@@ -1279,8 +2804,8 @@ RedBlackTree<KeyType, Comparator>::SearchMaximum(
  * @param node Узел, с которого начинается вычисление.
  * @return Черная высота поддерева, если она корректна; -1, если есть нарушение.
  */
-template <typename KeyType, typename Compare>
-int RedBlackTree<KeyType, Compare>::ComputeBlackHeight(
+template <typename KeyType, typename Compare, typename Options>
+int RedBlackTree<KeyType, Compare, Options>::ComputeBlackHeight(
     const RedBlackTreeNode *node) const noexcept {
   // Базовый случай: пустое поддерево имеет черную высоту 0
   if (node == nullptr) {
@@ -1298,7 +2823,34 @@ int RedBlackTree<KeyType, Compare>::ComputeBlackHeight(
   }
 
   // Возвращаем черную высоту текущего узла, добавляя 1, если он черный
-  return left_height + (node->color_ == BLACK ? 1 : 0);
+  return left_height + (node->color() == BLACK ? 1 : 0);
+}
+
+/**
+ * @brief Проверяет, что агрегаты поддерева совпадают с пересчитанными по
+ * его элементам.
+ *
+ * @param node Корень поддерева.
+ * @return true, если все агрегаты поддерева верны.
+ */
+template <typename Key, typename Comparator, typename Options>
+bool RedBlackTree<Key, Comparator, Options>::CheckAggregates(
+    const RedBlackTreeNode *node) noexcept {
+  if (node == nullptr) {
+    return true;
+  }
+  if (!CheckAggregates(node->left_) || !CheckAggregates(node->right_)) {
+    return false;
+  }
+  using Policy = typename Options::aggregate;
+  aggregate_type expected = Policy::Lift(node->key_);
+  if (node->left_ != nullptr) {
+    expected = Policy::Combine(node->left_->aggregate_, expected);
+  }
+  if (node->right_ != nullptr) {
+    expected = Policy::Combine(expected, node->right_->aggregate_);
+  }
+  return expected == node->aggregate_;
 }
 
 /**
@@ -1308,8 +2860,8 @@ int RedBlackTree<KeyType, Compare>::ComputeBlackHeight(
  * @param Node Узел, с которого начинается проверка.
  * @return true, если раскраска корректна; false, если есть нарушение.
  */
-template <typename KeyType, typename Compare>
-bool RedBlackTree<KeyType, Compare>::checkRedNodes(
+template <typename KeyType, typename Compare, typename Options>
+bool RedBlackTree<KeyType, Compare, Options>::checkRedNodes(
     const RedBlackTreeNode *Node) const noexcept {
   // Базовый случай: пустое поддерево имеет корректную раскраску
   if (Node == nullptr) {
@@ -1317,9 +2869,9 @@ bool RedBlackTree<KeyType, Compare>::checkRedNodes(
   }
 
   // Если текущий узел красный, проверяем, чтобы его дети были черными
-  if (Node->color_ == RED) {
-    if ((Node->left_ != nullptr && Node->left_->color_ == RED) ||
-        (Node->right_ != nullptr && Node->right_->color_ == RED)) {
+  if (Node->color() == RED) {
+    if ((Node->left_ != nullptr && Node->left_->color() == RED) ||
+        (Node->right_ != nullptr && Node->right_->color() == RED)) {
       return false;
     }
   }
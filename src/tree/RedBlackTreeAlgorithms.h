@@ -0,0 +1,142 @@
+#ifndef S21_CONTAINERS_TREE_REDBLACKTREEALGORITHMS_H_
+#define S21_CONTAINERS_TREE_REDBLACKTREEALGORITHMS_H_
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+enum Color : unsigned char { BLACK, RED };
+
+// Структурные связи узла красно-черного дерева: родитель, потомки, цвет и
+// один служебный флаг, которым распоряжается владелец узла. Родитель и цвет
+// доступны только через методы, чтобы алгоритмы не зависели от раскладки.
+//
+// Обычная раскладка хранит цвет и флаг отдельными байтами после указателей;
+// поля узла-наследника, выровненные не строже 4 байт, занимают хвостовое
+// выравнивание. Компактная раскладка упаковывает цвет и флаг в младшие биты
+// указателя на родителя: узлы выровнены как минимум на 4 байта, поэтому у
+// настоящих адресов эти биты нулевые, и связи занимают ровно три указателя.
+template <typename Node, bool Compact = false> struct TreeNodeLinks {
+  Node *parent() const noexcept { return parent_; }
+  void set_parent(Node *parent) noexcept { parent_ = parent; }
+  Color color() const noexcept { return color_; }
+  void set_color(Color color) noexcept { color_ = color; }
+  bool flag() const noexcept { return flag_; }
+  void set_flag(bool flag) noexcept { flag_ = flag; }
+
+  Node *left_ = nullptr;
+  Node *right_ = nullptr;
+
+private:
+  Node *parent_ = nullptr;
+  Color color_ = RED;
+  bool flag_ = false;
+};
+
+template <typename Node> struct TreeNodeLinks<Node, true> {
+  Node *parent() const noexcept {
+    static_assert(alignof(Node) >= 4,
+                  "Компактной раскладке нужны два свободных младших бита");
+    return reinterpret_cast<Node *>(bits_ & ~kTagMask);
+  }
+  void set_parent(Node *parent) noexcept {
+    bits_ = reinterpret_cast<std::uintptr_t>(parent) | (bits_ & kTagMask);
+  }
+  Color color() const noexcept { return static_cast<Color>(bits_ & kRedBit); }
+  void set_color(Color color) noexcept {
+    bits_ = (bits_ & ~kRedBit) | static_cast<std::uintptr_t>(color);
+  }
+  bool flag() const noexcept { return (bits_ & kFlagBit) != 0; }
+  void set_flag(bool flag) noexcept {
+    bits_ = (bits_ & ~kFlagBit) | (flag ? kFlagBit : 0);
+  }
+
+  Node *left_ = nullptr;
+  Node *right_ = nullptr;
+
+private:
+  static constexpr std::uintptr_t kRedBit = 1;
+  static constexpr std::uintptr_t kFlagBit = 2;
+  static constexpr std::uintptr_t kTagMask = kRedBit | kFlagBit;
+  static_assert(static_cast<std::uintptr_t>(RED) == kRedBit &&
+                    static_cast<std::uintptr_t>(BLACK) == 0,
+                "Цвет хранится одним битом");
+
+  // Указатель на родителя с цветом в бите 0 и флагом в бите 1
+  std::uintptr_t bits_ = kRedBit;
+};
+
+// Узел хранит агрегат поддерева, если у него есть метод UpdateAggregate()
+// (см. TreeAggregateData).
+template <typename Node, typename = void>
+struct HasSubtreeAggregate : std::false_type {};
+
+template <typename Node>
+struct HasSubtreeAggregate<
+    Node, std::void_t<decltype(std::declval<Node &>().UpdateAggregate())>>
+    : std::true_type {};
+
+// Обход и балансировка красно-черного дерева только по связям узлов, без
+// обращения к ключам. Node - наследник TreeNodeLinks<Node, ...> с любой
+// раскладкой связей. Дерево задается фиктивным узлом head:
+// head->parent() - корень (родитель корня - head), head->left_ - минимум,
+// head->right_ - максимум; у пустого дерева head->parent() == nullptr, а
+// head->left_ и head->right_ указывают на сам head. Фиктивный узел красный,
+// по этому и по связи с корнем его отличают обходы.
+//
+// Алгоритмы общие для RedBlackTree и интрузивных контейнеров, узлы которых
+// встроены в сами объекты. Stats - счетчики горячего пути
+// (StatsCounters<...>): балансировка сообщает им о поворотах и перекрасках.
+// Если узел хранит агрегат поддерева, вставка, удаление и повороты
+// пересчитывают агрегаты затронутых узлов; для остальных узлов этот код не
+// компилируется.
+template <typename Node> struct RedBlackTreeAlgorithms {
+  // Обход по порядку ключей
+  static Node *NextNode(const Node *node) noexcept;
+  static Node *PrevNode(const Node *node) noexcept;
+  static Node *Minimum(Node *node) noexcept;
+  static Node *Maximum(Node *node) noexcept;
+
+  // Балансировка
+  template <typename Stats>
+  static bool BalanceAfterInsert(Node *head, Node *node,
+                                 const Stats &stats) noexcept;
+  template <typename Stats>
+  static void Erase(Node *head, Node *node, const Stats &stats) noexcept;
+  template <typename Stats>
+  static void Rotate(Node *head, Node *node, bool rotate_right,
+                     const Stats &stats) noexcept;
+
+  // Агрегаты поддеревьев
+  static void UpdateAggregates(Node *head, Node *node) noexcept;
+
+private:
+  template <typename Stats>
+  static void HandleInsertCase(Node *head, Node *&node, bool parent_is_left,
+                               const Stats &stats) noexcept;
+  template <typename Stats>
+  static void EraseBalancing(Node *head, Node *node,
+                             const Stats &stats) noexcept;
+  template <typename Stats>
+  static void HandleRedSibling(Node *head, Node *parent, Node *check_node,
+                               const Stats &stats) noexcept;
+  template <typename Stats>
+  static bool HandleBlackSiblingWithBlackChildren(Node *parent,
+                                                  Node *&check_node,
+                                                  const Stats &stats) noexcept;
+  template <typename Stats>
+  static void HandleBlackSiblingWithRedChild(Node *head, Node *parent,
+                                             Node *check_node,
+                                             const Stats &stats) noexcept;
+  static void SwapPositions(Node *head, Node *node, Node *survivor) noexcept;
+  static void UpdateParent(Node *head, Node *node, Node *new_node) noexcept;
+  static void Detach(Node *head, Node *node) noexcept;
+  static void SwapColors(Node *lhs, Node *rhs) noexcept;
+};
+
+} // namespace s21
+
+#include "RedBlackTreeAlgorithms.tpp"
+#endif // S21_CONTAINERS_TREE_REDBLACKTREEALGORITHMS_H_
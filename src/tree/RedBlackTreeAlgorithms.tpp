@@ -0,0 +1,537 @@
+#include "RedBlackTreeAlgorithms.h"
+
+namespace s21 {
+/**
+ * @brief Возвращает следующий по порядку узел.
+ *
+ * Для максимального узла возвращает фиктивный узел head, для head - минимум
+ * (у пустого дерева - сам head).
+ *
+ * @param node Текущий узел.
+ * @return Следующий узел.
+ */
+template <typename Node>
+Node *RedBlackTreeAlgorithms<Node>::NextNode(const Node *node) noexcept {
+  auto *current = const_cast<Node *>(node);
+  if (current->color() == RED && (current->parent() == nullptr ||
+                                  current->parent()->parent() == current)) {
+    current = current->left_;
+  } else if (current->right_ != nullptr) {
+    current = current->right_;
+
+    while (current->left_ != nullptr) {
+      current = current->left_;
+    }
+  } else {
+    Node *parent = current->parent();
+
+    while (current == parent->right_) {
+      current = parent;
+      parent = parent->parent();
+    }
+    if (current->right_ != parent) {
+      current = parent;
+    }
+  }
+
+  return current;
+}
+
+/**
+ * @brief Возвращает предыдущий по порядку узел.
+ *
+ * Для фиктивного узла head возвращает максимум (у пустого дерева - сам head).
+ *
+ * @param node Текущий узел.
+ * @return Предыдущий узел.
+ */
+template <typename Node>
+Node *RedBlackTreeAlgorithms<Node>::PrevNode(const Node *node) noexcept {
+  auto *current = const_cast<Node *>(node);
+
+  if (current->color() == RED && (current->parent() == nullptr ||
+                                  current->parent()->parent() == current)) {
+    current = current->right_;
+  } else if (current->left_ != nullptr) {
+    current = current->left_;
+    while (current->right_ != nullptr) {
+      current = current->right_;
+    }
+  } else {
+    Node *parent = current->parent();
+    while (current == parent->left_) {
+      current = parent;
+      parent = parent->parent();
+    }
+    if (current->left_ != parent) {
+      current = parent;
+    }
+  }
+
+  return current;
+}
+
+/**
+ * @brief Находит минимальный узел поддерева.
+ *
+ * @param node Корень непустого поддерева.
+ * @return Самый левый узел поддерева.
+ */
+template <typename Node>
+Node *RedBlackTreeAlgorithms<Node>::Minimum(Node *node) noexcept {
+  while (node->left_ != nullptr) {
+    node = node->left_;
+  }
+  return node;
+}
+
+/**
+ * @brief Находит максимальный узел поддерева.
+ *
+ * @param node Корень непустого поддерева.
+ * @return Самый правый узел поддерева.
+ */
+template <typename Node>
+Node *RedBlackTreeAlgorithms<Node>::Maximum(Node *node) noexcept {
+  while (node->right_ != nullptr) {
+    node = node->right_;
+  }
+  return node;
+}
+
+/**
+ * @brief Выполняет балансировку красно-черного дерева после вставки нового
+ * узла. Метод проверяет и корректирует баланс дерева, чтобы сохранить его
+ * свойства.
+ *
+ * Агрегаты поддеревьев (если они есть) пересчитываются от узла до корня.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Узел, который был только что вставлен в дерево (красный).
+ * @param stats Счетчики поворотов и перекрасок.
+ * @return `true`, если корень пришлось перекрасить из красного в черный, то
+ * есть черная высота дерева выросла на единицу.
+ */
+template <typename Node>
+template <typename Stats>
+bool RedBlackTreeAlgorithms<Node>::BalanceAfterInsert(
+    Node *head, Node *node, const Stats &stats) noexcept {
+  // Новый узел меняет агрегаты всех предков; дальше их поддерживают
+  // повороты.
+  UpdateAggregates(head, node);
+  while (node != head->parent() && node->parent()->color() == RED) {
+    // Родитель слева или справа от дедушки - зеркальные случаи.
+    HandleInsertCase(head, node,
+                     node->parent()->parent()->left_ == node->parent(), stats);
+  }
+
+  if (head->parent()->color() == BLACK) {
+    return false;
+  }
+  stats.Recolor();
+  head->parent()->set_color(BLACK); // Корень всегда должен быть черным.
+  return true;
+}
+
+/**
+ * @brief Обрабатывает красного родителя вставленного узла.
+ *
+ * Если дядя красный, родитель и дядя перекрашиваются в черный, а дедушка -
+ * в красный, и проверка продолжается с дедушки. Иначе узел, его родитель и
+ * дедушка образуют "зигзаг" или прямую, которые исправляются одним или двумя
+ * поворотами.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Узел с красным родителем. В случае красного дяди заменяется
+ * дедушкой, с которого продолжается балансировка.
+ * @param parent_is_left Родитель - левый ребенок дедушки.
+ * @param stats Счетчики поворотов и перекрасок.
+ */
+template <typename Node>
+template <typename Stats>
+void RedBlackTreeAlgorithms<Node>::HandleInsertCase(
+    Node *head, Node *&node, bool parent_is_left, const Stats &stats) noexcept {
+  Node *parent = node->parent();
+  Node *gparent = parent->parent();
+  Node *uncle = parent_is_left ? gparent->right_ : gparent->left_;
+
+  if (uncle != nullptr && uncle->color() == RED) {
+    parent->set_color(BLACK); // Родитель и дядя становятся черными.
+    uncle->set_color(BLACK);
+    gparent->set_color(RED); // Дедушка становится красным.
+    stats.Recolor(3);
+    node = gparent; // Дедушка стал красным, продолжаем проверку выше.
+  } else {
+    // Узел внутри "зигзага": поворачиваем родителя, чтобы выпрямить его.
+    if ((parent_is_left ? parent->right_ : parent->left_) == node) {
+      Rotate(head, parent, !parent_is_left, stats);
+      std::swap(parent, node); // Меняем местами узел и родителя.
+    }
+    Rotate(head, gparent, parent_is_left, stats);
+    SwapColors(parent, gparent);
+    stats.Recolor(2);
+  }
+}
+
+/**
+ * @brief Выполняет операцию вращения узла влево или вправо.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Узел, который будет вращаться.
+ * @param rotate_right Если true, выполняется вращение вправо, иначе - влево.
+ * @param stats Счетчики поворотов.
+ */
+template <typename Node>
+template <typename Stats>
+void RedBlackTreeAlgorithms<Node>::Rotate(Node *head, Node *node,
+                                          bool rotate_right,
+                                          const Stats &stats) noexcept {
+  stats.Rotate();
+  Node *pivot = rotate_right ? node->left_ : node->right_;
+
+  Node *parent_before_rotation = node->parent();
+
+  if (node == head->parent()) {
+    head->set_parent(pivot); // Обновляем корень дерева.
+  } else if (parent_before_rotation->left_ == node) {
+    parent_before_rotation->left_ = pivot;
+  } else {
+    parent_before_rotation->right_ = pivot;
+  }
+
+  pivot->set_parent(parent_before_rotation);
+
+  if (rotate_right) {
+    // Вращение вправо.
+    node->left_ = pivot->right_;
+    if (pivot->right_ != nullptr) {
+      pivot->right_->set_parent(node);
+    }
+    pivot->right_ = node;
+  } else {
+    // Вращение влево.
+    node->right_ = pivot->left_;
+    if (pivot->left_ != nullptr) {
+      pivot->left_->set_parent(node);
+    }
+    pivot->left_ = node;
+  }
+
+  node->set_parent(pivot);
+
+  // Поменялись поддеревья только у node и pivot; node теперь ребенок.
+  if constexpr (HasSubtreeAggregate<Node>::value) {
+    node->UpdateAggregate();
+    pivot->UpdateAggregate();
+  }
+}
+
+/**
+ * @brief Пересчитывает агрегаты поддеревьев от узла до корня.
+ *
+ * Для узлов без агрегата ничего не делает.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Нижний узел пути.
+ */
+template <typename Node>
+void RedBlackTreeAlgorithms<Node>::UpdateAggregates(Node *head,
+                                                    Node *node) noexcept {
+  if constexpr (HasSubtreeAggregate<Node>::value) {
+    for (; node != head; node = node->parent()) {
+      node->UpdateAggregate();
+    }
+  }
+}
+
+/**
+ * @brief Исключает узел из дерева с сохранением его свойств.
+ *
+ * Узел с двумя потомками сначала меняется местами с минимальным узлом
+ * правого поддерева, после чего у него остается не больше одного потомка.
+ * Черный узел с одним потомком меняется местами с этим (красным) потомком,
+ * а черный лист перед удалением балансирует дерево. После этого узел -
+ * лист, и он отсоединяется от родителя. Ключи при этом не перемещаются:
+ * меняются только связи, поэтому указатели на остальные узлы остаются
+ * действительными. Затем агрегаты поддеревьев (если они есть)
+ * пересчитываются от бывшего родителя листа до корня.
+ *
+ * Связи самого узла после вызова не определены.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Удаляемый узел.
+ * @param stats Счетчики поворотов и перекрасок.
+ */
+template <typename Node>
+template <typename Stats>
+void RedBlackTreeAlgorithms<Node>::Erase(Node *head, Node *node,
+                                         const Stats &stats) noexcept {
+  // Если есть оба потомка, меняем узел с наименьшим в правом поддереве.
+  if (node->left_ != nullptr && node->right_ != nullptr) {
+    SwapPositions(head, node, Minimum(node->right_));
+  }
+  if (node->color() == BLACK) {
+    if ((node->left_ != nullptr) != (node->right_ != nullptr)) {
+      // У удаляемого узла есть один потомок. Заменяем его потомком.
+      SwapPositions(head, node,
+                    node->left_ != nullptr ? node->left_ : node->right_);
+    } else if (node->left_ == nullptr) {
+      // У удаляемого узла нет потомков. Балансируем дерево.
+      EraseBalancing(head, node, stats);
+    }
+  }
+  Node *parent = node->parent();
+  Detach(head, node);
+  // Все узлы с устаревшими агрегатами - предки удаленного листа: перестановки
+  // и повороты меняют поддеревья только тех узлов, которые сами
+  // пересчитывают.
+  if (parent != head) {
+    UpdateAggregates(head, parent);
+  }
+}
+
+/**
+ * @brief Отсоединяет лист от родителя и обновляет фиктивный узел.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Удаляемый лист.
+ */
+template <typename Node>
+void RedBlackTreeAlgorithms<Node>::Detach(Node *head, Node *node) noexcept {
+  if (node == head->parent()) {
+    // Удаляется последний узел: дерево становится пустым.
+    head->set_parent(nullptr);
+    head->left_ = head;
+    head->right_ = head;
+    return;
+  }
+  Node *parent = node->parent();
+  if (node == parent->left_) {
+    parent->left_ = nullptr;
+  } else {
+    parent->right_ = nullptr;
+  }
+
+  // Обновляем ссылки head на самый левый и самый правый узлы, если они были
+  // удалены.
+  if (head->left_ == node) {
+    head->left_ = Minimum(head->parent());
+  }
+  if (head->right_ == node) {
+    head->right_ = Maximum(head->parent());
+  }
+}
+
+/**
+ * @brief Меняет местами положение двух узлов в дереве вместе с цветами.
+ *
+ * Узлы могут быть родителем и ребенком.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Первый узел (удаляемый).
+ * @param survivor Второй узел, который займет место первого.
+ */
+template <typename Node>
+void RedBlackTreeAlgorithms<Node>::SwapPositions(Node *head, Node *node,
+                                                 Node *survivor) noexcept {
+  if (node == survivor) {
+    return;
+  }
+
+  UpdateParent(head, node, survivor);
+  UpdateParent(head, survivor, node);
+
+  Node *parent = node->parent();
+  node->set_parent(survivor->parent());
+  survivor->set_parent(parent);
+  std::swap(node->left_, survivor->left_);
+  std::swap(node->right_, survivor->right_);
+  SwapColors(node, survivor);
+
+  if (node->left_) {
+    node->left_->set_parent(node);
+  }
+  if (node->right_) {
+    node->right_->set_parent(node);
+  }
+  if (survivor->left_) {
+    survivor->left_->set_parent(survivor);
+  }
+  if (survivor->right_) {
+    survivor->right_->set_parent(survivor);
+  }
+}
+
+/**
+ * @brief Заменяет у родителя узла ссылку на него ссылкой на другой узел.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Узел, ссылку на который нужно заменить.
+ * @param new_node Новый узел.
+ */
+template <typename Node>
+void RedBlackTreeAlgorithms<Node>::UpdateParent(Node *head, Node *node,
+                                                Node *new_node) noexcept {
+  if (node->parent() == head) {
+    head->set_parent(new_node);
+  } else if (node->parent()->left_ == node) {
+    node->parent()->left_ = new_node;
+  } else {
+    node->parent()->right_ = new_node;
+  }
+}
+
+/**
+ * @brief Восстанавливает черную высоту перед удалением черного листа.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param node Удаляемый черный лист.
+ * @param stats Счетчики поворотов и перекрасок.
+ */
+template <typename Node>
+template <typename Stats>
+void RedBlackTreeAlgorithms<Node>::EraseBalancing(Node *head, Node *node,
+                                                  const Stats &stats) noexcept {
+  Node *node_to_check = node;
+
+  // Пока проверяемый узел не достигнет корня и его цвет черный.
+  while (node_to_check != head->parent() && node_to_check->color() == BLACK) {
+    Node *parent_node = node_to_check->parent();
+    Node *sibling_node = (node_to_check == parent_node->left_)
+                             ? parent_node->right_
+                             : parent_node->left_;
+
+    // Если брат красный, выполняем балансировку для этой ситуации.
+    if (sibling_node->color() == RED) {
+      HandleRedSibling(head, parent_node, node_to_check, stats);
+      // Брат изменился после поворота.
+      sibling_node = (node_to_check == parent_node->left_) ? parent_node->right_
+                                                           : parent_node->left_;
+    }
+
+    // Если брат черный и у него также черные дети, выполняем балансировку.
+    if ((sibling_node->left_ == nullptr ||
+         sibling_node->left_->color() == BLACK) &&
+        (sibling_node->right_ == nullptr ||
+         sibling_node->right_->color() == BLACK)) {
+      if (HandleBlackSiblingWithBlackChildren(parent_node, node_to_check,
+                                              stats)) {
+        break;
+      }
+    } else {
+      // В противном случае, выполняем балансировку для черного брата с
+      // красным ребенком.
+      HandleBlackSiblingWithRedChild(head, parent_node, node_to_check, stats);
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Обрабатывает красного брата: поворот делает брата черным.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param parent Родитель проверяемого узла.
+ * @param check_node Проверяемый узел.
+ * @param stats Счетчики поворотов и перекрасок.
+ */
+template <typename Node>
+template <typename Stats>
+void RedBlackTreeAlgorithms<Node>::HandleRedSibling(
+    Node *head, Node *parent, Node *check_node, const Stats &stats) noexcept {
+  const bool is_left = check_node == parent->left_;
+  Node *sibling = is_left ? parent->right_ : parent->left_;
+  SwapColors(sibling, parent);
+  stats.Recolor(2);
+
+  // Поворачиваем родительский узел влево или вправо в зависимости от позиции
+  // проверяемого узла.
+  Rotate(head, parent, !is_left, stats);
+}
+
+/**
+ * @brief Обрабатывает черного брата с черными детьми: брат перекрашивается
+ * в красный.
+ *
+ * @param parent Родитель проверяемого узла.
+ * @param check_node Проверяемый узел; если балансировка продолжается,
+ * заменяется родителем.
+ * @param stats Счетчики перекрасок.
+ * @return `true`, если красный родитель стал черным и балансировка
+ * закончена.
+ */
+template <typename Node>
+template <typename Stats>
+bool RedBlackTreeAlgorithms<Node>::HandleBlackSiblingWithBlackChildren(
+    Node *parent, Node *&check_node, const Stats &stats) noexcept {
+  Node *sibling =
+      (check_node == parent->left_) ? parent->right_ : parent->left_;
+  sibling->set_color(RED);
+  stats.Recolor();
+
+  // Если цвет родителя красный, то меняем цвет родителя на черный и
+  // завершаем обработку.
+  if (parent->color() == RED) {
+    parent->set_color(BLACK);
+    stats.Recolor();
+    return true;
+  }
+
+  // Переопределяем проверяемый узел для продолжения балансировки вверх по
+  // дереву.
+  check_node = parent;
+  return false;
+}
+
+/**
+ * @brief Обрабатывает черного брата с красным ребенком: один или два
+ * поворота завершают балансировку.
+ *
+ * @param head Фиктивный узел дерева.
+ * @param parent Родитель проверяемого узла.
+ * @param check_node Проверяемый узел.
+ * @param stats Счетчики поворотов и перекрасок.
+ */
+template <typename Node>
+template <typename Stats>
+void RedBlackTreeAlgorithms<Node>::HandleBlackSiblingWithRedChild(
+    Node *head, Node *parent, Node *check_node, const Stats &stats) noexcept {
+  const bool is_left = check_node == parent->left_;
+  Node *sibling = is_left ? parent->right_ : parent->left_;
+  Node *far_child = is_left ? sibling->right_ : sibling->left_;
+
+  // Дальний ребенок брата черный - значит, красный ближний. Поворачиваем
+  // брата, чтобы красный ребенок оказался дальним.
+  if (far_child == nullptr || far_child->color() == BLACK) {
+    Node *near_child = is_left ? sibling->left_ : sibling->right_;
+    SwapColors(sibling, near_child);
+    stats.Recolor(2);
+    Rotate(head, sibling, is_left, stats);
+    far_child = sibling;
+    sibling = near_child;
+  }
+
+  sibling->set_color(parent->color());
+  parent->set_color(BLACK);
+  far_child->set_color(BLACK);
+  stats.Recolor(3);
+
+  // Поворачиваем родительский узел влево или вправо в зависимости от позиции
+  // проверяемого узла.
+  Rotate(head, parent, !is_left, stats);
+}
+
+/**
+ * @brief Обменивает цвета двух узлов.
+ *
+ * @param lhs Первый узел.
+ * @param rhs Второй узел.
+ */
+template <typename Node>
+void RedBlackTreeAlgorithms<Node>::SwapColors(Node *lhs, Node *rhs) noexcept {
+  const Color color = lhs->color();
+  lhs->set_color(rhs->color());
+  rhs->set_color(color);
+}
+
+} // namespace s21
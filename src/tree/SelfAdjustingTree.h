@@ -0,0 +1,359 @@
+#ifndef S21_CONTAINERS_TREE_SELFADJUSTINGTREE_H_
+#define S21_CONTAINERS_TREE_SELFADJUSTINGTREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../stats/ContainerStats.h"
+#include "RedBlackTree.h"
+#include "RedBlackTreeAlgorithms.h"
+
+namespace s21 {
+
+// Параметры деревьев, которые подстраиваются под частые обращения.
+struct SplayTreeOptions : DefaultTreeOptions {
+  static constexpr TreeBackend backend = TreeBackend::kSplay;
+};
+
+struct TreapTreeOptions : DefaultTreeOptions {
+  static constexpr TreeBackend backend = TreeBackend::kTreap;
+};
+
+struct FrequencyTreapTreeOptions : DefaultTreeOptions {
+  static constexpr TreeBackend backend = TreeBackend::kFrequencyTreap;
+};
+
+// Приоритет узла декартова дерева. У косого дерева база пустая и не
+// увеличивает размер узла; у декартова 32-битный приоритет занимает
+// хвостовое выравнивание связей.
+template <bool Treap> struct TreapPriority {};
+
+template <> struct TreapPriority<true> {
+  std::uint32_t priority_ = 0;
+};
+
+// Двоичное дерево поиска с уникальными ключами, которое перестраивается
+// под распределение обращений, а не держит высоту O(log n) при любых
+// запросах. Вид дерева задает Options::backend:
+//   kSplay - косое дерево: найденный (или последний пройденный) узел
+//     поворотами поднимается в корень, поэтому недавно запрошенные ключи
+//     лежат у корня; любая последовательность из m операций стоит
+//     O(m log n) амортизированно.
+//   kTreap - декартово дерево со случайными приоритетами: ожидаемая
+//     глубина O(log n), поиск дерево не меняет.
+//   kFrequencyTreap - декартово дерево, у которого приоритет узла растет с
+//     каждым найденным обращением к нему: старшие биты приоритета - счетчик
+//     обращений, младшие - случайные. Частые ключи всплывают к корню.
+//
+// Интерфейс - та часть интерфейса RedBlackTree, на которой стоят map и set:
+// вставка, поиск, границы, удаление, обход, обмен и счетчики. Слияние
+// деревьев за O(n + m), извлечение узлов, агрегаты, уплотнение узлов
+// (Compact) и параметры раскладки узла (threaded, compact, aggregate) есть
+// только у красно-черного дерева.
+//
+// Поиск в косом и частотном декартовом дереве меняет форму дерева даже
+// через константные методы (фиктивный узел и узлы для этого изменяемые),
+// поэтому читать такое дерево из нескольких потоков без блокировки нельзя.
+// Итераторы и ссылки на элементы перестройка не затрагивает.
+template <typename Key, typename Comparator = std::less<Key>,
+          typename Options = SplayTreeOptions>
+class SelfAdjustingTree {
+private:
+  struct Node;
+  struct Iterator;
+  struct ConstIterator;
+  union HeadStorage;
+  struct InsertPosition;
+
+  static constexpr bool kSplay = Options::backend == TreeBackend::kSplay;
+  static constexpr bool kFrequency =
+      Options::backend == TreeBackend::kFrequencyTreap;
+  static constexpr bool kTreap =
+      Options::backend == TreeBackend::kTreap || kFrequency;
+  // Спуск отличает "меньше", "равно" и "больше" одним сравнением (C++20).
+  static constexpr bool kThreeWay =
+      TreeComparison<Key, Comparator>::ordering ||
+      TreeComparison<Key, Comparator>::spaceship;
+
+  static_assert(kSplay || kTreap,
+                "SelfAdjustingTree - косое или декартово дерево");
+  static_assert(!Options::threaded && !Options::compact &&
+                    std::is_same<typename Options::aggregate,
+                                 NoAggregate>::value,
+                "threaded, compact и aggregate есть только у RedBlackTree");
+
+public:
+  using key_type = Key;
+  using reference = key_type &;
+  using const_reference = const key_type &;
+  using key_arg_type = const key_type &;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+  using size_type = std::size_t;
+  using stats_type = StatsCounters<Options::stats>;
+  // Извлечения узлов у этих деревьев нет; типы объявлены, чтобы map и set
+  // с таким деревом компилировались, пока extract и insert(node) не
+  // вызываются.
+  struct NodeHandle;
+  struct NodeInsertResult;
+  using node_type = NodeHandle;
+  using insert_return_type = NodeInsertResult;
+  using aggregate_type = typename Options::aggregate::value_type;
+
+  // Конструкторы и деструктор
+  SelfAdjustingTree() noexcept;
+  SelfAdjustingTree(const SelfAdjustingTree &other);
+  SelfAdjustingTree(SelfAdjustingTree &&other) noexcept;
+  SelfAdjustingTree &operator=(const SelfAdjustingTree &other);
+  SelfAdjustingTree &operator=(SelfAdjustingTree &&other) noexcept;
+  ~SelfAdjustingTree();
+
+  // Вставка, поиск и удаление
+  std::pair<iterator, bool> InsertUnique(const key_type &key);
+  std::pair<iterator, bool> InsertUnique(key_type &&key);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> EmplaceUnique(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> ConstructUnique(Args &&...args);
+  template <typename Probe, typename... Args>
+  std::pair<iterator, bool> TryConstruct(const Probe &probe, Args &&...args);
+  iterator Find(key_arg_type key);
+  iterator LowerBound(key_arg_type key);
+  iterator UpperBound(key_arg_type key);
+  const_iterator Find(key_arg_type key) const;
+  const_iterator LowerBound(key_arg_type key) const;
+  const_iterator UpperBound(key_arg_type key) const;
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  iterator Find(const Probe &probe);
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  iterator LowerBound(const Probe &probe);
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  iterator UpperBound(const Probe &probe);
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  const_iterator Find(const Probe &probe) const;
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  const_iterator LowerBound(const Probe &probe) const;
+  template <typename Probe, EnableIfTreeProbe<Probe, Key> = 0>
+  const_iterator UpperBound(const Probe &probe) const;
+  void Erase(iterator position) noexcept;
+  iterator Erase(iterator first, iterator last) noexcept;
+  template <typename Predicate> size_type EraseIf(Predicate pred);
+
+  // Итераторы
+  iterator Begin() noexcept;
+  const_iterator Begin() const noexcept;
+  iterator End() noexcept;
+  const_iterator End() const noexcept;
+
+  // Размер, очистка, обмен и перенос узлов
+  void Clear() noexcept;
+  [[nodiscard]] size_type Size() const noexcept;
+  [[nodiscard]] bool Empty() const noexcept;
+  [[nodiscard]] size_type MaxSize() const noexcept;
+  void MergeUnique(SelfAdjustingTree &other);
+  void Swap(SelfAdjustingTree &other) noexcept;
+  [[nodiscard]] bool CheckTree() const noexcept;
+
+  // Агрегатов у этих деревьев нет; вызов ничего не делает
+  void UpdateAggregates(iterator position) noexcept;
+
+  // Счетчики горячего пути (заполнены только при Options::stats)
+  [[nodiscard]] ContainerStats Stats() const noexcept;
+  void ResetStats() noexcept;
+
+  // Память, занятая деревом вместе с узлами, в байтах
+  [[nodiscard]] size_type MemoryUsage() const noexcept;
+
+private:
+  // Из общих алгоритмов нужны только обход по связям и поворот; цвет
+  // отличает фиктивный узел (красный) от узлов с ключами (черных).
+  using TreeAlgorithms = RedBlackTreeAlgorithms<Node>;
+
+  // Счетчик обращений занимает старшие биты приоритета частотного
+  // декартова дерева, случайная добавка - младшие kRandomBits.
+  static constexpr unsigned kRandomBits = 12;
+  static constexpr std::uint32_t kHit = std::uint32_t{1} << kRandomBits;
+
+  struct Node : TreeNodeLinks<Node>, TreapPriority<kTreap> {
+    // Фиктивный узел: ключ не создается, связи задает InitializeHead().
+    Node() noexcept {}
+
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : key_(std::forward<Args>(args)...) {
+      this->set_color(BLACK);
+    }
+
+    Node(const Node &) = delete;
+    Node &operator=(const Node &) = delete;
+    ~Node() { key_.~key_type(); }
+
+    Node *NextNode() const noexcept { return TreeAlgorithms::NextNode(this); }
+    Node *PrevNode() const noexcept { return TreeAlgorithms::PrevNode(this); }
+
+    // Ключ в объединении: у фиктивного узла ключа нет.
+    union {
+      key_type key_;
+    };
+  };
+
+  // Место под фиктивный узел без ключа. Поиск перестраивает дерево и в
+  // константных методах, поэтому фиктивный узел (корень, минимум и
+  // максимум) изменяемый.
+  union HeadStorage {
+    HeadStorage() noexcept : node_() {}
+    ~HeadStorage() {}
+
+    Node node_;
+  };
+
+  struct Iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = SelfAdjustingTree::key_type;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    Iterator() = delete;
+
+    explicit Iterator(Node *node) : node_(node) {}
+
+    reference operator*() const noexcept { return node_->key_; }
+
+    Iterator &operator++() noexcept {
+      node_ = node_->NextNode();
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    Iterator &operator--() noexcept {
+      node_ = node_->PrevNode();
+      return *this;
+    }
+
+    Iterator operator--(int) noexcept {
+      Iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const Iterator &other) const noexcept {
+      return node_ == other.node_;
+    }
+
+    bool operator!=(const Iterator &other) const noexcept {
+      return node_ != other.node_;
+    }
+
+    Node *node_;
+  };
+
+  struct ConstIterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = SelfAdjustingTree::key_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    ConstIterator() = delete;
+
+    explicit ConstIterator(const Node *node) : node_(node) {}
+
+    ConstIterator(const Iterator &it) : node_(it.node_) {}
+
+    reference operator*() const noexcept { return node_->key_; }
+
+    ConstIterator &operator++() noexcept {
+      node_ = node_->NextNode();
+      return *this;
+    }
+
+    ConstIterator operator++(int) noexcept {
+      ConstIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    ConstIterator &operator--() noexcept {
+      node_ = node_->PrevNode();
+      return *this;
+    }
+
+    ConstIterator operator--(int) noexcept {
+      ConstIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const ConstIterator &lhs,
+                           const ConstIterator &rhs) noexcept {
+      return lhs.node_ == rhs.node_;
+    }
+
+    friend bool operator!=(const ConstIterator &lhs,
+                           const ConstIterator &rhs) noexcept {
+      return lhs.node_ != rhs.node_;
+    }
+
+    const Node *node_;
+  };
+
+  // Результат спуска по ключу: равный узел existing_ либо место вставки -
+  // родитель, ссылка на пустого потомка (nullptr для пустого дерева) и
+  // признаки нового минимума и максимума. Родитель - последний пройденный
+  // узел: его поднимает косое дерево, если ключа нет.
+  struct InsertPosition {
+    Node *parent_;
+    Node **link_;
+    bool leftmost_;
+    bool rightmost_;
+    Node *existing_;
+  };
+
+  Node *Head() const noexcept { return &head_.node_; }
+  Node *Root() const noexcept { return head_.node_.parent(); }
+  void InitializeHead() noexcept;
+  void RelinkHead() noexcept;
+  void CopyFrom(const SelfAdjustingTree &other);
+  Node *Clone(const Node *source);
+  void Destroy(Node *node) noexcept;
+
+  template <typename Probe> InsertPosition Locate(const Probe &probe);
+  template <typename Probe> iterator LocateEqual(const Probe &probe);
+  template <typename Probe> iterator LocateLower(const Probe &probe);
+  template <typename Probe> iterator LocateUpper(const Probe &probe);
+  iterator Link(const InsertPosition &position, Node *node) noexcept;
+  void Unlink(Node *node) noexcept;
+  void Touch(Node *node) noexcept;
+  void Splay(Node *node) noexcept;
+  void SiftUp(Node *node) noexcept;
+  std::uint32_t NewPriority() noexcept;
+
+  template <typename Lhs, typename Rhs>
+  bool Less(const Lhs &lhs, const Rhs &rhs) const;
+  template <typename Lhs, typename Rhs>
+  int ThreeWay(const Lhs &lhs, const Rhs &rhs) const;
+
+  mutable HeadStorage head_;
+  size_type size_ = 0;
+  Comparator key_comparator_;
+  // Состояние генератора случайных приоритетов (xorshift32)
+  std::uint32_t random_state_ = 2463534242u;
+  stats_type stats_;
+};
+
+} // namespace s21
+
+#include "SelfAdjustingTree.tpp"
+#endif // S21_CONTAINERS_TREE_SELFADJUSTINGTREE_H_
@@ -0,0 +1,1098 @@
+#include "SelfAdjustingTree.h"
+
+namespace s21 {
+
+/**
+ * @brief Создает пустое дерево без выделения памяти: фиктивный узел
+ * хранится в самом дереве.
+ */
+template <typename Key, typename Comparator, typename Options>
+SelfAdjustingTree<Key, Comparator, Options>::SelfAdjustingTree() noexcept {
+  InitializeHead();
+}
+
+/**
+ * @brief Копирует дерево вместе с его формой и приоритетами узлов.
+ *
+ * @param other Копируемое дерево.
+ */
+template <typename Key, typename Comparator, typename Options>
+SelfAdjustingTree<Key, Comparator, Options>::SelfAdjustingTree(
+    const SelfAdjustingTree &other)
+    : SelfAdjustingTree() {
+  key_comparator_ = other.key_comparator_;
+  CopyFrom(other);
+}
+
+/**
+ * @brief Забирает узлы другого дерева за O(1); other остается пустым.
+ *
+ * @param other Перемещаемое дерево.
+ */
+template <typename Key, typename Comparator, typename Options>
+SelfAdjustingTree<Key, Comparator, Options>::SelfAdjustingTree(
+    SelfAdjustingTree &&other) noexcept
+    : SelfAdjustingTree() {
+  Swap(other);
+}
+
+/**
+ * @brief Заменяет содержимое дерева копией other.
+ *
+ * @param other Копируемое дерево.
+ * @return Ссылка на текущее дерево.
+ */
+template <typename Key, typename Comparator, typename Options>
+SelfAdjustingTree<Key, Comparator, Options> &
+SelfAdjustingTree<Key, Comparator, Options>::operator=(
+    const SelfAdjustingTree &other) {
+  if (this != &other) {
+    Clear();
+    key_comparator_ = other.key_comparator_;
+    CopyFrom(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Освобождает текущие узлы и забирает узлы other.
+ *
+ * @param other Перемещаемое дерево.
+ * @return Ссылка на текущее дерево.
+ */
+template <typename Key, typename Comparator, typename Options>
+SelfAdjustingTree<Key, Comparator, Options> &
+SelfAdjustingTree<Key, Comparator, Options>::operator=(
+    SelfAdjustingTree &&other) noexcept {
+  Clear();
+  Swap(other);
+  return *this;
+}
+
+/**
+ * @brief Уничтожает все узлы дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+SelfAdjustingTree<Key, Comparator, Options>::~SelfAdjustingTree() {
+  Destroy(Root());
+}
+
+/**
+ * @brief Вставляет копию ключа, если такого ключа еще нет.
+ *
+ * @param key Ключ для вставки.
+ * @return Пара из итератора на элемент с этим ключом и флага вставки.
+ */
+template <typename Key, typename Comparator, typename Options>
+std::pair<typename SelfAdjustingTree<Key, Comparator, Options>::iterator, bool>
+SelfAdjustingTree<Key, Comparator, Options>::InsertUnique(
+    const key_type &key) {
+  return TryConstruct(key, key);
+}
+
+/**
+ * @brief Вставляет ключ перемещением, если такого ключа еще нет.
+ *
+ * Если ключ уже есть, key остается нетронутым.
+ *
+ * @param key Ключ для вставки.
+ * @return Пара из итератора на элемент с этим ключом и флага вставки.
+ */
+template <typename Key, typename Comparator, typename Options>
+std::pair<typename SelfAdjustingTree<Key, Comparator, Options>::iterator, bool>
+SelfAdjustingTree<Key, Comparator, Options>::InsertUnique(key_type &&key) {
+  return TryConstruct(key, std::move(key));
+}
+
+/**
+ * @brief Вставляет по одному элементу из каждого аргумента, пропуская уже
+ * существующие ключи.
+ *
+ * @param args Элементы (или аргументы их конструкторов) для вставки.
+ * @return Вектор пар из итератора и флага вставки для каждого аргумента.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename... Args>
+std::vector<std::pair<
+    typename SelfAdjustingTree<Key, Comparator, Options>::iterator, bool>>
+SelfAdjustingTree<Key, Comparator, Options>::EmplaceUnique(Args &&...args) {
+  std::vector<std::pair<iterator, bool>> results;
+  results.reserve(sizeof...(args));
+  (results.push_back(ConstructUnique(std::forward<Args>(args))), ...);
+  return results;
+}
+
+/**
+ * @brief Создает элемент прямо в новом узле и вставляет его, если такого
+ * ключа еще нет; иначе узел удаляется.
+ *
+ * @param args Аргументы конструктора элемента.
+ * @return Пара из итератора на элемент с этим ключом и флага вставки.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename... Args>
+std::pair<typename SelfAdjustingTree<Key, Comparator, Options>::iterator, bool>
+SelfAdjustingTree<Key, Comparator, Options>::ConstructUnique(Args &&...args) {
+  Node *node = new Node(std::in_place, std::forward<Args>(args)...);
+  stats_.Allocate();
+  InsertPosition position{};
+  try {
+    position = Locate(node->key_);
+  } catch (...) {
+    delete node;
+    stats_.Deallocate();
+    throw;
+  }
+  if (position.existing_ != nullptr) {
+    delete node;
+    stats_.Deallocate();
+    Touch(position.existing_);
+    return {iterator(position.existing_), false};
+  }
+  if constexpr (kTreap) {
+    node->priority_ = NewPriority();
+  }
+  return {Link(position, node), true};
+}
+
+/**
+ * @brief Создает элемент в новом узле, только если ключа probe в дереве нет.
+ *
+ * Найденный существующий элемент считается обращением: косое дерево
+ * поднимает его в корень, частотное декартово - увеличивает приоритет.
+ *
+ * @param probe Искомый ключ или объект, который компаратор сравнивает с
+ * ключами в обе стороны.
+ * @param args Аргументы конструктора элемента с ключом, равным probe.
+ * @return Пара из итератора на элемент с этим ключом и флага вставки.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, typename... Args>
+std::pair<typename SelfAdjustingTree<Key, Comparator, Options>::iterator, bool>
+SelfAdjustingTree<Key, Comparator, Options>::TryConstruct(const Probe &probe,
+                                                          Args &&...args) {
+  const InsertPosition position = Locate(probe);
+  if (position.existing_ != nullptr) {
+    Touch(position.existing_);
+    return {iterator(position.existing_), false};
+  }
+  Node *node = new Node(std::in_place, std::forward<Args>(args)...);
+  stats_.Allocate();
+  if constexpr (kTreap) {
+    node->priority_ = NewPriority();
+  }
+  return {Link(position, node), true};
+}
+
+/**
+ * @brief Находит элемент по ключу.
+ *
+ * Косое дерево поднимает в корень найденный узел, а при промахе - последний
+ * пройденный; частотное декартово дерево увеличивает приоритет найденного
+ * узла.
+ *
+ * @param probe Искомый ключ или проба.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::LocateEqual(const Probe &probe) {
+  const InsertPosition position = Locate(probe);
+  if (position.existing_ != nullptr) {
+    Touch(position.existing_);
+    return iterator(position.existing_);
+  }
+  if constexpr (kSplay) {
+    if (position.parent_ != Head()) {
+      Splay(position.parent_);
+    }
+  }
+  return End();
+}
+
+/**
+ * @brief Находит первый элемент, не меньший ключа.
+ *
+ * Косое дерево поднимает в корень последний пройденный узел.
+ *
+ * @param probe Ключ или проба нижней границы.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::LocateLower(const Probe &probe) {
+  Node *current = Root();
+  Node *last = Head();
+  Node *result = Head();
+  size_type depth = 0;
+  while (current != nullptr) {
+    ++depth;
+    last = current;
+    const bool go_right = Less(current->key_, probe);
+    result = go_right ? result : current;
+    current = go_right ? current->right_ : current->left_;
+  }
+  stats_.Descent(depth);
+  if constexpr (kSplay) {
+    if (last != Head()) {
+      Splay(last);
+    }
+  }
+  return iterator(result);
+}
+
+/**
+ * @brief Находит первый элемент, больший ключа.
+ *
+ * Косое дерево поднимает в корень последний пройденный узел.
+ *
+ * @param probe Ключ или проба верхней границы.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::LocateUpper(const Probe &probe) {
+  Node *current = Root();
+  Node *last = Head();
+  Node *result = Head();
+  size_type depth = 0;
+  while (current != nullptr) {
+    ++depth;
+    last = current;
+    const bool go_left = Less(probe, current->key_);
+    result = go_left ? current : result;
+    current = go_left ? current->left_ : current->right_;
+  }
+  stats_.Descent(depth);
+  if constexpr (kSplay) {
+    if (last != Head()) {
+      Splay(last);
+    }
+  }
+  return iterator(result);
+}
+
+/**
+ * @brief Поиск элемента по ключу.
+ *
+ * @param key Искомый ключ.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::Find(key_arg_type key) {
+  return LocateEqual(key);
+}
+
+/**
+ * @brief Находит первый элемент, не меньший ключа.
+ *
+ * @param key Ключ нижней границы.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::LowerBound(key_arg_type key) {
+  return LocateLower(key);
+}
+
+/**
+ * @brief Находит первый элемент, больший ключа.
+ *
+ * @param key Ключ верхней границы.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::UpperBound(key_arg_type key) {
+  return LocateUpper(key);
+}
+
+/**
+ * @brief Поиск в константном дереве.
+ *
+ * Поиск перестраивает дерево (см. описание класса), поэтому выполняется
+ * неконстантной версией: меняются только связи, а не элементы.
+ *
+ * @param key Искомый ключ.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::const_iterator
+SelfAdjustingTree<Key, Comparator, Options>::Find(key_arg_type key) const {
+  return const_cast<SelfAdjustingTree *>(this)->Find(key);
+}
+
+/**
+ * @brief Находит в константном дереве первый элемент, не меньший ключа.
+ *
+ * @param key Ключ нижней границы.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::const_iterator
+SelfAdjustingTree<Key, Comparator, Options>::LowerBound(
+    key_arg_type key) const {
+  return const_cast<SelfAdjustingTree *>(this)->LowerBound(key);
+}
+
+/**
+ * @brief Находит в константном дереве первый элемент, больший ключа.
+ *
+ * @param key Ключ верхней границы.
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::const_iterator
+SelfAdjustingTree<Key, Comparator, Options>::UpperBound(
+    key_arg_type key) const {
+  return const_cast<SelfAdjustingTree *>(this)->UpperBound(key);
+}
+
+/**
+ * @brief Поиск элемента по пробе без построения временного ключа.
+ *
+ * @param probe Проба, сравнимая с ключами (см. EnableIfTreeProbe).
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::Find(const Probe &probe) {
+  return LocateEqual(probe);
+}
+
+/**
+ * @brief Находит первый элемент, не меньший пробы.
+ *
+ * @param probe Проба, сравнимая с ключами (см. EnableIfTreeProbe).
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::LowerBound(const Probe &probe) {
+  return LocateLower(probe);
+}
+
+/**
+ * @brief Находит первый элемент, больший пробы.
+ *
+ * @param probe Проба, сравнимая с ключами (см. EnableIfTreeProbe).
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::UpperBound(const Probe &probe) {
+  return LocateUpper(probe);
+}
+
+/**
+ * @brief Поиск элемента по пробе в константном дереве.
+ *
+ * @param probe Проба, сравнимая с ключами (см. EnableIfTreeProbe).
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename SelfAdjustingTree<Key, Comparator, Options>::const_iterator
+SelfAdjustingTree<Key, Comparator, Options>::Find(const Probe &probe) const {
+  return const_cast<SelfAdjustingTree *>(this)->LocateEqual(probe);
+}
+
+/**
+ * @brief Находит в константном дереве первый элемент, не меньший
+ * пробы.
+ *
+ * @param probe Проба, сравнимая с ключами (см. EnableIfTreeProbe).
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename SelfAdjustingTree<Key, Comparator, Options>::const_iterator
+SelfAdjustingTree<Key, Comparator, Options>::LowerBound(
+    const Probe &probe) const {
+  return const_cast<SelfAdjustingTree *>(this)->LocateLower(probe);
+}
+
+/**
+ * @brief Находит в константном дереве первый элемент, больший пробы.
+ *
+ * @param probe Проба, сравнимая с ключами (см. EnableIfTreeProbe).
+ * @return Итератор на найденный элемент или End().
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe, EnableIfTreeProbe<Probe, Key>>
+typename SelfAdjustingTree<Key, Comparator, Options>::const_iterator
+SelfAdjustingTree<Key, Comparator, Options>::UpperBound(
+    const Probe &probe) const {
+  return const_cast<SelfAdjustingTree *>(this)->LocateUpper(probe);
+}
+
+/**
+ * @brief Удаляет элемент по итератору; End() игнорируется.
+ *
+ * @param position Итератор на удаляемый элемент.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::Erase(
+    iterator position) noexcept {
+  if (position.node_ == Head()) {
+    return;
+  }
+  Unlink(position.node_);
+  delete position.node_;
+  stats_.Deallocate();
+}
+
+/**
+ * @brief Удаляет элементы диапазона [first, last) по одному.
+ *
+ * Перестройка меняет только связи узлов, поэтому итератор last остается
+ * действительным.
+ *
+ * @param first Итератор на первый удаляемый элемент.
+ * @param last Итератор на элемент, следующий за последним удаляемым.
+ * @return Итератор на элемент, на который указывал last.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::Erase(iterator first,
+                                                   iterator last) noexcept {
+  while (first != last) {
+    Erase(first++);
+  }
+  return iterator(last.node_);
+}
+
+/**
+ * @brief Удаляет все элементы, для которых pred вернул true.
+ *
+ * @param pred Предикат от const key_type &.
+ * @return Число удаленных элементов.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Predicate>
+typename SelfAdjustingTree<Key, Comparator, Options>::size_type
+SelfAdjustingTree<Key, Comparator, Options>::EraseIf(Predicate pred) {
+  size_type removed = 0;
+  Node *node = Head()->left_;
+  while (node != Head()) {
+    Node *next = node->NextNode();
+    const key_type &key = node->key_;
+    if (pred(key)) {
+      Erase(iterator(node));
+      ++removed;
+    }
+    node = next;
+  }
+  return removed;
+}
+
+/**
+ * @brief Возвращает итератор на наименьший элемент.
+ *
+ * @return Итератор на начало дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::Begin() noexcept {
+  return iterator(Head()->left_);
+}
+
+/**
+ * @brief Возвращает константный итератор на наименьший элемент.
+ *
+ * @return Константный итератор на начало дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::const_iterator
+SelfAdjustingTree<Key, Comparator, Options>::Begin() const noexcept {
+  return const_iterator(Head()->left_);
+}
+
+/**
+ * @brief Возвращает итератор за последним элементом (фиктивный узел).
+ *
+ * @return Итератор на конец дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::End() noexcept {
+  return iterator(Head());
+}
+
+/**
+ * @brief Возвращает константный итератор за последним элементом.
+ *
+ * @return Константный итератор на конец дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::const_iterator
+SelfAdjustingTree<Key, Comparator, Options>::End() const noexcept {
+  return const_iterator(Head());
+}
+
+/**
+ * @brief Удаляет все элементы дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::Clear() noexcept {
+  Destroy(Root());
+  InitializeHead();
+  size_ = 0;
+}
+
+/**
+ * @brief Возвращает количество элементов.
+ *
+ * @return Размер дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::size_type
+SelfAdjustingTree<Key, Comparator, Options>::Size() const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Проверяет, пусто ли дерево.
+ *
+ * @return true, если элементов нет.
+ */
+template <typename Key, typename Comparator, typename Options>
+bool SelfAdjustingTree<Key, Comparator, Options>::Empty() const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Возвращает максимально возможное число элементов.
+ *
+ * @return Максимальный размер дерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::size_type
+SelfAdjustingTree<Key, Comparator, Options>::MaxSize() const noexcept {
+  return ((std::numeric_limits<size_type>::max() / 2) -
+          sizeof(SelfAdjustingTree) - sizeof(Node)) /
+         sizeof(Node);
+}
+
+/**
+ * @brief Переносит в дерево узлы other с ключами, которых в дереве нет, без
+ * копирования элементов; other после этого очищается, как и у
+ * RedBlackTree::MergeUnique.
+ *
+ * @param other Дерево-источник.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::MergeUnique(
+    SelfAdjustingTree &other) {
+  if (this == &other) {
+    return;
+  }
+  Node *node = other.Head()->left_;
+  while (node != other.Head()) {
+    Node *next = node->NextNode();
+    const InsertPosition position = Locate(node->key_);
+    if (position.existing_ == nullptr) {
+      other.Unlink(node);
+      node->left_ = nullptr;
+      node->right_ = nullptr;
+      // Частотное декартово дерево сохраняет накопленный счетчик обращений.
+      Link(position, node);
+    }
+    node = next;
+  }
+  other.Clear();
+}
+
+/**
+ * @brief Обменивается содержимым с другим деревом за O(1).
+ *
+ * @param other Дерево для обмена.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::Swap(
+    SelfAdjustingTree &other) noexcept {
+  Node *root = Root();
+  Head()->set_parent(other.Root());
+  other.Head()->set_parent(root);
+  std::swap(Head()->left_, other.Head()->left_);
+  std::swap(Head()->right_, other.Head()->right_);
+  RelinkHead();
+  other.RelinkHead();
+  std::swap(size_, other.size_);
+  std::swap(key_comparator_, other.key_comparator_);
+}
+
+/**
+ * @brief Проверяет структуру дерева без рекурсии (глубина косого дерева
+ * может достигать n): связи с родителями, крайние узлы фиктивного узла,
+ * строгий порядок ключей, размер и, у декартова дерева, порядок кучи по
+ * приоритетам.
+ *
+ * @return true, если нарушений нет.
+ */
+template <typename Key, typename Comparator, typename Options>
+bool SelfAdjustingTree<Key, Comparator, Options>::CheckTree() const noexcept {
+  const Node *head = Head();
+  const Node *root = Root();
+  if (head->color() != RED) {
+    return false;
+  }
+  if (root == nullptr) {
+    return size_ == 0 && head->left_ == head && head->right_ == head;
+  }
+  if (root->parent() != head ||
+      head->left_ != TreeAlgorithms::Minimum(Root()) ||
+      head->right_ != TreeAlgorithms::Maximum(Root())) {
+    return false;
+  }
+
+  size_type count = 0;
+  const Node *previous = nullptr;
+  for (const Node *node = head->left_; node != head;
+       node = node->NextNode()) {
+    if (node->color() != BLACK ||
+        (previous != nullptr && !Less(previous->key_, node->key_))) {
+      return false;
+    }
+    for (const Node *child : {node->left_, node->right_}) {
+      if (child == nullptr) {
+        continue;
+      }
+      if (child->parent() != node) {
+        return false;
+      }
+      if constexpr (kTreap) {
+        if (child->priority_ > node->priority_) {
+          return false;
+        }
+      }
+    }
+    previous = node;
+    ++count;
+  }
+  return count == size_;
+}
+
+/**
+ * @brief Совместимость с RedBlackTree::UpdateAggregates: узлы не хранят
+ * агрегатов, пересчитывать нечего.
+ *
+ * @param position Итератор на измененный элемент.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::UpdateAggregates(
+    iterator) noexcept {}
+
+/**
+ * @brief Возвращает снимок счетчиков горячего пути.
+ *
+ * @return Значения счетчиков (нулевые без Options::stats).
+ */
+template <typename Key, typename Comparator, typename Options>
+ContainerStats
+SelfAdjustingTree<Key, Comparator, Options>::Stats() const noexcept {
+  return stats_.Snapshot();
+}
+
+/**
+ * @brief Обнуляет счетчики горячего пути.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::ResetStats() noexcept {
+  stats_.Reset();
+}
+
+/**
+ * @brief Подсчитывает память дерева: сам объект с фиктивным узлом и
+ * отдельно выделенные узлы, без служебных данных распределителя.
+ *
+ * @return Число байт.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::size_type
+SelfAdjustingTree<Key, Comparator, Options>::MemoryUsage() const noexcept {
+  return sizeof(SelfAdjustingTree) + size_ * sizeof(Node);
+}
+
+/**
+ * @brief Делает дерево пустым: корня нет, минимум и максимум - сам
+ * фиктивный узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::InitializeHead() noexcept {
+  Head()->set_parent(nullptr);
+  Head()->left_ = Head();
+  Head()->right_ = Head();
+}
+
+/**
+ * @brief Восстанавливает ссылку корня на фиктивный узел после обмена.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::RelinkHead() noexcept {
+  if (Root() == nullptr) {
+    InitializeHead();
+    return;
+  }
+  Root()->set_parent(Head());
+}
+
+/**
+ * @brief Копирует узлы other в пустое дерево с сохранением формы.
+ *
+ * Обход идет по связям с родителями без стека: глубина косого дерева может
+ * быть порядка n. Если копирование ключа бросит исключение, уже созданные
+ * узлы удаляются.
+ *
+ * @param other Копируемое дерево.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::CopyFrom(
+    const SelfAdjustingTree &other) {
+  const Node *source_root = other.Root();
+  if (source_root == nullptr) {
+    return;
+  }
+  try {
+    Node *root = Clone(source_root);
+    root->set_parent(Head());
+    Head()->set_parent(root);
+    const Node *source = source_root;
+    Node *target = root;
+    while (true) {
+      if (source->left_ != nullptr && target->left_ == nullptr) {
+        target->left_ = Clone(source->left_);
+        target->left_->set_parent(target);
+        source = source->left_;
+        target = target->left_;
+      } else if (source->right_ != nullptr && target->right_ == nullptr) {
+        target->right_ = Clone(source->right_);
+        target->right_->set_parent(target);
+        source = source->right_;
+        target = target->right_;
+      } else if (source == source_root) {
+        break;
+      } else {
+        source = source->parent();
+        target = target->parent();
+      }
+    }
+  } catch (...) {
+    Clear();
+    throw;
+  }
+  Head()->left_ = TreeAlgorithms::Minimum(Root());
+  Head()->right_ = TreeAlgorithms::Maximum(Root());
+}
+
+/**
+ * @brief Создает несвязанную копию узла (ключ и приоритет) и учитывает ее в
+ * размере дерева.
+ *
+ * @param source Копируемый узел.
+ * @return Новый узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::Node *
+SelfAdjustingTree<Key, Comparator, Options>::Clone(const Node *source) {
+  Node *node = new Node(std::in_place, source->key_);
+  stats_.Allocate();
+  if constexpr (kTreap) {
+    node->priority_ = source->priority_;
+  }
+  ++size_;
+  return node;
+}
+
+/**
+ * @brief Удаляет поддерево без рекурсии: левый потомок поворотом
+ * поднимается наверх, узел без левого потомка удаляется.
+ *
+ * @param node Корень удаляемого поддерева.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::Destroy(
+    Node *node) noexcept {
+  while (node != nullptr) {
+    Node *left = node->left_;
+    if (left != nullptr) {
+      node->left_ = left->right_;
+      left->right_ = node;
+      node = left;
+    } else {
+      Node *right = node->right_;
+      delete node;
+      stats_.Deallocate();
+      node = right;
+    }
+  }
+}
+
+/**
+ * @brief Спускается от корня к узлу с ключом probe или к месту его
+ * вставки.
+ *
+ * @param probe Ключ или объект, который компаратор сравнивает с ключами в
+ * обе стороны.
+ * @return Место вставки; если ключ есть, заполнено existing_.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Probe>
+typename SelfAdjustingTree<Key, Comparator, Options>::InsertPosition
+SelfAdjustingTree<Key, Comparator, Options>::Locate(const Probe &probe) {
+  InsertPosition position{Head(), nullptr, true, true, nullptr};
+  Node *current = Root();
+  size_type depth = 0;
+  while (current != nullptr) {
+    ++depth;
+    position.parent_ = current;
+    int order = 0;
+    if constexpr (kThreeWay) {
+      order = ThreeWay(probe, current->key_);
+    } else {
+      order = Less(probe, current->key_) ? -1 : 1;
+      if (order > 0 && !Less(current->key_, probe)) {
+        order = 0;
+      }
+    }
+    if (order == 0) {
+      position.existing_ = current;
+      break;
+    }
+    const bool go_right = order > 0;
+    position.leftmost_ = position.leftmost_ && !go_right;
+    position.rightmost_ = position.rightmost_ && go_right;
+    position.link_ = go_right ? &current->right_ : &current->left_;
+    current = *position.link_;
+  }
+  stats_.Descent(depth);
+  return position;
+}
+
+/**
+ * @brief Подвешивает узел в найденное Locate место и перестраивает дерево:
+ * косое поднимает узел в корень, декартово - поворотами до порядка кучи.
+ *
+ * Приоритет узла декартова дерева должен быть уже задан.
+ *
+ * @param position Место вставки без дубликата.
+ * @param node Новый узел без потомков.
+ * @return Итератор на вставленный узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+typename SelfAdjustingTree<Key, Comparator, Options>::iterator
+SelfAdjustingTree<Key, Comparator, Options>::Link(
+    const InsertPosition &position, Node *node) noexcept {
+  node->set_parent(position.parent_);
+  if (position.link_ == nullptr) {
+    Head()->set_parent(node);
+    Head()->left_ = node;
+    Head()->right_ = node;
+  } else {
+    *position.link_ = node;
+    if (position.leftmost_) {
+      Head()->left_ = node;
+    }
+    if (position.rightmost_) {
+      Head()->right_ = node;
+    }
+  }
+  ++size_;
+  if constexpr (kSplay) {
+    Splay(node);
+  } else {
+    SiftUp(node);
+  }
+  return iterator(node);
+}
+
+/**
+ * @brief Исключает узел из дерева, не освобождая его.
+ *
+ * Узел с двумя потомками опускается поворотами, пока у него не останется
+ * одного потомка: в декартовом дереве наверх поднимается потомок с большим
+ * приоритетом, в косом - левый. Затем единственный потомок занимает место
+ * узла, а косое дерево поднимает в корень бывшего родителя узла.
+ *
+ * @param node Исключаемый узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::Unlink(Node *node) noexcept {
+  if (Head()->left_ == node) {
+    Head()->left_ = node->NextNode();
+  }
+  if (Head()->right_ == node) {
+    Head()->right_ = node->PrevNode();
+  }
+
+  while (node->left_ != nullptr && node->right_ != nullptr) {
+    bool rotate_right = true;
+    if constexpr (kTreap) {
+      rotate_right = node->left_->priority_ >= node->right_->priority_;
+    }
+    TreeAlgorithms::Rotate(Head(), node, rotate_right, stats_);
+  }
+
+  Node *child = node->left_ != nullptr ? node->left_ : node->right_;
+  Node *parent = node->parent();
+  if (node == Root()) {
+    Head()->set_parent(child);
+  } else if (parent->left_ == node) {
+    parent->left_ = child;
+  } else {
+    parent->right_ = child;
+  }
+  if (child != nullptr) {
+    child->set_parent(parent);
+  }
+  --size_;
+
+  if (Root() == nullptr) {
+    InitializeHead();
+  } else if constexpr (kSplay) {
+    if (parent != Head()) {
+      Splay(parent);
+    }
+  }
+}
+
+/**
+ * @brief Учитывает обращение к существующему узлу: косое дерево поднимает
+ * его в корень, частотное декартово прибавляет единицу к счетчику в
+ * старших битах приоритета (до насыщения) и поднимает узел по куче.
+ *
+ * @param node Узел, к которому обратились.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::Touch(Node *node) noexcept {
+  if constexpr (kSplay) {
+    Splay(node);
+  } else if constexpr (kFrequency) {
+    if (node->priority_ <= std::numeric_limits<std::uint32_t>::max() - kHit) {
+      node->priority_ += kHit;
+      SiftUp(node);
+    }
+  }
+}
+
+/**
+ * @brief Поднимает узел в корень поворотами снизу вверх.
+ *
+ * Узел и родитель по одну сторону от дедушки (zig-zig) поворачиваются
+ * начиная с дедушки, по разные (zig-zag) - начиная с родителя; последний
+ * одиночный поворот у корня - zig. Именно парные повороты дают
+ * амортизированную оценку O(log n): глубина узлов на пути примерно
+ * уменьшается вдвое.
+ *
+ * @param node Поднимаемый узел.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::Splay(Node *node) noexcept {
+  Node *head = Head();
+  while (node->parent() != head) {
+    Node *parent = node->parent();
+    Node *grandparent = parent->parent();
+    const bool node_is_left = parent->left_ == node;
+    if (grandparent == head) {
+      TreeAlgorithms::Rotate(head, parent, node_is_left, stats_);
+    } else if ((grandparent->left_ == parent) == node_is_left) {
+      TreeAlgorithms::Rotate(head, grandparent, node_is_left, stats_);
+      TreeAlgorithms::Rotate(head, parent, node_is_left, stats_);
+    } else {
+      TreeAlgorithms::Rotate(head, parent, node_is_left, stats_);
+      TreeAlgorithms::Rotate(head, grandparent, !node_is_left, stats_);
+    }
+  }
+}
+
+/**
+ * @brief Поднимает узел декартова дерева поворотами, пока его приоритет
+ * больше приоритета родителя.
+ *
+ * @param node Узел с новым или увеличенным приоритетом.
+ */
+template <typename Key, typename Comparator, typename Options>
+void SelfAdjustingTree<Key, Comparator, Options>::SiftUp(Node *node) noexcept {
+  if constexpr (kTreap) {
+    Node *head = Head();
+    while (node->parent() != head &&
+           node->parent()->priority_ < node->priority_) {
+      Node *parent = node->parent();
+      TreeAlgorithms::Rotate(head, parent, parent->left_ == node, stats_);
+    }
+  }
+}
+
+/**
+ * @brief Выдает приоритет нового узла декартова дерева: случайное число
+ * xorshift32, а у частотного дерева - счетчик в одно обращение и случайные
+ * младшие kRandomBits бит.
+ *
+ * @return Приоритет.
+ */
+template <typename Key, typename Comparator, typename Options>
+std::uint32_t
+SelfAdjustingTree<Key, Comparator, Options>::NewPriority() noexcept {
+  random_state_ ^= random_state_ << 13;
+  random_state_ ^= random_state_ >> 17;
+  random_state_ ^= random_state_ << 5;
+  if constexpr (kFrequency) {
+    return kHit | (random_state_ & (kHit - 1));
+  }
+  return random_state_;
+}
+
+/**
+ * @brief Сравнивает ключи компаратором дерева и учитывает сравнение в
+ * счетчиках.
+ *
+ * @param lhs Левый ключ (или проба).
+ * @param rhs Правый ключ (или проба).
+ * @return true, если lhs меньше rhs.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Lhs, typename Rhs>
+bool SelfAdjustingTree<Key, Comparator, Options>::Less(const Lhs &lhs,
+                                                       const Rhs &rhs) const {
+  stats_.Compare();
+  if constexpr (TreeComparison<Key, Comparator>::ordering) {
+    return key_comparator_(lhs, rhs) < 0;
+  } else {
+    return key_comparator_(lhs, rhs);
+  }
+}
+
+/**
+ * @brief Трехстороннее сравнение ключей с учетом в счетчиках (см.
+ * RedBlackTree::ThreeWay).
+ *
+ * @param lhs Левый ключ (или проба).
+ * @param rhs Правый ключ (или проба).
+ * @return Отрицательное число, ноль или положительное число.
+ */
+template <typename Key, typename Comparator, typename Options>
+template <typename Lhs, typename Rhs>
+int SelfAdjustingTree<Key, Comparator, Options>::ThreeWay(
+    const Lhs &lhs, const Rhs &rhs) const {
+#if S21_CONTAINERS_THREE_WAY
+  if constexpr (TreeComparison<Key, Comparator>::ordering) {
+    stats_.Compare();
+    const auto order = key_comparator_(lhs, rhs);
+    return static_cast<int>(order > 0) - static_cast<int>(order < 0);
+  } else if constexpr (TreeComparison<Key, Comparator>::spaceship) {
+    stats_.Compare();
+    const auto order = lhs <=> rhs;
+    return static_cast<int>(order > 0) - static_cast<int>(order < 0);
+  }
+#endif
+  return static_cast<int>(Less(rhs, lhs)) - static_cast<int>(Less(lhs, rhs));
+}
+
+} // namespace s21
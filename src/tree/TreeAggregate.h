@@ -0,0 +1,130 @@
+#ifndef S21_CONTAINERS_TREE_TREEAGGREGATE_H_
+#define S21_CONTAINERS_TREE_TREEAGGREGATE_H_
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace s21 {
+
+// Агрегат поддерева (моноид), который дерево хранит в каждом узле и
+// поддерживает при вставке, удалении, поворотах и изменении элемента.
+// Политика задает:
+//   value_type                     - тип агрегата;
+//   static value_type Identity()   - нейтральный элемент (агрегат пустого
+//                                    диапазона);
+//   static value_type Lift(const Element &) - агрегат одного элемента;
+//   static value_type Combine(const value_type &, const value_type &) -
+//                                    ассоциативная операция; аргументы идут
+//                                    в порядке ключей, поэтому коммутативность
+//                                    не требуется.
+// Lift и Combine не должны бросать исключений. Политики ниже для элемента
+// карты (пары ключ-значение) берут отображенное значение, для остальных
+// элементов - сам элемент.
+struct NoAggregate {
+  using value_type = void;
+};
+
+template <typename Element>
+const Element &AggregatedValue(const Element &element) noexcept {
+  return element;
+}
+
+template <typename Key, typename Type>
+const Type &
+AggregatedValue(const std::pair<const Key, Type> &element) noexcept {
+  return element.second;
+}
+
+template <typename T> struct SumAggregate {
+  using value_type = T;
+
+  static value_type Identity() { return value_type{}; }
+
+  template <typename Element> static value_type Lift(const Element &element) {
+    return static_cast<value_type>(AggregatedValue(element));
+  }
+
+  static value_type Combine(const value_type &lhs, const value_type &rhs) {
+    return lhs + rhs;
+  }
+};
+
+template <typename T> struct MinAggregate {
+  using value_type = T;
+
+  static value_type Identity() {
+    return std::numeric_limits<T>::has_infinity
+               ? std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::max();
+  }
+
+  template <typename Element> static value_type Lift(const Element &element) {
+    return static_cast<value_type>(AggregatedValue(element));
+  }
+
+  static value_type Combine(const value_type &lhs, const value_type &rhs) {
+    return rhs < lhs ? rhs : lhs;
+  }
+};
+
+template <typename T> struct MaxAggregate {
+  using value_type = T;
+
+  static value_type Identity() {
+    return std::numeric_limits<T>::has_infinity
+               ? -std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::lowest();
+  }
+
+  template <typename Element> static value_type Lift(const Element &element) {
+    return static_cast<value_type>(AggregatedValue(element));
+  }
+
+  static value_type Combine(const value_type &lhs, const value_type &rhs) {
+    return lhs < rhs ? rhs : lhs;
+  }
+};
+
+// Количество элементов: агрегат диапазона - число ключей в нем.
+struct CountAggregate {
+  using value_type = std::size_t;
+
+  static value_type Identity() { return 0; }
+
+  template <typename Element> static value_type Lift(const Element &) {
+    return 1;
+  }
+
+  static value_type Combine(value_type lhs, value_type rhs) {
+    return lhs + rhs;
+  }
+};
+
+// Поле агрегата в узле дерева. Node - сам узел (с полями left_, right_ и
+// key_), от которого он наследуется. Без агрегата база пустая и не
+// увеличивает размер узла.
+template <typename Node, typename Aggregate> struct TreeAggregateData {
+  using aggregate_type = typename Aggregate::value_type;
+
+  // Пересчитывает агрегат узла по агрегатам детей.
+  void UpdateAggregate() noexcept {
+    const Node *node = static_cast<const Node *>(this);
+    aggregate_type value = Aggregate::Lift(node->key_);
+    if (node->left_ != nullptr) {
+      value = Aggregate::Combine(node->left_->aggregate_, value);
+    }
+    if (node->right_ != nullptr) {
+      value = Aggregate::Combine(value, node->right_->aggregate_);
+    }
+    aggregate_ = std::move(value);
+  }
+
+  aggregate_type aggregate_{};
+};
+
+template <typename Node> struct TreeAggregateData<Node, NoAggregate> {};
+
+} // namespace s21
+
+#endif // S21_CONTAINERS_TREE_TREEAGGREGATE_H_
@@ -0,0 +1,55 @@
+#ifndef S21_CONTAINERS_TREE_TREEPARALLEL_H_
+#define S21_CONTAINERS_TREE_TREEPARALLEL_H_
+
+#include <exception>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "RedBlackTree.h"
+
+namespace s21 {
+
+// Исполнитель задач дерева в отдельных потоках: все задачи, кроме
+// последней, запускаются через std::async, последняя - в текущем потоке.
+// Threads - число потоков, на которое делится работа; 0 - по числу
+// аппаратных потоков.
+template <unsigned Threads = 0> struct ThreadTreeExecutor {
+  static unsigned Concurrency() noexcept {
+    return Threads != 0 ? Threads : std::thread::hardware_concurrency();
+  }
+
+  template <typename Task, typename Job>
+  static std::exception_ptr Run(const std::vector<Task *> &tasks, Job job) {
+    std::vector<std::future<void>> jobs;
+    std::exception_ptr error;
+    try {
+      for (std::size_t i = 0; i + 1 < tasks.size(); ++i) {
+        jobs.push_back(std::async(std::launch::async, job, tasks[i]));
+      }
+      if (!tasks.empty())
+        job(tasks.back());
+    } catch (...) {
+      error = std::current_exception();
+    }
+    for (auto &pending : jobs) {
+      try {
+        pending.get();
+      } catch (...) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+    return error;
+  }
+};
+
+// Дерево, которое копирует себя и сливает деревья в теоретико-множественных
+// операциях параллельно, начиная с parallel_threshold узлов.
+struct ParallelTreeOptions : DefaultTreeOptions {
+  using executor = ThreadTreeExecutor<>;
+};
+
+} // namespace s21
+
+#endif // S21_CONTAINERS_TREE_TREEPARALLEL_H_
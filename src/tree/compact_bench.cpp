@@ -0,0 +1,96 @@
+// Замер уплотнения узлов (compact) для долгоживущего s21::set<long>. Дерево
+// из 1000000 случайных ключей сначала "перемешивается": несколько раундов
+// удаляют и снова вставляют случайные ключи, так что соседние по порядку
+// узлы оказываются в разных блоках памяти. Затем замеряются полный обход
+// (scan, нс на элемент) и поиск случайных ключей (find, нс на запрос) после
+// перемешивания, после compact() в порядке обхода и после compact() в
+// порядке ван Эмде Боаса, а также время самого уплотнения.
+//
+// Сборка: g++ -std=c++17 -O2 compact_bench.cpp -o compact_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../set/s21_set.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kKeys = 1000000;
+constexpr int kChurnRounds = 4;
+constexpr std::size_t kQueries = std::size_t{1} << 20;
+
+double NanosecondsPerOp(Clock::time_point start, std::size_t ops) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+             .count() /
+         static_cast<double>(ops);
+}
+
+template <typename Set>
+void Measure(const char *name, const Set &container,
+             const std::vector<long> &queries) {
+  std::size_t sink = 0;
+  auto start = Clock::now();
+  for (int round = 0; round < 4; ++round) {
+    for (long key : container) {
+      sink += static_cast<std::size_t>(key);
+    }
+  }
+  const double scan_ns = NanosecondsPerOp(start, 4 * container.size());
+
+  start = Clock::now();
+  for (long query : queries) {
+    sink += container.contains(query);
+  }
+  const double find_ns = NanosecondsPerOp(start, queries.size());
+
+  std::printf("  %-12s scan %6.2f ns  find %7.1f ns  (sink %zu)\n", name,
+              scan_ns, find_ns, sink);
+}
+} // namespace
+
+int main() {
+  std::mt19937_64 gen(50);
+  std::uniform_int_distribution<long> any(0, 4 * static_cast<long>(kKeys));
+  s21::set<long> container;
+  while (container.size() < kKeys) {
+    container.insert(any(gen));
+  }
+  // Перемешивание: половина ключей удаляется и заменяется новыми, узлы
+  // новых ключей занимают освободившиеся места в разных блоках.
+  std::vector<long> keys(container.begin(), container.end());
+  for (int round = 0; round < kChurnRounds; ++round) {
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (std::size_t i = 0; i < keys.size() / 2; ++i) {
+      container.erase(container.find(keys[i]));
+    }
+    while (container.size() < kKeys) {
+      container.insert(any(gen));
+    }
+    keys.assign(container.begin(), container.end());
+  }
+
+  std::vector<long> queries(kQueries);
+  for (long &query : queries) {
+    query = keys[gen() % keys.size()];
+  }
+  std::printf("s21::set<long>, %zu keys after %d churn rounds\n", kKeys,
+              kChurnRounds);
+  Measure("churned", container, queries);
+
+  auto start = Clock::now();
+  container.compact();
+  std::printf("  compact in-order %.1f ms\n",
+              NanosecondsPerOp(start, 1000000));
+  Measure("in-order", container, queries);
+
+  start = Clock::now();
+  container.compact(s21::CompactOrder::kVanEmdeBoas);
+  std::printf("  compact van Emde Boas %.1f ms\n",
+              NanosecondsPerOp(start, 1000000));
+  Measure("van Emde Boas", container, queries);
+  return 0;
+}
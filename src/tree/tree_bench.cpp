@@ -0,0 +1,118 @@
+// Замер деревьев map и set на неравномерных потоках поиска: красно-черное
+// дерево против косого (SplayTreeOptions), декартова со случайными
+// приоритетами (TreapTreeOptions) и декартова с приоритетами по частоте
+// обращений (FrequencyTreapTreeOptions). В s21::set<int> из 100000 ключей
+// ищется поток из 2^20 ключей с распределением Ципфа (ранг k выпадает с
+// вероятностью ~ 1/k^s, ранги разбросаны по ключам случайно) для s от 0
+// (равномерно) до 1.2. Для каждого дерева выводятся средняя длина пути
+// поиска (по счетчикам дерева со статистикой) и время на запрос.
+//
+// Сборка: g++ -std=c++17 -O2 tree_bench.cpp -o tree_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../set/s21_set.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int kKeys = 100000;
+constexpr std::size_t kQueries = std::size_t{1} << 20;
+
+template <typename Options> struct WithStats : Options {
+  static constexpr bool stats = true;
+};
+
+double NanosecondsPerOp(Clock::time_point start, std::size_t ops) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+             .count() /
+         static_cast<double>(ops);
+}
+
+// Поток запросов с распределением Ципфа по рангам; ранг переводится в ключ
+// случайной перестановкой, чтобы горячие ключи не шли подряд.
+std::vector<int> ZipfTrace(double exponent, const std::vector<int> &keys,
+                           std::mt19937 &gen) {
+  std::vector<double> cdf(keys.size());
+  double total = 0.0;
+  for (std::size_t rank = 0; rank < keys.size(); ++rank) {
+    total += 1.0 / std::pow(static_cast<double>(rank + 1), exponent);
+    cdf[rank] = total;
+  }
+  std::uniform_real_distribution<double> uniform(0.0, total);
+  std::vector<int> trace(kQueries);
+  for (int &query : trace) {
+    const auto rank = static_cast<std::size_t>(
+        std::lower_bound(cdf.begin(), cdf.end(), uniform(gen)) - cdf.begin());
+    query = keys[std::min(rank, keys.size() - 1)];
+  }
+  return trace;
+}
+
+template <typename Options>
+void Run(const char *name, const std::vector<int> &inserted,
+         const std::vector<int> &trace) {
+  // Средняя длина пути: сначала поток прогоняется один раз, чтобы
+  // самоподстраивающиеся деревья пришли в установившееся состояние.
+  s21::set<int, WithStats<Options>> counted;
+  for (int key : inserted) {
+    counted.insert(key);
+  }
+  for (int query : trace) {
+    counted.contains(query);
+  }
+  counted.reset_stats();
+  for (int query : trace) {
+    counted.contains(query);
+  }
+  const s21::ContainerStats stats = counted.stats();
+
+  s21::set<int, Options> container;
+  for (int key : inserted) {
+    container.insert(key);
+  }
+  std::size_t sink = 0;
+  for (int query : trace) {
+    sink += container.contains(query);
+  }
+  const auto start = Clock::now();
+  for (int query : trace) {
+    sink += container.contains(query);
+  }
+  const double find_ns = NanosecondsPerOp(start, trace.size());
+
+  std::printf("  %-15s depth %6.2f  rotations/op %5.2f  find %6.1f ns  "
+              "(sink %zu)\n",
+              name, stats.average_depth,
+              static_cast<double>(stats.rotations) /
+                  static_cast<double>(trace.size()),
+              find_ns, sink);
+}
+} // namespace
+
+int main() {
+  std::mt19937 gen(49);
+  std::vector<int> keys(kKeys);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::vector<int> inserted = keys;
+  std::shuffle(inserted.begin(), inserted.end(), gen);
+  std::vector<int> ranked = keys;
+  std::shuffle(ranked.begin(), ranked.end(), gen);
+
+  for (double exponent : {0.0, 0.8, 1.0, 1.2}) {
+    const std::vector<int> trace = ZipfTrace(exponent, ranked, gen);
+    std::printf("zipf s = %.1f, %d keys, %zu queries\n", exponent, kKeys,
+                trace.size());
+    Run<s21::DefaultTreeOptions>("red-black", inserted, trace);
+    Run<s21::SplayTreeOptions>("splay", inserted, trace);
+    Run<s21::TreapTreeOptions>("treap", inserted, trace);
+    Run<s21::FrequencyTreapTreeOptions>("frequency treap", inserted, trace);
+  }
+  return 0;
+}
@@ -1,6 +1,17 @@
  #include "../tree/RedBlackTree.h"
+ #include "../tree/SelfAdjustingTree.h"
+ #include "../tree/TreeParallel.h"
  #include <gtest/gtest.h>
 
+ #include <algorithm>
+ #include <cctype>
+ #include <cstdint>
+ #include <iterator>
+ #include <random>
+ #include <set>
+ #include <string>
+ #include <vector>
+
  TEST(RedBlackTreeTest, InsertAndSize) {
    s21::RedBlackTree<int> tree;
    EXPECT_TRUE(tree.Empty());
@@ -287,10 +298,1029 @@
    EXPECT_EQ(tree.Size(), 0);
  }
 
+ TEST(RedBlackTreeTest, CopyConstructorKeepsOrderAndBalance) {
+   s21::RedBlackTree<std::string> original;
+   for (int i = 0; i < 100; ++i) {
+     original.Insert(std::to_string(i * 7 % 100));
+   }
+
+   s21::RedBlackTree<std::string> copy(original);
+   EXPECT_EQ(copy.Size(), original.Size());
+   EXPECT_TRUE(copy.CheckTree());
+
+   auto it = copy.Begin();
+   for (auto source = original.Begin(); source != original.End();
+        ++source, ++it) {
+     EXPECT_EQ(*it, *source);
+   }
+   EXPECT_EQ(it, copy.End());
+   EXPECT_EQ(*(--copy.End()), "99");
+ }
+
+ TEST(RedBlackTreeTest, CopyOutlivesOriginal) {
+   auto *original = new s21::RedBlackTree<int>;
+   for (int i = 0; i < 50; ++i) {
+     original->Insert(i);
+   }
+   s21::RedBlackTree<int> copy;
+   copy = *original;
+   delete original;
+
+   copy.Insert(100);
+   copy.Clear();
+   for (int i = 0; i < 10; ++i) {
+     copy.Insert(i);
+   }
+   EXPECT_EQ(copy.Size(), 10);
+   EXPECT_TRUE(copy.CheckTree());
+ }
+
+ namespace {
+ // Параллельное копирование и слияние с любого размера и на четырех
+ // потоках независимо от числа ядер машины.
+ struct ForcedParallelOptions : s21::DefaultTreeOptions {
+   using executor = s21::ThreadTreeExecutor<4>;
+   static constexpr std::size_t parallel_threshold = 1;
+ };
+
+ template <typename Options> void CheckCopy(int count) {
+   s21::RedBlackTree<int, std::less<int>, Options> original;
+   for (int i = 0; i < count; ++i) {
+     original.Insert(i);
+   }
+
+   s21::RedBlackTree<int, std::less<int>, Options> copy(original);
+   EXPECT_EQ(copy.Size(), original.Size());
+   EXPECT_TRUE(copy.CheckTree());
+
+   int expected = 0;
+   for (auto it = copy.Begin(); it != copy.End(); ++it, ++expected) {
+     ASSERT_EQ(*it, expected);
+   }
+   EXPECT_EQ(expected, count);
+   EXPECT_EQ(*copy.Find(count / 3), count / 3);
+ }
+ } // namespace
+
+ TEST(RedBlackTreeTest, CopyLargeTree) {
+   CheckCopy<s21::DefaultTreeOptions>(1 << 17);
+   CheckCopy<s21::ParallelTreeOptions>(1 << 17);
+   for (int count : {1, 2, 3, 7, 8, 100, 1 << 12}) {
+     CheckCopy<ForcedParallelOptions>(count);
+   }
+ }
+
+ TEST(RedBlackTreeTest, ParallelCombineMatchesStdAlgorithms) {
+   using Tree = s21::RedBlackTree<int, std::less<int>, ForcedParallelOptions>;
+   std::mt19937 gen(26);
+   for (int size : {0, 1, 5, 64, 3000}) {
+     std::set<int> lhs_keys;
+     std::set<int> rhs_keys;
+     Tree lhs;
+     Tree rhs;
+     for (int i = 0; i < size; ++i) {
+       const int left = static_cast<int>(gen() % (3 * size + 1));
+       const int right = static_cast<int>(gen() % (3 * size + 1));
+       lhs_keys.insert(left);
+       rhs_keys.insert(right);
+       lhs.InsertUnique(left);
+       rhs.InsertUnique(right);
+     }
+     for (s21::SetOperation operation :
+          {s21::SetOperation::kUnion, s21::SetOperation::kIntersection,
+           s21::SetOperation::kDifference,
+           s21::SetOperation::kSymmetricDifference}) {
+       std::vector<int> expected;
+       auto out = std::back_inserter(expected);
+       switch (operation) {
+       case s21::SetOperation::kUnion:
+         std::set_union(lhs_keys.begin(), lhs_keys.end(), rhs_keys.begin(),
+                        rhs_keys.end(), out);
+         break;
+       case s21::SetOperation::kIntersection:
+         std::set_intersection(lhs_keys.begin(), lhs_keys.end(),
+                               rhs_keys.begin(), rhs_keys.end(), out);
+         break;
+       case s21::SetOperation::kDifference:
+         std::set_difference(lhs_keys.begin(), lhs_keys.end(),
+                             rhs_keys.begin(), rhs_keys.end(), out);
+         break;
+       case s21::SetOperation::kSymmetricDifference:
+         std::set_symmetric_difference(lhs_keys.begin(), lhs_keys.end(),
+                                       rhs_keys.begin(), rhs_keys.end(), out);
+         break;
+       }
+       const Tree result = Tree::Combine(lhs, rhs, operation);
+       EXPECT_TRUE(result.CheckTree());
+       EXPECT_EQ(std::vector<int>(result.Begin(), result.End()), expected);
+     }
+   }
+ }
+
+ TEST(RedBlackTreeTest, InsertRecolorsRedUncleUpToRoot) {
+   // Возрастающие и убывающие ключи раз за разом дают случай красного дяди:
+   // после перекраски балансировка должна продолжиться от деда, иначе
+   // дерево вырождается в список.
+   for (bool ascending : {true, false}) {
+     s21::RedBlackTree<int, std::less<int>, s21::StatsTreeOptions> tree;
+     for (int i = 0; i < 1024; ++i) {
+       tree.Insert(ascending ? i : -i);
+       ASSERT_TRUE(tree.CheckTree());
+     }
+     // Высота красно-черного дерева не больше 2 log2(n + 1).
+     EXPECT_LE(tree.Stats().max_depth, 20U);
+   }
+ }
+
+ TEST(RedBlackTreeTest, EraseKeepsBalance) {
+   s21::RedBlackTree<int> tree;
+   for (int i = 0; i < 200; ++i) {
+     tree.Insert(i * 37 % 200);
+   }
+   for (int i = 0; i < 200; i += 3) {
+     tree.Erase(tree.Find(i * 11 % 200));
+     ASSERT_TRUE(tree.CheckTree());
+   }
 
+   int previous = -1;
+   std::size_t visited = 0;
+   for (auto it = tree.Begin(); it != tree.End(); ++it, ++visited) {
+     EXPECT_LT(previous, *it);
+     previous = *it;
+   }
+   EXPECT_EQ(visited, tree.Size());
+   EXPECT_EQ(tree.Size(), 133);
+ }
 
+ // Удаляет ключи в случайном порядке и после каждого удаления сверяет
+ // инварианты, содержимое в обе стороны и крайние элементы с std::set:
+ // удаление узла с двумя детьми, корня и максимума не должно терять
+ // поддеревья и портить ссылки фиктивного узла на минимум и максимум.
+ template <typename Options> void CheckRandomErase(unsigned seed) {
+   std::mt19937 gen(seed);
+   std::vector<int> keys(300);
+   for (int i = 0; i < 300; ++i) {
+     keys[i] = i;
+   }
+   std::shuffle(keys.begin(), keys.end(), gen);
+   s21::RedBlackTree<int, std::less<int>, Options> tree;
+   std::set<int> expected;
+   for (int key : keys) {
+     tree.Insert(key);
+     expected.insert(key);
+   }
+   std::shuffle(keys.begin(), keys.end(), gen);
+   for (int key : keys) {
+     tree.Erase(tree.Find(key));
+     expected.erase(key);
+     ASSERT_TRUE(tree.CheckTree());
+     ASSERT_EQ(tree.Size(), expected.size());
+     ASSERT_TRUE(std::equal(tree.Begin(), tree.End(), expected.begin(),
+                            expected.end()));
+     std::vector<int> backward;
+     for (auto it = tree.End(); it != tree.Begin();) {
+       backward.push_back(*--it);
+     }
+     ASSERT_TRUE(std::equal(backward.begin(), backward.end(),
+                            expected.rbegin(), expected.rend()));
+     if (!expected.empty()) {
+       ASSERT_EQ(*tree.Begin(), *expected.begin());
+       ASSERT_EQ(*--tree.End(), *expected.rbegin());
+     }
+   }
+   EXPECT_EQ(tree.Begin(), tree.End());
+ }
 
+ TEST(RedBlackTreeTest, EraseInRandomOrderKeepsInvariants) {
+   for (unsigned seed = 1; seed <= 4; ++seed) {
+     CheckRandomErase<s21::DefaultTreeOptions>(seed);
+     CheckRandomErase<s21::ThreadedTreeOptions>(seed);
+   }
+   // Корень с двумя детьми, затем корень - максимум.
+   s21::RedBlackTree<int> tree;
+   for (int key : {2, 1, 3}) {
+     tree.Insert(key);
+   }
+   tree.Erase(tree.Find(2));
+   ASSERT_TRUE(tree.CheckTree());
+   EXPECT_EQ(*tree.Begin(), 1);
+   EXPECT_EQ(*--tree.End(), 3);
+   tree.Erase(tree.Find(3));
+   ASSERT_TRUE(tree.CheckTree());
+   EXPECT_EQ(*tree.Begin(), 1);
+   EXPECT_EQ(*--tree.End(), 1);
+ }
+
+ TEST(RedBlackTreeTest, ThreadedTreeIteration) {
+   s21::RedBlackTree<int, std::less<int>, s21::ThreadedTreeOptions> tree;
+   for (int i = 0; i < 100; ++i) {
+     tree.Insert(i * 13 % 100);
+   }
+   for (int i = 0; i < 100; i += 2) {
+     tree.Erase(tree.Find(i));
+   }
+   EXPECT_TRUE(tree.CheckTree());
+
+   int expected = 1;
+   for (auto it = tree.Begin(); it != tree.End(); ++it, expected += 2) {
+     EXPECT_EQ(*it, expected);
+   }
+   EXPECT_EQ(expected, 101);
+
+   auto it = tree.End();
+   for (expected = 99; expected > 0; expected -= 2) {
+     --it;
+     EXPECT_EQ(*it, expected);
+   }
+   EXPECT_EQ(it, tree.Begin());
+ }
+
+ TEST(RedBlackTreeTest, ThreadedTreeCopyAndMerge) {
+   s21::RedBlackTree<int, std::less<int>, s21::ThreadedTreeOptions> tree;
+   for (int i = 0; i < 20; i += 2) {
+     tree.Insert(i);
+   }
+   auto copy = tree;
+   s21::RedBlackTree<int, std::less<int>, s21::ThreadedTreeOptions> other;
+   for (int i = 1; i < 20; i += 2) {
+     other.Insert(i);
+   }
+   copy.MergeUnique(other);
+
+   int expected = 0;
+   for (auto it = copy.Begin(); it != copy.End(); ++it, ++expected) {
+     EXPECT_EQ(*it, expected);
+   }
+   EXPECT_EQ(expected, 20);
+   EXPECT_EQ(tree.Size(), 10);
+ }
+
+ TEST(RedBlackTreeTest, EraseRange) {
+   s21::RedBlackTree<int, std::less<int>, s21::ThreadedTreeOptions> tree;
+   for (int i = 0; i < 1000; ++i) {
+     tree.Insert(i);
+   }
+   auto it = tree.Erase(tree.LowerBound(100), tree.LowerBound(900));
+   EXPECT_EQ(*it, 900);
+   EXPECT_EQ(tree.Size(), 200U);
+   EXPECT_TRUE(tree.CheckTree());
+
+   tree.Erase(tree.Begin(), tree.LowerBound(50));
+   tree.Erase(tree.LowerBound(950), tree.End());
+   EXPECT_EQ(tree.Size(), 100U);
+   EXPECT_TRUE(tree.CheckTree());
+
+   int expected = 50;
+   for (it = tree.Begin(); it != tree.End(); ++it, ++expected) {
+     if (expected == 100) {
+       expected = 900;
+     }
+     EXPECT_EQ(*it, expected);
+   }
+   EXPECT_EQ(expected, 950);
+   EXPECT_EQ(*(--tree.End()), 949);
+
+   EXPECT_EQ(tree.Erase(tree.Begin(), tree.End()), tree.End());
+   EXPECT_TRUE(tree.Empty());
+ }
+
+ TEST(RedBlackTreeTest, EraseIf) {
+   s21::RedBlackTree<int> tree;
+   for (int i = 0; i < 1000; ++i) {
+     tree.Insert(i);
+   }
+   EXPECT_EQ(tree.EraseIf([](int key) { return key % 3 != 0; }), 666U);
+   EXPECT_EQ(tree.Size(), 334U);
+   EXPECT_TRUE(tree.CheckTree());
+
+   int expected = 0;
+   for (auto it = tree.Begin(); it != tree.End(); ++it, expected += 3) {
+     EXPECT_EQ(*it, expected);
+   }
+   EXPECT_EQ(tree.EraseIf([](int) { return false; }), 0U);
+   EXPECT_EQ(tree.EraseIf([](int) { return true; }), 334U);
+   EXPECT_TRUE(tree.Empty());
+ }
+
+ TEST(RedBlackTreeTest, ExtractAndInsertNode) {
+   using Tree = s21::RedBlackTree<std::string, std::less<std::string>,
+                                  s21::StatsTreeOptions>;
+   Tree hot;
+   Tree cold;
+   hot.Insert("a");
+   hot.Insert("b");
+   hot.Insert("c");
+   auto copy = hot; // узлы копии лежат в общем блоке
+
+   Tree::node_type node = copy.Extract(std::string("b"));
+   ASSERT_FALSE(node.empty());
+   const std::string *address = &node.value();
+   node.value() = "z";
+   EXPECT_EQ(copy.Size(), 2U);
+
+   auto it = cold.Insert(std::move(node));
+   EXPECT_TRUE(node.empty());
+   EXPECT_EQ(&*it, address);
+   EXPECT_EQ(*it, "z");
+   EXPECT_EQ(cold.Stats().allocations, 0U);
+   EXPECT_TRUE(cold.CheckTree());
+
+   auto result = hot.InsertUnique(hot.Extract(hot.Find("a")));
+   EXPECT_TRUE(result.inserted);
+   EXPECT_TRUE(result.node.empty());
+   EXPECT_EQ(*result.position, "a");
+
+   Tree::node_type duplicate = copy.Extract(copy.Begin());
+   result = hot.InsertUnique(std::move(duplicate));
+   EXPECT_FALSE(result.inserted);
+   EXPECT_EQ(result.node.value(), "a");
+   EXPECT_EQ(hot.Size(), 3U);
+   EXPECT_TRUE(copy.Extract(copy.End()).empty());
+ }
+
+ TEST(RedBlackTreeTest, StatsCountHotPath) {
+   s21::RedBlackTree<int, std::less<int>, s21::StatsTreeOptions> tree;
+   for (int i = 0; i < 1000; ++i) {
+     tree.Insert(i);
+   }
+   s21::ContainerStats stats = tree.Stats();
+   EXPECT_EQ(stats.allocations, 1000U);
+   EXPECT_EQ(stats.descents, 1000U);
+   EXPECT_GT(stats.comparisons, 1000U);
+   EXPECT_GT(stats.rotations, 0U);
+   EXPECT_GT(stats.recolorings, 0U);
+   EXPECT_LE(stats.max_depth, 20U);
+   EXPECT_GT(stats.average_depth, 1.0);
+
+   tree.ResetStats();
+   EXPECT_NE(tree.Find(500), tree.End());
+   for (auto it = tree.Begin(); it != tree.End(); ++it) {
+   }
+   for (int i = 0; i < 1000; i += 2) {
+     tree.Erase(tree.Find(i));
+   }
+   stats = tree.Stats();
+   EXPECT_EQ(stats.descents, 501U);
+   EXPECT_EQ(stats.deallocations, 500U);
+   EXPECT_EQ(stats.allocations, 0U);
+   EXPECT_TRUE(tree.CheckTree());
+
+   auto copy = tree;
+   EXPECT_EQ(copy.Stats().allocations, 500U);
+   // Итераторы не ссылаются на счетчики дерева.
+   EXPECT_EQ(sizeof(decltype(tree)::iterator), sizeof(void *));
+ }
+
+ TEST(RedBlackTreeTest, StatsDisabledByDefault) {
+   s21::RedBlackTree<int> tree;
+   for (int i = 0; i < 100; ++i) {
+     tree.Insert(i);
+   }
+   s21::ContainerStats stats = tree.Stats();
+   EXPECT_EQ(stats.comparisons, 0U);
+   EXPECT_EQ(stats.allocations, 0U);
+   EXPECT_EQ(sizeof(s21::RedBlackTree<int>::iterator), sizeof(void *));
+ }
+
+ TEST(RedBlackTreeTest, StatsToJson) {
+   s21::ContainerStats stats;
+   stats.comparisons = 7;
+   stats.max_depth = 3;
+   stats.average_depth = 1.5;
+   EXPECT_EQ(stats.ToJson(),
+             "{\"comparisons\":7,\"rotations\":0,\"recolorings\":0,"
+             "\"allocations\":0,\"deallocations\":0,"
+             "\"descents\":0,\"max_depth\":3,"
+             "\"average_depth\":1.500000}");
+ }
+
+ TEST(RedBlackTreeTest, StringKeyFindComparisons) {
+   s21::RedBlackTree<std::string, std::less<std::string>,
+                     s21::StatsTreeOptions>
+       tree;
+   for (int i = 0; i < 512; ++i) {
+     tree.InsertUnique("key-" + std::to_string(i));
+   }
+   tree.ResetStats();
+   EXPECT_NE(tree.Find("key-300"), tree.End());
+   s21::ContainerStats stats = tree.Stats();
+ #if S21_CONTAINERS_THREE_WAY
+   EXPECT_EQ(stats.comparisons, stats.max_depth);
+ #else
+   EXPECT_LE(stats.comparisons, 2 * stats.max_depth);
+ #endif
+   EXPECT_EQ(tree.Emplace(std::string("key-300")).size(), 1U);
+   EXPECT_FALSE(tree.EmplaceUnique(std::string("key-300"))[0].second);
+   EXPECT_EQ(tree.Size(), 513U);
+   EXPECT_TRUE(tree.CheckTree());
+ }
+
+ #if S21_CONTAINERS_THREE_WAY
+ struct CaseInsensitiveOrder {
+   std::weak_ordering operator()(const std::string &lhs,
+                                 const std::string &rhs) const {
+     for (std::size_t i = 0; i < lhs.size() && i < rhs.size(); ++i) {
+       int a = std::tolower(static_cast<unsigned char>(lhs[i]));
+       int b = std::tolower(static_cast<unsigned char>(rhs[i]));
+       if (a != b) {
+         return a <=> b;
+       }
+     }
+     return lhs.size() <=> rhs.size();
+   }
+ };
+
+ TEST(RedBlackTreeTest, OrderingComparator) {
+   s21::RedBlackTree<std::string, CaseInsensitiveOrder> tree;
+   EXPECT_TRUE(tree.InsertUnique("Banana").second);
+   EXPECT_TRUE(tree.InsertUnique("apple").second);
+   EXPECT_FALSE(tree.InsertUnique("APPLE").second);
+   EXPECT_FALSE(tree.EmplaceUnique(std::string("BANANA"))[0].second);
+   tree.Insert("Cherry");
+   EXPECT_EQ(*tree.Begin(), "apple");
+   EXPECT_EQ(*tree.Find("banana"), "Banana");
+   EXPECT_EQ(*tree.LowerBound("b"), "Banana");
+   EXPECT_EQ(*tree.UpperBound("BANANA"), "Cherry");
+   EXPECT_EQ(tree.Size(), 3U);
+   EXPECT_TRUE(tree.CheckTree());
+ }
+ #endif
 
+ TEST(RedBlackTreeTest, ArithmeticKeyOneComparisonPerLevel) {
+   s21::RedBlackTree<int, std::less<int>, s21::StatsTreeOptions> tree;
+   for (int i = 0; i < 1024; i += 2) {
+     tree.InsertUnique(i);
+   }
+   tree.Insert(0);
+   tree.Insert(1022);
+   EXPECT_EQ(*tree.Begin(), 0);
+   EXPECT_EQ(*--tree.End(), 1022);
+   EXPECT_FALSE(tree.InsertUnique(500).second);
+   EXPECT_TRUE(tree.CheckTree());
+
+   for (int key : {500, 501, -1, 2000}) {
+     tree.ResetStats();
+     auto found = tree.Find(key);
+     s21::ContainerStats stats = tree.Stats();
+     EXPECT_EQ(found != tree.End(), key == 500);
+     // Одно сравнение на каждый пройденный уровень и не больше одной
+     // проверки равенства в конце.
+     EXPECT_LE(stats.comparisons, stats.max_depth + 1);
+   }
+
+   tree.ResetStats();
+   tree.Insert(-5);
+   EXPECT_EQ(tree.Stats().comparisons, tree.Stats().max_depth);
+   EXPECT_EQ(*tree.Begin(), -5);
+ }
+
+ TEST(RedBlackTreeTest, CombineIsLinear) {
+   using Tree = s21::RedBlackTree<int, std::less<int>, s21::StatsTreeOptions>;
+   Tree evens;
+   Tree thirds;
+   for (int i = 0; i < 3000; i += 2) {
+     evens.InsertUnique(i);
+   }
+   for (int i = 0; i < 3000; i += 3) {
+     thirds.InsertUnique(i);
+   }
+   const std::size_t total = evens.Size() + thirds.Size();
+
+   evens.ResetStats();
+   thirds.ResetStats();
+   Tree both = Tree::Combine(evens, thirds, s21::SetOperation::kIntersection);
+   EXPECT_EQ(both.Size(), 500U);
+   EXPECT_TRUE(both.CheckTree());
+   // Не больше двух сравнений на элемент вместо log n на каждый поиск.
+   EXPECT_LE(evens.Stats().comparisons + thirds.Stats().comparisons,
+             2 * total);
+   int expected = 0;
+   for (auto it = both.Begin(); it != both.End(); ++it, expected += 6) {
+     EXPECT_EQ(*it, expected);
+   }
+
+   Tree odd =
+       Tree::Combine(evens, thirds, s21::SetOperation::kSymmetricDifference);
+   EXPECT_EQ(odd.Size(), total - 2 * both.Size());
+   EXPECT_TRUE(odd.CheckTree());
+
+   // Оставшиеся узлы используются повторно.
+   const int *kept = &*evens.Find(4);
+   evens.CombineWith(thirds, s21::SetOperation::kDifference);
+   EXPECT_EQ(evens.Size(), 1000U);
+   EXPECT_TRUE(evens.Find(6) == evens.End());
+   EXPECT_EQ(&*evens.Find(4), kept);
+   EXPECT_TRUE(evens.CheckTree());
+
+   evens.CombineWith(evens, s21::SetOperation::kUnion);
+   EXPECT_EQ(evens.Size(), 1000U);
+   evens.CombineWith(evens, s21::SetOperation::kDifference);
+   EXPECT_TRUE(evens.Empty());
+   EXPECT_TRUE(evens.CheckTree());
+ }
+
+
+
+
+
+
+ namespace {
+ // Некоммутативный агрегат: ключи поддерева через запятую в порядке обхода.
+ struct KeyListAggregate {
+   using value_type = std::string;
+
+   static value_type Identity() { return {}; }
+
+   static value_type Lift(int key) { return std::to_string(key) + ","; }
+
+   static value_type Combine(const value_type &lhs, const value_type &rhs) {
+     return lhs + rhs;
+   }
+ };
+ } // namespace
+
+ TEST(RedBlackTreeTest, SubtreeAggregatesSurviveRebalancing) {
+   using Tree = s21::RedBlackTree<int, std::less<int>,
+                                  s21::AggregateTreeOptions<KeyListAggregate>>;
+   auto list = [](const Tree &tree, int lo, int hi) {
+     std::string expected;
+     for (auto it = tree.Begin(); it != tree.End(); ++it) {
+       if (*it >= lo && *it < hi) {
+         expected += std::to_string(*it) + ",";
+       }
+     }
+     return expected;
+   };
+
+   Tree tree;
+   for (int i = 0; i < 400; ++i) {
+     tree.InsertUnique((i * 7919) % 1000);
+   }
+   for (int i = 0; i < 400; i += 3) {
+     tree.Erase(tree.Find((i * 7919) % 1000));
+   }
+   EXPECT_TRUE(tree.CheckTree());
+   for (auto [lo, hi] :
+        {std::pair{0, 1000}, std::pair{150, 420}, std::pair{421, 422},
+         std::pair{421, 421}, std::pair{500, 100}}) {
+     EXPECT_EQ(tree.Aggregate(lo, hi), list(tree, lo, hi));
+   }
+
+   // Разрезание и склеивание, перестроение и копирование.
+   tree.Erase(tree.LowerBound(200), tree.LowerBound(600));
+   tree.EraseIf([](int key) { return key % 5 == 0; });
+   Tree copy = tree;
+   EXPECT_TRUE(copy.CheckTree());
+   EXPECT_EQ(copy.Aggregate(-1, 1000), list(tree, -1, 1000));
+   Tree odd = Tree::Combine(copy, tree, s21::SetOperation::kUnion);
+   EXPECT_TRUE(odd.CheckTree());
+   EXPECT_EQ(odd.Aggregate(100, 800), list(tree, 100, 800));
+ }
+
+ namespace {
+ struct CompactThreadedOptions : s21::CompactTreeOptions {
+   static constexpr bool threaded = true;
+ };
+ } // namespace
+
+ TEST(RedBlackTreeTest, CompactLayoutMatchesStdSet) {
+   using Tree =
+       s21::RedBlackTree<long, std::less<long>, s21::CompactTreeOptions>;
+   using ThreadedTree =
+       s21::RedBlackTree<long, std::less<long>, CompactThreadedOptions>;
+   Tree tree;
+   ThreadedTree threaded;
+   std::set<long> ref;
+   std::mt19937 gen(45);
+   for (int step = 0; step < 5000; ++step) {
+     const long key = static_cast<long>(gen() % 2000);
+     if (gen() % 3 == 0) {
+       if (tree.Find(key) != tree.End()) {
+         tree.Erase(tree.Find(key));
+         threaded.Erase(threaded.Find(key));
+       }
+       ref.erase(key);
+     } else {
+       tree.InsertUnique(key);
+       threaded.InsertUnique(key);
+       ref.insert(key);
+     }
+   }
+   ASSERT_TRUE(tree.CheckTree());
+   ASSERT_TRUE(threaded.CheckTree());
+   EXPECT_EQ(std::vector<long>(tree.Begin(), tree.End()),
+             std::vector<long>(ref.begin(), ref.end()));
+   EXPECT_EQ(std::vector<long>(threaded.Begin(), threaded.End()),
+             std::vector<long>(ref.begin(), ref.end()));
+
+   // Узлы общего блока: копия, извлечение, слияние и разрезание.
+   Tree copy = tree;
+   EXPECT_TRUE(copy.CheckTree());
+   auto node = copy.Extract(*ref.begin());
+   EXPECT_FALSE(node.empty());
+   Tree other;
+   other.Insert(std::move(node));
+   other.InsertUnique(-1);
+   Tree joined = Tree::Combine(copy, other, s21::SetOperation::kUnion);
+   EXPECT_TRUE(joined.CheckTree());
+   EXPECT_EQ(joined.Size(), ref.size() + 1);
+   copy.Erase(copy.LowerBound(500), copy.LowerBound(1500));
+   EXPECT_TRUE(copy.CheckTree());
+   std::vector<long> sorted(ref.begin(), ref.end());
+   copy.AssignSorted(sorted.begin(), sorted.end());
+   EXPECT_TRUE(copy.CheckTree());
+   EXPECT_EQ(std::vector<long>(copy.Begin(), copy.End()), sorted);
+ }
+
+ TEST(RedBlackTreeTest, MemoryUsageCountsNodes) {
+   s21::RedBlackTree<long> plain;
+   s21::RedBlackTree<long, std::less<long>, s21::CompactTreeOptions> compact;
+   const std::size_t plain_empty = plain.MemoryUsage();
+   const std::size_t compact_empty = compact.MemoryUsage();
+   for (long key = 0; key < 100; ++key) {
+     plain.Insert(key);
+     compact.Insert(key);
+   }
+   // Три указателя и 8-байтный ключ: цвет и признак блока упакованы в
+   // указатель на родителя, поэтому компактный узел на 8 байт меньше.
+   EXPECT_EQ(plain.MemoryUsage() - plain_empty, 100 * 40U);
+   EXPECT_EQ(compact.MemoryUsage() - compact_empty, 100 * 32U);
+
+   // Копия размещает узлы в общем блоке; компактному узлу int номер ячейки
+   // помещается в выравнивание, и узел остается 32-байтным. К ячейкам
+   // добавляется 16-байтовый заголовок блока.
+   s21::RedBlackTree<int, std::less<int>, s21::CompactTreeOptions> small;
+   for (int key = 0; key < 100; ++key) {
+     small.Insert(key);
+   }
+   const auto small_copy = small;
+   EXPECT_EQ(small_copy.MemoryUsage(), small.MemoryUsage() + 16);
+   EXPECT_EQ(small.MemoryUsage() - decltype(small)().MemoryUsage(), 100 * 32U);
+   small.Clear();
+   EXPECT_EQ(small.MemoryUsage(), decltype(small)().MemoryUsage());
+ }
+
+ namespace {
+ // Ключ без конструктора по умолчанию: фиктивный узел не создает ключ.
+ struct Label {
+   explicit Label(std::string text) : text(std::move(text)) {}
+   bool operator<(const Label &other) const { return text < other.text; }
+
+   std::string text;
+ };
+
+ template <typename Tree> std::vector<std::string> Labels(const Tree &tree) {
+   std::vector<std::string> labels;
+   for (auto it = tree.Begin(); it != tree.End(); ++it) {
+     labels.push_back((*it).text);
+   }
+   // Обратный обход проверяет связи максимума с фиктивным узлом.
+   std::vector<std::string> reversed;
+   for (auto it = tree.End(); it != tree.Begin();) {
+     reversed.push_back((*--it).text);
+   }
+   EXPECT_TRUE(std::equal(labels.begin(), labels.end(), reversed.rbegin(),
+                          reversed.rend()));
+   return labels;
+ }
+
+ template <typename Options> void CheckEmbeddedSentinel() {
+   using Tree = s21::RedBlackTree<Label, std::less<Label>, Options>;
+   Tree tree;
+   EXPECT_TRUE(tree.Begin() == tree.End());
+   for (const char *text : {"delta", "alpha", "echo", "charlie", "bravo"}) {
+     tree.InsertUnique(Label(text));
+   }
+   const std::vector<std::string> sorted{"alpha", "bravo", "charlie", "delta",
+                                         "echo"};
+
+   Tree moved(std::move(tree));
+   EXPECT_TRUE(tree.Empty());
+   EXPECT_TRUE(tree.Begin() == tree.End());
+   EXPECT_TRUE(moved.CheckTree());
+   EXPECT_EQ(Labels(moved), sorted);
+
+   Tree other;
+   other.InsertUnique(Label("zulu"));
+   other.Swap(moved);
+   EXPECT_TRUE(other.CheckTree());
+   EXPECT_TRUE(moved.CheckTree());
+   EXPECT_EQ(Labels(other), sorted);
+   EXPECT_EQ(Labels(moved), std::vector<std::string>{"zulu"});
+   other.Swap(other);
+   EXPECT_EQ(Labels(other), sorted);
+
+   tree = std::move(other);
+   tree.Erase(tree.Find(Label("charlie")));
+   tree.InsertUnique(Label("foxtrot"));
+   EXPECT_TRUE(tree.CheckTree());
+   EXPECT_EQ(Labels(tree), (std::vector<std::string>{"alpha", "bravo", "delta",
+                                                     "echo", "foxtrot"}));
+   const Tree copy = tree;
+   EXPECT_EQ(Labels(copy), Labels(tree));
+   tree.Clear();
+   tree.Swap(moved);
+   EXPECT_TRUE(moved.Empty());
+   EXPECT_EQ(Labels(tree), std::vector<std::string>{"zulu"});
+ }
+ } // namespace
+
+ TEST(RedBlackTreeTest, EmbeddedSentinelSurvivesMoveAndSwap) {
+   CheckEmbeddedSentinel<s21::DefaultTreeOptions>();
+   CheckEmbeddedSentinel<s21::ThreadedTreeOptions>();
+   CheckEmbeddedSentinel<s21::CompactTreeOptions>();
+ }
+
+ namespace {
+ // Статистика нужна, чтобы сравнить глубины узлов до и после уплотнения;
+ // компаратор не std::less, чтобы поиск останавливался на найденном узле.
+ template <typename Base> struct CompactionOptions : Base {
+   static constexpr bool stats = true;
+ };
+
+ template <typename Tree> std::vector<std::uintptr_t> Addresses(Tree &tree) {
+   std::vector<std::uintptr_t> addresses;
+   for (auto it = tree.Begin(); it != tree.End(); ++it) {
+     addresses.push_back(reinterpret_cast<std::uintptr_t>(&*it));
+   }
+   return addresses;
+ }
+
+ // Адреса, упорядоченные по возрастанию, идут с одним и тем же шагом.
+ bool Contiguous(std::vector<std::uintptr_t> addresses) {
+   std::sort(addresses.begin(), addresses.end());
+   for (std::size_t i = 2; i < addresses.size(); ++i) {
+     if (addresses[i] - addresses[i - 1] != addresses[1] - addresses[0]) {
+       return false;
+     }
+   }
+   return true;
+ }
+
+ template <typename Options> void CheckCompaction() {
+   using Tree =
+       s21::RedBlackTree<long, std::greater<long>, CompactionOptions<Options>>;
+   Tree tree;
+   std::set<long, std::greater<long>> ref;
+   std::mt19937 gen(50);
+   for (int step = 0; step < 6000; ++step) {
+     const long key = static_cast<long>(gen() % 3000);
+     if (gen() % 3 == 0) {
+       tree.Erase(tree.Find(key));
+       ref.erase(key);
+     } else {
+       tree.InsertUnique(key);
+       ref.insert(key);
+     }
+   }
+   auto depths = [&tree, &ref]() {
+     tree.ResetStats();
+     for (long key : ref) {
+       tree.Find(key);
+     }
+     return std::pair{tree.Stats().average_depth, tree.Stats().max_depth};
+   };
+   const auto shape = depths();
+   const std::vector<long> keys(ref.begin(), ref.end());
+
+   tree.Compact();
+   ASSERT_TRUE(tree.CheckTree());
+   EXPECT_EQ(depths(), shape);
+   EXPECT_EQ(std::vector<long>(tree.Begin(), tree.End()), keys);
+   std::vector<std::uintptr_t> addresses = Addresses(tree);
+   EXPECT_TRUE(Contiguous(addresses));
+   EXPECT_TRUE(std::is_sorted(addresses.begin(), addresses.end()));
+   std::vector<long> backwards;
+   for (auto it = tree.End(); it != tree.Begin();) {
+     backwards.push_back(*--it);
+   }
+   EXPECT_TRUE(std::equal(backwards.rbegin(), backwards.rend(), keys.begin(),
+                          keys.end()));
+
+   tree.Compact(s21::CompactOrder::kVanEmdeBoas);
+   ASSERT_TRUE(tree.CheckTree());
+   EXPECT_EQ(depths(), shape);
+   EXPECT_EQ(std::vector<long>(tree.Begin(), tree.End()), keys);
+   addresses = Addresses(tree);
+   EXPECT_TRUE(Contiguous(addresses));
+   // Первым в порядке ван Эмде Боаса лежит корень.
+   const auto first = std::min_element(addresses.begin(), addresses.end());
+   tree.ResetStats();
+   tree.Find(keys[static_cast<std::size_t>(first - addresses.begin())]);
+   EXPECT_EQ(tree.Stats().max_depth, 1U);
+
+   // Узлы общего блока продолжают жить после вставок и удалений.
+   tree.Erase(tree.Find(keys[keys.size() / 2]));
+   tree.InsertUnique(-1);
+   tree.Erase(tree.LowerBound(2000), tree.LowerBound(1000));
+   EXPECT_TRUE(tree.CheckTree());
+ }
+ } // namespace
+
+ TEST(RedBlackTreeTest, CompactKeepsShapeAndLaysOutNodes) {
+   CheckCompaction<s21::DefaultTreeOptions>();
+   CheckCompaction<s21::ThreadedTreeOptions>();
+   CheckCompaction<CompactThreadedOptions>();
+   CheckCompaction<s21::AggregateTreeOptions<s21::SumAggregate<long>>>();
+ }
+
+ TEST(RedBlackTreeTest, CompactStepIsIncremental) {
+   using Tree = s21::RedBlackTree<int>;
+   Tree tree;
+   std::set<int> ref;
+   for (int key = 0; key < 1000; ++key) {
+     tree.InsertUnique(key * 7 % 1000);
+     ref.insert(key);
+   }
+   Tree empty;
+   EXPECT_TRUE(empty.CompactStep(10));
+
+   int calls = 1;
+   while (!tree.CompactStep(64)) {
+     ++calls;
+   }
+   EXPECT_EQ(calls, 16);
+   EXPECT_TRUE(tree.CheckTree());
+   EXPECT_TRUE(Contiguous(Addresses(tree)));
+
+   // Изменения между порциями: вставки продолжают проход, удаление
+   // последнего перенесенного узла начинает его заново.
+   for (auto order :
+        {s21::CompactOrder::kInOrder, s21::CompactOrder::kVanEmdeBoas}) {
+     EXPECT_FALSE(tree.CompactStep(100, order));
+     tree.InsertUnique(5000);
+     ref.insert(5000);
+     EXPECT_FALSE(tree.CompactStep(100));
+     // Двухсотый ключ - последний перенесенный по порядку ключей узел.
+     const int last = *std::next(ref.begin(), 199);
+     tree.Erase(tree.Find(last));
+     ref.erase(last);
+     while (!tree.CompactStep(100)) {
+     }
+     ASSERT_TRUE(tree.CheckTree());
+     EXPECT_EQ(std::vector<int>(tree.Begin(), tree.End()),
+               std::vector<int>(ref.begin(), ref.end()));
+   }
+
+   // Незаконченный проход переживает обмен, копия его не наследует, а
+   // очистка и уничтожение освобождают его блок.
+   EXPECT_FALSE(tree.CompactStep(10));
+   Tree other;
+   other.Swap(tree);
+   Tree copy = other;
+   EXPECT_TRUE(other.CompactStep(2000));
+   EXPECT_TRUE(Contiguous(Addresses(other)));
+   EXPECT_FALSE(copy.CompactStep(10));
+   copy.Clear();
+   EXPECT_TRUE(copy.CompactStep(10));
+   EXPECT_FALSE(other.CompactStep(0, s21::CompactOrder::kVanEmdeBoas));
+ }
+
+ namespace {
+ struct SplayStatsOptions : s21::SplayTreeOptions {
+   static constexpr bool stats = true;
+ };
+
+ struct FrequencyTreapStatsOptions : s21::FrequencyTreapTreeOptions {
+   static constexpr bool stats = true;
+ };
+
+ template <typename Options> void CheckSelfAdjustingBackend() {
+   using Tree = s21::SelfAdjustingTree<int, std::less<int>, Options>;
+   Tree tree;
+   std::set<int> ref;
+   std::mt19937 gen(49);
+   for (int step = 0; step < 20000; ++step) {
+     const int key = static_cast<int>(gen() % 1000);
+     switch (gen() % 4) {
+     case 0: {
+       auto it = tree.Find(key);
+       ASSERT_EQ(it != tree.End(), ref.count(key) == 1);
+       if (it != tree.End()) {
+         tree.Erase(it);
+         ref.erase(key);
+       }
+       break;
+     }
+     case 1: {
+       auto it = tree.LowerBound(key);
+       auto expected = ref.lower_bound(key);
+       ASSERT_EQ(it == tree.End(), expected == ref.end());
+       if (expected != ref.end()) {
+         ASSERT_EQ(*it, *expected);
+       }
+       auto upper = tree.UpperBound(key);
+       expected = ref.upper_bound(key);
+       ASSERT_EQ(upper == tree.End(), expected == ref.end());
+       if (expected != ref.end()) {
+         ASSERT_EQ(*upper, *expected);
+       }
+       break;
+     }
+     default:
+       ASSERT_EQ(tree.InsertUnique(key).second, ref.insert(key).second);
+     }
+   }
+   ASSERT_TRUE(tree.CheckTree());
+   EXPECT_EQ(tree.Size(), ref.size());
+   EXPECT_EQ(std::vector<int>(tree.Begin(), tree.End()),
+             std::vector<int>(ref.begin(), ref.end()));
+   EXPECT_EQ(*std::prev(tree.End()), *ref.rbegin());
+
+   Tree copy = tree;
+   EXPECT_TRUE(copy.CheckTree());
+   copy.Erase(copy.LowerBound(200), copy.LowerBound(800));
+   EXPECT_TRUE(copy.CheckTree());
+   EXPECT_EQ(copy.EraseIf([](int key) { return key % 2 == 0; }),
+             static_cast<std::size_t>(std::count_if(
+                 ref.begin(), ref.end(), [](int key) {
+                   return key % 2 == 0 && (key < 200 || key >= 800);
+                 })));
+   EXPECT_TRUE(copy.CheckTree());
+
+   Tree other;
+   for (int key = 990; key < 1010; ++key) {
+     other.InsertUnique(key);
+   }
+   tree.MergeUnique(other);
+   EXPECT_TRUE(tree.CheckTree());
+   EXPECT_TRUE(other.Empty());
+   for (int key = 990; key < 1010; ++key) {
+     ref.insert(key);
+   }
+   EXPECT_EQ(std::vector<int>(tree.Begin(), tree.End()),
+             std::vector<int>(ref.begin(), ref.end()));
+
+   const Tree &constant = tree;
+   EXPECT_EQ(*constant.Find(1005), 1005);
+   EXPECT_TRUE(constant.CheckTree());
+   tree.Clear();
+   EXPECT_TRUE(tree.Empty());
+   EXPECT_TRUE(tree.Begin() == tree.End());
+   EXPECT_TRUE(tree.CheckTree());
+ }
+ } // namespace
+
+ TEST(SelfAdjustingTreeTest, MatchesStdSetForEveryBackend) {
+   CheckSelfAdjustingBackend<s21::SplayTreeOptions>();
+   CheckSelfAdjustingBackend<s21::TreapTreeOptions>();
+   CheckSelfAdjustingBackend<s21::FrequencyTreapTreeOptions>();
+ }
+
+ TEST(SelfAdjustingTreeTest, SplayMovesAccessedKeyToRoot) {
+   s21::SelfAdjustingTree<int, std::less<int>, SplayStatsOptions> tree;
+   for (int key = 0; key < 1000; ++key) {
+     tree.InsertUnique(key);
+   }
+   EXPECT_EQ(*tree.Find(0), 0);
+   EXPECT_TRUE(tree.CheckTree());
+   tree.ResetStats();
+   EXPECT_EQ(*tree.Find(0), 0);
+   EXPECT_EQ(tree.Stats().max_depth, 1U);
+   // Промах поднимает в корень последний пройденный узел: повторный промах
+   // обходится одним уровнем.
+   EXPECT_EQ(tree.Find(5000), tree.End());
+   tree.ResetStats();
+   EXPECT_EQ(tree.Find(5000), tree.End());
+   EXPECT_EQ(tree.Stats().max_depth, 1U);
+ }
+
+ TEST(SelfAdjustingTreeTest, FrequencyTreapLiftsHotKey) {
+   s21::SelfAdjustingTree<int, std::less<int>, FrequencyTreapStatsOptions>
+       tree;
+   std::vector<int> keys(4096);
+   for (int i = 0; i < 4096; ++i) {
+     keys[i] = i;
+   }
+   std::shuffle(keys.begin(), keys.end(), std::mt19937(50));
+   for (int key : keys) {
+     tree.InsertUnique(key);
+   }
+   for (int hit = 0; hit < 8; ++hit) {
+     tree.Find(777);
+     tree.Find(1234);
+   }
+   EXPECT_TRUE(tree.CheckTree());
+   tree.ResetStats();
+   tree.Find(777);
+   tree.Find(1234);
+   EXPECT_LE(tree.Stats().max_depth, 2U);
+ }
+
+ TEST(SelfAdjustingTreeTest, DegenerateSplayTreeWithoutRecursion) {
+   // Возрастающие вставки вытягивают косое дерево в путь длины n: копия,
+   // проверка и уничтожение не должны расходовать стек по глубине.
+   using Tree = s21::SelfAdjustingTree<int>;
+   Tree tree;
+   for (int key = 0; key < 200000; ++key) {
+     tree.InsertUnique(key);
+   }
+   Tree copy = tree;
+   EXPECT_TRUE(copy.CheckTree());
+   EXPECT_EQ(copy.Size(), 200000U);
+   EXPECT_EQ(*copy.Find(0), 0);
+   EXPECT_TRUE(copy.CheckTree());
+ }
 
  int main(int argc, char **argv) {
 
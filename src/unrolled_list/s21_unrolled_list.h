@@ -0,0 +1,218 @@
+#ifndef S21_CONTAINERS_UNROLLED_LIST_S21_UNROLLED_LIST_H_
+#define S21_CONTAINERS_UNROLLED_LIST_S21_UNROLLED_LIST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Вместимость узла по умолчанию: около 256 байт элементов, но не меньше 4.
+template <typename T>
+inline constexpr std::size_t kUnrolledListCapacity =
+    256 / sizeof(T) < 4 ? 4 : 256 / sizeof(T);
+
+// Развернутый двусвязный список: узел хранит до K элементов подряд во
+// встроенном массиве. Обход читает элементы последовательно, а служебные
+// указатели делятся на K элементов вместо одного. Вставка и удаление по
+// итератору сдвигают не больше K элементов одного узла; полный узел при
+// вставке делится пополам, а соседние узлы, которые после удаления вместе
+// занимают не больше половины узла, сливаются.
+//
+// Вставка и удаление делают недействительными итераторы на элементы
+// затронутых узлов (в отличие от s21::List, где элементы не перемещаются).
+template <typename T, std::size_t K = kUnrolledListCapacity<T>>
+class unrolled_list {
+  static_assert(K >= 2, "s21::unrolled_list: в узле нужно хотя бы 2 места");
+
+private:
+  struct Links;
+  struct Node;
+  template <bool IsConst> class UnrolledListIterator;
+
+public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = UnrolledListIterator<false>;
+  using const_iterator = UnrolledListIterator<true>;
+  using size_type = std::size_t;
+
+  // Конструкторы, деструктор и операторы присваивания
+  unrolled_list() noexcept;
+  explicit unrolled_list(size_type n);
+  unrolled_list(std::initializer_list<value_type> const &items);
+  unrolled_list(const unrolled_list &other);
+  unrolled_list(unrolled_list &&other) noexcept;
+  ~unrolled_list();
+
+  unrolled_list &operator=(const unrolled_list &other);
+  unrolled_list &operator=(unrolled_list &&other) noexcept;
+
+  friend bool operator==(const unrolled_list &lhs, const unrolled_list &rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  friend bool operator!=(const unrolled_list &lhs, const unrolled_list &rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Доступ к элементам
+  reference front() noexcept;
+  const_reference front() const noexcept;
+  reference back() noexcept;
+  const_reference back() const noexcept;
+
+  // Итераторы
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cBegin() const noexcept;
+  const_iterator cEnd() const noexcept;
+
+  // Размеры
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+  [[nodiscard]] size_type max_size() const noexcept;
+
+  // Модификаторы
+  void clear() noexcept;
+  iterator insert(const_iterator pos, const_reference value);
+  iterator erase(const_iterator pos);
+  void push_back(const_reference value);
+  void push_front(const_reference value);
+  void pop_back();
+  void pop_front();
+  void swap(unrolled_list &other) noexcept;
+  void merge(unrolled_list &other);
+  void reverse() noexcept;
+  void sort();
+
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args &&...args);
+  template <typename... Args> void insert_many_back(Args &&...args);
+  template <typename... Args> void insert_many_front(Args &&...args);
+
+private:
+  template <typename... Args>
+  iterator Emplace(const_iterator pos, Args &&...args);
+  template <typename... Args> void EmplaceBack(Args &&...args);
+  Node *InsertNodeAfter(Links *prev);
+  void RemoveNode(Node *node) noexcept;
+  void Split(Node *node);
+  void MergeWithNext(Node *node) noexcept;
+  void RelinkHead() noexcept;
+  Node *First() const noexcept;
+  Node *Last() const noexcept;
+
+  // Ссылки узла на соседей. Узлы образуют кольцевой список через head_,
+  // поэтому end() - позиция 0 в head_.
+  struct Links {
+    Links *prev_ = nullptr;
+    Links *next_ = nullptr;
+  };
+
+  // Элементы занимают первые count_ ячеек storage_ и создаются в них на
+  // месте, поэтому T не обязан иметь конструктор по умолчанию.
+  struct Node : Links {
+    T *Data() noexcept {
+      return std::launder(reinterpret_cast<T *>(storage_));
+    }
+
+    const T *Data() const noexcept {
+      return std::launder(reinterpret_cast<const T *>(storage_));
+    }
+
+    size_type count_ = 0;
+    alignas(T) unsigned char storage_[K * sizeof(T)];
+  };
+
+  template <bool IsConst> class UnrolledListIterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+    using links_pointer = std::conditional_t<IsConst, const Links *, Links *>;
+
+    UnrolledListIterator() noexcept = default;
+
+    UnrolledListIterator(links_pointer node, size_type index) noexcept
+        : node_(node), index_(index) {}
+
+    template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+    UnrolledListIterator(const UnrolledListIterator<WasConst> &other) noexcept
+        : node_(other.node_), index_(other.index_) {}
+
+    reference operator*() const noexcept {
+      return const_cast<Node *>(static_cast<const Node *>(node_))
+          ->Data()[index_];
+    }
+
+    pointer operator->() const noexcept { return &**this; }
+
+    UnrolledListIterator &operator++() noexcept {
+      if (++index_ == static_cast<const Node *>(node_)->count_) {
+        node_ = node_->next_;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    UnrolledListIterator operator++(int) noexcept {
+      UnrolledListIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    UnrolledListIterator &operator--() noexcept {
+      if (index_ == 0) {
+        node_ = node_->prev_;
+        index_ = static_cast<const Node *>(node_)->count_;
+      }
+      --index_;
+      return *this;
+    }
+
+    UnrolledListIterator operator--(int) noexcept {
+      UnrolledListIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const UnrolledListIterator &lhs,
+                           const UnrolledListIterator &rhs) noexcept {
+      return lhs.node_ == rhs.node_ && lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const UnrolledListIterator &lhs,
+                           const UnrolledListIterator &rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+  private:
+    friend class unrolled_list;
+    template <bool> friend class UnrolledListIterator;
+
+    links_pointer node_ = nullptr;
+    size_type index_ = 0;
+  };
+
+  Links head_;
+  size_type size_;
+};
+
+} // namespace s21
+
+#include "s21_unrolled_list.tpp"
+#endif // S21_CONTAINERS_UNROLLED_LIST_S21_UNROLLED_LIST_H_
@@ -0,0 +1,595 @@
+namespace s21 {
+
+/**
+ * @brief Конструктор по умолчанию. Создает пустой список.
+ *
+ * Фиктивный узел head_ замыкается сам на себя.
+ */
+template <typename T, std::size_t K>
+unrolled_list<T, K>::unrolled_list() noexcept : size_(0) {
+  head_.prev_ = head_.next_ = &head_;
+}
+
+/**
+ * @brief Создает список из n элементов, инициализированных по умолчанию.
+ *
+ * @param n Количество элементов.
+ */
+template <typename T, std::size_t K>
+unrolled_list<T, K>::unrolled_list(size_type n) : unrolled_list() {
+  for (size_type i = 0; i < n; ++i) {
+    EmplaceBack();
+  }
+}
+
+/**
+ * @brief Конструктор инициализации на основе списка значений.
+ *
+ * @param items Список значений для инициализации контейнера.
+ */
+template <typename T, std::size_t K>
+unrolled_list<T, K>::unrolled_list(
+    std::initializer_list<value_type> const &items)
+    : unrolled_list() {
+  for (const auto &item : items) {
+    EmplaceBack(item);
+  }
+}
+
+/**
+ * @brief Конструктор копирования. Узлы копии заполнены полностью, даже если
+ * в other они заполнены частично.
+ *
+ * @param other Список, содержимое которого копируется.
+ */
+template <typename T, std::size_t K>
+unrolled_list<T, K>::unrolled_list(const unrolled_list &other)
+    : unrolled_list() {
+  for (const auto &item : other) {
+    EmplaceBack(item);
+  }
+}
+
+/**
+ * @brief Конструктор перемещения. Забирает узлы у other.
+ *
+ * @param other Список, который после перемещения становится пустым.
+ */
+template <typename T, std::size_t K>
+unrolled_list<T, K>::unrolled_list(unrolled_list &&other) noexcept
+    : unrolled_list() {
+  swap(other);
+}
+
+/**
+ * @brief Деструктор. Разрушает элементы и освобождает узлы.
+ */
+template <typename T, std::size_t K> unrolled_list<T, K>::~unrolled_list() {
+  clear();
+}
+
+/**
+ * @brief Копирующее присваивание.
+ *
+ * Копия строится отдельно, поэтому при исключении текущее содержимое не
+ * меняется.
+ *
+ * @param other Список, содержимое которого копируется.
+ * @return Ссылка на текущий список.
+ */
+template <typename T, std::size_t K>
+unrolled_list<T, K> &
+unrolled_list<T, K>::operator=(const unrolled_list &other) {
+  if (this != &other) {
+    unrolled_list copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+/**
+ * @brief Перемещающее присваивание.
+ *
+ * @param other Список, содержимое которого перемещается.
+ * @return Ссылка на текущий список.
+ */
+template <typename T, std::size_t K>
+unrolled_list<T, K> &
+unrolled_list<T, K>::operator=(unrolled_list &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Первый элемент (список не должен быть пустым).
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::reference unrolled_list<T, K>::front() noexcept {
+  return First()->Data()[0];
+}
+
+/**
+ * @brief Первый элемент (список не должен быть пустым).
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::const_reference
+unrolled_list<T, K>::front() const noexcept {
+  return First()->Data()[0];
+}
+
+/**
+ * @brief Последний элемент (список не должен быть пустым).
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::reference unrolled_list<T, K>::back() noexcept {
+  Node *last = Last();
+  return last->Data()[last->count_ - 1];
+}
+
+/**
+ * @brief Последний элемент (список не должен быть пустым).
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::const_reference
+unrolled_list<T, K>::back() const noexcept {
+  const Node *last = Last();
+  return last->Data()[last->count_ - 1];
+}
+
+/**
+ * @brief Итератор на первый элемент.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::iterator unrolled_list<T, K>::begin() noexcept {
+  return iterator(head_.next_, 0);
+}
+
+/**
+ * @brief Константный итератор на первый элемент.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::const_iterator
+unrolled_list<T, K>::begin() const noexcept {
+  return const_iterator(head_.next_, 0);
+}
+
+/**
+ * @brief Итератор за последним элементом.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::iterator unrolled_list<T, K>::end() noexcept {
+  return iterator(&head_, 0);
+}
+
+/**
+ * @brief Константный итератор за последним элементом.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::const_iterator
+unrolled_list<T, K>::end() const noexcept {
+  return const_iterator(&head_, 0);
+}
+
+/**
+ * @brief Константный итератор на первый элемент (как в s21::List).
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::const_iterator
+unrolled_list<T, K>::cBegin() const noexcept {
+  return begin();
+}
+
+/**
+ * @brief Константный итератор за последним элементом (как в s21::List).
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::const_iterator
+unrolled_list<T, K>::cEnd() const noexcept {
+  return end();
+}
+
+/**
+ * @brief Проверяет, пуст ли список.
+ */
+template <typename T, std::size_t K>
+bool unrolled_list<T, K>::empty() const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Возвращает количество элементов.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::size_type
+unrolled_list<T, K>::size() const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Возвращает максимально возможное количество элементов.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::size_type
+unrolled_list<T, K>::max_size() const noexcept {
+  return std::numeric_limits<size_type>::max() / sizeof(Node) * K;
+}
+
+/**
+ * @brief Разрушает все элементы и освобождает узлы.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::clear() noexcept {
+  Links *link = head_.next_;
+  while (link != &head_) {
+    Links *next = link->next_;
+    Node *node = static_cast<Node *>(link);
+    std::destroy_n(node->Data(), node->count_);
+    delete node;
+    link = next;
+  }
+  head_.prev_ = head_.next_ = &head_;
+  size_ = 0;
+}
+
+/**
+ * @brief Вставляет копию value перед pos.
+ *
+ * @param pos Позиция вставки (может быть end()).
+ * @param value Вставляемое значение.
+ * @return Итератор на вставленный элемент.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::insert(const_iterator pos, const_reference value) {
+  return Emplace(pos, value);
+}
+
+/**
+ * @brief Удаляет элемент в позиции pos.
+ *
+ * Следующие элементы узла сдвигаются на место удаленного. Опустевший узел
+ * освобождается, а узел, который вместе с соседом занимает не больше
+ * половины узла, сливается с ним, поэтому средняя заполненность узлов не
+ * падает ниже четверти.
+ *
+ * @param pos Итератор на существующий элемент.
+ * @return Итератор на элемент, следовавший за удаленным.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::erase(const_iterator pos) {
+  Node *node = static_cast<Node *>(const_cast<Links *>(pos.node_));
+  size_type index = pos.index_;
+  T *data = node->Data();
+  std::move(data + index + 1, data + node->count_, data + index);
+  std::destroy_at(data + node->count_ - 1);
+  --node->count_;
+  --size_;
+
+  if (node->count_ == 0) {
+    Links *next = node->next_;
+    RemoveNode(node);
+    return iterator(next, 0);
+  }
+  Links *next = node->next_;
+  Links *prev = node->prev_;
+  if (next != &head_ &&
+      node->count_ + static_cast<Node *>(next)->count_ <= K / 2) {
+    MergeWithNext(node);
+  } else if (prev != &head_ &&
+             static_cast<Node *>(prev)->count_ + node->count_ <= K / 2) {
+    index += static_cast<Node *>(prev)->count_;
+    node = static_cast<Node *>(prev);
+    MergeWithNext(node);
+  }
+  if (index == node->count_) {
+    return iterator(node->next_, 0);
+  }
+  return iterator(node, index);
+}
+
+/**
+ * @brief Добавляет элемент в конец списка. Пока последний узел не заполнен,
+ * новый узел не выделяется.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::push_back(const_reference value) {
+  EmplaceBack(value);
+}
+
+/**
+ * @brief Добавляет элемент в начало списка.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::push_front(const_reference value) {
+  Emplace(cBegin(), value);
+}
+
+/**
+ * @brief Удаляет последний элемент. Для пустого списка ничего не делает.
+ */
+template <typename T, std::size_t K> void unrolled_list<T, K>::pop_back() {
+  if (!empty()) {
+    erase(--end());
+  }
+}
+
+/**
+ * @brief Удаляет первый элемент. Для пустого списка ничего не делает.
+ */
+template <typename T, std::size_t K> void unrolled_list<T, K>::pop_front() {
+  if (!empty()) {
+    erase(begin());
+  }
+}
+
+/**
+ * @brief Обменивает содержимое двух списков за O(1).
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::swap(unrolled_list &other) noexcept {
+  std::swap(head_, other.head_);
+  std::swap(size_, other.size_);
+  RelinkHead();
+  other.RelinkHead();
+}
+
+/**
+ * @brief Сливает отсортированный список other в текущий отсортированный.
+ *
+ * Результат строится за один проход в новых, полностью заполненных узлах;
+ * равные элементы other встают после элементов текущего списка. После
+ * слияния other пуст.
+ *
+ * @param other Отсортированный список.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::merge(unrolled_list &other) {
+  if (this == &other) {
+    return;
+  }
+  unrolled_list result;
+  iterator left = begin();
+  iterator right = other.begin();
+  while (left != end() && right != other.end()) {
+    if (*right < *left) {
+      result.EmplaceBack(std::move(*right++));
+    } else {
+      result.EmplaceBack(std::move(*left++));
+    }
+  }
+  for (; left != end(); ++left) {
+    result.EmplaceBack(std::move(*left));
+  }
+  for (; right != other.end(); ++right) {
+    result.EmplaceBack(std::move(*right));
+  }
+  swap(result);
+  other.clear();
+}
+
+/**
+ * @brief Обращает порядок элементов: переворачивает каждый узел и меняет
+ * местами его ссылки на соседей. Элементы между узлами не перемещаются.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::reverse() noexcept {
+  Links *link = head_.next_;
+  while (link != &head_) {
+    Node *node = static_cast<Node *>(link);
+    link = link->next_;
+    std::reverse(node->Data(), node->Data() + node->count_);
+    std::swap(node->prev_, node->next_);
+  }
+  std::swap(head_.prev_, head_.next_);
+}
+
+/**
+ * @brief Сортирует элементы по возрастанию (устойчиво).
+ *
+ * Элементы переносятся в непрерывный буфер, сортируются в нем за
+ * O(n log n) и возвращаются на прежние места; узлы не перестраиваются.
+ */
+template <typename T, std::size_t K> void unrolled_list<T, K>::sort() {
+  std::vector<T> buffer;
+  buffer.reserve(size_);
+  for (auto &item : *this) {
+    buffer.push_back(std::move(item));
+  }
+  std::stable_sort(buffer.begin(), buffer.end());
+  auto source = buffer.begin();
+  for (auto &item : *this) {
+    item = std::move(*source++);
+  }
+}
+
+/**
+ * @brief Вставляет несколько элементов перед pos в порядке аргументов.
+ *
+ * @param pos Позиция вставки.
+ * @param args Вставляемые значения.
+ * @return Итератор на последний вставленный элемент (pos, если аргументов
+ * нет).
+ */
+template <typename T, std::size_t K>
+template <typename... Args>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::insert_many(const_iterator pos, Args &&...args) {
+  iterator last(const_cast<Links *>(pos.node_), pos.index_);
+  ((last = Emplace(pos, std::forward<Args>(args)), pos = std::next(last)),
+   ...);
+  return last;
+}
+
+/**
+ * @brief Добавляет несколько элементов в конец списка в порядке аргументов.
+ */
+template <typename T, std::size_t K>
+template <typename... Args>
+void unrolled_list<T, K>::insert_many_back(Args &&...args) {
+  (EmplaceBack(std::forward<Args>(args)), ...);
+}
+
+/**
+ * @brief Добавляет несколько элементов в начало списка в порядке
+ * аргументов.
+ */
+template <typename T, std::size_t K>
+template <typename... Args>
+void unrolled_list<T, K>::insert_many_front(Args &&...args) {
+  insert_many(cBegin(), std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Создает элемент из args перед pos.
+ *
+ * Перед end() элемент дописывается в последний узел или, если тот
+ * заполнен, в новый узел. Иначе полный узел сначала делится пополам, а
+ * затем элементы узла правее позиции вставки сдвигаются на одну ячейку.
+ *
+ * @return Итератор на созданный элемент.
+ */
+template <typename T, std::size_t K>
+template <typename... Args>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::Emplace(const_iterator pos, Args &&...args) {
+  if (pos.node_ == &head_) {
+    Node *node = Last();
+    if (node == nullptr || node->count_ == K) {
+      node = InsertNodeAfter(head_.prev_);
+    }
+    try {
+      ::new (static_cast<void *>(node->Data() + node->count_))
+          T(std::forward<Args>(args)...);
+    } catch (...) {
+      if (node->count_ == 0) {
+        RemoveNode(node);
+      }
+      throw;
+    }
+    ++size_;
+    return iterator(node, node->count_++);
+  }
+
+  Node *node = static_cast<Node *>(const_cast<Links *>(pos.node_));
+  size_type index = pos.index_;
+  T value(std::forward<Args>(args)...);
+  if (node->count_ == K) {
+    Split(node);
+    if (index > node->count_) {
+      index -= node->count_;
+      node = static_cast<Node *>(node->next_);
+    }
+  }
+  T *data = node->Data();
+  if (index == node->count_) {
+    ::new (static_cast<void *>(data + index)) T(std::move(value));
+  } else {
+    ::new (static_cast<void *>(data + node->count_))
+        T(std::move(data[node->count_ - 1]));
+    std::move_backward(data + index, data + node->count_ - 1,
+                       data + node->count_);
+    data[index] = std::move(value);
+  }
+  ++node->count_;
+  ++size_;
+  return iterator(node, index);
+}
+
+/**
+ * @brief Создает элемент из args в конце списка.
+ */
+template <typename T, std::size_t K>
+template <typename... Args>
+void unrolled_list<T, K>::EmplaceBack(Args &&...args) {
+  Emplace(cEnd(), std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Выделяет пустой узел и вставляет его после prev.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::Node *
+unrolled_list<T, K>::InsertNodeAfter(Links *prev) {
+  Node *node = new Node;
+  node->prev_ = prev;
+  node->next_ = prev->next_;
+  prev->next_->prev_ = node;
+  prev->next_ = node;
+  return node;
+}
+
+/**
+ * @brief Разрушает оставшиеся элементы узла, исключает его из списка и
+ * освобождает.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::RemoveNode(Node *node) noexcept {
+  std::destroy_n(node->Data(), node->count_);
+  node->prev_->next_ = node->next_;
+  node->next_->prev_ = node->prev_;
+  delete node;
+}
+
+/**
+ * @brief Делит узел пополам: вторая половина элементов переносится в новый
+ * узел сразу за ним.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::Split(Node *node) {
+  Node *right = InsertNodeAfter(node);
+  size_type keep = node->count_ / 2;
+  T *data = node->Data();
+  std::uninitialized_move(data + keep, data + node->count_, right->Data());
+  std::destroy(data + keep, data + node->count_);
+  right->count_ = node->count_ - keep;
+  node->count_ = keep;
+}
+
+/**
+ * @brief Переносит элементы следующего узла в конец node и освобождает
+ * следующий узел. Вместе узлы должны помещаться в один.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::MergeWithNext(Node *node) noexcept {
+  Node *next = static_cast<Node *>(node->next_);
+  std::uninitialized_move(next->Data(), next->Data() + next->count_,
+                          node->Data() + node->count_);
+  node->count_ += next->count_;
+  RemoveNode(next);
+}
+
+/**
+ * @brief Восстанавливает ссылки первого и последнего узлов на head_ после
+ * того, как head_ скопирован из другого списка.
+ */
+template <typename T, std::size_t K>
+void unrolled_list<T, K>::RelinkHead() noexcept {
+  if (size_ == 0) {
+    head_.prev_ = head_.next_ = &head_;
+  } else {
+    head_.next_->prev_ = &head_;
+    head_.prev_->next_ = &head_;
+  }
+}
+
+/**
+ * @brief Первый узел или nullptr для пустого списка.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::Node *unrolled_list<T, K>::First() const noexcept {
+  return head_.next_ == &head_ ? nullptr : static_cast<Node *>(head_.next_);
+}
+
+/**
+ * @brief Последний узел или nullptr для пустого списка.
+ */
+template <typename T, std::size_t K>
+typename unrolled_list<T, K>::Node *unrolled_list<T, K>::Last() const noexcept {
+  return head_.prev_ == &head_ ? nullptr : static_cast<Node *>(head_.prev_);
+}
+
+} // namespace s21
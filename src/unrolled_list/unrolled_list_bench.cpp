@@ -0,0 +1,66 @@
+// Сравнение s21::unrolled_list<int> и s21::List<int>: обход (сумма
+// элементов), вставка в середину по итератору, который сохраняется между
+// вставками, и байты на элемент.
+//
+// Сборка: g++ -std=c++17 -O2 unrolled_list_bench.cpp -o unrolled_list_bench
+
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+
+#include "../bench/HeapCounter.h"
+#include "../list/s21_list.h"
+#include "s21_unrolled_list.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+template <typename List>
+void Run(const char *name, std::size_t count, std::size_t inserts) {
+  std::size_t before = s21::bench::live_bytes;
+  auto *list = new List;
+  for (std::size_t i = 0; i < count; ++i) {
+    list->push_back(static_cast<int>(i));
+  }
+  std::size_t bytes = s21::bench::live_bytes - before;
+
+  long long sum = 0;
+  auto start = Clock::now();
+  for (int round = 0; round < 10; ++round) {
+    for (auto it = list->cBegin(); it != list->cEnd(); ++it) {
+      sum += *it;
+    }
+  }
+  double traverse_ns = Milliseconds(start) * 1e6 / (10.0 * count);
+
+  auto position = list->cBegin();
+  for (std::size_t i = 0; i < count / 2; ++i) {
+    ++position;
+  }
+  start = Clock::now();
+  for (std::size_t i = 0; i < inserts; ++i) {
+    position = list->insert(position, static_cast<int>(i));
+  }
+  double insert_ns = Milliseconds(start) * 1e6 / inserts;
+
+  std::printf("  %-14s traverse %5.2f ns/elem  middle insert %8.1f ns/op  "
+              "%5.1f bytes/elem  (sum %lld)\n",
+              name, traverse_ns, insert_ns,
+              static_cast<double>(bytes) / count, sum);
+  delete list;
+}
+} // namespace
+
+int main() {
+  for (std::size_t count : {std::size_t{10000}, std::size_t{1000000}}) {
+    std::printf("%zu int elements\n", count);
+    Run<s21::unrolled_list<int>>("unrolled_list", count, 100000);
+    Run<s21::List<int>>("List", count, count < 100000 ? 10000 : 200);
+  }
+  return 0;
+}
@@ -0,0 +1,159 @@
+#include "s21_unrolled_list.h"
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace s21 {
+namespace {
+// Маленькие узлы, чтобы деление и слияние происходили часто.
+template <typename T> using SmallList = s21::unrolled_list<T, 4>;
+
+template <typename List, typename T>
+void ExpectSameAs(const List &actual, const std::list<T> &ref) {
+  ASSERT_EQ(actual.size(), ref.size());
+  EXPECT_TRUE(std::equal(actual.begin(), actual.end(), ref.begin()));
+  std::vector<T> backward;
+  for (auto it = actual.end(); it != actual.begin();) {
+    backward.push_back(*--it);
+  }
+  EXPECT_TRUE(std::equal(backward.begin(), backward.end(), ref.rbegin()));
+}
+} // namespace
+
+TEST(UnrolledListTest, EmptyList) {
+  s21::unrolled_list<int> list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.size(), 0U);
+  EXPECT_TRUE(list.begin() == list.end());
+  EXPECT_TRUE(list.cBegin() == list.cEnd());
+  list.pop_back();
+  list.pop_front();
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(UnrolledListTest, PushPopAndAccess) {
+  SmallList<int> list{2, 3};
+  list.push_front(1);
+  list.push_back(4);
+  list.push_back(5);
+  EXPECT_EQ(list.size(), 5U);
+  EXPECT_EQ(list.front(), 1);
+  EXPECT_EQ(list.back(), 5);
+  ExpectSameAs(list, std::list<int>{1, 2, 3, 4, 5});
+
+  list.pop_front();
+  list.pop_back();
+  ExpectSameAs(list, std::list<int>{2, 3, 4});
+
+  SmallList<int> zeros(9);
+  ExpectSameAs(zeros, std::list<int>(9));
+}
+
+TEST(UnrolledListTest, RandomInsertEraseMatchesStdList) {
+  std::mt19937 gen(36);
+  SmallList<int> list;
+  std::list<int> ref;
+  for (int step = 0; step < 20000; ++step) {
+    std::size_t index = ref.empty() ? 0 : gen() % (ref.size() + 1);
+    auto it = std::next(list.begin(), index);
+    auto ref_it = std::next(ref.begin(), index);
+    if (gen() % 5 < 3 || ref_it == ref.end()) {
+      int value = static_cast<int>(gen() % 1000);
+      auto inserted = list.insert(it, value);
+      ref.insert(ref_it, value);
+      EXPECT_EQ(*inserted, value);
+    } else {
+      auto next = list.erase(it);
+      auto ref_next = ref.erase(ref_it);
+      EXPECT_EQ(next == list.end(), ref_next == ref.end());
+      if (ref_next != ref.end()) {
+        EXPECT_EQ(*next, *ref_next);
+      }
+    }
+    if (step % 1000 == 0) {
+      ExpectSameAs(list, ref);
+    }
+  }
+  ExpectSameAs(list, ref);
+  while (!ref.empty()) {
+    list.erase(list.begin());
+    ref.pop_front();
+  }
+  EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(UnrolledListTest, NonTrivialElements) {
+  SmallList<std::string> list;
+  std::list<std::string> ref;
+  for (int i = 0; i < 50; ++i) {
+    std::string value = "value-" + std::to_string(i) + std::string(20, 'x');
+    list.insert(std::next(list.begin(), list.size() / 2), value);
+    ref.insert(std::next(ref.begin(), ref.size() / 2), value);
+  }
+  ExpectSameAs(list, ref);
+
+  SmallList<std::string> copy = list;
+  EXPECT_EQ(copy, list);
+  SmallList<std::string> moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved, list);
+  moved.erase(moved.begin());
+  EXPECT_NE(moved, list);
+  moved = list;
+  EXPECT_EQ(moved, list);
+
+  SmallList<std::string> other{"a"};
+  other.swap(moved);
+  EXPECT_EQ(other, list);
+  ExpectSameAs(moved, std::list<std::string>{"a"});
+}
+
+TEST(UnrolledListTest, SortMergeReverse) {
+  std::mt19937 gen(136);
+  SmallList<int> left;
+  SmallList<int> right;
+  std::list<int> ref_left;
+  std::list<int> ref_right;
+  for (int i = 0; i < 500; ++i) {
+    int a = static_cast<int>(gen() % 100);
+    int b = static_cast<int>(gen() % 100);
+    left.push_back(a);
+    ref_left.push_back(a);
+    right.push_front(b);
+    ref_right.push_front(b);
+  }
+  left.sort();
+  right.sort();
+  ref_left.sort();
+  ref_right.sort();
+  ExpectSameAs(left, ref_left);
+  ExpectSameAs(right, ref_right);
+
+  left.merge(right);
+  ref_left.merge(ref_right);
+  ExpectSameAs(left, ref_left);
+  EXPECT_TRUE(right.empty());
+
+  left.reverse();
+  ref_left.reverse();
+  ExpectSameAs(left, ref_left);
+}
+
+TEST(UnrolledListTest, InsertMany) {
+  SmallList<int> list{1, 5};
+  auto it = list.insert_many(std::next(list.cBegin()), 2, 3, 4);
+  EXPECT_EQ(*it, 4);
+  list.insert_many_back(6, 7);
+  list.insert_many_front(-1, 0);
+  ExpectSameAs(list, std::list<int>{-1, 0, 1, 2, 3, 4, 5, 6, 7});
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+} // namespace s21